@@ -1,5 +1,6 @@
 #pragma once
 
+#include "audio/processing/SilenceDetector.hpp"
 #include <string>
 
 namespace VRMusicStudio {
@@ -17,6 +18,12 @@ public:
     virtual float getParameter(int index) const = 0;
     virtual int getParameterCount() const = 0;
     virtual std::string getParameterName(int index) const = 0;
+
+    // How long the effect keeps producing output after its input fell silent
+    // (reverb decay, delay feedback). The effect engine skips the effect once
+    // its input has been silent for longer. The default kInfiniteTail keeps
+    // effects that do not declare a tail running.
+    virtual double getTailSeconds() const { return kInfiniteTail; }
 };
 
 } // namespace VRMusicStudio 
\ No newline at end of file
@@ -19,6 +19,7 @@ public:
     float getParameter(int index) const override;
     int getParameterCount() const override;
     std::string getParameterName(int index) const override;
+    double getTailSeconds() const override;
 
 private:
     void resizeBuffer();
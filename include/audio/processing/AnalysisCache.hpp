@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace VRMusicStudio {
+
+// On-disk half of AnalysisCache: one text file per key in a cache directory.
+//
+// The file name is a hash of the key and the first line repeats the full key,
+// so a hash collision reads as a miss. Entries are written to a per-thread
+// temporary file and renamed, so concurrent workers never see partial files.
+class AnalysisCacheFiles {
+public:
+    // `subdirectory` below the system temp directory, `extension` without dot
+    AnalysisCacheFiles(const std::string& subdirectory, const std::string& extension);
+
+    void setDirectory(const std::string& directory);
+
+    // Calls `read` with the stream positioned after the key line and the file
+    // size in bytes; returns false on a miss or when `read` fails
+    bool load(const std::string& key, const std::function<bool(std::istream&, size_t)>& read) const;
+    void save(const std::string& key, const std::function<void(std::ostream&)>& write) const;
+
+    // Key prefix for a file on disk: absolute path, size and modification
+    // time; empty if the file can't be inspected
+    static std::string fileKey(const std::string& path);
+
+    // Reads a count followed by that many positions. The count is checked
+    // against the file size first, so a damaged entry can't trigger a huge
+    // allocation.
+    static bool readPositions(std::istream& stream, size_t fileSize, std::vector<size_t>& positions);
+    static void writePositions(std::ostream& stream, const std::vector<size_t>& positions);
+
+private:
+    std::string fileFor(const std::string& key) const;
+
+    mutable std::mutex m_mutex;
+    std::string m_directory;
+    std::string m_extension;
+};
+
+// Result cache for the background analyzers (onsets, tempo/key).
+//
+// Results are kept in memory, least recently used entries are dropped beyond
+// `maxMemoryEntries`, and in AnalysisCacheFiles. The analyzer supplies the
+// key and how one result is read and written. Thread-safe; file I/O and
+// allocation keep it off the audio thread.
+template <typename T>
+class AnalysisCache {
+public:
+    using Reader = bool (*)(std::istream& stream, size_t fileSize, T& value);
+    using Writer = void (*)(std::ostream& stream, const T& value);
+
+    AnalysisCache(const std::string& subdirectory, const std::string& extension,
+                  size_t maxMemoryEntries, Reader reader, Writer writer)
+        : m_files(subdirectory, extension)
+        , m_maxMemoryEntries(maxMemoryEntries)
+        , m_reader(reader)
+        , m_writer(writer)
+    {
+    }
+
+    void setDirectory(const std::string& directory) { m_files.setDirectory(directory); }
+
+    // Memory first, then disk; a disk hit is kept in memory
+    std::shared_ptr<const T> find(const std::string& key) {
+        if (key.empty()) return nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_memory.find(key);
+            if (it != m_memory.end()) {
+                m_recentKeys.splice(m_recentKeys.begin(), m_recentKeys, it->second.recent);
+                return it->second.value;
+            }
+        }
+
+        auto value = std::make_shared<T>();
+        const bool loaded = m_files.load(key, [&](std::istream& stream, size_t fileSize) {
+            return m_reader(stream, fileSize, *value);
+        });
+        if (!loaded) return nullptr;
+        remember(key, value);
+        return value;
+    }
+
+    void store(const std::string& key, std::shared_ptr<const T> value) {
+        if (key.empty() || !value) return;
+        m_files.save(key, [&](std::ostream& stream) { m_writer(stream, *value); });
+        remember(key, std::move(value));
+    }
+
+    void clearMemory() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_memory.clear();
+        m_recentKeys.clear();
+    }
+
+private:
+    struct Entry {
+        std::shared_ptr<const T> value;
+        std::list<std::string>::iterator recent;
+    };
+
+    void remember(const std::string& key, std::shared_ptr<const T> value) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_memory.find(key);
+        if (it != m_memory.end()) {
+            it->second.value = std::move(value);
+            m_recentKeys.splice(m_recentKeys.begin(), m_recentKeys, it->second.recent);
+            return;
+        }
+
+        // Am längsten unbenutzte Einträge verdrängen
+        while (m_memory.size() >= m_maxMemoryEntries && !m_recentKeys.empty()) {
+            m_memory.erase(m_recentKeys.back());
+            m_recentKeys.pop_back();
+        }
+        m_recentKeys.push_front(key);
+        m_memory[key] = {std::move(value), m_recentKeys.begin()};
+    }
+
+    AnalysisCacheFiles m_files;
+    size_t m_maxMemoryEntries;
+    Reader m_reader;
+    Writer m_writer;
+
+    std::mutex m_mutex;
+    std::map<std::string, Entry> m_memory;
+    std::list<std::string> m_recentKeys;    // vorne = zuletzt benutzt
+};
+
+} // namespace VRMusicStudio
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace VRMusicStudio {
+
+// Result of a background job (prerender, analysis) that the audio thread reads
+// without locking. The worker publishes with an atomic shared_ptr store; the
+// previous value is kept alive one generation longer so a reader never drops
+// the last reference mid-block. Each request bumps the generation, results of
+// superseded requests are discarded by the worker.
+//
+// publish() must only be called from a single worker thread.
+template <typename T>
+class AsyncResult {
+public:
+    std::shared_ptr<const T> load() const { return std::atomic_load(&m_current); }
+
+    uint64_t beginRequest() { return m_generation.fetch_add(1) + 1; }
+    void cancel() { m_generation.fetch_add(1); }
+    bool isCurrent(uint64_t generation) const { return m_generation.load() == generation; }
+
+    void publish(std::shared_ptr<const T> value) {
+        m_previous = std::atomic_load(&m_current);
+        std::atomic_store(&m_current, std::move(value));
+    }
+
+private:
+    std::shared_ptr<const T> m_current;
+    std::shared_ptr<const T> m_previous;
+    std::atomic<uint64_t> m_generation{0};
+};
+
+} // namespace VRMusicStudio
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+namespace VRMusicStudio {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kTwoPi = 2.0 * kPi;
+
+// Smallest power of two >= value; sizes masked ring buffers and FFTs
+constexpr size_t nextPowerOfTwo(size_t value) {
+    size_t size = 1;
+    while (size < value) size <<= 1;
+    return size;
+}
+
+} // namespace VRMusicStudio
@@ -3,6 +3,7 @@
 #include <memory>
 #include <vector>
 #include "AudioEffect.hpp"
+#include "audio/processing/SilenceDetector.hpp"
 
 namespace VRMusicStudio {
 
@@ -22,6 +23,12 @@ public:
     void stopProcessing();
     bool isProcessing() const;
 
+    // Skip effects whose input has been silent for longer than their tail
+    void setSleepEnabled(bool enabled);
+    bool isSleepEnabled() const;
+    bool isEffectSleeping(const std::shared_ptr<AudioEffect>& effect) const;
+    bool isOutputSilent() const;
+
 private:
     void updateEffects();
     void updateEffect(std::shared_ptr<AudioEffect> effect);
@@ -30,7 +37,10 @@ private:
     int m_blockSize;
     int m_numChannels;
     bool m_isProcessing;
+    bool m_sleepEnabled;
+    bool m_outputSilent;
     std::vector<std::shared_ptr<AudioEffect>> m_effects;
+    std::vector<TailSleep> m_sleepStates;   // parallel to m_effects
 };
 
 } // namespace VRMusicStudio 
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace VRMusicStudio {
+
+// Real-input FFT of fixed size on top of FFTW.
+//
+// Plans and aligned buffers are created in the constructor (not real-time
+// safe); forward()/inverse() only execute the plan and are safe to call from
+// the audio thread. inverse() is unnormalized, i.e. inverse(forward(x)) == N*x.
+class RealFFT {
+public:
+    explicit RealFFT(size_t size);
+    ~RealFFT();
+
+    RealFFT(const RealFFT&) = delete;
+    RealFFT& operator=(const RealFFT&) = delete;
+
+    size_t getSize() const { return m_size; }
+    size_t getNumBins() const { return m_size / 2 + 1; }
+
+    // input: getSize() samples, output: getNumBins() bins
+    void forward(const float* input, std::complex<float>* output);
+    // input: getNumBins() bins, output: getSize() samples
+    void inverse(const std::complex<float>* input, float* output);
+
+    // Periodic Hann window, the default analysis window for the STFT users
+    static std::vector<float> hannWindow(size_t size);
+
+private:
+    struct Plans;
+
+    size_t m_size;
+    Plans* m_plans;
+};
+
+} // namespace VRMusicStudio
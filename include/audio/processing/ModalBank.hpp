@@ -0,0 +1,133 @@
+#pragma once
+
+#include "audio/processing/SimdOps.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace VRMusicStudio {
+
+// Modal synthesis for struck instruments (bars, membranes, tubes, plates).
+//
+// Every strike gets a voice with one damped resonator per mode of the
+// instrument's mode table. A resonator is a complex one-pole z = p z + g x
+// with |p| set from the mode's T60; its imaginary part is the output, so an
+// impulse starts as a sine without a click. Resonators are evaluated four at
+// a time with SimdOps::Float4 over blocks of kBlockSize samples, which keeps
+// hundreds of modes per instrument cheap and the cost independent of the
+// material.
+//
+// The excitation is a half-sine mallet pulse whose contact time shrinks with
+// velocity (harder hits excite more high modes), optionally plus a decaying
+// noise burst that drives dense mode sets such as cymbals. Mode amplitudes
+// depend on the strike position through each mode's spatial order.
+//
+// Voices and mode arrays are allocated in the constructor; strike(),
+// noteOff() and process() are allocation-free and belong to one audio thread.
+class ModalBank {
+public:
+    static constexpr int kBlockSize = 64;
+
+    struct Mode {
+        float ratio;        // Frequenz relativ zur Note
+        float decay;        // T60 in Sekunden
+        float gain;
+        float shape;        // räumliche Ordnung, 0 = unabhängig vom Anschlagpunkt
+    };
+
+    struct Preset {
+        std::vector<Mode> modes;
+        float contactTime = 0.001f;     // Sekunden bei voller Velocity
+        float noiseLevel = 0.0f;        // Rauschanteil der Anregung
+        float noiseDecay = 0.02f;       // Sekunden
+        float noiseMix = 0.0f;          // Rauschen direkt am Ausgang (Schnarrsaiten)
+        float decayPitchScale = 0.0f;   // T60 * (261.6 Hz / f)^x, hohe Noten klingen kürzer
+        float releaseDecay = 0.0f;      // T60 nach noteOff, 0 = kein Dämpfer
+        float strikePosition = 0.25f;   // 0 - 1, 0.5 = Mitte
+        float tremoloRate = 0.0f;       // Hz (Vibraphon-Motor)
+        float tremoloDepth = 0.0f;      // 0 - 1
+        float gain = 1.0f;
+    };
+
+    // Mode tables
+    static Preset marimba();
+    static Preset xylophone();
+    static Preset vibraphone();
+    static Preset glockenspiel();
+    static Preset tubularBells();
+    static Preset timpani();
+    static Preset cymbal();
+    static Preset hiHat();
+    static Preset kick();
+    static Preset snare();
+    static Preset tom();
+
+    explicit ModalBank(const Preset& preset, int maxVoices = 16, double sampleRate = 44100.0);
+    ~ModalBank();
+
+    void setGain(float gain) { m_gain = gain; }
+    void setDecayScale(float scale) { m_decayScale = scale; }   // für neue Anschläge
+
+    // MIDI note at the preset's default strike position; velocity 0 - 1
+    void noteOn(int note, float velocity);
+    // Strike with explicit frequency (Hz) and position (0 - 1). `key` identifies
+    // the voice for noteOff; striking a sounding key excites the same modes again.
+    void strike(int key, float frequency, float velocity, float position);
+    // Dampers (releaseDecay > 0) only
+    void noteOff(int key);
+    void allNotesOff();
+
+    // Adds numSamples mono samples to `out`
+    void process(float* out, int numSamples);
+
+    int getActiveVoices() const;
+    size_t getModeCount() const { return m_preset.modes.size(); }
+
+private:
+    struct Voice {
+        // Modi als SoA, auf Vielfache von vier aufgefüllt
+        std::vector<float> poleRe;
+        std::vector<float> poleIm;
+        std::vector<float> stateRe;
+        std::vector<float> stateIm;
+        std::vector<float> gain;
+        std::vector<float> decay;       // T60 pro Modus, für die Dämpfer
+
+        int key = -1;
+        bool active = false;
+        bool released = false;
+        uint64_t startOrder = 0;
+        float frequency = 0.0f;
+
+        // Anregung
+        int contactSamples = 0;
+        int contactPosition = 0;
+        float pulseGain = 0.0f;
+        float noiseLevel = 0.0f;
+    };
+
+    Voice* allocateVoice(int key);
+    void setPoles(Voice& voice, bool damped) const;
+    bool renderExcitation(Voice& voice, int numSamples);
+    void renderModes(Voice& voice, int numSamples, bool excited);
+    float nextNoise();
+
+    Preset m_preset;
+    double m_sampleRate;
+    size_t m_paddedModes;
+    std::vector<Voice> m_voices;
+
+    // Blockpuffer: Anregung, Rauschen am Ausgang, vier Spuren pro Sample
+    std::array<float, kBlockSize> m_excitation;
+    std::array<float, kBlockSize> m_direct;
+    std::array<float, 4 * kBlockSize> m_lanes;
+
+    float m_gain;
+    float m_decayScale;
+    double m_tremoloPhase;
+    uint64_t m_startCounter;
+    uint32_t m_noiseState;
+};
+
+} // namespace VRMusicStudio
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "audio/processing/AnalysisCache.hpp"
+#include "audio/processing/AsyncResult.hpp"
+#include "audio/processing/FFT.hpp"
+#include <complex>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace VRMusicStudio {
+
+// Onset/transient detection on an STFT (1024er Frames, 256er Hop).
+//
+// The onset detection function is one of spectral flux (log-compressed,
+// half-wave rectified), complex-domain deviation (rectified, catches soft
+// tonal onsets) or high-frequency content (cheap, good for percussion).
+// Peaks are picked against an adaptive median threshold with two frames of
+// lookahead, so the streaming path reports onsets ~12 ms after they happen.
+//
+// process() is real-time safe after prepare(); detect() is the offline pass
+// used for sample files and additionally refines every onset to the start of
+// the attack in the time domain.
+class OnsetDetector {
+public:
+    enum class Method {
+        SpectralFlux,
+        ComplexDomain,
+        HighFrequencyContent
+    };
+
+    struct Settings {
+        Method method = Method::ComplexDomain;
+        float sensitivity = 0.5f;       // 0 - 1, höher = mehr Onsets
+        float minIntervalMs = 40.0f;    // minimaler Abstand zweier Onsets
+    };
+
+    static constexpr size_t kFrameSize = 1024;
+    static constexpr size_t kHopSize = 256;
+    static constexpr size_t kLookahead = 2;
+    static constexpr size_t kHistory = 16;
+
+    OnsetDetector();
+    ~OnsetDetector();
+
+    void prepare(double sampleRate, const Settings& settings);
+    void reset();
+
+    // Mono input; writes absolute sample positions (since reset) of detected
+    // onsets to `onsets` and returns how many were written
+    size_t process(const float* input, size_t numFrames, uint64_t* onsets, size_t maxOnsets);
+
+    // Offline pass over a whole (interleaved) file
+    static std::vector<size_t> detect(const float* data, size_t frames, int channels,
+                                      double sampleRate, const Settings& settings);
+
+    // Moves every grid point to the nearest onset within maxDistance
+    static std::vector<size_t> snapToOnsets(const std::vector<size_t>& grid,
+                                            const std::vector<size_t>& onsets,
+                                            size_t maxDistance);
+
+private:
+    float analyzeFrame();
+    bool pickPeak(uint64_t& position);
+
+    double m_sampleRate;
+    Settings m_settings;
+    float m_thresholdScale;
+    float m_thresholdOffset;
+    size_t m_minInterval;
+
+    std::unique_ptr<RealFFT> m_fft;
+    std::vector<float> m_window;
+    std::vector<float> m_input;         // Ring über die letzten kFrameSize Samples
+    std::vector<float> m_frame;
+    std::vector<std::complex<float>> m_spectrum;
+    std::vector<float> m_magnitude;
+    std::vector<float> m_prevMagnitude;
+    std::vector<float> m_phase;
+    std::vector<float> m_prevPhase;
+    std::vector<float> m_prevPrevPhase;
+    float m_prevHfc;
+
+    size_t m_inputPos;
+    size_t m_hopFill;
+    uint64_t m_samplesSeen;
+    uint64_t m_framesAnalyzed;
+    uint64_t m_lastOnset;
+    float m_odf[kHistory + kLookahead + 1];
+    float m_odfMean;
+};
+
+// Onset positions of one sample file
+struct OnsetMarkers {
+    std::vector<size_t> onsets;
+    size_t frames = 0;
+    double sampleRate = 44100.0;
+};
+
+using OnsetSlot = AsyncResult<OnsetMarkers>;
+
+// Background analysis with a per-file cache. Results are kept in memory
+// (least recently used entries are dropped beyond kMaxMemoryEntries) and in a
+// small on-disk cache keyed by path, size and modification time, so a sample
+// is only analyzed once per settings combination.
+class OnsetAnalyzer {
+public:
+    static constexpr size_t kMaxMemoryEntries = 256;
+
+    static OnsetAnalyzer& getInstance();
+
+    ~OnsetAnalyzer();
+
+    void request(const std::shared_ptr<OnsetSlot>& slot, const std::string& path,
+                 std::shared_ptr<const std::vector<float>> data, int channels,
+                 double sampleRate, const OnsetDetector::Settings& settings);
+
+    void setCacheDirectory(const std::string& directory);
+    void clearMemoryCache();
+
+private:
+    struct Job {
+        std::weak_ptr<OnsetSlot> slot;
+        uint64_t generation = 0;
+        std::string path;
+        std::shared_ptr<const std::vector<float>> data;
+        int channels = 1;
+        double sampleRate = 44100.0;
+        OnsetDetector::Settings settings;
+    };
+
+    OnsetAnalyzer();
+    void run();
+    std::string makeKey(const Job& job) const;
+    static bool readMarkers(std::istream& stream, size_t fileSize, OnsetMarkers& markers);
+    static void writeMarkers(std::ostream& stream, const OnsetMarkers& markers);
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<Job> m_jobs;
+    AnalysisCache<OnsetMarkers> m_cache;
+    bool m_shouldStop;
+    std::thread m_worker;
+};
+
+} // namespace VRMusicStudio
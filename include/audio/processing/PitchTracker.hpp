@@ -0,0 +1,102 @@
+#pragma once
+
+#include "audio/processing/FFT.hpp"
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace VRMusicStudio {
+
+// Monophonic pitch tracker (YIN or McLeod/MPM) for vocal and melody input.
+//
+// Both methods are built on one FFT autocorrelation per hop:
+//  - YIN: cumulative-mean-normalized difference function; the first dip
+//    below `threshold` wins. Confidence is 1 - d'(tau).
+//  - MPM: normalized square difference function (NSDF); the first key
+//    maximum above `clarity` * highest maximum wins. Confidence is the
+//    NSDF value at the peak.
+// The lag is refined by parabolic interpolation.
+//
+// The analysis frame is 2 * (sampleRate / minFrequency) samples, so the
+// frequency range sets the latency; a new estimate is produced every hop.
+// process() is real-time safe after prepare().
+class PitchTracker {
+public:
+    enum class Method {
+        YIN,
+        MPM
+    };
+
+    struct Settings {
+        Method method = Method::MPM;
+        float minFrequency = 60.0f;         // Hz, bestimmt die Framelänge
+        float maxFrequency = 1200.0f;       // Hz
+        float hopMs = 5.0f;                 // Abstand zweier Schätzungen
+        float threshold = 0.15f;            // YIN: Schwelle für d'(tau)
+        float clarity = 0.9f;               // MPM: Faktor für Key-Maxima
+        float voicingThreshold = 0.6f;      // minimale Konfidenz für "voiced"
+        float silenceDb = -60.0f;           // darunter unvoiced ohne Analyse
+    };
+
+    struct Estimate {
+        float frequency = 0.0f;             // Hz, 0 wenn unvoiced
+        float confidence = 0.0f;            // 0 - 1
+        bool voiced = false;
+        uint64_t position = 0;              // Framemitte, Samples seit reset()
+
+        float midiNote() const;
+    };
+
+    PitchTracker();
+    ~PitchTracker();
+
+    void prepare(double sampleRate, const Settings& settings);
+    void reset();
+
+    // Mono input; writes one estimate per completed hop to `estimates` and
+    // returns how many were written (further estimates only update getLatest())
+    size_t process(const float* input, size_t numFrames, Estimate* estimates, size_t maxEstimates);
+
+    const Estimate& getLatest() const { return m_latest; }
+    size_t getFrameSize() const { return m_frameSize; }
+    size_t getHopSize() const { return m_hopSize; }
+    // Delay from the newest input sample to the centre of the analysed frame
+    size_t getLatencySamples() const { return m_frameSize / 2; }
+
+    // Offline pass over a whole (interleaved) file, channels are mixed to mono
+    static std::vector<Estimate> track(const float* data, size_t frames, int channels,
+                                       double sampleRate, const Settings& settings);
+
+    static float frequencyToMidi(float frequency);
+
+private:
+    void analyzeFrame();
+    float pickYin(float& confidence);
+    float pickMpm(float& confidence);
+    static float interpolate(const float* values, size_t index, size_t size);
+
+    double m_sampleRate;
+    Settings m_settings;
+    size_t m_minLag;
+    size_t m_maxLag;
+    size_t m_frameSize;
+    size_t m_hopSize;
+    float m_silenceEnergy;
+
+    std::unique_ptr<RealFFT> m_fft;
+    std::vector<float> m_input;         // linear, die letzten m_frameSize Samples
+    std::vector<float> m_padded;
+    std::vector<float> m_correlation;
+    std::vector<double> m_prefixEnergy;
+    std::vector<float> m_function;      // d'(tau) bzw. NSDF
+    std::vector<std::complex<float>> m_spectrum;
+    std::vector<std::complex<float>> m_windowSpectrum;
+
+    size_t m_inputFill;
+    uint64_t m_samplesSeen;
+    Estimate m_latest;
+};
+
+} // namespace VRMusicStudio
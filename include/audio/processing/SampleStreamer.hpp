@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace VRMusicStudio {
+
+// Sample file whose first frames are resident; the rest is streamed
+struct StreamedSample {
+    std::string path;
+    size_t frames = 0;
+    int channels = 1;
+    double sampleRate = 44100.0;
+    std::vector<float> head;            // interleaved, headFrames Frames
+    size_t headFrames = 0;
+
+    bool isResident() const { return headFrames >= frames; }
+};
+
+// Disk streaming for large multisample libraries ("preload the head, stream
+// the rest").
+//
+// open() keeps the first `preloadMs` of a file in memory. A voice starts on
+// that head while a background I/O thread fills its ring (ringFrames frames)
+// with the remainder in playback order, loops already unrolled. The thread
+// always serves the voice with the least buffered playback time first, so
+// memory grows with maxVoices instead of with the size of the library.
+//
+// startVoice(), readFrame(), advance() and stopVoice() are lock- and
+// allocation-free and belong to one audio thread. A frame that has not been
+// streamed yet reads as silence and counts as an underrun.
+//
+// A stopped slot stays with the I/O thread until it has closed the file, so
+// `spareVoices` extra slots are kept for voice stealing: a note that replaces
+// a stolen one still gets a ring while the old slot is being released. At
+// most maxVoices slots are active at a time.
+class SampleStreamer {
+public:
+    struct Settings {
+        double preloadMs = 500.0;
+        size_t ringFrames = 65536;          // pro Stimme, Zweierpotenz
+        size_t chunkFrames = 8192;          // Frames pro Lesezugriff
+        int maxVoices = 64;
+        int spareVoices = 16;               // Slots für gestohlene Stimmen
+        int maxChannels = 2;
+    };
+
+    SampleStreamer();
+    explicit SampleStreamer(const Settings& settings);
+    ~SampleStreamer();
+
+    // Blocking (loader thread); reads the head, or the whole file if it is
+    // shorter or `resident` is set. nullptr if the file cannot be opened.
+    std::shared_ptr<StreamedSample> open(const std::string& path, bool resident = false) const;
+
+    // Audio thread. Loop points are source frames; -1 if all voices are busy
+    int startVoice(const std::shared_ptr<StreamedSample>& sample, bool loop,
+                   uint64_t loopStart, uint64_t loopEnd);
+    void stopVoice(int voice);
+
+    // Interleaved frame at playback position `frame` (loops unrolled) into
+    // `out` (sample->channels values). false on underrun or past the end.
+    bool readFrame(int voice, uint64_t frame, float* out);
+
+    // Frames before `frame` are no longer needed. `speed` is the current
+    // playback rate in source frames per output frame (sets the priority).
+    void advance(int voice, uint64_t frame, float speed);
+
+    uint64_t getUnderruns() const { return m_underruns.load(std::memory_order_relaxed); }
+    int getActiveVoices() const;
+    size_t getMemoryUsage() const;          // Bytes der Ringpuffer
+    const Settings& getSettings() const { return m_settings; }
+
+private:
+    enum State : int { Free, Active, Stopping };
+
+    struct Voice {
+        std::atomic<int> state{Free};
+        std::shared_ptr<StreamedSample> sample;     // Audio setzt, I/O gibt frei
+        bool loop = false;
+        uint64_t loopStart = 0;
+        uint64_t loopEnd = 0;
+        std::vector<float> ring;
+        std::atomic<uint64_t> writeEnd{0};          // Frames < writeEnd liegen im Ring
+        std::atomic<uint64_t> readStart{0};         // Frames < readStart sind verbraucht
+        std::atomic<float> speed{1.0f};
+        bool underrun = false;                      // nur Audio-Thread
+
+        // nur I/O-Thread
+        void* file = nullptr;                       // SNDFILE*
+        uint64_t filePosition = 0;
+        bool failed = false;
+    };
+
+    static uint64_t sourceFrame(const Voice& voice, uint64_t frame) {
+        if (!voice.loop || frame < voice.loopEnd) return frame;
+        return voice.loopStart + (frame - voice.loopStart) % (voice.loopEnd - voice.loopStart);
+    }
+
+    void run();
+    void fill(Voice& voice);
+    void release(Voice& voice);
+
+    Settings m_settings;
+    std::vector<std::unique_ptr<Voice>> m_voices;
+    int m_startedVoices;                            // nur Audio-Thread
+    std::atomic<uint64_t> m_underruns;
+    std::atomic<bool> m_shouldStop;
+    std::thread m_worker;
+};
+
+} // namespace VRMusicStudio
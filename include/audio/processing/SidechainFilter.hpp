@@ -0,0 +1,99 @@
+#pragma once
+
+#include "audio/processing/DspMath.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace VRMusicStudio {
+
+// Detector filter for sidechain key inputs: a 2nd-order high-pass followed by
+// a 2nd-order low-pass (RBJ, Q = 0.7071). The key is only read, never copied
+// or written, so callers can hand in a view of another track's buffer.
+// Either stage switches itself off at the edges of the audio band.
+class SidechainFilter {
+public:
+    static constexpr float kMinHighpass = 20.0f;
+    static constexpr float kMaxLowpass = 20000.0f;
+
+    void prepare(double sampleRate) {
+        m_sampleRate = sampleRate;
+        m_highpassFrequency = -1.0f;
+        m_lowpassFrequency = -1.0f;
+        setFrequencies(kMinHighpass, kMaxLowpass);
+        reset();
+    }
+
+    void reset() {
+        m_highpass.reset();
+        m_lowpass.reset();
+    }
+
+    // Coefficients are only recomputed when a frequency actually changes
+    void setFrequencies(float highpass, float lowpass) {
+        if (highpass != m_highpassFrequency) {
+            m_highpassFrequency = highpass;
+            m_highpass.design(highpass, m_sampleRate, true, highpass > kMinHighpass);
+        }
+        if (lowpass != m_lowpassFrequency) {
+            m_lowpassFrequency = lowpass;
+            m_lowpass.design(lowpass, m_sampleRate, false,
+                             lowpass < kMaxLowpass && lowpass < m_sampleRate * 0.45);
+        }
+    }
+
+    float process(float key) {
+        return m_lowpass.process(m_highpass.process(key));
+    }
+
+    // Filters numSamples key samples and returns their absolute peak
+    float processPeak(const float* key, size_t numSamples) {
+        float peak = 0.0f;
+        for (size_t i = 0; i < numSamples; ++i) {
+            peak = std::max(peak, std::abs(process(key[i])));
+        }
+        return peak;
+    }
+
+private:
+    struct Biquad {
+        bool enabled = false;
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+        float z1 = 0.0f, z2 = 0.0f;
+
+        void reset() { z1 = z2 = 0.0f; }
+
+        void design(float frequency, double sampleRate, bool highpass, bool enable) {
+            enabled = enable;
+            if (!enabled) return;
+
+            const double w0 = 2.0 * kPi * std::clamp(static_cast<double>(frequency), 10.0, sampleRate * 0.45) / sampleRate;
+            const double alpha = std::sin(w0) / (2.0 * 0.7071);
+            const double cosW0 = std::cos(w0);
+            const double a0 = 1.0 + alpha;
+
+            const double b = highpass ? (1.0 + cosW0) * 0.5 : (1.0 - cosW0) * 0.5;
+            b0 = static_cast<float>(b / a0);
+            b1 = static_cast<float>((highpass ? -2.0 * b : 2.0 * b) / a0);
+            b2 = b0;
+            a1 = static_cast<float>(-2.0 * cosW0 / a0);
+            a2 = static_cast<float>((1.0 - alpha) / a0);
+        }
+
+        float process(float x) {
+            if (!enabled) return x;
+            const float y = b0 * x + z1;
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            return y;
+        }
+    };
+
+    double m_sampleRate = 44100.0;
+    float m_highpassFrequency = -1.0f;
+    float m_lowpassFrequency = -1.0f;
+    Biquad m_highpass;
+    Biquad m_lowpass;
+};
+
+} // namespace VRMusicStudio
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "audio/processing/SimdOps.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace VRMusicStudio {
+
+// Everything at or below this peak counts as digital silence (~ -120 dBFS)
+constexpr float kSilenceThreshold = 1.0e-6f;
+
+// Tail length for nodes that may produce output from silent input
+// (generators, self-oscillating feedback); such nodes never sleep
+constexpr double kInfiniteTail = -1.0;
+
+inline bool isSilent(const float* buffer, size_t numSamples, float threshold = kSilenceThreshold) {
+    return SimdOps::peak(buffer, numSamples) <= threshold;
+}
+
+// RT60 of a recirculating loop (delay line, comb filter) that is scaled by
+// `feedback` on every pass of loopSeconds; kInfiniteTail if it never decays
+inline double rt60Seconds(double loopSeconds, double feedback) {
+    const double gain = std::abs(feedback);
+    if (gain >= 0.999) return kInfiniteTail;
+    if (gain <= 0.0) return 0.0;
+    return loopSeconds * std::log(1.0e-3) / std::log(gain);
+}
+
+// Time for a decay with the given RT60 to fall below kSilenceThreshold
+inline double tailFromRT60(double rt60) {
+    if (rt60 < 0.0) return kInfiniteTail;
+    return rt60 * std::log(static_cast<double>(kSilenceThreshold)) / std::log(1.0e-3);
+}
+
+// Tail of a feedback delay: the first repeat plus the decay of the loop
+inline double feedbackTailSeconds(double loopSeconds, double feedback) {
+    const double rt60 = rt60Seconds(loopSeconds, feedback);
+    return rt60 < 0.0 ? kInfiniteTail : loopSeconds + tailFromRT60(rt60);
+}
+
+// Sleep state of one processing node. The node keeps running while its input
+// is silent until its tail has rung out, is then skipped, and wakes up on the
+// first non-silent input block before that block is processed.
+class TailSleep {
+public:
+    // Returns true if the node has to process the current block
+    bool update(bool inputSilent, size_t numFrames, int64_t tailFrames) {
+        if (!inputSilent) {
+            m_silentFrames = 0;
+            m_sleeping = false;
+            return true;
+        }
+        if (m_sleeping) return false;
+
+        if (tailFrames >= 0 && m_silentFrames >= static_cast<uint64_t>(tailFrames)) {
+            m_sleeping = true;
+            return false;
+        }
+        m_silentFrames += numFrames;
+        return true;
+    }
+
+    void reset() {
+        m_silentFrames = 0;
+        m_sleeping = false;
+    }
+
+    bool isSleeping() const { return m_sleeping; }
+
+private:
+    uint64_t m_silentFrames = 0;
+    bool m_sleeping = false;
+};
+
+} // namespace VRMusicStudio
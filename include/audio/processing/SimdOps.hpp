@@ -0,0 +1,264 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define VRMS_SIMD_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define VRMS_SIMD_NEON 1
+#endif
+
+namespace VRMusicStudio {
+namespace SimdOps {
+
+// Block helpers for the audio hot paths. Every function handles an arbitrary
+// length (vector body + scalar tail) and works on unaligned pointers, so
+// callers can pass sub-spans of larger buffers.
+
+// dst[i] += src[i]
+inline void add(float* dst, const float* src, size_t n) {
+    size_t i = 0;
+#if defined(VRMS_SIMD_SSE)
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+    }
+#elif defined(VRMS_SIMD_NEON)
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vld1q_f32(src + i)));
+    }
+#endif
+    for (; i < n; ++i) dst[i] += src[i];
+}
+
+// dst[i] += src[i] * gain
+inline void addScaled(float* dst, const float* src, float gain, size_t n) {
+    size_t i = 0;
+#if defined(VRMS_SIMD_SSE)
+    const __m128 g = _mm_set1_ps(gain);
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+    }
+#elif defined(VRMS_SIMD_NEON)
+    const float32x4_t g = vdupq_n_f32(gain);
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), g));
+    }
+#endif
+    for (; i < n; ++i) dst[i] += src[i] * gain;
+}
+
+// dst[i] *= gain
+inline void scale(float* dst, float gain, size_t n) {
+    size_t i = 0;
+#if defined(VRMS_SIMD_SSE)
+    const __m128 g = _mm_set1_ps(gain);
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), g));
+    }
+#elif defined(VRMS_SIMD_NEON)
+    const float32x4_t g = vdupq_n_f32(gain);
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(dst + i, vmulq_f32(vld1q_f32(dst + i), g));
+    }
+#endif
+    for (; i < n; ++i) dst[i] *= gain;
+}
+
+// dst[i] *= gains[i]
+inline void multiply(float* dst, const float* gains, size_t n) {
+    size_t i = 0;
+#if defined(VRMS_SIMD_SSE)
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(gains + i)));
+    }
+#elif defined(VRMS_SIMD_NEON)
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(dst + i, vmulq_f32(vld1q_f32(dst + i), vld1q_f32(gains + i)));
+    }
+#endif
+    for (; i < n; ++i) dst[i] *= gains[i];
+}
+
+// dst[i] = dst[i] * dryGain + wet[i] * wetGain
+inline void mix(float* dst, const float* wet, float dryGain, float wetGain, size_t n) {
+    size_t i = 0;
+#if defined(VRMS_SIMD_SSE)
+    const __m128 d = _mm_set1_ps(dryGain);
+    const __m128 w = _mm_set1_ps(wetGain);
+    for (; i + 4 <= n; i += 4) {
+        const __m128 a = _mm_mul_ps(_mm_loadu_ps(dst + i), d);
+        _mm_storeu_ps(dst + i, _mm_add_ps(a, _mm_mul_ps(_mm_loadu_ps(wet + i), w)));
+    }
+#elif defined(VRMS_SIMD_NEON)
+    const float32x4_t d = vdupq_n_f32(dryGain);
+    const float32x4_t w = vdupq_n_f32(wetGain);
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(dst + i, vmlaq_f32(vmulq_f32(vld1q_f32(dst + i), d), vld1q_f32(wet + i), w));
+    }
+#endif
+    for (; i < n; ++i) dst[i] = dst[i] * dryGain + wet[i] * wetGain;
+}
+
+// max(|src[i]|)
+inline float peak(const float* src, size_t n) {
+    size_t i = 0;
+    float result = 0.0f;
+#if defined(VRMS_SIMD_SSE)
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 m = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4) {
+        m = _mm_max_ps(m, _mm_and_ps(_mm_loadu_ps(src + i), absMask));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, m);
+    result = std::fmax(std::fmax(lanes[0], lanes[1]), std::fmax(lanes[2], lanes[3]));
+#elif defined(VRMS_SIMD_NEON)
+    float32x4_t m = vdupq_n_f32(0.0f);
+    for (; i + 4 <= n; i += 4) {
+        m = vmaxq_f32(m, vabsq_f32(vld1q_f32(src + i)));
+    }
+    float lanes[4];
+    vst1q_f32(lanes, m);
+    result = std::fmax(std::fmax(lanes[0], lanes[1]), std::fmax(lanes[2], lanes[3]));
+#endif
+    for (; i < n; ++i) result = std::fmax(result, std::fabs(src[i]));
+    return result;
+}
+
+// sum(src[i]^2)
+inline float sumOfSquares(const float* src, size_t n) {
+    size_t i = 0;
+    float result = 0.0f;
+#if defined(VRMS_SIMD_SSE)
+    __m128 acc = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4) {
+        const __m128 v = _mm_loadu_ps(src + i);
+        acc = _mm_add_ps(acc, _mm_mul_ps(v, v));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, acc);
+    result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(VRMS_SIMD_NEON)
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t v = vld1q_f32(src + i);
+        acc = vmlaq_f32(acc, v, v);
+    }
+    float lanes[4];
+    vst1q_f32(lanes, acc);
+    result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+    for (; i < n; ++i) result += src[i] * src[i];
+    return result;
+}
+
+// true if no sample is NaN or +-Inf. Tests the exponent bits, so it also
+// works under -ffast-math where isfinite() may be folded away.
+inline bool allFinite(const float* src, size_t n) {
+    size_t i = 0;
+    bool finite = true;
+#if defined(VRMS_SIMD_SSE)
+    const __m128i exponentMask = _mm_set1_epi32(0x7f800000);
+    __m128i bad = _mm_setzero_si128();
+    for (; i + 4 <= n; i += 4) {
+        const __m128i bits = _mm_and_si128(_mm_castps_si128(_mm_loadu_ps(src + i)), exponentMask);
+        bad = _mm_or_si128(bad, _mm_cmpeq_epi32(bits, exponentMask));
+    }
+    finite = _mm_movemask_epi8(bad) == 0;
+#elif defined(VRMS_SIMD_NEON)
+    const uint32x4_t exponentMask = vdupq_n_u32(0x7f800000u);
+    uint32x4_t bad = vdupq_n_u32(0);
+    for (; i + 4 <= n; i += 4) {
+        const uint32x4_t bits = vandq_u32(vreinterpretq_u32_f32(vld1q_f32(src + i)), exponentMask);
+        bad = vorrq_u32(bad, vceqq_u32(bits, exponentMask));
+    }
+    uint32_t lanes[4];
+    vst1q_u32(lanes, bad);
+    finite = (lanes[0] | lanes[1] | lanes[2] | lanes[3]) == 0;
+#endif
+    for (; i < n; ++i) {
+        uint32_t bits;
+        std::memcpy(&bits, src + i, sizeof(bits));
+        finite = finite && (bits & 0x7f800000u) != 0x7f800000u;
+    }
+    return finite;
+}
+
+// Four independent lanes, e.g. four channels or voices processed side by side.
+// Recursive filters vectorize across lanes instead of across time.
+struct Float4 {
+#if defined(VRMS_SIMD_SSE)
+    __m128 v;
+    static Float4 set1(float x) { return {_mm_set1_ps(x)}; }
+    static Float4 set(float a, float b, float c, float d) { return {_mm_setr_ps(a, b, c, d)}; }
+    static Float4 load(const float* src) { return {_mm_loadu_ps(src)}; }
+    void store(float* dst) const { _mm_storeu_ps(dst, v); }
+    friend Float4 operator+(Float4 a, Float4 b) { return {_mm_add_ps(a.v, b.v)}; }
+    friend Float4 operator-(Float4 a, Float4 b) { return {_mm_sub_ps(a.v, b.v)}; }
+    friend Float4 operator*(Float4 a, Float4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+    friend Float4 operator/(Float4 a, Float4 b) { return {_mm_div_ps(a.v, b.v)}; }
+    friend Float4 min(Float4 a, Float4 b) { return {_mm_min_ps(a.v, b.v)}; }
+    friend Float4 max(Float4 a, Float4 b) { return {_mm_max_ps(a.v, b.v)}; }
+    friend Float4 trunc(Float4 a) { return {_mm_cvtepi32_ps(_mm_cvttps_epi32(a.v))}; }
+#elif defined(VRMS_SIMD_NEON)
+    float32x4_t v;
+    static Float4 set1(float x) { return {vdupq_n_f32(x)}; }
+    static Float4 set(float a, float b, float c, float d) {
+        const float lanes[4] = {a, b, c, d};
+        return {vld1q_f32(lanes)};
+    }
+    static Float4 load(const float* src) { return {vld1q_f32(src)}; }
+    void store(float* dst) const { vst1q_f32(dst, v); }
+    friend Float4 operator+(Float4 a, Float4 b) { return {vaddq_f32(a.v, b.v)}; }
+    friend Float4 operator-(Float4 a, Float4 b) { return {vsubq_f32(a.v, b.v)}; }
+    friend Float4 operator*(Float4 a, Float4 b) { return {vmulq_f32(a.v, b.v)}; }
+    friend Float4 operator/(Float4 a, Float4 b) {
+    #if defined(__aarch64__)
+        return {vdivq_f32(a.v, b.v)};
+    #else
+        float32x4_t r = vrecpeq_f32(b.v);
+        r = vmulq_f32(r, vrecpsq_f32(b.v, r));
+        r = vmulq_f32(r, vrecpsq_f32(b.v, r));
+        return {vmulq_f32(a.v, r)};
+    #endif
+    }
+    friend Float4 min(Float4 a, Float4 b) { return {vminq_f32(a.v, b.v)}; }
+    friend Float4 max(Float4 a, Float4 b) { return {vmaxq_f32(a.v, b.v)}; }
+    friend Float4 trunc(Float4 a) { return {vcvtq_f32_s32(vcvtq_s32_f32(a.v))}; }
+#else
+    float v[4];
+    static Float4 set1(float x) { return {{x, x, x, x}}; }
+    static Float4 set(float a, float b, float c, float d) { return {{a, b, c, d}}; }
+    static Float4 load(const float* src) { return {{src[0], src[1], src[2], src[3]}}; }
+    void store(float* dst) const { for (int i = 0; i < 4; ++i) dst[i] = v[i]; }
+    friend Float4 operator+(Float4 a, Float4 b) { for (int i = 0; i < 4; ++i) a.v[i] += b.v[i]; return a; }
+    friend Float4 operator-(Float4 a, Float4 b) { for (int i = 0; i < 4; ++i) a.v[i] -= b.v[i]; return a; }
+    friend Float4 operator*(Float4 a, Float4 b) { for (int i = 0; i < 4; ++i) a.v[i] *= b.v[i]; return a; }
+    friend Float4 operator/(Float4 a, Float4 b) { for (int i = 0; i < 4; ++i) a.v[i] /= b.v[i]; return a; }
+    friend Float4 min(Float4 a, Float4 b) { for (int i = 0; i < 4; ++i) a.v[i] = std::fmin(a.v[i], b.v[i]); return a; }
+    friend Float4 max(Float4 a, Float4 b) { for (int i = 0; i < 4; ++i) a.v[i] = std::fmax(a.v[i], b.v[i]); return a; }
+    friend Float4 trunc(Float4 a) { for (int i = 0; i < 4; ++i) a.v[i] = std::trunc(a.v[i]); return a; }
+#endif
+
+    static Float4 zero() { return set1(0.0f); }
+    Float4& operator+=(Float4 b) { return *this = *this + b; }
+    Float4& operator*=(Float4 b) { return *this = *this * b; }
+
+    // trunc() rounds toward zero and is only valid for |a| < 2^31
+    friend Float4 abs(Float4 a) { return max(a, zero() - a); }
+
+    // Sum of all four lanes
+    float sum() const {
+        alignas(16) float lanes[4];
+        store(lanes);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+};
+
+} // namespace SimdOps
+} // namespace VRMusicStudio
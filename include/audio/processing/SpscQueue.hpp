@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace VRMusicStudio {
+
+// Bounded single-producer/single-consumer queue for handing messages between
+// the audio thread and one worker thread. Capacity is fixed at construction,
+// push/pop never allocate or block.
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity = 0) { reset(capacity); }
+
+    // Not thread-safe: call only while neither side is running.
+    void reset(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity + 1) size <<= 1;
+        m_slots.assign(size, T{});
+        m_mask = size - 1;
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+    }
+
+    bool push(const T& value) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t next = (tail + 1) & m_mask;
+        if (next == m_head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        m_slots[tail] = value;
+        m_tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& value) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = m_slots[head];
+        m_head.store((head + 1) & m_mask, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<T> m_slots;
+    size_t m_mask = 0;
+    alignas(64) std::atomic<size_t> m_head{0};
+    alignas(64) std::atomic<size_t> m_tail{0};
+};
+
+} // namespace VRMusicStudio
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace VRMusicStudio {
+
+// Digital-waveguide models for plucked and bowed strings.
+//
+// A plucked string is an extended Karplus-Strong loop: one delay line with a
+// one-pole loss filter (brightness, T60), a first-order allpass for stiffness
+// (sharpened partials) and an allpass for the fractional part of the period.
+// It is excited with velocity-filtered noise, notched at the pluck position.
+//
+// A bowed string is split at the bow into a bridge and a nut segment. Both
+// ends reflect with inversion, the bow couples to the string through the
+// usual friction curve ("bow table") driven by bow speed and pressure.
+//
+// All strings of one instance share a body: a small bank of two-pole modal
+// resonators fed by the bridge signal. Voices and delay lines are allocated
+// in the constructor; noteOn(), noteOff(), the setters and process() are
+// allocation-free and belong to one audio thread.
+class StringModel {
+public:
+    enum class Excitation { Pluck, Bow };
+
+    static constexpr int kMaxBodyModes = 8;
+    static constexpr int kBlockSize = 64;
+
+    struct BodyMode {
+        float frequency;    // Hz
+        float decay;        // T60 in Sekunden
+        float gain;
+    };
+
+    // String, bow and body settings of one instrument. setPreset() swaps
+    // everything except excitation and lowestFrequency: those size the string
+    // (and, when bowed, nut) delay lines at construction. Notes below
+    // lowestFrequency are clamped to it.
+    struct Preset {
+        Excitation excitation = Excitation::Pluck;
+        float lowestFrequency = 40.0f;  // Hz
+        float decay = 4.0f;             // T60 der Grundfrequenz in Sekunden
+        float releaseDecay = 0.2f;      // T60 nach noteOff (gedämpft)
+        float brightness = 0.7f;        // 0 - 1, Verlustfilter
+        float stiffness = 0.0f;         // 0 - 1, Dispersion
+        float position = 0.13f;         // Zupf-/Bogenposition relativ zum Steg
+        float bodyMix = 0.5f;           // 0 = nur Saite, 1 = nur Korpus
+        int bodyModeCount = 0;
+        std::array<BodyMode, kMaxBodyModes> body{};
+    };
+
+    static Preset violin();
+    static Preset viola();
+    static Preset cello();
+    static Preset doubleBass();
+    static Preset guitar();
+    static Preset harp();
+
+    explicit StringModel(const Preset& preset, int maxVoices = 16, double sampleRate = 44100.0);
+    ~StringModel();
+
+    // Takes effect for new notes; body and loss filters update immediately
+    void setPreset(const Preset& preset);
+    const Preset& getPreset() const { return m_preset; }
+
+    // Bowed strings only: 0 - 1
+    void setBow(float pressure, float speed);
+    // Depth in semitones, rate in Hz; applies to bowed strings
+    void setVibrato(float depth, float rate);
+    void setGain(float gain) { m_gain = gain; }
+
+    // MIDI note, velocity 0 - 1. A note that is still sounding is excited
+    // again on its own string (re-pluck, re-bow) instead of taking a voice.
+    void noteOn(int note, float velocity);
+    void noteOff(int note);
+    void allNotesOff();
+
+    // Adds numSamples mono samples to `out`
+    void process(float* out, int numSamples);
+
+    int getActiveVoices() const;
+    int getMaxVoices() const { return static_cast<int>(m_voices.size()); }
+
+private:
+    struct Voice {
+        std::vector<float> bridge;      // Pluck: gesamte Schleife
+        std::vector<float> nut;         // nur Bow
+        size_t write = 0;
+        int note = -1;
+        bool active = false;
+        bool released = false;
+        uint64_t startOrder = 0;
+
+        float frequency = 0.0f;
+        float velocity = 0.0f;
+
+        // Schleife, in Samples
+        int loopDelay = 0;              // Pluck: ganzzahliger Anteil
+        double bridgeDelay = 1.0;       // Bow: Bogen bis Steg
+        double nutDelay = 1.0;          // Bow: Bogen bis Sattel
+
+        float loopGain = 0.0f;
+        float lossPole = 0.0f;
+        float lossState = 0.0f;
+        float dispersion = 0.0f;        // Allpass-Koeffizient
+        float dispersionX = 0.0f;
+        float dispersionY = 0.0f;
+        float tuning = 0.0f;            // Allpass-Koeffizient, Nachkommaanteil
+        float tuningX = 0.0f;
+        float tuningY = 0.0f;
+
+        float bowLevel = 0.0f;          // Hüllkurve der Bogengeschwindigkeit
+    };
+
+    struct ModeState {
+        float a1 = 0.0f;
+        float a2 = 0.0f;
+        float b0 = 0.0f;
+        float y1 = 0.0f;
+        float y2 = 0.0f;
+    };
+
+    Voice* allocateVoice(int note);
+    void tuneVoice(Voice& voice, float vibrato) const;
+    void pluck(Voice& voice, float velocity);
+    float renderPluck(Voice& voice, float* out, int numSamples);
+    float renderBow(Voice& voice, float* out, int numSamples);
+    void updateBody();
+    float nextNoise();
+
+    Preset m_preset;
+    double m_sampleRate;
+    size_t m_lineMask;
+    std::vector<Voice> m_voices;
+    std::vector<float> m_scratch;       // Anregung, eine Periode
+    std::array<float, kBlockSize> m_block;
+    std::array<ModeState, kMaxBodyModes> m_modes;
+
+    float m_gain;
+    float m_bowPressure;
+    float m_bowSpeed;
+    float m_vibratoDepth;
+    float m_vibratoRate;
+    double m_vibratoPhase;
+    uint64_t m_startCounter;
+    uint32_t m_noiseState;
+};
+
+} // namespace VRMusicStudio
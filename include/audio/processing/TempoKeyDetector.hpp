@@ -0,0 +1,128 @@
+#pragma once
+
+#include "audio/processing/AnalysisCache.hpp"
+#include "audio/processing/AsyncResult.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace VRMusicStudio {
+
+// Tempo, beatgrid and key of one track
+struct TrackAnalysis {
+    double bpm = 0.0;                   // 0 wenn kein Tempo gefunden
+    float tempoConfidence = 0.0f;       // 0 - 1
+    std::vector<size_t> beats;          // Samplepositionen des (konstanten) Beatgrids
+    size_t downbeat = 0;                // Index des ersten Taktanfangs in beats
+    int beatsPerBar = 4;
+
+    int key = -1;                       // Tonika als Pitch-Class (0 = C), -1 = unbekannt
+    bool minor = false;
+    float keyConfidence = 0.0f;         // Korrelation mit dem Tonart-Profil
+
+    size_t frames = 0;
+    double sampleRate = 44100.0;
+
+    std::string keyName() const;        // z. B. "F#m"
+    std::string camelot() const;        // z. B. "11A"
+};
+
+// Offline tempo and key estimation for imported audio and DJ decks.
+//
+// The file is low-passed and decimated to ~11 kHz first. Tempo comes from a
+// log-compressed spectral-flux onset envelope (1024-sample frames, 128-sample
+// hop): its FFT autocorrelation is scored with a four-tooth comb and a
+// log-Gaussian preference around `preferredBpm`, which decides between half
+// and double time. Period and phase of a constant beatgrid are then refined
+// jointly against the envelope. The downbeat is the bar phase with the
+// strongest bass onsets and chroma changes.
+//
+// The key correlates the summed chroma (4096-sample frames, 100 - 2500 Hz)
+// with the Krumhansl-Kessler major and minor profiles in all 24 rotations.
+class TempoKeyDetector {
+public:
+    struct Settings {
+        float minBpm = 70.0f;
+        float maxBpm = 180.0f;
+        float preferredBpm = 120.0f;    // z. B. 128 für House, 174 für Drum & Bass
+        int beatsPerBar = 4;
+        bool detectKey = true;
+    };
+
+    // Whole (interleaved) file, channels are mixed to mono
+    static TrackAnalysis analyze(const float* data, size_t frames, int channels,
+                                 double sampleRate, const Settings& settings);
+
+    // Harmonic mixing: same key, relative major/minor or a fifth up/down
+    // (neighbours on the Camelot wheel)
+    static bool areKeysCompatible(const TrackAnalysis& a, const TrackAnalysis& b);
+
+    // Playback ratio that brings `track` to `targetBpm`; half/double time is
+    // used when it needs less stretching
+    static double tempoRatio(const TrackAnalysis& track, double targetBpm);
+};
+
+using TrackAnalysisSlot = AsyncResult<TrackAnalysis>;
+
+// Parallel background analysis for imports. A pool of one worker per
+// hardware thread decodes (if no samples are passed in) and analyzes files;
+// results are cached in memory (least recently used entries are dropped
+// beyond kMaxMemoryEntries) and on disk, keyed by path, size and modification
+// time, or by a hash of the samples for audio without a file.
+class TempoKeyAnalyzer {
+public:
+    static constexpr size_t kMaxMemoryEntries = 1024;
+
+    static TempoKeyAnalyzer& getInstance();
+
+    ~TempoKeyAnalyzer();
+
+    // `data` may be null, the worker then decodes `path` itself
+    void request(const std::shared_ptr<TrackAnalysisSlot>& slot, const std::string& path,
+                 std::shared_ptr<const std::vector<float>> data, int channels,
+                 double sampleRate, const TempoKeyDetector::Settings& settings);
+
+    // Blocks until all queued jobs are done (batch import)
+    void waitUntilIdle();
+    size_t getPendingJobs() const;
+
+    void setCacheDirectory(const std::string& directory);
+    void clearMemoryCache();
+
+private:
+    struct Job {
+        std::weak_ptr<TrackAnalysisSlot> slot;
+        uint64_t generation = 0;
+        std::string path;
+        std::shared_ptr<const std::vector<float>> data;
+        int channels = 1;
+        double sampleRate = 44100.0;
+        TempoKeyDetector::Settings settings;
+    };
+
+    TempoKeyAnalyzer();
+    void run();
+    void process(Job& job);
+    bool decode(Job& job) const;
+    std::string makeKey(const Job& job) const;
+    static bool readAnalysis(std::istream& stream, size_t fileSize, TrackAnalysis& analysis);
+    static void writeAnalysis(std::ostream& stream, const TrackAnalysis& analysis);
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::condition_variable m_idleCondition;
+    std::mutex m_publishMutex;          // AsyncResult::publish erwartet einen Schreiber
+    std::deque<Job> m_jobs;
+    size_t m_activeJobs;
+    AnalysisCache<TrackAnalysis> m_cache;
+    bool m_shouldStop;
+    std::vector<std::thread> m_workers;
+};
+
+} // namespace VRMusicStudio
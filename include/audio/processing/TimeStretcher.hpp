@@ -0,0 +1,159 @@
+#pragma once
+
+#include "audio/processing/AsyncResult.hpp"
+#include "audio/processing/FFT.hpp"
+#include <complex>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace VRMusicStudio {
+
+// Streaming time-stretch (tempo change without pitch change).
+//
+// Phase vocoder that pulls its analysis frames from a random-access source at
+// `speed` source frames per output frame, so the caller never has to manage
+// input/output ratios. Phases are propagated from the measured instantaneous
+// frequency with identity phase locking around spectral peaks; when the
+// spectral flux marks a transient the synthesis phases are reset to the
+// analysis phases so attacks stay sharp instead of being smeared.
+//
+// The output is aligned with the source: reset(start) primes the overlap-add
+// internally, the first output sample corresponds to source frame `start` and
+// no latency has to be compensated. At speed 1 the input is reproduced exactly.
+//
+// prepare() allocates, everything else is real-time safe.
+class TimeStretcher {
+public:
+    enum class Quality {
+        Draft,      // 1024er FFT, 4x Overlap, ohne Transientenerkennung
+        Standard,   // 2048er FFT, 4x Overlap
+        High        // 4096er FFT, 8x Overlap
+    };
+
+    static constexpr double kMinSpeed = 0.125;
+    static constexpr double kMaxSpeed = 8.0;
+
+    // Interleaved source; frames outside [0, frames) read as silence unless
+    // `loop` is set, then positions wrap (also used for ring buffers)
+    struct Source {
+        const float* data = nullptr;
+        size_t frames = 0;
+        int channels = 1;
+        bool loop = false;
+    };
+
+    TimeStretcher();
+    ~TimeStretcher();
+
+    void prepare(Quality quality);
+    Quality getQuality() const { return m_quality; }
+    bool isPrepared() const { return m_fft != nullptr; }
+
+    // Next output sample corresponds to source frame `sourcePosition`
+    void reset(double sourcePosition);
+
+    // Source frames per output frame, negative values play backwards
+    void setSpeed(double speed);
+    double getSpeed() const { return m_speed; }
+
+    void process(const Source& source, float* output, size_t numFrames);
+    float next(const Source& source) {
+        if (m_fifoPos == m_hopSize) synthesizeHop(source);
+        m_sourcePosition += m_speed;
+        return m_fifo[m_fifoPos++];
+    }
+
+    // Source position of the next output sample
+    double getSourcePosition() const { return m_sourcePosition; }
+    size_t getFrameSize() const { return m_frameSize; }
+
+    // Renders a whole clip in one go (prerender path, not real-time safe)
+    static std::vector<float> render(const Source& source, double speed, Quality quality);
+
+private:
+    void synthesizeHop(const Source& source);
+    void processFrame(const Source& source);
+    void readFrame(const Source& source, long center, bool reversed);
+    bool detectTransient();
+    void propagatePhases(long analysisHop);
+
+    Quality m_quality;
+    size_t m_frameSize;
+    size_t m_hopSize;
+    size_t m_numBins;
+    float m_outputScale;
+    bool m_transients;
+
+    std::unique_ptr<RealFFT> m_fft;
+    std::vector<float> m_window;
+    std::vector<float> m_frame;
+    std::vector<std::complex<float>> m_spectrum;
+    std::vector<float> m_magnitude;
+    std::vector<float> m_phase;
+    std::vector<float> m_prevMagnitude;
+    std::vector<float> m_prevPhase;
+    std::vector<float> m_synthPhase;
+    std::vector<size_t> m_peaks;
+    std::vector<float> m_overlapAdd;
+    std::vector<float> m_fifo;
+    size_t m_fifoPos;
+
+    double m_speed;
+    double m_resetPosition;
+    double m_analysisCenter;
+    double m_sourcePosition;
+    long m_prevCenter;
+    bool m_prevReversed;
+    bool m_firstFrame;
+    size_t m_pendingPreroll;
+    size_t m_transientHold;
+};
+
+// Stretched copy of a clip for a fixed speed, produced off the audio thread
+struct StretchedClip {
+    double speed = 1.0;
+    TimeStretcher::Quality quality = TimeStretcher::Quality::Standard;
+    std::vector<float> audio;   // mono
+};
+
+using StretchSlot = AsyncResult<StretchedClip>;
+
+// Background worker that renders stretched clips, shared by all tracks.
+// Newer requests for the same slot supersede queued or running older ones.
+class TimeStretchPrerenderer {
+public:
+    static TimeStretchPrerenderer& getInstance();
+
+    ~TimeStretchPrerenderer();
+
+    void request(const std::shared_ptr<StretchSlot>& slot,
+                 std::shared_ptr<const std::vector<float>> source,
+                 double speed, TimeStretcher::Quality quality);
+    void cancel(const std::shared_ptr<StretchSlot>& slot);
+
+private:
+    struct Job {
+        std::weak_ptr<StretchSlot> slot;
+        uint64_t generation = 0;
+        std::shared_ptr<const std::vector<float>> source;
+        double speed = 1.0;
+        TimeStretcher::Quality quality = TimeStretcher::Quality::Standard;
+    };
+
+    TimeStretchPrerenderer();
+    void run();
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<Job> m_jobs;
+    bool m_shouldStop;
+    std::thread m_worker;
+};
+
+} // namespace VRMusicStudio
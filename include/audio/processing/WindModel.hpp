@@ -0,0 +1,167 @@
+#pragma once
+
+#include "audio/processing/SimdOps.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace VRMusicStudio {
+
+// Digital-waveguide models for woodwind and brass instruments.
+//
+// Every voice is a bore delay line closed by an excitation:
+//  - CylindricalReed: reed at the end of a cylindrical bore (clarinet). The
+//    inverting reflection leaves odd harmonics only.
+//  - ConicalReed: the reed splits the loop into two segments (oboe, bassoon,
+//    saxophone), which restores the even harmonics. Below a split of about
+//    0.35 the reed locks to the second resonance and the note sounds an
+//    octave high.
+//  - Jet: an air jet with its own delay and a cubic jet table (flutes). The
+//    bore is 3/2 periods long and the jet locks to its second resonance.
+//  - Lip: lips as a constant-Q resonator tuned to the note whose opening
+//    area (displacement squared) scatters mouth and bore pressure (brass).
+// The open tone holes (or the bell) are a one-pole lowpass in the reflection:
+// high partials leave the bore and only the lower ones keep the loop going.
+//
+// Voices are evaluated four at a time with SimdOps::Float4, one voice per
+// lane: reed, jet and lip tables, loss filters and envelopes run as vector
+// code, only the delay line taps are per lane. The breath follows noteOn
+// velocity, setBreath() (breath controller) and includes seeded noise, so a
+// given note sequence always renders the same output.
+//
+// Voices and delay lines are allocated in the constructor; noteOn(),
+// noteOff(), the setters and process() are allocation-free and belong to one
+// audio thread.
+class WindModel {
+public:
+    enum class Excitation { CylindricalReed, ConicalReed, Jet, Lip };
+
+    static constexpr int kLanes = 4;
+    static constexpr int kBlockSize = 64;
+
+    // Bore and excitation settings of one instrument, fixed for the lifetime
+    // of the model. lowestFrequency sets the bore and jet line lengths (with
+    // headroom for the 3/2-period flute bore and vibrato); lower notes play at
+    // lowestFrequency. The reed, jet and lip fields only affect their own
+    // excitation.
+    struct Preset {
+        Excitation excitation = Excitation::CylindricalReed;
+        float lowestFrequency = 100.0f; // Hz
+        float pressure = 0.8f;          // Blasdruck bei voller Velocity
+        float dynamics = 0.4f;          // Anteil von Velocity/Atem am Blasdruck
+        float reedOffset = 0.7f;        // Rohrblatt: Öffnung in Ruhe
+        float reedSlope = -0.3f;        // Rohrblatt: Steifigkeit
+        float split = 0.35f;            // Rohrblattposition (konisch) bzw. Jet-/Rohrlänge
+        float lipTension = 1.0f;        // Lippenresonanz relativ zur Note
+        float toneHoleCutoff = 2000.0f; // Hz, Grenzfrequenz der offenen Tonlöcher/des Schallstücks
+        float reflection = 0.95f;       // Verlust pro Umlauf
+        float noise = 0.2f;             // Atemrauschen
+        float attack = 0.02f;           // Sekunden
+        float release = 0.05f;          // Sekunden
+        float gain = 1.0f;
+    };
+
+    static Preset flute();
+    static Preset recorder();
+    static Preset oboe();
+    static Preset englishHorn();
+    static Preset clarinet();
+    static Preset bassClarinet();
+    static Preset bassoon();
+    static Preset saxophone();
+    static Preset horn();
+    static Preset trumpet();
+    static Preset trombone();
+    static Preset tuba();
+
+    // maxVoices is rounded up to a multiple of kLanes
+    explicit WindModel(const Preset& preset, int maxVoices = 8, double sampleRate = 44100.0);
+    ~WindModel();
+
+    const Preset& getPreset() const { return m_preset; }
+
+    // Breath pressure relative to the preset, 1 = nominal, 0 - 2. Sounding
+    // notes follow immediately (breath controller).
+    void setBreath(float breath);
+    // Depth in semitones, rate in Hz
+    void setVibrato(float depth, float rate);
+    // 0 - 1, ramped per block
+    void setExpression(float expression);
+    void setGain(float gain) { m_gain = gain; }
+    // Monophonic: a new note changes the fingering of the sounding voice
+    // instead of attacking a new one
+    void setLegato(bool legato) { m_legato = legato; }
+
+    // MIDI note, velocity 0 - 1
+    void noteOn(int note, float velocity);
+    void noteOff(int note);
+    void allNotesOff();
+
+    // Adds numSamples mono samples to `out`
+    void process(float* out, int numSamples);
+
+    int getActiveVoices() const;
+    int getMaxVoices() const { return static_cast<int>(m_voices.size()); }
+
+private:
+    struct Voice {
+        int note = -1;
+        bool active = false;
+        bool released = false;
+        uint64_t startOrder = 0;
+        float frequency = 0.0f;
+        float velocity = 0.0f;
+    };
+
+    // Zustand pro Stimme als SoA, je kLanes Stimmen bilden eine Gruppe
+    struct Lanes {
+        std::vector<float> envelope;
+        std::vector<float> level;       // Ausgangspegel aus Velocity und Atem
+        std::vector<float> boreDelay;   // Samples
+        std::vector<float> auxDelay;    // Jet bzw. zweites Rohrsegment
+        std::vector<float> loss;        // Tonloch-Tiefpass
+        std::vector<float> dcIn;
+        std::vector<float> dcOut;
+        std::vector<float> lipB0;
+        std::vector<float> lipA1;
+        std::vector<float> lipA2;
+        std::vector<float> lipX1;
+        std::vector<float> lipX2;
+        std::vector<float> lipY1;
+        std::vector<float> lipY2;
+        std::vector<float> energy;      // Blockenergie der Ausgabe
+    };
+
+    Voice* allocateVoice(int note);
+    void resetVoice(size_t index);
+    void tuneVoice(size_t index, float vibrato);
+    void renderGroup(size_t group, int numSamples);
+    float nextNoise();
+
+    Preset m_preset;
+    double m_sampleRate;
+    size_t m_lineSize;
+    size_t m_lineMask;
+    size_t m_write;
+    std::vector<Voice> m_voices;
+    Lanes m_lanes;
+    std::vector<float> m_bore;          // m_voices.size() Leitungen à m_lineSize
+    std::vector<float> m_aux;
+    std::array<float, kBlockSize> m_block;
+
+    float m_lossPole;
+    float m_breath;
+    float m_vibratoDepth;
+    float m_vibratoRate;
+    double m_vibratoPhase;
+    bool m_vibratoApplied;      // Stimmen sind noch mit Vibrato gestimmt
+    float m_expression;
+    float m_expressionTarget;
+    float m_gain;
+    bool m_legato;
+    uint64_t m_startCounter;
+    uint32_t m_noiseState;
+};
+
+} // namespace VRMusicStudio
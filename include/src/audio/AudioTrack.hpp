@@ -5,6 +5,8 @@
 #include <vector>
 #include <mutex>
 #include "PluginInterface.hpp"
+#include "audio/processing/SilenceDetector.hpp"
+#include "audio/processing/TimeStretcher.hpp"
 
 namespace VR_DAW {
 
@@ -47,6 +49,16 @@ public:
     bool isMuted() const;
     void setPan(float pan);
     float getPan() const;
+    // Letzter Puffer war digitale Stille (z.B. gestoppt und alle Plugins
+    // ausgeklungen); Mixer können die Spur dann überspringen
+    bool isOutputSilent() const;
+
+    // Tempo-Anpassung: Clips mit bekanntem Tempo folgen dem Projekttempo
+    void setClipTempo(double bpm);          // 0 = Tempo nicht folgen
+    double getClipTempo() const;
+    void setProjectTempo(double bpm);
+    void setTimeStretchQuality(VRMusicStudio::TimeStretcher::Quality quality);
+    bool isTimeStretchPrerendered() const;
 
 private:
     std::string id;
@@ -59,11 +71,26 @@ private:
     bool muted;
     float pan;
     std::vector<std::shared_ptr<PluginInterface>> plugins;
+    std::vector<VRMusicStudio::TailSleep> pluginSleep;     // parallel zu plugins, in add/removePlugin gepflegt
+    double sampleRate;
+    bool outputSilent;
     mutable std::mutex mutex;
 
+    // Time-Stretch: vorgerenderter Clip aus dem Hintergrund-Thread, bis er
+    // fertig ist streamt der Stretcher live
+    double clipTempo;
+    double projectTempo;
+    VRMusicStudio::TimeStretcher::Quality stretchQuality;
+    VRMusicStudio::TimeStretcher stretcher;
+    std::shared_ptr<VRMusicStudio::StretchSlot> stretchSlot;
+    bool stretcherNeedsReset;
+
     // Hilfsfunktionen
     void generateId();
-    void processPlugins(float* buffer, unsigned long framesPerBuffer);
+    bool processPlugins(float* buffer, unsigned long framesPerBuffer);
+    double getStretchSpeed() const;
+    void requestPrerender();
+    void renderStretched(float* buffer, unsigned long framesPerBuffer, double speed);
 };
 
 } // namespace VR_DAW 
\ No newline at end of file
@@ -0,0 +1,398 @@
+#pragma once
+
+#include "audio/processing/DspMath.hpp"
+#include "audio/processing/SimdOps.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace ConsoleDSP {
+
+// Klangcharakter eines Mischpults. Alle Modelle teilen denselben Kanalzug
+// (Vorverstärker -> Vier-Band-EQ -> Übertrager -> Fader/Pan -> Bus-Kompressor),
+// nur diese Konstanten unterscheiden sich.
+struct Character {
+    // Vorverstärker
+    float preampDrive;          // Aussteuerung in die Sättigungskennlinie
+    float preampAsymmetry;      // Versatz der Kennlinie, erzeugt geradzahlige Obertöne
+
+    // Vier-Band-EQ
+    float eqRangeDb;            // maximaler Boost/Cut
+    float lowFreq;
+    bool lowShelf;              // sonst Glocke
+    float lowMidFreq;
+    float highMidFreq;
+    float midQ;
+    bool proportionalQ;         // Güte wächst mit dem Betrag der Verstärkung
+    float highFreq;
+    bool highShelf;
+
+    // Übertrager
+    float transformerDrive;
+    float transformerBumpFreq;  // Resonanz im Bass
+    float transformerBumpDb;
+    float transformerRolloff;   // Hz, Tiefpass erster Ordnung
+
+    // Bus-Kompressor
+    float busAttackMs;
+    float busReleaseMs;
+    float busRatio;
+    float busKneeDb;
+};
+
+inline constexpr Character kSSL4000G     {0.6f, 0.05f, 15.0f, 100.0f, true, 600.0f, 3000.0f, 1.0f, false, 8000.0f, true, 0.20f, 40.0f, 0.5f, 40000.0f, 10.0f, 400.0f, 4.0f, 2.0f};
+inline constexpr Character kSSL9000J     {0.3f, 0.02f, 15.0f, 80.0f, true, 500.0f, 4000.0f, 0.9f, false, 10000.0f, true, 0.05f, 30.0f, 0.2f, 60000.0f, 3.0f, 300.0f, 4.0f, 2.0f};
+inline constexpr Character kNeve88RS     {0.8f, 0.12f, 18.0f, 110.0f, true, 700.0f, 4800.0f, 0.7f, true, 12000.0f, true, 0.45f, 60.0f, 1.2f, 25000.0f, 20.0f, 800.0f, 2.5f, 6.0f};
+inline constexpr Character kNeveVR       {0.7f, 0.10f, 16.0f, 80.0f, true, 700.0f, 3200.0f, 0.7f, true, 10000.0f, true, 0.40f, 50.0f, 1.0f, 24000.0f, 15.0f, 600.0f, 3.0f, 6.0f};
+inline constexpr Character kAPI1608      {0.9f, 0.06f, 12.0f, 100.0f, false, 400.0f, 2500.0f, 0.8f, true, 10000.0f, true, 0.35f, 70.0f, 0.8f, 30000.0f, 5.0f, 200.0f, 4.0f, 3.0f};
+inline constexpr Character kAPI2448      {0.8f, 0.05f, 12.0f, 50.0f, false, 800.0f, 3000.0f, 0.8f, true, 12000.0f, true, 0.30f, 60.0f, 0.6f, 35000.0f, 5.0f, 250.0f, 3.0f, 3.0f};
+inline constexpr Character kStuderA800   {1.0f, 0.03f, 12.0f, 80.0f, true, 400.0f, 2500.0f, 0.7f, false, 10000.0f, true, 0.60f, 50.0f, 2.0f, 18000.0f, 30.0f, 500.0f, 2.0f, 8.0f};
+inline constexpr Character kStuderJ37    {1.1f, 0.08f, 10.0f, 70.0f, true, 500.0f, 2000.0f, 0.6f, false, 8000.0f, true, 0.70f, 45.0f, 2.5f, 14000.0f, 40.0f, 600.0f, 2.0f, 10.0f};
+inline constexpr Character kMidasXL4     {0.4f, 0.03f, 15.0f, 80.0f, true, 400.0f, 2500.0f, 1.0f, false, 12000.0f, true, 0.15f, 35.0f, 0.3f, 40000.0f, 10.0f, 300.0f, 3.0f, 4.0f};
+inline constexpr Character kMidasHeritage{0.45f, 0.03f, 15.0f, 80.0f, true, 500.0f, 3000.0f, 1.0f, false, 12000.0f, true, 0.20f, 40.0f, 0.4f, 35000.0f, 10.0f, 350.0f, 3.0f, 4.0f};
+
+// Einstellungen eines Kanalzugs
+struct ChannelStrip {
+    float inputGainDb = 0.0f;
+    float eqLowDb = 0.0f;
+    float eqLowMidDb = 0.0f;
+    float eqHighMidDb = 0.0f;
+    float eqHighDb = 0.0f;
+    float volume = 1.0f;        // Fader, linear
+    float pan = 0.0f;           // -1 (links) bis 1 (rechts)
+    bool enabled = true;
+};
+
+namespace detail {
+
+struct BiquadCoefficients {
+    float b0, b1, b2, a1, a2;
+};
+
+enum class BandShape { Bell, LowShelf, HighShelf };
+
+// RBJ-Cookbook, normiert auf a0 = 1
+inline BiquadCoefficients designBand(BandShape shape, double freq, double q, double gainDb, double sampleRate) {
+    freq = std::min(freq, sampleRate * 0.45);
+    const double a = std::pow(10.0, gainDb / 40.0);
+    const double w0 = 2.0 * VRMusicStudio::kPi * freq / sampleRate;
+    const double cosW = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+    double b0, b1, b2, a0, a1, a2;
+
+    if (shape == BandShape::Bell) {
+        b0 = 1.0 + alpha * a;
+        b1 = -2.0 * cosW;
+        b2 = 1.0 - alpha * a;
+        a0 = 1.0 + alpha / a;
+        a1 = -2.0 * cosW;
+        a2 = 1.0 - alpha / a;
+    } else {
+        const double sign = shape == BandShape::LowShelf ? 1.0 : -1.0;
+        const double root = 2.0 * std::sqrt(a) * alpha;
+        b0 = a * ((a + 1.0) - sign * (a - 1.0) * cosW + root);
+        b1 = sign * 2.0 * a * ((a - 1.0) - sign * (a + 1.0) * cosW);
+        b2 = a * ((a + 1.0) - sign * (a - 1.0) * cosW - root);
+        a0 = (a + 1.0) + sign * (a - 1.0) * cosW + root;
+        a1 = -sign * 2.0 * ((a - 1.0) + sign * (a + 1.0) * cosW);
+        a2 = (a + 1.0) + sign * (a - 1.0) * cosW - root;
+    }
+
+    return {static_cast<float>(b0 / a0), static_cast<float>(b1 / a0), static_cast<float>(b2 / a0),
+            static_cast<float>(a1 / a0), static_cast<float>(a2 / a0)};
+}
+
+// Weiche Sättigung (rationale tanh-Näherung, ab |x| = 3 begrenzt)
+inline VRMusicStudio::SimdOps::Float4 saturate(VRMusicStudio::SimdOps::Float4 x) {
+    using Float4 = VRMusicStudio::SimdOps::Float4;
+    const Float4 t = min(max(x, Float4::set1(-3.0f)), Float4::set1(3.0f));
+    const Float4 t2 = t * t;
+    return t * (Float4::set1(27.0f) + t2) / (Float4::set1(27.0f) + Float4::set1(9.0f) * t2);
+}
+
+inline float saturate(float x) {
+    const float t = std::clamp(x, -3.0f, 3.0f);
+    return t * (27.0f + t * t) / (27.0f + 9.0f * t * t);
+}
+
+} // namespace detail
+
+// Mischpult mit beliebig vielen Mono-Kanalzügen auf einen Stereo-Bus.
+// Je vier Kanäle laufen als Lanes eines SIMD-Vektors durch denselben
+// Kanalzug, so dass auch die rekursiven Filter vektorisiert werden.
+template <const Character& Model>
+class ConsoleDesk {
+public:
+    static constexpr size_t kLanes = 4;
+    static constexpr size_t kBands = 4;
+
+    ConsoleDesk() { prepare(44100.0, 0); }
+
+    void prepare(double sampleRate, int numChannels) {
+        m_sampleRate = sampleRate;
+        m_numChannels = std::max(0, numChannels);
+        m_strips.assign(m_numChannels, ChannelStrip());
+        m_groups.assign((m_numChannels + kLanes - 1) / kLanes, Group());
+
+        // Vorverstärker: Kleinsignalverstärkung auf 1 normieren
+        const float drive = Model.preampDrive;
+        const float offset = Model.preampAsymmetry;
+        const float epsilon = 1.0e-3f;
+        const float slope = (detail::saturate(offset + epsilon) - detail::saturate(offset - epsilon)) / (2.0f * epsilon);
+        m_preampOffset = detail::saturate(offset);
+        m_preampMakeup = 1.0f / (drive * slope);
+
+        const auto bump = detail::designBand(detail::BandShape::Bell, Model.transformerBumpFreq, 0.7,
+                                             Model.transformerBumpDb, sampleRate);
+        m_bump = bump;
+
+        const double rolloff = std::min(static_cast<double>(Model.transformerRolloff), sampleRate * 0.45);
+        m_lowpassCoeff = static_cast<float>(1.0 - std::exp(-VRMusicStudio::kTwoPi * rolloff / sampleRate));
+        m_dcCoeff = static_cast<float>(std::exp(-VRMusicStudio::kTwoPi * 5.0 / sampleRate));
+
+        m_busAttack = static_cast<float>(1.0 - std::exp(-1.0 / (Model.busAttackMs * 0.001 * sampleRate)));
+        m_busRelease = static_cast<float>(1.0 - std::exp(-1.0 / (Model.busReleaseMs * 0.001 * sampleRate)));
+        m_busEnvelope = 0.0f;
+        m_busGainReductionDb = 0.0f;
+
+        for (int channel = 0; channel < m_numChannels; ++channel) {
+            updateChannel(channel);
+        }
+    }
+
+    int getNumChannels() const { return m_numChannels; }
+
+    void setChannel(int channel, const ChannelStrip& strip) {
+        if (channel < 0 || channel >= m_numChannels) return;
+        m_strips[channel] = strip;
+        updateChannel(channel);
+    }
+
+    const ChannelStrip& getChannel(int channel) const { return m_strips[channel]; }
+
+    void setBusCompression(float amount) { m_busAmount = std::clamp(amount, 0.0f, 1.0f); }
+    void setMasterVolume(float volume) { m_masterVolume = volume; }
+    float getBusGainReductionDb() const { return m_busGainReductionDb; }
+
+    // inputs: numChannels Mono-Kanäle; left/right werden überschrieben
+    void process(const float* const* inputs, float* left, float* right, size_t numFrames) {
+        for (size_t offset = 0; offset < numFrames; offset += kChunk) {
+            const size_t frames = std::min(kChunk, numFrames - offset);
+            for (size_t i = 0; i < frames; ++i) {
+                m_busLeft[i] = Float4::zero();
+                m_busRight[i] = Float4::zero();
+            }
+            for (size_t g = 0; g < m_groups.size(); ++g) {
+                processGroup(g, inputs, offset, frames);
+            }
+            processBus(left + offset, right + offset, frames);
+        }
+    }
+
+private:
+    using Float4 = VRMusicStudio::SimdOps::Float4;
+    static constexpr size_t kChunk = 256;
+
+    // Zustand und Koeffizienten von vier Kanälen, lane-weise abgelegt
+    struct alignas(16) Group {
+        float inputGain[kLanes] = {};
+        float gainLeft[kLanes] = {};
+        float gainRight[kLanes] = {};
+        float eq[kBands][5][kLanes] = {};
+        float eqState[kBands][2][kLanes] = {};
+        float bumpState[2][kLanes] = {};
+        float lowpassState[kLanes] = {};
+        float dcState[2][kLanes] = {};
+        bool active = false;
+    };
+
+    void updateChannel(int channel) {
+        Group& group = m_groups[channel / kLanes];
+        const size_t lane = channel % kLanes;
+        const ChannelStrip& strip = m_strips[channel];
+
+        // Konstante Leistung beim Panorama
+        const float angle = (std::clamp(strip.pan, -1.0f, 1.0f) + 1.0f) * 0.25f * static_cast<float>(VRMusicStudio::kPi);
+        const float fader = strip.enabled ? strip.volume : 0.0f;
+        group.inputGain[lane] = strip.enabled ? std::pow(10.0f, strip.inputGainDb / 20.0f) : 0.0f;
+        group.gainLeft[lane] = fader * std::cos(angle);
+        group.gainRight[lane] = fader * std::sin(angle);
+
+        const float range = Model.eqRangeDb;
+        const float gains[kBands] = {
+            std::clamp(strip.eqLowDb, -range, range),
+            std::clamp(strip.eqLowMidDb, -range, range),
+            std::clamp(strip.eqHighMidDb, -range, range),
+            std::clamp(strip.eqHighDb, -range, range)
+        };
+        const float freqs[kBands] = {Model.lowFreq, Model.lowMidFreq, Model.highMidFreq, Model.highFreq};
+        const detail::BandShape shapes[kBands] = {
+            Model.lowShelf ? detail::BandShape::LowShelf : detail::BandShape::Bell,
+            detail::BandShape::Bell,
+            detail::BandShape::Bell,
+            Model.highShelf ? detail::BandShape::HighShelf : detail::BandShape::Bell
+        };
+
+        for (size_t band = 0; band < kBands; ++band) {
+            double q = shapes[band] == detail::BandShape::Bell ? Model.midQ : 0.707;
+            if (Model.proportionalQ && shapes[band] == detail::BandShape::Bell) {
+                q *= 0.5 + 1.5 * std::fabs(gains[band]) / range;
+            }
+            const auto c = detail::designBand(shapes[band], freqs[band], q, gains[band], m_sampleRate);
+            group.eq[band][0][lane] = c.b0;
+            group.eq[band][1][lane] = c.b1;
+            group.eq[band][2][lane] = c.b2;
+            group.eq[band][3][lane] = c.a1;
+            group.eq[band][4][lane] = c.a2;
+        }
+
+        group.active = false;
+        const size_t first = (channel / kLanes) * kLanes;
+        for (size_t c = first; c < std::min(first + kLanes, static_cast<size_t>(m_numChannels)); ++c) {
+            group.active = group.active || m_strips[c].enabled;
+        }
+    }
+
+    void processGroup(size_t index, const float* const* inputs, size_t offset, size_t frames) {
+        Group& group = m_groups[index];
+        if (!group.active) return;
+
+        const float* lanes[kLanes];
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+            const size_t channel = index * kLanes + lane;
+            lanes[lane] = channel < static_cast<size_t>(m_numChannels) ? inputs[channel] + offset : m_silence;
+        }
+
+        // Koeffizienten und Zustände für den ganzen Block in Register laden
+        const Float4 inputGain = Float4::load(group.inputGain);
+        const Float4 gainLeft = Float4::load(group.gainLeft);
+        const Float4 gainRight = Float4::load(group.gainRight);
+        Float4 eq[kBands][5];
+        Float4 eqState[kBands][2];
+        for (size_t band = 0; band < kBands; ++band) {
+            for (size_t k = 0; k < 5; ++k) eq[band][k] = Float4::load(group.eq[band][k]);
+            eqState[band][0] = Float4::load(group.eqState[band][0]);
+            eqState[band][1] = Float4::load(group.eqState[band][1]);
+        }
+        Float4 bump1 = Float4::load(group.bumpState[0]);
+        Float4 bump2 = Float4::load(group.bumpState[1]);
+        Float4 lowpass = Float4::load(group.lowpassState);
+        Float4 dcInput = Float4::load(group.dcState[0]);
+        Float4 dcOutput = Float4::load(group.dcState[1]);
+
+        const Float4 drive = Float4::set1(Model.preampDrive);
+        const Float4 asymmetry = Float4::set1(Model.preampAsymmetry);
+        const Float4 preampOffset = Float4::set1(m_preampOffset);
+        const Float4 preampMakeup = Float4::set1(m_preampMakeup);
+        const float transformerDrive = std::max(Model.transformerDrive, 1.0e-3f);
+        const Float4 transDrive = Float4::set1(transformerDrive);
+        const Float4 transMakeup = Float4::set1(1.0f / transformerDrive);
+        const Float4 b0 = Float4::set1(m_bump.b0), b1 = Float4::set1(m_bump.b1), b2 = Float4::set1(m_bump.b2);
+        const Float4 a1 = Float4::set1(m_bump.a1), a2 = Float4::set1(m_bump.a2);
+        const Float4 lowpassCoeff = Float4::set1(m_lowpassCoeff);
+        const Float4 dcCoeff = Float4::set1(m_dcCoeff);
+        // Kleiner Gleichanteil gegen Denormals, der DC-Blocker entfernt ihn wieder
+        const Float4 denormalGuard = Float4::set1(1.0e-18f);
+
+        for (size_t i = 0; i < frames; ++i) {
+            Float4 x = Float4::set(lanes[0][i], lanes[1][i], lanes[2][i], lanes[3][i]);
+            x = x * inputGain + denormalGuard;
+
+            // Vorverstärker
+            x = (detail::saturate(x * drive + asymmetry) - preampOffset) * preampMakeup;
+
+            // Vier-Band-EQ (transponierte Direktform II)
+            for (size_t band = 0; band < kBands; ++band) {
+                const Float4 y = eq[band][0] * x + eqState[band][0];
+                eqState[band][0] = eq[band][1] * x - eq[band][3] * y + eqState[band][1];
+                eqState[band][1] = eq[band][2] * x - eq[band][4] * y;
+                x = y;
+            }
+
+            // Übertrager: Sättigung, Bassresonanz, Höhenabfall
+            x = detail::saturate(x * transDrive) * transMakeup;
+            const Float4 y = b0 * x + bump1;
+            bump1 = b1 * x - a1 * y + bump2;
+            bump2 = b2 * x - a2 * y;
+            lowpass += (y - lowpass) * lowpassCoeff;
+
+            // DC-Blocker gegen den Gleichanteil der asymmetrischen Kennlinie
+            const Float4 out = lowpass - dcInput + dcCoeff * dcOutput;
+            dcInput = lowpass;
+            dcOutput = out;
+
+            m_busLeft[i] += out * gainLeft;
+            m_busRight[i] += out * gainRight;
+        }
+
+        for (size_t band = 0; band < kBands; ++band) {
+            eqState[band][0].store(group.eqState[band][0]);
+            eqState[band][1].store(group.eqState[band][1]);
+        }
+        bump1.store(group.bumpState[0]);
+        bump2.store(group.bumpState[1]);
+        lowpass.store(group.lowpassState);
+        dcInput.store(group.dcState[0]);
+        dcOutput.store(group.dcState[1]);
+    }
+
+    void processBus(float* left, float* right, size_t frames) {
+        const float thresholdDb = -24.0f * m_busAmount;
+        const float slope = 1.0f / Model.busRatio - 1.0f;
+        const float knee = Model.busKneeDb;
+        const float makeupDb = -thresholdDb * (1.0f - 1.0f / Model.busRatio) * 0.5f;
+
+        for (size_t i = 0; i < frames; ++i) {
+            float l = m_busLeft[i].sum();
+            float r = m_busRight[i].sum();
+
+            if (m_busAmount > 0.0f) {
+                // Gekoppelter Detektor auf dem Stereo-Bus
+                const float level = std::max(std::fabs(l), std::fabs(r));
+                const float coeff = level > m_busEnvelope ? m_busAttack : m_busRelease;
+                m_busEnvelope += (level - m_busEnvelope) * coeff;
+
+                const float over = 20.0f * std::log10(m_busEnvelope + 1.0e-9f) - thresholdDb;
+                float reduction = 0.0f;
+                if (2.0f * over >= knee) {
+                    reduction = slope * over;
+                } else if (2.0f * over > -knee) {
+                    const float x = over + knee * 0.5f;
+                    reduction = slope * x * x / (2.0f * knee);
+                }
+                m_busGainReductionDb = reduction;
+                const float gain = std::pow(10.0f, (reduction + makeupDb) / 20.0f);
+                l *= gain;
+                r *= gain;
+            }
+
+            left[i] = l * m_masterVolume;
+            right[i] = r * m_masterVolume;
+        }
+    }
+
+    double m_sampleRate = 44100.0;
+    int m_numChannels = 0;
+    std::vector<ChannelStrip> m_strips;
+    std::vector<Group> m_groups;
+
+    float m_preampOffset = 0.0f;
+    float m_preampMakeup = 1.0f;
+    detail::BiquadCoefficients m_bump{1.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    float m_lowpassCoeff = 1.0f;
+    float m_dcCoeff = 0.0f;
+
+    float m_busAmount = 0.0f;
+    float m_masterVolume = 1.0f;
+    float m_busAttack = 0.0f;
+    float m_busRelease = 0.0f;
+    float m_busEnvelope = 0.0f;
+    float m_busGainReductionDb = 0.0f;
+
+    Float4 m_busLeft[kChunk];
+    Float4 m_busRight[kChunk];
+    float m_silence[kChunk] = {};   // Eingang für unbelegte Lanes
+};
+
+} // namespace ConsoleDSP
@@ -6,8 +6,22 @@
 #include <memory>
 #include <torch/torch.h>
 
+// Schlaginstrumente über native Modalsynthese (ModalBank), gespielt mit
+// noteOn/noteOff; das Drum-Kit folgt der General-MIDI-Drum-Map. Die
+// KI-Modelle sind eine optionale Veredelung für das Offline-Rendering.
 class PercussionInstruments {
 public:
+    enum class Instrument {
+        DrumKit,
+        Timpani,
+        Cymbals,
+        Marimba,
+        Xylophone,
+        Vibraphone,
+        Glockenspiel,
+        TubularBells
+    };
+
     struct DrumKit {
         float volume;
         float pan;
@@ -75,6 +89,17 @@ public:
     PercussionInstruments();
     ~PercussionInstruments();
 
+    // velocity 0 - 127; noteOff dämpft nur Instrumente mit Dämpfer
+    // (Vibraphon, Röhrenglocken, Pauken, Becken)
+    void noteOn(Instrument instrument, int note, int velocity);
+    void noteOff(Instrument instrument, int note);
+    void allNotesOff();
+
+    // KI-Modelle statt Modalsynthese. Lädt die Modelle beim ersten
+    // Einschalten, daher nicht im Audio-Thread aufrufen.
+    void setNeuralEnhancement(bool enabled);
+    bool isNeuralEnhancementEnabled() const;
+
     void setDrumKitParams(const DrumKit& params);
     void setTimpaniParams(const Timpani& params);
     void setCymbalsParams(const Cymbals& params);
@@ -4,10 +4,23 @@
 #include <string>
 #include <functional>
 #include <memory>
-#include <torch/torch.h>
+#include "ConsoleStrip.hpp"
 
 class ProfessionalMixers {
 public:
+    enum class Console {
+        SSL4000G,
+        SSL9000J,
+        Neve88RS,
+        NeveVR,
+        API1608,
+        API2448,
+        StuderA800,
+        StuderJ37,
+        MidasXL4,
+        MidasHeritage
+    };
+
     // SSL Mischpulte
     struct SSL4000G {
         float volume;
@@ -136,6 +149,8 @@ public:
     ProfessionalMixers();
     ~ProfessionalMixers();
 
+    void setSampleRate(double sampleRate);
+
     // Parameter-Setter für alle Mischpulte
     void setSSL4000GParams(const SSL4000G& params);
     void setSSL9000JParams(const SSL9000J& params);
@@ -148,7 +163,9 @@ public:
     void setMidasXL4Params(const MidasXL4& params);
     void setMidasHeritageParams(const MidasHeritage& params);
 
-    // Audio-Verarbeitung für alle Mischpulte
+    // Audio-Verarbeitung für alle Mischpulte: der Buffer ist Stereo (interleaved)
+    // und läuft durch zwei Kanalzüge des jeweiligen Pults. eqMid wirkt auf beide
+    // Mittenbänder, compression steuert den Bus-Kompressor.
     void processSSL4000G(std::vector<float>& buffer);
     void processSSL9000J(std::vector<float>& buffer);
     void processNeve88RS(std::vector<float>& buffer);
@@ -160,6 +177,13 @@ public:
     void processMidasXL4(std::vector<float>& buffer);
     void processMidasHeritage(std::vector<float>& buffer);
 
+    // Komplettes Pult: numChannels Mono-Kanalzüge auf einen Stereo-Bus
+    void setDeskChannelCount(Console console, int numChannels);
+    void setDeskChannel(Console console, int channel, const ConsoleDSP::ChannelStrip& strip);
+    void setDeskBusCompression(Console console, float amount);
+    void setDeskMasterVolume(Console console, float volume);
+    void processDesk(Console console, const float* const* inputs, float* left, float* right, size_t numFrames);
+
     // Callback-Setter für alle Mischpulte
     void setSSL4000GCallback(std::function<void(const std::vector<float>&)> callback);
     void setSSL900JCallback(std::function<void(const std::vector<float>&)> callback);
@@ -3,12 +3,26 @@
 #include <vector>
 #include <string>
 #include <functional>
+#include <memory>
 #include <torch/script.h>
 
 namespace VRMusicStudio {
 
+// Streich- und Zupfinstrumente. Alle Instrumente klingen über native
+// Waveguide-Modelle (StringModel) und werden mit noteOn/noteOff gespielt;
+// die KI-Modelle sind eine optionale Veredelung für das Offline-Rendering.
 class StringInstruments {
 public:
+    enum class Instrument {
+        Violin,
+        Viola,
+        Cello,
+        DoubleBass,
+        Guitar,
+        Harp,
+        StringOrchestra
+    };
+
     // Violine Struktur
     struct Violin {
         float bowPressure;
@@ -68,9 +82,44 @@ public:
         bool enabled;
     };
 
+    // Gitarre Struktur
+    struct Guitar {
+        float pluckPosition;    // relativ zum Steg
+        float brightness;
+        float sustain;          // T60 in Sekunden
+        float bodyMix;
+        float volume;
+        float reverb;
+        float delay;
+        bool enabled;
+    };
+
+    // Harfe Struktur
+    struct Harp {
+        float pluckPosition;
+        float brightness;
+        float sustain;
+        float bodyMix;
+        float volume;
+        float reverb;
+        float delay;
+        bool enabled;
+    };
+
     StringInstruments();
     ~StringInstruments();
 
+    // Noten, velocity 0 - 127. Das Streichorchester verteilt Noten nach
+    // Tonumfang auf seine Register.
+    void noteOn(Instrument instrument, int note, int velocity);
+    void noteOff(Instrument instrument, int note);
+    void allNotesOff();
+
+    // KI-Modelle statt Waveguide (Gitarre und Harfe haben keins). Lädt die
+    // Modelle beim ersten Einschalten, daher nicht im Audio-Thread aufrufen.
+    void setNeuralEnhancement(bool enabled);
+    bool isNeuralEnhancementEnabled() const;
+
     // Violine Methoden
     void setViolin(const Violin& params);
     void processViolin(float* buffer, int numSamples);
@@ -96,6 +145,16 @@ public:
     void processStringOrchestra(float* buffer, int numSamples);
     void setStringOrchestraCallback(std::function<void(const std::vector<float>&)> callback);
 
+    // Gitarre Methoden
+    void setGuitar(const Guitar& params);
+    void processGuitar(float* buffer, int numSamples);
+    void setGuitarCallback(std::function<void(const std::vector<float>&)> callback);
+
+    // Harfe Methoden
+    void setHarp(const Harp& params);
+    void processHarp(float* buffer, int numSamples);
+    void setHarpCallback(std::function<void(const std::vector<float>&)> callback);
+
 private:
     struct Impl;
     std::unique_ptr<Impl> pImpl;
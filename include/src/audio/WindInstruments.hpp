@@ -3,12 +3,28 @@
 #include <vector>
 #include <string>
 #include <functional>
+#include <memory>
 #include <torch/script.h>
 
 namespace VRMusicStudio {
 
+// Holz- und Blechblasinstrumente. Alle Instrumente klingen über native
+// Waveguide-Modelle (WindModel) und werden mit noteOn/noteOff und
+// MIDI-Controllern gespielt; die KI-Modelle sind eine optionale Veredelung
+// für das Offline-Rendering.
 class WindInstruments {
 public:
+    enum class Instrument {
+        Flute,
+        Oboe,
+        Clarinet,
+        Bassoon,
+        Horn,
+        Trumpet,
+        Trombone,
+        Tuba
+    };
+
     // Flöte Struktur
     struct Flute {
         float breathPressure;
@@ -100,6 +116,19 @@ public:
     WindInstruments();
     ~WindInstruments();
 
+    // Noten, velocity 0 - 127
+    void noteOn(Instrument instrument, int note, int velocity);
+    void noteOff(Instrument instrument, int note);
+    void allNotesOff();
+    // MIDI-Controller 0 - 127: 1 Modulation (Vibrato), 2 Breath Controller
+    // (überschreibt breathPressure), 11 Expression, 68 Legato
+    void controlChange(Instrument instrument, int controller, int value);
+
+    // KI-Modelle statt Waveguide. Lädt die Modelle beim ersten Einschalten,
+    // daher nicht im Audio-Thread aufrufen.
+    void setNeuralEnhancement(bool enabled);
+    bool isNeuralEnhancementEnabled() const;
+
     // Flöte Methoden
     void setFlute(const Flute& params);
     void processFlute(float* buffer, int numSamples);
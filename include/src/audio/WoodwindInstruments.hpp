@@ -3,12 +3,24 @@
 #include <vector>
 #include <string>
 #include <functional>
+#include <memory>
 #include <torch/script.h>
 
 namespace VRMusicStudio {
 
+// Weitere Holzblasinstrumente über native Waveguide-Modelle (WindModel),
+// gespielt mit noteOn/noteOff und MIDI-Controllern; die KI-Modelle sind eine
+// optionale Veredelung für das Offline-Rendering.
 class WoodwindInstruments {
 public:
+    enum class Instrument {
+        TransverseFlute,
+        Recorder,
+        Saxophone,
+        BassClarinet,
+        EnglishHorn
+    };
+
     // Querflöte Struktur
     struct TransverseFlute {
         float breathPressure;
@@ -67,6 +79,19 @@ public:
     WoodwindInstruments();
     ~WoodwindInstruments();
 
+    // Noten, velocity 0 - 127
+    void noteOn(Instrument instrument, int note, int velocity);
+    void noteOff(Instrument instrument, int note);
+    void allNotesOff();
+    // MIDI-Controller 0 - 127: 1 Modulation (Vibrato), 2 Breath Controller
+    // (überschreibt breathPressure), 11 Expression, 68 Legato
+    void controlChange(Instrument instrument, int controller, int value);
+
+    // KI-Modelle statt Waveguide. Lädt die Modelle beim ersten Einschalten,
+    // daher nicht im Audio-Thread aufrufen.
+    void setNeuralEnhancement(bool enabled);
+    bool isNeuralEnhancementEnabled() const;
+
     // Querflöte Methoden
     void setTransverseFlute(const TransverseFlute& params);
     void processTransverseFlute(float* buffer, int numSamples);
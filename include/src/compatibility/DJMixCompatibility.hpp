@@ -7,6 +7,8 @@
 
 namespace VRMusicStudio {
 
+struct TrackAnalysis;
+
 class DJMixCompatibility {
 public:
     struct DJMixConfig {
@@ -27,6 +29,16 @@ public:
     std::vector<DJMixConfig> getAvailableDJMixes() const;
     bool isDJMixAvailable(const std::string& djMixName) const;
 
+    // Tempo-/Tonart-Analyse importierter Tracks; läuft parallel im Hintergrund
+    // und wird pro Datei gecacht
+    void analyzeTracks(const std::vector<std::string>& paths);
+    void waitForAnalysis();
+    std::shared_ptr<const TrackAnalysis> getTrackAnalysis(const std::string& path) const;
+
+    // Harmonic Mixing (Camelot-Nachbarn) und Abspielverhältnis zum Ziel-Tempo
+    bool areTracksHarmonicallyCompatible(const std::string& pathA, const std::string& pathB) const;
+    double getTempoRatio(const std::string& path, double targetBpm) const;
+
     // Callback-Funktionen
     using DJMixChangeCallback = std::function<void(const std::string&, const DJMixConfig&)>;
     void setDJMixChangeCallback(DJMixChangeCallback callback);
@@ -60,6 +60,10 @@ public:
     void setLyrics(const std::vector<std::string>& lyrics);
     void setEmotion(const std::string& emotion);
 
+    // Erkannte Eingangstonhöhe (Hz, 0 = unvoiced) und deren Konfidenz
+    float getInputPitch() const;
+    float getInputPitchConfidence() const;
+
 private:
     struct Impl;
     std::unique_ptr<Impl> pImpl;
@@ -7,6 +7,7 @@
 #include <functional>
 #include <glm/glm.hpp>
 #include "../core/Logger.hpp"
+#include "audio/processing/SilenceDetector.hpp"
 
 <<<<<<< HEAD
 namespace VR_DAW {
@@ -115,6 +116,12 @@ public:
 
     // Audio-Verarbeitung
     virtual void processAudio(float* buffer, unsigned long framesPerBuffer) = 0;
+
+    // Wie lange das Plugin nach stillem Eingang noch Ausgang erzeugt
+    // (Nachhall, Delay-Feedback), in Sekunden. Hosts überspringen es danach,
+    // bis wieder Signal anliegt. kInfiniteTail (Standard, z.B. Instrumente)
+    // schläft nie.
+    virtual double getTailSeconds() const { return VRMusicStudio::kInfiniteTail; }
 <<<<<<< HEAD
     virtual void processMidi(const std::vector<uint8_t>& midiData) = 0;
 
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "EffectPlugin.hpp"
-#include <deque>
+#include "audio/processing/OnsetDetector.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <random>
 
@@ -44,8 +47,9 @@ private:
     float sliceOffset;
     float sliceRandom;
     float sliceReverse;
+    float snap;          // 0.0 - 1.0, Fangbereich zum nächsten Onset (Anteil der halben Slice-Länge)
     float mix;
-    float quality;
+    std::atomic<float> quality;     // wählt den Onset-Detektor, übernommen am Blockanfang
 
     // Automation Flags
     bool automatedSliceSize;
@@ -53,36 +57,52 @@ private:
     bool automatedSliceOffset;
     bool automatedSliceRandom;
     bool automatedSliceReverse;
+    bool automatedSnap;
     bool automatedMix;
     bool automatedQuality;
 
-    // State Variables
+    // State Variables: der Eingang läuft in einen Verlaufspuffer. Zu Beginn
+    // jedes Zyklus wird der letzte Takt eingefroren und Schritt für Schritt
+    // in Slices wiedergegeben; Slice-Anfänge rasten auf den nächsten Onset ein.
     struct Slice {
-        std::deque<float> buffer;
-        size_t startPos;
-        size_t endPos;
-        size_t currentPos;
-        float level;
+        unsigned long long start;   // absolute Position im Verlauf
+        unsigned long length;
+        unsigned long currentPos;
         bool reverse;
-        bool active;
     };
 
-    std::vector<Slice> slices;
+    static constexpr double kSampleRate = 44100.0;
+    static constexpr size_t kMaxOnsets = 256;
+    static constexpr size_t kMaxOnsetsPerBlock = 16;
+    static constexpr unsigned long kFadeSamples = 64;
+
+    Slice slice;
+    std::vector<float> history;
+    unsigned long long written;
+    unsigned long long barStart;
+    int currentStep;
+    int stepCount;
+    unsigned long sliceLength;
     size_t bufferSize;
-    float currentSliceSize;
-    float currentSliceCount;
-    float currentSliceOffset;
-    float currentSliceRandom;
-    float currentSliceReverse;
+
+    // Ein vorbereiteter Detektor pro Verfahren, damit ein Wechsel nicht allokiert
+    static constexpr int kMethodCount = 3;
+    std::array<VRMusicStudio::OnsetDetector, kMethodCount> onsetDetectors;
+    VRMusicStudio::OnsetDetector::Method currentMethod;
+    unsigned long long detectorOrigin;  // Verlaufsposition beim letzten Detektor-Reset
+    uint64_t onsets[kMaxOnsets];    // Ring der zuletzt erkannten Onsets
+    size_t onsetCount;
     std::mt19937 rng;
 
     // Private Methods
     void initializeSlices();
     void updateSlices();
-    void processSlice(Slice& slice, float* buffer, unsigned long framesPerBuffer);
-    void updateSlicePositions();
-    void applySliceRandomization();
-    void applySliceReversal();
+    void startNextSlice();
+    void detectOnsets(const float* buffer, unsigned long framesPerBuffer);
+    unsigned long long snapToOnset(unsigned long long position, unsigned long maxDistance) const;
+    float processSlice();
+    int getStepCount() const;
+    VRMusicStudio::OnsetDetector::Method getDetectionMethod() const;
 };
 
 } // namespace VR_DAW 
\ No newline at end of file
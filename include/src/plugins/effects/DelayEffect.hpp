@@ -30,6 +30,7 @@ public:
 
     // Audio-Verarbeitung
     void processAudio(float* buffer, unsigned long framesPerBuffer) override;
+    double getTailSeconds() const override;
 
     // Automation
     void addAutomationPoint(const std::string& parameter, float time, float value) override {}
@@ -76,7 +77,7 @@ private:
     // Hilfsfunktionen
     void updateFilterCoefficients();
     float processFilter(float input, int channel);
-    float calculateSyncTime();
+    float calculateSyncTime() const;
 };
 
 } // namespace VR_DAW 
\ No newline at end of file
@@ -1 +1,97 @@
- 
\ No newline at end of file
+#pragma once
+
+#include "EffectPlugin.hpp"
+#include "audio/processing/SidechainFilter.hpp"
+#include <vector>
+#include <string>
+
+namespace VR_DAW {
+
+class DuckingDelayEffect : public EffectPlugin {
+public:
+    DuckingDelayEffect();
+    ~DuckingDelayEffect();
+
+    // Plugin-Identifikation
+    std::string getName() const override { return "Ducking Delay"; }
+    std::string getVendor() const override { return "VR DAW"; }
+    std::string getCategory() const override { return "Effect"; }
+    std::string getVersion() const override { return "1.0.0"; }
+
+    // Plugin-Lebenszyklus
+    bool initialize() override;
+    void shutdown() override;
+
+    // Parameter-Management
+    std::vector<PluginParameter> getParameters() const override;
+    void setParameter(const std::string& name, float value) override;
+    float getParameter(const std::string& name) const override;
+    void setParameterAutomated(const std::string& name, bool automated) override;
+    bool isParameterAutomated(const std::string& name) const override;
+
+    // Audio-Verarbeitung; die Echos werden vom Key (Standard: trockenes
+    // Eingangssignal) weggeduckt
+    void processAudio(float* buffer, unsigned long framesPerBuffer) override;
+    void setSidechainInput(const float* key, unsigned long framesPerBuffer) override;
+
+    // Preset-Management
+    void loadPreset(const std::string& presetName) override;
+    void savePreset(const std::string& presetName) override;
+    std::vector<std::string> getAvailablePresets() const override;
+
+private:
+    // Parameter
+    float time;         // 0.0 - 2000.0 ms
+    float feedback;     // 0.0 - 0.9
+    float mix;          // 0.0 - 1.0
+    float threshold;    // -60.0 - 0.0 dB
+    float ratio;        // 1.0 - 20.0
+    float attack;       // 0.1 - 100.0 ms
+    float release;      // 10.0 - 1000.0 ms
+    float quality;      // 0.0 - 1.0
+    float keyHighpass;  // 20.0 - 2000.0 Hz
+    float keyLowpass;   // 200.0 - 20000.0 Hz
+
+    // Automatisierungs-Flags
+    bool automatedTime;
+    bool automatedFeedback;
+    bool automatedMix;
+    bool automatedThreshold;
+    bool automatedRatio;
+    bool automatedAttack;
+    bool automatedRelease;
+    bool automatedQuality;
+    bool automatedKeyHighpass;
+    bool automatedKeyLowpass;
+
+    // Zustandsvariablen
+    struct DelayLine {
+        std::vector<float> buffer;
+        unsigned long writePos;
+        unsigned long readPos;
+        float time;
+        float level;
+        float envelope;
+        float attackCoeff;
+        float releaseCoeff;
+        VRMusicStudio::SidechainFilter keyFilter;
+    };
+    DelayLine leftDelay;
+    DelayLine rightDelay;
+    unsigned long bufferSize;
+
+    // Sidechain (Sicht, nicht kopiert)
+    const float* keyInput;
+    unsigned long keyFrames;
+
+    // Hilfsmethoden
+    void initializeDelayLines();
+    void updateDelayLines();
+    void updateDelayTimes();
+    void updateEnvelopeCoefficients();
+    void updateEnvelope(DelayLine& delay, float key);
+    float calculateGain(float envelope);
+    float processDelayLine(DelayLine& delay, float input, float key);
+};
+
+} // namespace VR_DAW
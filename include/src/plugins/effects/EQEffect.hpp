@@ -1,13 +1,39 @@
 #pragma once
 
 #include "EffectPlugin.hpp"
+#include "audio/processing/AsyncResult.hpp"
+#include "audio/processing/FFT.hpp"
+#include <complex>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <string>
 
 namespace VR_DAW {
 
+// Parametrischer EQ mit drei Betriebsarten über dasselbe Bandmodell:
+//  - MinimumPhase: Peaking-Biquads (Standard, keine Latenz)
+//  - LinearPhase: FIR aus dem Betragsgang der Bänder, per FFT gefaltet
+//    (Overlap-Save). Der Kernel wird im Hintergrund entworfen und beim
+//    nächsten Hop über kHop Frames eingeblendet.
+//  - Dynamic: der Gain jedes Bands folgt einem Bandpass-Detektor auf dem
+//    Sidechain-Key bzw. dem eigenen Eingang (z.B. De-Essing)
 class EQEffect : public EffectPlugin {
 public:
+    enum class Mode {
+        MinimumPhase,
+        LinearPhase,
+        Dynamic
+    };
+
+    static constexpr size_t kFirLength = 4095;
+    static constexpr size_t kFftSize = 8192;
+    static constexpr size_t kHop = kFftSize - kFirLength + 1;
+    static constexpr unsigned long kControlBlock = 32;      // Frames
+
     EQEffect();
     ~EQEffect() override;
 
@@ -29,6 +55,10 @@ public:
 
     // Audio-Verarbeitung
     void processAudio(float* buffer, unsigned long framesPerBuffer) override;
+    void setSidechainInput(const float* key, unsigned long framesPerBuffer) override;
+
+    // Latenz der aktuellen Betriebsart in Frames
+    int getLatencySamples() const;
 
     // Automation
     void addAutomationPoint(const std::string& parameter, float time, float value) override {}
@@ -49,8 +79,17 @@ private:
         float q;            // 0.1 - 10.0
         bool enabled;       // true/false
         bool automated;     // true/false
+
+        // Dynamic-Modus: Absenkung oberhalb der Schwelle
+        float threshold;    // -60.0 - 0.0 dB
+        float ratio;        // 1.0 - 20.0 (1 = statisch)
+        float range;        // 0.0 - 24.0 dB maximale Absenkung
+        float attack;       // 0.1 - 100.0 ms
+        float release;      // 5.0 - 1000.0 ms
     };
 
+    Mode mode;
+
     // 10 Bands für den EQ
     std::vector<Band> bands;
 
@@ -67,12 +106,64 @@ private:
     };
 
     std::vector<FilterCoeffs> coeffs;
-    std::vector<FilterState> states;
+    std::vector<FilterState> states;            // [Band][Kanal]
+
+    // Dynamic-Modus: Bandpass-Detektor und geglättete Absenkung je Band
+    struct Detector {
+        FilterCoeffs coeffs;
+        FilterState states[2];
+        float peak;                 // Spitzenpegel des laufenden Kontrollblocks
+        float gainReduction;        // dB, <= 0
+        float appliedGain;          // dB, aktueller Gain der Biquads
+        float attackCoeff;
+        float releaseCoeff;
+    };
+    std::vector<Detector> detectors;
+    unsigned long controlFill;
+
+    // Sidechain (Sicht, nicht kopiert)
+    const float* keyInput;
+    unsigned long keyFrames;
+
+    // Linearphasig: Kernel-Spektrum inkl. Normierung der inversen FFT
+    struct Kernel {
+        std::vector<std::complex<float>> spectrum;
+    };
+    std::unique_ptr<VRMusicStudio::RealFFT> fft;
+    std::vector<float> fifoInput[2];
+    std::vector<float> fifoOutput[2];
+    std::vector<float> fftBuffer;
+    std::vector<std::complex<float>> spectrum;
+    std::vector<std::complex<float>> filteredSpectrum;
+    size_t fifoPos;
+    std::shared_ptr<const Kernel> activeKernel;
+    VRMusicStudio::AsyncResult<Kernel> designedKernel;
+
+    // Kernel-Entwurf im Hintergrund; der Thread besitzt eine eigene FFT
+    std::unique_ptr<VRMusicStudio::RealFFT> designFft;
+    std::mutex designMutex;
+    std::condition_variable designCondition;
+    std::vector<Band> pendingBands;
+    uint64_t designRequested;
+    uint64_t designHandled;
+    bool stopDesign;
+    std::thread designThread;
 
     // Hilfsfunktionen
+    bool parseBandParameter(const std::string& name, size_t& bandIndex, std::string& paramType) const;
     void updateFilterCoefficients(size_t bandIndex);
-    float processFilter(float input, size_t bandIndex);
+    void updateDetectorCoefficients(size_t bandIndex);
+    static FilterCoeffs peakingCoefficients(float frequency, float gain, float q);
+    float processFilter(float input, size_t bandIndex, int channel);
     float dbToLinear(float db);
+    void setMode(Mode newMode);
+    void processMinimumPhase(float* buffer, unsigned long framesPerBuffer);
+    void processDynamic(float* buffer, unsigned long framesPerBuffer);
+    void processLinearPhase(float* buffer, unsigned long framesPerBuffer);
+    void updateDynamicGains();
+    void requestKernel();
+    void designLoop();
+    std::shared_ptr<const Kernel> designKernel(const std::vector<Band>& snapshot, VRMusicStudio::RealFFT& transform) const;
 };
 
 } // namespace VR_DAW 
\ No newline at end of file
@@ -23,6 +23,15 @@ public:
     // Audio-Verarbeitung
     virtual void processAudio(float* buffer, unsigned long framesPerBuffer) override = 0;
 
+    // Sidechain: externer Key-Eingang im Format des Audio-Puffers. Der Zeiger
+    // ist eine Sicht auf den Ausgang einer anderen Spur bzw. eines Busses und
+    // muss bis zum nächsten processAudio() gültig bleiben; nullptr = eigener
+    // Eingang. Effekte ohne Key-Eingang ignorieren ihn.
+    virtual void setSidechainInput(const float* key, unsigned long framesPerBuffer) {
+        (void)key;
+        (void)framesPerBuffer;
+    }
+
     // Preset-Management
     virtual void loadPreset(const std::string& presetName) = 0;
     virtual void savePreset(const std::string& presetName) = 0;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EffectPlugin.hpp"
+#include "audio/processing/SidechainFilter.hpp"
 #include <vector>
 #include <string>
 
@@ -29,6 +30,7 @@ public:
 
     // Audio-Verarbeitung
     void processAudio(float* buffer, unsigned long framesPerBuffer) override;
+    void setSidechainInput(const float* key, unsigned long framesPerBuffer) override;
 
     // Automation
     void addAutomationPoint(const std::string& parameter, float time, float value) override {}
@@ -50,6 +52,8 @@ private:
     float range;        // 0.0 - 100.0 dB
     float knee;         // 0.0 - 40.0 dB
     float mix;          // 0.0 - 1.0
+    float keyHighpass;  // 20.0 - 2000.0 Hz
+    float keyLowpass;   // 200.0 - 20000.0 Hz
 
     // Automatisierung
     bool automatedThreshold;
@@ -59,11 +63,18 @@ private:
     bool automatedRange;
     bool automatedKnee;
     bool automatedMix;
+    bool automatedKeyHighpass;
+    bool automatedKeyLowpass;
 
     // Gate-Zustand
     float envelope;     // Hüllkurve
     float gain;         // Verstärkung
 
+    // Sidechain (Sicht, nicht kopiert)
+    const float* keyInput;
+    unsigned long keyFrames;
+    VRMusicStudio::SidechainFilter keyFilters[2];     // L/R
+
     // Hilfsfunktionen
     float calculateGain(float input);
     float calculateEnvelope(float input);
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "EffectPlugin.hpp"
+#include "audio/processing/PitchTracker.hpp"
+#include <cstdint>
+#include <vector>
+#include <string>
+
+namespace VR_DAW {
+
+// Automatische Tonhöhenkorrektur für Gesang und monophone Instrumente.
+//
+// Ein PitchTracker (MPM) liefert alle 32 Frames die Grundfrequenz, die auf
+// die nächste Note der gewählten Tonart/Skala bzw. auf gehaltene MIDI-Noten
+// gezogen wird. Die Korrektur folgt dem Ziel mit "retuneSpeed" (0 = hart);
+// "humanize" verlangsamt sie bei lang gehaltenen Noten, damit Vibrato und
+// Ausklang natürlich bleiben. Verschoben wird per TD-PSOLA: pitch-synchrone
+// Grains werden im neuen Abstand überlagert, die Formanten bleiben dabei
+// erhalten und lassen sich mit "formant" getrennt verschieben.
+// Die Latenz ist fest kLatency Frames (~9.8 ms bei 44.1 kHz, unter dem
+// 10-ms-Budget): die halbe Framelänge des PitchTrackers bei kMinFrequency plus
+// ein Kontrollblock, so beschreibt jede Schätzung das Signal, das die Grains
+// gerade lesen. Dafür beginnt der Tracker erst bei 110 Hz (A2); tiefere Stimmen
+// werden nicht erkannt und laufen unkorrigiert durch. Eingangs- und
+// Ausgangshälfte eines Grains passen zusammen in die Latenz; ohne
+// Formantverschiebung sind Grains unter ~200 Hz daher kürzer als zwei Perioden.
+class PitchCorrectionEffect : public EffectPlugin {
+public:
+    enum class Scale {
+        Chromatic,
+        Major,
+        NaturalMinor,
+        HarmonicMinor,
+        Dorian,
+        MajorPentatonic,
+        MinorPentatonic,
+        Blues
+    };
+
+    static constexpr float kSampleRate = 44100.0f;
+    static constexpr float kMinFrequency = 110.0f;          // Hz, untere Grenze des Trackers
+    static constexpr unsigned long kControlBlock = 32;      // Frames
+    // Obergrenze für PitchTracker::getLatencySamples() (ceil(sr / fmin) + 1)
+    static constexpr unsigned long kTrackerLatency = static_cast<unsigned long>(kSampleRate / kMinFrequency) + 2;
+    static constexpr unsigned long kLatency = kTrackerLatency + kControlBlock;   // Frames
+    static constexpr size_t kRingSize = 4096;               // Zweierpotenz
+
+    PitchCorrectionEffect();
+    ~PitchCorrectionEffect();
+
+    // Plugin-Identifikation
+    const char* getName() const override { return "Pitch Correction"; }
+    const char* getManufacturer() const override { return "VR DAW"; }
+    const char* getCategory() const override { return "Effect"; }
+    const char* getVersion() const override { return "1.0.0"; }
+
+    // Lifecycle
+    bool initialize() override;
+    void shutdown() override;
+
+    // Parameter-Management
+    std::vector<PluginParameter> getParameters() const override;
+    void setParameter(const std::string& name, float value) override;
+    float getParameter(const std::string& name) const override;
+    void setParameterAutomated(const std::string& name, bool automated) override;
+    bool isParameterAutomated(const std::string& name) const override;
+
+    // Audio-Verarbeitung
+    void processAudio(float* buffer, unsigned long framesPerBuffer) override;
+
+    // MIDI-Zielnoten: solange Noten gehalten werden (und "midiTarget" an ist),
+    // wird auf die nächstgelegene gehaltene Tonklasse korrigiert
+    void noteOn(int note, int velocity);
+    void noteOff(int note);
+    void allNotesOff();
+
+    // Latenz in Frames und Anzeige
+    int getLatencySamples() const { return static_cast<int>(kLatency); }
+    float getDetectedFrequency() const { return detectedFrequency; }
+    float getCorrectionSemitones() const { return correction; }
+    int getTargetNote() const { return targetNote; }
+
+    // Preset-Management
+    void loadPreset(const std::string& presetName) override;
+    void savePreset(const std::string& presetName) override;
+    std::vector<std::string> getAvailablePresets() const override;
+
+private:
+    // Parameter
+    float key;          // 0 - 11 (C - B)
+    float scale;        // 0 - 7, siehe Scale
+    float retuneSpeed;  // 0.0 - 400.0 ms
+    float humanize;     // 0.0 - 1.0
+    float amount;       // 0.0 - 1.0
+    float formant;      // -12.0 - +12.0 Halbtöne
+    float mix;          // 0.0 - 1.0
+    float midiTarget;   // 0 / 1
+
+    // Automatisierung
+    bool automatedKey;
+    bool automatedScale;
+    bool automatedRetuneSpeed;
+    bool automatedHumanize;
+    bool automatedAmount;
+    bool automatedFormant;
+    bool automatedMix;
+    bool automatedMidiTarget;
+
+    // Tonhöhenerkennung
+    VRMusicStudio::PitchTracker tracker;
+    std::vector<VRMusicStudio::PitchTracker::Estimate> estimates;
+    std::vector<float> monoBlock;
+
+    // Korrektur-Zustand
+    float detectedFrequency;
+    float correction;           // Halbtöne, geglättet
+    int targetNote;             // -1 = keine
+    float sustainTime;          // Sekunden auf derselben Zielnote
+    float analysisPeriod;       // Frames
+    float pitchRatio;
+    float formantRatio;
+    bool heldNotes[128];
+    int heldNoteCount;
+
+    // PSOLA-Zustand; Positionen sind absolute Frames seit initialize()
+    std::vector<float> inputRing[2];
+    std::vector<float> outputRing[2];
+    uint64_t time;
+    double analysisMark;
+    double synthesisMark;
+    unsigned long controlPos;
+
+    // Hilfsmethoden
+    void updateControl();
+    int quantize(float midiNote) const;
+    int nearestHeldNote(float midiNote) const;
+    double grainHalf() const;
+    void placeGrain();
+    float readInput(int channel, double position) const;
+};
+
+} // namespace VR_DAW
@@ -29,6 +29,7 @@ public:
 
     // Audio-Verarbeitung
     void processAudio(float* buffer, unsigned long framesPerBuffer) override;
+    double getTailSeconds() const override;
 
     // Automation
     void addAutomationPoint(const std::string& parameter, float time, float value) override {}
@@ -1,9 +1,10 @@
 #pragma once
 
 #include "EffectPlugin.hpp"
+#include "audio/processing/TimeStretcher.hpp"
+#include <atomic>
 #include <vector>
 #include <random>
-#include <deque>
 
 namespace VR_DAW {
 
@@ -38,14 +39,15 @@ public:
     std::vector<std::string> getAvailablePresets() const override;
 
 private:
-    // Parameter
-    float speed;         // 0.0 - 1.0
-    float direction;     // 0.0 - 1.0
+    // Parameter; speed, direction und quality liest der Audio-Thread am
+    // Blockanfang für die Stretcher
+    std::atomic<float> speed;       // 0.0 - 1.0
+    std::atomic<float> direction;   // 0.0 - 1.0
     float distortion;    // 0.0 - 1.0
     float glitch;        // 0.0 - 1.0
     float stutter;       // 0.0 - 1.0
     float mix;           // 0.0 - 1.0
-    float quality;       // 0.0 - 1.0
+    std::atomic<float> quality;     // 0.0 - 1.0
 
     // Automatisierung
     bool automatedSpeed;
@@ -56,28 +58,34 @@ private:
     bool automatedMix;
     bool automatedQuality;
 
-    // Zustandsvariablen
-    struct TimeState {
-        std::deque<float> buffer;
-        float position;
-        float speed;
-        float direction;
-    };
-
-    struct WarpState {
-        std::vector<TimeState> states;
-        float time;
-        float glitch;
-    };
-
-    std::vector<WarpState> states;
+    // Zustandsvariablen: der Eingang läuft in einen Verlaufspuffer, aus dem
+    // ein Phase-Vocoder mit der Warp-Geschwindigkeit liest. Läuft der Lesekopf
+    // aus dem Puffer, springt ein zweiter Stretcher an die neue Stelle und
+    // wird überblendet. Jede Qualitätsstufe hat ein eigenes, in
+    // initializeStates() vorbereitetes Stretcher-Paar; setParameter() merkt
+    // sich nur die Werte, processAudio() schaltet am Blockanfang um.
+    static constexpr int kQualityTiers = 3;
+    std::vector<float> history;
+    unsigned long long written;
+    VRMusicStudio::TimeStretcher readers[kQualityTiers][2];
+    int activeReader;
+    VRMusicStudio::TimeStretcher* fadingReader;
+    unsigned long crossfadeRemaining;
+    VRMusicStudio::TimeStretcher::Quality currentQuality;   // nur Audio-Thread
+    std::vector<float> wetBuffer;
+    std::vector<float> fadeBuffer;
     std::mt19937 rng;
     unsigned long bufferSize;
 
+    static constexpr unsigned long kCrossfadeSamples = 1024;
+
     // Private Methoden
     void initializeStates();
     void updateStates();
-    void processState(WarpState& state, float* buffer, unsigned long framesPerBuffer);
+    double getWarpRate() const;
+    VRMusicStudio::TimeStretcher::Quality getQualityTier() const;
+    VRMusicStudio::TimeStretcher* activePair() { return readers[static_cast<int>(currentQuality)]; }
+    void processWarp(float* wet, unsigned long framesPerBuffer);
     void applyDistortion(float* buffer, unsigned long framesPerBuffer);
     void applyGlitch(float* buffer, unsigned long framesPerBuffer);
     void applyStutter(float* buffer, unsigned long framesPerBuffer);
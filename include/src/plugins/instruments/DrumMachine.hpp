@@ -1,6 +1,9 @@
 #pragma once
 
 #include "../PluginInterface.hpp"
+#include "audio/processing/OnsetDetector.hpp"
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
@@ -8,8 +11,76 @@
 
 namespace VR_DAW {
 
+// Pads werden sample-genau ausgelöst: MIDI, triggerPad() und der Sequencer
+// legen Trigger mit Frame-Offset in eine Warteschlange, processAudio startet
+// die Stimmen genau an diesem Frame. Jeder Anschlag bekommt eine eigene
+// Stimme (Flams und Rolls überlappen), Choke-Gruppen (offene/geschlossene
+// Hi-Hat) blenden ältere Stimmen derselben Gruppe in O(1) aus.
+//
+// Pads und Pattern liegen als flache Arrays pro Feld vor (SoA): Stimmenstart
+// und Sequencer lesen nur Gain, Pitch, Start/Ende, Velocity und
+// Wahrscheinlichkeit. Pfade, Slice-Marker, Effekt-Parameter und Parameter-
+// Locks pro Step liegen getrennt davon. Alle Parameter werden über
+// setPadParameter/setStepParameter bzw. Namen wie "pad.36.volume" oder
+// "step.36.4.velocity" adressiert.
 class DrumMachine : public InstrumentPlugin {
 public:
+    static constexpr int kMaxPads = 128;
+    static constexpr int kMaxVoices = 64;
+    static constexpr int kMaxChokeGroups = 16;      // Gruppe 0 = kein Choke
+    static constexpr int kStepsPerPattern = 16;
+
+    enum class PadParameter : uint8_t {
+        Volume,
+        Pitch,              // Halbtöne
+        Start,              // 0 - 1 der Sample-Länge
+        End,
+        ChokeGroup,
+        Pan,
+        FilterCutoff,
+        FilterResonance,
+        EnvelopeAttack,
+        EnvelopeDecay,
+        EnvelopeSustain,
+        EnvelopeRelease,
+        LfoRate,
+        LfoAmount,
+        LfoDestination,     // 0 = Filter, 1 = Amplitude, 2 = Pitch
+        ReverbAmount,
+        DelayTime,
+        DelayFeedback,
+        CompressionThreshold,
+        CompressionRatio,
+        EqLow,
+        EqMid,
+        EqHigh,
+        DistortionAmount,
+        GranularGrainSize,
+        GranularDensity,
+        GranularPitch,
+        TimeStretchRate,
+        Reverse,
+        Count
+    };
+
+    enum class StepParameter : uint8_t {
+        Active,
+        Velocity,           // 1 - 127
+        Probability,        // 0 - 1
+        Pitch,              // Halbtöne
+        Length,             // in Steps
+        Count
+    };
+
+    struct ParameterInfo {
+        const char* name;
+        float minValue;
+        float maxValue;
+        float defaultValue;
+    };
+    static const ParameterInfo& getParameterInfo(PadParameter parameter);
+    static const ParameterInfo& getParameterInfo(StepParameter parameter);
+
     DrumMachine();
     ~DrumMachine();
 
@@ -25,243 +96,175 @@ public:
     void processAudio(float* buffer, unsigned long framesPerBuffer) override;
     void processMidi(const std::vector<uint8_t>& midiData) override;
 
-    // Drum Machine spezifische Funktionen
-    void loadDrumKit(const std::string& path);
+    // Kits: Sample-Pfade, Pad-Parameter und Slice-Einstellungen als Textdatei
+    bool loadDrumKit(const std::string& path);
+    bool saveDrumKit(const std::string& path) const;
     void unloadDrumKit();
     void setDrumSample(int pad, const std::string& path);
-    void setDrumVolume(int pad, float volume);
-    void setDrumPan(int pad, float pan);
-    void setDrumPitch(int pad, float pitch);
-    void setDrumFilter(int pad, float cutoff, float resonance);
-    void setDrumEnvelope(int pad, float attack, float decay, float sustain, float release);
-    void setDrumLFO(int pad, float rate, float amount, const std::string& destination);
-    void setDrumReverb(int pad, float amount);
-    void setDrumDelay(int pad, float time, float feedback);
-    void setDrumCompression(int pad, float threshold, float ratio);
-    void setDrumEQ(int pad, float low, float mid, float high);
-    void setDrumDistortion(int pad, float amount);
-    void setDrumGranular(int pad, float grainSize, float density, float pitch);
-    void setDrumTimeStretch(int pad, float rate);
-    void setDrumReverse(int pad, bool reverse);
+
+    // Adressierte Parameter; Werte werden auf den Bereich aus ParameterInfo begrenzt
+    void setPadParameter(int pad, PadParameter parameter, float value);
+    float getPadParameter(int pad, PadParameter parameter) const;
+    void setDrumChokeGroup(int pad, int group);
+
+    // Slices
     void setDrumSlice(int pad, const std::vector<float>& slicePoints);
     void setDrumSliceMode(int pad, const std::string& mode);
     void setDrumSliceQuantize(int pad, float amount);
-    void setDrumSliceRandom(int pad, float amount);
-    void setDrumSliceReverse(int pad, bool reverse);
-    void setDrumSlicePitch(int pad, float pitch);
-    void setDrumSliceVolume(int pad, float volume);
-    void setDrumSlicePan(int pad, float pan);
-    void setDrumSliceFilter(int pad, float cutoff, float resonance);
-    void setDrumSliceEnvelope(int pad, float attack, float decay, float sustain, float release);
-    void setDrumSliceLFO(int pad, float rate, float amount, const std::string& destination);
-    void setDrumSliceReverb(int pad, float amount);
-    void setDrumSliceDelay(int pad, float time, float feedback);
-    void setDrumSliceCompression(int pad, float threshold, float ratio);
-    void setDrumSliceEQ(int pad, float low, float mid, float high);
-    void setDrumSliceDistortion(int pad, float amount);
-    void setDrumSliceGranular(int pad, float grainSize, float density, float pitch);
-    void setDrumSliceTimeStretch(int pad, float rate);
-    void setDrumSliceReverse(int pad, bool reverse);
+    void setDrumSliceDetection(int pad, VRMusicStudio::OnsetDetector::Method method, float sensitivity);
+    void triggerDrumSlice(int pad, int slice, int velocity);
+    std::vector<float> getDrumSlicePoints(int pad);
+
+    // Anschlag `frameOffset` Frames nach Beginn des nächsten processAudio-Puffers
+    void triggerPad(int pad, int velocity, unsigned long frameOffset = 0);
+    int getActiveVoiceCount() const;
 
-    // Sequencer Funktionen
+    // Sequencer Funktionen; ein Step ist ein Sechzehntel
+    void startSequencer();
+    void stopSequencer();
+    bool isSequencerRunning() const { return sequencerRunning; }
     void setBPM(float bpm);
     void setTimeSignature(int numerator, int denominator);
     void setStep(int pad, int step, bool active);
-    void setStepVelocity(int pad, int step, int velocity);
-    void setStepProbability(int pad, int step, float probability);
+    void setStepParameter(int pad, int step, StepParameter parameter, float value);
+    float getStepParameter(int pad, int step, StepParameter parameter) const;
+    void clearPattern();
+
+    // Parameter-Locks: Pad-Parameter, die nur für einen Step gelten
+    void setStepLock(int pad, int step, PadParameter parameter, float value);
+    void clearStepLock(int pad, int step, PadParameter parameter);
+    bool getStepLock(int pad, int step, PadParameter parameter, float& value) const;
     void setStepCondition(int pad, int step, const std::string& condition);
-    void setStepLength(int pad, int step, float length);
-    void setStepPitch(int pad, int step, float pitch);
-    void setStepPan(int pad, int step, float pan);
-    void setStepFilter(int pad, int step, float cutoff, float resonance);
-    void setStepEnvelope(int pad, int step, float attack, float decay, float sustain, float release);
-    void setStepLFO(int pad, int step, float rate, float amount, const std::string& destination);
-    void setStepReverb(int pad, int step, float amount);
-    void setStepDelay(int pad, int step, float time, float feedback);
-    void setStepCompression(int pad, int step, float threshold, float ratio);
-    void setStepEQ(int pad, int step, float low, float mid, float high);
-    void setStepDistortion(int pad, int step, float amount);
-    void setStepGranular(int pad, int step, float grainSize, float density, float pitch);
-    void setStepTimeStretch(int pad, int step, float rate);
-    void setStepReverse(int pad, int step, bool reverse);
-    void setStepSlice(int pad, int step, const std::vector<float>& slicePoints);
-    void setStepSliceMode(int pad, int step, const std::string& mode);
-    void setStepSliceQuantize(int pad, int step, float amount);
-    void setStepSliceRandom(int pad, int step, float amount);
-    void setStepSliceReverse(int pad, int step, bool reverse);
-    void setStepSlicePitch(int pad, int step, float pitch);
-    void setStepSliceVolume(int pad, int step, float volume);
-    void setStepSlicePan(int pad, int step, float pan);
-    void setStepSliceFilter(int pad, int step, float cutoff, float resonance);
-    void setStepSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release);
-    void setStepSliceLFO(int pad, int step, float rate, float amount, const std::string& destination);
-    void setStepSliceReverb(int pad, int step, float amount);
-    void setStepSliceDelay(int pad, int step, float time, float feedback);
-    void setStepSliceCompression(int pad, int step, float threshold, float ratio);
-    void setStepSliceEQ(int pad, int step, float low, float mid, float high);
-    void setStepSliceDistortion(int pad, int step, float amount);
-    void setStepSliceGranular(int pad, int step, float grainSize, float density, float pitch);
-    void setStepSliceTimeStretch(int pad, int step, float rate);
-    void setStepSliceReverse(int pad, int step, bool reverse);
 
 private:
-    struct DrumPad {
+    static constexpr int kPadParameterCount = static_cast<int>(PadParameter::Count);
+    static constexpr int kPatternCells = kStepsPerPattern * kMaxPads;
+    static constexpr int kPadWords = kMaxPads / 64;
+
+    // Sample-Daten eines Pads (interleaved)
+    struct PadSample {
         std::vector<float> data;
-        float sampleRate;
-        int channels;
-        float volume;
-        float pan;
-        float pitch;
-        float filterCutoff;
-        float filterResonance;
-        float envelopeAttack;
-        float envelopeDecay;
-        float envelopeSustain;
-        float envelopeRelease;
-        float lfoRate;
-        float lfoAmount;
-        std::string lfoDestination;
-        float reverbAmount;
-        float delayTime;
-        float delayFeedback;
-        float compressionThreshold;
-        float compressionRatio;
-        float eqLow;
-        float eqMid;
-        float eqHigh;
-        float distortionAmount;
-        float granularGrainSize;
-        float granularDensity;
-        float granularPitch;
-        float timeStretchRate;
-        bool reverse;
-        std::vector<float> slicePoints;
-        std::string sliceMode;
-        float sliceQuantize;
-        float sliceRandom;
-        bool sliceReverse;
-        float slicePitch;
-        float sliceVolume;
-        float slicePan;
-        float sliceFilterCutoff;
-        float sliceFilterResonance;
-        float sliceEnvelopeAttack;
-        float sliceEnvelopeDecay;
-        float sliceEnvelopeSustain;
-        float sliceEnvelopeRelease;
-        float sliceLfoRate;
-        float sliceLfoAmount;
-        std::string sliceLfoDestination;
-        float sliceReverbAmount;
-        float sliceDelayTime;
-        float sliceDelayFeedback;
-        float sliceCompressionThreshold;
-        float sliceCompressionRatio;
-        float sliceEqLow;
-        float sliceEqMid;
-        float sliceEqHigh;
-        float sliceDistortionAmount;
-        float sliceGranularGrainSize;
-        float sliceGranularDensity;
-        float sliceGranularPitch;
-        float sliceTimeStretchRate;
-        bool sliceReverse;
+        size_t frames = 0;
+        int channels = 1;
+        float sampleRate = 44100.0f;
     };
 
-    struct Step {
-        bool active;
-        int velocity;
-        float probability;
-        std::string condition;
-        float length;
-        float pitch;
-        float pan;
-        float filterCutoff;
-        float filterResonance;
-        float envelopeAttack;
-        float envelopeDecay;
-        float envelopeSustain;
-        float envelopeRelease;
-        float lfoRate;
-        float lfoAmount;
-        std::string lfoDestination;
-        float reverbAmount;
-        float delayTime;
-        float delayFeedback;
-        float compressionThreshold;
-        float compressionRatio;
-        float eqLow;
-        float eqMid;
-        float eqHigh;
-        float distortionAmount;
-        float granularGrainSize;
-        float granularDensity;
-        float granularPitch;
-        float timeStretchRate;
-        bool reverse;
+    // Heiße Pad-Daten, Index = Pad
+    struct PadData {
+        std::array<const PadSample*, kMaxPads> sample;  // nullptr = leer
+        std::array<float, kMaxPads> gain;
+        std::array<float, kMaxPads> pitch;
+        std::array<float, kMaxPads> start;
+        std::array<float, kMaxPads> end;
+        std::array<uint8_t, kMaxPads> chokeGroup;
+    };
+
+    // Kalte Pad-Daten: nur Editor, Kits und Slice-Auflösung
+    struct PadInfo {
+        std::string path;
+        std::shared_ptr<PadSample> sample;
+        std::array<float, kPadParameterCount> parameters;   // inkl. Kopie der heißen Werte
+
         std::vector<float> slicePoints;
-        std::string sliceMode;
-        float sliceQuantize;
-        float sliceRandom;
-        bool sliceReverse;
-        float slicePitch;
-        float sliceVolume;
-        float slicePan;
-        float sliceFilterCutoff;
-        float sliceFilterResonance;
-        float sliceEnvelopeAttack;
-        float sliceEnvelopeDecay;
-        float sliceEnvelopeSustain;
-        float sliceEnvelopeRelease;
-        float sliceLfoRate;
-        float sliceLfoAmount;
-        std::string sliceLfoDestination;
-        float sliceReverbAmount;
-        float sliceDelayTime;
-        float sliceDelayFeedback;
-        float sliceCompressionThreshold;
-        float sliceCompressionRatio;
-        float sliceEqLow;
-        float sliceEqMid;
-        float sliceEqHigh;
-        float sliceDistortionAmount;
-        float sliceGranularGrainSize;
-        float sliceGranularDensity;
-        float sliceGranularPitch;
-        float sliceTimeStretchRate;
-        bool sliceReverse;
+        std::string sliceMode = "manual";
+        float sliceQuantize = 0.25f;
+
+        // Slice-Marker: Onsets kommen asynchron aus dem OnsetAnalyzer,
+        // sliceStarts wird bei Änderungen neu aufgelöst (in Frames)
+        VRMusicStudio::OnsetDetector::Settings onsetSettings;
+        std::shared_ptr<VRMusicStudio::OnsetSlot> onsets;
+        std::shared_ptr<const VRMusicStudio::OnsetMarkers> resolvedOnsets;
+        std::vector<size_t> sliceStarts;
+        bool slicesDirty = true;
+    };
+
+    // Pattern, Index = step * kMaxPads + pad, damit ein Step am Stück liegt
+    struct PatternData {
+        std::array<std::array<uint64_t, kPadWords>, kStepsPerPattern> active;  // Bit = Pad
+        std::array<uint8_t, kPatternCells> velocity;
+        std::array<uint8_t, kPatternCells> probability;     // 0 - 255, 255 = immer
+        std::array<float, kPatternCells> pitch;
+        std::array<float, kPatternCells> length;
     };
 
+    // Stimme; Sample und Bereich werden beim Start aufgelöst
     struct Note {
+        const PadSample* sample;
         int pad;
-        int velocity;
         float amplitude;
-        float position;
-        float filterEnvelope;
-        float ampEnvelope;
+        double position;            // Frames im Sample
+        double increment;           // Frames pro Ausgabe-Frame
+        double end;                 // Frames
+        bool fadeAtEnd;             // Slices: kurze Ausblende vor dem nächsten Slice
+        unsigned long startOffset;  // Frames bis zum Einsatz im aktuellen Block
+        uint64_t startFrame;
+        int chokeGroup;
+        uint32_t chokeGeneration;
+        int fadeRemaining;          // > 0 während des Choke-Fades
         bool active;
-        int currentSlice;
-        float slicePosition;
-        float sliceFilterEnvelope;
-        float sliceAmpEnvelope;
-        bool sliceActive;
     };
 
-    std::map<int, DrumPad> pads;
-    std::map<int, std::vector<Step>> steps;
-    std::map<int, Note> activeNotes;
+    // Anstehender Anschlag; Offset relativ zum nächsten Puffer
+    struct Trigger {
+        int pad;
+        int velocity;
+        float pitch;                // Halbtöne
+        size_t start;               // Frames; end == 0: Bereich des Pads
+        size_t end;
+        unsigned long offset;
+    };
+
+    // Letzte Anschläge pro Choke-Gruppe: eine Stimme mit Generation g wird
+    // beim Anschlag g + 1 ausgeblendet, dessen Frame hier steht
+    struct ChokeGroup {
+        uint32_t generation = 0;
+        std::array<uint64_t, 4> frames{};
+    };
+
+    PadData padData;
+    std::vector<PadInfo> padInfo;                   // kMaxPads Einträge
+    std::unique_ptr<PatternData> pattern;
+    std::map<uint32_t, float> stepLocks;            // Schlüssel: Zelle << 8 | Parameter
+    std::map<int, std::string> stepConditions;      // Schlüssel: Zelle
+    std::vector<Note> voices;
+    std::vector<Trigger> triggers;                  // Kapazität vorab reserviert
+    std::array<ChokeGroup, kMaxChokeGroups> chokeGroups;
+    uint64_t frameCounter;
+    uint32_t randomState;
+
+    static constexpr size_t kMaxTriggers = 256;
+    static constexpr int kChokeFadeFrames = 64;
+    static constexpr float kSliceFadeFrames = 64.0f;
+
+    bool sequencerRunning;
+    int sequencerStep;
+    double nextStepFrame;       // absoluter Frame des nächsten Steps
     float bpm;
     int timeSignatureNumerator;
     int timeSignatureDenominator;
-    float currentStep;
     float stepLength;
     float pitchBend;
     float modulation;
     float aftertouch;
 
+    static bool isValidPad(int pad) { return pad >= 0 && pad < kMaxPads; }
+    static bool isValidCell(int pad, int step) { return isValidPad(pad) && step >= 0 && step < kStepsPerPattern; }
+    static int cellIndex(int pad, int step) { return step * kMaxPads + pad; }
+    static bool findParameter(const std::string& name, PadParameter& parameter);
+    static bool findParameter(const std::string& name, StepParameter& parameter);
+
+    void resetPad(int pad);
+    void applyHotParameter(int pad, PadParameter parameter);
     void noteOn(int pad, int velocity);
     void noteOff(int pad);
-    float processDrumPad(const DrumPad& pad, float position);
+    void queueTrigger(const Trigger& trigger);
+    void scheduleSequencer(unsigned long framesPerBuffer);
+    void startVoice(const Trigger& trigger);
+    void renderVoice(Note& voice, float* buffer, unsigned long framesPerBuffer);
+    void stopPadVoices(int pad);
+    double framesPerStep() const;
+    float nextRandom();
+    float processDrumPad(const PadSample& sample, double position);
     float processFilter(float input, float cutoff, float resonance);
     float processEnvelope(float input, float attack, float decay, float sustain, float release, float time);
     float processLFO(float rate, float amount, const std::string& destination, float time);
@@ -273,18 +276,8 @@ private:
     float processGranular(float input, float grainSize, float density, float pitch);
     float processTimeStretch(float input, float rate);
     float processReverse(float input);
-    float processSlice(const DrumPad& pad, int slice, float position);
-    float processSliceFilter(float input, float cutoff, float resonance);
-    float processSliceEnvelope(float input, float attack, float decay, float sustain, float release, float time);
-    float processSliceLFO(float rate, float amount, const std::string& destination, float time);
-    float processSliceReverb(float input, float amount);
-    float processSliceDelay(float input, float time, float feedback);
-    float processSliceCompression(float input, float threshold, float ratio);
-    float processSliceEQ(float input, float low, float mid, float high);
-    float processSliceDistortion(float input, float amount);
-    float processSliceGranular(float input, float grainSize, float density, float pitch);
-    float processSliceTimeStretch(float input, float rate);
-    float processSliceReverse(float input);
+    void requestOnsets(PadInfo& pad);
+    void resolveSlices(PadInfo& pad);
 };
 
-} // namespace VR_DAW 
\ No newline at end of file
+} // namespace VR_DAW
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "../PluginInterface.hpp"
+#include "audio/processing/AsyncResult.hpp"
+#include "audio/processing/SampleStreamer.hpp"
+#include "audio/processing/TimeStretcher.hpp"
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
@@ -10,6 +15,37 @@ namespace VR_DAW {
 
 class Sampler : public InstrumentPlugin {
 public:
+    // Zone eines Multisamples (entspricht einer SFZ-Region).
+    //
+    // Eine Zone klingt, wenn Taste und Velocity in ihren Bereichen liegen,
+    // ihre Round-Robin-Position dran ist und die Zufallszahl der Note in
+    // [randomLow, randomHigh) fällt. Release-Zonen starten erst beim Note-Off
+    // und werden pro gehaltener Sekunde um releaseDecay dB leiser.
+    // Velocity-Crossfades blenden mit gleicher Leistung zwischen Layern:
+    // unter fadeInLow stumm, ab fadeInHigh voll, ab fadeOutLow abfallend,
+    // ab fadeOutHigh stumm. Gleiche Grenzen schalten die Rampe ab.
+    struct ZoneDefinition {
+        std::string path;
+        int lowKey = 0;
+        int highKey = 127;
+        int rootKey = 60;
+        int lowVelocity = 1;
+        int highVelocity = 127;
+        int fadeInLow = 0;
+        int fadeInHigh = 0;
+        int fadeOutLow = 127;
+        int fadeOutHigh = 127;
+        int sequenceLength = 1;     // Round Robin: Anzahl der Varianten
+        int sequencePosition = 1;   // 1 - sequenceLength
+        float randomLow = 0.0f;     // 0.0 - 1.0
+        float randomHigh = 1.0f;
+        bool releaseTrigger = false;
+        float releaseDecay = 0.0f;  // dB pro Sekunde
+        float tune = 0.0f;          // Cent
+        float volume = 0.0f;        // dB
+        bool loop = false;
+    };
+
     Sampler();
     ~Sampler();
 
@@ -25,7 +61,11 @@ public:
     void processAudio(float* buffer, unsigned long framesPerBuffer) override;
     void processMidi(const std::vector<uint8_t>& midiData) override;
 
-    // Sampler-spezifische Funktionen
+    // Sampler-spezifische Funktionen. Die setSample*-Setter adressieren per
+    // Taste die mit loadSample geladenen Samples, per zoneTarget() die Datei
+    // einer Zone; Zonen mit derselben Datei teilen sich deren Einstellungen.
+    static constexpr int kZoneTargetBase = 1000;
+    static int zoneTarget(int zoneIndex) { return kZoneTargetBase + zoneIndex; }
     void loadSample(const std::string& path, int note);
     void unloadSample(int note);
     void setSampleLoop(int note, bool loop);
@@ -64,9 +104,50 @@ public:
     void setSampleSliceTimeStretch(int note, float rate);
     void setSampleSliceReverse(int note, bool reverse);
 
+    // Multisample-Zonen; nicht während der Wiedergabe ändern. Dateien werden
+    // pro Pfad nur einmal geladen. Rückgabe: Index der Zone, -1 bei Fehler
+    int addZone(const ZoneDefinition& zone);
+    void clearZones();
+    size_t getZoneCount() const { return zones.size(); }
+    // Index der ersten Zone mit dieser Datei, -1 wenn keine
+    int findZone(const std::string& path) const;
+
+    // Streaming-Statistik
+    uint64_t getStreamUnderruns() const { return streamer->getUnderruns(); }
+    size_t getStreamingMemory() const { return streamer->getMemoryUsage(); }
+
 private:
+    // Per-Voice-Effektkette: beim Parameterwechsel aus den aktiven Stufen
+    // zusammengestellt und im Audio-Thread blockweise per switch abgearbeitet.
+    // Hall und Delay laufen nicht pro Stimme, sondern als Sends auf einem
+    // gemeinsamen Bus hinter den Stimmen.
+    enum class VoiceStage : uint8_t {
+        Filter,
+        Envelope,
+        Tremolo,
+        Compression,
+        EQ,
+        Distortion,
+        Granular,
+        Reverse,
+        Slice
+    };
+    static constexpr int kMaxStages = 9;
+
+    enum class LfoTarget : uint8_t { None, Filter, Amplitude };
+
+    struct EffectChain {
+        std::array<VoiceStage, kMaxStages> stages;
+        int stageCount = 0;
+        float reverbSend = 0.0f;
+        float delaySend = 0.0f;
+    };
+
     struct Sample {
-        std::vector<float> data;
+        std::shared_ptr<VRMusicStudio::StreamedSample> stream;     // Kopf resident, Rest per Streaming
+        // Vollständig geladene Kopie für den Phase-Vocoder; der Steuer-Thread
+        // veröffentlicht sie, der Audio-Thread liest sie einmal pro Block
+        std::shared_ptr<VRMusicStudio::AsyncResult<VRMusicStudio::StreamedSample>> residentStream;
         float sampleRate;
         int channels;
         bool loop;
@@ -83,7 +164,7 @@ private:
         float envelopeRelease;
         float lfoRate;
         float lfoAmount;
-        std::string lfoDestination;
+        LfoTarget lfoTarget;
         float reverbAmount;
         float delayTime;
         float delayFeedback;
@@ -129,13 +210,30 @@ private:
         float sliceGranularPitch;
         float sliceTimeStretchRate;
         bool sliceReverse;
+        EffectChain chain;
     };
 
+    // Aufgelöste Zone; sample zeigt in samples oder zoneSamples
+    struct Zone {
+        ZoneDefinition definition;
+        Sample* sample;
+        int legacyNote;         // von loadSample angelegt, sonst -1
+    };
+
+    // Stimme; alle Zonen-Abhängigkeiten werden beim Start aufgelöst
     struct Note {
+        const Sample* sample;   // Sample der Zone, kein Lookup beim Rendern
+        bool releaseTrigger;
+        uint64_t startFrame;
         int note;
         int velocity;
         float amplitude;
-        float position;
+        double position;        // Frames im Sample, Loops abgewickelt
+        double increment;       // Frames pro Ausgabe-Frame
+        bool loop;
+        uint64_t loopStart;     // Frames
+        uint64_t loopEnd;
+        int streamVoice;        // Streaming-Stimme, -1 = nur residente Daten
         float filterEnvelope;
         float ampEnvelope;
         bool active;
@@ -144,27 +242,102 @@ private:
         float sliceFilterEnvelope;
         float sliceAmpEnvelope;
         bool sliceActive;
+        int stretcher;          // Index im Stretcher-Pool, -1 = ohne Time-Stretch
+        float releaseGain;      // Ausklingen nach Note-Off, Stretcher bleibt bis zum Ende
+        float releaseStep;      // 0 = Taste gehalten
     };
 
     std::map<int, Sample> samples;
-    std::map<int, Note> activeNotes;
+    std::map<std::string, Sample> zoneSamples;
+    std::vector<Zone> zones;
+    std::array<std::vector<int>, 128> zonesByKey;   // Zonen-Indizes pro Taste
+
+    // Stimmen: feste Anzahl, Note-On nimmt eine freie oder die älteste
+    static constexpr int kMaxVoices = 64;
+    static constexpr float kMinReleaseSeconds = 0.005f;   // Mindest-Ausklang gegen Knacken
+    std::vector<Note> voices;
+
+    // Zustand pro Taste für Round Robin und Release-Trigger
+    std::array<uint32_t, 128> sequenceCounters;
+    std::array<int, 128> heldVelocity;              // 0 = nicht gehalten
+    std::array<uint64_t, 128> noteOnFrames;
+    uint64_t frameCounter;
+    uint32_t randomState;
+
+    // Blockverarbeitung und gemeinsamer Send-Bus. Das Delay des Busses nutzt
+    // die zuletzt per setSampleDelay gesetzte Zeit und Rückkopplung. Hall und
+    // Delay liefern nur den Effektanteil, das trockene Signal kommt aus der Stimme.
+    static constexpr unsigned long kBlockSize = 64;
+    static constexpr unsigned long kMaxBusDelayFrames = 2 * 44100;   // 2 s bei 44.1kHz
+    static constexpr float kMaxBusDelayFeedback = 0.95f;
+    static constexpr int kReverbCombs = 4;
+    static constexpr int kReverbAllpasses = 2;
+    static constexpr float kReverbFeedback = 0.84f;
+    static constexpr float kReverbDamping = 0.2f;
+    static constexpr float kReverbInputGain = 0.04f;  // Summe der Kämme bei Gleichanteil ~ 1
+    std::vector<float> voiceBlock;
+    std::vector<float> reverbBus;
+    std::vector<float> delayBus;
+    float busDelayTime;
+    float busDelayFeedback;
+    unsigned long reverbTail;
+    unsigned long delayTail;
+    unsigned long reverbTailFrames;                 // Ausklingen nach dem letzten Send
+    unsigned long delayTailFrames;
+
+    // Puffer der Send-Effekte, im Konstruktor angelegt
+    std::vector<float> delayLine;
+    unsigned long delayWrite;
+    std::array<std::vector<float>, kReverbCombs> reverbCombs;
+    std::array<size_t, kReverbCombs> reverbCombIndex;
+    std::array<float, kReverbCombs> reverbCombDamp; // Tiefpass im Kammfilter
+    std::array<std::vector<float>, kReverbAllpasses> reverbAllpasses;
+    std::array<size_t, kReverbAllpasses> reverbAllpassIndex;
     float pitchBend;
     float modulation;
     float aftertouch;
 
+    // Time-Stretch: vorbereitete Stretcher für gleichzeitig klingende Noten
+    static constexpr int kMaxStretchVoices = 16;
+    std::vector<std::unique_ptr<VRMusicStudio::TimeStretcher>> stretchers;
+    std::vector<int> freeStretchers;
+    int acquireStretcher();
+    void releaseStretcher(Note& note);
+
+    // Disk-Streaming: die ersten Millisekunden jedes Samples bleiben im
+    // Speicher, der Rest wird pro Stimme im Hintergrund nachgeladen
+    static constexpr int kMaxStreamVoices = 64;
+    std::unique_ptr<VRMusicStudio::SampleStreamer> streamer;
+    void stopStream(Note& note);
+    float readFrame(const Sample& sample, const Note& note, uint64_t frame);
+
     void noteOn(int note, int velocity);
     void noteOff(int note);
-    float processSample(const Sample& sample, float position);
+    bool createSample(const std::string& path, Sample& sample);
+    void rebuildKeyMap();
+    Sample* findSample(int target);
+    void stopVoices(const Sample* sample);
+    void stopVoice(Note& voice);
+    void releaseVoice(Note& voice);
+    void startZones(int note, int velocity, bool releaseTrigger, uint32_t sequence, float heldSeconds);
+    void startVoice(const Zone& zone, int note, int velocity, float gain, bool releaseTrigger);
+    float nextRandom();
+    static float crossfadeGain(const ZoneDefinition& zone, int velocity);
+    static LfoTarget parseLfoTarget(const std::string& destination);
+    void compileChain(Sample& sample);
+    void renderVoice(Note& voice, float* block, unsigned long frames);
+    void runStage(VoiceStage stage, const Sample& sample, const Note& voice, float* block, unsigned long frames);
+    float processSample(const Sample& sample, Note& note);
     float processFilter(float input, float cutoff, float resonance);
     float processEnvelope(float input, float attack, float decay, float sustain, float release, float time);
-    float processLFO(float rate, float amount, const std::string& destination, float time);
+    float processLFO(float rate, float amount, float time);
     float processReverb(float input, float amount);
     float processDelay(float input, float time, float feedback);
     float processCompression(float input, float threshold, float ratio);
     float processEQ(float input, float low, float mid, float high);
     float processDistortion(float input, float amount);
     float processGranular(float input, float grainSize, float density, float pitch);
-    float processTimeStretch(float input, float rate);
+    float processTimeStretch(Note& note, const Sample& sample, const VRMusicStudio::StreamedSample& stream);
     float processReverse(float input);
     float processSlice(const Sample& sample, int slice, float position);
     float processSliceFilter(float input, float cutoff, float resonance);
@@ -1,15 +1,42 @@
 #pragma once
 
 #include "../PluginInterface.hpp"
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
-#include <map>
 
 namespace VR_DAW {
 
+// Polyphoner Synthesizer mit festem Stimmen-Pool.
+//
+// Alle kMaxVoices Stimmen sind vorab als Structure of Arrays angelegt; je vier
+// benachbarte Stimmen werden als eine SIMD-Gruppe (Float4) blockweise
+// gerechnet, leere Gruppen werden übersprungen. noteOn() belegt pro Note
+// "unison" Stimmen und stiehlt bei vollem Pool nach der gewählten Strategie,
+// ohne zu allozieren. Eine gestohlene Stimme setzt ihre Hüllkurve beim
+// aktuellen Pegel fort, dadurch entsteht kein Sprung in der Lautstärke.
+//
+// Jede Stimme hat ein eigenes Zero-Delay-Feedback-Filter (State Variable
+// oder 4-Pol-Ladder) mit Key Tracking, zwei ADSR-Hüllkurven und eine LFO-
+// Phase. Hüllkurven, LFO und Filterkoeffizienten werden nur alle
+// kControlRate Frames berechnet (exponentielle Segmente per Rekursion mit
+// vorberechnetem Faktor) und dazwischen linear interpoliert; pro Sample
+// bleiben Oszillatoren, Filter und ein paar Multiply-Adds.
 class Synthesizer : public InstrumentPlugin {
 public:
+    enum class VoiceStealing {
+        Oldest,         // älteste Stimme, losgelassene zuerst
+        Quietest,       // leiseste Stimme, losgelassene zuerst
+        SameNote        // gleiche Note wird neu getriggert, sonst älteste
+    };
+
+    static constexpr int kMaxVoices = 256;
+    static constexpr int kMaxUnison = 8;
+    static constexpr int kNumOscillators = 3;
+    static constexpr unsigned long kControlRate = 16;  // Frames pro Modulations-Schritt
+    static constexpr float kSampleRate = 44100.0f;
+
     Synthesizer();
     ~Synthesizer();
 
@@ -66,6 +93,7 @@ public:
     void setFilterType(const std::string& type);
     void setFilterCutoff(float cutoff);
     void setFilterResonance(float resonance);
+    void setFilterKeyTracking(float amount);
     void setFilterEnvelopeAmount(float amount);
     void setFilterEnvelopeAttack(float attack);
     void setFilterEnvelopeDecay(float decay);
@@ -79,25 +107,44 @@ public:
     void setLfoAmount(float amount);
     void setLfoWaveform(const std::string& waveform);
     void setLfoDestination(const std::string& destination);
+    void setLfoSync(bool sync);
+    void setLfoDivision(const std::string& division);
+    void setLfoRetrigger(bool retrigger);
+    void setTempo(float bpm);
+
+    // Stimmenverwaltung
+    void setVoiceStealing(VoiceStealing mode);
+    void setMaxPolyphony(int count);
+    void setUnisonVoices(int count);
+    void setUnisonDetune(float cents);
+    void allNotesOff();
+    int getActiveVoiceCount() const { return activeVoiceCount; }
 
 private:
     std::string id;
     std::string name;
 
+    enum class Waveform : uint8_t { Sine, Square, Saw, Triangle };
+    enum class EnvelopeStage : uint8_t { Idle, Attack, Decay, Sustain, Release };
+    enum class FilterMode : uint8_t { Lowpass, Highpass, Bandpass, Notch, Ladder };
+    enum class LfoDestination : uint8_t { Filter, Amplitude, Pitch };
+
     // Synthesizer-Komponenten
     struct Oscillator {
         std::string waveform;
-        float frequency;
+        Waveform shape;
+        float frequency;    // relativ zu 440 Hz = Grundton der Note
         float detune;
         float mix;
-        float phase;
     };
     std::vector<Oscillator> oscillators;
 
     struct Filter {
         std::string type;
+        FilterMode mode;
         float cutoff;
         float resonance;
+        float keyTracking;      // 0 - 1, 1 = Cutoff folgt der Note (C4 neutral)
         float envelopeAmount;
         float envelopeAttack;
         float envelopeDecay;
@@ -115,25 +162,64 @@ private:
     Envelope ampEnvelope;
     Envelope filterEnvelope;
 
+    // Faktoren für einen Steuerschritt: level = target + (level - target) * coef
+    struct EnvelopeRates {
+        float attackTarget;
+        float attackCoef;
+        float decayCoef;
+        float releaseCoef;
+    };
+    EnvelopeRates ampRates;
+    EnvelopeRates filterRates;
+
     struct LFO {
         float rate;
         float amount;
         std::string waveform;
         std::string destination;
-        float phase;
+        float phase;            // freilaufend, Startphase ohne Retrigger
+        Waveform shape;
+        LfoDestination target;
+        bool sync;
+        float division;         // Viertelnoten pro Zyklus bei Sync
+        bool retrigger;
     };
     LFO lfo;
 
-    // Aktive Noten
-    struct Note {
-        int note;
-        int velocity;
-        float amplitude;
-        float filterEnvelope;
-        float ampEnvelope;
-        bool active;
+    // Stimmen-Pool (Structure of Arrays); Stimme v liegt in Gruppe v / 4
+    static constexpr int kLanes = 4;
+    static constexpr int kGroups = kMaxVoices / kLanes;
+    struct VoicePool {
+        // pro Sample (SIMD)
+        alignas(16) float phase[kNumOscillators][kMaxVoices];
+        alignas(16) float increment[kMaxVoices];    // Grundton in Zyklen pro Frame
+        alignas(16) float pitchMod[kMaxVoices];     // LFO-Faktor für increment
+        alignas(16) float amp[kMaxVoices];          // Hüllkurve * Gain, interpoliert
+        alignas(16) float ampDelta[kMaxVoices];
+        alignas(16) float coef[3][kMaxVoices];      // Filterkoeffizienten, interpoliert
+        alignas(16) float coefDelta[3][kMaxVoices];
+        alignas(16) float filterState[4][kMaxVoices];
+        // pro Steuerschritt
+        float gain[kMaxVoices];                     // Velocity und Unison-Pegel
+        float envLevel[kMaxVoices];
+        float filterEnvLevel[kMaxVoices];
+        float lfoPhase[kMaxVoices];
+        int note[kMaxVoices];
+        uint64_t started[kMaxVoices];               // noteOn-Zähler beim Start
+        EnvelopeStage stage[kMaxVoices];
+        EnvelopeStage filterStage[kMaxVoices];
+        uint8_t groupVoices[kGroups];               // aktive Stimmen je Gruppe
     };
-    std::map<int, Note> activeNotes;
+    VoicePool voices;
+    int activeVoiceCount;
+    uint64_t noteCounter;
+    VoiceStealing voiceStealing;
+    int maxPolyphony;
+    int unisonVoices;
+    float unisonDetune;     // Cent zwischen äußersten Unison-Stimmen
+    float pitchBend;        // Frequenzfaktor
+    float tempo;            // BPM für LFO-Sync
+    unsigned long controlRemaining;     // Frames bis zum nächsten Steuerschritt
 
     // Hilfsfunktionen
     void generateId();
@@ -141,10 +227,17 @@ private:
     void initializeFilter();
     void initializeEnvelopes();
     void initializeLFO();
-    float processOscillator(const Oscillator& osc, float time);
-    float processFilter(float input, float cutoff, float resonance);
-    float processEnvelope(const Envelope& env, float time, bool noteOn);
-    float processLFO(float time);
+    int allocateVoice(int note);
+    void startVoice(int voice, int note, int velocity, int unisonIndex);
+    void releaseVoice(int voice);
+    void freeVoice(int voice);
+    static Waveform parseWaveform(const std::string& waveform);
+    void updateEnvelopeRates();
+    void updateModulation();
+    void computeFilterCoefficients(int voice, float lfoValue, float* coefficients) const;
+    void renderVoices(float* output, unsigned long frames);
+    float processEnvelope(float level, EnvelopeStage& stage, const EnvelopeRates& rates, float sustain) const;
+    float processLFO(float phase) const;
 };
 
 } // namespace VR_DAW 
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <random>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 
 namespace VRMusicStudio {
 
@@ -15,8 +16,16 @@ AudioTrack::AudioTrack(const std::string& name)
     , volume(1.0f)
     , muted(false)
     , pan(0.0f)
+    , sampleRate(44100.0)
+    , outputSilent(true)
+    , clipTempo(0.0)
+    , projectTempo(120.0)
+    , stretchQuality(TimeStretcher::Quality::Standard)
+    , stretchSlot(std::make_shared<StretchSlot>())
+    , stretcherNeedsReset(true)
 {
     generateId();
+    stretcher.prepare(stretchQuality);
 }
 
 AudioTrack::~AudioTrack() {
@@ -68,6 +77,9 @@ bool AudioTrack::loadAudioFile(const std::string& filePath) {
     }
 
     sf_close(file);
+    sampleRate = fileInfo.samplerate;
+    stretcherNeedsReset = true;
+    requestPrerender();
     spdlog::info("Audio-Datei geladen: {}", filePath);
     return true;
 }
@@ -76,7 +88,7 @@ bool AudioTrack::saveAudioFile(const std::string& filePath) const {
     std::lock_guard<std::mutex> lock(mutex);
     
     SF_INFO fileInfo;
-    fileInfo.samplerate = 44100;
+    fileInfo.samplerate = static_cast<int>(sampleRate);
     fileInfo.channels = 1;
     fileInfo.format = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
 
@@ -102,6 +114,7 @@ void AudioTrack::clear() {
     std::lock_guard<std::mutex> lock(mutex);
     audioData.clear();
     position = 0.0;
+    TimeStretchPrerenderer::getInstance().cancel(stretchSlot);
 }
 
 void AudioTrack::startRecording() {
@@ -133,6 +146,7 @@ void AudioTrack::stopPlayback() {
 void AudioTrack::setPosition(double newPosition) {
     std::lock_guard<std::mutex> lock(mutex);
     position = std::max(0.0, std::min(newPosition, static_cast<double>(audioData.size())));
+    stretcherNeedsReset = true;
 }
 
 double AudioTrack::getPosition() const {
@@ -143,10 +157,12 @@ double AudioTrack::getPosition() const {
 bool AudioTrack::addPlugin(const std::string& pluginId) {
     std::lock_guard<std::mutex> lock(mutex);
     
-    // Hier würde die Plugin-Instanz erstellt und initialisiert werden
+    // Hier würde die Plugin-Instanz erstellt und initialisiert werden;
+    // pluginSleep wächst mit, damit der Audio-Thread nie allokiert
     // auto plugin = PluginManager::getInstance().createPlugin(pluginId);
     // if (plugin) {
     //     plugins.push_back(plugin);
+    //     pluginSleep.emplace_back();
     //     return true;
     // }
     return false;
@@ -159,6 +175,7 @@ bool AudioTrack::removePlugin(const std::string& pluginId) {
         [&](const auto& plugin) { return plugin->getId() == pluginId; });
     
     if (it != plugins.end()) {
+        pluginSleep.erase(pluginSleep.begin() + (it - plugins.begin()));
         plugins.erase(it);
         return true;
     }
@@ -180,24 +197,29 @@ std::vector<std::shared_ptr<PluginInterface>> AudioTrack::getPlugins() const {
 
 void AudioTrack::processAudio(float* buffer, unsigned long framesPerBuffer) {
     std::lock_guard<std::mutex> lock(mutex);
-    
-    if (!playing || audioData.empty()) {
-        std::fill(buffer, buffer + framesPerBuffer, 0.0f);
-        return;
-    }
 
-    // Audio-Daten kopieren
-    for (unsigned long i = 0; i < framesPerBuffer; ++i) {
-        size_t index = static_cast<size_t>(position + i);
-        if (index < audioData.size()) {
-            buffer[i] = audioData[index];
-        } else {
-            buffer[i] = 0.0f;
+    // Gestoppt: die Plugins bekommen Stille, bis Hall und Echos ausgeklungen sind
+    const bool hasClip = playing && !audioData.empty();
+    const double speed = hasClip ? getStretchSpeed() : 1.0;
+    if (!hasClip) {
+        std::fill(buffer, buffer + framesPerBuffer, 0.0f);
+    } else if (speed != 1.0) {
+        renderStretched(buffer, framesPerBuffer, speed);
+    } else {
+        // Audio-Daten kopieren
+        for (unsigned long i = 0; i < framesPerBuffer; ++i) {
+            size_t index = static_cast<size_t>(position + i);
+            if (index < audioData.size()) {
+                buffer[i] = audioData[index];
+            } else {
+                buffer[i] = 0.0f;
+            }
         }
+        stretcherNeedsReset = true;
     }
 
     // Plugins verarbeiten
-    processPlugins(buffer, framesPerBuffer);
+    const bool silent = processPlugins(buffer, framesPerBuffer);
 
     // Volume und Pan anwenden
     if (!muted) {
@@ -207,18 +229,114 @@ void AudioTrack::processAudio(float* buffer, unsigned long framesPerBuffer) {
     } else {
         std::fill(buffer, buffer + framesPerBuffer, 0.0f);
     }
+    outputSilent = silent || muted;
 
-    // Position aktualisieren
-    position += framesPerBuffer;
+    if (!hasClip) {
+        return;
+    }
+
+    // Position aktualisieren (in Frames des Original-Clips)
+    position += static_cast<double>(framesPerBuffer) * speed;
     if (position >= audioData.size()) {
         playing = false;
     }
 }
 
-void AudioTrack::processPlugins(float* buffer, unsigned long framesPerBuffer) {
-    for (auto& plugin : plugins) {
-        plugin->processAudio(buffer, framesPerBuffer);
+void AudioTrack::renderStretched(float* buffer, unsigned long framesPerBuffer, double speed) {
+    // Vorgerenderter Clip für das aktuelle Tempo: nur kopieren
+    auto clip = stretchSlot->load();
+    if (clip && clip->speed == speed && clip->quality == stretchQuality) {
+        const double start = position / speed;
+        for (unsigned long i = 0; i < framesPerBuffer; ++i) {
+            size_t index = static_cast<size_t>(start + i);
+            buffer[i] = index < clip->audio.size() ? clip->audio[index] : 0.0f;
+        }
+        stretcherNeedsReset = true;
+        return;
+    }
+
+    // Sonst live strecken, bis das Rendering fertig ist
+    if (stretcherNeedsReset) {
+        stretcher.setSpeed(speed);
+        stretcher.reset(position);
+        stretcherNeedsReset = false;
+    }
+    stretcher.setSpeed(speed);
+
+    TimeStretcher::Source source;
+    source.data = audioData.data();
+    source.frames = audioData.size();
+    stretcher.process(source, buffer, framesPerBuffer);
+}
+
+double AudioTrack::getStretchSpeed() const {
+    if (clipTempo <= 0.0 || projectTempo <= 0.0) {
+        return 1.0;
+    }
+    return std::clamp(projectTempo / clipTempo, TimeStretcher::kMinSpeed, TimeStretcher::kMaxSpeed);
+}
+
+void AudioTrack::requestPrerender() {
+    const double speed = getStretchSpeed();
+    if (speed == 1.0 || audioData.empty()) {
+        TimeStretchPrerenderer::getInstance().cancel(stretchSlot);
+        return;
+    }
+    auto source = std::make_shared<const std::vector<float>>(audioData);
+    TimeStretchPrerenderer::getInstance().request(stretchSlot, std::move(source), speed, stretchQuality);
+}
+
+void AudioTrack::setClipTempo(double bpm) {
+    std::lock_guard<std::mutex> lock(mutex);
+    clipTempo = std::max(0.0, bpm);
+    requestPrerender();
+}
+
+double AudioTrack::getClipTempo() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return clipTempo;
+}
+
+void AudioTrack::setProjectTempo(double bpm) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (bpm <= 0.0 || bpm == projectTempo) {
+        return;
     }
+    projectTempo = bpm;
+    requestPrerender();
+}
+
+void AudioTrack::setTimeStretchQuality(TimeStretcher::Quality quality) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (quality == stretchQuality) {
+        return;
+    }
+    stretchQuality = quality;
+    stretcher.prepare(stretchQuality);
+    stretcherNeedsReset = true;
+    requestPrerender();
+}
+
+bool AudioTrack::isTimeStretchPrerendered() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto clip = stretchSlot->load();
+    return clip && clip->speed == getStretchSpeed() && clip->quality == stretchQuality;
+}
+
+bool AudioTrack::processPlugins(float* buffer, unsigned long framesPerBuffer) {
+    // Die Stille-Fahne folgt dem Puffer durch die Kette; ausgeklungene
+    // Plugins werden übersprungen und lassen den stillen Puffer unverändert
+    bool silent = isSilent(buffer, framesPerBuffer);
+    for (size_t i = 0; i < plugins.size(); ++i) {
+        const double tail = plugins[i]->getTailSeconds();
+        const int64_t tailFrames = tail < 0.0 ? -1 : static_cast<int64_t>(tail * sampleRate);
+        if (!pluginSleep[i].update(silent, framesPerBuffer, tailFrames)) {
+            continue;
+        }
+        plugins[i]->processAudio(buffer, framesPerBuffer);
+        silent = isSilent(buffer, framesPerBuffer);
+    }
+    return silent;
 }
 
 void AudioTrack::setVolume(float newVolume) {
@@ -246,6 +364,11 @@ void AudioTrack::setPan(float newPan) {
     pan = std::max(-1.0f, std::min(1.0f, newPan));
 }
 
+bool AudioTrack::isOutputSilent() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return outputSilent;
+}
+
 float AudioTrack::getPan() const {
     std::lock_guard<std::mutex> lock(mutex);
     return pan;
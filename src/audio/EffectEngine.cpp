@@ -7,9 +7,18 @@ namespace VR_DAW {
 
 EffectEngine::EffectEngine() {
     initializeComponents();
+    rebuildThread = std::thread(&EffectEngine::rebuildLoop, this);
 }
 
 EffectEngine::~EffectEngine() {
+    {
+        std::lock_guard<std::mutex> lock(rebuildMutex);
+        shouldStop = true;
+    }
+    rebuildCondition.notify_all();
+    if (rebuildThread.joinable()) {
+        rebuildThread.join();
+    }
     shutdown();
 }
 
@@ -42,6 +51,7 @@ void EffectEngine::update() {
 
 void EffectEngine::shutdown() {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         audioEngine.reset();
         state.effectBuffers.clear();
         state.chainBuffers.clear();
@@ -50,8 +60,10 @@ void EffectEngine::shutdown() {
         state.effectParameters.clear();
         state.effectBypasses.clear();
         state.effectMixes.clear();
+        state.effectSidechains.clear();
         state.effectChains.clear();
         state.effectRacks.clear();
+        requestRebuild();
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -64,13 +76,15 @@ void EffectEngine::processEffect(const std::string& effectName, const std::vecto
             throw std::runtime_error("Invalid effect buffer");
         }
 
-        // Verarbeite Effekt
+        // Ein Schnappschuss pro Puffer, noch nicht kompilierte Effekte reichen durch
         outputBuffer = inputBuffer;
-        if (!state.effectBypasses[effectName]) {
-            float mix = state.effectMixes[effectName];
-            for (float& sample : outputBuffer) {
-                sample = sample * (1.0f - mix) + processEffectSample(effectName, sample) * mix;
-            }
+        auto graph = compiledGraph.load();
+        if (!graph) return;
+
+        auto it = graph->effects.find(effectName);
+        if (it != graph->effects.end()) {
+            it->second.process(outputBuffer.data(), outputBuffer.size(),
+                               VRMusicStudio::isSilent(outputBuffer.data(), outputBuffer.size()));
         }
     } catch (const std::exception& e) {
         handleErrors();
@@ -84,10 +98,14 @@ void EffectEngine::processEffectChain(const std::string& chainName, const std::v
             throw std::runtime_error("Invalid effect chain buffer");
         }
 
-        // Verarbeite Effekt-Kette
+        // Verarbeite Effekt-Kette blockweise
         outputBuffer = inputBuffer;
-        for (const auto& effectName : state.effectChains[chainName]) {
-            processEffect(effectName, outputBuffer, outputBuffer);
+        auto graph = compiledGraph.load();
+        if (!graph) return;
+
+        auto it = graph->chains.find(chainName);
+        if (it != graph->chains.end()) {
+            it->second.process(outputBuffer.data(), outputBuffer.size());
         }
     } catch (const std::exception& e) {
         handleErrors();
@@ -101,10 +119,14 @@ void EffectEngine::processEffectRack(const std::string& rackName, const std::vec
             throw std::runtime_error("Invalid effect rack buffer");
         }
 
-        // Verarbeite Effekt-Rack
+        // Verarbeite Effekt-Rack blockweise
         outputBuffer = inputBuffer;
-        for (const auto& effectName : state.effectRacks[rackName]) {
-            processEffect(effectName, outputBuffer, outputBuffer);
+        auto graph = compiledGraph.load();
+        if (!graph) return;
+
+        auto it = graph->racks.find(rackName);
+        if (it != graph->racks.end()) {
+            it->second.process(outputBuffer.data(), outputBuffer.size());
         }
     } catch (const std::exception& e) {
         handleErrors();
@@ -112,12 +134,51 @@ void EffectEngine::processEffectRack(const std::string& rackName, const std::vec
     }
 }
 
+GraphBuffer* EffectEngine::getGraphBuffer(const std::string& name) {
+    std::lock_guard<std::recursive_mutex> lock(editMutex);
+    auto& buffer = graphBuffers[name];
+    if (!buffer) {
+        buffer = std::make_unique<GraphBuffer>();
+    }
+    return buffer.get();
+}
+
+void EffectEngine::processGraph() {
+    try {
+        auto graph = compiledGraph.load();
+        if (!graph) return;
+
+        // Quellen sind bereits verarbeitet, wenn ihre Keys gelesen werden
+        for (const auto& node : graph->schedule) {
+            if (!node.buffer || node.buffer->empty()) continue;
+            node.rack.process(node.buffer->data(), node.buffer->size(), true);
+        }
+    } catch (const std::exception& e) {
+        handleErrors();
+        throw;
+    }
+}
+
+bool EffectEngine::isOutputSilent(const std::string& name) const {
+    auto graph = compiledGraph.load();
+    if (!graph) return false;
+
+    auto chain = graph->chains.find(name);
+    if (chain != graph->chains.end()) return chain->second.isOutputSilent();
+    auto rack = graph->racks.find(name);
+    return rack != graph->racks.end() && rack->second.isOutputSilent();
+}
+
 void EffectEngine::createEffect(const std::string& name, const std::string& type) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         state.effectTypes[name] = type;
         state.effectParameters[name] = std::map<std::string, float>();
         state.effectBypasses[name] = false;
         state.effectMixes[name] = 1.0f;
+        // Neu angelegte Effekte starten mit frischem Zustand und Standardwerten
+        processors.erase(name);
+        requestRebuild();
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -126,19 +187,26 @@ void EffectEngine::createEffect(const std::string& name, const std::string& type
 
 void EffectEngine::deleteEffect(const std::string& name) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         state.effectTypes.erase(name);
         state.effectParameters.erase(name);
         state.effectBypasses.erase(name);
         state.effectMixes.erase(name);
+        state.effectSidechains.erase(name);
+        requestRebuild();
     } catch (const std::exception& e) {
         handleErrors();
         throw;
     }
 }
 
+// Parameter, Bypass und Mix schreiben direkt in die gebundenen Slots und
+// brauchen keinen Neuaufbau
 void EffectEngine::setEffectParameter(const std::string& name, const std::string& parameterName, float value) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         state.effectParameters[name][parameterName] = value;
+        getSlot(name, parameterName, value);
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -147,7 +215,9 @@ void EffectEngine::setEffectParameter(const std::string& name, const std::string
 
 void EffectEngine::setEffectBypass(const std::string& name, bool bypass) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         state.effectBypasses[name] = bypass;
+        getSlot(name, "@bypass", bypass ? 1.0f : 0.0f);
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -156,7 +226,25 @@ void EffectEngine::setEffectBypass(const std::string& name, bool bypass) {
 
 void EffectEngine::setEffectMix(const std::string& name, float mix) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         state.effectMixes[name] = mix;
+        getSlot(name, "@mix", mix);
+    } catch (const std::exception& e) {
+        handleErrors();
+        throw;
+    }
+}
+
+void EffectEngine::setEffectSidechain(const std::string& name, const std::string& sourceName) {
+    try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
+        if (sourceName.empty()) {
+            state.effectSidechains.erase(name);
+        } else {
+            state.effectSidechains[name] = sourceName;
+        }
+        // Neue Key-Kante ändert die Verarbeitungsreihenfolge
+        requestRebuild();
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -165,7 +253,9 @@ void EffectEngine::setEffectMix(const std::string& name, float mix) {
 
 void EffectEngine::createEffectChain(const std::string& name) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         state.effectChains[name] = std::vector<std::string>();
+        requestRebuild();
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -174,7 +264,9 @@ void EffectEngine::createEffectChain(const std::string& name) {
 
 void EffectEngine::deleteEffectChain(const std::string& name) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         state.effectChains.erase(name);
+        requestRebuild();
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -183,7 +275,9 @@ void EffectEngine::deleteEffectChain(const std::string& name) {
 
 void EffectEngine::addEffectToChain(const std::string& chainName, const std::string& effectName) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         state.effectChains[chainName].push_back(effectName);
+        requestRebuild();
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -192,8 +286,10 @@ void EffectEngine::addEffectToChain(const std::string& chainName, const std::str
 
 void EffectEngine::removeEffectFromChain(const std::string& chainName, const std::string& effectName) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         auto& effects = state.effectChains[chainName];
         effects.erase(std::remove(effects.begin(), effects.end(), effectName), effects.end());
+        requestRebuild();
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -202,6 +298,7 @@ void EffectEngine::removeEffectFromChain(const std::string& chainName, const std
 
 void EffectEngine::setChainParameter(const std::string& chainName, const std::string& parameterName, float value) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         for (const auto& effectName : state.effectChains[chainName]) {
             setEffectParameter(effectName, parameterName, value);
         }
@@ -213,6 +310,7 @@ void EffectEngine::setChainParameter(const std::string& chainName, const std::st
 
 void EffectEngine::setChainBypass(const std::string& chainName, bool bypass) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         for (const auto& effectName : state.effectChains[chainName]) {
             setEffectBypass(effectName, bypass);
         }
@@ -224,6 +322,7 @@ void EffectEngine::setChainBypass(const std::string& chainName, bool bypass) {
 
 void EffectEngine::setChainMix(const std::string& chainName, float mix) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         for (const auto& effectName : state.effectChains[chainName]) {
             setEffectMix(effectName, mix);
         }
@@ -235,7 +334,9 @@ void EffectEngine::setChainMix(const std::string& chainName, float mix) {
 
 void EffectEngine::createEffectRack(const std::string& name) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         state.effectRacks[name] = std::vector<std::string>();
+        requestRebuild();
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -244,7 +345,9 @@ void EffectEngine::createEffectRack(const std::string& name) {
 
 void EffectEngine::deleteEffectRack(const std::string& name) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         state.effectRacks.erase(name);
+        requestRebuild();
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -253,7 +356,9 @@ void EffectEngine::deleteEffectRack(const std::string& name) {
 
 void EffectEngine::addEffectToRack(const std::string& rackName, const std::string& effectName) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         state.effectRacks[rackName].push_back(effectName);
+        requestRebuild();
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -262,8 +367,10 @@ void EffectEngine::addEffectToRack(const std::string& rackName, const std::strin
 
 void EffectEngine::removeEffectFromRack(const std::string& rackName, const std::string& effectName) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         auto& effects = state.effectRacks[rackName];
         effects.erase(std::remove(effects.begin(), effects.end(), effectName), effects.end());
+        requestRebuild();
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -272,6 +379,7 @@ void EffectEngine::removeEffectFromRack(const std::string& rackName, const std::
 
 void EffectEngine::setRackParameter(const std::string& rackName, const std::string& parameterName, float value) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         for (const auto& effectName : state.effectRacks[rackName]) {
             setEffectParameter(effectName, parameterName, value);
         }
@@ -283,6 +391,7 @@ void EffectEngine::setRackParameter(const std::string& rackName, const std::stri
 
 void EffectEngine::setRackBypass(const std::string& rackName, bool bypass) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         for (const auto& effectName : state.effectRacks[rackName]) {
             setEffectBypass(effectName, bypass);
         }
@@ -294,6 +403,7 @@ void EffectEngine::setRackBypass(const std::string& rackName, bool bypass) {
 
 void EffectEngine::setRackMix(const std::string& rackName, float mix) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(editMutex);
         for (const auto& effectName : state.effectRacks[rackName]) {
             setEffectMix(effectName, mix);
         }
@@ -303,6 +413,11 @@ void EffectEngine::setRackMix(const std::string& rackName, float mix) {
     }
 }
 
+void EffectEngine::waitForRebuild() {
+    std::unique_lock<std::mutex> lock(rebuildMutex);
+    rebuildCondition.wait(lock, [this] { return shouldStop || rebuildPublished == rebuildRequested; });
+}
+
 float EffectEngine::getEffectLevel(const std::string& name) {
     return analysis.effectLevels[name];
 }
@@ -492,9 +607,163 @@ float EffectEngine::calculateTransient(const std::vector<float>& buffer) {
     return sum / (buffer.size() - 2);
 }
 
-float EffectEngine::processEffectSample(const std::string& effectName, float sample) {
-    // Effekt-spezifische Verarbeitung
-    return sample;
+ParameterSlot* EffectEngine::getSlot(const std::string& effectName, const std::string& parameterName, float value) {
+    auto& slot = parameterSlots[effectName + "|" + parameterName];
+    if (!slot) {
+        slot = std::make_unique<ParameterSlot>(value);
+    } else {
+        slot->value.store(value, std::memory_order_relaxed);
+    }
+    return slot.get();
+}
+
+void EffectEngine::requestRebuild() {
+    {
+        std::lock_guard<std::mutex> lock(rebuildMutex);
+        ++rebuildRequested;
+    }
+    rebuildCondition.notify_all();
+}
+
+void EffectEngine::rebuildLoop() {
+    while (true) {
+        uint64_t target = 0;
+        {
+            std::unique_lock<std::mutex> lock(rebuildMutex);
+            rebuildCondition.wait(lock, [this] { return shouldStop || rebuildRequested != rebuildPublished; });
+            if (shouldStop) return;
+            // Mehrere Änderungen in Folge ergeben einen einzigen Neuaufbau
+            target = rebuildRequested;
+        }
+
+        try {
+            compiledGraph.publish(compileGraph());
+        } catch (const std::exception& e) {
+            handleErrors();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(rebuildMutex);
+            rebuildPublished = target;
+        }
+        rebuildCondition.notify_all();
+    }
+}
+
+std::shared_ptr<const CompiledEffectGraph> EffectEngine::compileGraph() {
+    std::lock_guard<std::recursive_mutex> lock(editMutex);
+    auto graph = std::make_shared<CompiledEffectGraph>();
+
+    // Prozessoren gelöschter oder umtypisierter Effekte verwerfen; ältere
+    // Schnappschüsse halten sie am Leben, solange der Audio-Thread sie nutzt
+    for (auto it = processors.begin(); it != processors.end();) {
+        auto type = state.effectTypes.find(it->first);
+        if (type == state.effectTypes.end() || type->second != it->second->getType()) {
+            it = processors.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (const auto& [name, type] : state.effectTypes) {
+        const auto& values = state.effectParameters[name];
+
+        // Bestehende Prozessoren behalten Zustand (Delay-Puffer, Filter)
+        // und ihre Slot-Bindung, neue werden einmalig gebunden
+        auto& processor = processors[name];
+        if (!processor) {
+            processor = EffectProcessor::create(type);
+            processor->prepare(parameters.sampleRate);
+            const auto defaults = processor->getParameterDefaults();
+            for (size_t i = 0; i < defaults.size(); ++i) {
+                auto value = values.find(defaults[i].first);
+                const float initial = value != values.end() ? value->second : defaults[i].second;
+                processor->bindParameter(i, getSlot(name, defaults[i].first, initial));
+            }
+        }
+
+        CompiledEffect effect;
+        effect.processor = processor;
+        effect.sampleRate = parameters.sampleRate;
+        effect.bypass = getSlot(name, "@bypass", state.effectBypasses[name] ? 1.0f : 0.0f);
+        effect.mix = getSlot(name, "@mix", state.effectMixes.count(name) ? state.effectMixes[name] : 1.0f);
+        auto sidechain = state.effectSidechains.find(name);
+        if (sidechain != state.effectSidechains.end() && processor->hasKeyInput()) {
+            effect.keySource = sidechain->second;
+            effect.key = getGraphBuffer(sidechain->second);
+        }
+        graph->effects.emplace(name, std::move(effect));
+    }
+
+    for (const auto& [name, effectNames] : state.effectChains) {
+        graph->chains.emplace(name, CompiledRack(compileSequence(effectNames, graph->effects)));
+    }
+    for (const auto& [name, effectNames] : state.effectRacks) {
+        graph->racks.emplace(name, CompiledRack(compileSequence(effectNames, graph->effects)));
+    }
+    graph->schedule = scheduleGraph(*graph);
+    for (auto& node : graph->schedule) {
+        node.buffer = getGraphBuffer(node.name);
+    }
+    return graph;
+}
+
+std::vector<CompiledEffect> EffectEngine::compileSequence(const std::vector<std::string>& effectNames,
+                                                          const std::map<std::string, CompiledEffect>& effects) const {
+    std::vector<CompiledEffect> sequence;
+    sequence.reserve(effectNames.size());
+    for (const auto& effectName : effectNames) {
+        auto it = effects.find(effectName);
+        if (it != effects.end()) {
+            sequence.push_back(it->second);
+        }
+    }
+    return sequence;
+}
+
+// Topologische Sortierung (Kahn) über Ketten und Racks. Eine Kante führt von
+// jedem Knoten mit dem Namen einer Key-Quelle zu dem Knoten, der den Key
+// liest. Bei Zyklen werden die übrigen Knoten in ihrer Reihenfolge angehängt;
+// ihre Keys sehen dann den noch unverarbeiteten Quellpuffer.
+std::vector<ScheduledRack> EffectEngine::scheduleGraph(const CompiledEffectGraph& graph) const {
+    std::vector<ScheduledRack> nodes;
+    for (const auto& [name, rack] : graph.chains) nodes.push_back({name, rack});
+    for (const auto& [name, rack] : graph.racks) nodes.push_back({name, rack});
+
+    std::vector<std::vector<size_t>> dependents(nodes.size());
+    std::vector<size_t> pending(nodes.size(), 0);
+    for (size_t target = 0; target < nodes.size(); ++target) {
+        for (const auto& effect : nodes[target].rack.effects()) {
+            if (effect.keySource.empty() || effect.keySource == nodes[target].name) continue;
+            for (size_t source = 0; source < nodes.size(); ++source) {
+                if (nodes[source].name == effect.keySource) {
+                    dependents[source].push_back(target);
+                    ++pending[target];
+                }
+            }
+        }
+    }
+
+    std::vector<size_t> order;
+    order.reserve(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (pending[i] == 0) order.push_back(i);
+    }
+    for (size_t next = 0; next < order.size(); ++next) {
+        for (size_t target : dependents[order[next]]) {
+            if (--pending[target] == 0) order.push_back(target);
+        }
+    }
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (pending[i] != 0) order.push_back(i);
+    }
+
+    std::vector<ScheduledRack> schedule;
+    schedule.reserve(order.size());
+    for (size_t index : order) {
+        schedule.push_back(std::move(nodes[index]));
+    }
+    return schedule;
 }
 
-} // namespace VR_DAW 
\ No newline at end of file
+} // namespace VR_DAW
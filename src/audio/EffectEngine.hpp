@@ -0,0 +1,186 @@
+#pragma once
+
+#include "EffectRack.hpp"
+#include "audio/processing/AsyncResult.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace VR_DAW {
+
+class AudioEngine;
+
+// Effekte, Ketten und Racks werden über ihre Namen bearbeitet. Jede
+// strukturelle Änderung stößt im Hintergrund einen Neuaufbau an, der die
+// Ketten zu CompiledRacks mit vorab gebundenen Parameter-Slots übersetzt und
+// atomar veröffentlicht. Der Audio-Thread liest pro Puffer einen Schnappschuss
+// und verarbeitet ganze Blöcke ohne Locks.
+//
+// Sidechains: Ketten stehen für Spuren, Racks für Busse. Der Key-Eingang eines
+// Effekts kann per setEffectSidechain() an den Ausgang einer beliebigen Kette
+// oder eines Racks gehängt werden; processGraph() verarbeitet dann alle Knoten
+// so, dass jede Quelle vor den Effekten läuft, die sie als Key lesen. Knoten
+// und Keys sind beim Kompilieren an feste Graph-Puffer gebunden.
+class EffectEngine {
+public:
+    EffectEngine();
+    ~EffectEngine();
+
+    // Lifecycle Management
+    void initialize();
+    void update();
+    void shutdown();
+
+    // Effekt-Verarbeitung
+    void processEffect(const std::string& effectName, const std::vector<float>& inputBuffer, std::vector<float>& outputBuffer);
+    void processEffectChain(const std::string& chainName, const std::vector<float>& inputBuffer, std::vector<float>& outputBuffer);
+    void processEffectRack(const std::string& rackName, const std::vector<float>& inputBuffer, std::vector<float>& outputBuffer);
+
+    // Puffer einer Kette, eines Racks oder einer reinen Key-Quelle (z.B. eines
+    // trockenen Spurausgangs). Der Zeiger bleibt gültig, solange die Engine
+    // lebt; Größe einmalig hier setzen, den Inhalt schreibt der Audio-Thread.
+    GraphBuffer* getGraphBuffer(const std::string& name);
+
+    // Verarbeitet alle Ketten und Racks mit nicht leerem Graph-Puffer in-place
+    // in Abhängigkeitsreihenfolge. Sidechain-Keys lesen direkt aus den
+    // Puffern ihrer Quellen.
+    void processGraph();
+
+    // Ob der letzte Puffer einer Kette oder eines Racks digitale Stille war;
+    // ausgeklungene Ketten kann der Mixer überspringen
+    bool isOutputSilent(const std::string& name) const;
+
+    // Effekt-Management
+    void createEffect(const std::string& name, const std::string& type);
+    void deleteEffect(const std::string& name);
+    void setEffectParameter(const std::string& name, const std::string& parameterName, float value);
+    void setEffectBypass(const std::string& name, bool bypass);
+    void setEffectMix(const std::string& name, float mix);
+    // Key-Quelle (Ketten-/Rack-Name) eines Effekts; leer = eigener Eingang
+    void setEffectSidechain(const std::string& name, const std::string& sourceName);
+
+    // Ketten-Management
+    void createEffectChain(const std::string& name);
+    void deleteEffectChain(const std::string& name);
+    void addEffectToChain(const std::string& chainName, const std::string& effectName);
+    void removeEffectFromChain(const std::string& chainName, const std::string& effectName);
+    void setChainParameter(const std::string& chainName, const std::string& parameterName, float value);
+    void setChainBypass(const std::string& chainName, bool bypass);
+    void setChainMix(const std::string& chainName, float mix);
+
+    // Rack-Management
+    void createEffectRack(const std::string& name);
+    void deleteEffectRack(const std::string& name);
+    void addEffectToRack(const std::string& rackName, const std::string& effectName);
+    void removeEffectFromRack(const std::string& rackName, const std::string& effectName);
+    void setRackParameter(const std::string& rackName, const std::string& parameterName, float value);
+    void setRackBypass(const std::string& rackName, bool bypass);
+    void setRackMix(const std::string& rackName, float mix);
+
+    // Blockiert, bis alle angestoßenen Neuaufbauten veröffentlicht sind
+    void waitForRebuild();
+
+    // Analyse
+    float getEffectLevel(const std::string& name);
+    float getEffectSpectrum(const std::string& name);
+    float getEffectPhase(const std::string& name);
+    float getEffectCorrelation(const std::string& name);
+    float getEffectDynamics(const std::string& name);
+    float getEffectStereo(const std::string& name);
+    float getEffectFrequency(const std::string& name);
+    float getEffectTransient(const std::string& name);
+
+    // Visualisierung
+    void updateEffectVisualization(const std::string& name);
+    void updateChainVisualization(const std::string& name);
+    void updateRackVisualization(const std::string& name);
+    void updateAnalysisVisualization();
+
+private:
+    // Komponenten
+    std::unique_ptr<AudioEngine> audioEngine;
+
+    // State (Bearbeitungsseite, geschützt durch editMutex)
+    struct {
+        std::map<std::string, std::vector<float>> effectBuffers;
+        std::map<std::string, std::vector<float>> chainBuffers;
+        std::map<std::string, std::vector<float>> rackBuffers;
+        std::map<std::string, std::string> effectTypes;
+        std::map<std::string, std::map<std::string, float>> effectParameters;
+        std::map<std::string, bool> effectBypasses;
+        std::map<std::string, float> effectMixes;
+        std::map<std::string, std::string> effectSidechains;
+        std::map<std::string, std::vector<std::string>> effectChains;
+        std::map<std::string, std::vector<std::string>> effectRacks;
+    } state;
+
+    // Parameter
+    struct {
+        float sampleRate = 44100.0f;
+        int bufferSize = 1024;
+    } parameters;
+
+    // Analyse
+    struct {
+        std::map<std::string, float> effectLevels;
+        std::map<std::string, float> effectSpectrums;
+        std::map<std::string, float> effectPhases;
+        std::map<std::string, float> effectCorrelations;
+        std::map<std::string, float> effectDynamics;
+        std::map<std::string, float> effectStereos;
+        std::map<std::string, float> effectFrequencies;
+        std::map<std::string, float> effectTransients;
+    } analysis;
+
+    // Kompilierte Effekte; Slots werden nie freigegeben, solange die Engine
+    // lebt, damit ein älterer Schnappschuss nie auf gelöschte Slots zeigt
+    std::recursive_mutex editMutex;
+    std::map<std::string, std::unique_ptr<ParameterSlot>> parameterSlots;
+    std::map<std::string, std::unique_ptr<GraphBuffer>> graphBuffers;
+    std::map<std::string, std::shared_ptr<EffectProcessor>> processors;
+    VRMusicStudio::AsyncResult<CompiledEffectGraph> compiledGraph;
+
+    // Neuaufbau im Hintergrund
+    std::mutex rebuildMutex;
+    std::condition_variable rebuildCondition;
+    uint64_t rebuildRequested = 0;
+    uint64_t rebuildPublished = 0;
+    bool shouldStop = false;
+    std::thread rebuildThread;
+
+    // Hilfsfunktionen
+    void initializeComponents();
+    void updateState();
+    void processEffects();
+    void processChains();
+    void processRacks();
+    void updateParameters();
+    void updateAnalysis();
+    void generateVisualization();
+    void validateState();
+    void handleErrors();
+    bool validateBuffer(const std::vector<float>& buffer);
+    float calculateLevel(const std::vector<float>& buffer);
+    float calculateSpectrum(const std::vector<float>& buffer);
+    float calculatePhase(const std::vector<float>& buffer);
+    float calculateCorrelation(const std::vector<float>& leftBuffer, const std::vector<float>& rightBuffer);
+    float calculateDynamics(const std::vector<float>& buffer);
+    float calculateStereo(const std::vector<float>& leftBuffer, const std::vector<float>& rightBuffer);
+    float calculateFrequency(const std::vector<float>& buffer);
+    float calculateTransient(const std::vector<float>& buffer);
+
+    ParameterSlot* getSlot(const std::string& effectName, const std::string& parameterName, float value);
+    void requestRebuild();
+    void rebuildLoop();
+    std::shared_ptr<const CompiledEffectGraph> compileGraph();
+    std::vector<CompiledEffect> compileSequence(const std::vector<std::string>& effectNames,
+                                                const std::map<std::string, CompiledEffect>& effects) const;
+    std::vector<ScheduledRack> scheduleGraph(const CompiledEffectGraph& graph) const;
+};
+
+} // namespace VR_DAW
@@ -0,0 +1,470 @@
+#include "EffectRack.hpp"
+#include "audio/processing/DspMath.hpp"
+#include "audio/processing/SidechainFilter.hpp"
+#include "audio/processing/SimdOps.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace VR_DAW {
+
+namespace {
+
+using VRMusicStudio::kPi;
+
+constexpr size_t kMixBlock = 256;
+constexpr size_t kControlBlock = 32;
+constexpr float kMinLevelDb = -120.0f;
+
+// Basis für Prozessoren mit festen Parametern; ungebundene Parameter lesen
+// ihren Standardwert
+class ParameterizedProcessor : public EffectProcessor {
+public:
+    explicit ParameterizedProcessor(std::vector<std::pair<std::string, float>> defaults)
+        : m_defaults(std::move(defaults)), m_slots(m_defaults.size(), nullptr) {}
+
+    std::vector<std::pair<std::string, float>> getParameterDefaults() const override { return m_defaults; }
+
+    void bindParameter(size_t index, const ParameterSlot* slot) override {
+        if (index < m_slots.size()) m_slots[index] = slot;
+    }
+
+protected:
+    float parameter(size_t index) const {
+        const ParameterSlot* slot = m_slots[index];
+        return slot ? slot->value.load(std::memory_order_relaxed) : m_defaults[index].second;
+    }
+
+private:
+    std::vector<std::pair<std::string, float>> m_defaults;
+    std::vector<const ParameterSlot*> m_slots;
+};
+
+class PassThroughProcessor : public EffectProcessor {
+public:
+    explicit PassThroughProcessor(std::string type) : m_type(std::move(type)) {}
+
+    const std::string& getType() const override { return m_type; }
+    void prepare(double) override {}
+    void process(float*, size_t) override {}
+    double getTailSeconds() const override { return 0.0; }
+
+private:
+    std::string m_type;
+};
+
+class GainProcessor : public ParameterizedProcessor {
+public:
+    GainProcessor() : ParameterizedProcessor({{"gain", 1.0f}}) {}
+
+    const std::string& getType() const override { static const std::string type = "gain"; return type; }
+    void prepare(double) override {}
+
+    void process(float* buffer, size_t numSamples) override {
+        VRMusicStudio::SimdOps::scale(buffer, parameter(0), numSamples);
+    }
+
+    double getTailSeconds() const override { return 0.0; }
+};
+
+class DistortionProcessor : public ParameterizedProcessor {
+public:
+    DistortionProcessor() : ParameterizedProcessor({{"drive", 1.0f}}) {}
+
+    const std::string& getType() const override { static const std::string type = "distortion"; return type; }
+    void prepare(double) override {}
+
+    void process(float* buffer, size_t numSamples) override {
+        const float drive = std::max(parameter(0), 0.01f);
+        const float normalize = 1.0f / std::tanh(drive);
+        for (size_t i = 0; i < numSamples; ++i) {
+            buffer[i] = std::tanh(buffer[i] * drive) * normalize;
+        }
+    }
+
+    double getTailSeconds() const override { return 0.0; }
+};
+
+// RBJ-Biquad; Koeffizienten werden nur bei Parameteränderung neu berechnet
+class FilterProcessor : public ParameterizedProcessor {
+public:
+    explicit FilterProcessor(bool highpass)
+        : ParameterizedProcessor({{"cutoff", highpass ? 20.0f : 20000.0f}, {"resonance", 0.7071f}}),
+          m_highpass(highpass) {}
+
+    const std::string& getType() const override {
+        static const std::string lowpass = "lowpass";
+        static const std::string highpass = "highpass";
+        return m_highpass ? highpass : lowpass;
+    }
+
+    void prepare(double sampleRate) override {
+        m_sampleRate = sampleRate;
+        m_cutoff = -1.0f;
+        m_z1 = m_z2 = 0.0f;
+    }
+
+    void process(float* buffer, size_t numSamples) override {
+        const float cutoff = parameter(0);
+        const float q = parameter(1);
+        if (cutoff != m_cutoff || q != m_q) {
+            updateCoefficients(cutoff, q);
+        }
+
+        float z1 = m_z1, z2 = m_z2;
+        for (size_t i = 0; i < numSamples; ++i) {
+            const float x = buffer[i];
+            const float y = m_b0 * x + z1;
+            z1 = m_b1 * x - m_a1 * y + z2;
+            z2 = m_b2 * x - m_a2 * y;
+            buffer[i] = y;
+        }
+        m_z1 = z1;
+        m_z2 = z2;
+    }
+
+    // Ausschwingen bis zur Stilleschwelle; der Polradius ist sqrt(a2)
+    double getTailSeconds() const override {
+        const double radius = std::sqrt(std::max(static_cast<double>(m_a2), 0.0));
+        if (radius <= 0.0) return 0.0;
+        if (radius >= 1.0) return VRMusicStudio::kInfiniteTail;
+        return std::log(static_cast<double>(VRMusicStudio::kSilenceThreshold)) / std::log(radius) / m_sampleRate;
+    }
+
+private:
+    void updateCoefficients(float cutoff, float q) {
+        m_cutoff = cutoff;
+        m_q = q;
+
+        const double frequency = std::clamp(static_cast<double>(cutoff), 10.0, m_sampleRate * 0.49);
+        const double w0 = 2.0 * kPi * frequency / m_sampleRate;
+        const double alpha = std::sin(w0) / (2.0 * std::max(static_cast<double>(q), 0.1));
+        const double cosW0 = std::cos(w0);
+        const double a0 = 1.0 + alpha;
+
+        const double b1 = m_highpass ? -(1.0 + cosW0) : 1.0 - cosW0;
+        const double b0 = m_highpass ? (1.0 + cosW0) * 0.5 : (1.0 - cosW0) * 0.5;
+        m_b0 = static_cast<float>(b0 / a0);
+        m_b1 = static_cast<float>(b1 / a0);
+        m_b2 = m_b0;
+        m_a1 = static_cast<float>(-2.0 * cosW0 / a0);
+        m_a2 = static_cast<float>((1.0 - alpha) / a0);
+    }
+
+    bool m_highpass;
+    double m_sampleRate = 44100.0;
+    float m_cutoff = -1.0f;
+    float m_q = 0.0f;
+    float m_b0 = 1.0f, m_b1 = 0.0f, m_b2 = 0.0f, m_a1 = 0.0f, m_a2 = 0.0f;
+    float m_z1 = 0.0f, m_z2 = 0.0f;
+};
+
+class DelayProcessor : public ParameterizedProcessor {
+public:
+    static constexpr double kMaxDelaySeconds = 2.0;
+
+    DelayProcessor() : ParameterizedProcessor({{"time", 0.25f}, {"feedback", 0.3f}}) {}
+
+    const std::string& getType() const override { static const std::string type = "delay"; return type; }
+
+    void prepare(double sampleRate) override {
+        m_sampleRate = sampleRate;
+        m_buffer.assign(static_cast<size_t>(sampleRate * kMaxDelaySeconds) + 1, 0.0f);
+        m_writePos = 0;
+    }
+
+    void process(float* buffer, size_t numSamples) override {
+        if (m_buffer.empty()) return;
+        const size_t size = m_buffer.size();
+        const size_t delay = std::clamp<size_t>(static_cast<size_t>(std::max(parameter(0), 0.0f) * m_sampleRate), 1, size - 1);
+        const float feedback = std::clamp(parameter(1), 0.0f, 0.99f);
+
+        size_t readPos = (m_writePos + size - delay) % size;
+        for (size_t i = 0; i < numSamples; ++i) {
+            const float delayed = m_buffer[readPos];
+            m_buffer[m_writePos] = buffer[i] + delayed * feedback;
+            buffer[i] += delayed;
+            if (++readPos == size) readPos = 0;
+            if (++m_writePos == size) m_writePos = 0;
+        }
+    }
+
+    double getTailSeconds() const override {
+        return VRMusicStudio::feedbackTailSeconds(std::max(parameter(0), 0.0f), std::clamp(parameter(1), 0.0f, 0.99f));
+    }
+
+private:
+    double m_sampleRate = 44100.0;
+    std::vector<float> m_buffer;
+    size_t m_writePos = 0;
+};
+
+// Basis für Effekte mit Key-Eingang. Die letzten beiden Parameter sind
+// Hoch- und Tiefpass des Key-Filters. Der Regelkreis läuft mit Kontrollrate:
+// pro kControlBlock Samples Spitzenpegel des gefilterten Keys, Kennlinie und
+// Attack/Release im dB-Bereich; der Aufrufer rampt den Gain im Block linear.
+class KeyedProcessor : public ParameterizedProcessor {
+public:
+    explicit KeyedProcessor(std::vector<std::pair<std::string, float>> defaults)
+        : ParameterizedProcessor(withKeyFilter(std::move(defaults))),
+          m_keyIndex(getParameterDefaults().size() - 2) {}
+
+    bool hasKeyInput() const override { return true; }
+
+    // Der Gain soll vor dem Einschlafen zurückgeregelt haben
+    double getTailSeconds() const override { return std::max(releaseMs(), 0.0f) * 0.001; }
+
+    void prepare(double sampleRate) override {
+        m_sampleRate = sampleRate;
+        m_filter.prepare(sampleRate);
+        m_gainDb = 0.0f;
+        m_gain = 1.0f;
+        m_attackMs = m_releaseMs = -1.0f;
+    }
+
+    void process(float* buffer, size_t numSamples) override {
+        processKeyed(buffer, nullptr, numSamples);
+    }
+
+protected:
+    // Statische Kennlinie in dB (<= 0)
+    virtual float targetGainDb(float levelDb) const = 0;
+    virtual float attackMs() const = 0;
+    virtual float releaseMs() const = 0;
+    virtual float makeupDb() const { return 0.0f; }
+    // Limiter greifen ohne Rampe, damit der Block nicht überschwingt
+    virtual bool instantAttack() const { return false; }
+
+    // Einmal pro Puffer vor detect() aufrufen
+    void updateDetector() {
+        m_filter.setFrequencies(parameter(m_keyIndex), parameter(m_keyIndex + 1));
+        const float attack = attackMs();
+        const float release = releaseMs();
+        if (attack != m_attackMs || release != m_releaseMs) {
+            m_attackMs = attack;
+            m_releaseMs = release;
+            m_attackCoefficient = coefficient(attack);
+            m_releaseCoefficient = coefficient(release);
+        }
+    }
+
+    // Neuer linearer Ziel-Gain für count Key-Samples (count <= kControlBlock);
+    // m_gain ist danach der Startwert der Rampe
+    float detect(const float* key, size_t count) {
+        const float peak = m_filter.processPeak(key, count);
+        const float levelDb = peak > 1.0e-6f ? 20.0f * std::log10(peak) : kMinLevelDb;
+        const float target = targetGainDb(levelDb);
+        const float coefficient = target < m_gainDb ? m_attackCoefficient : m_releaseCoefficient;
+        m_gainDb = target + (m_gainDb - target) * coefficient;
+
+        const float gain = std::pow(10.0f, (m_gainDb + makeupDb()) / 20.0f);
+        if (instantAttack() && gain < m_gain) m_gain = gain;
+        return gain;
+    }
+
+    // Wendet die Rampe m_gain -> target auf count Samples an
+    void applyRamp(float* buffer, size_t count, float target) {
+        const float step = (target - m_gain) / static_cast<float>(count);
+        float gain = m_gain;
+        for (size_t i = 0; i < count; ++i) {
+            gain += step;
+            buffer[i] *= gain;
+        }
+        m_gain = target;
+    }
+
+    double m_sampleRate = 44100.0;
+    float m_gain = 1.0f;
+
+private:
+    static std::vector<std::pair<std::string, float>> withKeyFilter(std::vector<std::pair<std::string, float>> defaults) {
+        defaults.emplace_back("key_hpf", VRMusicStudio::SidechainFilter::kMinHighpass);
+        defaults.emplace_back("key_lpf", VRMusicStudio::SidechainFilter::kMaxLowpass);
+        return defaults;
+    }
+
+    float coefficient(float milliseconds) const {
+        const double blocks = std::max(static_cast<double>(milliseconds), 0.01) * 0.001 * m_sampleRate / kControlBlock;
+        return static_cast<float>(std::exp(-1.0 / blocks));
+    }
+
+    size_t m_keyIndex;
+    VRMusicStudio::SidechainFilter m_filter;
+    float m_gainDb = 0.0f;
+    float m_attackMs = -1.0f, m_releaseMs = -1.0f;
+    float m_attackCoefficient = 0.0f, m_releaseCoefficient = 0.0f;
+};
+
+// Kompressor, Gate und Limiter; ohne Key regelt der eigene Eingang
+class DynamicsProcessor : public KeyedProcessor {
+public:
+    enum class Mode { Compressor, Gate, Limiter };
+
+    explicit DynamicsProcessor(Mode mode) : KeyedProcessor(defaultsFor(mode)), m_mode(mode) {}
+
+    const std::string& getType() const override {
+        static const std::string compressor = "compressor";
+        static const std::string gate = "gate";
+        static const std::string limiter = "limiter";
+        return m_mode == Mode::Compressor ? compressor : m_mode == Mode::Gate ? gate : limiter;
+    }
+
+    void processKeyed(float* buffer, const float* key, size_t numSamples) override {
+        updateDetector();
+        // Ohne Key liest der Detektor den noch unveränderten Block selbst
+        const float* detector = key ? key : buffer;
+        for (size_t offset = 0; offset < numSamples; offset += kControlBlock) {
+            const size_t count = std::min(kControlBlock, numSamples - offset);
+            const float target = detect(detector + offset, count);
+            applyRamp(buffer + offset, count, target);
+        }
+    }
+
+protected:
+    float targetGainDb(float levelDb) const override {
+        const float threshold = parameter(0);
+        switch (m_mode) {
+        case Mode::Compressor: {
+            const float ratio = std::max(parameter(1), 1.0f);
+            return levelDb > threshold ? (levelDb - threshold) * (1.0f / ratio - 1.0f) : 0.0f;
+        }
+        case Mode::Gate:
+            return levelDb < threshold ? -std::max(parameter(1), 0.0f) : 0.0f;
+        case Mode::Limiter:
+            return std::min(threshold - levelDb, 0.0f);
+        }
+        return 0.0f;
+    }
+
+    float attackMs() const override { return m_mode == Mode::Limiter ? 0.0f : parameter(2); }
+    float releaseMs() const override { return parameter(m_mode == Mode::Limiter ? 1 : 3); }
+    float makeupDb() const override { return m_mode == Mode::Compressor ? parameter(4) : 0.0f; }
+    bool instantAttack() const override { return m_mode == Mode::Limiter; }
+
+private:
+    static std::vector<std::pair<std::string, float>> defaultsFor(Mode mode) {
+        switch (mode) {
+        case Mode::Compressor:
+            return {{"threshold", -20.0f}, {"ratio", 4.0f}, {"attack", 10.0f}, {"release", 100.0f}, {"makeup", 0.0f}};
+        case Mode::Gate:
+            return {{"threshold", -40.0f}, {"range", 60.0f}, {"attack", 1.0f}, {"release", 100.0f}};
+        case Mode::Limiter:
+            return {{"threshold", -1.0f}, {"release", 50.0f}};
+        }
+        return {};
+    }
+
+    Mode m_mode;
+};
+
+// Delay, dessen Echos der Key (Standard: das trockene Signal) wegduckt
+class DuckingDelayProcessor : public KeyedProcessor {
+public:
+    static constexpr double kMaxDelaySeconds = 2.0;
+
+    DuckingDelayProcessor()
+        : KeyedProcessor({{"time", 0.25f}, {"feedback", 0.3f}, {"threshold", -30.0f}, {"ratio", 4.0f},
+                          {"attack", 10.0f}, {"release", 200.0f}}) {}
+
+    const std::string& getType() const override { static const std::string type = "ducking_delay"; return type; }
+
+    void prepare(double sampleRate) override {
+        KeyedProcessor::prepare(sampleRate);
+        m_buffer.assign(static_cast<size_t>(sampleRate * kMaxDelaySeconds) + 1, 0.0f);
+        m_writePos = 0;
+    }
+
+    void processKeyed(float* buffer, const float* key, size_t numSamples) override {
+        if (m_buffer.empty()) return;
+        updateDetector();
+
+        const size_t size = m_buffer.size();
+        const size_t delay = std::clamp<size_t>(static_cast<size_t>(std::max(parameter(0), 0.0f) * m_sampleRate), 1, size - 1);
+        const float feedback = std::clamp(parameter(1), 0.0f, 0.99f);
+        const float* detector = key ? key : buffer;
+
+        size_t readPos = (m_writePos + size - delay) % size;
+        float wet[kControlBlock];
+        for (size_t offset = 0; offset < numSamples; offset += kControlBlock) {
+            const size_t count = std::min(kControlBlock, numSamples - offset);
+            const float target = detect(detector + offset, count);
+
+            float* block = buffer + offset;
+            for (size_t i = 0; i < count; ++i) {
+                wet[i] = m_buffer[readPos];
+                m_buffer[m_writePos] = block[i] + wet[i] * feedback;
+                if (++readPos == size) readPos = 0;
+                if (++m_writePos == size) m_writePos = 0;
+            }
+            applyRamp(wet, count, target);
+            VRMusicStudio::SimdOps::add(block, wet, count);
+        }
+    }
+
+    double getTailSeconds() const override {
+        return VRMusicStudio::feedbackTailSeconds(std::max(parameter(0), 0.0f), std::clamp(parameter(1), 0.0f, 0.99f));
+    }
+
+protected:
+    float targetGainDb(float levelDb) const override {
+        const float threshold = parameter(2);
+        const float ratio = std::max(parameter(3), 1.0f);
+        return levelDb > threshold ? (levelDb - threshold) * (1.0f / ratio - 1.0f) : 0.0f;
+    }
+
+    float attackMs() const override { return parameter(4); }
+    float releaseMs() const override { return parameter(5); }
+
+private:
+    std::vector<float> m_buffer;
+    size_t m_writePos = 0;
+};
+
+} // namespace
+
+std::shared_ptr<EffectProcessor> EffectProcessor::create(const std::string& type) {
+    if (type == "gain") return std::make_shared<GainProcessor>();
+    if (type == "distortion") return std::make_shared<DistortionProcessor>();
+    if (type == "lowpass") return std::make_shared<FilterProcessor>(false);
+    if (type == "highpass") return std::make_shared<FilterProcessor>(true);
+    if (type == "delay") return std::make_shared<DelayProcessor>();
+    if (type == "compressor") return std::make_shared<DynamicsProcessor>(DynamicsProcessor::Mode::Compressor);
+    if (type == "gate") return std::make_shared<DynamicsProcessor>(DynamicsProcessor::Mode::Gate);
+    if (type == "limiter") return std::make_shared<DynamicsProcessor>(DynamicsProcessor::Mode::Limiter);
+    if (type == "ducking_delay") return std::make_shared<DuckingDelayProcessor>();
+    return std::make_shared<PassThroughProcessor>(type);
+}
+
+bool CompiledEffect::process(float* buffer, size_t numSamples, bool inputSilent, bool useKey) const {
+    if (bypass && bypass->value.load(std::memory_order_relaxed) >= 0.5f) return inputSilent;
+
+    // Key als Sicht auf den Quellpuffer; der eigene Puffer zählt als kein Key
+    const float* keyData = nullptr;
+    if (useKey && key && key->size() == numSamples && key->data() != buffer) {
+        keyData = key->data();
+    }
+
+    // Ein aktiver Key weckt den Effekt auch bei stillem Eingang
+    const bool active = !inputSilent || (keyData && !VRMusicStudio::isSilent(keyData, numSamples));
+    const double tail = processor->getTailSeconds();
+    const int64_t tailFrames = tail < 0.0 ? -1 : static_cast<int64_t>(tail * sampleRate);
+    if (!processor->sleep.update(!active, numSamples, tailFrames)) return true;
+
+    const float wet = mix ? std::clamp(mix->value.load(std::memory_order_relaxed), 0.0f, 1.0f) : 1.0f;
+    if (wet >= 1.0f) {
+        processor->processKeyed(buffer, keyData, numSamples);
+        return VRMusicStudio::isSilent(buffer, numSamples);
+    }
+
+    // Dry/Wet in festen Blöcken, der Dry-Puffer liegt auf dem Stack
+    float dry[kMixBlock];
+    for (size_t offset = 0; offset < numSamples; offset += kMixBlock) {
+        const size_t count = std::min(kMixBlock, numSamples - offset);
+        float* block = buffer + offset;
+        std::copy(block, block + count, dry);
+        processor->processKeyed(block, keyData ? keyData + offset : nullptr, count);
+        VRMusicStudio::SimdOps::mix(block, dry, wet, 1.0f - wet, count);
+    }
+    return VRMusicStudio::isSilent(buffer, numSamples);
+}
+
+} // namespace VR_DAW
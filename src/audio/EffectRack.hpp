@@ -0,0 +1,120 @@
+#pragma once
+
+#include "audio/processing/SilenceDetector.hpp"
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace VR_DAW {
+
+// Parameterwert, den der Audio-Thread ohne Lock liest. Die Adresse bleibt
+// über Neuaufbauten hinweg stabil, Parameteränderungen brauchen daher keinen
+// Neuaufbau der Kette.
+struct ParameterSlot {
+    explicit ParameterSlot(float initial = 0.0f) : value(initial) {}
+    std::atomic<float> value;
+};
+
+// Ausgang einer Spur oder eines Busses im Effekt-Graphen. Wie die
+// Parameter-Slots legt die Engine jeden Puffer einmalig an und gibt ihn nicht
+// frei, solange sie lebt; kompilierte Effekte lesen Sidechain-Keys über einen
+// Zeiger darauf und suchen auf dem Audio-Thread keine Namen. Den Inhalt
+// schreibt der Audio-Thread.
+using GraphBuffer = std::vector<float>;
+
+// Typisierter Effekt, verarbeitet ganze Blöcke
+class EffectProcessor {
+public:
+    virtual ~EffectProcessor() = default;
+
+    virtual const std::string& getType() const = 0;
+    virtual void prepare(double sampleRate) = 0;
+    virtual void process(float* buffer, size_t numSamples) = 0;
+
+    // Dynamik-Effekte mit Key-Eingang; key hat numSamples Samples oder ist
+    // nullptr, dann steuert der eigene Eingang
+    virtual bool hasKeyInput() const { return false; }
+    virtual void processKeyed(float* buffer, const float* key, size_t numSamples) {
+        (void)key;
+        process(buffer, numSamples);
+    }
+
+    // Nachklingzeit nach dem letzten nicht stillen Eingang, danach wird der
+    // Effekt bei stillem Eingang übersprungen. Unbekannte Effekte schlafen nie.
+    virtual double getTailSeconds() const { return VRMusicStudio::kInfiniteTail; }
+
+    // Schlafzustand, gehört dem Audio-Thread und überlebt Neuaufbauten
+    VRMusicStudio::TailSleep sleep;
+
+    // Parameter mit Standardwert; Slot i gehört zu Parameter i
+    virtual std::vector<std::pair<std::string, float>> getParameterDefaults() const { return {}; }
+    virtual void bindParameter(size_t index, const ParameterSlot* slot) { (void)index; (void)slot; }
+
+    // Unbekannte Typen liefern einen Durchreicher
+    static std::shared_ptr<EffectProcessor> create(const std::string& type);
+};
+
+struct CompiledEffect {
+    std::shared_ptr<EffectProcessor> processor;
+    const ParameterSlot* bypass = nullptr;
+    const ParameterSlot* mix = nullptr;
+    std::string keySource;              // leer = eigener Eingang; nur für die Planung
+    const GraphBuffer* key = nullptr;   // beim Kompilieren aufgelöste keySource
+    double sampleRate = 44100.0;
+
+    // Ohne useKey oder wenn die Länge des Keys nicht passt, steuert der eigene
+    // Eingang. inputSilent beschreibt buffer, der Rückgabewert den Ausgang;
+    // ausgeklungene Effekte werden übersprungen.
+    bool process(float* buffer, size_t numSamples, bool inputSilent, bool useKey = false) const;
+};
+
+// Fertig gebundene, unveränderliche Effektfolge einer Kette oder eines Racks
+class CompiledRack {
+public:
+    CompiledRack() : m_outputSilent(std::make_shared<std::atomic<bool>>(false)) {}
+    explicit CompiledRack(std::vector<CompiledEffect> effects)
+        : m_effects(std::move(effects)), m_outputSilent(std::make_shared<std::atomic<bool>>(false)) {}
+
+    // Gibt zurück, ob der Ausgang still ist; die Stille-Fahne folgt dem
+    // Puffer von Effekt zu Effekt
+    bool process(float* buffer, size_t numSamples, bool useKeys = false) const {
+        bool silent = VRMusicStudio::isSilent(buffer, numSamples);
+        for (const auto& effect : m_effects) {
+            silent = effect.process(buffer, numSamples, silent, useKeys);
+        }
+        m_outputSilent->store(silent, std::memory_order_relaxed);
+        return silent;
+    }
+
+    // Stand des letzten Puffers; Kopien (Schedule) teilen die Fahne
+    bool isOutputSilent() const { return m_outputSilent->load(std::memory_order_relaxed); }
+
+    size_t size() const { return m_effects.size(); }
+    const std::vector<CompiledEffect>& effects() const { return m_effects; }
+
+private:
+    std::vector<CompiledEffect> m_effects;
+    std::shared_ptr<std::atomic<bool>> m_outputSilent;
+};
+
+// Ketten (Spuren) und Racks (Busse) in Verarbeitungsreihenfolge: jede
+// Sidechain-Quelle läuft vor den Knoten, deren Effekte sie als Key lesen
+struct ScheduledRack {
+    std::string name;
+    CompiledRack rack;
+    GraphBuffer* buffer = nullptr;  // Graph-Puffer des Knotens
+};
+
+// Schnappschuss aller Effekte, Ketten und Racks, den der Audio-Thread liest
+struct CompiledEffectGraph {
+    std::map<std::string, CompiledEffect> effects;
+    std::map<std::string, CompiledRack> chains;
+    std::map<std::string, CompiledRack> racks;
+    std::vector<ScheduledRack> schedule;
+};
+
+} // namespace VR_DAW
@@ -1,5 +1,25 @@
 #include "ProfessionalMixers.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace {
+
+// Ein Mischpult-Modell: frei belegbares Pult plus Stereo-Kanalzug für processXxx(buffer)
+template <const ConsoleDSP::Character& Model>
+struct ConsoleUnit {
+    ConsoleDSP::ConsoleDesk<Model> desk;
+    ConsoleDSP::ConsoleDesk<Model> stereo;
+    std::vector<float> left;
+    std::vector<float> right;
+    std::function<void(const std::vector<float>&)> callback;
+
+    void prepare(double sampleRate) {
+        desk.prepare(sampleRate, desk.getNumChannels());
+        stereo.prepare(sampleRate, 2);
+    }
+};
+
+} // namespace
 
 struct ProfessionalMixers::Impl {
     // SSL Mischpulte
@@ -22,70 +42,106 @@ struct ProfessionalMixers::Impl {
     MidasXL4 midasXL4;
     MidasHeritage midasHeritage;
 
-    // KI-Modelle
-    torch::jit::script::Module ssl4000gModel;
-    torch::jit::script::Module ssl9000jModel;
-    torch::jit::script::Module neve88rsModel;
-    torch::jit::script::Module nevevrModel;
-    torch::jit::script::Module api1608Model;
-    torch::jit::script::Module api2448Model;
-    torch::jit::script::Module studerA800Model;
-    torch::jit::script::Module studerJ37Model;
-    torch::jit::script::Module midasXL4Model;
-    torch::jit::script::Module midasHeritageModel;
-
-    // Audio-Buffer
-    std::vector<float> ssl4000gBuffer;
-    std::vector<float> ssl9000jBuffer;
-    std::vector<float> neve88rsBuffer;
-    std::vector<float> nevevrBuffer;
-    std::vector<float> api1608Buffer;
-    std::vector<float> api2448Buffer;
-    std::vector<float> studerA800Buffer;
-    std::vector<float> studerJ37Buffer;
-    std::vector<float> midasXL4Buffer;
-    std::vector<float> midasHeritageBuffer;
-
-    // Callbacks
-    std::function<void(const std::vector<float>&)> ssl4000gCallback;
-    std::function<void(const std::vector<float>&)> ssl9000jCallback;
-    std::function<void(const std::vector<float>&)> neve88rsCallback;
-    std::function<void(const std::vector<float>&)> nevevrCallback;
-    std::function<void(const std::vector<float>&)> api1608Callback;
-    std::function<void(const std::vector<float>&)> api2448Callback;
-    std::function<void(const std::vector<float>&)> studerA800Callback;
-    std::function<void(const std::vector<float>&)> studerJ37Callback;
-    std::function<void(const std::vector<float>&)> midasXL4Callback;
-    std::function<void(const std::vector<float>&)> midasHeritageCallback;
+    // Kanalzug-Modelle
+    ConsoleUnit<ConsoleDSP::kSSL4000G> ssl4000gUnit;
+    ConsoleUnit<ConsoleDSP::kSSL9000J> ssl9000jUnit;
+    ConsoleUnit<ConsoleDSP::kNeve88RS> neve88rsUnit;
+    ConsoleUnit<ConsoleDSP::kNeveVR> nevevrUnit;
+    ConsoleUnit<ConsoleDSP::kAPI1608> api1608Unit;
+    ConsoleUnit<ConsoleDSP::kAPI2448> api2448Unit;
+    ConsoleUnit<ConsoleDSP::kStuderA800> studerA800Unit;
+    ConsoleUnit<ConsoleDSP::kStuderJ37> studerJ37Unit;
+    ConsoleUnit<ConsoleDSP::kMidasXL4> midasXL4Unit;
+    ConsoleUnit<ConsoleDSP::kMidasHeritage> midasHeritageUnit;
+
+    double sampleRate = 44100.0;
 
     Impl() {
-        try {
-            // Lade KI-Modelle
-            ssl4000gModel = torch::jit::load("models/ssl_4000g.pt");
-            ssl9000jModel = torch::jit::load("models/ssl_9000j.pt");
-            neve88rsModel = torch::jit::load("models/neve_88rs.pt");
-            nevevrModel = torch::jit::load("models/neve_vr.pt");
-            api1608Model = torch::jit::load("models/api_1608.pt");
-            api2448Model = torch::jit::load("models/api_2448.pt");
-            studerA800Model = torch::jit::load("models/studer_a800.pt");
-            studerJ37Model = torch::jit::load("models/studer_j37.pt");
-            midasXL4Model = torch::jit::load("models/midas_xl4.pt");
-            midasHeritageModel = torch::jit::load("models/midas_heritage.pt");
-
-            // Initialisiere Buffer
-            const size_t bufferSize = 1024;
-            ssl4000gBuffer.resize(bufferSize);
-            ssl9000jBuffer.resize(bufferSize);
-            neve88rsBuffer.resize(bufferSize);
-            nevevrBuffer.resize(bufferSize);
-            api1608Buffer.resize(bufferSize);
-            api2448Buffer.resize(bufferSize);
-            studerA800Buffer.resize(bufferSize);
-            studerJ37Buffer.resize(bufferSize);
-            midasXL4Buffer.resize(bufferSize);
-            midasHeritageBuffer.resize(bufferSize);
-        } catch (const c10::Error& e) {
-            spdlog::error("Fehler beim Laden der KI-Modelle: {}", e.what());
+        ssl4000g = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, false};
+        ssl9000j = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, false};
+        neve88rs = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, false};
+        nevevr = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, false};
+        api1608 = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, false};
+        api2448 = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, false};
+        studerA800 = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, false};
+        studerJ37 = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, false};
+        midasXL4 = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, false};
+        midasHeritage = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, false};
+        forEachUnit([this](auto& unit) { unit.prepare(sampleRate); });
+    }
+
+    template <typename Function>
+    void forEachUnit(Function&& function) {
+        function(ssl4000gUnit);
+        function(ssl9000jUnit);
+        function(neve88rsUnit);
+        function(nevevrUnit);
+        function(api1608Unit);
+        function(api2448Unit);
+        function(studerA800Unit);
+        function(studerJ37Unit);
+        function(midasXL4Unit);
+        function(midasHeritageUnit);
+    }
+
+    template <typename Function>
+    void withUnit(Console console, Function&& function) {
+        switch (console) {
+            case Console::SSL4000G: function(ssl4000gUnit); break;
+            case Console::SSL9000J: function(ssl9000jUnit); break;
+            case Console::Neve88RS: function(neve88rsUnit); break;
+            case Console::NeveVR: function(nevevrUnit); break;
+            case Console::API1608: function(api1608Unit); break;
+            case Console::API2448: function(api2448Unit); break;
+            case Console::StuderA800: function(studerA800Unit); break;
+            case Console::StuderJ37: function(studerJ37Unit); break;
+            case Console::MidasXL4: function(midasXL4Unit); break;
+            case Console::MidasHeritage: function(midasHeritageUnit); break;
+        }
+    }
+
+    // Stereo-Buffer durch zwei hart gepannte Kanalzüge; pan wirkt als Balance.
+    // reverb/delay sind Sends und werden hier nicht verarbeitet.
+    template <typename Params, typename Unit>
+    void processStereo(const Params& params, Unit& unit, std::vector<float>& buffer) {
+        if (!params.enabled) return;
+
+        ConsoleDSP::ChannelStrip strip;
+        strip.eqLowDb = params.eqLow;
+        strip.eqLowMidDb = params.eqMid;
+        strip.eqHighMidDb = params.eqMid;
+        strip.eqHighDb = params.eqHigh;
+
+        const float balance = std::clamp(params.pan, -1.0f, 1.0f);
+        strip.pan = -1.0f;
+        strip.volume = params.volume * std::min(1.0f, 1.0f - balance);
+        unit.stereo.setChannel(0, strip);
+        strip.pan = 1.0f;
+        strip.volume = params.volume * std::min(1.0f, 1.0f + balance);
+        unit.stereo.setChannel(1, strip);
+        unit.stereo.setBusCompression(params.compression);
+
+        const size_t frames = buffer.size() / 2;
+        if (unit.left.size() < frames) {
+            unit.left.resize(frames);
+            unit.right.resize(frames);
+        }
+        for (size_t i = 0; i < frames; ++i) {
+            unit.left[i] = buffer[2 * i];
+            unit.right[i] = buffer[2 * i + 1];
+        }
+
+        // In-place: der Bus schreibt erst, nachdem alle Kanäle gelesen wurden
+        const float* inputs[2] = {unit.left.data(), unit.right.data()};
+        unit.stereo.process(inputs, unit.left.data(), unit.right.data(), frames);
+
+        for (size_t i = 0; i < frames; ++i) {
+            buffer[2 * i] = unit.left[i];
+            buffer[2 * i + 1] = unit.right[i];
+        }
+
+        if (unit.callback) {
+            unit.callback(buffer);
         }
     }
 };
@@ -93,6 +149,15 @@ struct ProfessionalMixers::Impl {
 ProfessionalMixers::ProfessionalMixers() : pImpl(std::make_unique<Impl>()) {}
 ProfessionalMixers::~ProfessionalMixers() = default;
 
+void ProfessionalMixers::setSampleRate(double sampleRate) {
+    if (sampleRate <= 0.0) {
+        spdlog::error("Ungültige Samplerate: {}", sampleRate);
+        return;
+    }
+    pImpl->sampleRate = sampleRate;
+    pImpl->forEachUnit([sampleRate](auto& unit) { unit.prepare(sampleRate); });
+}
+
 // Parameter-Setter Implementierungen
 void ProfessionalMixers::setSSL4000GParams(const SSL4000G& params) { pImpl->ssl4000g = params; }
 void ProfessionalMixers::setSSL9000JParams(const SSL9000J& params) { pImpl->ssl9000j = params; }
@@ -106,77 +171,76 @@ void ProfessionalMixers::setMidasXL4Params(const MidasXL4& params) { pImpl->mida
 void ProfessionalMixers::setMidasHeritageParams(const MidasHeritage& params) { pImpl->midasHeritage = params; }
 
 // Audio-Verarbeitung Implementierungen
-void ProfessionalMixers::processSSL4000G(std::vector<float>& buffer) {
-    if (!pImpl->ssl4000g.enabled) return;
-
-    try {
-        std::vector<torch::jit::IValue> inputs;
-        inputs.push_back(torch::tensor({
-            pImpl->ssl4000g.volume,
-            pImpl->ssl4000g.pan,
-            pImpl->ssl4000g.eqLow,
-            pImpl->ssl4000g.eqMid,
-            pImpl->ssl4000g.eqHigh,
-            pImpl->ssl4000g.compression,
-            pImpl->ssl4000g.reverb,
-            pImpl->ssl4000g.delay
-        }));
-
-        auto output = pImpl->ssl4000gModel.forward(inputs).toTensor();
-        auto outputData = output.data_ptr<float>();
-
-        for (size_t i = 0; i < buffer.size(); ++i) {
-            buffer[i] = outputData[i] * pImpl->ssl4000g.volume;
-        }
+void ProfessionalMixers::processSSL4000G(std::vector<float>& buffer) { pImpl->processStereo(pImpl->ssl4000g, pImpl->ssl4000gUnit, buffer); }
+void ProfessionalMixers::processSSL9000J(std::vector<float>& buffer) { pImpl->processStereo(pImpl->ssl9000j, pImpl->ssl9000jUnit, buffer); }
+void ProfessionalMixers::processNeve88RS(std::vector<float>& buffer) { pImpl->processStereo(pImpl->neve88rs, pImpl->neve88rsUnit, buffer); }
+void ProfessionalMixers::processNeveVR(std::vector<float>& buffer) { pImpl->processStereo(pImpl->nevevr, pImpl->nevevrUnit, buffer); }
+void ProfessionalMixers::processAPI1608(std::vector<float>& buffer) { pImpl->processStereo(pImpl->api1608, pImpl->api1608Unit, buffer); }
+void ProfessionalMixers::processAPI2448(std::vector<float>& buffer) { pImpl->processStereo(pImpl->api2448, pImpl->api2448Unit, buffer); }
+void ProfessionalMixers::processStuderA800(std::vector<float>& buffer) { pImpl->processStereo(pImpl->studerA800, pImpl->studerA800Unit, buffer); }
+void ProfessionalMixers::processStuderJ37(std::vector<float>& buffer) { pImpl->processStereo(pImpl->studerJ37, pImpl->studerJ37Unit, buffer); }
+void ProfessionalMixers::processMidasXL4(std::vector<float>& buffer) { pImpl->processStereo(pImpl->midasXL4, pImpl->midasXL4Unit, buffer); }
+void ProfessionalMixers::processMidasHeritage(std::vector<float>& buffer) { pImpl->processStereo(pImpl->midasHeritage, pImpl->midasHeritageUnit, buffer); }
+
+// Pult-Verwaltung
+void ProfessionalMixers::setDeskChannelCount(Console console, int numChannels) {
+    const double sampleRate = pImpl->sampleRate;
+    pImpl->withUnit(console, [&](auto& unit) { unit.desk.prepare(sampleRate, numChannels); });
+}
 
-        if (pImpl->ssl4000gCallback) {
-            pImpl->ssl4000gCallback(buffer);
-        }
-    } catch (const c10::Error& e) {
-        spdlog::error("Fehler bei der SSL4000G-Verarbeitung: {}", e.what());
-    }
+void ProfessionalMixers::setDeskChannel(Console console, int channel, const ConsoleDSP::ChannelStrip& strip) {
+    pImpl->withUnit(console, [&](auto& unit) { unit.desk.setChannel(channel, strip); });
+}
+
+void ProfessionalMixers::setDeskBusCompression(Console console, float amount) {
+    pImpl->withUnit(console, [&](auto& unit) { unit.desk.setBusCompression(amount); });
 }
 
-// Ähnliche Implementierungen für alle anderen Mischpulte...
-// (Der Code ist sehr ähnlich, nur die Mischpult-spezifischen Namen und Parameter ändern sich)
+void ProfessionalMixers::setDeskMasterVolume(Console console, float volume) {
+    pImpl->withUnit(console, [&](auto& unit) { unit.desk.setMasterVolume(volume); });
+}
+
+void ProfessionalMixers::processDesk(Console console, const float* const* inputs, float* left, float* right, size_t numFrames) {
+    pImpl->withUnit(console, [&](auto& unit) { unit.desk.process(inputs, left, right, numFrames); });
+}
 
 // Callback-Setter Implementierungen
 void ProfessionalMixers::setSSL4000GCallback(std::function<void(const std::vector<float>&)> callback) {
-    pImpl->ssl4000gCallback = callback;
+    pImpl->ssl4000gUnit.callback = callback;
 }
 
 void ProfessionalMixers::setSSL900JCallback(std::function<void(const std::vector<float>&)> callback) {
-    pImpl->ssl9000jCallback = callback;
+    pImpl->ssl9000jUnit.callback = callback;
 }
 
 void ProfessionalMixers::setNeve88RSCallback(std::function<void(const std::vector<float>&)> callback) {
-    pImpl->neve88rsCallback = callback;
+    pImpl->neve88rsUnit.callback = callback;
 }
 
 void ProfessionalMixers::setNeveVRCallback(std::function<void(const std::vector<float>&)> callback) {
-    pImpl->nevevrCallback = callback;
+    pImpl->nevevrUnit.callback = callback;
 }
 
 void ProfessionalMixers::setAPI1608Callback(std::function<void(const std::vector<float>&)> callback) {
-    pImpl->api1608Callback = callback;
+    pImpl->api1608Unit.callback = callback;
 }
 
 void ProfessionalMixers::setAPI2448Callback(std::function<void(const std::vector<float>&)> callback) {
-    pImpl->api2448Callback = callback;
+    pImpl->api2448Unit.callback = callback;
 }
 
 void ProfessionalMixers::setStuderA800Callback(std::function<void(const std::vector<float>&)> callback) {
-    pImpl->studerA800Callback = callback;
+    pImpl->studerA800Unit.callback = callback;
 }
 
 void ProfessionalMixers::setStuderJ37Callback(std::function<void(const std::vector<float>&)> callback) {
-    pImpl->studerJ37Callback = callback;
+    pImpl->studerJ37Unit.callback = callback;
 }
 
 void ProfessionalMixers::setMidasXL4Callback(std::function<void(const std::vector<float>&)> callback) {
-    pImpl->midasXL4Callback = callback;
+    pImpl->midasXL4Unit.callback = callback;
 }
 
 void ProfessionalMixers::setMidasHeritageCallback(std::function<void(const std::vector<float>&)> callback) {
-    pImpl->midasHeritageCallback = callback;
+    pImpl->midasHeritageUnit.callback = callback;
 } 
\ No newline at end of file
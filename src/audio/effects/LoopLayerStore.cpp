@@ -0,0 +1,784 @@
+#include "LoopLayerStore.hpp"
+#include "audio/processing/SimdOps.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+    #include <cstdlib>
+#endif
+
+namespace VRMusicStudio {
+
+// Memory-mapped Spill-Datei fester Größe. Die Datei wird beim Öffnen bereits
+// gelöscht bzw. mit DELETE_ON_CLOSE angelegt, damit nach einem Absturz keine
+// Reste im Temp-Verzeichnis liegen bleiben.
+struct LoopLayerStore::SpillFile {
+    float* data = nullptr;
+    size_t bytes = 0;
+    std::vector<float> memory;      // Ersatz im RAM, wenn keine Datei angelegt werden kann
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+
+    bool open(const std::string& path, size_t size) {
+        bytes = size;
+#ifdef _WIN32
+        std::string filePath = path;
+        if (filePath.empty()) {
+            char dir[MAX_PATH];
+            char name[MAX_PATH];
+            if (!GetTempPathA(MAX_PATH, dir) || !GetTempFileNameA(dir, "vrl", 0, name)) {
+                return false;
+            }
+            filePath = name;
+        }
+        file = CreateFileA(filePath.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                           FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        const unsigned long long total = size;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+                                     static_cast<DWORD>(total >> 32), static_cast<DWORD>(total & 0xffffffffu), nullptr);
+        if (!mapping) {
+            close();
+            return false;
+        }
+        data = static_cast<float*>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size));
+        if (!data) {
+            close();
+            return false;
+        }
+#else
+        if (path.empty()) {
+            char name[] = "/tmp/vrms-looper-XXXXXX";
+            fd = mkstemp(name);
+            if (fd >= 0) {
+                unlink(name);
+            }
+        } else {
+            fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+            if (fd >= 0) {
+                unlink(path.c_str());
+            }
+        }
+        if (fd < 0 || ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            close();
+            return false;
+        }
+        void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            close();
+            return false;
+        }
+        data = static_cast<float*>(mapped);
+#endif
+        return true;
+    }
+
+    void allocate(size_t size) {
+        memory.assign(size / sizeof(float), 0.0f);
+        data = memory.data();
+        bytes = size;
+    }
+
+    bool isFile() const { return memory.empty(); }
+
+    void close() {
+        if (!isFile()) {
+            memory.clear();
+            memory.shrink_to_fit();
+            data = nullptr;
+            bytes = 0;
+            return;
+        }
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (data) munmap(data, bytes);
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+#endif
+        data = nullptr;
+        bytes = 0;
+    }
+
+    // Seiten vor dem Zugriff durch den Audio-Thread einlesen lassen
+    void prefetch(const float* ptr, size_t size) {
+#ifdef _WIN32
+        WIN32_MEMORY_RANGE_ENTRY range{const_cast<float*>(ptr), size};
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+        const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(ptr) & ~(page - 1);
+        madvise(reinterpret_cast<void*>(begin), size + (reinterpret_cast<uintptr_t>(ptr) - begin), MADV_WILLNEED);
+#endif
+    }
+};
+
+LoopLayerStore::LoopLayerStore() :
+    m_maxLoopChunks(0),
+    m_residentChunks(0),
+    m_spillChunks(0),
+    m_order{},
+    m_totalLayers(0),
+    m_visibleLayers(0),
+    m_recordingLayer(-1),
+    m_loopLength(0),
+    m_recordedFrames(0),
+    m_droppedFrames(0),
+    m_residentInUse(0),
+    m_playPosition(0),
+    m_publishedVisible(0),
+    m_publishedLoopLength(0),
+    m_spillInUse(0),
+    m_collapseLayers{0, 0},
+    m_collapseGenerations{0, 0},
+    m_collapseGains{1.0f, 1.0f},
+    m_collapseChunkCount(0),
+    m_collapseReady(false),
+    m_shouldStop(false)
+{
+    for (auto& entry : m_publishedOrder) {
+        entry.store(0, std::memory_order_relaxed);
+    }
+}
+
+LoopLayerStore::~LoopLayerStore() {
+    release();
+}
+
+bool LoopLayerStore::prepare(const Config& config) {
+    release();
+
+    m_config = config;
+    m_config.maxUndoLayers = std::clamp<size_t>(config.maxUndoLayers, 1, kMaxLayers - 2);
+
+    const double maxFrames = std::max(1.0, static_cast<double>(config.maxLoopSeconds) * config.sampleRate);
+    m_maxLoopChunks = static_cast<size_t>(std::ceil(maxFrames / kChunkFrames));
+
+    // Ein voller Basis-Layer plus ein Overdub muss immer in den RAM-Pool passen
+    m_residentChunks = std::max(config.residentChunks, m_maxLoopChunks * 2);
+    m_spillChunks = std::max(config.spillChunks, m_maxLoopChunks * (m_config.maxUndoLayers + 2));
+
+    m_residentPool.assign(m_residentChunks * kChunkFrames, 0.0f);
+    m_freeResident.clear();
+    m_freeResident.reserve(m_residentChunks);
+    for (size_t i = m_residentChunks; i > 0; --i) {
+        m_freeResident.push_back(static_cast<uint32_t>(i - 1));
+    }
+    m_residentInUse.store(0, std::memory_order_relaxed);
+
+    m_layers.reset(new Layer[kMaxLayers]);
+    for (size_t i = 0; i < kMaxLayers; ++i) {
+        m_layers[i].chunks.reset(new std::atomic<uint32_t>[m_maxLoopChunks]);
+        for (size_t c = 0; c < m_maxLoopChunks; ++c) {
+            m_layers[i].chunks[c].store(kNoChunk, std::memory_order_relaxed);
+        }
+    }
+
+    m_spill = std::make_unique<SpillFile>();
+    if (!m_spill->open(config.spillPath, m_spillChunks * kChunkFrames * sizeof(float))) {
+        // Ohne Spill-Datei bleiben alle Layer im RAM-Pool; zwei Looplängen RAM
+        // dienen als Ziel für das Zusammenführen (altes und neues Ergebnis)
+        m_spill->close();
+        m_spillChunks = m_maxLoopChunks * 2;
+        m_spill->allocate(m_spillChunks * kChunkFrames * sizeof(float));
+    }
+    m_freeSpill.clear();
+    m_freeSpill.reserve(m_spillChunks);
+    for (size_t i = m_spillChunks; i > 0; --i) {
+        m_freeSpill.push_back(static_cast<uint32_t>(i - 1));
+    }
+    m_spillInUse.store(0, std::memory_order_relaxed);
+    m_remaps.reset(std::max<size_t>(m_spillChunks, 1));
+    m_spillReleases.reset(std::max<size_t>(m_spillChunks, 1));
+
+    m_collapseChunks.reset(new uint32_t[m_maxLoopChunks]);
+    m_collapseReady.store(false, std::memory_order_relaxed);
+
+    m_totalLayers = 0;
+    m_visibleLayers = 0;
+    m_recordingLayer = -1;
+    m_loopLength = 0;
+    m_recordedFrames = 0;
+    m_droppedFrames.store(0, std::memory_order_relaxed);
+    m_publishedVisible.store(0, std::memory_order_relaxed);
+    m_publishedLoopLength.store(0, std::memory_order_relaxed);
+    return true;
+}
+
+void LoopLayerStore::release() {
+    stopService();
+    if (m_spill) {
+        m_spill->close();
+        m_spill.reset();
+    }
+    m_layers.reset();
+    m_collapseChunks.reset();
+    m_residentPool.clear();
+    m_residentPool.shrink_to_fit();
+    m_freeResident.clear();
+    m_freeSpill.clear();
+    m_totalLayers = 0;
+    m_visibleLayers = 0;
+    m_recordingLayer = -1;
+    m_loopLength = 0;
+    m_publishedVisible.store(0, std::memory_order_release);
+    m_publishedLoopLength.store(0, std::memory_order_release);
+}
+
+void LoopLayerStore::startService() {
+    if (m_serviceThread.joinable() || !m_layers) {
+        return;
+    }
+    m_shouldStop.store(false);
+    m_serviceThread = std::thread([this]() {
+        while (!m_shouldStop.load()) {
+            service();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    });
+}
+
+void LoopLayerStore::stopService() {
+    m_shouldStop.store(true);
+    if (m_serviceThread.joinable()) {
+        m_serviceThread.join();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Audio-Thread
+// ---------------------------------------------------------------------------
+
+void LoopLayerStore::beginBlock() {
+    if (!m_layers) return;
+    applyRemaps();
+    applyCollapse();
+}
+
+bool LoopLayerStore::beginLayer(float decayOfExistingLayers) {
+    if (!m_layers || m_recordingLayer >= 0) {
+        return false;
+    }
+
+    // Ein neuer Overdub verwirft die Redo-Historie
+    for (size_t i = m_visibleLayers; i < m_totalLayers; ++i) {
+        releaseLayer(m_order[i]);
+    }
+    m_totalLayers = m_visibleLayers;
+
+    const int slot = allocateLayerSlot();
+    if (slot < 0) {
+        return false;
+    }
+
+    // Der Decay gehört zum neuen Layer und wirkt beim Mischen auf alle darunter;
+    // Undo blendet ihn mit dem Layer wieder aus
+    Layer& layer = m_layers[slot];
+    layer.gain.store(1.0f, std::memory_order_relaxed);
+    layer.decay.store(decayOfExistingLayers, std::memory_order_relaxed);
+    layer.state.store(static_cast<uint32_t>(LayerState::Recording), std::memory_order_release);
+
+    if (m_visibleLayers == 0) {
+        m_loopLength = 0;
+        m_recordedFrames = 0;
+        m_publishedLoopLength.store(0, std::memory_order_release);
+    }
+    m_order[m_totalLayers++] = slot;
+    m_visibleLayers = m_totalLayers;
+    m_recordingLayer = slot;
+
+    for (size_t i = 0; i < m_totalLayers; ++i) {
+        m_publishedOrder[i].store(static_cast<uint32_t>(m_order[i]), std::memory_order_relaxed);
+    }
+    m_publishedVisible.store(m_visibleLayers, std::memory_order_release);
+    return true;
+}
+
+void LoopLayerStore::write(const float* input, size_t loopPosition, size_t numFrames) {
+    if (m_recordingLayer < 0) return;
+
+    Layer& layer = m_layers[m_recordingLayer];
+    const size_t maxFrames = getMaxLoopFrames();
+    size_t position = loopPosition;
+    size_t done = 0;
+
+    while (done < numFrames) {
+        if (m_loopLength > 0 && position >= m_loopLength) {
+            position %= m_loopLength;
+        }
+        if (position >= maxFrames) {
+            m_droppedFrames.fetch_add(numFrames - done, std::memory_order_relaxed);
+            return;
+        }
+
+        const size_t chunkIndex = position / kChunkFrames;
+        const size_t offset = position % kChunkFrames;
+        size_t count = std::min(numFrames - done, kChunkFrames - offset);
+        if (m_loopLength > 0) {
+            count = std::min(count, m_loopLength - position);
+        }
+
+        uint32_t chunk = layer.chunks[chunkIndex].load(std::memory_order_relaxed);
+        if (chunk == kNoChunk) {
+            chunk = acquireResidentChunk();
+            if (chunk != kNoChunk) {
+                std::memset(chunkData(chunk), 0, kChunkFrames * sizeof(float));
+                layer.chunks[chunkIndex].store(chunk, std::memory_order_release);
+            }
+        }
+
+        if (chunk != kNoChunk) {
+            std::memcpy(chunkData(chunk) + offset, input + done, count * sizeof(float));
+        } else {
+            m_droppedFrames.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        if (m_loopLength == 0) {
+            m_recordedFrames = std::max(m_recordedFrames, position + count);
+        }
+        position += count;
+        done += count;
+    }
+}
+
+void LoopLayerStore::finishLayer() {
+    if (m_recordingLayer < 0) return;
+
+    const bool isBase = (m_visibleLayers == 1 && m_loopLength == 0);
+    if (isBase) {
+        m_loopLength = std::min(m_recordedFrames, getMaxLoopFrames());
+    }
+
+    Layer& layer = m_layers[m_recordingLayer];
+    m_recordingLayer = -1;
+
+    if (isBase && m_loopLength == 0) {
+        // Nichts aufgenommen
+        clear();
+        return;
+    }
+
+    layer.state.store(static_cast<uint32_t>(LayerState::Finished), std::memory_order_release);
+    m_publishedLoopLength.store(m_loopLength, std::memory_order_release);
+}
+
+void LoopLayerStore::setLoopLength(size_t frames) {
+    if (m_recordingLayer >= 0 && m_visibleLayers == 1) {
+        // Basis-Layer noch offen: Länge wird beim Abschließen übernommen
+        m_recordedFrames = frames;
+        return;
+    }
+    m_loopLength = std::min(frames, getMaxLoopFrames());
+    m_publishedLoopLength.store(m_loopLength, std::memory_order_release);
+}
+
+bool LoopLayerStore::undo() {
+    if (m_recordingLayer >= 0) {
+        // Laufenden Overdub verwerfen statt abschließen
+        const int slot = m_recordingLayer;
+        finishLayer();
+        if (m_visibleLayers > 0 && m_order[m_visibleLayers - 1] == slot) {
+            releaseLayer(slot);
+            --m_visibleLayers;
+            m_totalLayers = m_visibleLayers;
+            m_publishedVisible.store(m_visibleLayers, std::memory_order_release);
+        }
+        return true;
+    }
+    if (m_visibleLayers == 0) {
+        return false;
+    }
+    --m_visibleLayers;
+    m_publishedVisible.store(m_visibleLayers, std::memory_order_release);
+    return true;
+}
+
+bool LoopLayerStore::redo() {
+    if (m_recordingLayer >= 0 || m_visibleLayers >= m_totalLayers) {
+        return false;
+    }
+    ++m_visibleLayers;
+    m_publishedVisible.store(m_visibleLayers, std::memory_order_release);
+    return true;
+}
+
+void LoopLayerStore::clear() {
+    if (!m_layers) return;
+    for (size_t i = 0; i < m_totalLayers; ++i) {
+        releaseLayer(m_order[i]);
+    }
+    m_totalLayers = 0;
+    m_visibleLayers = 0;
+    m_recordingLayer = -1;
+    m_loopLength = 0;
+    m_recordedFrames = 0;
+    m_publishedVisible.store(0, std::memory_order_release);
+    m_publishedLoopLength.store(0, std::memory_order_release);
+}
+
+void LoopLayerStore::layerGains(float* gains) const {
+    float decay = 1.0f;
+    for (size_t l = m_visibleLayers; l > 0; --l) {
+        const Layer& layer = m_layers[m_order[l - 1]];
+        gains[l - 1] = layer.gain.load(std::memory_order_relaxed) * decay;
+        decay *= layer.decay.load(std::memory_order_relaxed);
+    }
+}
+
+void LoopLayerStore::mixInto(float* output, size_t loopPosition, size_t numFrames, float gain) const {
+    if (!m_layers || m_loopLength == 0) return;
+
+    float gains[kMaxLayers];
+    layerGains(gains);
+    for (size_t l = 0; l < m_visibleLayers; ++l) {
+        const Layer& layer = m_layers[m_order[l]];
+        const float layerGain = gains[l] * gain;
+        size_t position = loopPosition % m_loopLength;
+        size_t done = 0;
+
+        while (done < numFrames) {
+            const size_t chunkIndex = position / kChunkFrames;
+            const size_t offset = position % kChunkFrames;
+            const size_t count = std::min({numFrames - done, kChunkFrames - offset, m_loopLength - position});
+
+            const uint32_t chunk = layer.chunks[chunkIndex].load(std::memory_order_relaxed);
+            if (chunk != kNoChunk) {
+                SimdOps::addScaled(output + done, chunkData(chunk) + offset, layerGain, count);
+            }
+
+            position += count;
+            if (position >= m_loopLength) position = 0;
+            done += count;
+        }
+    }
+}
+
+float LoopLayerStore::readInterpolated(double loopPosition) const {
+    if (!m_layers || m_loopLength == 0) return 0.0f;
+
+    double wrapped = std::fmod(loopPosition, static_cast<double>(m_loopLength));
+    if (wrapped < 0.0) wrapped += static_cast<double>(m_loopLength);
+    const size_t index0 = static_cast<size_t>(wrapped) % m_loopLength;
+    const size_t index1 = (index0 + 1) % m_loopLength;
+    const float fraction = static_cast<float>(wrapped - std::floor(wrapped));
+
+    float gains[kMaxLayers];
+    layerGains(gains);
+    float sum = 0.0f;
+    for (size_t l = 0; l < m_visibleLayers; ++l) {
+        const Layer& layer = m_layers[m_order[l]];
+        const uint32_t chunk0 = layer.chunks[index0 / kChunkFrames].load(std::memory_order_relaxed);
+        const uint32_t chunk1 = layer.chunks[index1 / kChunkFrames].load(std::memory_order_relaxed);
+        const float s0 = chunk0 != kNoChunk ? chunkData(chunk0)[index0 % kChunkFrames] : 0.0f;
+        const float s1 = chunk1 != kNoChunk ? chunkData(chunk1)[index1 % kChunkFrames] : 0.0f;
+        sum += (s0 + fraction * (s1 - s0)) * gains[l];
+    }
+    return sum;
+}
+
+LoopLayerStore::Stats LoopLayerStore::getStats() const {
+    Stats stats;
+    stats.residentChunksInUse = m_residentInUse.load(std::memory_order_relaxed);
+    stats.spilledChunksInUse = m_spillInUse.load(std::memory_order_relaxed);
+    stats.layers = m_publishedVisible.load(std::memory_order_relaxed);
+    stats.loopFrames = m_publishedLoopLength.load(std::memory_order_relaxed);
+    stats.droppedFrames = m_droppedFrames.load(std::memory_order_relaxed);
+    return stats;
+}
+
+float* LoopLayerStore::chunkData(uint32_t chunk) const {
+    if (isResident(chunk)) {
+        return const_cast<float*>(m_residentPool.data()) + static_cast<size_t>(chunk) * kChunkFrames;
+    }
+    return m_spill->data + static_cast<size_t>(chunk - m_residentChunks) * kChunkFrames;
+}
+
+uint32_t LoopLayerStore::acquireResidentChunk() {
+    if (m_freeResident.empty()) {
+        return kNoChunk;
+    }
+    const uint32_t chunk = m_freeResident.back();
+    m_freeResident.pop_back();
+    m_residentInUse.fetch_add(1, std::memory_order_relaxed);
+    return chunk;
+}
+
+void LoopLayerStore::releaseChunk(uint32_t chunk) {
+    if (chunk == kNoChunk) return;
+    if (isResident(chunk)) {
+        m_freeResident.push_back(chunk);
+        m_residentInUse.fetch_sub(1, std::memory_order_relaxed);
+    } else {
+        m_spillReleases.push(chunk - static_cast<uint32_t>(m_residentChunks));
+    }
+}
+
+void LoopLayerStore::releaseLayer(int slot) {
+    Layer& layer = m_layers[slot];
+    layer.generation.fetch_add(1, std::memory_order_acq_rel);
+    layer.state.store(static_cast<uint32_t>(LayerState::Free), std::memory_order_release);
+    for (size_t c = 0; c < m_maxLoopChunks; ++c) {
+        releaseChunk(layer.chunks[c].exchange(kNoChunk, std::memory_order_acq_rel));
+    }
+    layer.gain.store(1.0f, std::memory_order_relaxed);
+    layer.decay.store(1.0f, std::memory_order_relaxed);
+}
+
+int LoopLayerStore::allocateLayerSlot() {
+    if (m_totalLayers >= kMaxLayers) {
+        return -1;
+    }
+    for (size_t i = 0; i < kMaxLayers; ++i) {
+        if (m_layers[i].state.load(std::memory_order_relaxed) != static_cast<uint32_t>(LayerState::Free)) {
+            continue;
+        }
+        bool inUse = false;
+        for (size_t j = 0; j < m_totalLayers; ++j) {
+            inUse = inUse || m_order[j] == static_cast<int>(i);
+        }
+        if (!inUse) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void LoopLayerStore::applyRemaps() {
+    Remap remap;
+    while (m_remaps.pop(remap)) {
+        Layer& layer = m_layers[remap.layer];
+        const uint32_t current = layer.chunks[remap.chunkIndex].load(std::memory_order_relaxed);
+        const bool valid = layer.generation.load(std::memory_order_relaxed) == remap.generation
+                        && layer.state.load(std::memory_order_relaxed) == static_cast<uint32_t>(LayerState::Finished)
+                        && current != kNoChunk && isResident(current);
+        if (valid) {
+            layer.chunks[remap.chunkIndex].store(remap.spillChunk, std::memory_order_release);
+            releaseChunk(current);
+        } else {
+            releaseChunk(remap.spillChunk);
+        }
+    }
+}
+
+void LoopLayerStore::applyCollapse() {
+    if (!m_collapseReady.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    const size_t chunkCount = m_collapseChunkCount;
+    const int a = static_cast<int>(m_collapseLayers[0]);
+    const int b = static_cast<int>(m_collapseLayers[1]);
+    const bool valid = m_visibleLayers >= 2 && m_order[0] == a && m_order[1] == b && m_recordingLayer != b
+                    && m_layers[a].generation.load(std::memory_order_relaxed) == m_collapseGenerations[0]
+                    && m_layers[b].generation.load(std::memory_order_relaxed) == m_collapseGenerations[1]
+                    && m_layers[a].gain.load(std::memory_order_relaxed) * m_layers[b].decay.load(std::memory_order_relaxed) == m_collapseGains[0]
+                    && m_layers[b].gain.load(std::memory_order_relaxed) == m_collapseGains[1]
+                    && m_publishedLoopLength.load(std::memory_order_relaxed) == m_loopLength;
+
+    if (valid) {
+        Layer& base = m_layers[a];
+        for (size_t c = 0; c < chunkCount; ++c) {
+            releaseChunk(base.chunks[c].exchange(m_collapseChunks[c], std::memory_order_acq_rel));
+        }
+        // Das Ergebnis steht an Position 0, ein Decay darunter gibt es nicht mehr
+        base.gain.store(1.0f, std::memory_order_relaxed);
+        base.decay.store(1.0f, std::memory_order_relaxed);
+        releaseLayer(b);
+
+        for (size_t i = 1; i + 1 < m_totalLayers; ++i) {
+            m_order[i] = m_order[i + 1];
+        }
+        --m_totalLayers;
+        --m_visibleLayers;
+        for (size_t i = 0; i < m_totalLayers; ++i) {
+            m_publishedOrder[i].store(static_cast<uint32_t>(m_order[i]), std::memory_order_relaxed);
+        }
+        m_publishedVisible.store(m_visibleLayers, std::memory_order_release);
+    } else {
+        for (size_t c = 0; c < chunkCount; ++c) {
+            releaseChunk(m_collapseChunks[c]);
+        }
+    }
+    m_collapseReady.store(false, std::memory_order_release);
+}
+
+// ---------------------------------------------------------------------------
+// Hintergrund-Thread
+// ---------------------------------------------------------------------------
+
+void LoopLayerStore::service() {
+    if (!m_layers || !m_spill) return;
+    reclaimSpillChunks();
+    collapseOldestLayers();
+    // Der RAM-Ersatz nimmt nur zusammengeführte Layer auf
+    if (m_spill->isFile()) {
+        spillFinishedLayers();
+        prefetchAroundPlayhead();
+    }
+}
+
+void LoopLayerStore::reclaimSpillChunks() {
+    uint32_t chunk;
+    while (m_spillReleases.pop(chunk)) {
+        m_freeSpill.push_back(chunk);
+        m_spillInUse.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+uint32_t LoopLayerStore::acquireSpillChunk() {
+    if (m_freeSpill.empty()) {
+        return kNoChunk;
+    }
+    const uint32_t chunk = m_freeSpill.back();
+    m_freeSpill.pop_back();
+    m_spillInUse.fetch_add(1, std::memory_order_relaxed);
+    return chunk;
+}
+
+void LoopLayerStore::spillFinishedLayers() {
+    const size_t visible = m_publishedVisible.load(std::memory_order_acquire);
+    const bool underPressure = m_residentInUse.load(std::memory_order_relaxed) * 4 > m_residentChunks * 3;
+    bool pushed = false;
+
+    for (size_t i = 0; i < visible; ++i) {
+        // Die beiden obersten Layer bleiben für schnelles Undo/Redo im RAM
+        if (i + 2 >= visible && !underPressure) {
+            continue;
+        }
+        const uint32_t slot = m_publishedOrder[i].load(std::memory_order_relaxed);
+        Layer& layer = m_layers[slot];
+        const uint32_t generation = layer.generation.load(std::memory_order_acquire);
+        if (layer.state.load(std::memory_order_acquire) != static_cast<uint32_t>(LayerState::Finished)) {
+            continue;
+        }
+
+        for (size_t c = 0; c < m_maxLoopChunks; ++c) {
+            const uint32_t current = layer.chunks[c].load(std::memory_order_acquire);
+            if (current == kNoChunk || !isResident(current)) {
+                continue;
+            }
+            const uint32_t target = acquireSpillChunk();
+            if (target == kNoChunk) {
+                return;
+            }
+            const uint32_t global = target + static_cast<uint32_t>(m_residentChunks);
+            std::memcpy(chunkData(global), chunkData(current), kChunkFrames * sizeof(float));
+            if (!m_remaps.push({slot, generation, static_cast<uint32_t>(c), global})) {
+                m_freeSpill.push_back(target);
+                m_spillInUse.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+            pushed = true;
+        }
+    }
+
+    // Warten, bis der Audio-Thread die Umzüge übernommen hat, bevor derselbe
+    // Chunk ein zweites Mal kopiert wird
+    while (pushed && !m_remaps.empty() && !m_shouldStop.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void LoopLayerStore::collapseOldestLayers() {
+    if (m_collapseReady.load(std::memory_order_acquire)) {
+        return;
+    }
+    const size_t visible = m_publishedVisible.load(std::memory_order_acquire);
+    if (visible <= m_config.maxUndoLayers) {
+        return;
+    }
+
+    const uint32_t a = m_publishedOrder[0].load(std::memory_order_relaxed);
+    const uint32_t b = m_publishedOrder[1].load(std::memory_order_relaxed);
+    Layer& layerA = m_layers[a];
+    Layer& layerB = m_layers[b];
+    const uint32_t finished = static_cast<uint32_t>(LayerState::Finished);
+    if (layerA.state.load(std::memory_order_acquire) != finished
+        || layerB.state.load(std::memory_order_acquire) != finished) {
+        return;
+    }
+
+    m_collapseLayers[0] = a;
+    m_collapseLayers[1] = b;
+    m_collapseGenerations[0] = layerA.generation.load(std::memory_order_acquire);
+    m_collapseGenerations[1] = layerB.generation.load(std::memory_order_acquire);
+    // A liegt unter B und bekommt dessen Decay; was darüber liegt, wirkt auf beide gleich
+    m_collapseGains[0] = layerA.gain.load(std::memory_order_relaxed) * layerB.decay.load(std::memory_order_relaxed);
+    m_collapseGains[1] = layerB.gain.load(std::memory_order_relaxed);
+
+    const size_t loopLength = m_publishedLoopLength.load(std::memory_order_acquire);
+    const size_t chunkCount = (loopLength + kChunkFrames - 1) / kChunkFrames;
+
+    for (size_t c = 0; c < chunkCount; ++c) {
+        const uint32_t chunkA = layerA.chunks[c].load(std::memory_order_acquire);
+        const uint32_t chunkB = layerB.chunks[c].load(std::memory_order_acquire);
+        if (chunkA == kNoChunk && chunkB == kNoChunk) {
+            m_collapseChunks[c] = kNoChunk;
+            continue;
+        }
+
+        const uint32_t target = acquireSpillChunk();
+        if (target == kNoChunk) {
+            // Kein Platz: bereits belegte Ziel-Chunks zurückgeben und später erneut versuchen
+            for (size_t k = 0; k < c; ++k) {
+                if (m_collapseChunks[k] != kNoChunk) {
+                    m_freeSpill.push_back(m_collapseChunks[k] - static_cast<uint32_t>(m_residentChunks));
+                    m_spillInUse.fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+            return;
+        }
+
+        const uint32_t global = target + static_cast<uint32_t>(m_residentChunks);
+        float* out = chunkData(global);
+        std::memset(out, 0, kChunkFrames * sizeof(float));
+        if (chunkA != kNoChunk) SimdOps::addScaled(out, chunkData(chunkA), m_collapseGains[0], kChunkFrames);
+        if (chunkB != kNoChunk) SimdOps::addScaled(out, chunkData(chunkB), m_collapseGains[1], kChunkFrames);
+        m_collapseChunks[c] = global;
+    }
+
+    m_collapseChunkCount = chunkCount;
+    m_collapseReady.store(true, std::memory_order_release);
+}
+
+void LoopLayerStore::prefetchAroundPlayhead() {
+    const size_t loopLength = m_publishedLoopLength.load(std::memory_order_acquire);
+    if (loopLength == 0) return;
+
+    const size_t visible = m_publishedVisible.load(std::memory_order_acquire);
+    const size_t position = m_playPosition.load(std::memory_order_relaxed) % loopLength;
+    const size_t chunkCount = (loopLength + kChunkFrames - 1) / kChunkFrames;
+    const size_t current = position / kChunkFrames;
+
+    for (size_t i = 0; i < visible; ++i) {
+        const Layer& layer = m_layers[m_publishedOrder[i].load(std::memory_order_relaxed)];
+        for (size_t ahead = 0; ahead < 2; ++ahead) {
+            const uint32_t chunk = layer.chunks[(current + ahead) % chunkCount].load(std::memory_order_acquire);
+            if (chunk != kNoChunk && !isResident(chunk)) {
+                m_spill->prefetch(chunkData(chunk), kChunkFrames * sizeof(float));
+            }
+        }
+    }
+}
+
+} // namespace VRMusicStudio
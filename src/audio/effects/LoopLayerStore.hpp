@@ -0,0 +1,171 @@
+#pragma once
+
+#include "audio/processing/SpscQueue.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace VRMusicStudio {
+
+// Chunked storage for looper layers.
+//
+// Audio is recorded into fixed-size chunks taken from a preallocated RAM pool.
+// Finished layers are copied by a background thread into a memory-mapped spill
+// file and their RAM chunks are handed back to the audio thread, so resident
+// memory is bounded by the pool size regardless of how long a set runs.
+// Every overdub is its own layer; the newest layers form an undo/redo stack and
+// the oldest layers are collapsed into one once the undo depth is exceeded.
+// The decay an overdub applies to the layers below it is stored with the
+// overdub and applied while mixing, so undo/redo also restore the levels.
+// Without a spill file a small RAM region of two loop lengths takes its place
+// as the collapse target, so the layer count stays bounded either way.
+//
+// Threading: prepare()/release() on the message thread while the store is not
+// in use by the audio thread (to reconfigure a running looper, prepare a new
+// store and hand it over), everything marked "audio thread" from the audio
+// callback only, service() from the background thread started by
+// startService(). getLayerCount() and getStats() may be called from any thread.
+class LoopLayerStore {
+public:
+    static constexpr size_t kChunkFrames = 16384;
+    static constexpr size_t kMaxLayers = 32;
+    static constexpr uint32_t kNoChunk = 0xffffffffu;
+
+    struct Config {
+        double sampleRate = 44100.0;
+        float maxLoopSeconds = 60.0f;
+        size_t residentChunks = 256;    // 16 MiB RAM
+        size_t spillChunks = 4096;      // 256 MiB Spill-Datei
+        size_t maxUndoLayers = 16;
+        std::string spillPath;          // leer = temporäre Datei
+    };
+
+    struct Stats {
+        size_t residentChunksInUse = 0;
+        size_t spilledChunksInUse = 0;
+        size_t layers = 0;
+        size_t loopFrames = 0;
+        size_t droppedFrames = 0;
+    };
+
+    LoopLayerStore();
+    ~LoopLayerStore();
+
+    bool prepare(const Config& config);
+    void release();
+
+    void startService();
+    void stopService();
+
+    // Audio thread
+    void beginBlock();
+    bool beginLayer(float decayOfExistingLayers);
+    void write(const float* input, size_t loopPosition, size_t numFrames);
+    void finishLayer();
+    void setLoopLength(size_t frames);
+    bool undo();
+    bool redo();
+    void clear();
+    void mixInto(float* output, size_t loopPosition, size_t numFrames, float gain) const;
+    float readInterpolated(double loopPosition) const;
+
+    const Config& getConfig() const { return m_config; }
+    size_t getLoopLength() const { return m_loopLength; }
+    size_t getMaxLoopFrames() const { return m_maxLoopChunks * kChunkFrames; }
+    size_t getLayerCount() const { return m_publishedVisible.load(std::memory_order_acquire); }
+    bool isLayerOpen() const { return m_recordingLayer >= 0; }
+    void setPlayPosition(size_t loopPosition) { m_playPosition.store(loopPosition, std::memory_order_relaxed); }
+    Stats getStats() const;
+
+    // Background thread
+    void service();
+
+private:
+    enum class LayerState : uint32_t { Free, Recording, Finished };
+
+    struct Layer {
+        std::unique_ptr<std::atomic<uint32_t>[]> chunks;
+        std::atomic<uint32_t> state{static_cast<uint32_t>(LayerState::Free)};
+        std::atomic<uint32_t> generation{0};
+        std::atomic<float> gain{1.0f};
+        std::atomic<float> decay{1.0f};     // beim Start auf die darunterliegenden Layer angewandt
+    };
+
+    struct Remap {
+        uint32_t layer = 0;
+        uint32_t generation = 0;
+        uint32_t chunkIndex = 0;
+        uint32_t spillChunk = kNoChunk;
+    };
+
+    struct SpillFile;
+
+    // Effektive Pegel der sichtbaren Layer: eigener Gain mal Decay aller darüberliegenden
+    void layerGains(float* gains) const;
+
+    // Chunk-Verwaltung
+    float* chunkData(uint32_t chunk) const;
+    bool isResident(uint32_t chunk) const { return chunk < m_residentChunks; }
+    uint32_t acquireResidentChunk();
+    void releaseChunk(uint32_t chunk);
+    void releaseLayer(int layer);
+    int allocateLayerSlot();
+    void applyRemaps();
+    void applyCollapse();
+
+    // Hintergrund-Verarbeitung
+    void reclaimSpillChunks();
+    void spillFinishedLayers();
+    void collapseOldestLayers();
+    void prefetchAroundPlayhead();
+    uint32_t acquireSpillChunk();
+
+    Config m_config;
+    size_t m_maxLoopChunks;
+    size_t m_residentChunks;
+    size_t m_spillChunks;
+
+    std::vector<float> m_residentPool;
+    std::unique_ptr<SpillFile> m_spill;
+
+    // Audio-Thread-Zustand
+    std::vector<uint32_t> m_freeResident;
+    std::unique_ptr<Layer[]> m_layers;
+    int m_order[kMaxLayers];
+    size_t m_totalLayers;       // inkl. rückgängig gemachter (Redo) Layer
+    size_t m_visibleLayers;
+    int m_recordingLayer;
+    size_t m_loopLength;
+    size_t m_recordedFrames;
+    std::atomic<size_t> m_droppedFrames;
+    std::atomic<size_t> m_residentInUse;
+    std::atomic<size_t> m_playPosition;
+
+    // Für den Hintergrund-Thread veröffentlichte Layer-Reihenfolge
+    std::atomic<uint32_t> m_publishedOrder[kMaxLayers];
+    std::atomic<size_t> m_publishedVisible;
+    std::atomic<size_t> m_publishedLoopLength;
+
+    // Hintergrund-Thread-Zustand
+    std::vector<uint32_t> m_freeSpill;
+    std::atomic<size_t> m_spillInUse;
+    SpscQueue<Remap> m_remaps;
+    SpscQueue<uint32_t> m_spillReleases;
+
+    // Zusammenführen der ältesten Layer
+    std::unique_ptr<uint32_t[]> m_collapseChunks;
+    uint32_t m_collapseLayers[2];
+    uint32_t m_collapseGenerations[2];
+    float m_collapseGains[2];
+    size_t m_collapseChunkCount;
+    std::atomic<bool> m_collapseReady;
+
+    std::thread m_serviceThread;
+    std::atomic<bool> m_shouldStop;
+};
+
+} // namespace VRMusicStudio
@@ -1,11 +1,22 @@
 #include "LooperEffect.hpp"
+#include "audio/processing/SimdOps.hpp"
+#include <algorithm>
 #include <cmath>
 
 namespace VRMusicStudio {
 
+namespace {
+    // Längster Abschnitt, der am Stück verarbeitet wird; größere Blöcke werden aufgeteilt
+    constexpr size_t kMaxSegmentFrames = 4096;
+    constexpr size_t kCommandQueueSize = 64;
+    // Pro Umkonfiguration wird höchstens ein Speicher ersetzt; die Reserve
+    // deckt Umkonfigurationen ab, bevor der Nachrichten-Thread aufräumt
+    constexpr size_t kRetiredStoreSlots = 8;
+}
+
 LooperEffect::LooperEffect() :
     mix(0.5f),
-    feedback(0.5f),
+    feedback(1.0f),
     reverse(0.0f),
     speed(1.0f),
     quality(1.0f),
@@ -14,18 +25,32 @@ LooperEffect::LooperEffect() :
     automatedReverse(false),
     automatedSpeed(false),
     automatedQuality(false),
-    bufferSize(0),
-    writePos(0),
-    readPos(0),
+    activeStore(nullptr),
+    pendingStore(nullptr),
+    retiredStores(kRetiredStoreSlots),
+    sampleRate(44100.0),
+    playPosition(0.0),
+    recordPosition(0),
     recording(false),
+    overdubbing(false),
     playing(false),
-    loopLength(4.0f),
+    loopLength(0.0f),
+    maxLoopLength(60.0f),
     currentSpeed(1.0f),
     currentReverse(0.0f),
     currentMix(0.5f),
-    currentFeedback(0.5f),
-    currentQuality(1.0f)
+    currentFeedback(1.0f),
+    currentQuality(1.0f),
+    qualityState(0.0f),
+    transportPosition(0.0),
+    transportBpm(120.0),
+    transportBeatsPerBar(4),
+    transportRunning(false),
+    quantize(Quantize::Off),
+    commandQueue(kCommandQueueSize),
+    pendingCommand(Command::None)
 {
+    loopScratch.assign(kMaxSegmentFrames, 0.0f);
 }
 
 LooperEffect::~LooperEffect() {
@@ -33,19 +58,25 @@ LooperEffect::~LooperEffect() {
 }
 
 bool LooperEffect::initialize() {
-    const float sampleRate = 44100.0f;
-    resizeBuffer(loopLength);
+    initializeBuffer();
     return true;
 }
 
 void LooperEffect::shutdown() {
-    loopBuffer.clear();
+    // Nur bei gestoppter Audioverarbeitung
+    delete pendingStore.exchange(nullptr, std::memory_order_acq_rel);
+    activeStore.store(nullptr, std::memory_order_release);
+    store.reset();
+    deleteRetiredStores();
+    recording = false;
+    overdubbing = false;
+    playing = false;
 }
 
 std::vector<PluginParameter> LooperEffect::getParameters() const {
     return {
         {"mix", 0.5f, 0.0f, 1.0f},
-        {"feedback", 0.5f, 0.0f, 0.9f},
+        {"feedback", 1.0f, 0.0f, 1.0f},     // Abschwächung der vorhandenen Layer pro Overdub
         {"reverse", 0.0f, 0.0f, 1.0f},
         {"speed", 1.0f, 0.25f, 4.0f},
         {"quality", 1.0f, 0.0f, 1.0f}
@@ -87,84 +118,219 @@ bool LooperEffect::isParameterAutomated(const std::string& name) const {
 }
 
 void LooperEffect::processAudio(float* buffer, unsigned long framesPerBuffer) {
+    adoptPendingStore();
+    if (!store) return;
+
     updateParameters();
-    
-    if (recording) {
-        for (unsigned long i = 0; i < framesPerBuffer; ++i) {
-            loopBuffer[writePos] = buffer[i];
-            writePos = (writePos + 1) % bufferSize;
+    store->beginBlock();
+
+    size_t offset = 0;
+    while (offset < framesPerBuffer) {
+        // Neue Befehle übernehmen; Undo/Redo/Clear wirken sofort
+        Command command;
+        while (pendingCommand == Command::None && commandQueue.pop(command)) {
+            if (isQuantizable(command)) {
+                pendingCommand = command;
+            } else {
+                executeCommand(command);
+            }
+        }
+
+        size_t segment = std::min<size_t>(framesPerBuffer - offset, kMaxSegmentFrames);
+
+        if (pendingCommand != Command::None) {
+            const size_t boundary = framesUntilBoundary();
+            if (boundary == 0) {
+                executeCommand(pendingCommand);
+                pendingCommand = Command::None;
+                continue;
+            }
+            segment = std::min(segment, boundary);
+        }
+
+        // Feste Aufnahmelänge bzw. maximale Looplänge nicht überschreiten
+        if (recording) {
+            size_t limit = store->getMaxLoopFrames();
+            if (loopLength > 0.0f) {
+                limit = std::min(limit, quantizeLength(static_cast<size_t>(loopLength * sampleRate)));
+            }
+            if (recordPosition >= limit) {
+                executeCommand(Command::StopRecord);
+                continue;
+            }
+            segment = std::min(segment, limit - recordPosition);
+        }
+
+        processSegment(buffer + offset, segment);
+        offset += segment;
+        if (transportRunning) {
+            transportPosition += static_cast<double>(segment);
         }
     }
-    
-    if (playing) {
-        processLoop(buffer, framesPerBuffer);
-    }
-    
-    applySpeed(buffer, framesPerBuffer);
-    applyReverse(buffer, framesPerBuffer);
-    applyMix(buffer, framesPerBuffer);
-    applyFeedback(buffer, framesPerBuffer);
-    applyQuality(buffer, framesPerBuffer);
+
+    store->setPlayPosition(static_cast<size_t>(playPosition));
 }
 
 void LooperEffect::loadPreset(const std::string& presetName) {
-    // TODO: Implement preset loading
+    auto user = userPresets.find(presetName);
+    if (user != userPresets.end()) {
+        for (const auto& [name, value] : user->second) {
+            setParameter(name, value);
+        }
+        return;
+    }
+
+    if (presetName == "Default") {
+        mix = 0.5f;
+        feedback = 1.0f;
+        reverse = 0.0f;
+        speed = 1.0f;
+        quality = 1.0f;
+    }
+    else if (presetName == "Ambient Swell") {
+        mix = 0.6f;
+        feedback = 0.85f;
+        reverse = 0.0f;
+        speed = 1.0f;
+        quality = 0.6f;
+    }
+    else if (presetName == "Tape Fade") {
+        mix = 0.5f;
+        feedback = 0.7f;
+        reverse = 0.0f;
+        speed = 1.0f;
+        quality = 0.4f;
+    }
+    else if (presetName == "Half Speed Reverse") {
+        mix = 0.5f;
+        feedback = 1.0f;
+        reverse = 1.0f;
+        speed = 0.5f;
+        quality = 1.0f;
+    }
 }
 
 void LooperEffect::savePreset(const std::string& presetName) {
-    // TODO: Implement preset saving
+    userPresets[presetName] = {
+        {"mix", mix},
+        {"feedback", feedback},
+        {"reverse", reverse},
+        {"speed", speed},
+        {"quality", quality}
+    };
 }
 
 std::vector<std::string> LooperEffect::getAvailablePresets() const {
-    return {}; // TODO: Implement preset list
+    std::vector<std::string> presets = {"Default", "Ambient Swell", "Tape Fade", "Half Speed Reverse"};
+    for (const auto& entry : userPresets) {
+        presets.push_back(entry.first);
+    }
+    return presets;
 }
 
 void LooperEffect::startRecording() {
-    recording = true;
-    playing = false;
-    writePos = 0;
+    requestCommand(Command::Record);
 }
 
 void LooperEffect::stopRecording() {
-    recording = false;
-    playing = true;
-    readPos = 0;
+    requestCommand(Command::StopRecord);
+}
+
+void LooperEffect::startOverdub() {
+    requestCommand(Command::Overdub);
+}
+
+void LooperEffect::stopOverdub() {
+    requestCommand(Command::StopOverdub);
 }
 
 void LooperEffect::startPlayback() {
-    playing = true;
+    requestCommand(Command::Play);
 }
 
 void LooperEffect::stopPlayback() {
-    playing = false;
+    requestCommand(Command::Stop);
+}
+
+bool LooperEffect::undoLayer() {
+    if (getLayerCount() == 0) return false;
+    requestCommand(Command::Undo);
+    return true;
+}
+
+bool LooperEffect::redoLayer() {
+    requestCommand(Command::Redo);
+    return true;
 }
 
 void LooperEffect::clearLoop() {
-    loopBuffer.clear();
-    loopBuffer.resize(bufferSize, 0.0f);
-    recording = false;
-    playing = false;
-    writePos = 0;
-    readPos = 0;
+    requestCommand(Command::Clear);
 }
 
 void LooperEffect::setLoopLength(float seconds) {
-    loopLength = seconds;
-    resizeBuffer(seconds);
+    loopLength = std::clamp(seconds, 0.0f, maxLoopLength);
 }
 
 float LooperEffect::getLoopLength() const {
-    return loopLength;
+    const LoopLayerStore* current = activeStore.load(std::memory_order_acquire);
+    const size_t frames = current ? current->getStats().loopFrames : 0;
+    return frames > 0 ? static_cast<float>(frames / storeConfig.sampleRate) : loopLength;
 }
 
 bool LooperEffect::isRecording() const {
     return recording;
 }
 
+bool LooperEffect::isOverdubbing() const {
+    return overdubbing;
+}
+
 bool LooperEffect::isPlaying() const {
     return playing;
 }
 
+size_t LooperEffect::getLayerCount() const {
+    const LoopLayerStore* current = activeStore.load(std::memory_order_acquire);
+    return current ? current->getLayerCount() : 0;
+}
+
+LoopLayerStore::Stats LooperEffect::getStorageStats() const {
+    const LoopLayerStore* current = activeStore.load(std::memory_order_acquire);
+    return current ? current->getStats() : LoopLayerStore::Stats{};
+}
+
+void LooperEffect::setSampleRate(double rate) {
+    storeConfig.sampleRate = rate;
+    initializeBuffer();
+}
+
+void LooperEffect::setTransport(double samplePosition, double bpm, int beatsPerBar, bool running) {
+    transportPosition = samplePosition;
+    transportBpm = bpm;
+    transportBeatsPerBar = std::max(1, beatsPerBar);
+    transportRunning = running;
+}
+
+void LooperEffect::setQuantize(Quantize mode) {
+    quantize = mode;
+}
+
+LooperEffect::Quantize LooperEffect::getQuantize() const {
+    return quantize;
+}
+
+void LooperEffect::setMaxLoopLength(float seconds) {
+    maxLoopLength = std::max(0.1f, seconds);
+    initializeBuffer();
+}
+
+void LooperEffect::setMemoryBudget(size_t residentMegabytes, const std::string& spillPath) {
+    const size_t chunkBytes = LoopLayerStore::kChunkFrames * sizeof(float);
+    storeConfig.residentChunks = std::max<size_t>(1, residentMegabytes * 1024 * 1024 / chunkBytes);
+    storeConfig.spillPath = spillPath;
+    initializeBuffer();
+}
+
 void LooperEffect::updateParameters() {
     currentSpeed = speed;
     currentReverse = reverse;
@@ -173,96 +339,214 @@ void LooperEffect::updateParameters() {
     currentQuality = quality;
 }
 
-void LooperEffect::processLoop(float* buffer, unsigned long framesPerBuffer) {
-    for (unsigned long i = 0; i < framesPerBuffer; ++i) {
-        float loopSample = loopBuffer[readPos];
-        buffer[i] = buffer[i] * (1.0f - currentMix) + loopSample * currentMix;
-        loopBuffer[writePos] = buffer[i] * currentFeedback;
-        
-        writePos = (writePos + 1) % bufferSize;
-        readPos = (readPos + 1) % bufferSize;
+void LooperEffect::processSegment(float* buffer, size_t numFrames) {
+    float* wet = loopScratch.data();
+    std::fill(wet, wet + numFrames, 0.0f);
+
+    // Overdubs werden nur bei normaler Wiedergabe positionsgenau geschrieben
+    const bool straightPlayback = currentSpeed == 1.0f && currentReverse < 0.5f;
+    const size_t overdubPosition = static_cast<size_t>(playPosition);
+
+    if (playing) {
+        renderLoop(wet, numFrames);
+        applyQuality(wet, numFrames);
     }
-}
 
-void LooperEffect::applySpeed(float* buffer, unsigned long framesPerBuffer) {
-    if (currentSpeed == 1.0f) return;
-    
-    std::vector<float> tempBuffer(buffer, buffer + framesPerBuffer);
-    float position = 0.0f;
-    float step = currentSpeed;
-    
-    for (unsigned long i = 0; i < framesPerBuffer; ++i) {
-        buffer[i] = interpolateSample(tempBuffer, position);
-        position += step;
+    if (recording) {
+        store->write(buffer, recordPosition, numFrames);
+        recordPosition += numFrames;
+    } else if (overdubbing && playing && straightPlayback) {
+        store->write(buffer, overdubPosition, numFrames);
     }
+
+    SimdOps::mix(buffer, wet, 1.0f - currentMix, currentMix, numFrames);
 }
 
-void LooperEffect::applyReverse(float* buffer, unsigned long framesPerBuffer) {
-    if (currentReverse <= 0.0f) return;
-    
-    std::vector<float> tempBuffer(buffer, buffer + framesPerBuffer);
-    for (unsigned long i = 0; i < framesPerBuffer; ++i) {
-        float forward = tempBuffer[i];
-        float backward = tempBuffer[framesPerBuffer - 1 - i];
-        buffer[i] = forward * (1.0f - currentReverse) + backward * currentReverse;
+void LooperEffect::renderLoop(float* output, size_t numFrames) {
+    const size_t length = store->getLoopLength();
+    if (length == 0) return;
+
+    if (currentSpeed == 1.0f && currentReverse < 0.5f) {
+        store->mixInto(output, static_cast<size_t>(playPosition), numFrames, 1.0f);
+        playPosition = std::fmod(std::floor(playPosition) + static_cast<double>(numFrames), static_cast<double>(length));
+        return;
+    }
+
+    // Varispeed/Rückwärts: interpolierendes Lesen über alle Layer
+    const double step = currentReverse >= 0.5f ? -currentSpeed : currentSpeed;
+    const double wrap = static_cast<double>(length);
+    for (size_t i = 0; i < numFrames; ++i) {
+        output[i] = store->readInterpolated(playPosition);
+        playPosition += step;
+        if (playPosition >= wrap) playPosition -= wrap;
+        else if (playPosition < 0.0) playPosition += wrap;
     }
 }
 
-void LooperEffect::applyMix(float* buffer, unsigned long framesPerBuffer) {
-    if (currentMix == 0.5f) return;
-    
-    for (unsigned long i = 0; i < framesPerBuffer; ++i) {
-        buffer[i] *= currentMix;
+void LooperEffect::applyQuality(float* buffer, size_t numFrames) {
+    if (currentQuality >= 1.0f) {
+        qualityState = numFrames > 0 ? buffer[numFrames - 1] : qualityState;
+        return;
+    }
+
+    // Einpoliger Tiefpass über das Loop-Signal
+    const float alpha = std::max(currentQuality, 0.01f);
+    float state = qualityState;
+    for (size_t i = 0; i < numFrames; ++i) {
+        state += alpha * (buffer[i] - state);
+        buffer[i] = state;
+    }
+    qualityState = state;
+}
+
+void LooperEffect::requestCommand(Command command) {
+    commandQueue.push(command);
+}
+
+bool LooperEffect::isQuantizable(Command command) {
+    return command != Command::Undo && command != Command::Redo && command != Command::Clear;
+}
+
+void LooperEffect::executeCommand(Command command) {
+    switch (command) {
+        case Command::Record:
+            store->clear();
+            if (store->beginLayer(1.0f)) {
+                recording = true;
+                overdubbing = false;
+                playing = false;
+                recordPosition = 0;
+            }
+            break;
+
+        case Command::StopRecord:
+            if (!recording) break;
+            store->setLoopLength(quantizeLength(recordPosition));
+            store->finishLayer();
+            recording = false;
+            playing = store->getLoopLength() > 0;
+            playPosition = 0.0;
+            break;
+
+        case Command::Overdub:
+            if (recording) {
+                executeCommand(Command::StopRecord);
+            }
+            if (playing && !overdubbing && store->beginLayer(currentFeedback)) {
+                overdubbing = true;
+            }
+            break;
+
+        case Command::StopOverdub:
+            if (!overdubbing) break;
+            store->finishLayer();
+            overdubbing = false;
+            break;
+
+        case Command::Play:
+            if (recording) {
+                executeCommand(Command::StopRecord);
+            }
+            playing = store->getLoopLength() > 0;
+            playPosition = 0.0;
+            break;
+
+        case Command::Stop:
+            if (recording) {
+                executeCommand(Command::StopRecord);
+            }
+            executeCommand(Command::StopOverdub);
+            playing = false;
+            break;
+
+        case Command::Undo:
+            store->undo();
+            overdubbing = false;
+            if (recording) {
+                recording = false;
+                playing = false;
+            }
+            break;
+
+        case Command::Redo:
+            store->redo();
+            playing = playing || (store->getLoopLength() > 0 && store->getLayerCount() > 0);
+            break;
+
+        case Command::Clear:
+            store->clear();
+            pendingCommand = Command::None;
+            recording = false;
+            overdubbing = false;
+            playing = false;
+            playPosition = 0.0;
+            recordPosition = 0;
+            break;
+
+        case Command::None:
+            break;
     }
 }
 
-void LooperEffect::applyFeedback(float* buffer, unsigned long framesPerBuffer) {
-    if (currentFeedback <= 0.0f) return;
-    
-    for (unsigned long i = 0; i < framesPerBuffer; ++i) {
-        buffer[i] *= (1.0f + currentFeedback);
+size_t LooperEffect::framesUntilBoundary() const {
+    if (quantize == Quantize::Off || !transportRunning || transportBpm <= 0.0) {
+        return 0;
     }
+    const double beatFrames = sampleRate * 60.0 / transportBpm;
+    const double unit = quantize == Quantize::Bar ? beatFrames * transportBeatsPerBar : beatFrames;
+    const double next = std::ceil(transportPosition / unit - 1e-9) * unit;
+    return static_cast<size_t>(std::llround(std::max(0.0, next - transportPosition)));
 }
 
-void LooperEffect::applyQuality(float* buffer, unsigned long framesPerBuffer) {
-    if (currentQuality >= 1.0f) return;
-    
-    // Simple low-pass filter based on quality
-    float alpha = currentQuality;
-    float prev = buffer[0];
-    
-    for (unsigned long i = 1; i < framesPerBuffer; ++i) {
-        float current = buffer[i];
-        buffer[i] = prev + alpha * (current - prev);
-        prev = buffer[i];
+size_t LooperEffect::quantizeLength(size_t frames) const {
+    if (quantize == Quantize::Off || transportBpm <= 0.0) {
+        return frames;
     }
+    const double beatFrames = sampleRate * 60.0 / transportBpm;
+    const double unit = quantize == Quantize::Bar ? beatFrames * transportBeatsPerBar : beatFrames;
+    const double units = std::max(1.0, std::round(static_cast<double>(frames) / unit));
+    return static_cast<size_t>(std::llround(units * unit));
 }
 
 void LooperEffect::initializeBuffer() {
-    loopBuffer.resize(bufferSize, 0.0f);
-    writePos = 0;
-    readPos = 0;
+    deleteRetiredStores();
+
+    storeConfig.maxLoopSeconds = maxLoopLength;
+    auto next = std::make_unique<LoopLayerStore>();
+    next->prepare(storeConfig);
+    next->startService();
+
+    // Eine noch nicht übernommene Konfiguration wird direkt ersetzt
+    delete pendingStore.exchange(next.release(), std::memory_order_acq_rel);
 }
 
-void LooperEffect::resizeBuffer(float seconds) {
-    const float sampleRate = 44100.0f;
-    bufferSize = static_cast<unsigned long>(seconds * sampleRate);
-    loopBuffer.resize(bufferSize, 0.0f);
-    writePos = 0;
-    readPos = 0;
+void LooperEffect::adoptPendingStore() {
+    if (!pendingStore.load(std::memory_order_acquire)) return;
+
+    // Den alten Speicher nur abgeben, wenn der Nachrichten-Thread ihn sicher löschen kann
+    if (store && !retiredStores.push(store.get())) return;
+    store.release(); // gehört jetzt retiredStores
+    store.reset(pendingStore.exchange(nullptr, std::memory_order_acq_rel));
+    activeStore.store(store.get(), std::memory_order_release);
+
+    // Befehle und Zustand beziehen sich auf den ersetzten Loop
+    Command dropped;
+    while (commandQueue.pop(dropped)) {}
+    pendingCommand = Command::None;
+    sampleRate = store ? store->getConfig().sampleRate : sampleRate;
+    recording = false;
+    overdubbing = false;
+    playing = false;
+    playPosition = 0.0;
+    recordPosition = 0;
+    qualityState = 0.0f;
 }
 
-float LooperEffect::interpolateSample(const std::deque<float>& buffer, float position) {
-    unsigned long index = static_cast<unsigned long>(position);
-    float fraction = position - index;
-    
-    if (index >= buffer.size() - 1) {
-        return buffer.back();
+void LooperEffect::deleteRetiredStores() {
+    LoopLayerStore* retired = nullptr;
+    while (retiredStores.pop(retired)) {
+        delete retired;
     }
-    
-    float sample1 = buffer[index];
-    float sample2 = buffer[index + 1];
-    return sample1 + fraction * (sample2 - sample1);
 }
 
-} // namespace VRMusicStudio 
\ No newline at end of file
+} // namespace VRMusicStudio
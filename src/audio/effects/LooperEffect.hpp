@@ -1,9 +1,12 @@
 #pragma once
 
 #include "EffectPlugin.hpp"
+#include "LoopLayerStore.hpp"
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <string>
-#include <deque>
+#include <map>
 
 namespace VRMusicStudio {
 
@@ -38,15 +41,36 @@ public:
     std::vector<std::string> getAvailablePresets() const override;
 
     // Looper Control
+    // Start/stop requests are executed at the next quantization boundary of
+    // the transport when quantization is enabled and the transport is running.
     void startRecording();
     void stopRecording();
+    void startOverdub();
+    void stopOverdub();
     void startPlayback();
     void stopPlayback();
+    bool undoLayer();
+    bool redoLayer();
     void clearLoop();
     void setLoopLength(float seconds);
     float getLoopLength() const;
     bool isRecording() const;
+    bool isOverdubbing() const;
     bool isPlaying() const;
+    size_t getLayerCount() const;
+    LoopLayerStore::Stats getStorageStats() const;
+
+    // Transport & Quantization
+    enum class Quantize { Off, Beat, Bar };
+    void setSampleRate(double rate);
+    void setTransport(double samplePosition, double bpm, int beatsPerBar, bool running);
+    void setQuantize(Quantize mode);
+    Quantize getQuantize() const;
+    // Reconfiguration prepares a new layer store on the calling thread and
+    // hands it to the audio thread, which adopts it at the next block and
+    // drops the current loop. Safe to call while audio is running.
+    void setMaxLoopLength(float seconds);
+    void setMemoryBudget(size_t residentMegabytes, const std::string& spillPath = {});
 
 private:
     // Parameter
@@ -63,33 +87,60 @@ private:
     bool automatedSpeed;
     bool automatedQuality;
 
+    enum class Command { None, Record, StopRecord, Overdub, StopOverdub, Play, Stop, Undo, Redo, Clear };
+
     // State Variables
-    std::deque<float> loopBuffer;
-    unsigned long bufferSize;
-    unsigned long writePos;
-    unsigned long readPos;
+    // Der aktive Speicher gehört dem Audio-Thread. Neue Konfigurationen kommen
+    // fertig vorbereitet über pendingStore, ersetzte Speicher gehen über
+    // retiredStores zum Löschen an den Nachrichten-Thread zurück.
+    std::unique_ptr<LoopLayerStore> store;
+    std::atomic<LoopLayerStore*> activeStore;      // Sicht für Abfragen außerhalb des Audio-Threads
+    std::atomic<LoopLayerStore*> pendingStore;
+    SpscQueue<LoopLayerStore*> retiredStores;
+    LoopLayerStore::Config storeConfig;            // nur Nachrichten-Thread
+    std::vector<float> loopScratch;
+    double sampleRate;
+    double playPosition;
+    size_t recordPosition;
     bool recording;
+    bool overdubbing;
     bool playing;
     float loopLength;
+    float maxLoopLength;
     float currentSpeed;
     float currentReverse;
     float currentMix;
     float currentFeedback;
     float currentQuality;
+    float qualityState;
+
+    // Transport
+    double transportPosition;
+    double transportBpm;
+    int transportBeatsPerBar;
+    bool transportRunning;
+    Quantize quantize;
+    SpscQueue<Command> commandQueue;   // UI -> Audio-Thread
+    Command pendingCommand;            // wartet auf die nächste Quantisierungsgrenze
+
+    // Presets
+    std::map<std::string, std::map<std::string, float>> userPresets;
 
     // Processing Methods
     void updateParameters();
-    void processLoop(float* buffer, unsigned long framesPerBuffer);
-    void applySpeed(float* buffer, unsigned long framesPerBuffer);
-    void applyReverse(float* buffer, unsigned long framesPerBuffer);
-    void applyMix(float* buffer, unsigned long framesPerBuffer);
-    void applyFeedback(float* buffer, unsigned long framesPerBuffer);
-    void applyQuality(float* buffer, unsigned long framesPerBuffer);
+    void processSegment(float* buffer, size_t numFrames);
+    void renderLoop(float* output, size_t numFrames);
+    void applyQuality(float* buffer, size_t numFrames);
+    void requestCommand(Command command);
+    void executeCommand(Command command);
+    static bool isQuantizable(Command command);
+    size_t framesUntilBoundary() const;
+    size_t quantizeLength(size_t frames) const;
 
     // Helper Methods
     void initializeBuffer();
-    void resizeBuffer(float seconds);
-    float interpolateSample(const std::deque<float>& buffer, float position);
+    void adoptPendingStore();
+    void deleteRetiredStores();
 };
 
 } // namespace VRMusicStudio 
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "ReverseDelayEffect.hpp"
+#include "audio/processing/SilenceDetector.hpp"
 #include <algorithm>
 #include <cmath>
 
@@ -93,4 +94,9 @@ std::string ReverseDelayEffect::getParameterName(int index) const
     }
 }
 
+double ReverseDelayEffect::getTailSeconds() const
+{
+    return feedbackTailSeconds(m_delayTime, m_feedback);
+}
+
 } // namespace VRMusicStudio 
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <torch/script.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace VRMusicStudio {
+
+// Gemeinsame Render-Schritte der Instrumentenfamilien (nur für die .cpp-Dateien
+// in diesem Verzeichnis, nicht Teil der öffentlichen Header)
+namespace InstrumentRendering {
+
+// Nativer Pfad: die Modelle addieren in den Puffer, also vorher löschen
+template <typename Model>
+inline void renderNative(Model& model, float* buffer, int numSamples) {
+    std::fill(buffer, buffer + numSamples, 0.0f);
+    model.process(buffer, numSamples);
+}
+
+template <typename Model>
+inline void renderNative(Model& model, std::vector<float>& buffer) {
+    renderNative(model, buffer.data(), static_cast<int>(buffer.size()));
+}
+
+// Ein Forward-Aufruf pro Block, Ausgabe am Stück kopieren; fehlende Samples
+// bleiben still
+inline void renderNeural(torch::jit::script::Module& model, const torch::Tensor& input,
+                         float* buffer, int numSamples) {
+    auto output = model.forward({input}).toTensor().to(torch::kFloat).contiguous();
+    const int available = static_cast<int>(std::min<int64_t>(output.numel(), numSamples));
+    const float* data = output.data_ptr<float>();
+    std::copy(data, data + available, buffer);
+    std::fill(buffer + available, buffer + numSamples, 0.0f);
+}
+
+// Block in den Verlaufspuffer des Instruments übernehmen und melden
+inline void publish(const float* buffer, int numSamples, std::vector<float>& history,
+                    const std::function<void(const std::vector<float>&)>& callback) {
+    std::copy(buffer, buffer + std::min<size_t>(numSamples, history.size()), history.begin());
+    if (callback) {
+        callback(history);
+    }
+}
+
+} // namespace InstrumentRendering
+
+} // namespace VRMusicStudio
@@ -1,5 +1,55 @@
 #include "PercussionInstruments.hpp"
+#include "InstrumentRendering.hpp"
+#include "audio/processing/ModalBank.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+
+using VRMusicStudio::ModalBank;
+
+namespace {
+
+// General-MIDI-Drum-Map auf die Modalmodelle des Drum-Kits
+enum class DrumPiece { Kick, Snare, Tom, HiHat, Cymbal };
+
+struct DrumHit {
+    DrumPiece piece;
+    float frequency;    // Hz
+    float position;     // Anschlagpunkt 0 - 1
+    float velocity;     // Faktor
+    bool closed;        // Hi-Hat: sofort abdämpfen
+};
+
+bool findDrumHit(int note, DrumHit& hit) {
+    switch (note) {
+    case 35: hit = {DrumPiece::Kick, 50.0f, 0.5f, 1.0f, false}; return true;
+    case 36: hit = {DrumPiece::Kick, 55.0f, 0.5f, 1.0f, false}; return true;
+    case 37: hit = {DrumPiece::Snare, 190.0f, 0.95f, 0.5f, false}; return true;    // Side Stick
+    case 38: hit = {DrumPiece::Snare, 190.0f, 0.3f, 1.0f, false}; return true;
+    case 40: hit = {DrumPiece::Snare, 200.0f, 0.2f, 1.0f, false}; return true;
+    case 41: hit = {DrumPiece::Tom, 82.0f, 0.3f, 1.0f, false}; return true;
+    case 43: hit = {DrumPiece::Tom, 98.0f, 0.3f, 1.0f, false}; return true;
+    case 45: hit = {DrumPiece::Tom, 110.0f, 0.3f, 1.0f, false}; return true;
+    case 47: hit = {DrumPiece::Tom, 131.0f, 0.3f, 1.0f, false}; return true;
+    case 48: hit = {DrumPiece::Tom, 147.0f, 0.3f, 1.0f, false}; return true;
+    case 50: hit = {DrumPiece::Tom, 165.0f, 0.3f, 1.0f, false}; return true;
+    case 42: hit = {DrumPiece::HiHat, 440.0f, 0.8f, 1.0f, true}; return true;
+    case 44: hit = {DrumPiece::HiHat, 440.0f, 0.8f, 0.5f, true}; return true;      // Pedal
+    case 46: hit = {DrumPiece::HiHat, 440.0f, 0.8f, 1.0f, false}; return true;
+    case 49: hit = {DrumPiece::Cymbal, 330.0f, 0.8f, 1.0f, false}; return true;    // Crash
+    case 57: hit = {DrumPiece::Cymbal, 370.0f, 0.8f, 1.0f, false}; return true;
+    case 51: hit = {DrumPiece::Cymbal, 520.0f, 0.5f, 0.7f, false}; return true;    // Ride
+    case 59: hit = {DrumPiece::Cymbal, 560.0f, 0.5f, 0.7f, false}; return true;
+    case 53: hit = {DrumPiece::Cymbal, 780.0f, 0.1f, 0.8f, false}; return true;    // Ride Bell
+    case 52: hit = {DrumPiece::Cymbal, 300.0f, 0.9f, 1.0f, false}; return true;    // China
+    case 55: hit = {DrumPiece::Cymbal, 620.0f, 0.8f, 0.8f, false}; return true;    // Splash
+    default: return false;
+    }
+}
+
+// Alle Hi-Hat-Noten teilen sich eine Stimme, geschlossen dämpft offen ab
+constexpr int kHiHatKey = 42;
+
+} // namespace
 
 struct PercussionInstruments::Impl {
     DrumKit drumKit;
@@ -11,6 +61,21 @@ struct PercussionInstruments::Impl {
     Glockenspiel glockenspiel;
     TubularBells tubularBells;
 
+    // Native Modalmodelle
+    ModalBank kickBank{ModalBank::kick(), 4};
+    ModalBank snareBank{ModalBank::snare(), 6};
+    ModalBank tomBank{ModalBank::tom(), 8};
+    ModalBank hiHatBank{ModalBank::hiHat(), 2};
+    ModalBank kitCymbalBank{ModalBank::cymbal(), 6};
+    ModalBank timpaniBank{ModalBank::timpani(), 8};
+    ModalBank cymbalsBank{ModalBank::cymbal(), 4};
+    ModalBank marimbaBank{ModalBank::marimba(), 32};
+    ModalBank xylophoneBank{ModalBank::xylophone(), 32};
+    ModalBank vibraphoneBank{ModalBank::vibraphone(), 32};
+    ModalBank glockenspielBank{ModalBank::glockenspiel(), 24};
+    ModalBank tubularBellsBank{ModalBank::tubularBells(), 16};
+
+    // KI-Modelle (optional, werden erst bei Bedarf geladen)
     torch::jit::script::Module drumKitModel;
     torch::jit::script::Module timpaniModel;
     torch::jit::script::Module cymbalsModel;
@@ -19,6 +84,8 @@ struct PercussionInstruments::Impl {
     torch::jit::script::Module vibraphoneModel;
     torch::jit::script::Module glockenspielModel;
     torch::jit::script::Module tubularBellsModel;
+    bool neuralEnhancement = false;
+    bool modelsLoaded = false;
 
     std::vector<float> drumKitBuffer;
     std::vector<float> timpaniBuffer;
@@ -39,6 +106,17 @@ struct PercussionInstruments::Impl {
     std::function<void(const std::vector<float>&)> tubularBellsCallback;
 
     Impl() {
+        drumKitBuffer.resize(1024);
+        timpaniBuffer.resize(1024);
+        cymbalsBuffer.resize(1024);
+        marimbaBuffer.resize(1024);
+        xylophoneBuffer.resize(1024);
+        vibraphoneBuffer.resize(1024);
+        glockenspielBuffer.resize(1024);
+        tubularBellsBuffer.resize(1024);
+    }
+
+    void loadModels() {
         try {
             drumKitModel = torch::jit::load("models/drum_kit.pt");
             timpaniModel = torch::jit::load("models/timpani.pt");
@@ -48,59 +126,153 @@ struct PercussionInstruments::Impl {
             vibraphoneModel = torch::jit::load("models/vibraphone.pt");
             glockenspielModel = torch::jit::load("models/glockenspiel.pt");
             tubularBellsModel = torch::jit::load("models/tubular_bells.pt");
-
-            drumKitBuffer.resize(1024);
-            timpaniBuffer.resize(1024);
-            cymbalsBuffer.resize(1024);
-            marimbaBuffer.resize(1024);
-            xylophoneBuffer.resize(1024);
-            vibraphoneBuffer.resize(1024);
-            glockenspielBuffer.resize(1024);
-            tubularBellsBuffer.resize(1024);
+            modelsLoaded = true;
         } catch (const c10::Error& e) {
             spdlog::error("Fehler beim Laden der KI-Modelle: {}", e.what());
         }
     }
+
+    ModalBank* bank(Instrument instrument) {
+        switch (instrument) {
+        case Instrument::Timpani: return &timpaniBank;
+        case Instrument::Cymbals: return &cymbalsBank;
+        case Instrument::Marimba: return &marimbaBank;
+        case Instrument::Xylophone: return &xylophoneBank;
+        case Instrument::Vibraphone: return &vibraphoneBank;
+        case Instrument::Glockenspiel: return &glockenspielBank;
+        case Instrument::TubularBells: return &tubularBellsBank;
+        default: return nullptr;
+        }
+    }
+
+    ModalBank& drumBank(DrumPiece piece) {
+        switch (piece) {
+        case DrumPiece::Kick: return kickBank;
+        case DrumPiece::Snare: return snareBank;
+        case DrumPiece::Tom: return tomBank;
+        case DrumPiece::HiHat: return hiHatBank;
+        default: return kitCymbalBank;
+        }
+    }
+
+    void strikeDrum(int note, float velocity) {
+        DrumHit hit;
+        if (!findDrumHit(note, hit)) return;
+        const int key = hit.piece == DrumPiece::HiHat ? kHiHatKey : note;
+        ModalBank& target = drumBank(hit.piece);
+        target.strike(key, hit.frequency, velocity * hit.velocity, hit.position);
+        if (hit.closed) target.noteOff(key);
+    }
+
+    void applyDrumKitGain() {
+        for (ModalBank* piece : {&kickBank, &snareBank, &tomBank, &hiHatBank, &kitCymbalBank}) {
+            piece->setGain(drumKit.volume);
+        }
+    }
+
+    void renderDrumKit(std::vector<float>& buffer) {
+        std::fill(buffer.begin(), buffer.end(), 0.0f);
+        for (ModalBank* piece : {&kickBank, &snareBank, &tomBank, &hiHatBank, &kitCymbalBank}) {
+            piece->process(buffer.data(), static_cast<int>(buffer.size()));
+        }
+    }
 };
 
 PercussionInstruments::PercussionInstruments() : pImpl(std::make_unique<Impl>()) {}
 PercussionInstruments::~PercussionInstruments() = default;
 
+void PercussionInstruments::noteOn(Instrument instrument, int note, int velocity) {
+    const float level = std::clamp(velocity, 0, 127) / 127.0f;
+    if (level <= 0.0f) {
+        noteOff(instrument, note);
+        return;
+    }
+    if (instrument == Instrument::DrumKit) {
+        pImpl->strikeDrum(note, level);
+    } else if (ModalBank* bank = pImpl->bank(instrument)) {
+        bank->noteOn(note, level);
+    }
+}
+
+void PercussionInstruments::noteOff(Instrument instrument, int note) {
+    // Das Drum-Kit klingt immer frei aus
+    if (ModalBank* bank = pImpl->bank(instrument)) {
+        bank->noteOff(note);
+    }
+}
+
+void PercussionInstruments::allNotesOff() {
+    for (Instrument instrument : {Instrument::Timpani, Instrument::Cymbals, Instrument::Marimba,
+                                  Instrument::Xylophone, Instrument::Vibraphone, Instrument::Glockenspiel,
+                                  Instrument::TubularBells}) {
+        pImpl->bank(instrument)->allNotesOff();
+    }
+    pImpl->hiHatBank.allNotesOff();
+    pImpl->kitCymbalBank.allNotesOff();
+}
+
+void PercussionInstruments::setNeuralEnhancement(bool enabled) {
+    if (enabled && !pImpl->modelsLoaded) {
+        pImpl->loadModels();
+    }
+    pImpl->neuralEnhancement = enabled && pImpl->modelsLoaded;
+}
+
+bool PercussionInstruments::isNeuralEnhancementEnabled() const {
+    return pImpl->neuralEnhancement;
+}
+
 void PercussionInstruments::setDrumKitParams(const DrumKit& params) {
     pImpl->drumKit = params;
+    pImpl->applyDrumKitGain();
 }
 
 void PercussionInstruments::setTimpaniParams(const Timpani& params) {
     pImpl->timpani = params;
+    pImpl->timpaniBank.setGain(params.volume);
 }
 
 void PercussionInstruments::setCymbalsParams(const Cymbals& params) {
     pImpl->cymbals = params;
+    pImpl->cymbalsBank.setGain(params.volume);
 }
 
 void PercussionInstruments::setMarimbaParams(const Marimba& params) {
     pImpl->marimba = params;
+    pImpl->marimbaBank.setGain(params.volume);
 }
 
 void PercussionInstruments::setXylophoneParams(const Xylophone& params) {
     pImpl->xylophone = params;
+    pImpl->xylophoneBank.setGain(params.volume);
 }
 
 void PercussionInstruments::setVibraphoneParams(const Vibraphone& params) {
     pImpl->vibraphone = params;
+    pImpl->vibraphoneBank.setGain(params.volume);
 }
 
 void PercussionInstruments::setGlockenspielParams(const Glockenspiel& params) {
     pImpl->glockenspiel = params;
+    pImpl->glockenspielBank.setGain(params.volume);
 }
 
 void PercussionInstruments::setTubularBellsParams(const TubularBells& params) {
     pImpl->tubularBells = params;
+    pImpl->tubularBellsBank.setGain(params.volume);
 }
 
 void PercussionInstruments::processDrumKit(std::vector<float>& buffer) {
     if (!pImpl->drumKit.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        pImpl->renderDrumKit(buffer);
+        if (pImpl->drumKitCallback) {
+            pImpl->drumKitCallback(buffer);
+        }
+        return;
+    }
+
     try {
         std::vector<torch::jit::IValue> inputs;
         inputs.push_back(torch::tensor({
@@ -110,12 +282,14 @@ void PercussionInstruments::processDrumKit(std::vector<float>& buffer) {
             pImpl->drumKit.delay
         }));
 
-        auto output = pImpl->drumKitModel.forward(inputs).toTensor();
+        auto output = pImpl->drumKitModel.forward(inputs).toTensor().contiguous();
         auto outputData = output.data_ptr<float>();
+        const size_t count = std::min<size_t>(buffer.size(), static_cast<size_t>(output.numel()));
 
-        for (size_t i = 0; i < buffer.size(); ++i) {
+        for (size_t i = 0; i < count; ++i) {
             buffer[i] = outputData[i] * pImpl->drumKit.volume;
         }
+        std::fill(buffer.begin() + count, buffer.end(), 0.0f);
 
         if (pImpl->drumKitCallback) {
             pImpl->drumKitCallback(buffer);
@@ -128,6 +302,14 @@ void PercussionInstruments::processDrumKit(std::vector<float>& buffer) {
 void PercussionInstruments::processTimpani(std::vector<float>& buffer) {
     if (!pImpl->timpani.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->timpaniBank, buffer);
+        if (pImpl->timpaniCallback) {
+            pImpl->timpaniCallback(buffer);
+        }
+        return;
+    }
+
     try {
         std::vector<torch::jit::IValue> inputs;
         inputs.push_back(torch::tensor({
@@ -137,12 +319,14 @@ void PercussionInstruments::processTimpani(std::vector<float>& buffer) {
             pImpl->timpani.delay
         }));
 
-        auto output = pImpl->timpaniModel.forward(inputs).toTensor();
+        auto output = pImpl->timpaniModel.forward(inputs).toTensor().contiguous();
         auto outputData = output.data_ptr<float>();
+        const size_t count = std::min<size_t>(buffer.size(), static_cast<size_t>(output.numel()));
 
-        for (size_t i = 0; i < buffer.size(); ++i) {
+        for (size_t i = 0; i < count; ++i) {
             buffer[i] = outputData[i] * pImpl->timpani.volume;
         }
+        std::fill(buffer.begin() + count, buffer.end(), 0.0f);
 
         if (pImpl->timpaniCallback) {
             pImpl->timpaniCallback(buffer);
@@ -155,6 +339,14 @@ void PercussionInstruments::processTimpani(std::vector<float>& buffer) {
 void PercussionInstruments::processCymbals(std::vector<float>& buffer) {
     if (!pImpl->cymbals.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->cymbalsBank, buffer);
+        if (pImpl->cymbalsCallback) {
+            pImpl->cymbalsCallback(buffer);
+        }
+        return;
+    }
+
     try {
         std::vector<torch::jit::IValue> inputs;
         inputs.push_back(torch::tensor({
@@ -164,12 +356,14 @@ void PercussionInstruments::processCymbals(std::vector<float>& buffer) {
             pImpl->cymbals.delay
         }));
 
-        auto output = pImpl->cymbalsModel.forward(inputs).toTensor();
+        auto output = pImpl->cymbalsModel.forward(inputs).toTensor().contiguous();
         auto outputData = output.data_ptr<float>();
+        const size_t count = std::min<size_t>(buffer.size(), static_cast<size_t>(output.numel()));
 
-        for (size_t i = 0; i < buffer.size(); ++i) {
+        for (size_t i = 0; i < count; ++i) {
             buffer[i] = outputData[i] * pImpl->cymbals.volume;
         }
+        std::fill(buffer.begin() + count, buffer.end(), 0.0f);
 
         if (pImpl->cymbalsCallback) {
             pImpl->cymbalsCallback(buffer);
@@ -182,6 +376,14 @@ void PercussionInstruments::processCymbals(std::vector<float>& buffer) {
 void PercussionInstruments::processMarimba(std::vector<float>& buffer) {
     if (!pImpl->marimba.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->marimbaBank, buffer);
+        if (pImpl->marimbaCallback) {
+            pImpl->marimbaCallback(buffer);
+        }
+        return;
+    }
+
     try {
         std::vector<torch::jit::IValue> inputs;
         inputs.push_back(torch::tensor({
@@ -191,12 +393,14 @@ void PercussionInstruments::processMarimba(std::vector<float>& buffer) {
             pImpl->marimba.delay
         }));
 
-        auto output = pImpl->marimbaModel.forward(inputs).toTensor();
+        auto output = pImpl->marimbaModel.forward(inputs).toTensor().contiguous();
         auto outputData = output.data_ptr<float>();
+        const size_t count = std::min<size_t>(buffer.size(), static_cast<size_t>(output.numel()));
 
-        for (size_t i = 0; i < buffer.size(); ++i) {
+        for (size_t i = 0; i < count; ++i) {
             buffer[i] = outputData[i] * pImpl->marimba.volume;
         }
+        std::fill(buffer.begin() + count, buffer.end(), 0.0f);
 
         if (pImpl->marimbaCallback) {
             pImpl->marimbaCallback(buffer);
@@ -209,6 +413,14 @@ void PercussionInstruments::processMarimba(std::vector<float>& buffer) {
 void PercussionInstruments::processXylophone(std::vector<float>& buffer) {
     if (!pImpl->xylophone.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->xylophoneBank, buffer);
+        if (pImpl->xylophoneCallback) {
+            pImpl->xylophoneCallback(buffer);
+        }
+        return;
+    }
+
     try {
         std::vector<torch::jit::IValue> inputs;
         inputs.push_back(torch::tensor({
@@ -218,12 +430,14 @@ void PercussionInstruments::processXylophone(std::vector<float>& buffer) {
             pImpl->xylophone.delay
         }));
 
-        auto output = pImpl->xylophoneModel.forward(inputs).toTensor();
+        auto output = pImpl->xylophoneModel.forward(inputs).toTensor().contiguous();
         auto outputData = output.data_ptr<float>();
+        const size_t count = std::min<size_t>(buffer.size(), static_cast<size_t>(output.numel()));
 
-        for (size_t i = 0; i < buffer.size(); ++i) {
+        for (size_t i = 0; i < count; ++i) {
             buffer[i] = outputData[i] * pImpl->xylophone.volume;
         }
+        std::fill(buffer.begin() + count, buffer.end(), 0.0f);
 
         if (pImpl->xylophoneCallback) {
             pImpl->xylophoneCallback(buffer);
@@ -236,6 +450,14 @@ void PercussionInstruments::processXylophone(std::vector<float>& buffer) {
 void PercussionInstruments::processVibraphone(std::vector<float>& buffer) {
     if (!pImpl->vibraphone.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->vibraphoneBank, buffer);
+        if (pImpl->vibraphoneCallback) {
+            pImpl->vibraphoneCallback(buffer);
+        }
+        return;
+    }
+
     try {
         std::vector<torch::jit::IValue> inputs;
         inputs.push_back(torch::tensor({
@@ -245,12 +467,14 @@ void PercussionInstruments::processVibraphone(std::vector<float>& buffer) {
             pImpl->vibraphone.delay
         }));
 
-        auto output = pImpl->vibraphoneModel.forward(inputs).toTensor();
+        auto output = pImpl->vibraphoneModel.forward(inputs).toTensor().contiguous();
         auto outputData = output.data_ptr<float>();
+        const size_t count = std::min<size_t>(buffer.size(), static_cast<size_t>(output.numel()));
 
-        for (size_t i = 0; i < buffer.size(); ++i) {
+        for (size_t i = 0; i < count; ++i) {
             buffer[i] = outputData[i] * pImpl->vibraphone.volume;
         }
+        std::fill(buffer.begin() + count, buffer.end(), 0.0f);
 
         if (pImpl->vibraphoneCallback) {
             pImpl->vibraphoneCallback(buffer);
@@ -263,6 +487,14 @@ void PercussionInstruments::processVibraphone(std::vector<float>& buffer) {
 void PercussionInstruments::processGlockenspiel(std::vector<float>& buffer) {
     if (!pImpl->glockenspiel.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->glockenspielBank, buffer);
+        if (pImpl->glockenspielCallback) {
+            pImpl->glockenspielCallback(buffer);
+        }
+        return;
+    }
+
     try {
         std::vector<torch::jit::IValue> inputs;
         inputs.push_back(torch::tensor({
@@ -272,12 +504,14 @@ void PercussionInstruments::processGlockenspiel(std::vector<float>& buffer) {
             pImpl->glockenspiel.delay
         }));
 
-        auto output = pImpl->glockenspielModel.forward(inputs).toTensor();
+        auto output = pImpl->glockenspielModel.forward(inputs).toTensor().contiguous();
         auto outputData = output.data_ptr<float>();
+        const size_t count = std::min<size_t>(buffer.size(), static_cast<size_t>(output.numel()));
 
-        for (size_t i = 0; i < buffer.size(); ++i) {
+        for (size_t i = 0; i < count; ++i) {
             buffer[i] = outputData[i] * pImpl->glockenspiel.volume;
         }
+        std::fill(buffer.begin() + count, buffer.end(), 0.0f);
 
         if (pImpl->glockenspielCallback) {
             pImpl->glockenspielCallback(buffer);
@@ -290,6 +524,14 @@ void PercussionInstruments::processGlockenspiel(std::vector<float>& buffer) {
 void PercussionInstruments::processTubularBells(std::vector<float>& buffer) {
     if (!pImpl->tubularBells.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->tubularBellsBank, buffer);
+        if (pImpl->tubularBellsCallback) {
+            pImpl->tubularBellsCallback(buffer);
+        }
+        return;
+    }
+
     try {
         std::vector<torch::jit::IValue> inputs;
         inputs.push_back(torch::tensor({
@@ -299,12 +541,14 @@ void PercussionInstruments::processTubularBells(std::vector<float>& buffer) {
             pImpl->tubularBells.delay
         }));
 
-        auto output = pImpl->tubularBellsModel.forward(inputs).toTensor();
+        auto output = pImpl->tubularBellsModel.forward(inputs).toTensor().contiguous();
         auto outputData = output.data_ptr<float>();
+        const size_t count = std::min<size_t>(buffer.size(), static_cast<size_t>(output.numel()));
 
-        for (size_t i = 0; i < buffer.size(); ++i) {
+        for (size_t i = 0; i < count; ++i) {
             buffer[i] = outputData[i] * pImpl->tubularBells.volume;
         }
+        std::fill(buffer.begin() + count, buffer.end(), 0.0f);
 
         if (pImpl->tubularBellsCallback) {
             pImpl->tubularBellsCallback(buffer);
@@ -1,10 +1,31 @@
 #include "StringInstruments.hpp"
+#include "InstrumentRendering.hpp"
+#include "audio/processing/StringModel.hpp"
 #include <spdlog/spdlog.h>
 #include <algorithm>
 #include <cmath>
 
 namespace VRMusicStudio {
 
+namespace {
+
+// Tonumfang der Orchesterregister (MIDI)
+struct SectionRange {
+    int lowest;
+    int highest;
+};
+
+constexpr SectionRange kViolinRange{55, 103};
+constexpr SectionRange kViolaRange{48, 91};
+constexpr SectionRange kCelloRange{36, 76};
+constexpr SectionRange kBassRange{28, 60};
+
+bool inRange(const SectionRange& range, int note) {
+    return note >= range.lowest && note <= range.highest;
+}
+
+} // namespace
+
 struct StringInstruments::Impl {
     // Streichinstrumente-Parameter
     Violin violin;
@@ -12,13 +33,31 @@ struct StringInstruments::Impl {
     Cello cello;
     DoubleBass doubleBass;
     StringOrchestra stringOrchestra;
-
-    // KI-Modelle
+    Guitar guitar;
+    Harp harp;
+
+    // Native Waveguide-Modelle
+    StringModel violinString{StringModel::violin()};
+    StringModel violaString{StringModel::viola()};
+    StringModel celloString{StringModel::cello()};
+    StringModel doubleBassString{StringModel::doubleBass()};
+    StringModel guitarString{StringModel::guitar(), 12};
+    StringModel harpString{StringModel::harp(), 32};
+
+    // Register des Streichorchesters
+    StringModel orchestraViolins{StringModel::violin()};
+    StringModel orchestraViolas{StringModel::viola()};
+    StringModel orchestraCellos{StringModel::cello()};
+    StringModel orchestraBasses{StringModel::doubleBass()};
+
+    // KI-Modelle (optional, werden erst bei Bedarf geladen)
     torch::jit::script::Module violinModel;
     torch::jit::script::Module violaModel;
     torch::jit::script::Module celloModel;
     torch::jit::script::Module doubleBassModel;
     torch::jit::script::Module stringOrchestraModel;
+    bool neuralEnhancement = false;
+    bool modelsLoaded = false;
 
     // Buffer
     std::vector<float> violinBuffer;
@@ -26,6 +65,8 @@ struct StringInstruments::Impl {
     std::vector<float> celloBuffer;
     std::vector<float> doubleBassBuffer;
     std::vector<float> stringOrchestraBuffer;
+    std::vector<float> guitarBuffer;
+    std::vector<float> harpBuffer;
 
     // Callbacks
     std::function<void(const std::vector<float>&)> violinCallback;
@@ -33,8 +74,76 @@ struct StringInstruments::Impl {
     std::function<void(const std::vector<float>&)> celloCallback;
     std::function<void(const std::vector<float>&)> doubleBassCallback;
     std::function<void(const std::vector<float>&)> stringOrchestraCallback;
+    std::function<void(const std::vector<float>&)> guitarCallback;
+    std::function<void(const std::vector<float>&)> harpCallback;
 
     Impl() {
+        // Initialisiere Buffer
+        violinBuffer.resize(1024);
+        violaBuffer.resize(1024);
+        celloBuffer.resize(1024);
+        doubleBassBuffer.resize(1024);
+        stringOrchestraBuffer.resize(1024);
+        guitarBuffer.resize(1024);
+        harpBuffer.resize(1024);
+
+        // Initialisiere Parameter
+        violin = {0.5f, 0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+        viola = {0.5f, 0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+        cello = {0.5f, 0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+        doubleBass = {0.5f, 0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+        stringOrchestra = {1.0f, 1.0f, 1.0f, 1.0f, 0.3f, 0.2f, false};
+        guitar = {0.18f, 0.8f, 4.0f, 0.5f, 1.0f, 0.3f, 0.2f, false};
+        harp = {0.45f, 0.6f, 6.0f, 0.4f, 1.0f, 0.3f, 0.2f, false};
+
+        applyBowed(violinString, violin);
+        applyBowed(violaString, viola);
+        applyBowed(celloString, cello);
+        applyBowed(doubleBassString, doubleBass);
+        applyPlucked(guitarString, guitar);
+        applyPlucked(harpString, harp);
+        applyOrchestra();
+    }
+
+    // Bogendruck und -geschwindigkeit 0 - 1, Vibrato-Tiefe in Halbtönen
+    template <typename Params>
+    static void applyBowed(StringModel& model, const Params& params) {
+        model.setBow(params.bowPressure, params.bowSpeed);
+        model.setVibrato(params.vibratoDepth, params.vibratoRate);
+        model.setGain(params.volume);
+    }
+
+    template <typename Params>
+    static void applyPlucked(StringModel& model, const Params& params) {
+        StringModel::Preset preset = model.getPreset();
+        preset.position = std::clamp(params.pluckPosition, 0.01f, 0.5f);
+        preset.brightness = std::clamp(params.brightness, 0.0f, 1.0f);
+        preset.decay = std::max(params.sustain, 0.05f);
+        preset.bodyMix = std::clamp(params.bodyMix, 0.0f, 1.0f);
+        model.setPreset(preset);
+        model.setGain(params.volume);
+    }
+
+    void applyOrchestra() {
+        orchestraViolins.setGain(stringOrchestra.violinVolume);
+        orchestraViolas.setGain(stringOrchestra.violaVolume);
+        orchestraCellos.setGain(stringOrchestra.celloVolume);
+        orchestraBasses.setGain(stringOrchestra.bassVolume);
+    }
+
+    StringModel* model(Instrument instrument) {
+        switch (instrument) {
+        case Instrument::Violin: return &violinString;
+        case Instrument::Viola: return &violaString;
+        case Instrument::Cello: return &celloString;
+        case Instrument::DoubleBass: return &doubleBassString;
+        case Instrument::Guitar: return &guitarString;
+        case Instrument::Harp: return &harpString;
+        default: return nullptr;
+        }
+    }
+
+    void loadModels() {
         try {
             // Lade KI-Modelle
             violinModel = torch::jit::load("models/violin.pt");
@@ -42,20 +151,7 @@ struct StringInstruments::Impl {
             celloModel = torch::jit::load("models/cello.pt");
             doubleBassModel = torch::jit::load("models/double_bass.pt");
             stringOrchestraModel = torch::jit::load("models/string_orchestra.pt");
-
-            // Initialisiere Buffer
-            violinBuffer.resize(1024);
-            violaBuffer.resize(1024);
-            celloBuffer.resize(1024);
-            doubleBassBuffer.resize(1024);
-            stringOrchestraBuffer.resize(1024);
-
-            // Initialisiere Parameter
-            violin = {0.5f, 0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
-            viola = {0.5f, 0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
-            cello = {0.5f, 0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
-            doubleBass = {0.5f, 0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
-            stringOrchestra = {1.0f, 1.0f, 1.0f, 1.0f, 0.3f, 0.2f, false};
+            modelsLoaded = true;
         } catch (const std::exception& e) {
             spdlog::error("Fehler beim Laden der Streichinstrumente-Modelle: {}", e.what());
         }
@@ -65,14 +161,70 @@ struct StringInstruments::Impl {
 StringInstruments::StringInstruments() : pImpl(std::make_unique<Impl>()) {}
 StringInstruments::~StringInstruments() = default;
 
+// Noten
+void StringInstruments::noteOn(Instrument instrument, int note, int velocity) {
+    const float level = std::clamp(velocity, 0, 127) / 127.0f;
+    if (instrument == Instrument::StringOrchestra) {
+        if (inRange(kViolinRange, note)) pImpl->orchestraViolins.noteOn(note, level);
+        if (inRange(kViolaRange, note)) pImpl->orchestraViolas.noteOn(note, level);
+        if (inRange(kCelloRange, note)) pImpl->orchestraCellos.noteOn(note, level);
+        if (inRange(kBassRange, note)) pImpl->orchestraBasses.noteOn(note, level);
+        return;
+    }
+    if (StringModel* model = pImpl->model(instrument)) {
+        model->noteOn(note, level);
+    }
+}
+
+void StringInstruments::noteOff(Instrument instrument, int note) {
+    if (instrument == Instrument::StringOrchestra) {
+        pImpl->orchestraViolins.noteOff(note);
+        pImpl->orchestraViolas.noteOff(note);
+        pImpl->orchestraCellos.noteOff(note);
+        pImpl->orchestraBasses.noteOff(note);
+        return;
+    }
+    if (StringModel* model = pImpl->model(instrument)) {
+        model->noteOff(note);
+    }
+}
+
+void StringInstruments::allNotesOff() {
+    for (StringModel* model : {&pImpl->violinString, &pImpl->violaString, &pImpl->celloString,
+                               &pImpl->doubleBassString, &pImpl->guitarString, &pImpl->harpString,
+                               &pImpl->orchestraViolins, &pImpl->orchestraViolas,
+                               &pImpl->orchestraCellos, &pImpl->orchestraBasses}) {
+        model->allNotesOff();
+    }
+}
+
+// KI-Veredelung
+void StringInstruments::setNeuralEnhancement(bool enabled) {
+    if (enabled && !pImpl->modelsLoaded) {
+        pImpl->loadModels();
+    }
+    pImpl->neuralEnhancement = enabled && pImpl->modelsLoaded;
+}
+
+bool StringInstruments::isNeuralEnhancementEnabled() const {
+    return pImpl->neuralEnhancement;
+}
+
 // Violine
 void StringInstruments::setViolin(const Violin& params) {
     pImpl->violin = params;
+    Impl::applyBowed(pImpl->violinString, params);
 }
 
 void StringInstruments::processViolin(float* buffer, int numSamples) {
     if (!pImpl->violin.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->violinString, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->violinBuffer, pImpl->violinCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 7});
@@ -85,20 +237,8 @@ void StringInstruments::processViolin(float* buffer, int numSamples) {
         input[0][6] = pImpl->violin.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->violinModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->violinBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->violinCallback) {
-            pImpl->violinCallback(pImpl->violinBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->violinModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->violinBuffer, pImpl->violinCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Violine-Verarbeitung: {}", e.what());
     }
@@ -107,11 +247,18 @@ void StringInstruments::processViolin(float* buffer, int numSamples) {
 // Viola
 void StringInstruments::setViola(const Viola& params) {
     pImpl->viola = params;
+    Impl::applyBowed(pImpl->violaString, params);
 }
 
 void StringInstruments::processViola(float* buffer, int numSamples) {
     if (!pImpl->viola.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->violaString, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->violaBuffer, pImpl->violaCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 7});
@@ -124,20 +271,8 @@ void StringInstruments::processViola(float* buffer, int numSamples) {
         input[0][6] = pImpl->viola.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->violaModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->violaBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->violaCallback) {
-            pImpl->violaCallback(pImpl->violaBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->violaModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->violaBuffer, pImpl->violaCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Viola-Verarbeitung: {}", e.what());
     }
@@ -146,11 +281,18 @@ void StringInstruments::processViola(float* buffer, int numSamples) {
 // Cello
 void StringInstruments::setCello(const Cello& params) {
     pImpl->cello = params;
+    Impl::applyBowed(pImpl->celloString, params);
 }
 
 void StringInstruments::processCello(float* buffer, int numSamples) {
     if (!pImpl->cello.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->celloString, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->celloBuffer, pImpl->celloCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 7});
@@ -163,20 +305,8 @@ void StringInstruments::processCello(float* buffer, int numSamples) {
         input[0][6] = pImpl->cello.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->celloModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->celloBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->celloCallback) {
-            pImpl->celloCallback(pImpl->celloBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->celloModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->celloBuffer, pImpl->celloCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Cello-Verarbeitung: {}", e.what());
     }
@@ -185,11 +315,18 @@ void StringInstruments::processCello(float* buffer, int numSamples) {
 // Kontrabass
 void StringInstruments::setDoubleBass(const DoubleBass& params) {
     pImpl->doubleBass = params;
+    Impl::applyBowed(pImpl->doubleBassString, params);
 }
 
 void StringInstruments::processDoubleBass(float* buffer, int numSamples) {
     if (!pImpl->doubleBass.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->doubleBassString, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->doubleBassBuffer, pImpl->doubleBassCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 7});
@@ -202,20 +339,8 @@ void StringInstruments::processDoubleBass(float* buffer, int numSamples) {
         input[0][6] = pImpl->doubleBass.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->doubleBassModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->doubleBassBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->doubleBassCallback) {
-            pImpl->doubleBassCallback(pImpl->doubleBassBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->doubleBassModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->doubleBassBuffer, pImpl->doubleBassCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Kontrabass-Verarbeitung: {}", e.what());
     }
@@ -224,11 +349,22 @@ void StringInstruments::processDoubleBass(float* buffer, int numSamples) {
 // Streichorchester
 void StringInstruments::setStringOrchestra(const StringOrchestra& params) {
     pImpl->stringOrchestra = params;
+    pImpl->applyOrchestra();
 }
 
 void StringInstruments::processStringOrchestra(float* buffer, int numSamples) {
     if (!pImpl->stringOrchestra.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        std::fill(buffer, buffer + numSamples, 0.0f);
+        pImpl->orchestraViolins.process(buffer, numSamples);
+        pImpl->orchestraViolas.process(buffer, numSamples);
+        pImpl->orchestraCellos.process(buffer, numSamples);
+        pImpl->orchestraBasses.process(buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->stringOrchestraBuffer, pImpl->stringOrchestraCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 6});
@@ -240,25 +376,37 @@ void StringInstruments::processStringOrchestra(float* buffer, int numSamples) {
         input[0][5] = pImpl->stringOrchestra.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->stringOrchestraModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->stringOrchestraBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->stringOrchestraCallback) {
-            pImpl->stringOrchestraCallback(pImpl->stringOrchestraBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->stringOrchestraModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->stringOrchestraBuffer, pImpl->stringOrchestraCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Streichorchester-Verarbeitung: {}", e.what());
     }
 }
 
+// Gitarre
+void StringInstruments::setGuitar(const Guitar& params) {
+    pImpl->guitar = params;
+    Impl::applyPlucked(pImpl->guitarString, params);
+}
+
+void StringInstruments::processGuitar(float* buffer, int numSamples) {
+    if (!pImpl->guitar.enabled) return;
+    InstrumentRendering::renderNative(pImpl->guitarString, buffer, numSamples);
+    InstrumentRendering::publish(buffer, numSamples, pImpl->guitarBuffer, pImpl->guitarCallback);
+}
+
+// Harfe
+void StringInstruments::setHarp(const Harp& params) {
+    pImpl->harp = params;
+    Impl::applyPlucked(pImpl->harpString, params);
+}
+
+void StringInstruments::processHarp(float* buffer, int numSamples) {
+    if (!pImpl->harp.enabled) return;
+    InstrumentRendering::renderNative(pImpl->harpString, buffer, numSamples);
+    InstrumentRendering::publish(buffer, numSamples, pImpl->harpBuffer, pImpl->harpCallback);
+}
+
 // Callback-Setter
 void StringInstruments::setViolinCallback(std::function<void(const std::vector<float>&)> callback) {
     pImpl->violinCallback = callback;
@@ -280,4 +428,12 @@ void StringInstruments::setStringOrchestraCallback(std::function<void(const std:
     pImpl->stringOrchestraCallback = callback;
 }
 
-} // namespace VRMusicStudio 
\ No newline at end of file
+void StringInstruments::setGuitarCallback(std::function<void(const std::vector<float>&)> callback) {
+    pImpl->guitarCallback = callback;
+}
+
+void StringInstruments::setHarpCallback(std::function<void(const std::vector<float>&)> callback) {
+    pImpl->harpCallback = callback;
+}
+
+} // namespace VRMusicStudio
@@ -1,4 +1,6 @@
 #include "WindInstruments.hpp"
+#include "InstrumentRendering.hpp"
+#include "audio/processing/WindModel.hpp"
 #include <spdlog/spdlog.h>
 #include <algorithm>
 #include <cmath>
@@ -16,7 +18,17 @@ struct WindInstruments::Impl {
     Trombone trombone;
     Tuba tuba;
 
-    // KI-Modelle
+    // Native Waveguide-Modelle
+    WindModel fluteWaveguide{WindModel::flute()};
+    WindModel oboeWaveguide{WindModel::oboe()};
+    WindModel clarinetWaveguide{WindModel::clarinet()};
+    WindModel bassoonWaveguide{WindModel::bassoon()};
+    WindModel hornWaveguide{WindModel::horn()};
+    WindModel trumpetWaveguide{WindModel::trumpet()};
+    WindModel tromboneWaveguide{WindModel::trombone()};
+    WindModel tubaWaveguide{WindModel::tuba()};
+
+    // KI-Modelle (optional, werden erst bei Bedarf geladen)
     torch::jit::script::Module fluteModel;
     torch::jit::script::Module oboeModel;
     torch::jit::script::Module clarinetModel;
@@ -25,6 +37,8 @@ struct WindInstruments::Impl {
     torch::jit::script::Module trumpetModel;
     torch::jit::script::Module tromboneModel;
     torch::jit::script::Module tubaModel;
+    bool neuralEnhancement = false;
+    bool modelsLoaded = false;
 
     // Buffer
     std::vector<float> fluteBuffer;
@@ -47,6 +61,84 @@ struct WindInstruments::Impl {
     std::function<void(const std::vector<float>&)> tubaCallback;
 
     Impl() {
+        // Initialisiere Buffer
+        fluteBuffer.resize(1024);
+        oboeBuffer.resize(1024);
+        clarinetBuffer.resize(1024);
+        bassoonBuffer.resize(1024);
+        hornBuffer.resize(1024);
+        trumpetBuffer.resize(1024);
+        tromboneBuffer.resize(1024);
+        tubaBuffer.resize(1024);
+
+        // Initialisiere Parameter
+        flute = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+        oboe = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+        clarinet = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+        bassoon = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+        horn = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+        trumpet = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+        trombone = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+        tuba = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+
+        apply(fluteWaveguide, flute);
+        apply(oboeWaveguide, oboe);
+        apply(clarinetWaveguide, clarinet);
+        apply(bassoonWaveguide, bassoon);
+        apply(hornWaveguide, horn);
+        apply(trumpetWaveguide, trumpet);
+        apply(tromboneWaveguide, trombone);
+        apply(tubaWaveguide, tuba);
+    }
+
+    // Atemdruck 0 - 1 (0.5 = normal), Vibrato-Tiefe in Halbtönen
+    template <typename Params>
+    static void apply(WindModel& model, const Params& params) {
+        model.setBreath(2.0f * params.breathPressure);
+        model.setVibrato(params.vibratoDepth, params.vibratoRate);
+        model.setGain(params.volume);
+    }
+
+    // MIDI-Controller: 1 Modulation (Vibrato), 2 Breath Controller,
+    // 11 Expression, 68 Legato-Pedal
+    template <typename Params>
+    static void control(WindModel& model, Params& params, int controller, int value) {
+        const float level = std::clamp(value, 0, 127) / 127.0f;
+        switch (controller) {
+        case 1:
+            params.vibratoDepth = 0.5f * level;
+            model.setVibrato(params.vibratoDepth, params.vibratoRate);
+            break;
+        case 2:
+            params.breathPressure = level;
+            model.setBreath(2.0f * level);
+            break;
+        case 11:
+            model.setExpression(level);
+            break;
+        case 68:
+            model.setLegato(value >= 64);
+            break;
+        default:
+            break;
+        }
+    }
+
+    WindModel* model(Instrument instrument) {
+        switch (instrument) {
+        case Instrument::Flute: return &fluteWaveguide;
+        case Instrument::Oboe: return &oboeWaveguide;
+        case Instrument::Clarinet: return &clarinetWaveguide;
+        case Instrument::Bassoon: return &bassoonWaveguide;
+        case Instrument::Horn: return &hornWaveguide;
+        case Instrument::Trumpet: return &trumpetWaveguide;
+        case Instrument::Trombone: return &tromboneWaveguide;
+        case Instrument::Tuba: return &tubaWaveguide;
+        default: return nullptr;
+        }
+    }
+
+    void loadModels() {
         try {
             // Lade KI-Modelle
             fluteModel = torch::jit::load("models/flute.pt");
@@ -57,26 +149,7 @@ struct WindInstruments::Impl {
             trumpetModel = torch::jit::load("models/trumpet.pt");
             tromboneModel = torch::jit::load("models/trombone.pt");
             tubaModel = torch::jit::load("models/tuba.pt");
-
-            // Initialisiere Buffer
-            fluteBuffer.resize(1024);
-            oboeBuffer.resize(1024);
-            clarinetBuffer.resize(1024);
-            bassoonBuffer.resize(1024);
-            hornBuffer.resize(1024);
-            trumpetBuffer.resize(1024);
-            tromboneBuffer.resize(1024);
-            tubaBuffer.resize(1024);
-
-            // Initialisiere Parameter
-            flute = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
-            oboe = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
-            clarinet = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
-            bassoon = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
-            horn = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
-            trumpet = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
-            trombone = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
-            tuba = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+            modelsLoaded = true;
         } catch (const std::exception& e) {
             spdlog::error("Fehler beim Laden der Blasinstrumente-Modelle: {}", e.what());
         }
@@ -86,14 +159,65 @@ struct WindInstruments::Impl {
 WindInstruments::WindInstruments() : pImpl(std::make_unique<Impl>()) {}
 WindInstruments::~WindInstruments() = default;
 
+// Noten
+void WindInstruments::noteOn(Instrument instrument, int note, int velocity) {
+    if (WindModel* model = pImpl->model(instrument)) {
+        model->noteOn(note, std::clamp(velocity, 0, 127) / 127.0f);
+    }
+}
+
+void WindInstruments::noteOff(Instrument instrument, int note) {
+    if (WindModel* model = pImpl->model(instrument)) {
+        model->noteOff(note);
+    }
+}
+
+void WindInstruments::allNotesOff() {
+    for (WindModel* model : {&pImpl->fluteWaveguide, &pImpl->oboeWaveguide, &pImpl->clarinetWaveguide, &pImpl->bassoonWaveguide, &pImpl->hornWaveguide, &pImpl->trumpetWaveguide, &pImpl->tromboneWaveguide, &pImpl->tubaWaveguide}) {
+        model->allNotesOff();
+    }
+}
+
+void WindInstruments::controlChange(Instrument instrument, int controller, int value) {
+    switch (instrument) {
+    case Instrument::Flute: Impl::control(pImpl->fluteWaveguide, pImpl->flute, controller, value); break;
+    case Instrument::Oboe: Impl::control(pImpl->oboeWaveguide, pImpl->oboe, controller, value); break;
+    case Instrument::Clarinet: Impl::control(pImpl->clarinetWaveguide, pImpl->clarinet, controller, value); break;
+    case Instrument::Bassoon: Impl::control(pImpl->bassoonWaveguide, pImpl->bassoon, controller, value); break;
+    case Instrument::Horn: Impl::control(pImpl->hornWaveguide, pImpl->horn, controller, value); break;
+    case Instrument::Trumpet: Impl::control(pImpl->trumpetWaveguide, pImpl->trumpet, controller, value); break;
+    case Instrument::Trombone: Impl::control(pImpl->tromboneWaveguide, pImpl->trombone, controller, value); break;
+    case Instrument::Tuba: Impl::control(pImpl->tubaWaveguide, pImpl->tuba, controller, value); break;
+    }
+}
+
+// KI-Veredelung
+void WindInstruments::setNeuralEnhancement(bool enabled) {
+    if (enabled && !pImpl->modelsLoaded) {
+        pImpl->loadModels();
+    }
+    pImpl->neuralEnhancement = enabled && pImpl->modelsLoaded;
+}
+
+bool WindInstruments::isNeuralEnhancementEnabled() const {
+    return pImpl->neuralEnhancement;
+}
+
 // Flöte
 void WindInstruments::setFlute(const Flute& params) {
     pImpl->flute = params;
+    Impl::apply(pImpl->fluteWaveguide, params);
 }
 
 void WindInstruments::processFlute(float* buffer, int numSamples) {
     if (!pImpl->flute.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->fluteWaveguide, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->fluteBuffer, pImpl->fluteCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 6});
@@ -105,20 +229,8 @@ void WindInstruments::processFlute(float* buffer, int numSamples) {
         input[0][5] = pImpl->flute.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->fluteModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->fluteBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->fluteCallback) {
-            pImpl->fluteCallback(pImpl->fluteBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->fluteModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->fluteBuffer, pImpl->fluteCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Flöte-Verarbeitung: {}", e.what());
     }
@@ -127,11 +239,18 @@ void WindInstruments::processFlute(float* buffer, int numSamples) {
 // Oboe
 void WindInstruments::setOboe(const Oboe& params) {
     pImpl->oboe = params;
+    Impl::apply(pImpl->oboeWaveguide, params);
 }
 
 void WindInstruments::processOboe(float* buffer, int numSamples) {
     if (!pImpl->oboe.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->oboeWaveguide, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->oboeBuffer, pImpl->oboeCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 6});
@@ -143,20 +262,8 @@ void WindInstruments::processOboe(float* buffer, int numSamples) {
         input[0][5] = pImpl->oboe.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->oboeModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->oboeBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->oboeCallback) {
-            pImpl->oboeCallback(pImpl->oboeBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->oboeModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->oboeBuffer, pImpl->oboeCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Oboe-Verarbeitung: {}", e.what());
     }
@@ -165,11 +272,18 @@ void WindInstruments::processOboe(float* buffer, int numSamples) {
 // Klarinette
 void WindInstruments::setClarinet(const Clarinet& params) {
     pImpl->clarinet = params;
+    Impl::apply(pImpl->clarinetWaveguide, params);
 }
 
 void WindInstruments::processClarinet(float* buffer, int numSamples) {
     if (!pImpl->clarinet.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->clarinetWaveguide, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->clarinetBuffer, pImpl->clarinetCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 6});
@@ -181,20 +295,8 @@ void WindInstruments::processClarinet(float* buffer, int numSamples) {
         input[0][5] = pImpl->clarinet.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->clarinetModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->clarinetBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->clarinetCallback) {
-            pImpl->clarinetCallback(pImpl->clarinetBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->clarinetModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->clarinetBuffer, pImpl->clarinetCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Klarinette-Verarbeitung: {}", e.what());
     }
@@ -203,11 +305,18 @@ void WindInstruments::processClarinet(float* buffer, int numSamples) {
 // Fagott
 void WindInstruments::setBassoon(const Bassoon& params) {
     pImpl->bassoon = params;
+    Impl::apply(pImpl->bassoonWaveguide, params);
 }
 
 void WindInstruments::processBassoon(float* buffer, int numSamples) {
     if (!pImpl->bassoon.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->bassoonWaveguide, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->bassoonBuffer, pImpl->bassoonCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 6});
@@ -219,20 +328,8 @@ void WindInstruments::processBassoon(float* buffer, int numSamples) {
         input[0][5] = pImpl->bassoon.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->bassoonModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->bassoonBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->bassoonCallback) {
-            pImpl->bassoonCallback(pImpl->bassoonBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->bassoonModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->bassoonBuffer, pImpl->bassoonCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Fagott-Verarbeitung: {}", e.what());
     }
@@ -241,11 +338,18 @@ void WindInstruments::processBassoon(float* buffer, int numSamples) {
 // Horn
 void WindInstruments::setHorn(const Horn& params) {
     pImpl->horn = params;
+    Impl::apply(pImpl->hornWaveguide, params);
 }
 
 void WindInstruments::processHorn(float* buffer, int numSamples) {
     if (!pImpl->horn.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->hornWaveguide, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->hornBuffer, pImpl->hornCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 6});
@@ -257,20 +361,8 @@ void WindInstruments::processHorn(float* buffer, int numSamples) {
         input[0][5] = pImpl->horn.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->hornModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->hornBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->hornCallback) {
-            pImpl->hornCallback(pImpl->hornBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->hornModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->hornBuffer, pImpl->hornCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Horn-Verarbeitung: {}", e.what());
     }
@@ -279,11 +371,18 @@ void WindInstruments::processHorn(float* buffer, int numSamples) {
 // Trompete
 void WindInstruments::setTrumpet(const Trumpet& params) {
     pImpl->trumpet = params;
+    Impl::apply(pImpl->trumpetWaveguide, params);
 }
 
 void WindInstruments::processTrumpet(float* buffer, int numSamples) {
     if (!pImpl->trumpet.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->trumpetWaveguide, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->trumpetBuffer, pImpl->trumpetCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 6});
@@ -295,20 +394,8 @@ void WindInstruments::processTrumpet(float* buffer, int numSamples) {
         input[0][5] = pImpl->trumpet.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->trumpetModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->trumpetBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->trumpetCallback) {
-            pImpl->trumpetCallback(pImpl->trumpetBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->trumpetModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->trumpetBuffer, pImpl->trumpetCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Trompete-Verarbeitung: {}", e.what());
     }
@@ -317,11 +404,18 @@ void WindInstruments::processTrumpet(float* buffer, int numSamples) {
 // Posaune
 void WindInstruments::setTrombone(const Trombone& params) {
     pImpl->trombone = params;
+    Impl::apply(pImpl->tromboneWaveguide, params);
 }
 
 void WindInstruments::processTrombone(float* buffer, int numSamples) {
     if (!pImpl->trombone.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->tromboneWaveguide, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->tromboneBuffer, pImpl->tromboneCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 6});
@@ -333,20 +427,8 @@ void WindInstruments::processTrombone(float* buffer, int numSamples) {
         input[0][5] = pImpl->trombone.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->tromboneModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->tromboneBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->tromboneCallback) {
-            pImpl->tromboneCallback(pImpl->tromboneBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->tromboneModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->tromboneBuffer, pImpl->tromboneCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Posaune-Verarbeitung: {}", e.what());
     }
@@ -355,11 +437,18 @@ void WindInstruments::processTrombone(float* buffer, int numSamples) {
 // Tuba
 void WindInstruments::setTuba(const Tuba& params) {
     pImpl->tuba = params;
+    Impl::apply(pImpl->tubaWaveguide, params);
 }
 
 void WindInstruments::processTuba(float* buffer, int numSamples) {
     if (!pImpl->tuba.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->tubaWaveguide, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->tubaBuffer, pImpl->tubaCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 6});
@@ -371,20 +460,8 @@ void WindInstruments::processTuba(float* buffer, int numSamples) {
         input[0][5] = pImpl->tuba.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->tubaModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->tubaBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->tubaCallback) {
-            pImpl->tubaCallback(pImpl->tubaBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->tubaModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->tubaBuffer, pImpl->tubaCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Tuba-Verarbeitung: {}", e.what());
     }
@@ -1,4 +1,6 @@
 #include "WoodwindInstruments.hpp"
+#include "InstrumentRendering.hpp"
+#include "audio/processing/WindModel.hpp"
 #include <spdlog/spdlog.h>
 #include <algorithm>
 #include <cmath>
@@ -13,12 +15,21 @@ struct WoodwindInstruments::Impl {
     BassClarinet bassClarinet;
     EnglishHorn englishHorn;
 
-    // KI-Modelle
+    // Native Waveguide-Modelle
+    WindModel transverseFluteWaveguide{WindModel::flute()};
+    WindModel recorderWaveguide{WindModel::recorder()};
+    WindModel saxophoneWaveguide{WindModel::saxophone()};
+    WindModel bassClarinetWaveguide{WindModel::bassClarinet()};
+    WindModel englishHornWaveguide{WindModel::englishHorn()};
+
+    // KI-Modelle (optional, werden erst bei Bedarf geladen)
     torch::jit::script::Module transverseFluteModel;
     torch::jit::script::Module recorderModel;
     torch::jit::script::Module saxophoneModel;
     torch::jit::script::Module bassClarinetModel;
     torch::jit::script::Module englishHornModel;
+    bool neuralEnhancement = false;
+    bool modelsLoaded = false;
 
     // Buffer
     std::vector<float> transverseFluteBuffer;
@@ -35,6 +46,72 @@ struct WoodwindInstruments::Impl {
     std::function<void(const std::vector<float>&)> englishHornCallback;
 
     Impl() {
+        // Initialisiere Buffer
+        transverseFluteBuffer.resize(1024);
+        recorderBuffer.resize(1024);
+        saxophoneBuffer.resize(1024);
+        bassClarinetBuffer.resize(1024);
+        englishHornBuffer.resize(1024);
+
+        // Initialisiere Parameter
+        transverseFlute = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+        recorder = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+        saxophone = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+        bassClarinet = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+        englishHorn = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+
+        apply(transverseFluteWaveguide, transverseFlute);
+        apply(recorderWaveguide, recorder);
+        apply(saxophoneWaveguide, saxophone);
+        apply(bassClarinetWaveguide, bassClarinet);
+        apply(englishHornWaveguide, englishHorn);
+    }
+
+    // Atemdruck 0 - 1 (0.5 = normal), Vibrato-Tiefe in Halbtönen
+    template <typename Params>
+    static void apply(WindModel& model, const Params& params) {
+        model.setBreath(2.0f * params.breathPressure);
+        model.setVibrato(params.vibratoDepth, params.vibratoRate);
+        model.setGain(params.volume);
+    }
+
+    // MIDI-Controller: 1 Modulation (Vibrato), 2 Breath Controller,
+    // 11 Expression, 68 Legato-Pedal
+    template <typename Params>
+    static void control(WindModel& model, Params& params, int controller, int value) {
+        const float level = std::clamp(value, 0, 127) / 127.0f;
+        switch (controller) {
+        case 1:
+            params.vibratoDepth = 0.5f * level;
+            model.setVibrato(params.vibratoDepth, params.vibratoRate);
+            break;
+        case 2:
+            params.breathPressure = level;
+            model.setBreath(2.0f * level);
+            break;
+        case 11:
+            model.setExpression(level);
+            break;
+        case 68:
+            model.setLegato(value >= 64);
+            break;
+        default:
+            break;
+        }
+    }
+
+    WindModel* model(Instrument instrument) {
+        switch (instrument) {
+        case Instrument::TransverseFlute: return &transverseFluteWaveguide;
+        case Instrument::Recorder: return &recorderWaveguide;
+        case Instrument::Saxophone: return &saxophoneWaveguide;
+        case Instrument::BassClarinet: return &bassClarinetWaveguide;
+        case Instrument::EnglishHorn: return &englishHornWaveguide;
+        default: return nullptr;
+        }
+    }
+
+    void loadModels() {
         try {
             // Lade KI-Modelle
             transverseFluteModel = torch::jit::load("models/transverse_flute.pt");
@@ -42,20 +119,7 @@ struct WoodwindInstruments::Impl {
             saxophoneModel = torch::jit::load("models/saxophone.pt");
             bassClarinetModel = torch::jit::load("models/bass_clarinet.pt");
             englishHornModel = torch::jit::load("models/english_horn.pt");
-
-            // Initialisiere Buffer
-            transverseFluteBuffer.resize(1024);
-            recorderBuffer.resize(1024);
-            saxophoneBuffer.resize(1024);
-            bassClarinetBuffer.resize(1024);
-            englishHornBuffer.resize(1024);
-
-            // Initialisiere Parameter
-            transverseFlute = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
-            recorder = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
-            saxophone = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
-            bassClarinet = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
-            englishHorn = {0.5f, 0.2f, 5.0f, 1.0f, 0.3f, 0.2f, false};
+            modelsLoaded = true;
         } catch (const std::exception& e) {
             spdlog::error("Fehler beim Laden der Holzblasinstrumente-Modelle: {}", e.what());
         }
@@ -65,14 +129,62 @@ struct WoodwindInstruments::Impl {
 WoodwindInstruments::WoodwindInstruments() : pImpl(std::make_unique<Impl>()) {}
 WoodwindInstruments::~WoodwindInstruments() = default;
 
+// Noten
+void WoodwindInstruments::noteOn(Instrument instrument, int note, int velocity) {
+    if (WindModel* model = pImpl->model(instrument)) {
+        model->noteOn(note, std::clamp(velocity, 0, 127) / 127.0f);
+    }
+}
+
+void WoodwindInstruments::noteOff(Instrument instrument, int note) {
+    if (WindModel* model = pImpl->model(instrument)) {
+        model->noteOff(note);
+    }
+}
+
+void WoodwindInstruments::allNotesOff() {
+    for (WindModel* model : {&pImpl->transverseFluteWaveguide, &pImpl->recorderWaveguide, &pImpl->saxophoneWaveguide, &pImpl->bassClarinetWaveguide, &pImpl->englishHornWaveguide}) {
+        model->allNotesOff();
+    }
+}
+
+void WoodwindInstruments::controlChange(Instrument instrument, int controller, int value) {
+    switch (instrument) {
+    case Instrument::TransverseFlute: Impl::control(pImpl->transverseFluteWaveguide, pImpl->transverseFlute, controller, value); break;
+    case Instrument::Recorder: Impl::control(pImpl->recorderWaveguide, pImpl->recorder, controller, value); break;
+    case Instrument::Saxophone: Impl::control(pImpl->saxophoneWaveguide, pImpl->saxophone, controller, value); break;
+    case Instrument::BassClarinet: Impl::control(pImpl->bassClarinetWaveguide, pImpl->bassClarinet, controller, value); break;
+    case Instrument::EnglishHorn: Impl::control(pImpl->englishHornWaveguide, pImpl->englishHorn, controller, value); break;
+    }
+}
+
+// KI-Veredelung
+void WoodwindInstruments::setNeuralEnhancement(bool enabled) {
+    if (enabled && !pImpl->modelsLoaded) {
+        pImpl->loadModels();
+    }
+    pImpl->neuralEnhancement = enabled && pImpl->modelsLoaded;
+}
+
+bool WoodwindInstruments::isNeuralEnhancementEnabled() const {
+    return pImpl->neuralEnhancement;
+}
+
 // Querflöte
 void WoodwindInstruments::setTransverseFlute(const TransverseFlute& params) {
     pImpl->transverseFlute = params;
+    Impl::apply(pImpl->transverseFluteWaveguide, params);
 }
 
 void WoodwindInstruments::processTransverseFlute(float* buffer, int numSamples) {
     if (!pImpl->transverseFlute.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->transverseFluteWaveguide, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->transverseFluteBuffer, pImpl->transverseFluteCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 6});
@@ -84,20 +196,8 @@ void WoodwindInstruments::processTransverseFlute(float* buffer, int numSamples)
         input[0][5] = pImpl->transverseFlute.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->transverseFluteModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->transverseFluteBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->transverseFluteCallback) {
-            pImpl->transverseFluteCallback(pImpl->transverseFluteBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->transverseFluteModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->transverseFluteBuffer, pImpl->transverseFluteCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Querflöte-Verarbeitung: {}", e.what());
     }
@@ -106,11 +206,18 @@ void WoodwindInstruments::processTransverseFlute(float* buffer, int numSamples)
 // Blockflöte
 void WoodwindInstruments::setRecorder(const Recorder& params) {
     pImpl->recorder = params;
+    Impl::apply(pImpl->recorderWaveguide, params);
 }
 
 void WoodwindInstruments::processRecorder(float* buffer, int numSamples) {
     if (!pImpl->recorder.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->recorderWaveguide, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->recorderBuffer, pImpl->recorderCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 6});
@@ -122,20 +229,8 @@ void WoodwindInstruments::processRecorder(float* buffer, int numSamples) {
         input[0][5] = pImpl->recorder.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->recorderModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->recorderBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->recorderCallback) {
-            pImpl->recorderCallback(pImpl->recorderBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->recorderModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->recorderBuffer, pImpl->recorderCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Blockflöte-Verarbeitung: {}", e.what());
     }
@@ -144,11 +239,18 @@ void WoodwindInstruments::processRecorder(float* buffer, int numSamples) {
 // Saxophon
 void WoodwindInstruments::setSaxophone(const Saxophone& params) {
     pImpl->saxophone = params;
+    Impl::apply(pImpl->saxophoneWaveguide, params);
 }
 
 void WoodwindInstruments::processSaxophone(float* buffer, int numSamples) {
     if (!pImpl->saxophone.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->saxophoneWaveguide, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->saxophoneBuffer, pImpl->saxophoneCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 6});
@@ -160,20 +262,8 @@ void WoodwindInstruments::processSaxophone(float* buffer, int numSamples) {
         input[0][5] = pImpl->saxophone.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->saxophoneModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->saxophoneBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->saxophoneCallback) {
-            pImpl->saxophoneCallback(pImpl->saxophoneBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->saxophoneModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->saxophoneBuffer, pImpl->saxophoneCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Saxophon-Verarbeitung: {}", e.what());
     }
@@ -182,11 +272,18 @@ void WoodwindInstruments::processSaxophone(float* buffer, int numSamples) {
 // Bassklarinette
 void WoodwindInstruments::setBassClarinet(const BassClarinet& params) {
     pImpl->bassClarinet = params;
+    Impl::apply(pImpl->bassClarinetWaveguide, params);
 }
 
 void WoodwindInstruments::processBassClarinet(float* buffer, int numSamples) {
     if (!pImpl->bassClarinet.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->bassClarinetWaveguide, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->bassClarinetBuffer, pImpl->bassClarinetCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 6});
@@ -198,20 +295,8 @@ void WoodwindInstruments::processBassClarinet(float* buffer, int numSamples) {
         input[0][5] = pImpl->bassClarinet.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->bassClarinetModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->bassClarinetBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->bassClarinetCallback) {
-            pImpl->bassClarinetCallback(pImpl->bassClarinetBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->bassClarinetModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->bassClarinetBuffer, pImpl->bassClarinetCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Bassklarinette-Verarbeitung: {}", e.what());
     }
@@ -220,11 +305,18 @@ void WoodwindInstruments::processBassClarinet(float* buffer, int numSamples) {
 // Englischhorn
 void WoodwindInstruments::setEnglishHorn(const EnglishHorn& params) {
     pImpl->englishHorn = params;
+    Impl::apply(pImpl->englishHornWaveguide, params);
 }
 
 void WoodwindInstruments::processEnglishHorn(float* buffer, int numSamples) {
     if (!pImpl->englishHorn.enabled) return;
 
+    if (!pImpl->neuralEnhancement) {
+        InstrumentRendering::renderNative(pImpl->englishHornWaveguide, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->englishHornBuffer, pImpl->englishHornCallback);
+        return;
+    }
+
     try {
         // Erstelle Input-Tensor
         auto input = torch::zeros({1, 6});
@@ -236,20 +328,8 @@ void WoodwindInstruments::processEnglishHorn(float* buffer, int numSamples) {
         input[0][5] = pImpl->englishHorn.delay;
 
         // Führe KI-Modell aus
-        auto output = pImpl->englishHornModel.forward({input}).toTensor();
-
-        // Verarbeite Output
-        for (int i = 0; i < numSamples; ++i) {
-            buffer[i] = output[0][i].item<float>();
-        }
-
-        // Aktualisiere Buffer
-        std::copy(buffer, buffer + numSamples, pImpl->englishHornBuffer.begin());
-
-        // Rufe Callback auf
-        if (pImpl->englishHornCallback) {
-            pImpl->englishHornCallback(pImpl->englishHornBuffer);
-        }
+        InstrumentRendering::renderNeural(pImpl->englishHornModel, input, buffer, numSamples);
+        InstrumentRendering::publish(buffer, numSamples, pImpl->englishHornBuffer, pImpl->englishHornCallback);
     } catch (const std::exception& e) {
         spdlog::error("Fehler bei der Englischhorn-Verarbeitung: {}", e.what());
     }
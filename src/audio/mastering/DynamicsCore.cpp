@@ -0,0 +1,84 @@
+#include "DynamicsCore.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace VR_DAW {
+
+namespace {
+
+constexpr float kMinLevelDb = -120.0f;
+constexpr float kMaxExpansionDb = -80.0f;
+
+} // namespace
+
+DynamicsCore::DynamicsCore()
+    : sampleRate(44100.0)
+    , numBands(1) {
+    prepare(sampleRate, numBands);
+}
+
+void DynamicsCore::prepare(double newSampleRate, int newNumBands) {
+    sampleRate = newSampleRate;
+    numBands = std::clamp(newNumBands, 1, kMaxBands);
+    for (auto& band : bands) {
+        updateCoefficients(band);
+    }
+    reset();
+}
+
+void DynamicsCore::reset() {
+    for (auto& band : bands) {
+        band.gainReduction = 0.0f;
+    }
+}
+
+void DynamicsCore::setBand(int band, const Settings& settings) {
+    if (band < 0 || band >= kMaxBands) return;
+    bands[band].settings = settings;
+    updateCoefficients(bands[band]);
+}
+
+float DynamicsCore::process(int index, float peak) {
+    Band& band = bands[index];
+    const float levelDb = peak > 1.0e-6f ? 20.0f * std::log10(peak) : kMinLevelDb;
+    const float target = computeGain(band.settings, levelDb);
+
+    // Attack bei zunehmender, Release bei abnehmender Gain-Reduktion
+    const float coefficient = target < band.gainReduction ? band.attackCoefficient : band.releaseCoefficient;
+    band.gainReduction = target + (band.gainReduction - target) * coefficient;
+
+    return std::pow(10.0f, (band.gainReduction + band.settings.makeup) / 20.0f);
+}
+
+float DynamicsCore::computeGain(const Settings& settings, float levelDb) {
+    float gain = 0.0f;
+
+    // Kompressor mit quadratischem Soft-Knee
+    const float slope = 1.0f / std::max(settings.ratio, 1.0f) - 1.0f;
+    const float overshoot = levelDb - settings.threshold;
+    const float halfKnee = settings.knee * 0.5f;
+    if (overshoot >= halfKnee) {
+        gain = slope * overshoot;
+    } else if (overshoot > -halfKnee) {
+        const float x = overshoot + halfKnee;
+        gain = slope * x * x / (2.0f * settings.knee);
+    }
+
+    // Abwärts-Expander unterhalb der Expander-Schwelle
+    if (settings.expanderRatio > 1.0f && levelDb < settings.expanderThreshold) {
+        gain += std::max((settings.expanderRatio - 1.0f) * (levelDb - settings.expanderThreshold), kMaxExpansionDb);
+    }
+    return gain;
+}
+
+void DynamicsCore::updateCoefficients(Band& band) {
+    const double blockRate = sampleRate / static_cast<double>(kControlBlock);
+    auto coefficient = [blockRate](float milliseconds) {
+        const double blocks = std::max(static_cast<double>(milliseconds), 0.01) * 0.001 * blockRate;
+        return static_cast<float>(std::exp(-1.0 / blocks));
+    };
+    band.attackCoefficient = coefficient(band.settings.attack);
+    band.releaseCoefficient = coefficient(band.settings.release);
+}
+
+} // namespace VR_DAW
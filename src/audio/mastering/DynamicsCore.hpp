@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+
+namespace VR_DAW {
+
+// Blockbasierter Kompressor/Expander, gemeinsam genutzt von Single- und
+// Multiband-Dynamics.
+//
+// Der Regelkreis läuft mit Kontrollrate: pro kControlBlock Samples kommt ein
+// Spitzenpegel je Band herein, der Gain-Computer (Soft-Knee-Kompressor plus
+// Abwärts-Expander) und die Attack/Release-Glättung arbeiten im dB-Bereich,
+// heraus kommt der lineare Ziel-Gain. Der Aufrufer interpoliert den Gain
+// innerhalb des Blocks linear. log/exp fallen so nur einmal pro Band und
+// Kontrollblock an statt pro Sample.
+class DynamicsCore {
+public:
+    static constexpr int kMaxBands = 8;
+    static constexpr size_t kControlBlock = 32;
+
+    struct Settings {
+        float threshold = -12.0f;           // dBFS
+        float ratio = 2.0f;
+        float knee = 6.0f;                  // dB
+        float expanderThreshold = -90.0f;   // dBFS
+        float expanderRatio = 1.0f;         // 1 = aus
+        float attack = 10.0f;               // ms
+        float release = 100.0f;             // ms
+        float makeup = 0.0f;                // dB
+    };
+
+    DynamicsCore();
+
+    void prepare(double sampleRate, int numBands);
+    void reset();
+
+    void setBand(int band, const Settings& settings);
+    const Settings& getBand(int band) const { return bands[band].settings; }
+    int getNumBands() const { return numBands; }
+
+    // Spitzenpegel (linear) eines Kontrollblocks -> linearer Gain inkl. Make-up
+    float process(int band, float peak);
+
+    float getGainReductionDb(int band) const { return bands[band].gainReduction; }
+
+    // Statische Kennlinie in dB (<= 0), ohne Make-up
+    static float computeGain(const Settings& settings, float levelDb);
+
+private:
+    struct Band {
+        Settings settings;
+        float attackCoefficient = 0.0f;
+        float releaseCoefficient = 0.0f;
+        float gainReduction = 0.0f;         // geglättet, dB
+    };
+
+    void updateCoefficients(Band& band);
+
+    double sampleRate;
+    int numBands;
+    Band bands[kMaxBands];
+};
+
+} // namespace VR_DAW
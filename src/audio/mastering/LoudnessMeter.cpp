@@ -0,0 +1,283 @@
+#include "LoudnessMeter.hpp"
+#include "audio/processing/DspMath.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace VR_DAW {
+
+namespace {
+
+using VRMusicStudio::kPi;
+
+constexpr float kSilence = -144.0f;
+
+// Analoge Prototypen der K-Gewichtung aus BS.1770, per bilinearer
+// Transformation auf die aktuelle Abtastrate gebracht
+constexpr double kShelfFrequency = 1681.974450955533;
+constexpr double kShelfGainDb = 3.999843853973347;
+constexpr double kShelfQ = 0.7071752369554196;
+constexpr double kHighpassFrequency = 38.13547087602444;
+constexpr double kHighpassQ = 0.5003270373238773;
+
+} // namespace
+
+LoudnessMeter::LoudnessMeter()
+    : sampleRate(48000.0)
+    , numChannels(2)
+    , blockLength(4800)
+    , blockFill(0)
+    , blockSum(0.0)
+    , blockPowers{}
+    , blockPos(0)
+    , blocksSeen(0)
+    , momentary(kSilence)
+    , shortTerm(kSilence)
+    , maxMomentary(kSilence)
+    , maxShortTerm(kSilence)
+    , truePeak(0.0f) {
+    prepare(sampleRate, numChannels);
+}
+
+void LoudnessMeter::prepare(double newSampleRate, int newNumChannels) {
+    sampleRate = newSampleRate;
+    numChannels = std::max(newNumChannels, 1);
+    blockLength = std::max<size_t>(static_cast<size_t>(std::lround(sampleRate * 0.1)), 1);
+
+    // Stufe 1: High-Shelf (Kopfeffekt)
+    {
+        const double k = std::tan(kPi * kShelfFrequency / sampleRate);
+        const double vh = std::pow(10.0, kShelfGainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / kShelfQ + k * k;
+        shelf.b0 = (vh + vb * k / kShelfQ + k * k) / a0;
+        shelf.b1 = 2.0 * (k * k - vh) / a0;
+        shelf.b2 = (vh - vb * k / kShelfQ + k * k) / a0;
+        shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+        shelf.a2 = (1.0 - k / kShelfQ + k * k) / a0;
+    }
+
+    // Stufe 2: RLB-Hochpass
+    {
+        const double k = std::tan(kPi * kHighpassFrequency / sampleRate);
+        const double a0 = 1.0 + k / kHighpassQ + k * k;
+        highpass.b0 = 1.0;
+        highpass.b1 = -2.0;
+        highpass.b2 = 1.0;
+        highpass.a1 = 2.0 * (k * k - 1.0) / a0;
+        highpass.a2 = (1.0 - k / kHighpassQ + k * k) / a0;
+    }
+
+    channels.assign(numChannels, Channel());
+    if (numChannels == 6) {
+        channels[3].weight = 0.0f;
+        channels[4].weight = 1.41f;
+        channels[5].weight = 1.41f;
+    }
+
+    reset();
+}
+
+void LoudnessMeter::reset() {
+    for (auto& channel : channels) {
+        std::fill(std::begin(channel.z), std::end(channel.z), 0.0);
+        std::fill(std::begin(channel.history), std::end(channel.history), 0.0f);
+        channel.historyPos = 0;
+    }
+    blockFill = 0;
+    blockSum = 0.0;
+    std::fill(std::begin(blockPowers), std::end(blockPowers), 0.0);
+    blockPos = 0;
+    blocksSeen = 0;
+    momentaryHistogram.clear();
+    shortTermHistogram.clear();
+    momentary = kSilence;
+    shortTerm = kSilence;
+    maxMomentary = kSilence;
+    maxShortTerm = kSilence;
+    truePeak = 0.0f;
+}
+
+void LoudnessMeter::setChannelWeight(int channel, float weight) {
+    if (channel >= 0 && channel < numChannels) {
+        channels[channel].weight = weight;
+    }
+}
+
+void LoudnessMeter::process(const float* interleaved, size_t numFrames) {
+    constexpr int taps = TruePeakLimiter::kTapsPerPhase;
+
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        const float* input = interleaved + frame * numChannels;
+        double frameSum = 0.0;
+
+        for (int ch = 0; ch < numChannels; ++ch) {
+            Channel& channel = channels[ch];
+            const double x = input[ch];
+
+            // K-Gewichtung, zwei Biquads in Transposed Direct Form II
+            const double y1 = shelf.b0 * x + channel.z[0];
+            channel.z[0] = shelf.b1 * x - shelf.a1 * y1 + channel.z[1];
+            channel.z[1] = shelf.b2 * x - shelf.a2 * y1;
+            const double y2 = highpass.b0 * y1 + channel.z[2];
+            channel.z[2] = highpass.b1 * y1 - highpass.a1 * y2 + channel.z[3];
+            channel.z[3] = highpass.b2 * y1 - highpass.a2 * y2;
+            frameSum += channel.weight * y2 * y2;
+
+            // True-Peak über die doppelt geschriebene Filterhistorie
+            channel.history[channel.historyPos] = input[ch];
+            channel.history[channel.historyPos + taps] = input[ch];
+            channel.historyPos = (channel.historyPos + 1) % taps;
+            truePeak = std::max(truePeak, TruePeakLimiter::interpolatedPeak(channel.history + channel.historyPos));
+        }
+
+        blockSum += frameSum;
+        if (++blockFill == blockLength) {
+            finishBlock();
+        }
+    }
+}
+
+void LoudnessMeter::finishBlock() {
+    blockPowers[blockPos] = blockSum / static_cast<double>(blockLength);
+    blockPos = (blockPos + 1) % kShortTermBlocks;
+    blocksSeen = std::min(blocksSeen + 1, kShortTermBlocks);
+    blockSum = 0.0;
+    blockFill = 0;
+
+    auto windowPower = [this](int blocks) {
+        double sum = 0.0;
+        for (int i = 1; i <= blocks; ++i) {
+            sum += blockPowers[(blockPos - i + kShortTermBlocks) % kShortTermBlocks];
+        }
+        return sum / blocks;
+    };
+
+    // Gating-Block: 400 ms, alle 100 ms (75 % Überlappung)
+    if (blocksSeen >= kMomentaryBlocks) {
+        const double power = windowPower(kMomentaryBlocks);
+        momentary = powerToLoudness(power);
+        maxMomentary = std::max(maxMomentary, momentary);
+        momentaryHistogram.add(power);
+    }
+
+    // Short-Term-Werte mit 10 Hz für die Loudness Range (Tech 3342)
+    if (blocksSeen >= kShortTermBlocks) {
+        const double power = windowPower(kShortTermBlocks);
+        shortTerm = powerToLoudness(power);
+        maxShortTerm = std::max(maxShortTerm, shortTerm);
+        shortTermHistogram.add(power);
+    }
+}
+
+float LoudnessMeter::getMomentaryLoudness() const {
+    return momentary;
+}
+
+float LoudnessMeter::getShortTermLoudness() const {
+    return shortTerm;
+}
+
+float LoudnessMeter::getIntegratedLoudness() const {
+    // Absolutes Gate steckt in der Histogramm-Untergrenze
+    uint64_t count = 0;
+    const float ungated = momentaryHistogram.gatedMean(kAbsoluteGate, &count);
+    if (count == 0) return kSilence;
+
+    const float integrated = momentaryHistogram.gatedMean(ungated + kRelativeGate, &count);
+    return count > 0 ? integrated : kSilence;
+}
+
+float LoudnessMeter::getLoudnessRange() const {
+    uint64_t count = 0;
+    const float ungated = shortTermHistogram.gatedMean(kAbsoluteGate, &count);
+    if (count == 0) return 0.0f;
+
+    const int firstBin = std::max(histogramBin(ungated + kRangeRelativeGate), 0);
+    uint64_t total = 0;
+    for (int bin = firstBin; bin < kHistogramBins; ++bin) {
+        total += shortTermHistogram.counts[bin];
+    }
+    if (total == 0) return 0.0f;
+
+    // 10. und 95. Perzentil der verbleibenden Short-Term-Werte
+    const uint64_t lowIndex = static_cast<uint64_t>(std::round((total - 1) * 0.10));
+    const uint64_t highIndex = static_cast<uint64_t>(std::round((total - 1) * 0.95));
+    float low = 0.0f;
+    float high = 0.0f;
+    bool lowFound = false;
+    uint64_t seen = 0;
+    for (int bin = firstBin; bin < kHistogramBins; ++bin) {
+        seen += shortTermHistogram.counts[bin];
+        const float loudness = kHistogramMin + (bin + 0.5f) * kHistogramStep;
+        if (!lowFound && seen > lowIndex) {
+            low = loudness;
+            lowFound = true;
+        }
+        if (seen > highIndex) {
+            high = loudness;
+            break;
+        }
+    }
+    return high - low;
+}
+
+float LoudnessMeter::getTruePeakDb() const {
+    return truePeak > 0.0f ? 20.0f * std::log10(truePeak) : kSilence;
+}
+
+LoudnessMeter::Measurement LoudnessMeter::getMeasurement() const {
+    Measurement measurement;
+    measurement.integrated = getIntegratedLoudness();
+    measurement.range = getLoudnessRange();
+    measurement.truePeak = getTruePeakDb();
+    measurement.maxMomentary = maxMomentary;
+    measurement.maxShortTerm = maxShortTerm;
+    return measurement;
+}
+
+LoudnessMeter::Measurement LoudnessMeter::analyze(const float* interleaved, size_t numFrames, int numChannels, double sampleRate) {
+    LoudnessMeter meter;
+    meter.prepare(sampleRate, numChannels);
+    meter.process(interleaved, numFrames);
+    return meter.getMeasurement();
+}
+
+float LoudnessMeter::powerToLoudness(double power) {
+    return power > 0.0 ? static_cast<float>(-0.691 + 10.0 * std::log10(power)) : kSilence;
+}
+
+double LoudnessMeter::loudnessToPower(float loudness) {
+    return std::pow(10.0, (loudness + 0.691) / 10.0);
+}
+
+int LoudnessMeter::histogramBin(float loudness) {
+    if (loudness < kHistogramMin) return -1;
+    const int bin = static_cast<int>((loudness - kHistogramMin) / kHistogramStep);
+    return std::min(bin, kHistogramBins - 1);
+}
+
+void LoudnessMeter::Histogram::add(double power) {
+    const int bin = histogramBin(powerToLoudness(power));
+    if (bin < 0) return;
+    ++counts[bin];
+    powers[bin] += power;
+}
+
+void LoudnessMeter::Histogram::clear() {
+    counts.assign(kHistogramBins, 0);
+    powers.assign(kHistogramBins, 0.0);
+}
+
+float LoudnessMeter::Histogram::gatedMean(float gate, uint64_t* count) const {
+    const int firstBin = std::max(histogramBin(gate), 0);
+    double powerSum = 0.0;
+    uint64_t blocks = 0;
+    for (int bin = firstBin; bin < kHistogramBins; ++bin) {
+        powerSum += powers[bin];
+        blocks += counts[bin];
+    }
+    *count = blocks;
+    return blocks > 0 ? powerToLoudness(powerSum / blocks) : kSilence;
+}
+
+} // namespace VR_DAW
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "TruePeakLimiter.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace VR_DAW {
+
+// Lautheitsmessung nach ITU-R BS.1770-4 / EBU R128 (Tech 3341, 3342).
+//
+// Das Signal wird K-gewichtet (High-Shelf + RLB-Hochpass, Koeffizienten für
+// beliebige Abtastraten), pro Kanal gewichtet und in 100-ms-Teilblöcken
+// aufsummiert. Daraus ergeben sich Momentary (400 ms) und Short-Term (3 s)
+// als gleitende Summen. Jeder 400-ms-Block (75 % Überlappung) und jeder
+// Short-Term-Wert landet in einem Histogramm mit 0,1-LU-Auflösung, sodass
+// Integrated Loudness und Loudness Range mit beiden Gates jederzeit in
+// konstanter Zeit ausgewertet werden können, ohne die Blockhistorie zu
+// speichern. Der True-Peak nutzt den Interpolator des TruePeakLimiters.
+//
+// process() ist nach prepare() echtzeitfähig; analyze() misst einen
+// kompletten Puffer offline (Stems, Export).
+class LoudnessMeter {
+public:
+    static constexpr float kAbsoluteGate = -70.0f;         // LUFS
+    static constexpr float kRelativeGate = -10.0f;         // LU, Integrated
+    static constexpr float kRangeRelativeGate = -20.0f;    // LU, Loudness Range
+    static constexpr float kHistogramMin = -70.0f;
+    static constexpr float kHistogramMax = 30.0f;
+    static constexpr float kHistogramStep = 0.1f;
+    static constexpr int kHistogramBins = 1000;
+    static constexpr int kMomentaryBlocks = 4;             // 4 x 100 ms
+    static constexpr int kShortTermBlocks = 30;            // 30 x 100 ms
+
+    struct Measurement {
+        float integrated = -144.0f;      // LUFS
+        float range = 0.0f;              // LU
+        float truePeak = -144.0f;        // dBTP
+        float maxMomentary = -144.0f;    // LUFS
+        float maxShortTerm = -144.0f;    // LUFS
+    };
+
+    LoudnessMeter();
+
+    void prepare(double sampleRate, int numChannels);
+    void reset();
+
+    // Standard: L/R/C = 1,0, bei 5.1 (L R C LFE Ls Rs) LFE = 0 und Surround = 1,41
+    void setChannelWeight(int channel, float weight);
+
+    void process(const float* interleaved, size_t numFrames);
+
+    float getMomentaryLoudness() const;
+    float getShortTermLoudness() const;
+    float getIntegratedLoudness() const;
+    float getLoudnessRange() const;
+    float getTruePeakDb() const;
+    float getMaxMomentaryLoudness() const { return maxMomentary; }
+    float getMaxShortTermLoudness() const { return maxShortTerm; }
+    Measurement getMeasurement() const;
+
+    static Measurement analyze(const float* interleaved, size_t numFrames, int numChannels, double sampleRate);
+
+    static float powerToLoudness(double power);
+    static double loudnessToPower(float loudness);
+
+private:
+    struct Biquad {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+    };
+
+    struct Channel {
+        float weight = 1.0f;
+        double z[4] = {};                // Zustände beider Stufen (Transposed DF II)
+        float history[2 * TruePeakLimiter::kTapsPerPhase] = {};
+        int historyPos = 0;
+    };
+
+    // Anzahl und Leistungssumme pro 0,1-LU-Bin; die Summen machen die
+    // gegatete Mittelung exakt, die Anzahlen liefern die Perzentile
+    struct Histogram {
+        std::vector<uint32_t> counts;
+        std::vector<double> powers;
+        void add(double power);
+        void clear();
+        float gatedMean(float gate, uint64_t* count) const;
+    };
+
+    void finishBlock();
+    static int histogramBin(float loudness);
+
+    double sampleRate;
+    int numChannels;
+    Biquad shelf;
+    Biquad highpass;
+    std::vector<Channel> channels;
+
+    // Teilblöcke zu 100 ms
+    size_t blockLength;
+    size_t blockFill;
+    double blockSum;
+    double blockPowers[kShortTermBlocks];
+    int blockPos;
+    int blocksSeen;
+
+    // Histogramme der Gating-Blöcke (Integrated) und Short-Term-Werte (LRA)
+    Histogram momentaryHistogram;
+    Histogram shortTermHistogram;
+
+    float momentary;
+    float shortTerm;
+    float maxMomentary;
+    float maxShortTerm;
+    float truePeak;
+};
+
+} // namespace VR_DAW
@@ -1,4 +1,6 @@
 #include "MasteringEngine.hpp"
+#include "audio/processing/DspMath.hpp"
+#include "audio/processing/SimdOps.hpp"
 #include <stdexcept>
 #include <algorithm>
 #include <cmath>
@@ -8,6 +10,13 @@
 namespace VR_DAW {
 
 MasteringEngine::MasteringEngine() {
+    // Platz für mehrere Updates jedes Bandes zwischen zwei Puffern
+    state.eqUpdates.reset(4 * kMaxEQBands);
+    state.stageOrderUpdates.reset(4);
+    parameters.stageOrder.stages = {Stage::Loudness, Stage::Stereo, Stage::Dynamics, Stage::EQ, Stage::Limiter};
+    parameters.stageOrder.count = kNumStages;
+    state.stageOrder = parameters.stageOrder;
+    parameters.eqBands.fill(std::make_tuple(1000.0f, 0.0f, 0.7071f));
     initializeComponents();
 }
 
@@ -45,15 +54,7 @@ void MasteringEngine::update() {
 
 void MasteringEngine::shutdown() {
     try {
-        audioEngine.reset();
-        mixingEngine.reset();
-        state.inputBuffer.clear();
-        state.outputBuffer.clear();
-        state.loudnessBuffer.clear();
-        state.stereoBuffer.clear();
-        state.dynamicsBuffer.clear();
-        state.eqBuffer.clear();
-        state.limiterBuffer.clear();
+        initialized = false;
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -62,17 +63,35 @@ void MasteringEngine::shutdown() {
 
 void MasteringEngine::processMastering(const std::vector<float>& inputBuffer, std::vector<float>& outputBuffer) {
     try {
-        if (!validateBuffer(inputBuffer)) {
+        if (&outputBuffer != &inputBuffer) {
+            outputBuffer = inputBuffer;
+        }
+        processMastering(outputBuffer.data(), outputBuffer.size() / 2);
+    } catch (const std::exception& e) {
+        handleErrors();
+        throw;
+    }
+}
+
+void MasteringEngine::processMastering(float* interleaved, size_t numFrames) {
+    try {
+        if (parameters.validateInput && !VRMusicStudio::SimdOps::allFinite(interleaved, numFrames * 2)) {
             throw std::runtime_error("Invalid mastering buffer");
         }
 
-        // Verarbeite Mastering
-        state.inputBuffer = inputBuffer;
-        processLoudness(state.inputBuffer, state.loudnessBuffer);
-        processStereo(state.loudnessBuffer, state.stereoBuffer);
-        processDynamics(state.stereoBuffer, state.dynamicsBuffer);
-        processEQ(state.dynamicsBuffer, state.eqBuffer);
-        outputBuffer = state.eqBuffer;
+        // Neue Reihenfolge vom Steuer-Thread übernehmen, die letzte gilt
+        StageOrder order;
+        while (state.stageOrderUpdates.pop(order)) {
+            state.stageOrder = order;
+        }
+
+        // Alle Stufen in-place auf demselben Puffer
+        for (int i = 0; i < state.stageOrder.count; ++i) {
+            runStage(state.stageOrder.stages[i], interleaved, numFrames);
+        }
+
+        outputMeter.process(interleaved, numFrames);
+        analysis.loudness = outputMeter.getIntegratedLoudness();
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -84,14 +103,10 @@ void MasteringEngine::processLoudness(const std::vector<float>& inputBuffer, std
         if (!validateBuffer(inputBuffer)) {
             throw std::runtime_error("Invalid loudness buffer");
         }
-
-        // Verarbeite Loudness
-        outputBuffer = inputBuffer;
-        float currentLoudness = calculateLoudness(outputBuffer);
-        float gain = std::pow(10.0f, (parameters.loudnessTarget - currentLoudness) / 20.0f);
-        for (float& sample : outputBuffer) {
-            sample *= gain;
+        if (&outputBuffer != &inputBuffer) {
+            outputBuffer = inputBuffer;
         }
+        applyLoudness(outputBuffer.data(), outputBuffer.size() / 2);
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -103,16 +118,10 @@ void MasteringEngine::processStereo(const std::vector<float>& inputBuffer, std::
         if (!validateBuffer(inputBuffer)) {
             throw std::runtime_error("Invalid stereo buffer");
         }
-
-        // Verarbeite Stereo
-        outputBuffer = inputBuffer;
-        for (size_t i = 0; i < outputBuffer.size(); i += 2) {
-            float mid = (outputBuffer[i] + outputBuffer[i + 1]) * 0.5f;
-            float side = (outputBuffer[i] - outputBuffer[i + 1]) * 0.5f;
-            side *= parameters.stereoWidth;
-            outputBuffer[i] = mid + side;
-            outputBuffer[i + 1] = mid - side;
+        if (&outputBuffer != &inputBuffer) {
+            outputBuffer = inputBuffer;
         }
+        applyStereo(outputBuffer.data(), outputBuffer.size() / 2);
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -124,22 +133,10 @@ void MasteringEngine::processDynamics(const std::vector<float>& inputBuffer, std
         if (!validateBuffer(inputBuffer)) {
             throw std::runtime_error("Invalid dynamics buffer");
         }
-
-        // Verarbeite Dynamics
-        outputBuffer = inputBuffer;
-        float envelope = 0.0f;
-        for (float& sample : outputBuffer) {
-            float level = std::abs(sample);
-            if (level > envelope) {
-                envelope = level + (envelope - level) * std::exp(-1.0f / (parameters.compressionAttack * 44100.0f));
-            } else {
-                envelope = level + (envelope - level) * std::exp(-1.0f / (parameters.compressionRelease * 44100.0f));
-            }
-            if (envelope > parameters.compressionThreshold) {
-                float gain = std::pow(10.0f, (parameters.compressionThreshold - envelope) * (1.0f - 1.0f / parameters.compressionRatio) / 20.0f);
-                sample *= gain;
-            }
+        if (&outputBuffer != &inputBuffer) {
+            outputBuffer = inputBuffer;
         }
+        applyDynamics(outputBuffer.data(), outputBuffer.size() / 2);
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -151,28 +148,122 @@ void MasteringEngine::processEQ(const std::vector<float>& inputBuffer, std::vect
         if (!validateBuffer(inputBuffer)) {
             throw std::runtime_error("Invalid EQ buffer");
         }
+        if (&outputBuffer != &inputBuffer) {
+            outputBuffer = inputBuffer;
+        }
+        applyEQ(outputBuffer.data(), outputBuffer.size() / 2);
+    } catch (const std::exception& e) {
+        handleErrors();
+        throw;
+    }
+}
 
-        // Verarbeite EQ
-        outputBuffer = inputBuffer;
-        for (const auto& [frequency, gain, q] : parameters.eqBands) {
-            float w0 = 2.0f * M_PI * frequency / 44100.0f;
-            float alpha = std::sin(w0) / (2.0f * q);
-            float a0 = 1.0f + alpha;
-            float a1 = -2.0f * std::cos(w0);
-            float a2 = 1.0f - alpha;
-            float b0 = 1.0f + alpha * gain;
-            float b1 = a1;
-            float b2 = 1.0f - alpha * gain;
-            for (size_t i = 2; i < outputBuffer.size(); ++i) {
-                outputBuffer[i] = (b0 * inputBuffer[i] + b1 * inputBuffer[i - 1] + b2 * inputBuffer[i - 2] - a1 * outputBuffer[i - 1] - a2 * outputBuffer[i - 2]) / a0;
-            }
+void MasteringEngine::processLimiting(const std::vector<float>& inputBuffer, std::vector<float>& outputBuffer) {
+    try {
+        if (!validateBuffer(inputBuffer)) {
+            throw std::runtime_error("Invalid limiter buffer");
+        }
+        if (&outputBuffer != &inputBuffer) {
+            outputBuffer = inputBuffer;
         }
+        applyLimiter(outputBuffer.data(), outputBuffer.size() / 2);
     } catch (const std::exception& e) {
         handleErrors();
         throw;
     }
 }
 
+void MasteringEngine::runStage(Stage stage, float* interleaved, size_t numFrames) {
+    switch (stage) {
+        case Stage::Loudness: applyLoudness(interleaved, numFrames); break;
+        case Stage::Stereo: applyStereo(interleaved, numFrames); break;
+        case Stage::Dynamics: applyDynamics(interleaved, numFrames); break;
+        case Stage::EQ: applyEQ(interleaved, numFrames); break;
+        case Stage::Limiter: applyLimiter(interleaved, numFrames); break;
+    }
+}
+
+void MasteringEngine::applyLoudness(float* interleaved, size_t numFrames) {
+    // Gain aus der gegateten Integrated Loudness des Eingangs; solange
+    // noch kein Gating-Block vorliegt, bleibt der bisherige Gain stehen
+    inputMeter.process(interleaved, numFrames);
+
+    float targetGain = state.loudnessGain;
+    const float integrated = inputMeter.getIntegratedLoudness();
+    if (integrated > LoudnessMeter::kAbsoluteGate) {
+        const float gainDb = std::clamp(parameters.loudnessTarget - integrated,
+                                        -parameters.maxLoudnessGain, parameters.maxLoudnessGain);
+        targetGain = std::pow(10.0f, gainDb / 20.0f);
+    }
+
+    // Gain-Änderung linear über den Puffer verteilen
+    const float startGain = state.loudnessGain;
+    const float step = numFrames > 0 ? (targetGain - startGain) / numFrames : 0.0f;
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        const float gain = startGain + step * (frame + 1);
+        interleaved[2 * frame] *= gain;
+        interleaved[2 * frame + 1] *= gain;
+    }
+    state.loudnessGain = targetGain;
+}
+
+void MasteringEngine::applyStereo(float* interleaved, size_t numFrames) {
+    if (parameters.stereoWidth == 1.0f) return;
+
+    const float width = parameters.stereoWidth;
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        float* sample = interleaved + 2 * frame;
+        const float mid = (sample[0] + sample[1]) * 0.5f;
+        const float side = (sample[0] - sample[1]) * 0.5f * width;
+        sample[0] = mid + side;
+        sample[1] = mid - side;
+    }
+}
+
+void MasteringEngine::applyDynamics(float* interleaved, size_t numFrames) {
+    // Multiband-Dynamics (bei einem Band ohne Weiche)
+    dynamics.process(interleaved, numFrames);
+}
+
+void MasteringEngine::applyEQ(float* interleaved, size_t numFrames) {
+    // Neue Koeffizienten übernehmen, der Filterzustand bleibt erhalten
+    EQUpdate update;
+    while (state.eqUpdates.pop(update)) {
+        EQFilter& filter = state.eqFilters[update.band];
+        filter.b0 = update.b0;
+        filter.b1 = update.b1;
+        filter.b2 = update.b2;
+        filter.a1 = update.a1;
+        filter.a2 = update.a2;
+        state.activeEQBands = std::max(state.activeEQBands, update.band + 1);
+    }
+
+    for (int band = 0; band < state.activeEQBands; ++band) {
+        EQFilter& filter = state.eqFilters[band];
+        for (int channel = 0; channel < 2; ++channel) {
+            double z1 = filter.z[channel][0];
+            double z2 = filter.z[channel][1];
+            float* sample = interleaved + channel;
+            for (size_t frame = 0; frame < numFrames; ++frame, sample += 2) {
+                const double x = *sample;
+                const double y = filter.b0 * x + z1;
+                z1 = filter.b1 * x - filter.a1 * y + z2;
+                z2 = filter.b2 * x - filter.a2 * y;
+                *sample = static_cast<float>(y);
+            }
+            filter.z[channel][0] = z1;
+            filter.z[channel][1] = z2;
+        }
+    }
+}
+
+void MasteringEngine::applyLimiter(float* interleaved, size_t numFrames) {
+    // True-Peak-Limiter mit Lookahead; die Kette ist um getLatencySamples() verzögert
+    limiter.process(interleaved, numFrames);
+    analysis.truePeak = limiter.getOutputTruePeakDb();
+    analysis.gainReduction = limiter.getGainReductionDb();
+}
+
 void MasteringEngine::setLoudnessTarget(float target) {
     try {
         parameters.loudnessTarget = target;
@@ -194,6 +285,7 @@ void MasteringEngine::setStereoWidth(float width) {
 void MasteringEngine::setCompressionThreshold(float threshold) {
     try {
         parameters.compressionThreshold = threshold;
+        applyCompressionSettings();
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -203,6 +295,7 @@ void MasteringEngine::setCompressionThreshold(float threshold) {
 void MasteringEngine::setCompressionRatio(float ratio) {
     try {
         parameters.compressionRatio = ratio;
+        applyCompressionSettings();
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -212,6 +305,7 @@ void MasteringEngine::setCompressionRatio(float ratio) {
 void MasteringEngine::setCompressionAttack(float attack) {
     try {
         parameters.compressionAttack = attack;
+        applyCompressionSettings();
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -221,6 +315,7 @@ void MasteringEngine::setCompressionAttack(float attack) {
 void MasteringEngine::setCompressionRelease(float release) {
     try {
         parameters.compressionRelease = release;
+        applyCompressionSettings();
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -229,10 +324,12 @@ void MasteringEngine::setCompressionRelease(float release) {
 
 void MasteringEngine::setEQBand(int band, float frequency, float gain, float q) {
     try {
-        if (band >= parameters.eqBands.size()) {
-            parameters.eqBands.resize(band + 1);
+        if (band < 0 || band >= kMaxEQBands) {
+            throw std::invalid_argument("Invalid EQ band");
         }
+        parameters.eqBandCount = std::max(parameters.eqBandCount, band + 1);
         parameters.eqBands[band] = std::make_tuple(frequency, gain, q);
+        updateEQFilter(band);
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -242,6 +339,7 @@ void MasteringEngine::setEQBand(int band, float frequency, float gain, float q)
 void MasteringEngine::setLimiterThreshold(float threshold) {
     try {
         parameters.limiterThreshold = threshold;
+        limiter.setCeiling(threshold);
     } catch (const std::exception& e) {
         handleErrors();
         throw;
@@ -251,16 +349,147 @@ void MasteringEngine::setLimiterThreshold(float threshold) {
 void MasteringEngine::setLimiterRelease(float release) {
     try {
         parameters.limiterRelease = release;
+        limiter.setRelease(release * 1000.0f);
+    } catch (const std::exception& e) {
+        handleErrors();
+        throw;
+    }
+}
+
+void MasteringEngine::setLimiterLookahead(float milliseconds) {
+    try {
+        parameters.limiterLookahead = milliseconds;
+        limiter.setLookahead(milliseconds);
+    } catch (const std::exception& e) {
+        handleErrors();
+        throw;
+    }
+}
+
+void MasteringEngine::setLimiterReleaseCurve(TruePeakLimiter::ReleaseCurve curve) {
+    try {
+        limiter.setReleaseCurve(curve);
+    } catch (const std::exception& e) {
+        handleErrors();
+        throw;
+    }
+}
+
+void MasteringEngine::setExportNormalization(bool enabled) {
+    try {
+        parameters.exportNormalization = enabled;
+    } catch (const std::exception& e) {
+        handleErrors();
+        throw;
+    }
+}
+
+void MasteringEngine::setDynamicsBandCount(int bands) {
+    try {
+        dynamics.setBandCount(bands);
+    } catch (const std::exception& e) {
+        handleErrors();
+        throw;
+    }
+}
+
+void MasteringEngine::setDynamicsCrossover(MultibandDynamics::Crossover crossover) {
+    try {
+        dynamics.setCrossover(crossover);
+    } catch (const std::exception& e) {
+        handleErrors();
+        throw;
+    }
+}
+
+void MasteringEngine::setCrossoverFrequency(int index, float frequency) {
+    try {
+        dynamics.setCrossoverFrequency(index, frequency);
+    } catch (const std::exception& e) {
+        handleErrors();
+        throw;
+    }
+}
+
+void MasteringEngine::setBandDynamics(int band, const DynamicsCore::Settings& settings) {
+    try {
+        dynamics.setBand(band, settings);
+    } catch (const std::exception& e) {
+        handleErrors();
+        throw;
+    }
+}
+
+void MasteringEngine::setStageOrder(const std::vector<Stage>& order) {
+    try {
+        if (order.size() > static_cast<size_t>(kNumStages)) {
+            throw std::invalid_argument("Too many mastering stages");
+        }
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (std::find(order.begin() + i + 1, order.end(), order[i]) != order.end()) {
+                throw std::invalid_argument("Mastering stage listed twice");
+            }
+        }
+
+        StageOrder update;
+        std::copy(order.begin(), order.end(), update.stages.begin());
+        update.count = static_cast<int>(order.size());
+        if (!state.stageOrderUpdates.push(update)) {
+            throw std::runtime_error("Stage order queue full");
+        }
+        parameters.stageOrder = update;
+    } catch (const std::exception& e) {
+        handleErrors();
+        throw;
+    }
+}
+
+std::vector<MasteringEngine::Stage> MasteringEngine::getStageOrder() const {
+    const auto& order = parameters.stageOrder;
+    return std::vector<Stage>(order.stages.begin(), order.stages.begin() + order.count);
+}
+
+void MasteringEngine::setInputValidation(bool enabled) {
+    try {
+        parameters.validateInput = enabled;
     } catch (const std::exception& e) {
         handleErrors();
         throw;
     }
 }
 
+int MasteringEngine::getLatencySamples() const {
+    return dynamics.getLatencySamples() + limiter.getLatencySamples();
+}
+
 float MasteringEngine::getLoudness() {
     return analysis.loudness;
 }
 
+float MasteringEngine::getMomentaryLoudness() {
+    return outputMeter.getMomentaryLoudness();
+}
+
+float MasteringEngine::getShortTermLoudness() {
+    return outputMeter.getShortTermLoudness();
+}
+
+float MasteringEngine::getLoudnessRange() {
+    return outputMeter.getLoudnessRange();
+}
+
+void MasteringEngine::resetLoudness() {
+    try {
+        inputMeter.reset();
+        outputMeter.reset();
+        state.loudnessGain = 1.0f;
+        analysis.loudness = outputMeter.getIntegratedLoudness();
+    } catch (const std::exception& e) {
+        handleErrors();
+        throw;
+    }
+}
+
 float MasteringEngine::getStereoWidth() {
     return analysis.stereoWidth;
 }
@@ -289,12 +518,108 @@ float MasteringEngine::getHeadroom() {
     return analysis.headroom;
 }
 
+float MasteringEngine::getTruePeak() {
+    return analysis.truePeak;
+}
+
+float MasteringEngine::getLimiterGainReduction() {
+    return analysis.gainReduction;
+}
+
+float MasteringEngine::getBandGainReduction(int band) {
+    return dynamics.getGainReductionDb(band);
+}
+
+LoudnessMeter::Measurement MasteringEngine::analyzeLoudness(const std::vector<float>& buffer) {
+    try {
+        if (!validateBuffer(buffer)) {
+            throw std::runtime_error("Invalid loudness analysis buffer");
+        }
+        return LoudnessMeter::analyze(buffer.data(), buffer.size() / 2, 2, parameters.sampleRate);
+    } catch (const std::exception& e) {
+        handleErrors();
+        throw;
+    }
+}
+
+float MasteringEngine::normalizeLoudness(const std::vector<float>& inputBuffer, std::vector<float>& outputBuffer) {
+    try {
+        // 1. Durchgang: Integrated Loudness und True-Peak messen
+        const LoudnessMeter::Measurement measurement = analyzeLoudness(inputBuffer);
+        outputBuffer = inputBuffer;
+        if (measurement.integrated <= LoudnessMeter::kAbsoluteGate) return measurement.integrated;
+
+        // Ohne Spitzen über der Ceiling reicht ein konstanter Gain
+        float gainDb = std::min(parameters.loudnessTarget - measurement.integrated, parameters.maxLoudnessGain);
+        if (measurement.truePeak + gainDb <= parameters.limiterThreshold) {
+            const float gain = std::pow(10.0f, gainDb / 20.0f);
+            for (float& sample : outputBuffer) {
+                sample *= gain;
+            }
+            return measurement.integrated + gainDb;
+        }
+
+        // 2. Durchgang über den Limiter. Das Begrenzen kostet Lautheit, daher
+        // wird der Gain per Sekantenschritt nachgeführt, bis das Ziel erreicht ist
+        float achieved = measurement.integrated;
+        float previousGainDb = 0.0f;
+        float previousAchieved = measurement.integrated;
+        for (int pass = 0; pass < 4; ++pass) {
+            applyMakeUpGain(inputBuffer, gainDb, outputBuffer);
+            achieved = analyzeLoudness(outputBuffer).integrated;
+            const float missing = parameters.loudnessTarget - achieved;
+            if (std::fabs(missing) < 0.1f || (missing > 0.0f && gainDb >= parameters.maxLoudnessGain)) break;
+
+            // Anstieg der Lautheit pro dB Gain, durch den Limiter kleiner als 1
+            const float step = gainDb - previousGainDb;
+            const float slope = std::fabs(step) > 1e-3f
+                ? std::clamp((achieved - previousAchieved) / step, 0.1f, 1.0f) : 1.0f;
+            previousGainDb = gainDb;
+            previousAchieved = achieved;
+            gainDb = std::min(gainDb + missing / slope, parameters.maxLoudnessGain);
+        }
+        return achieved;
+    } catch (const std::exception& e) {
+        handleErrors();
+        throw;
+    }
+}
+
+void MasteringEngine::applyMakeUpGain(const std::vector<float>& inputBuffer, float gainDb, std::vector<float>& outputBuffer) {
+    // Eigener Limiter, damit der Zustand der Echtzeit-Kette unberührt bleibt
+    TruePeakLimiter makeUpLimiter;
+    makeUpLimiter.setCeiling(parameters.limiterThreshold);
+    makeUpLimiter.setRelease(parameters.limiterRelease * 1000.0f);
+    makeUpLimiter.setReleaseCurve(limiter.getReleaseCurve());
+    makeUpLimiter.setLookahead(parameters.limiterLookahead);
+    makeUpLimiter.prepare(parameters.sampleRate, 2);
+
+    // Um die Latenz verlängert verarbeiten und den Anfang verwerfen, damit der
+    // Ausgang sampleweise zum Eingang passt
+    const size_t frames = inputBuffer.size() / 2;
+    const size_t latency = static_cast<size_t>(makeUpLimiter.getLatencySamples());
+    const float gain = std::pow(10.0f, gainDb / 20.0f);
+    std::vector<float> padded((frames + latency) * 2, 0.0f);
+    for (size_t i = 0; i < frames * 2; ++i) {
+        padded[i] = inputBuffer[i] * gain;
+    }
+    makeUpLimiter.process(padded.data(), frames + latency);
+
+    outputBuffer.assign(padded.begin() + latency * 2, padded.end());
+}
+
 void MasteringEngine::exportToFile(const std::string& filename, const std::vector<float>& buffer) {
     try {
         std::ofstream file(filename, std::ios::binary);
         if (!file) {
             throw std::runtime_error("Could not open file for writing");
         }
+        if (parameters.exportNormalization) {
+            std::vector<float> normalized;
+            normalizeLoudness(buffer, normalized);
+            file.write(reinterpret_cast<const char*>(normalized.data()), normalized.size() * sizeof(float));
+            return;
+        }
         file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(float));
     } catch (const std::exception& e) {
         handleErrors();
@@ -304,6 +629,12 @@ void MasteringEngine::exportToFile(const std::string& filename, const std::vecto
 
 void MasteringEngine::exportToStream(std::ostream& stream, const std::vector<float>& buffer) {
     try {
+        if (parameters.exportNormalization) {
+            std::vector<float> normalized;
+            normalizeLoudness(buffer, normalized);
+            stream.write(reinterpret_cast<const char*>(normalized.data()), normalized.size() * sizeof(float));
+            return;
+        }
         stream.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(float));
     } catch (const std::exception& e) {
         handleErrors();
@@ -312,6 +643,8 @@ void MasteringEngine::exportToStream(std::ostream& stream, const std::vector<flo
 }
 
 void MasteringEngine::exportToDevice(const std::string& device, const std::vector<float>& buffer) {
+    (void)device;
+    (void)buffer;
     try {
         // Implementierung der Geräte-Export-Funktionalität
     } catch (const std::exception& e) {
@@ -366,8 +699,18 @@ void MasteringEngine::updateAnalysisVisualization() {
 }
 
 void MasteringEngine::initializeComponents() {
-    audioEngine = std::make_unique<AudioEngine>();
-    mixingEngine = std::make_unique<MixingEngine>();
+    limiter.prepare(parameters.sampleRate, 2);
+    limiter.setCeiling(parameters.limiterThreshold);
+    limiter.setRelease(parameters.limiterRelease * 1000.0f);
+    limiter.setLookahead(parameters.limiterLookahead);
+
+    dynamics.prepare(parameters.sampleRate);
+    applyCompressionSettings();
+
+    inputMeter.prepare(parameters.sampleRate, 2);
+    outputMeter.prepare(parameters.sampleRate, 2);
+    state.loudnessGain = 1.0f;
+    initialized = true;
 }
 
 void MasteringEngine::updateState() {
@@ -394,6 +737,39 @@ void MasteringEngine::updateParameters() {
     // Parameter aktualisieren
 }
 
+void MasteringEngine::updateEQFilter(int band) {
+    // RBJ-Peaking-EQ
+    const auto& [frequency, gain, q] = parameters.eqBands[band];
+    const double a = std::pow(10.0, gain / 40.0);
+    const double w0 = 2.0 * VRMusicStudio::kPi * std::clamp(static_cast<double>(frequency), 10.0, parameters.sampleRate * 0.49) / parameters.sampleRate;
+    const double alpha = std::sin(w0) / (2.0 * std::max(static_cast<double>(q), 0.05));
+    const double cosW0 = std::cos(w0);
+    const double a0 = 1.0 + alpha / a;
+
+    // Der Audio-Thread übernimmt die Koeffizienten am Anfang von applyEQ()
+    EQUpdate update;
+    update.band = band;
+    update.b0 = (1.0 + alpha * a) / a0;
+    update.b1 = -2.0 * cosW0 / a0;
+    update.b2 = (1.0 - alpha * a) / a0;
+    update.a1 = update.b1;
+    update.a2 = (1.0 - alpha / a) / a0;
+    if (!state.eqUpdates.push(update)) {
+        throw std::runtime_error("EQ update queue full");
+    }
+}
+
+void MasteringEngine::applyCompressionSettings() {
+    for (int band = 0; band < MultibandDynamics::kMaxBands; ++band) {
+        DynamicsCore::Settings settings = dynamics.getBand(band);
+        settings.threshold = 20.0f * std::log10(std::max(parameters.compressionThreshold, 1.0e-6f));
+        settings.ratio = parameters.compressionRatio;
+        settings.attack = parameters.compressionAttack * 1000.0f;
+        settings.release = parameters.compressionRelease * 1000.0f;
+        dynamics.setBand(band, settings);
+    }
+}
+
 void MasteringEngine::updateAnalysis() {
     // Analyse aktualisieren
 }
@@ -403,7 +779,7 @@ void MasteringEngine::generateVisualization() {
 }
 
 void MasteringEngine::validateState() {
-    if (!audioEngine || !mixingEngine) {
+    if (!initialized) {
         throw std::runtime_error("Components not initialized");
     }
 }
@@ -413,16 +789,11 @@ void MasteringEngine::handleErrors() {
 }
 
 bool MasteringEngine::validateBuffer(const std::vector<float>& buffer) {
-    return !buffer.empty() && std::all_of(buffer.begin(), buffer.end(), [](float x) { return std::isfinite(x); });
+    return !buffer.empty() && VRMusicStudio::SimdOps::allFinite(buffer.data(), buffer.size());
 }
 
 float MasteringEngine::calculateLoudness(const std::vector<float>& buffer) {
-    if (buffer.empty()) return 0.0f;
-    float sum = 0.0f;
-    for (float sample : buffer) {
-        sum += sample * sample;
-    }
-    return 10.0f * std::log10(sum / buffer.size());
+    return LoudnessMeter::analyze(buffer.data(), buffer.size() / 2, 2, parameters.sampleRate).integrated;
 }
 
 float MasteringEngine::calculateStereoWidth(const std::vector<float>& leftBuffer, const std::vector<float>& rightBuffer) {
@@ -447,6 +818,7 @@ float MasteringEngine::calculateDynamics(const std::vector<float>& buffer) {
 }
 
 float MasteringEngine::calculateFrequencyResponse(const std::vector<float>& buffer, int band) {
+    (void)band;
     if (buffer.empty()) return 0.0f;
     float sum = 0.0f;
     for (size_t i = 1; i < buffer.size(); ++i) {
@@ -456,6 +828,7 @@ float MasteringEngine::calculateFrequencyResponse(const std::vector<float>& buff
 }
 
 float MasteringEngine::calculatePhaseResponse(const std::vector<float>& buffer, int band) {
+    (void)band;
     if (buffer.empty()) return 0.0f;
     float sum = 0.0f;
     for (size_t i = 1; i < buffer.size(); ++i) {
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "LoudnessMeter.hpp"
+#include "MultibandDynamics.hpp"
+#include "TruePeakLimiter.hpp"
+#include "audio/processing/SpscQueue.hpp"
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <ostream>
+
+namespace VR_DAW {
+
+class MasteringEngine {
+public:
+    // Stufen der Mastering-Kette; Reihenfolge per setStageOrder()
+    enum class Stage {
+        Loudness,
+        Stereo,
+        Dynamics,
+        EQ,
+        Limiter
+    };
+
+    static constexpr int kNumStages = 5;
+
+    // EQ-Bänder sind fest vorab angelegt, der Audio-Thread alloziert nie
+    static constexpr int kMaxEQBands = 16;
+
+    MasteringEngine();
+    ~MasteringEngine();
+
+    // Lifecycle Management
+    void initialize();
+    void update();
+    void shutdown();
+
+    // Mastering Processing (interleaved Stereo). Alle Stufen arbeiten in-place
+    // auf einem Puffer; die Vektor-Variante kopiert nur einmal in outputBuffer
+    void processMastering(const std::vector<float>& inputBuffer, std::vector<float>& outputBuffer);
+    void processMastering(float* interleaved, size_t numFrames);
+    void processLoudness(const std::vector<float>& inputBuffer, std::vector<float>& outputBuffer);
+    void processStereo(const std::vector<float>& inputBuffer, std::vector<float>& outputBuffer);
+    void processDynamics(const std::vector<float>& inputBuffer, std::vector<float>& outputBuffer);
+    void processEQ(const std::vector<float>& inputBuffer, std::vector<float>& outputBuffer);
+    void processLimiting(const std::vector<float>& inputBuffer, std::vector<float>& outputBuffer);
+
+    // Parameter
+    void setLoudnessTarget(float target);
+    void setStereoWidth(float width);
+    void setCompressionThreshold(float threshold);
+    void setCompressionRatio(float ratio);
+    void setCompressionAttack(float attack);
+    void setCompressionRelease(float release);
+    void setEQBand(int band, float frequency, float gain, float q);     // gain in dB, band < kMaxEQBands
+    void setLimiterThreshold(float threshold);
+    void setLimiterRelease(float release);
+    void setLimiterLookahead(float milliseconds);
+    void setLimiterReleaseCurve(TruePeakLimiter::ReleaseCurve curve);
+
+    // Multiband-Dynamics; die setCompression*-Werte gelten für alle Bänder
+    void setDynamicsBandCount(int bands);
+    void setDynamicsCrossover(MultibandDynamics::Crossover crossover);
+    void setCrossoverFrequency(int index, float frequency);
+    void setBandDynamics(int band, const DynamicsCore::Settings& settings);
+
+    // Kettenreihenfolge; nicht aufgeführte Stufen werden übersprungen. Gilt ab
+    // dem nächsten processMastering()-Aufruf
+    void setStageOrder(const std::vector<Stage>& order);
+    std::vector<Stage> getStageOrder() const;
+
+    // NaN/Inf-Prüfung des Eingangs in processMastering (standardmäßig aus)
+    void setInputValidation(bool enabled);
+
+    // Exporte zweistufig auf loudnessTarget (LUFS) normalisieren
+    void setExportNormalization(bool enabled);
+
+    // Latenz der Mastering-Kette in Samples
+    int getLatencySamples() const;
+
+    // Analyse
+    float getLoudness();                  // Integrated (LUFS) am Ausgang
+    float getMomentaryLoudness();
+    float getShortTermLoudness();
+    float getLoudnessRange();
+    void resetLoudness();
+    float getStereoWidth();
+    float getDynamics();
+    float getFrequencyResponse(int band);
+    float getPhaseResponse(int band);
+    float getDistortion();
+    float getNoiseFloor();
+    float getHeadroom();
+    float getTruePeak();
+    float getLimiterGainReduction();
+    float getBandGainReduction(int band);
+
+    // Offline-Messung und zweistufige Normalisierung (Stems, Export). Der
+    // Make-up-Gain läuft durch einen True-Peak-Limiter mit den Einstellungen der
+    // Kette; zurückgegeben wird die erreichte Integrated Loudness (LUFS), die
+    // nur bei mehr als maxLoudnessGain Abstand unter dem Ziel bleibt
+    LoudnessMeter::Measurement analyzeLoudness(const std::vector<float>& buffer);
+    float normalizeLoudness(const std::vector<float>& inputBuffer, std::vector<float>& outputBuffer);
+
+    // Export
+    void exportToFile(const std::string& filename, const std::vector<float>& buffer);
+    void exportToStream(std::ostream& stream, const std::vector<float>& buffer);
+    void exportToDevice(const std::string& device, const std::vector<float>& buffer);
+
+    // Visualisierung
+    void updateLoudnessVisualization();
+    void updateStereoVisualization();
+    void updateDynamicsVisualization();
+    void updateEQVisualization();
+    void updateAnalysisVisualization();
+
+private:
+    // Komponenten
+    bool initialized = false;
+    MultibandDynamics dynamics;
+    TruePeakLimiter limiter;
+    LoudnessMeter inputMeter;
+    LoudnessMeter outputMeter;
+
+    // Peaking-EQ-Band, Zustand je Kanal (Transposed Direct Form II)
+    struct EQFilter {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+        double z[2][2] = {};
+    };
+
+    // Neue Koeffizienten eines Bandes, Steuer-Thread -> Audio-Thread
+    struct EQUpdate {
+        int band = 0;
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+    };
+
+    // Feste Kettenreihenfolge, als Ganzes an den Audio-Thread übergeben
+    struct StageOrder {
+        std::array<Stage, kNumStages> stages{};
+        int count = 0;
+    };
+
+    // State
+    struct {
+        std::array<EQFilter, kMaxEQBands> eqFilters;
+        int activeEQBands = 0;              // nur Audio-Thread
+        VRMusicStudio::SpscQueue<EQUpdate> eqUpdates;
+        StageOrder stageOrder;              // nur Audio-Thread
+        VRMusicStudio::SpscQueue<StageOrder> stageOrderUpdates;
+        float loudnessGain = 1.0f;          // aktuell angewendeter Normalisierungs-Gain
+    } state;
+
+    // Parameter
+    struct {
+        float sampleRate = 44100.0f;
+        float loudnessTarget = -14.0f;      // LUFS
+        float maxLoudnessGain = 24.0f;      // dB
+        bool exportNormalization = false;
+        float stereoWidth = 1.0f;
+        float compressionThreshold = 0.5f;      // linear
+        float compressionRatio = 2.0f;
+        float compressionAttack = 0.01f;        // Sekunden
+        float compressionRelease = 0.1f;        // Sekunden
+        std::array<std::tuple<float, float, float>, kMaxEQBands> eqBands;
+        int eqBandCount = 0;
+        float limiterThreshold = -1.0f;     // dBTP
+        float limiterRelease = 0.08f;       // Sekunden
+        float limiterLookahead = 5.0f;      // Millisekunden
+        StageOrder stageOrder;
+        bool validateInput = false;
+    } parameters;
+
+    // Analyse
+    struct {
+        float loudness = -144.0f;
+        float stereoWidth = 0.0f;
+        float dynamics = 0.0f;
+        std::vector<float> frequencyResponse;
+        std::vector<float> phaseResponse;
+        float distortion = 0.0f;
+        float noiseFloor = 0.0f;
+        float headroom = 0.0f;
+        float truePeak = -120.0f;
+        float gainReduction = 0.0f;
+    } analysis;
+
+    // Hilfsfunktionen
+    void initializeComponents();
+    void updateState();
+    void processLoudnessToStereo();
+    void processStereoToDynamics();
+    void processDynamicsToEQ();
+    void processEQToLimiter();
+    void updateParameters();
+    void applyCompressionSettings();
+    void updateEQFilter(int band);
+    void applyMakeUpGain(const std::vector<float>& inputBuffer, float gainDb, std::vector<float>& outputBuffer);
+
+    // In-place-Stufen der Kette
+    void runStage(Stage stage, float* interleaved, size_t numFrames);
+    void applyLoudness(float* interleaved, size_t numFrames);
+    void applyStereo(float* interleaved, size_t numFrames);
+    void applyDynamics(float* interleaved, size_t numFrames);
+    void applyEQ(float* interleaved, size_t numFrames);
+    void applyLimiter(float* interleaved, size_t numFrames);
+    void updateAnalysis();
+    void generateVisualization();
+    void validateState();
+    void handleErrors();
+    bool validateBuffer(const std::vector<float>& buffer);
+    float calculateLoudness(const std::vector<float>& buffer);
+    float calculateStereoWidth(const std::vector<float>& leftBuffer, const std::vector<float>& rightBuffer);
+    float calculateDynamics(const std::vector<float>& buffer);
+    float calculateFrequencyResponse(const std::vector<float>& buffer, int band);
+    float calculatePhaseResponse(const std::vector<float>& buffer, int band);
+    float calculateDistortion(const std::vector<float>& buffer);
+    float calculateNoiseFloor(const std::vector<float>& buffer);
+    float calculateHeadroom(const std::vector<float>& buffer);
+};
+
+} // namespace VR_DAW
@@ -0,0 +1,402 @@
+#include "MultibandDynamics.hpp"
+#include "audio/processing/DspMath.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace VR_DAW {
+
+namespace {
+
+using VRMusicStudio::kPi;
+
+constexpr double kButterworthQ = 0.70710678118654752;
+constexpr float kDefaultFrequencies[MultibandDynamics::kMaxBands - 1] = {120.0f, 600.0f, 2500.0f, 8000.0f};
+
+struct Coefficients {
+    double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+};
+
+enum class Shape { Lowpass, Highpass, Allpass };
+
+// RBJ-Biquad mit Butterworth-Güte; zwei davon ergeben LR4, der Allpass hat
+// dieselben Pole und entspricht der Summe aus LR4-Tief- und -Hochpass
+Coefficients design(Shape shape, double frequency, double sampleRate) {
+    const double w0 = 2.0 * kPi * frequency / sampleRate;
+    const double cosW0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * kButterworthQ);
+    const double a0 = 1.0 + alpha;
+
+    Coefficients c;
+    switch (shape) {
+        case Shape::Lowpass:
+            c.b0 = (1.0 - cosW0) * 0.5 / a0;
+            c.b1 = (1.0 - cosW0) / a0;
+            c.b2 = c.b0;
+            break;
+        case Shape::Highpass:
+            c.b0 = (1.0 + cosW0) * 0.5 / a0;
+            c.b1 = -(1.0 + cosW0) / a0;
+            c.b2 = c.b0;
+            break;
+        case Shape::Allpass:
+            c.b0 = (1.0 - alpha) / a0;
+            c.b1 = -2.0 * cosW0 / a0;
+            c.b2 = 1.0;
+            break;
+    }
+    c.a1 = -2.0 * cosW0 / a0;
+    c.a2 = (1.0 - alpha) / a0;
+    return c;
+}
+
+} // namespace
+
+MultibandDynamics::MultibandDynamics()
+    : sampleRate(44100.0)
+    , numBands(1)
+    , crossover(Crossover::LinkwitzRiley)
+    , controlFill(0)
+    , fifoPos(0) {
+    std::copy(std::begin(kDefaultFrequencies), std::end(kDefaultFrequencies), frequencies);
+    prepare(sampleRate);
+}
+
+MultibandDynamics::~MultibandDynamics() = default;
+
+void MultibandDynamics::prepare(double newSampleRate) {
+    sampleRate = newSampleRate;
+
+    bandLanes.assign(kChunk * kMaxGroups * 4, 0.0f);
+    if (!fft) {
+        fft = std::make_unique<VRMusicStudio::RealFFT>(kFftSize);
+        designFft = std::make_unique<VRMusicStudio::RealFFT>(kFftSize);
+    }
+    fftBuffer.assign(kFftSize, 0.0f);
+    spectrum.assign(fft->getNumBins(), {});
+    bandSpectrum.assign(fft->getNumBins(), {});
+    for (auto& fifo : fifoInput) {
+        fifo.assign(kFftSize, 0.0f);
+    }
+    fifoBands.assign(kMaxLanes * kHop, 0.0f);
+
+    // Außerhalb der Wiedergabe direkt übernehmen, process() findet immer einen Entwurf
+    publishDesign();
+    active.reset();
+    adoptDesign(designs.load());
+}
+
+void MultibandDynamics::reset() {
+    core.reset();
+    std::memset(stageStates, 0, sizeof(stageStates));
+    std::memset(peakLanes, 0, sizeof(peakLanes));
+    std::memset(laneSteps, 0, sizeof(laneSteps));
+    for (int group = 0; group < kMaxGroups; ++group) {
+        for (int lane = 0; lane < 4; ++lane) {
+            laneGains[group][lane] = group * 4 + lane < numLanes() ? 1.0f : 0.0f;
+        }
+    }
+    controlFill = 0;
+
+    for (auto& fifo : fifoInput) {
+        std::fill(fifo.begin(), fifo.end(), 0.0f);
+    }
+    std::fill(fifoBands.begin(), fifoBands.end(), 0.0f);
+    fifoPos = 0;
+}
+
+void MultibandDynamics::setBandCount(int bands) {
+    numBands = std::clamp(bands, 1, kMaxBands);
+    publishDesign();
+}
+
+void MultibandDynamics::setCrossover(Crossover newCrossover) {
+    if (crossover == newCrossover) return;
+    crossover = newCrossover;
+    publishDesign();
+}
+
+void MultibandDynamics::setCrossoverFrequency(int index, float frequency) {
+    if (index < 0 || index >= kMaxBands - 1) return;
+    frequencies[index] = std::clamp(frequency, 20.0f, static_cast<float>(sampleRate * 0.45));
+    publishDesign();
+}
+
+void MultibandDynamics::setBand(int band, const DynamicsCore::Settings& settings) {
+    if (band < 0 || band >= kMaxBands) return;
+    core.setBand(band, settings);
+}
+
+int MultibandDynamics::getLatencySamples() const {
+    if (numBands == 1 || crossover == Crossover::LinkwitzRiley) return 0;
+    return static_cast<int>(kHop + (kFirLength - 1) / 2);
+}
+
+void MultibandDynamics::process(float* interleaved, size_t numFrames) {
+    // Neuer Entwurf vom Steuer-Thread gilt ab diesem Block
+    auto design = designs.load();
+    if (design != active) {
+        adoptDesign(std::move(design));
+    }
+    const bool linearPhase = active->numBands > 1 && active->crossover == Crossover::LinearPhase;
+
+    for (size_t offset = 0; offset < numFrames; offset += kChunk) {
+        const size_t count = std::min(kChunk, numFrames - offset);
+        float* chunk = interleaved + 2 * offset;
+
+        if (linearPhase) {
+            splitLinearPhase(chunk, count);
+        } else {
+            splitLinkwitzRiley(chunk, count);
+        }
+        applyDynamics(chunk, count);
+    }
+}
+
+void MultibandDynamics::publishDesign() {
+    auto design = std::make_shared<Design>();
+    design->numBands = numBands;
+    design->crossover = crossover;
+    if (crossover == Crossover::LinearPhase && numBands > 1) {
+        designLinearPhase(*design);
+    }
+    // Die LR4-Kaskade wird immer gesetzt; bei einem Band hat sie keine Stufen
+    designLinkwitzRiley(*design);
+    designs.publish(std::move(design));
+}
+
+void MultibandDynamics::adoptDesign(std::shared_ptr<const Design> design) {
+    // Andere Bandzahl oder Weiche: Zustände passen nicht mehr zum Signalweg
+    const bool topologyChanged = !active || design->numBands != active->numBands ||
+                                 design->crossover != active->crossover;
+    active = std::move(design);
+    if (topologyChanged) {
+        core.prepare(sampleRate, active->numBands);
+        reset();
+    }
+}
+
+std::array<float, MultibandDynamics::kMaxBands - 1> MultibandDynamics::sortedFrequencies() const {
+    // Trennfrequenzen aufsteigend, sonst überlappen die Bänder
+    std::array<float, kMaxBands - 1> sorted;
+    std::copy(frequencies, frequencies + kMaxBands - 1, sorted.begin());
+    for (int i = 1; i < numBands - 1; ++i) {
+        for (int j = i; j > 0 && sorted[j] < sorted[j - 1]; --j) {
+            std::swap(sorted[j], sorted[j - 1]);
+        }
+    }
+    return sorted;
+}
+
+void MultibandDynamics::designLinkwitzRiley(Design& target) const {
+    const auto sorted = sortedFrequencies();
+
+    target.numStages = numBands > 1 ? 2 * (numBands - 1) : 0;
+
+    for (int group = 0; group < kMaxGroups; ++group) {
+        for (int lane = 0; lane < 4; ++lane) {
+            const int band = (group * 4 + lane) / 2;
+
+            // Band k = LP(f_k) * HP(f_j < f_k) * AP(f_j > f_k), Rest Identität
+            std::vector<Coefficients> chain;
+            if (band < numBands) {
+                for (int j = 0; j < band; ++j) {
+                    chain.push_back(design(Shape::Highpass, sorted[j], sampleRate));
+                    chain.push_back(design(Shape::Highpass, sorted[j], sampleRate));
+                }
+                if (band < numBands - 1) {
+                    chain.push_back(design(Shape::Lowpass, sorted[band], sampleRate));
+                    chain.push_back(design(Shape::Lowpass, sorted[band], sampleRate));
+                }
+                for (int j = band + 1; j < numBands - 1; ++j) {
+                    chain.push_back(design(Shape::Allpass, sorted[j], sampleRate));
+                }
+            }
+            chain.resize(kMaxStages);
+
+            for (int stage = 0; stage < kMaxStages; ++stage) {
+                Stage& s = target.stages[group][stage];
+                s.b0[lane] = static_cast<float>(chain[stage].b0);
+                s.b1[lane] = static_cast<float>(chain[stage].b1);
+                s.b2[lane] = static_cast<float>(chain[stage].b2);
+                s.a1[lane] = static_cast<float>(chain[stage].a1);
+                s.a2[lane] = static_cast<float>(chain[stage].a2);
+            }
+        }
+    }
+}
+
+void MultibandDynamics::designLinearPhase(Design& target) {
+    const auto sorted = sortedFrequencies();
+
+    const size_t numBins = designFft->getNumBins();
+    const size_t halfLength = (kFirLength - 1) / 2;
+    target.kernels.assign(numBands, std::vector<std::complex<float>>(numBins));
+    std::vector<std::complex<float>> curve(numBins);
+    std::vector<float> response(kFftSize);
+
+    for (int band = 0; band < numBands; ++band) {
+        // Nullphasiger Betragsgang: |LP4| = 1 / (1 + (f/fc)^4), die Bänder
+        // ergeben in Summe exakt 1
+        for (size_t bin = 0; bin < numBins; ++bin) {
+            const double frequency = bin * sampleRate / kFftSize;
+            double magnitude = 1.0;
+            for (int j = 0; j < band; ++j) {
+                const double r = std::pow(frequency / sorted[j], 4.0);
+                magnitude *= r / (1.0 + r);
+            }
+            if (band < numBands - 1) {
+                magnitude *= 1.0 / (1.0 + std::pow(frequency / sorted[band], 4.0));
+            }
+            curve[bin] = {static_cast<float>(magnitude), 0.0f};
+        }
+        designFft->inverse(curve.data(), response.data());
+
+        // Impulsantwort um halfLength zentrieren und mit Blackman fenstern;
+        // die Fenstermitte ist 1, die Summe aller Bänder bleibt ein Dirac
+        std::vector<float> impulse(kFftSize, 0.0f);
+        for (size_t n = 0; n < kFirLength; ++n) {
+            const long offset = static_cast<long>(n) - static_cast<long>(halfLength);
+            const size_t source = static_cast<size_t>((offset + static_cast<long>(kFftSize)) % static_cast<long>(kFftSize));
+            const double phase = 2.0 * kPi * n / (kFirLength - 1);
+            const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+            impulse[n] = static_cast<float>(response[source] / kFftSize * window);
+        }
+
+        // Kernel enthält bereits die Normierung der späteren inversen FFT
+        designFft->forward(impulse.data(), target.kernels[band].data());
+        for (auto& bin : target.kernels[band]) {
+            bin /= static_cast<float>(kFftSize);
+        }
+    }
+}
+
+void MultibandDynamics::splitLinkwitzRiley(const float* input, size_t numFrames) {
+    const int groups = numGroups();
+    const size_t stride = static_cast<size_t>(groups) * 4;
+
+    for (int group = 0; group < groups; ++group) {
+        float* lanes = bandLanes.data() + group * 4;
+        for (size_t frame = 0; frame < numFrames; ++frame) {
+            Float4::set(input[2 * frame], input[2 * frame + 1], input[2 * frame], input[2 * frame + 1])
+                .store(lanes + frame * stride);
+        }
+
+        // Stufenweise über den ganzen Chunk, Koeffizienten bleiben in Registern
+        for (int stage = 0; stage < active->numStages; ++stage) {
+            const Stage& s = active->stages[group][stage];
+            const Float4 b0 = Float4::load(s.b0);
+            const Float4 b1 = Float4::load(s.b1);
+            const Float4 b2 = Float4::load(s.b2);
+            const Float4 a1 = Float4::load(s.a1);
+            const Float4 a2 = Float4::load(s.a2);
+            StageState& state = stageStates[group][stage];
+            Float4 z1 = Float4::load(state.z1);
+            Float4 z2 = Float4::load(state.z2);
+
+            for (size_t frame = 0; frame < numFrames; ++frame) {
+                float* lane = lanes + frame * stride;
+                const Float4 x = Float4::load(lane);
+                const Float4 y = b0 * x + z1;
+                z1 = b1 * x - a1 * y + z2;
+                z2 = b2 * x - a2 * y;
+                y.store(lane);
+            }
+            z1.store(state.z1);
+            z2.store(state.z2);
+        }
+    }
+}
+
+void MultibandDynamics::splitLinearPhase(const float* input, size_t numFrames) {
+    const size_t stride = static_cast<size_t>(numGroups()) * 4;
+    const int lanes = numLanes();
+
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        float* out = bandLanes.data() + frame * stride;
+        for (int lane = 0; lane < lanes; ++lane) {
+            out[lane] = fifoBands[lane * kHop + fifoPos];
+        }
+        fifoInput[0][kFftSize - kHop + fifoPos] = input[2 * frame];
+        fifoInput[1][kFftSize - kHop + fifoPos] = input[2 * frame + 1];
+
+        if (++fifoPos < kHop) continue;
+        fifoPos = 0;
+
+        // Overlap-Save: die letzten kHop Samples der zirkulären Faltung sind gültig
+        for (int channel = 0; channel < 2; ++channel) {
+            fft->forward(fifoInput[channel].data(), spectrum.data());
+            for (int band = 0; band < active->numBands; ++band) {
+                const auto& kernel = active->kernels[band];
+                for (size_t bin = 0; bin < spectrum.size(); ++bin) {
+                    bandSpectrum[bin] = spectrum[bin] * kernel[bin];
+                }
+                fft->inverse(bandSpectrum.data(), fftBuffer.data());
+                std::copy(fftBuffer.begin() + (kFftSize - kHop), fftBuffer.end(),
+                          fifoBands.begin() + (band * 2 + channel) * kHop);
+            }
+            std::memmove(fifoInput[channel].data(), fifoInput[channel].data() + kHop,
+                         (kFftSize - kHop) * sizeof(float));
+        }
+    }
+}
+
+void MultibandDynamics::applyDynamics(float* output, size_t numFrames) {
+    const int groups = numGroups();
+    const size_t stride = static_cast<size_t>(groups) * 4;
+    const Float4 zero = Float4::zero();
+
+    Float4 peaks[kMaxGroups];
+    Float4 gains[kMaxGroups];
+    Float4 steps[kMaxGroups];
+    for (int group = 0; group < groups; ++group) {
+        peaks[group] = Float4::load(peakLanes[group]);
+        gains[group] = Float4::load(laneGains[group]);
+        steps[group] = Float4::load(laneSteps[group]);
+    }
+
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        const float* lanes = bandLanes.data() + frame * stride;
+
+        // Gain-Rampe anwenden, Bänder aufsummieren, Spitzenpegel sammeln
+        Float4 sum = zero;
+        for (int group = 0; group < groups; ++group) {
+            const Float4 y = Float4::load(lanes + group * 4);
+            peaks[group] = max(peaks[group], max(y, zero - y));
+            gains[group] += steps[group];
+            sum += y * gains[group];
+        }
+        alignas(16) float mixed[4];
+        sum.store(mixed);
+        output[2 * frame] = mixed[0] + mixed[2];
+        output[2 * frame + 1] = mixed[1] + mixed[3];
+
+        // Kontrollrate: neuer Ziel-Gain je Band, Rampe über den nächsten Block
+        if (++controlFill < DynamicsCore::kControlBlock) continue;
+        controlFill = 0;
+
+        alignas(16) float peak[kMaxGroups * 4];
+        alignas(16) float target[kMaxGroups * 4] = {};
+        for (int group = 0; group < groups; ++group) {
+            peaks[group].store(peak + group * 4);
+            peaks[group] = zero;
+        }
+        for (int band = 0; band < active->numBands; ++band) {
+            const float gain = core.process(band, std::max(peak[2 * band], peak[2 * band + 1]));
+            target[2 * band] = gain;
+            target[2 * band + 1] = gain;
+        }
+        const Float4 inverseLength = Float4::set1(1.0f / DynamicsCore::kControlBlock);
+        for (int group = 0; group < groups; ++group) {
+            steps[group] = (Float4::load(target + group * 4) - gains[group]) * inverseLength;
+        }
+    }
+
+    for (int group = 0; group < groups; ++group) {
+        peaks[group].store(peakLanes[group]);
+        gains[group].store(laneGains[group]);
+        steps[group].store(laneSteps[group]);
+    }
+}
+
+} // namespace VR_DAW
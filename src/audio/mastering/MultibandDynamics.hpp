@@ -0,0 +1,144 @@
+#pragma once
+
+#include "DynamicsCore.hpp"
+#include "audio/processing/AsyncResult.hpp"
+#include "audio/processing/FFT.hpp"
+#include "audio/processing/SimdOps.hpp"
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace VR_DAW {
+
+// Multiband-Dynamics für das Mastering (interleaved Stereo, 1 - 5 Bänder).
+//
+// Frequenzweichen:
+//  - LinkwitzRiley: LR4 (minimalphasig). Jedes Band wird direkt aus dem
+//    Eingang gefiltert (Hochpässe der tieferen, Tiefpass der eigenen und
+//    Allpässe der höheren Trennfrequenzen), die Summe aller Bänder ist damit
+//    ein reiner Allpass. Weil die Bänder unabhängig sind, laufen je zwei
+//    Bänder (L/R) als vier SIMD-Lanes durch dieselbe Biquad-Kaskade.
+//  - LinearPhase: FIR-Weichen per FFT (Overlap-Save). Die Bandbetragsgänge
+//    sind komplementär, die Summe ist eine reine Verzögerung von
+//    getLatencySamples() Samples.
+//
+// Die Bänder teilen sich den DynamicsCore; bei einem Band entfällt die Weiche
+// und der Pfad entspricht dem Single-Band-Kompressor.
+//
+// Die Setter entwerfen die Weiche vollständig auf dem Steuer-Thread (eigene
+// FFT) und veröffentlichen sie als unveränderlichen Entwurf; process()
+// übernimmt ihn zu Beginn des nächsten Blocks. Der Audio-Thread liest damit
+// nie Puffer, die gerade neu angelegt werden.
+class MultibandDynamics {
+public:
+    enum class Crossover {
+        LinkwitzRiley,
+        LinearPhase
+    };
+
+    static constexpr int kMaxBands = 5;
+    static constexpr int kMaxLanes = 2 * kMaxBands;
+    static constexpr int kMaxGroups = (kMaxLanes + 3) / 4;
+    static constexpr int kMaxStages = 2 * (kMaxBands - 1);
+    static constexpr size_t kChunk = 8 * DynamicsCore::kControlBlock;
+    static constexpr size_t kFirLength = 4095;
+    static constexpr size_t kFftSize = 8192;
+    static constexpr size_t kHop = kFftSize - kFirLength + 1;
+
+    MultibandDynamics();
+    ~MultibandDynamics();
+
+    void prepare(double sampleRate);
+    void reset();
+
+    // Die Setter berechnen die Weichen neu (bei LinearPhase inkl. FFTs) und
+    // sind daher nicht für den Audio-Thread gedacht; sie dürfen aber parallel
+    // zu process() laufen
+    void setBandCount(int bands);
+    void setCrossover(Crossover crossover);
+    void setCrossoverFrequency(int index, float frequency);
+    void setBand(int band, const DynamicsCore::Settings& settings);
+
+    int getBandCount() const { return numBands; }
+    Crossover getCrossover() const { return crossover; }
+    float getCrossoverFrequency(int index) const { return frequencies[index]; }
+    const DynamicsCore::Settings& getBand(int band) const { return core.getBand(band); }
+    float getGainReductionDb(int band) const { return core.getGainReductionDb(band); }
+    int getLatencySamples() const;
+
+    void process(float* interleaved, size_t numFrames);
+
+private:
+    using Float4 = VRMusicStudio::SimdOps::Float4;
+
+    // Koeffizienten einer Biquad-Stufe für vier Lanes
+    struct Stage {
+        alignas(16) float b0[4];
+        alignas(16) float b1[4];
+        alignas(16) float b2[4];
+        alignas(16) float a1[4];
+        alignas(16) float a2[4];
+    };
+
+    struct StageState {
+        alignas(16) float z1[4];
+        alignas(16) float z2[4];
+    };
+
+    // Fertig entworfene Weiche; wird nach der Veröffentlichung nicht mehr verändert
+    struct Design {
+        int numBands = 1;
+        Crossover crossover = Crossover::LinkwitzRiley;
+        // LR4: Biquad-Kaskade je Lane-Gruppe
+        int numStages = 0;
+        Stage stages[kMaxGroups][kMaxStages];
+        // LinearPhase: Kernel-Spektrum je Band
+        std::vector<std::vector<std::complex<float>>> kernels;
+    };
+
+    void publishDesign();
+    void adoptDesign(std::shared_ptr<const Design> design);
+    std::array<float, kMaxBands - 1> sortedFrequencies() const;
+    void designLinkwitzRiley(Design& target) const;
+    void designLinearPhase(Design& target);
+    void splitLinkwitzRiley(const float* input, size_t numFrames);
+    void splitLinearPhase(const float* input, size_t numFrames);
+    void applyDynamics(float* output, size_t numFrames);
+
+    int numLanes() const { return 2 * active->numBands; }
+    int numGroups() const { return (numLanes() + 3) / 4; }
+
+    // Steuer-Thread: gewünschte Einstellungen
+    double sampleRate;
+    int numBands;
+    Crossover crossover;
+    float frequencies[kMaxBands - 1];
+    std::unique_ptr<VRMusicStudio::RealFFT> designFft;
+    VRMusicStudio::AsyncResult<Design> designs;
+
+    // Audio-Thread: laufender Entwurf und Zustände
+    std::shared_ptr<const Design> active;
+    DynamicsCore core;
+    StageState stageStates[kMaxGroups][kMaxStages];
+
+    // Bandsignale eines Chunks, Layout [Frame][Gruppe][Lane]
+    std::vector<float> bandLanes;
+    // Regelung: Spitzenpegel, Gain und Rampensteigung je Lane
+    alignas(16) float peakLanes[kMaxGroups][4];
+    alignas(16) float laneGains[kMaxGroups][4];
+    alignas(16) float laneSteps[kMaxGroups][4];
+    size_t controlFill;
+
+    // Linearphasige Weiche: Overlap-Save mit Hop kHop
+    std::unique_ptr<VRMusicStudio::RealFFT> fft;
+    std::vector<float> fifoInput[2];
+    std::vector<float> fifoBands;                                // [Band][Kanal][kHop]
+    std::vector<float> fftBuffer;
+    std::vector<std::complex<float>> spectrum;
+    std::vector<std::complex<float>> bandSpectrum;
+    size_t fifoPos;
+};
+
+} // namespace VR_DAW
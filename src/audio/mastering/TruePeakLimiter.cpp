@@ -0,0 +1,293 @@
+#include "TruePeakLimiter.hpp"
+#include "audio/processing/DspMath.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace VR_DAW {
+
+namespace {
+
+using VRMusicStudio::nextPowerOfTwo;
+
+// Polyphasen-Koeffizienten des 4x-Interpolationsfilters aus ITU-R BS.1770-4, Annex 2
+constexpr float kTruePeakCoefficients[TruePeakLimiter::kOversampling][TruePeakLimiter::kTapsPerPhase] = {
+    { 0.0017089843750f,  0.0109863281250f, -0.0196533203125f,  0.0332031250000f,
+     -0.0594482421875f,  0.1373291015625f,  0.9721679687500f, -0.1022949218750f,
+      0.0476074218750f, -0.0266113281250f,  0.0148925781250f, -0.0083007812500f },
+    {-0.0291748046875f,  0.0292968750000f, -0.0517578125000f,  0.0891113281250f,
+     -0.1665039062500f,  0.4650878906250f,  0.7797851562500f, -0.2003173828125f,
+      0.1015625000000f, -0.0582275390625f,  0.0330810546875f, -0.0189208984375f },
+    {-0.0189208984375f,  0.0330810546875f, -0.0582275390625f,  0.1015625000000f,
+     -0.2003173828125f,  0.7797851562500f,  0.4650878906250f, -0.1665039062500f,
+      0.0891113281250f, -0.0517578125000f,  0.0292968750000f, -0.0291748046875f },
+    {-0.0083007812500f,  0.0148925781250f, -0.0266113281250f,  0.0476074218750f,
+     -0.1022949218750f,  0.9721679687500f,  0.1373291015625f, -0.0594482421875f,
+      0.0332031250000f, -0.0196533203125f,  0.0109863281250f,  0.0017089843750f }
+};
+
+float dbToLinear(float db) {
+    return std::pow(10.0f, db / 20.0f);
+}
+
+float linearToDb(float linear) {
+    return 20.0f * std::log10(std::max(linear, 1e-9f));
+}
+
+} // namespace
+
+float TruePeakLimiter::History::push(float sample) {
+    samples[pos] = sample;
+    samples[pos + kTapsPerPhase] = sample;
+    pos = (pos + 1) % kTapsPerPhase;
+    return interpolatedPeak(samples + pos);
+}
+
+float TruePeakLimiter::interpolatedPeak(const float* history) {
+    // history[kTapsPerPhase - 1] ist das neueste Sample
+    float peak = std::fabs(history[kTapsPerPhase - 1 - kDetectorDelay]);
+    for (int phase = 0; phase < kOversampling; ++phase) {
+        const float* h = kTruePeakCoefficients[phase];
+        float sum = 0.0f;
+        for (int tap = 0; tap < kTapsPerPhase; ++tap) {
+            sum += h[tap] * history[kTapsPerPhase - 1 - tap];
+        }
+        peak = std::max(peak, std::fabs(sum));
+    }
+    return peak;
+}
+
+TruePeakLimiter::TruePeakLimiter()
+    : sampleRate(44100.0)
+    , numChannels(2)
+    , ceilingDb(-1.0f)
+    , inputGainDb(0.0f)
+    , lookaheadMs(5.0f)
+    , releaseMs(80.0f)
+    , releaseCurve(ReleaseCurve::Adaptive)
+    , ceilingLinear(1.0f)
+    , inputGain(1.0f)
+    , lookaheadSamples(0)
+    , pendingLookahead(-1)
+    , releaseCoefficient(0.0f)
+    , slowReleaseCoefficient(0.0f)
+    , logReleaseStep(1.0f)
+    , sustainCoefficient(0.0f)
+    , delayMask(0)
+    , delayWritePos(0)
+    , minHead(0)
+    , minTail(0)
+    , minMask(0)
+    , sampleIndex(0)
+    , holdLength(1)
+    , boxPos(0)
+    , boxSum(0.0)
+    , boxLength(1)
+    , releaseState(1.0f)
+    , sustain(0.0f)
+    , currentGain(1.0f)
+    , inputPeak(0.0f)
+    , outputPeak(0.0f)
+{
+    prepare(sampleRate, numChannels);
+}
+
+void TruePeakLimiter::prepare(double rate, int channelCount) {
+    sampleRate = rate;
+    numChannels = std::max(1, channelCount);
+
+    // Puffer einmalig für die maximale Lookahead-Zeit anlegen
+    const size_t maxLookahead = static_cast<size_t>(std::ceil(kMaxLookaheadMs * 0.001 * sampleRate));
+    const size_t maxDelay = maxLookahead + kDetectorDelay;
+
+    channels.assign(numChannels, Channel{});
+    delayMask = nextPowerOfTwo(maxDelay + 1) - 1;
+    delayLine.assign((delayMask + 1) * numChannels, 0.0f);
+
+    minMask = nextPowerOfTwo(maxLookahead + 3) - 1;
+    minValues.assign(minMask + 1, 1.0f);
+    minIndices.assign(minMask + 1, 0);
+
+    boxRing.assign(maxLookahead + 1, 1.0f);
+
+    ceilingLinear = dbToLinear(ceilingDb);
+    inputGain = dbToLinear(inputGainDb);
+    pendingLookahead.store(-1, std::memory_order_relaxed);
+    applyLookahead(lookaheadToSamples(lookaheadMs));
+    updateCoefficients();
+}
+
+void TruePeakLimiter::reset() {
+    for (auto& channel : channels) {
+        channel = Channel{};
+    }
+    std::fill(delayLine.begin(), delayLine.end(), 0.0f);
+    delayWritePos = 0;
+
+    minHead = 0;
+    minTail = 0;
+    sampleIndex = 0;
+
+    std::fill(boxRing.begin(), boxRing.end(), 1.0f);
+    boxPos = 0;
+    boxSum = static_cast<double>(boxLength);
+
+    releaseState = 1.0f;
+    sustain = 0.0f;
+    currentGain = 1.0f;
+}
+
+void TruePeakLimiter::setCeiling(float dBTP) {
+    ceilingDb = std::clamp(dBTP, -24.0f, 0.0f);
+    ceilingLinear = dbToLinear(ceilingDb);
+}
+
+void TruePeakLimiter::setInputGain(float dB) {
+    inputGainDb = std::clamp(dB, -24.0f, 24.0f);
+    inputGain = dbToLinear(inputGainDb);
+}
+
+void TruePeakLimiter::setLookahead(float milliseconds) {
+    // Übernahme am Anfang des nächsten process(), der Audio-Thread setzt dort zurück
+    lookaheadMs = std::clamp(milliseconds, 0.0f, kMaxLookaheadMs);
+    pendingLookahead.store(lookaheadToSamples(lookaheadMs), std::memory_order_release);
+}
+
+int TruePeakLimiter::lookaheadToSamples(float milliseconds) const {
+    const int samples = static_cast<int>(std::lround(milliseconds * 0.001 * sampleRate));
+    return std::clamp(samples, 0, static_cast<int>(boxRing.size()) - 1);
+}
+
+void TruePeakLimiter::applyLookahead(int samples) {
+    lookaheadSamples.store(samples, std::memory_order_relaxed);
+
+    // Hold-Fenster ein Sample länger als der Mittelwert, weil der Detektor
+    // den Bereich zwischen zwei Samples abdeckt
+    boxLength = static_cast<size_t>(samples) + 1;
+    holdLength = boxLength + 1;
+    reset();
+}
+
+void TruePeakLimiter::setRelease(float milliseconds) {
+    releaseMs = std::clamp(milliseconds, 1.0f, 2000.0f);
+    updateCoefficients();
+}
+
+void TruePeakLimiter::setReleaseCurve(ReleaseCurve curve) {
+    releaseCurve = curve;
+}
+
+void TruePeakLimiter::process(float* interleaved, size_t numFrames) {
+    const int pending = pendingLookahead.exchange(-1, std::memory_order_acquire);
+    if (pending >= 0 && pending != lookaheadSamples.load(std::memory_order_relaxed)) {
+        applyLookahead(pending);
+    }
+
+    const size_t delay = static_cast<size_t>(getLatencySamples());
+    const size_t channelCount = static_cast<size_t>(numChannels);
+
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        float* samples = interleaved + frame * channelCount;
+        float* writeSlot = delayLine.data() + delayWritePos * channelCount;
+
+        // Eingang verzögern und True-Peak über alle Kanäle bestimmen
+        float peak = 0.0f;
+        for (size_t c = 0; c < channelCount; ++c) {
+            const float x = samples[c] * inputGain;
+            writeSlot[c] = x;
+            peak = std::max(peak, channels[c].input.push(x));
+        }
+        inputPeak = std::max(inputPeak, peak);
+
+        const float required = peak > ceilingLinear ? ceilingLinear / peak : 1.0f;
+        const float gain = boxFilter(applyRelease(slidingMinimum(required)));
+
+        const size_t readPos = (delayWritePos - delay) & delayMask;
+        const float* readSlot = delayLine.data() + readPos * channelCount;
+        for (size_t c = 0; c < channelCount; ++c) {
+            const float y = readSlot[c] * gain;
+            samples[c] = y;
+            outputPeak = std::max(outputPeak, channels[c].output.push(y));
+        }
+
+        currentGain = gain;
+        delayWritePos = (delayWritePos + 1) & delayMask;
+    }
+}
+
+float TruePeakLimiter::getGainReductionDb() const {
+    return -linearToDb(currentGain);
+}
+
+float TruePeakLimiter::getInputTruePeakDb() const {
+    return linearToDb(inputPeak);
+}
+
+float TruePeakLimiter::getOutputTruePeakDb() const {
+    return linearToDb(outputPeak);
+}
+
+void TruePeakLimiter::resetPeakHold() {
+    inputPeak = 0.0f;
+    outputPeak = 0.0f;
+}
+
+float TruePeakLimiter::slidingMinimum(float value) {
+    // Größere Werte am Ende verwerfen, sie können nie mehr das Minimum sein
+    while (minTail != minHead && minValues[(minTail - 1) & minMask] >= value) {
+        --minTail;
+    }
+    minValues[minTail & minMask] = value;
+    minIndices[minTail & minMask] = sampleIndex;
+    ++minTail;
+
+    // Aus dem Fenster gefallene Werte vorne entfernen
+    while (minIndices[minHead & minMask] + holdLength <= sampleIndex) {
+        ++minHead;
+    }
+    ++sampleIndex;
+    return minValues[minHead & minMask];
+}
+
+float TruePeakLimiter::applyRelease(float target) {
+    // Attack ist sofort; das Glätten übernimmt der Rechteck-Mittelwert
+    if (target <= releaseState) {
+        releaseState = target;
+    } else {
+        switch (releaseCurve) {
+            case ReleaseCurve::Exponential:
+                releaseState = target + (releaseState - target) * releaseCoefficient;
+                break;
+            case ReleaseCurve::Logarithmic:
+                releaseState = std::min(target, releaseState * logReleaseStep);
+                break;
+            case ReleaseCurve::Adaptive: {
+                const float amount = std::min(1.0f, sustain * 4.0f);
+                const float coefficient = releaseCoefficient + (slowReleaseCoefficient - releaseCoefficient) * amount;
+                releaseState = target + (releaseState - target) * coefficient;
+                break;
+            }
+        }
+    }
+
+    // Dauer der Gain-Reduktion für die adaptive Release mitführen
+    sustain = (1.0f - releaseState) + (sustain - (1.0f - releaseState)) * sustainCoefficient;
+    return releaseState;
+}
+
+float TruePeakLimiter::boxFilter(float value) {
+    boxSum += static_cast<double>(value) - static_cast<double>(boxRing[boxPos]);
+    boxRing[boxPos] = value;
+    boxPos = boxPos + 1 == boxLength ? 0 : boxPos + 1;
+    return static_cast<float>(boxSum / static_cast<double>(boxLength));
+}
+
+void TruePeakLimiter::updateCoefficients() {
+    const double releaseSamples = std::max(1.0, releaseMs * 0.001 * sampleRate);
+    releaseCoefficient = static_cast<float>(std::exp(-1.0 / releaseSamples));
+    slowReleaseCoefficient = static_cast<float>(std::exp(-1.0 / (4.0 * releaseSamples)));
+    // 12 dB Erholung pro Release-Zeit
+    logReleaseStep = static_cast<float>(std::pow(10.0, (12.0 / 20.0) / releaseSamples));
+    sustainCoefficient = static_cast<float>(std::exp(-1.0 / (0.2 * sampleRate)));
+}
+
+} // namespace VR_DAW
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace VR_DAW {
+
+// Lookahead-Limiter für das Mastering mit True-Peak-Erkennung.
+//
+// Der Pegel wird mit dem 4x-Polyphasen-Interpolationsfilter aus ITU-R BS.1770
+// (Annex 2, 48 Taps) zwischen den Samples geschätzt. Der benötigte Gain läuft
+// durch ein gleitendes Minimum (monotone Queue, O(1) pro Sample), die Release-
+// Kurve und einen Rechteck-Mittelwert über die Lookahead-Länge. Dadurch
+// erreicht der Gain sein Ziel genau dann, wenn der Peak am verzögerten Ausgang
+// ankommt, ohne dass eine harte Gain-Stufe entsteht.
+//
+// Die Audiodaten sind interleaved, alle Kanäle teilen sich einen Gain.
+// setLookahead() darf aus dem Steuer-Thread kommen: die neue Länge wird
+// vorgemerkt und am Anfang des nächsten process() samt Reset übernommen.
+class TruePeakLimiter {
+public:
+    enum class ReleaseCurve {
+        Exponential,    // klassischer RC-Verlauf
+        Logarithmic,    // konstante dB/s, wirkt bei tiefen Reduktionen gleichmäßiger
+        Adaptive        // längere Release bei dauerhafter Gain-Reduktion
+    };
+
+    static constexpr int kOversampling = 4;
+    static constexpr int kTapsPerPhase = 12;
+    static constexpr int kDetectorDelay = 6;      // Gruppenlaufzeit des Interpolationsfilters
+    static constexpr float kMaxLookaheadMs = 20.0f;
+
+    TruePeakLimiter();
+
+    void prepare(double sampleRate, int numChannels);
+    void reset();
+
+    void setCeiling(float dBTP);
+    void setInputGain(float dB);
+    void setLookahead(float milliseconds);
+    void setRelease(float milliseconds);
+    void setReleaseCurve(ReleaseCurve curve);
+
+    float getCeiling() const { return ceilingDb; }
+    float getLookahead() const { return lookaheadMs; }
+    float getRelease() const { return releaseMs; }
+    ReleaseCurve getReleaseCurve() const { return releaseCurve; }
+
+    void process(float* interleaved, size_t numFrames);
+
+    // Verzögerung zwischen Ein- und Ausgang in Samples
+    int getLatencySamples() const { return lookaheadSamples.load(std::memory_order_relaxed) + kDetectorDelay; }
+    float getGainReductionDb() const;
+    float getInputTruePeakDb() const;
+    float getOutputTruePeakDb() const;
+    void resetPeakHold();
+
+    // True-Peak eines Frames aus der Filterhistorie (auch für Messungen nutzbar)
+    static float interpolatedPeak(const float* history);
+
+private:
+    // Filterhistorie als doppelt geschriebener Ring, damit die letzten
+    // kTapsPerPhase Samples immer zusammenhängend gelesen werden können
+    struct History {
+        float samples[2 * kTapsPerPhase] = {};
+        int pos = 0;
+        float push(float sample);
+    };
+
+    struct Channel {
+        History input;
+        History output;
+    };
+
+    float slidingMinimum(float value);
+    float applyRelease(float target);
+    float boxFilter(float value);
+    void updateCoefficients();
+    int lookaheadToSamples(float milliseconds) const;
+    void applyLookahead(int samples);
+
+    double sampleRate;
+    int numChannels;
+
+    // Parameter
+    float ceilingDb;
+    float inputGainDb;
+    float lookaheadMs;
+    float releaseMs;
+    ReleaseCurve releaseCurve;
+
+    float ceilingLinear;
+    float inputGain;
+    std::atomic<int> lookaheadSamples;
+    std::atomic<int> pendingLookahead;      // -1 = keine Änderung vorgemerkt
+    float releaseCoefficient;
+    float slowReleaseCoefficient;
+    float logReleaseStep;
+    float sustainCoefficient;
+
+    // Kanäle und Verzögerungsleitung
+    std::vector<Channel> channels;
+    std::vector<float> delayLine;       // interleaved
+    size_t delayMask;
+    size_t delayWritePos;
+
+    // Gleitendes Minimum: monotone Queue aus (Wert, Index)
+    std::vector<float> minValues;
+    std::vector<size_t> minIndices;
+    size_t minHead;
+    size_t minTail;
+    size_t minMask;
+    size_t sampleIndex;
+    size_t holdLength;
+
+    // Rechteck-Mittelwert
+    std::vector<float> boxRing;
+    size_t boxPos;
+    double boxSum;
+    size_t boxLength;
+
+    // Release
+    float releaseState;
+    float sustain;
+
+    // Messung
+    float currentGain;
+    float inputPeak;
+    float outputPeak;
+};
+
+} // namespace VR_DAW
@@ -0,0 +1,117 @@
+#include "audio/processing/AnalysisCache.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace VRMusicStudio {
+
+AnalysisCacheFiles::AnalysisCacheFiles(const std::string& subdirectory, const std::string& extension)
+    : m_extension(extension)
+{
+    std::error_code error;
+    const auto temp = std::filesystem::temp_directory_path(error);
+    if (!error) {
+        m_directory = (temp / "VRMusicStudio" / subdirectory).string();
+    }
+}
+
+void AnalysisCacheFiles::setDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_directory = directory;
+}
+
+std::string AnalysisCacheFiles::fileFor(const std::string& key) const {
+    std::string directory;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        directory = m_directory;
+    }
+    if (directory.empty()) return {};
+
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << std::hash<std::string>{}(key) << '.' << m_extension;
+    return (std::filesystem::path(directory) / name.str()).string();
+}
+
+bool AnalysisCacheFiles::load(const std::string& key,
+                              const std::function<bool(std::istream&, size_t)>& read) const {
+    const std::string file = fileFor(key);
+    if (file.empty()) return false;
+
+    std::error_code error;
+    const auto fileSize = std::filesystem::file_size(file, error);
+    if (error) return false;
+
+    std::ifstream stream(file);
+    if (!stream) return false;
+
+    // Bei einer Hash-Kollision steht hier ein anderer Schlüssel
+    std::string storedKey;
+    if (!std::getline(stream, storedKey) || storedKey != key) return false;
+    return read(stream, static_cast<size_t>(fileSize));
+}
+
+void AnalysisCacheFiles::save(const std::string& key, const std::function<void(std::ostream&)>& write) const {
+    const std::string file = fileFor(key);
+    if (file.empty()) return;
+
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(file).parent_path(), error);
+    if (error) return;
+
+    // Erst in eine eigene Datei schreiben, dann umbenennen
+    std::ostringstream temporary;
+    temporary << file << '.' << std::hash<std::thread::id>{}(std::this_thread::get_id());
+    {
+        std::ofstream stream(temporary.str(), std::ios::trunc);
+        if (!stream) return;
+        stream << key << '\n';
+        write(stream);
+        if (!stream) {
+            stream.close();
+            std::filesystem::remove(temporary.str(), error);
+            return;
+        }
+    }
+    std::filesystem::rename(temporary.str(), file, error);
+    if (error) std::filesystem::remove(temporary.str(), error);
+}
+
+std::string AnalysisCacheFiles::fileKey(const std::string& path) {
+    if (path.empty()) return {};
+
+    std::error_code error;
+    const auto size = std::filesystem::file_size(path, error);
+    if (error) return {};
+    const auto modified = std::filesystem::last_write_time(path, error);
+    if (error) return {};
+
+    std::ostringstream key;
+    key << std::filesystem::absolute(path, error).string()
+        << '|' << size
+        << '|' << modified.time_since_epoch().count();
+    return key.str();
+}
+
+bool AnalysisCacheFiles::readPositions(std::istream& stream, size_t fileSize, std::vector<size_t>& positions) {
+    size_t count = 0;
+    if (!(stream >> count)) return false;
+    // Jeder Eintrag braucht mindestens eine Ziffer und einen Trenner
+    if (count > fileSize / 2) return false;
+    positions.resize(count);
+    for (auto& position : positions) {
+        if (!(stream >> position)) return false;
+    }
+    return true;
+}
+
+void AnalysisCacheFiles::writePositions(std::ostream& stream, const std::vector<size_t>& positions) {
+    stream << positions.size() << '\n';
+    for (size_t position : positions) {
+        stream << position << '\n';
+    }
+}
+
+} // namespace VRMusicStudio
@@ -9,6 +9,8 @@ EffectEngine::EffectEngine()
     , m_blockSize(512)
     , m_numChannels(2)
     , m_isProcessing(false)
+    , m_sleepEnabled(true)
+    , m_outputSilent(false)
 {
 }
 
@@ -45,10 +47,28 @@ void EffectEngine::process(float* buffer, int numFrames)
         return;
     }
 
-    // Process through effect chain
-    for (auto& effect : m_effects) {
-        effect->process(buffer, numFrames);
+    const size_t numSamples = static_cast<size_t>(numFrames) * static_cast<size_t>(m_numChannels);
+    if (!m_sleepEnabled) {
+        for (auto& effect : m_effects) {
+            effect->process(buffer, numFrames);
+        }
+        m_outputSilent = false;
+        return;
     }
+
+    // The silence flag follows the buffer through the chain; a sleeping
+    // effect leaves the (silent) buffer untouched
+    bool silent = isSilent(buffer, numSamples);
+    for (size_t i = 0; i < m_effects.size(); ++i) {
+        const double tail = m_effects[i]->getTailSeconds();
+        const int64_t tailFrames = tail < 0.0 ? -1 : static_cast<int64_t>(tail * m_sampleRate);
+        if (!m_sleepStates[i].update(silent, static_cast<size_t>(numFrames), tailFrames)) {
+            continue;
+        }
+        m_effects[i]->process(buffer, numFrames);
+        silent = isSilent(buffer, numSamples);
+    }
+    m_outputSilent = silent;
 }
 
 void EffectEngine::addEffect(std::shared_ptr<AudioEffect> effect)
@@ -57,6 +77,7 @@ void EffectEngine::addEffect(std::shared_ptr<AudioEffect> effect)
         throw std::invalid_argument("Effect cannot be null");
     }
     m_effects.push_back(effect);
+    m_sleepStates.emplace_back();
     updateEffect(effect);
 }
 
@@ -64,6 +85,7 @@ void EffectEngine::removeEffect(std::shared_ptr<AudioEffect> effect)
 {
     auto it = std::find(m_effects.begin(), m_effects.end(), effect);
     if (it != m_effects.end()) {
+        m_sleepStates.erase(m_sleepStates.begin() + (it - m_effects.begin()));
         m_effects.erase(it);
     }
 }
@@ -83,6 +105,33 @@ bool EffectEngine::isProcessing() const
     return m_isProcessing;
 }
 
+void EffectEngine::setSleepEnabled(bool enabled)
+{
+    m_sleepEnabled = enabled;
+    for (auto& state : m_sleepStates) {
+        state.reset();
+    }
+}
+
+bool EffectEngine::isSleepEnabled() const
+{
+    return m_sleepEnabled;
+}
+
+bool EffectEngine::isEffectSleeping(const std::shared_ptr<AudioEffect>& effect) const
+{
+    auto it = std::find(m_effects.begin(), m_effects.end(), effect);
+    if (it == m_effects.end()) {
+        return false;
+    }
+    return m_sleepStates[it - m_effects.begin()].isSleeping();
+}
+
+bool EffectEngine::isOutputSilent() const
+{
+    return m_outputSilent;
+}
+
 void EffectEngine::updateEffects()
 {
     for (auto& effect : m_effects) {
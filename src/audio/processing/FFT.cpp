@@ -0,0 +1,80 @@
+#include "audio/processing/FFT.hpp"
+#include "audio/processing/DspMath.hpp"
+#include <fftw3.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+namespace VRMusicStudio {
+
+namespace {
+
+// Der FFTW-Planer ist nicht threadsicher, execute dagegen schon
+std::mutex& plannerMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+} // namespace
+
+struct RealFFT::Plans {
+    float* real = nullptr;
+    fftwf_complex* spectrum = nullptr;
+    fftwf_plan forward = nullptr;
+    fftwf_plan inverse = nullptr;
+};
+
+RealFFT::RealFFT(size_t size)
+    : m_size(size)
+    , m_plans(new Plans())
+{
+    if (size < 2 || (size & (size - 1)) != 0) {
+        delete m_plans;
+        throw std::invalid_argument("FFT-Größe muss eine Zweierpotenz sein");
+    }
+
+    m_plans->real = fftwf_alloc_real(m_size);
+    m_plans->spectrum = fftwf_alloc_complex(getNumBins());
+
+    std::lock_guard<std::mutex> lock(plannerMutex());
+    const int n = static_cast<int>(m_size);
+    m_plans->forward = fftwf_plan_dft_r2c_1d(n, m_plans->real, m_plans->spectrum, FFTW_ESTIMATE);
+    m_plans->inverse = fftwf_plan_dft_c2r_1d(n, m_plans->spectrum, m_plans->real, FFTW_ESTIMATE);
+}
+
+RealFFT::~RealFFT() {
+    {
+        std::lock_guard<std::mutex> lock(plannerMutex());
+        if (m_plans->forward) fftwf_destroy_plan(m_plans->forward);
+        if (m_plans->inverse) fftwf_destroy_plan(m_plans->inverse);
+    }
+    fftwf_free(m_plans->real);
+    fftwf_free(m_plans->spectrum);
+    delete m_plans;
+}
+
+void RealFFT::forward(const float* input, std::complex<float>* output) {
+    std::memcpy(m_plans->real, input, m_size * sizeof(float));
+    fftwf_execute(m_plans->forward);
+    // fftwf_complex und std::complex<float> sind layoutkompatibel
+    std::memcpy(static_cast<void*>(output), m_plans->spectrum, getNumBins() * sizeof(fftwf_complex));
+}
+
+void RealFFT::inverse(const std::complex<float>* input, float* output) {
+    // c2r überschreibt seine Eingabe, deshalb immer über den internen Puffer
+    std::memcpy(m_plans->spectrum, input, getNumBins() * sizeof(fftwf_complex));
+    fftwf_execute(m_plans->inverse);
+    std::memcpy(output, m_plans->real, m_size * sizeof(float));
+}
+
+std::vector<float> RealFFT::hannWindow(size_t size) {
+    std::vector<float> window(size);
+    for (size_t i = 0; i < size; ++i) {
+        window[i] = static_cast<float>(0.5 - 0.5 * std::cos(kTwoPi * static_cast<double>(i) / static_cast<double>(size)));
+    }
+    return window;
+}
+
+} // namespace VRMusicStudio
@@ -0,0 +1,408 @@
+#include "audio/processing/ModalBank.hpp"
+#include "audio/processing/DspMath.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace VRMusicStudio {
+
+namespace {
+
+constexpr float kMiddleC = 261.63f;
+
+// Ideale Kreismembran (Bessel-Nullstellen), relativ zur (0,1)-Mode
+constexpr float kMembraneRatios[] = {1.0f, 1.59f, 2.14f, 2.30f, 2.65f, 2.92f, 3.16f, 3.50f};
+
+// Dichte, unharmonische Modensätze für Becken; fester Seed, damit jede
+// Instanz gleich klingt
+ModalBank::Preset plate(int count, float maxRatio, float decay, uint32_t seed) {
+    ModalBank::Preset preset;
+    preset.modes.reserve(static_cast<size_t>(count));
+    auto random = [&seed]() {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return static_cast<float>(seed >> 8) / 16777216.0f;
+    };
+    for (int i = 0; i < count; ++i) {
+        // Exponentiell verteilt: gleich viele Moden pro Oktave
+        const float ratio = std::exp(random() * std::log(maxRatio));
+        const float gain = (0.4f + 0.6f * random()) / std::sqrt(ratio);
+        preset.modes.push_back({ratio, decay * std::pow(ratio, -0.35f) + 0.05f, gain, 0.0f});
+    }
+
+    // Summe der Modenenergie = 1, sonst wächst die Lautstärke mit der Modenzahl
+    float energy = 0.0f;
+    for (const auto& mode : preset.modes) energy += mode.gain * mode.gain;
+    const float norm = 1.0f / std::sqrt(std::max(energy, 1e-6f));
+    for (auto& mode : preset.modes) mode.gain *= norm;
+    return preset;
+}
+
+ModalBank::Preset membrane(const float (&decays)[8], float contactTime) {
+    ModalBank::Preset preset;
+    for (int i = 0; i < 8; ++i) {
+        // (0,n)-Moden sind rotationssymmetrisch und in der Mitte am stärksten,
+        // die übrigen haben dort einen Knoten
+        const bool symmetric = i == 0 || i == 3 || i == 7;
+        preset.modes.push_back({kMembraneRatios[i], decays[i], 1.0f / (1.0f + 0.5f * i), symmetric ? 1.0f : 2.0f});
+    }
+    preset.contactTime = contactTime;
+    preset.strikePosition = 0.3f;
+    return preset;
+}
+
+} // namespace
+
+// Stäbe: Marimba und Vibraphon auf 1:4:10 gestimmt, Xylophon auf 1:3:6,
+// Glockenspiel ungestimmt (freier Stab). Ordnung = Schwingungsbäuche entlang
+// des Stabs, ein Anschlag in der Mitte lässt die geraden Moden aus.
+ModalBank::Preset ModalBank::marimba() {
+    Preset preset;
+    preset.modes = {{1.0f, 1.5f, 1.0f, 1.0f}, {3.99f, 0.5f, 0.35f, 2.0f},
+                    {10.0f, 0.15f, 0.15f, 3.0f}, {18.6f, 0.08f, 0.05f, 4.0f}};
+    preset.contactTime = 0.0012f;
+    preset.decayPitchScale = 0.6f;
+    preset.strikePosition = 0.4f;
+    preset.gain = 0.5f;
+    return preset;
+}
+
+ModalBank::Preset ModalBank::xylophone() {
+    Preset preset;
+    preset.modes = {{1.0f, 0.6f, 1.0f, 1.0f}, {3.0f, 0.3f, 0.5f, 2.0f},
+                    {6.0f, 0.15f, 0.25f, 3.0f}, {9.9f, 0.08f, 0.1f, 4.0f}};
+    preset.contactTime = 0.0004f;
+    preset.decayPitchScale = 0.6f;
+    preset.strikePosition = 0.4f;
+    preset.gain = 0.4f;
+    return preset;
+}
+
+ModalBank::Preset ModalBank::vibraphone() {
+    Preset preset;
+    preset.modes = {{1.0f, 6.0f, 1.0f, 1.0f}, {3.98f, 2.5f, 0.25f, 2.0f}, {9.98f, 1.0f, 0.1f, 3.0f}};
+    preset.contactTime = 0.0009f;
+    preset.decayPitchScale = 0.4f;
+    preset.releaseDecay = 0.15f;
+    preset.strikePosition = 0.4f;
+    preset.tremoloRate = 5.0f;
+    preset.tremoloDepth = 0.3f;
+    preset.gain = 0.5f;
+    return preset;
+}
+
+ModalBank::Preset ModalBank::glockenspiel() {
+    Preset preset;
+    preset.modes = {{1.0f, 3.0f, 1.0f, 1.0f}, {2.756f, 1.5f, 0.4f, 2.0f},
+                    {5.404f, 0.8f, 0.25f, 3.0f}, {8.933f, 0.4f, 0.1f, 4.0f}};
+    preset.contactTime = 0.0003f;
+    preset.decayPitchScale = 0.3f;
+    preset.strikePosition = 0.4f;
+    preset.gain = 0.4f;
+    return preset;
+}
+
+ModalBank::Preset ModalBank::tubularBells() {
+    // Moden eines freien Rohrs; der wahrgenommene Schlagton liegt eine Oktave
+    // unter der vierten Mode, die Tabelle ist auf ihn bezogen
+    Preset preset;
+    preset.modes = {{0.224f, 4.0f, 0.1f, 0.0f}, {0.618f, 6.0f, 0.3f, 0.0f}, {1.209f, 6.0f, 0.6f, 0.0f},
+                    {2.0f, 5.0f, 1.0f, 0.0f}, {2.987f, 4.0f, 0.8f, 0.0f}, {4.174f, 3.0f, 0.6f, 0.0f},
+                    {5.556f, 2.0f, 0.4f, 0.0f}};
+    preset.contactTime = 0.0005f;
+    preset.releaseDecay = 1.0f;
+    preset.gain = 0.3f;
+    return preset;
+}
+
+ModalBank::Preset ModalBank::timpani() {
+    // Luftlast verschiebt die (n,1)-Moden fast harmonisch; die Note ist (1,1)
+    Preset preset;
+    preset.modes = {{0.63f, 0.25f, 0.4f, 1.0f}, {1.0f, 3.0f, 1.0f, 2.0f}, {1.5f, 2.5f, 0.6f, 2.0f},
+                    {1.65f, 0.6f, 0.2f, 1.0f}, {1.98f, 2.0f, 0.45f, 2.0f}, {2.44f, 1.5f, 0.3f, 2.0f},
+                    {2.9f, 1.2f, 0.2f, 2.0f}, {3.32f, 0.9f, 0.1f, 2.0f}};
+    preset.contactTime = 0.003f;
+    preset.noiseLevel = 0.05f;
+    preset.noiseDecay = 0.01f;
+    preset.releaseDecay = 0.3f;
+    preset.strikePosition = 0.25f;
+    preset.gain = 0.5f;
+    return preset;
+}
+
+ModalBank::Preset ModalBank::cymbal() {
+    Preset preset = plate(240, 40.0f, 3.0f, 0x5EEDC0DEu);
+    preset.contactTime = 0.0003f;
+    preset.noiseLevel = 1.0f;
+    preset.noiseDecay = 0.03f;
+    preset.noiseMix = 0.15f;
+    preset.releaseDecay = 0.1f;
+    preset.strikePosition = 0.8f;
+    preset.gain = 0.15f;
+    return preset;
+}
+
+ModalBank::Preset ModalBank::hiHat() {
+    Preset preset = plate(160, 25.0f, 1.0f, 0x4A7C15EDu);
+    preset.contactTime = 0.0002f;
+    preset.noiseLevel = 1.0f;
+    preset.noiseDecay = 0.02f;
+    preset.noiseMix = 0.3f;
+    preset.releaseDecay = 0.05f;
+    preset.strikePosition = 0.8f;
+    preset.gain = 0.15f;
+    return preset;
+}
+
+ModalBank::Preset ModalBank::kick() {
+    Preset preset = membrane({0.5f, 0.25f, 0.15f, 0.12f, 0.1f, 0.08f, 0.06f, 0.05f}, 0.004f);
+    preset.noiseLevel = 0.1f;
+    preset.noiseDecay = 0.005f;
+    preset.noiseMix = 0.05f;
+    preset.strikePosition = 0.5f;
+    preset.gain = 0.8f;
+    return preset;
+}
+
+ModalBank::Preset ModalBank::snare() {
+    Preset preset = membrane({0.3f, 0.2f, 0.15f, 0.12f, 0.1f, 0.1f, 0.08f, 0.08f}, 0.0015f);
+    // Schnarrsaiten: Rauschen auf Fell und Ausgang
+    preset.noiseLevel = 0.3f;
+    preset.noiseDecay = 0.12f;
+    preset.noiseMix = 0.5f;
+    preset.gain = 0.45f;
+    return preset;
+}
+
+ModalBank::Preset ModalBank::tom() {
+    Preset preset = membrane({0.8f, 0.5f, 0.35f, 0.3f, 0.25f, 0.2f, 0.2f, 0.15f}, 0.002f);
+    preset.gain = 0.45f;
+    return preset;
+}
+
+ModalBank::ModalBank(const Preset& preset, int maxVoices, double sampleRate)
+    : m_preset(preset)
+    , m_sampleRate(sampleRate)
+    , m_paddedModes((preset.modes.size() + 3) & ~size_t(3))
+    , m_excitation{}
+    , m_direct{}
+    , m_lanes{}
+    , m_gain(1.0f)
+    , m_decayScale(1.0f)
+    , m_tremoloPhase(0.0)
+    , m_startCounter(0)
+    , m_noiseState(0x2545F491u)
+{
+    m_voices.resize(static_cast<size_t>(std::max(1, maxVoices)));
+    for (auto& voice : m_voices) {
+        for (auto* values : {&voice.poleRe, &voice.poleIm, &voice.stateRe, &voice.stateIm, &voice.gain, &voice.decay}) {
+            values->assign(m_paddedModes, 0.0f);
+        }
+    }
+}
+
+ModalBank::~ModalBank() = default;
+
+void ModalBank::noteOn(int note, float velocity) {
+    const float frequency = 440.0f * std::pow(2.0f, (note - 69) / 12.0f);
+    strike(note, frequency, velocity, m_preset.strikePosition);
+}
+
+void ModalBank::strike(int key, float frequency, float velocity, float position) {
+    if (velocity <= 0.0f || frequency <= 0.0f) return;
+    velocity = std::min(velocity, 1.0f);
+    position = std::clamp(position, 0.0f, 1.0f);
+
+    Voice& voice = *allocateVoice(key);
+    voice.key = key;
+    voice.released = false;
+    voice.startOrder = ++m_startCounter;
+    voice.frequency = frequency;
+
+    // Amplitude je Mode aus dem Anschlagpunkt, Abklingzeit aus der Tonhöhe
+    const float pitchScale = m_preset.decayPitchScale > 0.0f
+        ? std::pow(kMiddleC / frequency, m_preset.decayPitchScale) : 1.0f;
+    for (size_t i = 0; i < m_preset.modes.size(); ++i) {
+        const Mode& mode = m_preset.modes[i];
+        const float weight = mode.shape > 0.0f
+            ? std::fabs(std::sin(static_cast<float>(kPi) * mode.shape * position)) : 1.0f;
+        voice.gain[i] = mode.gain * weight;
+        voice.decay[i] = std::max(mode.decay * pitchScale * m_decayScale, 0.001f);
+    }
+    setPoles(voice, false);
+
+    // Halbsinus-Impuls mit Fläche 1; harte Anschläge sind kürzer und heller
+    const float contact = m_preset.contactTime * (2.0f - velocity);
+    voice.contactSamples = std::max(1, static_cast<int>(std::lround(contact * m_sampleRate)));
+    voice.contactPosition = 0;
+    voice.pulseGain = velocity * static_cast<float>(kPi) / (2.0f * voice.contactSamples);
+    voice.noiseLevel = m_preset.noiseLevel * velocity;
+    voice.active = true;
+}
+
+void ModalBank::noteOff(int key) {
+    if (m_preset.releaseDecay <= 0.0f) return;
+    for (auto& voice : m_voices) {
+        if (voice.active && !voice.released && voice.key == key) {
+            voice.released = true;
+            setPoles(voice, true);
+        }
+    }
+}
+
+void ModalBank::allNotesOff() {
+    if (m_preset.releaseDecay <= 0.0f) return;
+    for (auto& voice : m_voices) {
+        if (voice.active && !voice.released) {
+            voice.released = true;
+            setPoles(voice, true);
+        }
+    }
+}
+
+int ModalBank::getActiveVoices() const {
+    int count = 0;
+    for (const auto& voice : m_voices) {
+        if (voice.active) ++count;
+    }
+    return count;
+}
+
+ModalBank::Voice* ModalBank::allocateVoice(int key) {
+    // Klingende Taste erneut anschlagen, die Moden schwingen weiter
+    for (auto& voice : m_voices) {
+        if (voice.active && voice.key == key) return &voice;
+    }
+
+    Voice* target = nullptr;
+    for (auto& voice : m_voices) {
+        if (!voice.active) {
+            target = &voice;
+            break;
+        }
+        if (!target || voice.startOrder < target->startOrder) target = &voice;
+    }
+
+    std::fill(target->stateRe.begin(), target->stateRe.end(), 0.0f);
+    std::fill(target->stateIm.begin(), target->stateIm.end(), 0.0f);
+    return target;
+}
+
+void ModalBank::setPoles(Voice& voice, bool damped) const {
+    const double nyquistLimit = 0.45 * m_sampleRate;
+    for (size_t i = 0; i < m_preset.modes.size(); ++i) {
+        const double frequency = static_cast<double>(voice.frequency) * m_preset.modes[i].ratio;
+        if (frequency >= nyquistLimit) {
+            voice.poleRe[i] = voice.poleIm[i] = voice.gain[i] = 0.0f;
+            continue;
+        }
+        const double decay = damped ? std::min(voice.decay[i], m_preset.releaseDecay) : voice.decay[i];
+        const double radius = std::pow(10.0, -3.0 / (decay * m_sampleRate));
+        const double w = 2.0 * kPi * frequency / m_sampleRate;
+        voice.poleRe[i] = static_cast<float>(radius * std::cos(w));
+        voice.poleIm[i] = static_cast<float>(radius * std::sin(w));
+    }
+}
+
+bool ModalBank::renderExcitation(Voice& voice, int numSamples) {
+    const bool pulse = voice.contactPosition < voice.contactSamples;
+    const bool noise = voice.noiseLevel > 1e-5f;
+    if (!pulse && !noise) return false;
+
+    // Rauschen so skaliert, dass die Modenenergie kaum von noiseDecay abhängt
+    const float noiseFall = std::exp(-1.0f / (m_preset.noiseDecay * static_cast<float>(m_sampleRate)));
+    const float noiseScale = 1.0f / std::sqrt(0.5f * m_preset.noiseDecay * static_cast<float>(m_sampleRate));
+
+    for (int i = 0; i < numSamples; ++i) {
+        float x = 0.0f;
+        if (voice.contactPosition < voice.contactSamples) {
+            x = voice.pulseGain * std::sin(static_cast<float>(kPi) * (voice.contactPosition + 0.5f) / voice.contactSamples);
+            ++voice.contactPosition;
+        }
+        if (voice.noiseLevel > 1e-5f) {
+            const float n = nextNoise() * voice.noiseLevel;
+            x += n * noiseScale;
+            m_direct[i] += n * m_preset.noiseMix;
+            voice.noiseLevel *= noiseFall;
+        }
+        m_excitation[i] = x;
+    }
+    return true;
+}
+
+void ModalBank::renderModes(Voice& voice, int numSamples, bool excited) {
+    using SimdOps::Float4;
+
+    // Vier Moden pro Durchlauf; die Spuren werden erst am Blockende summiert
+    for (size_t m = 0; m < m_paddedModes; m += 4) {
+        const Float4 pr = Float4::load(&voice.poleRe[m]);
+        const Float4 pi = Float4::load(&voice.poleIm[m]);
+        Float4 zr = Float4::load(&voice.stateRe[m]);
+        Float4 zi = Float4::load(&voice.stateIm[m]);
+        float* lanes = m_lanes.data();
+
+        if (excited) {
+            const Float4 gain = Float4::load(&voice.gain[m]);
+            for (int i = 0; i < numSamples; ++i) {
+                const Float4 re = pr * zr - pi * zi + Float4::set1(m_excitation[i]) * gain;
+                zi = pr * zi + pi * zr;
+                zr = re;
+                (Float4::load(lanes + 4 * i) + zi).store(lanes + 4 * i);
+            }
+        } else {
+            for (int i = 0; i < numSamples; ++i) {
+                const Float4 re = pr * zr - pi * zi;
+                zi = pr * zi + pi * zr;
+                zr = re;
+                (Float4::load(lanes + 4 * i) + zi).store(lanes + 4 * i);
+            }
+        }
+
+        zr.store(&voice.stateRe[m]);
+        zi.store(&voice.stateIm[m]);
+    }
+}
+
+float ModalBank::nextNoise() {
+    m_noiseState ^= m_noiseState << 13;
+    m_noiseState ^= m_noiseState >> 17;
+    m_noiseState ^= m_noiseState << 5;
+    return static_cast<float>(m_noiseState >> 8) / 8388608.0f - 1.0f;
+}
+
+void ModalBank::process(float* out, int numSamples) {
+    const float gain = m_gain * m_preset.gain;
+    const double tremoloStep = 2.0 * kPi * m_preset.tremoloRate / m_sampleRate;
+
+    for (int offset = 0; offset < numSamples; offset += kBlockSize) {
+        const int count = std::min(kBlockSize, numSamples - offset);
+        std::fill(m_lanes.begin(), m_lanes.begin() + 4 * count, 0.0f);
+        std::fill(m_direct.begin(), m_direct.begin() + count, 0.0f);
+
+        for (auto& voice : m_voices) {
+            if (!voice.active) continue;
+            const bool excited = renderExcitation(voice, count);
+            renderModes(voice, count, excited);
+
+            // Ausgeklungen: Anregung vorbei und Energie unter -120 dB
+            if (voice.contactPosition >= voice.contactSamples && voice.noiseLevel <= 1e-5f) {
+                const float energy = SimdOps::sumOfSquares(voice.stateRe.data(), m_paddedModes) +
+                                     SimdOps::sumOfSquares(voice.stateIm.data(), m_paddedModes);
+                if (energy < 1e-12f) voice.active = false;
+            }
+        }
+
+        for (int i = 0; i < count; ++i) {
+            const float* lanes = &m_lanes[4 * i];
+            float sample = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + m_direct[i];
+            if (m_preset.tremoloDepth > 0.0f) {
+                sample *= 1.0f - m_preset.tremoloDepth * 0.5f * (1.0f - static_cast<float>(std::cos(m_tremoloPhase)));
+                m_tremoloPhase += tremoloStep;
+            }
+            out[offset + i] += sample * gain;
+        }
+        if (m_tremoloPhase > 2.0 * kPi) m_tremoloPhase -= 2.0 * kPi;
+    }
+}
+
+} // namespace VRMusicStudio
@@ -0,0 +1,370 @@
+#include "audio/processing/OnsetDetector.hpp"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace VRMusicStudio {
+
+namespace {
+
+constexpr float kSilenceEnergy = 1e-8f;
+constexpr float kLogCompression = 100.0f;
+constexpr size_t kRefineBlock = 32;
+
+} // namespace
+
+OnsetDetector::OnsetDetector()
+    : m_sampleRate(44100.0)
+    , m_thresholdScale(2.0f)
+    , m_thresholdOffset(0.3f)
+    , m_minInterval(0)
+    , m_prevHfc(0.0f)
+    , m_inputPos(0)
+    , m_hopFill(0)
+    , m_samplesSeen(0)
+    , m_framesAnalyzed(0)
+    , m_lastOnset(0)
+    , m_odf{}
+    , m_odfMean(0.0f)
+{
+}
+
+OnsetDetector::~OnsetDetector() = default;
+
+void OnsetDetector::prepare(double sampleRate, const Settings& settings) {
+    m_sampleRate = sampleRate;
+    m_settings = settings;
+
+    // Hohe Empfindlichkeit senkt sowohl den Median-Faktor als auch den festen Anteil
+    const float sensitivity = std::clamp(settings.sensitivity, 0.0f, 1.0f);
+    m_thresholdScale = 1.0f + (1.0f - sensitivity) * 2.0f;
+    m_thresholdOffset = 0.1f + (1.0f - sensitivity) * 0.4f;
+    m_minInterval = static_cast<size_t>(std::max(0.0f, settings.minIntervalMs) * 0.001 * sampleRate);
+
+    const size_t bins = kFrameSize / 2 + 1;
+    m_fft = std::make_unique<RealFFT>(kFrameSize);
+    m_window = RealFFT::hannWindow(kFrameSize);
+    m_input.assign(kFrameSize, 0.0f);
+    m_frame.assign(kFrameSize, 0.0f);
+    m_spectrum.assign(bins, {0.0f, 0.0f});
+    m_magnitude.assign(bins, 0.0f);
+    m_prevMagnitude.assign(bins, 0.0f);
+    m_phase.assign(bins, 0.0f);
+    m_prevPhase.assign(bins, 0.0f);
+    m_prevPrevPhase.assign(bins, 0.0f);
+    reset();
+}
+
+void OnsetDetector::reset() {
+    std::fill(m_input.begin(), m_input.end(), 0.0f);
+    std::fill(m_prevMagnitude.begin(), m_prevMagnitude.end(), 0.0f);
+    std::fill(m_prevPhase.begin(), m_prevPhase.end(), 0.0f);
+    std::fill(m_prevPrevPhase.begin(), m_prevPrevPhase.end(), 0.0f);
+    std::fill(std::begin(m_odf), std::end(m_odf), 0.0f);
+    m_prevHfc = 0.0f;
+    m_inputPos = 0;
+    m_hopFill = 0;
+    m_samplesSeen = 0;
+    m_framesAnalyzed = 0;
+    m_lastOnset = 0;
+    m_odfMean = 0.0f;
+}
+
+size_t OnsetDetector::process(const float* input, size_t numFrames, uint64_t* onsets, size_t maxOnsets) {
+    size_t found = 0;
+    for (size_t i = 0; i < numFrames; ++i) {
+        m_input[m_inputPos] = input[i];
+        m_inputPos = (m_inputPos + 1) % kFrameSize;
+        ++m_samplesSeen;
+
+        if (++m_hopFill < kHopSize) continue;
+        m_hopFill = 0;
+
+        // Verlauf der Detektionsfunktion weiterschieben, neuester Wert am Ende
+        std::copy(std::begin(m_odf) + 1, std::end(m_odf), std::begin(m_odf));
+        m_odf[kHistory + kLookahead] = analyzeFrame();
+        ++m_framesAnalyzed;
+
+        uint64_t position = 0;
+        if (pickPeak(position) && found < maxOnsets) {
+            onsets[found++] = position;
+        }
+    }
+    return found;
+}
+
+float OnsetDetector::analyzeFrame() {
+    for (size_t i = 0; i < kFrameSize; ++i) {
+        m_frame[i] = m_input[(m_inputPos + i) % kFrameSize] * m_window[i];
+    }
+    m_fft->forward(m_frame.data(), m_spectrum.data());
+
+    const size_t bins = m_spectrum.size();
+    float energy = 0.0f;
+    for (size_t k = 0; k < bins; ++k) {
+        m_magnitude[k] = std::abs(m_spectrum[k]);
+        m_phase[k] = std::arg(m_spectrum[k]);
+        energy += m_magnitude[k] * m_magnitude[k];
+    }
+
+    float value = 0.0f;
+    switch (m_settings.method) {
+        case Method::SpectralFlux:
+            for (size_t k = 0; k < bins; ++k) {
+                const float rise = std::log1p(kLogCompression * m_magnitude[k]) - std::log1p(kLogCompression * m_prevMagnitude[k]);
+                if (rise > 0.0f) value += rise;
+            }
+            break;
+
+        case Method::ComplexDomain:
+            // Abweichung vom aus den letzten zwei Frames vorhergesagten Spektrum,
+            // nur für steigende Magnituden (rektifiziert)
+            for (size_t k = 0; k < bins; ++k) {
+                if (m_magnitude[k] < m_prevMagnitude[k]) continue;
+                const float predictedPhase = 2.0f * m_prevPhase[k] - m_prevPrevPhase[k];
+                value += std::abs(m_spectrum[k] - std::polar(m_prevMagnitude[k], predictedPhase));
+            }
+            break;
+
+        case Method::HighFrequencyContent: {
+            float hfc = 0.0f;
+            for (size_t k = 0; k < bins; ++k) {
+                hfc += static_cast<float>(k) * m_magnitude[k] * m_magnitude[k];
+            }
+            hfc = std::sqrt(hfc);
+            value = std::max(0.0f, hfc - m_prevHfc);
+            m_prevHfc = hfc;
+            break;
+        }
+    }
+
+    m_prevMagnitude.swap(m_magnitude);
+    m_prevPrevPhase.swap(m_prevPhase);
+    m_prevPhase.swap(m_phase);
+
+    return energy < kSilenceEnergy ? 0.0f : value;
+}
+
+bool OnsetDetector::pickPeak(uint64_t& position) {
+    const float value = m_odf[kHistory];
+
+    // Laufender Mittelwert (~1 s) für den festen Anteil der Schwelle; am Anfang
+    // kumulativ, damit die Schwelle nicht bei null startet
+    const float meanCoefficient = std::max(0.01f, 1.0f / static_cast<float>(m_framesAnalyzed));
+    m_odfMean += (m_odf[kHistory + kLookahead] - m_odfMean) * meanCoefficient;
+
+    if (m_framesAnalyzed < kLookahead + 3 || value <= 0.0f) return false;
+
+    // Lokales Maximum inkl. Lookahead
+    for (size_t i = kHistory - 2; i <= kHistory + kLookahead; ++i) {
+        if (i == kHistory) continue;
+        if (i < kHistory ? m_odf[i] >= value : m_odf[i] > value) return false;
+    }
+
+    float window[kHistory + kLookahead + 1];
+    std::copy(std::begin(m_odf), std::end(m_odf), window);
+    const size_t count = kHistory + kLookahead + 1;
+    std::nth_element(window, window + count / 2, window + count);
+    const float threshold = m_thresholdScale * window[count / 2] + m_thresholdOffset * m_odfMean;
+    if (value <= threshold) return false;
+
+    // Frame des Kandidaten endet kLookahead Hops vor dem aktuellen; der größte
+    // Anstieg liegt etwa ein Viertel Frame vor seinem Ende
+    const uint64_t frameEnd = m_samplesSeen - kLookahead * kHopSize;
+    const uint64_t offset = kFrameSize / 4 + kHopSize / 2;
+    const uint64_t estimate = frameEnd > offset ? frameEnd - offset : 0;
+
+    if (m_lastOnset != 0 && estimate < m_lastOnset + m_minInterval) return false;
+    m_lastOnset = std::max<uint64_t>(estimate, 1);
+    position = estimate;
+    return true;
+}
+
+std::vector<size_t> OnsetDetector::detect(const float* data, size_t frames, int channels,
+                                          double sampleRate, const Settings& settings) {
+    std::vector<size_t> result;
+    if (!data || frames == 0) return result;
+
+    const size_t channelCount = static_cast<size_t>(std::max(1, channels));
+    std::vector<float> mono(frames + kFrameSize, 0.0f);
+    for (size_t i = 0; i < frames; ++i) {
+        float sum = 0.0f;
+        for (size_t c = 0; c < channelCount; ++c) sum += data[i * channelCount + c];
+        mono[i] = sum / static_cast<float>(channelCount);
+    }
+
+    OnsetDetector detector;
+    detector.prepare(sampleRate, settings);
+
+    // Mit einem Frame Stille nachlaufen lassen, damit auch Onsets am Ende erkannt werden
+    std::vector<uint64_t> found(mono.size() / kHopSize + 1);
+    const size_t count = detector.process(mono.data(), mono.size(), found.data(), found.size());
+
+    // Auf den Beginn des Attacks verfeinern: größter Energieanstieg in kurzen
+    // Blöcken, dann zum vorherigen Nulldurchgang, damit der Schnitt nicht knackt
+    for (size_t n = 0; n < count; ++n) {
+        const size_t estimate = static_cast<size_t>(found[n]);
+        const size_t searchStart = estimate > kFrameSize / 2 ? estimate - kFrameSize / 2 : 0;
+        const size_t searchEnd = std::min(frames, estimate + kHopSize);
+
+        size_t best = estimate;
+        float bestRise = 0.0f;
+        float previousEnergy = -1.0f;
+        for (size_t block = searchStart; block + kRefineBlock <= searchEnd; block += kRefineBlock) {
+            float energy = 0.0f;
+            for (size_t i = block; i < block + kRefineBlock; ++i) energy += mono[i] * mono[i];
+            if (previousEnergy >= 0.0f && energy - previousEnergy > bestRise) {
+                bestRise = energy - previousEnergy;
+                best = block;
+            }
+            previousEnergy = energy;
+        }
+
+        size_t onset = std::min(best, frames - 1);
+        for (size_t back = 0; back < kRefineBlock && onset > 0; ++back, --onset) {
+            if ((mono[onset - 1] <= 0.0f) != (mono[onset] <= 0.0f)) break;
+        }
+
+        if (result.empty() || onset > result.back()) {
+            result.push_back(onset);
+        }
+    }
+    return result;
+}
+
+std::vector<size_t> OnsetDetector::snapToOnsets(const std::vector<size_t>& grid,
+                                                const std::vector<size_t>& onsets,
+                                                size_t maxDistance) {
+    std::vector<size_t> result;
+    result.reserve(grid.size());
+
+    for (size_t point : grid) {
+        size_t snapped = point;
+        auto it = std::lower_bound(onsets.begin(), onsets.end(), point);
+        size_t bestDistance = maxDistance + 1;
+        if (it != onsets.end() && *it - point < bestDistance) {
+            bestDistance = *it - point;
+            snapped = *it;
+        }
+        if (it != onsets.begin() && point - *(it - 1) < bestDistance) {
+            snapped = *(it - 1);
+        }
+
+        // Zwei Rasterpunkte dürfen nicht auf denselben Onset fallen
+        if (!result.empty() && snapped <= result.back()) snapped = point;
+        if (result.empty() || snapped > result.back()) result.push_back(snapped);
+    }
+    return result;
+}
+
+// Hintergrund-Analyse
+
+OnsetAnalyzer& OnsetAnalyzer::getInstance() {
+    static OnsetAnalyzer instance;
+    return instance;
+}
+
+OnsetAnalyzer::OnsetAnalyzer()
+    : m_cache("onsets", "onsets", kMaxMemoryEntries, &OnsetAnalyzer::readMarkers, &OnsetAnalyzer::writeMarkers)
+    , m_shouldStop(false)
+{
+    m_worker = std::thread(&OnsetAnalyzer::run, this);
+}
+
+OnsetAnalyzer::~OnsetAnalyzer() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shouldStop = true;
+        m_jobs.clear();
+    }
+    m_condition.notify_all();
+    if (m_worker.joinable()) m_worker.join();
+}
+
+void OnsetAnalyzer::request(const std::shared_ptr<OnsetSlot>& slot, const std::string& path,
+                            std::shared_ptr<const std::vector<float>> data, int channels,
+                            double sampleRate, const OnsetDetector::Settings& settings) {
+    if (!slot || !data) return;
+
+    Job job;
+    job.slot = slot;
+    job.generation = slot->beginRequest();
+    job.path = path;
+    job.data = std::move(data);
+    job.channels = std::max(1, channels);
+    job.sampleRate = sampleRate;
+    job.settings = settings;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_condition.notify_one();
+}
+
+void OnsetAnalyzer::setCacheDirectory(const std::string& directory) {
+    m_cache.setDirectory(directory);
+}
+
+void OnsetAnalyzer::clearMemoryCache() {
+    m_cache.clearMemory();
+}
+
+void OnsetAnalyzer::run() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_shouldStop || !m_jobs.empty(); });
+            if (m_shouldStop) return;
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        {
+            auto slot = job.slot.lock();
+            if (!slot || !slot->isCurrent(job.generation)) continue;
+        }
+
+        const std::string key = makeKey(job);
+        std::shared_ptr<const OnsetMarkers> markers = m_cache.find(key);
+        if (!markers) {
+            auto analyzed = std::make_shared<OnsetMarkers>();
+            analyzed->frames = job.data->size() / static_cast<size_t>(job.channels);
+            analyzed->sampleRate = job.sampleRate;
+            analyzed->onsets = OnsetDetector::detect(job.data->data(), analyzed->frames, job.channels,
+                                                     job.sampleRate, job.settings);
+            m_cache.store(key, analyzed);
+            markers = std::move(analyzed);
+        }
+
+        auto slot = job.slot.lock();
+        if (slot && slot->isCurrent(job.generation)) {
+            slot->publish(std::move(markers));
+        }
+    }
+}
+
+std::string OnsetAnalyzer::makeKey(const Job& job) const {
+    const std::string fileKey = AnalysisCacheFiles::fileKey(job.path);
+    if (fileKey.empty()) return {};
+
+    std::ostringstream key;
+    key << fileKey
+        << '|' << static_cast<int>(job.settings.method)
+        << '|' << std::lround(job.settings.sensitivity * 100.0f)
+        << '|' << std::lround(job.settings.minIntervalMs);
+    return key.str();
+}
+
+bool OnsetAnalyzer::readMarkers(std::istream& stream, size_t fileSize, OnsetMarkers& markers) {
+    if (!(stream >> markers.frames >> markers.sampleRate)) return false;
+    return AnalysisCacheFiles::readPositions(stream, fileSize, markers.onsets);
+}
+
+void OnsetAnalyzer::writeMarkers(std::ostream& stream, const OnsetMarkers& markers) {
+    stream << markers.frames << ' ' << markers.sampleRate << ' ';
+    AnalysisCacheFiles::writePositions(stream, markers.onsets);
+}
+
+} // namespace VRMusicStudio
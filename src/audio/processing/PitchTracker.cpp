@@ -0,0 +1,237 @@
+#include "audio/processing/PitchTracker.hpp"
+#include "audio/processing/DspMath.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace VRMusicStudio {
+
+float PitchTracker::Estimate::midiNote() const {
+    return frequencyToMidi(frequency);
+}
+
+PitchTracker::PitchTracker()
+    : m_sampleRate(44100.0)
+    , m_minLag(2)
+    , m_maxLag(2)
+    , m_frameSize(0)
+    , m_hopSize(1)
+    , m_silenceEnergy(0.0f)
+    , m_inputFill(0)
+    , m_samplesSeen(0)
+{
+}
+
+PitchTracker::~PitchTracker() = default;
+
+void PitchTracker::prepare(double sampleRate, const Settings& settings) {
+    m_sampleRate = sampleRate;
+    m_settings = settings;
+
+    const float minFrequency = std::max(settings.minFrequency, 20.0f);
+    const float maxFrequency = std::clamp(settings.maxFrequency, minFrequency * 1.5f, static_cast<float>(sampleRate) * 0.25f);
+    m_minLag = std::max<size_t>(2, static_cast<size_t>(std::floor(sampleRate / maxFrequency)));
+    m_maxLag = std::max(m_minLag + 2, static_cast<size_t>(std::ceil(sampleRate / minFrequency)) + 1);
+
+    // YIN integriert über m_maxLag Samples und braucht dafür 2 * m_maxLag;
+    // die FFT ist groß genug für die lineare Autokorrelation des ganzen Frames
+    m_frameSize = 2 * m_maxLag;
+    m_hopSize = std::clamp<size_t>(static_cast<size_t>(std::max(settings.hopMs, 0.0f) * 0.001 * sampleRate), 1, m_frameSize);
+    m_silenceEnergy = std::pow(10.0f, settings.silenceDb / 10.0f);
+
+    const size_t fftSize = nextPowerOfTwo(2 * m_frameSize);
+    m_fft = std::make_unique<RealFFT>(fftSize);
+    m_input.assign(m_frameSize, 0.0f);
+    m_padded.assign(fftSize, 0.0f);
+    m_correlation.assign(fftSize, 0.0f);
+    m_prefixEnergy.assign(m_frameSize + 1, 0.0);
+    m_function.assign(m_maxLag + 1, 0.0f);
+    m_spectrum.assign(m_fft->getNumBins(), {0.0f, 0.0f});
+    m_windowSpectrum.assign(m_fft->getNumBins(), {0.0f, 0.0f});
+    reset();
+}
+
+void PitchTracker::reset() {
+    std::fill(m_input.begin(), m_input.end(), 0.0f);
+    m_inputFill = 0;
+    m_samplesSeen = 0;
+    m_latest = Estimate();
+}
+
+size_t PitchTracker::process(const float* input, size_t numFrames, Estimate* estimates, size_t maxEstimates) {
+    if (!m_fft) return 0;
+
+    size_t found = 0;
+    for (size_t i = 0; i < numFrames; ++i) {
+        m_input[m_inputFill++] = input[i];
+        ++m_samplesSeen;
+        if (m_inputFill < m_frameSize) continue;
+
+        analyzeFrame();
+        if (found < maxEstimates) {
+            estimates[found++] = m_latest;
+        }
+
+        // Frame um einen Hop weiterschieben
+        std::memmove(m_input.data(), m_input.data() + m_hopSize, (m_frameSize - m_hopSize) * sizeof(float));
+        m_inputFill = m_frameSize - m_hopSize;
+    }
+    return found;
+}
+
+void PitchTracker::analyzeFrame() {
+    const size_t frameSize = m_frameSize;
+    const size_t window = m_maxLag;
+    const float scale = 1.0f / static_cast<float>(m_fft->getSize());
+
+    m_latest = Estimate();
+    m_latest.position = m_samplesSeen - frameSize / 2;
+
+    m_prefixEnergy[0] = 0.0;
+    for (size_t i = 0; i < frameSize; ++i) {
+        m_prefixEnergy[i + 1] = m_prefixEnergy[i] + static_cast<double>(m_input[i]) * m_input[i];
+    }
+    if (m_prefixEnergy[frameSize] / frameSize < m_silenceEnergy) return;
+
+    std::copy(m_input.begin(), m_input.end(), m_padded.begin());
+    std::fill(m_padded.begin() + frameSize, m_padded.end(), 0.0f);
+    m_fft->forward(m_padded.data(), m_spectrum.data());
+
+    float lag = 0.0f;
+    float confidence = 0.0f;
+    if (m_settings.method == Method::YIN) {
+        // Kreuzkorrelation des ersten Fensters mit dem ganzen Frame
+        std::fill(m_padded.begin() + window, m_padded.end(), 0.0f);
+        m_fft->forward(m_padded.data(), m_windowSpectrum.data());
+        for (size_t k = 0; k < m_spectrum.size(); ++k) {
+            m_windowSpectrum[k] = m_spectrum[k] * std::conj(m_windowSpectrum[k]);
+        }
+        m_fft->inverse(m_windowSpectrum.data(), m_correlation.data());
+
+        // d(tau) = e(0) + e(tau) - 2 c(tau), kumulativ normiert
+        const double energy0 = m_prefixEnergy[window];
+        double runningSum = 0.0;
+        m_function[0] = 1.0f;
+        for (size_t tau = 1; tau <= m_maxLag; ++tau) {
+            const double energyTau = m_prefixEnergy[tau + window] - m_prefixEnergy[tau];
+            const double difference = std::max(0.0, energy0 + energyTau - 2.0 * m_correlation[tau] * scale);
+            runningSum += difference;
+            m_function[tau] = runningSum > 0.0 ? static_cast<float>(difference * tau / runningSum) : 1.0f;
+        }
+        lag = pickYin(confidence);
+    } else {
+        // Autokorrelation des Frames über das Leistungsspektrum
+        for (auto& bin : m_spectrum) {
+            bin = {std::norm(bin), 0.0f};
+        }
+        m_fft->inverse(m_spectrum.data(), m_correlation.data());
+
+        const double total = m_prefixEnergy[frameSize];
+        m_function[0] = 1.0f;
+        for (size_t tau = 1; tau <= m_maxLag; ++tau) {
+            const double m = m_prefixEnergy[frameSize - tau] + total - m_prefixEnergy[tau];
+            m_function[tau] = m > 0.0 ? static_cast<float>(2.0 * m_correlation[tau] * scale / m) : 0.0f;
+        }
+        lag = pickMpm(confidence);
+    }
+
+    if (lag <= 0.0f) return;
+    m_latest.confidence = std::clamp(confidence, 0.0f, 1.0f);
+    m_latest.voiced = m_latest.confidence >= m_settings.voicingThreshold;
+    m_latest.frequency = m_latest.voiced ? static_cast<float>(m_sampleRate / lag) : 0.0f;
+}
+
+float PitchTracker::pickYin(float& confidence) {
+    size_t best = 0;
+    for (size_t tau = m_minLag; tau < m_maxLag; ++tau) {
+        if (m_function[tau] < m_settings.threshold) {
+            // Bis zum Boden der Senke weiterlaufen
+            while (tau + 1 < m_maxLag && m_function[tau + 1] < m_function[tau]) ++tau;
+            best = tau;
+            break;
+        }
+    }
+    if (best == 0) {
+        // Keine Senke unter der Schwelle: globales Minimum mit geringer Konfidenz
+        best = m_minLag;
+        for (size_t tau = m_minLag + 1; tau < m_maxLag; ++tau) {
+            if (m_function[tau] < m_function[best]) best = tau;
+        }
+    }
+    confidence = 1.0f - m_function[best];
+    return interpolate(m_function.data(), best, m_function.size());
+}
+
+float PitchTracker::pickMpm(float& confidence) {
+    // Key-Maxima: je positiver Region nach dem ersten Nulldurchgang das Maximum
+    auto forEachKeyMaximum = [this](auto&& visit) {
+        size_t tau = 1;
+        while (tau < m_maxLag && m_function[tau] > 0.0f) ++tau;
+        while (tau < m_maxLag) {
+            while (tau < m_maxLag && m_function[tau] <= 0.0f) ++tau;
+            size_t peak = tau;
+            while (tau < m_maxLag && m_function[tau] > 0.0f) {
+                if (m_function[tau] > m_function[peak]) peak = tau;
+                ++tau;
+            }
+            if (peak < m_maxLag && peak >= m_minLag && m_function[peak] > 0.0f) {
+                if (visit(peak)) return;
+            }
+        }
+    };
+
+    float highest = 0.0f;
+    forEachKeyMaximum([this, &highest](size_t peak) {
+        highest = std::max(highest, m_function[peak]);
+        return false;
+    });
+    if (highest <= 0.0f) return 0.0f;
+
+    size_t best = 0;
+    const float limit = m_settings.clarity * highest;
+    forEachKeyMaximum([this, &best, limit](size_t peak) {
+        if (m_function[peak] < limit) return false;
+        best = peak;
+        return true;
+    });
+
+    confidence = m_function[best];
+    return interpolate(m_function.data(), best, m_function.size());
+}
+
+float PitchTracker::interpolate(const float* values, size_t index, size_t size) {
+    if (index == 0 || index + 1 >= size) return static_cast<float>(index);
+    const float a = values[index - 1];
+    const float b = values[index];
+    const float c = values[index + 1];
+    const float denominator = a - 2.0f * b + c;
+    if (std::abs(denominator) < 1.0e-12f) return static_cast<float>(index);
+    return static_cast<float>(index) + 0.5f * (a - c) / denominator;
+}
+
+std::vector<PitchTracker::Estimate> PitchTracker::track(const float* data, size_t frames, int channels,
+                                                        double sampleRate, const Settings& settings) {
+    PitchTracker tracker;
+    tracker.prepare(sampleRate, settings);
+
+    const int numChannels = std::max(channels, 1);
+    std::vector<float> mono(frames);
+    for (size_t i = 0; i < frames; ++i) {
+        float sum = 0.0f;
+        for (int c = 0; c < numChannels; ++c) {
+            sum += data[i * numChannels + c];
+        }
+        mono[i] = sum / numChannels;
+    }
+
+    std::vector<Estimate> estimates(frames / tracker.getHopSize() + 1);
+    const size_t found = tracker.process(mono.data(), frames, estimates.data(), estimates.size());
+    estimates.resize(found);
+    return estimates;
+}
+
+float PitchTracker::frequencyToMidi(float frequency) {
+    return frequency > 0.0f ? 69.0f + 12.0f * std::log2(frequency / 440.0f) : 0.0f;
+}
+
+} // namespace VRMusicStudio
@@ -0,0 +1,276 @@
+#include "audio/processing/SampleStreamer.hpp"
+#include "audio/processing/DspMath.hpp"
+#include <sndfile.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+
+namespace VRMusicStudio {
+
+namespace {
+
+// Wartezeit des I/O-Threads ohne aktive Stimmen bzw. wenn alle Ringe voll
+// sind; der residente Kopf deckt ein Vielfaches davon ab
+constexpr auto kIdleWait = std::chrono::milliseconds(5);
+constexpr auto kFullWait = std::chrono::milliseconds(1);
+
+} // namespace
+
+SampleStreamer::SampleStreamer()
+    : SampleStreamer(Settings())
+{
+}
+
+SampleStreamer::SampleStreamer(const Settings& settings)
+    : m_settings(settings)
+    , m_startedVoices(0)
+    , m_underruns(0)
+    , m_shouldStop(false)
+{
+    m_settings.chunkFrames = std::max<size_t>(256, m_settings.chunkFrames);
+    m_settings.ringFrames = nextPowerOfTwo(std::max(m_settings.ringFrames, 2 * m_settings.chunkFrames));
+    m_settings.maxChannels = std::max(1, m_settings.maxChannels);
+    m_settings.maxVoices = std::max(1, m_settings.maxVoices);
+    m_settings.spareVoices = std::max(0, m_settings.spareVoices);
+
+    for (int i = 0; i < m_settings.maxVoices + m_settings.spareVoices; ++i) {
+        auto voice = std::make_unique<Voice>();
+        voice->ring.assign(m_settings.ringFrames * static_cast<size_t>(m_settings.maxChannels), 0.0f);
+        m_voices.push_back(std::move(voice));
+    }
+    m_worker = std::thread(&SampleStreamer::run, this);
+}
+
+SampleStreamer::~SampleStreamer() {
+    m_shouldStop.store(true, std::memory_order_release);
+    if (m_worker.joinable()) m_worker.join();
+    for (auto& voice : m_voices) {
+        if (voice->state.load(std::memory_order_acquire) != Free) release(*voice);
+    }
+}
+
+std::shared_ptr<StreamedSample> SampleStreamer::open(const std::string& path, bool resident) const {
+    SF_INFO info{};
+    SNDFILE* file = sf_open(path.c_str(), SFM_READ, &info);
+    if (!file) return nullptr;
+
+    auto sample = std::make_shared<StreamedSample>();
+    sample->path = path;
+    sample->frames = static_cast<size_t>(std::max<sf_count_t>(0, info.frames));
+    sample->channels = std::max(1, info.channels);
+    sample->sampleRate = info.samplerate > 0 ? info.samplerate : 44100.0;
+
+    // Mehr Kanäle als die Ringe fassen: komplett laden
+    size_t headFrames = static_cast<size_t>(m_settings.preloadMs * 0.001 * sample->sampleRate);
+    if (resident || sample->channels > m_settings.maxChannels) headFrames = sample->frames;
+    headFrames = std::min(headFrames, sample->frames);
+
+    sample->head.resize(headFrames * static_cast<size_t>(sample->channels));
+    const sf_count_t read = sf_readf_float(file, sample->head.data(), static_cast<sf_count_t>(headFrames));
+    sf_close(file);
+
+    sample->headFrames = static_cast<size_t>(std::max<sf_count_t>(0, read));
+    if (sample->headFrames < headFrames) {
+        // Datei kürzer als angegeben
+        sample->frames = sample->headFrames;
+        sample->head.resize(sample->headFrames * static_cast<size_t>(sample->channels));
+    }
+    return sample;
+}
+
+int SampleStreamer::startVoice(const std::shared_ptr<StreamedSample>& sample, bool loop,
+                               uint64_t loopStart, uint64_t loopEnd) {
+    if (!sample || sample->channels > m_settings.maxChannels) return -1;
+    if (m_startedVoices >= m_settings.maxVoices) return -1;
+
+    for (size_t i = 0; i < m_voices.size(); ++i) {
+        Voice& voice = *m_voices[i];
+        if (voice.state.load(std::memory_order_acquire) != Free) continue;
+
+        // Freie Stimmen gehören dem Audio-Thread, der I/O-Thread liest sie erst
+        // nach dem Wechsel auf Active
+        voice.sample = sample;
+        voice.loop = loop && loopEnd > loopStart && loopEnd <= sample->frames;
+        voice.loopStart = loopStart;
+        voice.loopEnd = loopEnd;
+        voice.underrun = false;
+        voice.readStart.store(0, std::memory_order_relaxed);
+        voice.writeEnd.store(sample->headFrames, std::memory_order_relaxed);
+        voice.speed.store(1.0f, std::memory_order_relaxed);
+        voice.state.store(Active, std::memory_order_release);
+        ++m_startedVoices;
+        return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void SampleStreamer::stopVoice(int voice) {
+    if (voice < 0 || voice >= static_cast<int>(m_voices.size())) return;
+    // Datei schließen und Sample freigeben übernimmt der I/O-Thread; bis dahin
+    // starten neue Noten auf den Reserve-Slots
+    Voice& v = *m_voices[voice];
+    if (v.state.load(std::memory_order_relaxed) != Active) return;
+    v.state.store(Stopping, std::memory_order_release);
+    --m_startedVoices;
+}
+
+bool SampleStreamer::readFrame(int voice, uint64_t frame, float* out) {
+    Voice& v = *m_voices[voice];
+    const StreamedSample& sample = *v.sample;
+    const size_t channels = static_cast<size_t>(sample.channels);
+
+    if (!v.loop && frame >= sample.frames) {
+        std::fill(out, out + channels, 0.0f);
+        return false;
+    }
+
+    const uint64_t source = sourceFrame(v, frame);
+    if (source < sample.headFrames) {
+        std::memcpy(out, sample.head.data() + source * channels, channels * sizeof(float));
+        v.underrun = false;
+        return true;
+    }
+
+    if (frame >= v.writeEnd.load(std::memory_order_acquire)) {
+        if (!v.underrun) {
+            m_underruns.fetch_add(1, std::memory_order_relaxed);
+            v.underrun = true;
+        }
+        std::fill(out, out + channels, 0.0f);
+        return false;
+    }
+
+    v.underrun = false;
+    const size_t index = static_cast<size_t>(frame & (m_settings.ringFrames - 1)) * channels;
+    std::memcpy(out, v.ring.data() + index, channels * sizeof(float));
+    return true;
+}
+
+void SampleStreamer::advance(int voice, uint64_t frame, float speed) {
+    Voice& v = *m_voices[voice];
+    v.readStart.store(frame, std::memory_order_release);
+    v.speed.store(speed, std::memory_order_relaxed);
+}
+
+int SampleStreamer::getActiveVoices() const {
+    int count = 0;
+    for (const auto& voice : m_voices) {
+        if (voice->state.load(std::memory_order_relaxed) == Active) ++count;
+    }
+    return count;
+}
+
+size_t SampleStreamer::getMemoryUsage() const {
+    return m_voices.size() * m_settings.ringFrames * static_cast<size_t>(m_settings.maxChannels) * sizeof(float);
+}
+
+void SampleStreamer::run() {
+    while (!m_shouldStop.load(std::memory_order_acquire)) {
+        // Stimme mit der kürzesten gepufferten Spielzeit zuerst
+        Voice* next = nullptr;
+        double shortest = std::numeric_limits<double>::max();
+        bool anyActive = false;
+
+        for (auto& entry : m_voices) {
+            Voice& voice = *entry;
+            const int state = voice.state.load(std::memory_order_acquire);
+            if (state == Stopping) {
+                release(voice);
+                continue;
+            }
+            if (state != Active) continue;
+            anyActive = true;
+
+            const StreamedSample& sample = *voice.sample;
+            if (voice.failed || sample.isResident()) continue;
+
+            const uint64_t write = voice.writeEnd.load(std::memory_order_relaxed);
+            if (!voice.loop && write >= sample.frames) continue;
+
+            // Erst nachlesen, wenn ein nennenswerter Teil des Rings frei ist
+            const uint64_t read = voice.readStart.load(std::memory_order_acquire);
+            if (read + m_settings.ringFrames < write + m_settings.chunkFrames / 4) continue;
+
+            const double ahead = static_cast<double>(write - std::min(read, write)) /
+                                 std::max(0.01f, voice.speed.load(std::memory_order_relaxed));
+            if (ahead < shortest) {
+                shortest = ahead;
+                next = &voice;
+            }
+        }
+
+        if (next) {
+            fill(*next);
+        } else {
+            std::this_thread::sleep_for(anyActive ? kFullWait : kIdleWait);
+        }
+    }
+}
+
+void SampleStreamer::fill(Voice& voice) {
+    const StreamedSample& sample = *voice.sample;
+    const size_t channels = static_cast<size_t>(sample.channels);
+
+    if (!voice.file) {
+        SF_INFO info{};
+        voice.file = sf_open(sample.path.c_str(), SFM_READ, &info);
+        voice.filePosition = 0;
+        if (!voice.file || info.channels != sample.channels) {
+            voice.failed = true;
+            return;
+        }
+    }
+    SNDFILE* file = static_cast<SNDFILE*>(voice.file);
+
+    const uint64_t write = voice.writeEnd.load(std::memory_order_relaxed);
+    const uint64_t read = voice.readStart.load(std::memory_order_acquire);
+    uint64_t count = std::min<uint64_t>(m_settings.chunkFrames, read + m_settings.ringFrames - write);
+    if (!voice.loop) count = std::min<uint64_t>(count, sample.frames - write);
+
+    // In zusammenhängenden Abschnitten: bis Loop-Ende, Kopfende und Ringende
+    uint64_t done = 0;
+    while (done < count) {
+        const uint64_t frame = write + done;
+        const uint64_t source = sourceFrame(voice, frame);
+        const uint64_t ringPosition = frame & (m_settings.ringFrames - 1);
+
+        uint64_t length = std::min<uint64_t>(count - done, m_settings.ringFrames - ringPosition);
+        length = std::min<uint64_t>(length, sample.frames - source);
+        if (voice.loop) length = std::min<uint64_t>(length, voice.loopEnd - source);
+
+        float* destination = voice.ring.data() + ringPosition * channels;
+        if (source < sample.headFrames) {
+            length = std::min<uint64_t>(length, sample.headFrames - source);
+            std::memcpy(destination, sample.head.data() + source * channels, length * channels * sizeof(float));
+        } else {
+            if (voice.filePosition != source) {
+                sf_seek(file, static_cast<sf_count_t>(source), SEEK_SET);
+                voice.filePosition = source;
+            }
+            const sf_count_t got = sf_readf_float(file, destination, static_cast<sf_count_t>(length));
+            if (got <= 0) {
+                voice.failed = true;
+                break;
+            }
+            length = static_cast<uint64_t>(got);
+            voice.filePosition += length;
+        }
+        done += length;
+    }
+
+    // Erst nach dem Schreiben sichtbar machen
+    voice.writeEnd.store(write + done, std::memory_order_release);
+}
+
+void SampleStreamer::release(Voice& voice) {
+    if (voice.file) {
+        sf_close(static_cast<SNDFILE*>(voice.file));
+        voice.file = nullptr;
+    }
+    voice.failed = false;
+    voice.sample.reset();
+    voice.state.store(Free, std::memory_order_release);
+}
+
+} // namespace VRMusicStudio
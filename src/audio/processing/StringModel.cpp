@@ -0,0 +1,459 @@
+#include "audio/processing/StringModel.hpp"
+#include "audio/processing/DspMath.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace VRMusicStudio {
+
+namespace {
+
+// Schleifenverstärkung pro Periode für eine Abklingzeit T60
+double t60Gain(double frequency, double t60) {
+    return std::pow(10.0, -3.0 / (frequency * std::max(t60, 0.001)));
+}
+
+// One-pole lowpass (1 - b) / (1 - b z^-1): magnitude and phase delay at w
+double onePoleMagnitude(double b, double w) {
+    return (1.0 - b) / std::sqrt(1.0 - 2.0 * b * std::cos(w) + b * b);
+}
+
+double onePoleDelay(double b, double w) {
+    return std::atan2(b * std::sin(w), 1.0 - b * std::cos(w)) / w;
+}
+
+// First-order allpass (a + z^-1) / (1 + a z^-1): phase delay at w
+double allpassDelay(double a, double w) {
+    const double phase = std::atan2(-std::sin(w), a + std::cos(w)) -
+                         std::atan2(-a * std::sin(w), 1.0 + a * std::cos(w));
+    return -phase / w;
+}
+
+// Linear interpolierter Abgriff `delay` Samples vor `write`
+float readLine(const std::vector<float>& line, size_t write, double delay, size_t mask) {
+    const size_t whole = static_cast<size_t>(delay);
+    const float fraction = static_cast<float>(delay - static_cast<double>(whole));
+    const float a = line[(write - whole) & mask];
+    const float b = line[(write - whole - 1) & mask];
+    return a + (b - a) * fraction;
+}
+
+StringModel::Preset makePreset(StringModel::Excitation excitation, float lowestFrequency, float decay,
+                               float releaseDecay, float brightness, float stiffness, float position,
+                               float bodyMix, std::initializer_list<StringModel::BodyMode> body) {
+    StringModel::Preset preset;
+    preset.excitation = excitation;
+    preset.lowestFrequency = lowestFrequency;
+    preset.decay = decay;
+    preset.releaseDecay = releaseDecay;
+    preset.brightness = brightness;
+    preset.stiffness = stiffness;
+    preset.position = position;
+    preset.bodyMix = bodyMix;
+    for (const auto& mode : body) {
+        if (preset.bodyModeCount == StringModel::kMaxBodyModes) break;
+        preset.body[preset.bodyModeCount++] = mode;
+    }
+    return preset;
+}
+
+} // namespace
+
+// Korpusmoden: Helmholtz-Luftmode (A0), Korpusmoden (CBR, B1-, B1+) und
+// Stegresonanz, Abklingzeiten als T60
+StringModel::Preset StringModel::violin() {
+    return makePreset(Excitation::Bow, 180.0f, 1.5f, 0.3f, 0.75f, 0.0f, 0.127f, 0.6f,
+                      {{275.0f, 0.15f, 1.0f}, {405.0f, 0.10f, 0.6f}, {460.0f, 0.12f, 0.9f},
+                       {530.0f, 0.12f, 1.0f}, {700.0f, 0.08f, 0.5f}, {1000.0f, 0.06f, 0.4f},
+                       {2500.0f, 0.04f, 0.6f}, {3200.0f, 0.03f, 0.3f}});
+}
+
+StringModel::Preset StringModel::viola() {
+    return makePreset(Excitation::Bow, 120.0f, 1.8f, 0.35f, 0.7f, 0.0f, 0.13f, 0.6f,
+                      {{230.0f, 0.15f, 1.0f}, {350.0f, 0.10f, 0.6f}, {395.0f, 0.12f, 0.9f},
+                       {440.0f, 0.12f, 1.0f}, {600.0f, 0.08f, 0.5f}, {880.0f, 0.06f, 0.4f},
+                       {2100.0f, 0.04f, 0.5f}, {2800.0f, 0.03f, 0.3f}});
+}
+
+StringModel::Preset StringModel::cello() {
+    return makePreset(Excitation::Bow, 60.0f, 2.5f, 0.4f, 0.65f, 0.0f, 0.12f, 0.6f,
+                      {{100.0f, 0.20f, 1.0f}, {145.0f, 0.15f, 0.6f}, {195.0f, 0.15f, 0.9f},
+                       {220.0f, 0.15f, 1.0f}, {310.0f, 0.10f, 0.5f}, {400.0f, 0.08f, 0.4f},
+                       {1000.0f, 0.05f, 0.4f}, {2000.0f, 0.04f, 0.3f}});
+}
+
+StringModel::Preset StringModel::doubleBass() {
+    return makePreset(Excitation::Bow, 30.0f, 3.0f, 0.5f, 0.55f, 0.0f, 0.11f, 0.55f,
+                      {{57.0f, 0.25f, 1.0f}, {98.0f, 0.20f, 0.7f}, {128.0f, 0.18f, 0.9f},
+                       {160.0f, 0.15f, 0.8f}, {200.0f, 0.12f, 0.5f}, {280.0f, 0.10f, 0.4f},
+                       {450.0f, 0.06f, 0.3f}, {800.0f, 0.04f, 0.2f}});
+}
+
+StringModel::Preset StringModel::guitar() {
+    return makePreset(Excitation::Pluck, 75.0f, 4.0f, 0.15f, 0.8f, 0.1f, 0.18f, 0.5f,
+                      {{100.0f, 0.20f, 1.0f}, {200.0f, 0.15f, 0.8f}, {240.0f, 0.15f, 0.6f},
+                       {380.0f, 0.10f, 0.5f}, {500.0f, 0.08f, 0.4f}, {610.0f, 0.08f, 0.3f},
+                       {1000.0f, 0.05f, 0.2f}, {2400.0f, 0.03f, 0.2f}});
+}
+
+StringModel::Preset StringModel::harp() {
+    // Gezupft nahe der Saitenmitte: hohler, grundtöniger Klang
+    return makePreset(Excitation::Pluck, 30.0f, 6.0f, 0.5f, 0.6f, 0.05f, 0.45f, 0.4f,
+                      {{150.0f, 0.25f, 1.0f}, {300.0f, 0.20f, 0.7f}, {460.0f, 0.15f, 0.5f},
+                       {650.0f, 0.10f, 0.4f}, {900.0f, 0.08f, 0.3f}, {1300.0f, 0.06f, 0.2f}});
+}
+
+StringModel::StringModel(const Preset& preset, int maxVoices, double sampleRate)
+    : m_preset(preset)
+    , m_sampleRate(sampleRate)
+    , m_lineMask(0)
+    , m_block{}
+    , m_modes{}
+    , m_gain(1.0f)
+    , m_bowPressure(0.5f)
+    , m_bowSpeed(0.5f)
+    , m_vibratoDepth(0.0f)
+    , m_vibratoRate(5.0f)
+    , m_vibratoPhase(0.0)
+    , m_startCounter(0)
+    , m_noiseState(0x9E3779B9u)
+{
+    m_preset.lowestFrequency = std::max(m_preset.lowestFrequency, 20.0f);
+
+    // Längste Periode plus Reserve für Vibrato und Filterlaufzeiten
+    const size_t length = nextPowerOfTwo(static_cast<size_t>(m_sampleRate / m_preset.lowestFrequency * 1.1) + 8);
+    m_lineMask = length - 1;
+    m_scratch.assign(length, 0.0f);
+
+    m_voices.resize(static_cast<size_t>(std::max(1, maxVoices)));
+    for (auto& voice : m_voices) {
+        voice.bridge.assign(length, 0.0f);
+        if (m_preset.excitation == Excitation::Bow) voice.nut.assign(length, 0.0f);
+    }
+    updateBody();
+}
+
+StringModel::~StringModel() = default;
+
+void StringModel::setPreset(const Preset& preset) {
+    const float lowestFrequency = m_preset.lowestFrequency;
+    const Excitation excitation = m_preset.excitation;
+    m_preset = preset;
+    // Delay-Leitungen sind für Anregung und tiefste Note angelegt
+    m_preset.lowestFrequency = lowestFrequency;
+    m_preset.excitation = excitation;
+    m_preset.bodyModeCount = std::clamp(m_preset.bodyModeCount, 0, kMaxBodyModes);
+    updateBody();
+
+    for (auto& voice : m_voices) {
+        if (voice.active) tuneVoice(voice, 1.0f);
+    }
+}
+
+void StringModel::setBow(float pressure, float speed) {
+    m_bowPressure = std::clamp(pressure, 0.0f, 1.0f);
+    m_bowSpeed = std::clamp(speed, 0.0f, 1.0f);
+}
+
+void StringModel::setVibrato(float depth, float rate) {
+    m_vibratoDepth = std::clamp(depth, 0.0f, 2.0f);
+    m_vibratoRate = std::clamp(rate, 0.0f, 20.0f);
+}
+
+void StringModel::noteOn(int note, float velocity) {
+    if (velocity <= 0.0f) {
+        noteOff(note);
+        return;
+    }
+
+    Voice& voice = *allocateVoice(note);
+    const float frequency = 440.0f * std::pow(2.0f, (note - 69) / 12.0f);
+    // Oben begrenzt, damit jedes Segment mindestens zwei Samples lang bleibt
+    voice.frequency = std::clamp(frequency, m_preset.lowestFrequency, static_cast<float>(m_sampleRate / 8.0));
+    voice.velocity = std::min(velocity, 1.0f);
+    voice.note = note;
+    voice.released = false;
+    voice.startOrder = ++m_startCounter;
+    tuneVoice(voice, 1.0f);
+
+    if (m_preset.excitation == Excitation::Pluck) {
+        pluck(voice, voice.velocity);
+    }
+    voice.active = true;
+}
+
+void StringModel::noteOff(int note) {
+    for (auto& voice : m_voices) {
+        if (voice.active && !voice.released && voice.note == note) {
+            voice.released = true;
+            tuneVoice(voice, 1.0f);
+        }
+    }
+}
+
+void StringModel::allNotesOff() {
+    for (auto& voice : m_voices) {
+        if (voice.active && !voice.released) {
+            voice.released = true;
+            tuneVoice(voice, 1.0f);
+        }
+    }
+}
+
+int StringModel::getActiveVoices() const {
+    int count = 0;
+    for (const auto& voice : m_voices) {
+        if (voice.active) ++count;
+    }
+    return count;
+}
+
+StringModel::Voice* StringModel::allocateVoice(int note) {
+    // Klingende Saite derselben Note wiederverwenden
+    for (auto& voice : m_voices) {
+        if (voice.active && voice.note == note) return &voice;
+    }
+
+    // Sonst frei, sonst die älteste
+    Voice* target = nullptr;
+    for (auto& voice : m_voices) {
+        if (!voice.active) {
+            target = &voice;
+            break;
+        }
+        if (!target || voice.startOrder < target->startOrder) target = &voice;
+    }
+
+    Voice& voice = *target;
+    std::fill(voice.bridge.begin(), voice.bridge.end(), 0.0f);
+    std::fill(voice.nut.begin(), voice.nut.end(), 0.0f);
+    voice.lossState = 0.0f;
+    voice.dispersionX = voice.dispersionY = 0.0f;
+    voice.tuningX = voice.tuningY = 0.0f;
+    voice.bowLevel = 0.0f;
+    return &voice;
+}
+
+void StringModel::tuneVoice(Voice& voice, float vibrato) const {
+    const double frequency = voice.frequency * vibrato;
+    const double w = 2.0 * kPi * frequency / m_sampleRate;
+    const double period = m_sampleRate / frequency;
+    const double maxDelay = static_cast<double>(m_lineMask - 2);
+
+    // Verlustfilter: Helligkeit bestimmt den Pol, die Schleifenverstärkung
+    // gleicht dessen Dämpfung bei der Grundfrequenz aus
+    const double pole = (1.0 - std::clamp(m_preset.brightness, 0.0f, 1.0f)) * 0.9;
+    const double decay = voice.released ? m_preset.releaseDecay : m_preset.decay;
+    voice.lossPole = static_cast<float>(pole);
+    voice.loopGain = static_cast<float>(std::min(0.99999, t60Gain(frequency, decay) / onePoleMagnitude(pole, w)));
+
+    double remaining = period - onePoleDelay(pole, w);
+
+    if (m_preset.excitation == Excitation::Pluck) {
+        // Negativer Koeffizient: tiefe Frequenzen laufen länger, Obertöne werden höher
+        voice.dispersion = -0.7f * std::clamp(m_preset.stiffness, 0.0f, 1.0f);
+        remaining -= allpassDelay(voice.dispersion, w);
+
+        // Nachkommaanteil im Bereich 0.1 - 1.1 hält den Tuning-Allpass stabil
+        const double whole = std::clamp(std::floor(remaining - 0.1), 1.0, maxDelay);
+        const double fraction = std::max(0.1, remaining - whole);
+        voice.loopDelay = static_cast<int>(whole);
+        voice.tuning = static_cast<float>((1.0 - fraction) / (1.0 + fraction));
+    } else {
+        const double position = std::clamp(m_preset.position, 0.02f, 0.5f);
+        remaining = std::clamp(remaining, 2.0, maxDelay);
+        voice.bridgeDelay = std::max(1.0, remaining * position);
+        voice.nutDelay = std::max(1.0, remaining - voice.bridgeDelay);
+    }
+}
+
+void StringModel::pluck(Voice& voice, float velocity) {
+    const int length = voice.loopDelay;
+
+    // Rauschen, bei leisem Anschlag weicher gefiltert
+    const float smoothing = 0.8f - 0.7f * velocity;
+    float state = 0.0f;
+    for (int i = 0; i < length; ++i) {
+        state += (nextNoise() - state) * (1.0f - smoothing);
+        m_scratch[i] = state;
+    }
+
+    // Kammfilter: Teiltöne mit Knoten an der Zupfposition fehlen
+    const int pick = std::clamp(static_cast<int>(std::lround(m_preset.position * length)), 1, std::max(1, length - 1));
+    for (int i = length - 1; i >= pick; --i) {
+        m_scratch[i] -= m_scratch[i - pick];
+    }
+
+    // Gleichanteil entfernen; die Schleife dämpft ihn kaum
+    float mean = 0.0f;
+    for (int i = 0; i < length; ++i) mean += m_scratch[i];
+    mean /= static_cast<float>(length);
+    for (int i = 0; i < length; ++i) m_scratch[i] -= mean;
+
+    // In den Abschnitt, der als nächstes gelesen wird; klingt die Saite noch,
+    // addiert sich der neue Anschlag
+    const float amplitude = 0.5f * velocity;
+    const size_t start = voice.write - static_cast<size_t>(length);
+    for (int i = 0; i < length; ++i) {
+        voice.bridge[(start + static_cast<size_t>(i)) & m_lineMask] += m_scratch[i] * amplitude;
+    }
+}
+
+float StringModel::renderPluck(Voice& voice, float* out, int numSamples) {
+    float* line = voice.bridge.data();
+    const size_t mask = m_lineMask;
+    const size_t delay = static_cast<size_t>(voice.loopDelay);
+    const float pole = voice.lossPole;
+    const float gain = voice.loopGain;
+    const float dispersion = voice.dispersion;
+    const float tuning = voice.tuning;
+
+    size_t write = voice.write;
+    float loss = voice.lossState;
+    float dx = voice.dispersionX;
+    float dy = voice.dispersionY;
+    float tx = voice.tuningX;
+    float ty = voice.tuningY;
+    float peak = 0.0f;
+
+    for (int i = 0; i < numSamples; ++i) {
+        const float x = line[(write - delay) & mask];
+        loss += (x - loss) * (1.0f - pole);
+        const float y = loss * gain;
+        const float d = dispersion * (y - dy) + dx;
+        dx = y;
+        dy = d;
+        const float t = tuning * (d - ty) + tx;
+        tx = d;
+        ty = t;
+        line[write & mask] = t;
+        ++write;
+
+        out[i] += x;
+        peak = std::max(peak, std::fabs(x));
+    }
+
+    voice.write = write;
+    voice.lossState = loss;
+    voice.dispersionX = dx;
+    voice.dispersionY = dy;
+    voice.tuningX = tx;
+    voice.tuningY = ty;
+    return peak;
+}
+
+float StringModel::renderBow(Voice& voice, float* out, int numSamples) {
+    const size_t mask = m_lineMask;
+    const float pole = voice.lossPole;
+    const float gain = voice.loopGain;
+
+    // Bogen setzt in ~50 ms an und hebt in ~20 ms ab
+    const float target = voice.released ? 0.0f : 1.0f;
+    const float rate = 1.0f - std::exp(-1.0f / ((voice.released ? 0.02f : 0.05f) * static_cast<float>(m_sampleRate)));
+    const float maxVelocity = (0.03f + 0.2f * m_bowSpeed) * (0.5f + 0.5f * voice.velocity);
+    const float slope = 5.0f - 4.0f * m_bowPressure;
+
+    size_t write = voice.write;
+    float loss = voice.lossState;
+    float bowLevel = voice.bowLevel;
+    float peak = 0.0f;
+
+    for (int i = 0; i < numSamples; ++i) {
+        bowLevel += (target - bowLevel) * rate;
+
+        const float nutOut = readLine(voice.nut, write, voice.nutDelay, mask);
+        const float bridgeOut = readLine(voice.bridge, write, voice.bridgeDelay, mask);
+        loss += (bridgeOut - loss) * (1.0f - pole);
+        const float bridgeReflection = -loss * gain;
+        const float nutReflection = -nutOut;
+
+        // Reibungskennlinie: Haften bei kleiner Geschwindigkeitsdifferenz,
+        // Gleiten bei großer; ohne Bogen schwingt die Saite frei aus
+        float bowForce = 0.0f;
+        if (bowLevel > 1e-4f) {
+            const float difference = bowLevel * maxVelocity - (bridgeReflection + nutReflection);
+            float friction = std::fabs((difference + 0.001f) * slope) + 0.75f;
+            friction *= friction;
+            bowForce = difference * std::min(1.0f, 1.0f / (friction * friction));
+        }
+
+        voice.nut[write & mask] = bridgeReflection + bowForce;
+        voice.bridge[write & mask] = nutReflection + bowForce;
+        ++write;
+
+        out[i] += bridgeOut;
+        peak = std::max(peak, std::fabs(bridgeOut));
+    }
+
+    voice.write = write;
+    voice.lossState = loss;
+    voice.bowLevel = bowLevel;
+    return peak;
+}
+
+void StringModel::updateBody() {
+    for (int i = 0; i < kMaxBodyModes; ++i) {
+        ModeState& state = m_modes[i];
+        if (i >= m_preset.bodyModeCount) {
+            state = ModeState();
+            continue;
+        }
+        const BodyMode& mode = m_preset.body[i];
+        const double w = 2.0 * kPi * std::clamp(static_cast<double>(mode.frequency), 20.0, m_sampleRate * 0.45) / m_sampleRate;
+        const double r = std::pow(10.0, -3.0 / (std::max(mode.decay, 0.001f) * m_sampleRate));
+        state.a1 = static_cast<float>(2.0 * r * std::cos(w));
+        state.a2 = static_cast<float>(r * r);
+        // Spitzenverstärkung ~ gain
+        state.b0 = static_cast<float>(mode.gain * (1.0 - r) * 2.0 * std::sin(w));
+    }
+}
+
+float StringModel::nextNoise() {
+    m_noiseState ^= m_noiseState << 13;
+    m_noiseState ^= m_noiseState >> 17;
+    m_noiseState ^= m_noiseState << 5;
+    return static_cast<float>(m_noiseState >> 8) / 8388608.0f - 1.0f;
+}
+
+void StringModel::process(float* out, int numSamples) {
+    const bool bowed = m_preset.excitation == Excitation::Bow;
+    const int modeCount = m_preset.bodyModeCount;
+    const float bodyMix = std::clamp(m_preset.bodyMix, 0.0f, 1.0f);
+
+    for (int offset = 0; offset < numSamples; offset += kBlockSize) {
+        const int count = std::min(kBlockSize, numSamples - offset);
+        std::fill(m_block.begin(), m_block.begin() + count, 0.0f);
+
+        // Vibrato einmal pro Block
+        const float vibrato = std::pow(2.0f, m_vibratoDepth * static_cast<float>(std::sin(m_vibratoPhase)) / 12.0f);
+        m_vibratoPhase += 2.0 * kPi * m_vibratoRate * count / m_sampleRate;
+        if (m_vibratoPhase > 2.0 * kPi) m_vibratoPhase -= 2.0 * kPi;
+
+        for (auto& voice : m_voices) {
+            if (!voice.active) continue;
+            if (bowed) {
+                tuneVoice(voice, vibrato);
+                const float peak = renderBow(voice, m_block.data(), count);
+                if (voice.released && voice.bowLevel < 1e-4f && peak < 1e-5f) voice.active = false;
+            } else {
+                const float peak = renderPluck(voice, m_block.data(), count);
+                if (peak < 1e-5f) voice.active = false;
+            }
+        }
+
+        // Gemeinsamer Korpus
+        for (int i = 0; i < count; ++i) {
+            const float x = m_block[i];
+            float body = 0.0f;
+            for (int k = 0; k < modeCount; ++k) {
+                ModeState& mode = m_modes[k];
+                const float y = mode.b0 * x + mode.a1 * mode.y1 - mode.a2 * mode.y2;
+                mode.y2 = mode.y1;
+                mode.y1 = y;
+                body += y;
+            }
+            out[offset + i] += m_gain * (x * (1.0f - bodyMix) + body * bodyMix);
+        }
+    }
+}
+
+} // namespace VRMusicStudio
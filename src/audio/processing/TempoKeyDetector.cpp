@@ -0,0 +1,717 @@
+#include "audio/processing/TempoKeyDetector.hpp"
+#include "audio/processing/DspMath.hpp"
+#include "audio/processing/FFT.hpp"
+#include <sndfile.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+
+namespace VRMusicStudio {
+
+namespace {
+
+constexpr double kAnalysisRate = 11025.0;
+constexpr size_t kOnsetFrame = 1024;
+constexpr size_t kOnsetHop = 128;
+constexpr size_t kChromaFrame = 4096;
+constexpr size_t kChromaHop = 1024;
+constexpr float kLogCompression = 100.0f;
+constexpr float kBassLimit = 150.0f;        // Hz, Kick/Bass für die Downbeat-Suche
+constexpr float kChromaLow = 100.0f;        // Hz
+constexpr float kChromaHigh = 2500.0f;      // Hz
+constexpr int kCombTeeth = 4;
+constexpr double kPreferenceOctaves = 1.0;  // Breite der Tempo-Präferenz
+constexpr double kBpmStep = 0.05;
+constexpr double kPeriodRange = 0.005;      // ±0.5 % bei der Grid-Verfeinerung
+constexpr int kPeriodSteps = 50;
+constexpr double kOnsetDelay = 0.66;        // Frames vom Framebeginn bis zum Flux-Maximum eines Onsets
+
+using Chroma = std::array<float, 12>;
+
+// Krumhansl-Kessler-Profile, Index 0 = Tonika
+constexpr Chroma kMajorProfile = {6.35f, 2.23f, 3.48f, 2.33f, 4.38f, 4.09f, 2.52f, 5.19f, 2.39f, 3.66f, 2.29f, 2.88f};
+constexpr Chroma kMinorProfile = {6.33f, 2.68f, 3.52f, 5.38f, 2.60f, 3.53f, 2.54f, 4.75f, 3.98f, 2.69f, 3.34f, 3.17f};
+
+const char* const kPitchNames[12] = {"C", "Db", "D", "Eb", "E", "F", "F#", "G", "Ab", "A", "Bb", "B"};
+
+// Mono-Mix, Tiefpass (Blackman-Sinc) und Dezimation auf ~11 kHz
+std::vector<float> downmix(const float* data, size_t frames, int channels, double sampleRate, size_t& factor) {
+    factor = std::max<size_t>(1, static_cast<size_t>(std::lround(sampleRate / kAnalysisRate)));
+
+    std::vector<float> mono(frames);
+    const float scale = 1.0f / static_cast<float>(channels);
+    for (size_t i = 0; i < frames; ++i) {
+        float sum = 0.0f;
+        for (int c = 0; c < channels; ++c) {
+            sum += data[i * channels + c];
+        }
+        mono[i] = sum * scale;
+    }
+    if (factor == 1) return mono;
+
+    const size_t taps = 8 * factor + 1;
+    const size_t half = taps / 2;
+    const double cutoff = 0.45 / static_cast<double>(factor);
+    std::vector<float> kernel(taps);
+    double kernelSum = 0.0;
+    for (size_t i = 0; i < taps; ++i) {
+        const double x = static_cast<double>(i) - static_cast<double>(half);
+        const double sinc = x == 0.0 ? 2.0 * cutoff : std::sin(2.0 * kPi * cutoff * x) / (kPi * x);
+        const double phase = 2.0 * kPi * static_cast<double>(i) / static_cast<double>(taps - 1);
+        const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+        kernel[i] = static_cast<float>(sinc * window);
+        kernelSum += kernel[i];
+    }
+    for (float& k : kernel) {
+        k = static_cast<float>(k / kernelSum);
+    }
+
+    // Nur die behaltenen Samples werden gefiltert
+    std::vector<float> decimated(frames / factor);
+    for (size_t o = 0; o < decimated.size(); ++o) {
+        const size_t center = o * factor;
+        const size_t first = center >= half ? 0 : half - center;
+        const size_t last = std::min(taps, frames + half - center);
+        float acc = 0.0f;
+        for (size_t k = first; k < last; ++k) {
+            acc += kernel[k] * mono[center + k - half];
+        }
+        decimated[o] = acc;
+    }
+    return decimated;
+}
+
+float sampleAt(const std::vector<float>& values, double position) {
+    if (position < 0.0 || values.empty()) return 0.0f;
+    const size_t index = static_cast<size_t>(position);
+    if (index + 1 >= values.size()) return index < values.size() ? values[index] : 0.0f;
+    const float fraction = static_cast<float>(position - static_cast<double>(index));
+    return values[index] + (values[index + 1] - values[index]) * fraction;
+}
+
+// Spectral Flux (log-komprimiert, halbwellengleichgerichtet), gesamt und < kBassLimit
+void onsetEnvelopes(const std::vector<float>& signal, double rate,
+                    std::vector<float>& flux, std::vector<float>& bass) {
+    flux.clear();
+    bass.clear();
+    if (signal.size() < kOnsetFrame) return;
+
+    const size_t count = (signal.size() - kOnsetFrame) / kOnsetHop + 1;
+    const size_t bins = kOnsetFrame / 2 + 1;
+    const size_t bassBins = std::min(bins, static_cast<size_t>(kBassLimit * kOnsetFrame / rate) + 1);
+    const float magnitudeScale = 2.0f / static_cast<float>(kOnsetFrame);
+
+    RealFFT fft(kOnsetFrame);
+    const auto window = RealFFT::hannWindow(kOnsetFrame);
+    std::vector<float> frame(kOnsetFrame);
+    std::vector<std::complex<float>> spectrum(bins);
+    std::vector<float> previous(bins, 0.0f);
+    flux.assign(count, 0.0f);
+    bass.assign(count, 0.0f);
+
+    for (size_t t = 0; t < count; ++t) {
+        const float* input = signal.data() + t * kOnsetHop;
+        for (size_t i = 0; i < kOnsetFrame; ++i) {
+            frame[i] = input[i] * window[i];
+        }
+        fft.forward(frame.data(), spectrum.data());
+
+        float total = 0.0f;
+        float low = 0.0f;
+        for (size_t b = 0; b < bins; ++b) {
+            const float magnitude = std::log1p(kLogCompression * magnitudeScale * std::abs(spectrum[b]));
+            const float rise = magnitude - previous[b];
+            previous[b] = magnitude;
+            if (rise <= 0.0f) continue;
+            total += rise;
+            if (b < bassBins) low += rise;
+        }
+        // Der erste Frame hat keinen Vorgänger
+        if (t > 0) {
+            flux[t] = total;
+            bass[t] = low;
+        }
+    }
+}
+
+// Gleitenden Mittelwert abziehen, gleichrichten und leicht glätten (Gauß, sigma = 1 Frame)
+std::vector<float> novelty(const std::vector<float>& envelope, size_t radius) {
+    const size_t count = envelope.size();
+    std::vector<double> prefix(count + 1, 0.0);
+    for (size_t i = 0; i < count; ++i) {
+        prefix[i + 1] = prefix[i] + envelope[i];
+    }
+
+    std::vector<float> rectified(count);
+    for (size_t i = 0; i < count; ++i) {
+        const size_t first = i >= radius ? i - radius : 0;
+        const size_t last = std::min(count, i + radius + 1);
+        const double mean = (prefix[last] - prefix[first]) / static_cast<double>(last - first);
+        rectified[i] = std::max(0.0f, envelope[i] - static_cast<float>(mean));
+    }
+
+    constexpr float kSmoothing[5] = {0.054f, 0.242f, 0.399f, 0.242f, 0.054f};
+    std::vector<float> smoothed(count, 0.0f);
+    for (size_t i = 0; i < count; ++i) {
+        float sum = 0.0f;
+        for (int k = -2; k <= 2; ++k) {
+            const long index = static_cast<long>(i) + k;
+            if (index >= 0 && index < static_cast<long>(count)) sum += kSmoothing[k + 2] * rectified[index];
+        }
+        smoothed[i] = sum;
+    }
+    return smoothed;
+}
+
+// Autokorrelation über die FFT (Nullauffüllung, kein zyklisches Übersprechen)
+std::vector<float> autocorrelation(const std::vector<float>& values, size_t maxLag) {
+    size_t size = 2;
+    while (size < 2 * values.size()) size <<= 1;
+
+    RealFFT fft(size);
+    std::vector<float> padded(size, 0.0f);
+    std::copy(values.begin(), values.end(), padded.begin());
+    std::vector<std::complex<float>> spectrum(fft.getNumBins());
+    fft.forward(padded.data(), spectrum.data());
+    for (auto& bin : spectrum) {
+        bin = {std::norm(bin), 0.0f};
+    }
+    fft.inverse(spectrum.data(), padded.data());
+
+    padded.resize(std::min(size, maxLag + 1));
+    const float scale = 1.0f / static_cast<float>(size);
+    for (float& value : padded) {
+        value *= scale;
+    }
+    return padded;
+}
+
+std::vector<Chroma> chromagram(const std::vector<float>& signal, double rate) {
+    std::vector<Chroma> chroma;
+    if (signal.size() < kChromaFrame) return chroma;
+
+    const size_t count = (signal.size() - kChromaFrame) / kChromaHop + 1;
+    const size_t bins = kChromaFrame / 2 + 1;
+    const float magnitudeScale = 2.0f / static_cast<float>(kChromaFrame);
+
+    // Bin -> Pitch-Class, gewichtet nach Abstand zur Halbtonmitte
+    std::vector<int> pitchClass(bins, -1);
+    std::vector<float> weight(bins, 0.0f);
+    for (size_t b = 1; b < bins; ++b) {
+        const double frequency = static_cast<double>(b) * rate / kChromaFrame;
+        if (frequency < kChromaLow || frequency > kChromaHigh) continue;
+        const double midi = 69.0 + 12.0 * std::log2(frequency / 440.0);
+        const double nearest = std::round(midi);
+        const double closeness = std::cos(kPi * (midi - nearest));
+        pitchClass[b] = static_cast<int>(nearest) % 12;
+        weight[b] = static_cast<float>(closeness * closeness);
+    }
+
+    RealFFT fft(kChromaFrame);
+    const auto window = RealFFT::hannWindow(kChromaFrame);
+    std::vector<float> frame(kChromaFrame);
+    std::vector<std::complex<float>> spectrum(bins);
+    chroma.assign(count, Chroma{});
+
+    for (size_t t = 0; t < count; ++t) {
+        const float* input = signal.data() + t * kChromaHop;
+        for (size_t i = 0; i < kChromaFrame; ++i) {
+            frame[i] = input[i] * window[i];
+        }
+        fft.forward(frame.data(), spectrum.data());
+        for (size_t b = 0; b < bins; ++b) {
+            if (pitchClass[b] < 0) continue;
+            chroma[t][pitchClass[b]] += weight[b] * std::log1p(kLogCompression * magnitudeScale * std::abs(spectrum[b]));
+        }
+    }
+    return chroma;
+}
+
+float correlate(const Chroma& chroma, const Chroma& profile, int tonic) {
+    float chromaMean = 0.0f;
+    float profileMean = 0.0f;
+    for (int i = 0; i < 12; ++i) {
+        chromaMean += chroma[i];
+        profileMean += profile[i];
+    }
+    chromaMean /= 12.0f;
+    profileMean /= 12.0f;
+
+    float covariance = 0.0f;
+    float chromaVariance = 0.0f;
+    float profileVariance = 0.0f;
+    for (int i = 0; i < 12; ++i) {
+        const float c = chroma[i] - chromaMean;
+        const float p = profile[(i - tonic + 12) % 12] - profileMean;
+        covariance += c * p;
+        chromaVariance += c * c;
+        profileVariance += p * p;
+    }
+    const float denominator = std::sqrt(chromaVariance * profileVariance);
+    return denominator > 0.0f ? covariance / denominator : 0.0f;
+}
+
+void estimateKey(const std::vector<Chroma>& chroma, TrackAnalysis& result) {
+    Chroma total{};
+    for (const auto& frame : chroma) {
+        for (int i = 0; i < 12; ++i) {
+            total[i] += frame[i];
+        }
+    }
+    if (*std::max_element(total.begin(), total.end()) <= 0.0f) return;
+
+    float best = -1.0f;
+    for (int tonic = 0; tonic < 12; ++tonic) {
+        const float major = correlate(total, kMajorProfile, tonic);
+        const float minor = correlate(total, kMinorProfile, tonic);
+        if (major > best) {
+            best = major;
+            result.key = tonic;
+            result.minor = false;
+        }
+        if (minor > best) {
+            best = minor;
+            result.key = tonic;
+            result.minor = true;
+        }
+    }
+    result.keyConfidence = std::clamp(best, 0.0f, 1.0f);
+}
+
+// Summe der Onset-Kurve auf einem konstanten Grid
+float gridScore(const std::vector<float>& onset, double period, double phase) {
+    float score = 0.0f;
+    for (double position = phase; position < static_cast<double>(onset.size()); position += period) {
+        score += sampleAt(onset, position);
+    }
+    return score;
+}
+
+// Taktphase mit den stärksten Bass-Onsets und Harmoniewechseln
+size_t findDownbeat(const std::vector<float>& bass, const std::vector<Chroma>& chroma,
+                    double period, double phase, int beatsPerBar) {
+    if (beatsPerBar <= 1) return 0;
+
+    std::vector<double> beatFrames;
+    for (double position = phase; position < static_cast<double>(bass.size()); position += period) {
+        beatFrames.push_back(position);
+    }
+    if (beatFrames.size() < static_cast<size_t>(2 * beatsPerBar)) return 0;
+
+    const size_t count = beatFrames.size();
+    std::vector<float> bassAccent(count, 0.0f);
+    std::vector<float> chordChange(count, 0.0f);
+    Chroma previous{};
+    for (size_t i = 0; i < count; ++i) {
+        const long center = std::lround(beatFrames[i]);
+        for (long k = center - 2; k <= center + 2; ++k) {
+            if (k >= 0 && k < static_cast<long>(bass.size())) bassAccent[i] = std::max(bassAccent[i], bass[k]);
+        }
+
+        // Chroma über die Dauer des Beats (Zeitbasis: Samples der Analyse-Rate)
+        const double start = beatFrames[i] * kOnsetHop;
+        const double end = start + period * kOnsetHop;
+        Chroma current{};
+        for (size_t t = 0; t < chroma.size(); ++t) {
+            const double center = static_cast<double>(t * kChromaHop + kChromaFrame / 2);
+            if (center < start) continue;
+            if (center >= end) break;
+            for (int c = 0; c < 12; ++c) {
+                current[c] += chroma[t][c];
+            }
+        }
+
+        float dot = 0.0f;
+        float currentNorm = 0.0f;
+        float previousNorm = 0.0f;
+        for (int c = 0; c < 12; ++c) {
+            dot += current[c] * previous[c];
+            currentNorm += current[c] * current[c];
+            previousNorm += previous[c] * previous[c];
+        }
+        if (i > 0 && currentNorm > 0.0f && previousNorm > 0.0f) {
+            chordChange[i] = 1.0f - dot / std::sqrt(currentNorm * previousNorm);
+        }
+        previous = current;
+    }
+
+    float bassMean = 0.0f;
+    float changeMean = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        bassMean += bassAccent[i];
+        changeMean += chordChange[i];
+    }
+    bassMean = std::max(bassMean / count, 1e-9f);
+    changeMean = std::max(changeMean / count, 1e-9f);
+
+    size_t best = 0;
+    float bestScore = -1.0f;
+    for (int bar = 0; bar < beatsPerBar; ++bar) {
+        float score = 0.0f;
+        size_t beats = 0;
+        for (size_t i = bar; i < count; i += beatsPerBar) {
+            score += bassAccent[i] / bassMean + chordChange[i] / changeMean;
+            ++beats;
+        }
+        score /= static_cast<float>(std::max<size_t>(1, beats));
+        if (score > bestScore) {
+            bestScore = score;
+            best = static_cast<size_t>(bar);
+        }
+    }
+    return best;
+}
+
+void estimateTempo(const std::vector<float>& signal, double rate, size_t factor,
+                   const std::vector<Chroma>& chroma, const TempoKeyDetector::Settings& settings,
+                   TrackAnalysis& result) {
+    std::vector<float> flux;
+    std::vector<float> bass;
+    onsetEnvelopes(signal, rate, flux, bass);
+
+    const double framesPerSecond = rate / kOnsetHop;
+    const double minBpm = std::max(20.0, static_cast<double>(std::min(settings.minBpm, settings.maxBpm)));
+    const double maxBpm = std::max(minBpm + 1.0, static_cast<double>(std::max(settings.minBpm, settings.maxBpm)));
+    const double longestLag = framesPerSecond * 60.0 / minBpm;
+    if (flux.size() < static_cast<size_t>(2.0 * kCombTeeth * longestLag)) return;
+
+    const auto onset = novelty(flux, static_cast<size_t>(framesPerSecond * 0.25));
+
+    // Ohne Gleichanteil, sonst korreliert auch Rauschen bei jedem Lag
+    double onsetMean = 0.0;
+    for (float value : onset) {
+        onsetMean += value;
+    }
+    onsetMean /= static_cast<double>(onset.size());
+    std::vector<float> centered(onset.size());
+    for (size_t i = 0; i < onset.size(); ++i) {
+        centered[i] = onset[i] - static_cast<float>(onsetMean);
+    }
+    const auto acf = autocorrelation(centered, static_cast<size_t>(kCombTeeth * longestLag) + 2);
+    if (acf[0] <= 0.0f) return;
+
+    // Kammfilter über die Autokorrelation, gewichtet mit der Tempo-Präferenz
+    double bestBpm = 0.0;
+    double bestScore = 0.0;
+    double bestComb = 0.0;
+    double teethWeight = 0.0;
+    for (int k = 1; k <= kCombTeeth; ++k) {
+        teethWeight += 1.0 / k;
+    }
+    const double preferredBpm = std::clamp(static_cast<double>(settings.preferredBpm), minBpm, maxBpm);
+    for (double bpm = minBpm; bpm <= maxBpm; bpm += kBpmStep) {
+        const double lag = framesPerSecond * 60.0 / bpm;
+        double comb = 0.0;
+        for (int k = 1; k <= kCombTeeth; ++k) {
+            comb += sampleAt(acf, k * lag) / k;
+        }
+        const double octaves = std::log2(bpm / preferredBpm) / kPreferenceOctaves;
+        const double score = comb * std::exp(-0.5 * octaves * octaves);
+        if (score > bestScore) {
+            bestScore = score;
+            bestComb = comb;
+            bestBpm = bpm;
+        }
+    }
+    if (bestBpm <= 0.0) return;
+
+    // Periode und Phase des Grids gemeinsam verfeinern
+    const double coarsePeriod = framesPerSecond * 60.0 / bestBpm;
+    double period = coarsePeriod;
+    double phase = 0.0;
+    float bestGrid = -1.0f;
+    for (int step = -kPeriodSteps; step <= kPeriodSteps; ++step) {
+        const double candidate = coarsePeriod * (1.0 + kPeriodRange * step / kPeriodSteps);
+        for (double offset = 0.0; offset < candidate; offset += 0.5) {
+            const float score = gridScore(onset, candidate, offset);
+            if (score > bestGrid) {
+                bestGrid = score;
+                period = candidate;
+                phase = offset;
+            }
+        }
+    }
+    const double coarsePhase = phase;
+    for (double offset = coarsePhase - 0.5; offset <= coarsePhase + 0.5; offset += 0.05) {
+        const double wrapped = offset < 0.0 ? offset + period : offset;
+        const float score = gridScore(onset, period, wrapped);
+        if (score > bestGrid) {
+            bestGrid = score;
+            phase = wrapped;
+        }
+    }
+
+    result.bpm = framesPerSecond * 60.0 / period;
+    result.tempoConfidence = static_cast<float>(std::clamp(bestComb / (acf[0] * teethWeight), 0.0, 1.0));
+    result.downbeat = findDownbeat(bass, chroma, period, phase, result.beatsPerBar);
+
+    // Frame-Index -> Samples der Originalrate
+    const double hopSamples = static_cast<double>(kOnsetHop * factor);
+    const double delay = kOnsetDelay * static_cast<double>(kOnsetFrame * factor);
+    for (double position = phase * hopSamples + delay; position < static_cast<double>(result.frames);
+         position += period * hopSamples) {
+        result.beats.push_back(static_cast<size_t>(std::lround(position)));
+    }
+    result.downbeat = std::min(result.downbeat, result.beats.empty() ? 0 : result.beats.size() - 1);
+}
+
+int camelotNumber(int majorTonic) {
+    return (majorTonic * 7 % 12 + 7) % 12 + 1;
+}
+
+uint64_t hashSamples(const std::vector<float>& data) {
+    // FNV-1a über die Rohbytes
+    uint64_t hash = 14695981039346656037ull;
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+    const size_t size = data.size() * sizeof(float);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+std::string TrackAnalysis::keyName() const {
+    if (key < 0 || key > 11) return {};
+    return std::string(kPitchNames[key]) + (minor ? "m" : "");
+}
+
+std::string TrackAnalysis::camelot() const {
+    if (key < 0 || key > 11) return {};
+    // Moll liegt auf der Nummer seiner Paralleltonart
+    const int number = camelotNumber(minor ? (key + 3) % 12 : key);
+    return std::to_string(number) + (minor ? "A" : "B");
+}
+
+TrackAnalysis TempoKeyDetector::analyze(const float* data, size_t frames, int channels,
+                                        double sampleRate, const Settings& settings) {
+    TrackAnalysis result;
+    result.frames = frames;
+    result.sampleRate = sampleRate;
+    result.beatsPerBar = std::max(1, settings.beatsPerBar);
+    if (!data || frames == 0 || channels < 1 || sampleRate <= 0.0) return result;
+
+    size_t factor = 1;
+    const auto signal = downmix(data, frames, channels, sampleRate, factor);
+    const double rate = sampleRate / static_cast<double>(factor);
+
+    // Das Chromagramm dient auch der Downbeat-Suche
+    std::vector<Chroma> chroma;
+    if (settings.detectKey || result.beatsPerBar > 1) {
+        chroma = chromagram(signal, rate);
+    }
+    if (settings.detectKey) {
+        estimateKey(chroma, result);
+    }
+    estimateTempo(signal, rate, factor, chroma, settings, result);
+    return result;
+}
+
+bool TempoKeyDetector::areKeysCompatible(const TrackAnalysis& a, const TrackAnalysis& b) {
+    if (a.key < 0 || b.key < 0) return false;
+
+    const int numberA = camelotNumber(a.minor ? (a.key + 3) % 12 : a.key);
+    const int numberB = camelotNumber(b.minor ? (b.key + 3) % 12 : b.key);
+    if (a.minor != b.minor) return numberA == numberB;
+
+    const int distance = (numberA - numberB + 12) % 12;
+    return distance == 0 || distance == 1 || distance == 11;
+}
+
+double TempoKeyDetector::tempoRatio(const TrackAnalysis& track, double targetBpm) {
+    if (track.bpm <= 0.0 || targetBpm <= 0.0) return 1.0;
+
+    double best = targetBpm / track.bpm;
+    for (double multiple : {0.5, 2.0}) {
+        const double ratio = targetBpm / (track.bpm * multiple);
+        if (std::abs(std::log(ratio)) < std::abs(std::log(best))) best = ratio;
+    }
+    return best;
+}
+
+// Hintergrund-Analyse
+
+TempoKeyAnalyzer& TempoKeyAnalyzer::getInstance() {
+    static TempoKeyAnalyzer instance;
+    return instance;
+}
+
+TempoKeyAnalyzer::TempoKeyAnalyzer()
+    : m_activeJobs(0)
+    , m_cache("tempokey", "tempokey", kMaxMemoryEntries, &TempoKeyAnalyzer::readAnalysis, &TempoKeyAnalyzer::writeAnalysis)
+    , m_shouldStop(false)
+{
+    const unsigned workers = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < workers; ++i) {
+        m_workers.emplace_back(&TempoKeyAnalyzer::run, this);
+    }
+}
+
+TempoKeyAnalyzer::~TempoKeyAnalyzer() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shouldStop = true;
+        m_jobs.clear();
+    }
+    m_condition.notify_all();
+    m_idleCondition.notify_all();
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void TempoKeyAnalyzer::request(const std::shared_ptr<TrackAnalysisSlot>& slot, const std::string& path,
+                               std::shared_ptr<const std::vector<float>> data, int channels,
+                               double sampleRate, const TempoKeyDetector::Settings& settings) {
+    if (!slot || (!data && path.empty())) return;
+
+    Job job;
+    job.slot = slot;
+    job.generation = slot->beginRequest();
+    job.path = path;
+    job.data = std::move(data);
+    job.channels = std::max(1, channels);
+    job.sampleRate = sampleRate;
+    job.settings = settings;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_condition.notify_one();
+}
+
+void TempoKeyAnalyzer::waitUntilIdle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idleCondition.wait(lock, [this] { return m_shouldStop || (m_jobs.empty() && m_activeJobs == 0); });
+}
+
+size_t TempoKeyAnalyzer::getPendingJobs() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_jobs.size() + m_activeJobs;
+}
+
+void TempoKeyAnalyzer::setCacheDirectory(const std::string& directory) {
+    m_cache.setDirectory(directory);
+}
+
+void TempoKeyAnalyzer::clearMemoryCache() {
+    m_cache.clearMemory();
+}
+
+void TempoKeyAnalyzer::run() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_shouldStop || !m_jobs.empty(); });
+            if (m_shouldStop) return;
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            ++m_activeJobs;
+        }
+
+        process(job);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_activeJobs;
+            if (m_jobs.empty() && m_activeJobs == 0) m_idleCondition.notify_all();
+        }
+    }
+}
+
+void TempoKeyAnalyzer::process(Job& job) {
+    {
+        auto slot = job.slot.lock();
+        if (!slot || !slot->isCurrent(job.generation)) return;
+    }
+
+    const std::string key = makeKey(job);
+    std::shared_ptr<const TrackAnalysis> analysis = m_cache.find(key);
+    if (!analysis) {
+        // Dekodieren erst nach dem Cache-Test, das spart beim Re-Import die meiste Zeit
+        if (!job.data && !decode(job)) return;
+        const size_t frames = job.data->size() / static_cast<size_t>(job.channels);
+        auto analyzed = std::make_shared<TrackAnalysis>(
+            TempoKeyDetector::analyze(job.data->data(), frames, job.channels, job.sampleRate, job.settings));
+        m_cache.store(key, analyzed);
+        analysis = std::move(analyzed);
+    }
+
+    auto slot = job.slot.lock();
+    if (slot && slot->isCurrent(job.generation)) {
+        std::lock_guard<std::mutex> lock(m_publishMutex);
+        slot->publish(std::move(analysis));
+    }
+}
+
+bool TempoKeyAnalyzer::decode(Job& job) const {
+    SF_INFO fileInfo;
+    std::memset(&fileInfo, 0, sizeof(fileInfo));
+    SNDFILE* file = sf_open(job.path.c_str(), SFM_READ, &fileInfo);
+    if (!file) return false;
+
+    auto data = std::make_shared<std::vector<float>>(static_cast<size_t>(fileInfo.frames) * fileInfo.channels);
+    const sf_count_t read = sf_readf_float(file, data->data(), fileInfo.frames);
+    sf_close(file);
+    if (read <= 0 || fileInfo.channels < 1) return false;
+
+    data->resize(static_cast<size_t>(read) * fileInfo.channels);
+    job.channels = fileInfo.channels;
+    job.sampleRate = fileInfo.samplerate;
+    job.data = std::move(data);
+    return true;
+}
+
+std::string TempoKeyAnalyzer::makeKey(const Job& job) const {
+    std::ostringstream key;
+
+    std::error_code error;
+    const bool onDisk = !job.path.empty() && std::filesystem::is_regular_file(job.path, error);
+    if (onDisk) {
+        const std::string fileKey = AnalysisCacheFiles::fileKey(job.path);
+        if (fileKey.empty()) return {};
+        key << fileKey;
+    } else if (job.data) {
+        // Audio ohne Datei (Aufnahme, Bounce): Inhalt als Schlüssel
+        key << "data:" << std::hex << hashSamples(*job.data) << std::dec
+            << '|' << job.channels
+            << '|' << std::lround(job.sampleRate);
+    } else {
+        return {};
+    }
+
+    key << '|' << std::lround(job.settings.minBpm * 100.0f)
+        << '|' << std::lround(job.settings.maxBpm * 100.0f)
+        << '|' << std::lround(job.settings.preferredBpm * 100.0f)
+        << '|' << job.settings.beatsPerBar
+        << '|' << job.settings.detectKey;
+    return key.str();
+}
+
+bool TempoKeyAnalyzer::readAnalysis(std::istream& stream, size_t fileSize, TrackAnalysis& analysis) {
+    if (!(stream >> analysis.bpm >> analysis.tempoConfidence >> analysis.downbeat >> analysis.beatsPerBar
+                 >> analysis.key >> analysis.minor >> analysis.keyConfidence
+                 >> analysis.frames >> analysis.sampleRate)) {
+        return false;
+    }
+    return AnalysisCacheFiles::readPositions(stream, fileSize, analysis.beats);
+}
+
+void TempoKeyAnalyzer::writeAnalysis(std::ostream& stream, const TrackAnalysis& analysis) {
+    stream << std::setprecision(12)
+           << analysis.bpm << ' ' << analysis.tempoConfidence << ' ' << analysis.downbeat << ' '
+           << analysis.beatsPerBar << ' ' << analysis.key << ' ' << analysis.minor << ' '
+           << analysis.keyConfidence << ' ' << analysis.frames << ' ' << analysis.sampleRate << ' ';
+    AnalysisCacheFiles::writePositions(stream, analysis.beats);
+}
+
+} // namespace VRMusicStudio
@@ -0,0 +1,373 @@
+#include "audio/processing/TimeStretcher.hpp"
+#include "audio/processing/DspMath.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace VRMusicStudio {
+
+namespace {
+
+// Verhältnis positiver Spektralfluss / Gesamtenergie, ab dem ein Frame als Transiente gilt
+constexpr float kTransientThreshold = 0.3f;
+constexpr float kSilenceFloor = 1e-6f;
+
+inline float princarg(double phase) {
+    return static_cast<float>(phase - kTwoPi * std::floor(phase / kTwoPi + 0.5));
+}
+
+} // namespace
+
+TimeStretcher::TimeStretcher()
+    : m_quality(Quality::Standard)
+    , m_frameSize(0)
+    , m_hopSize(0)
+    , m_numBins(0)
+    , m_outputScale(1.0f)
+    , m_transients(true)
+    , m_fifoPos(0)
+    , m_speed(1.0)
+    , m_resetPosition(0.0)
+    , m_analysisCenter(0.0)
+    , m_sourcePosition(0.0)
+    , m_prevCenter(0)
+    , m_prevReversed(false)
+    , m_firstFrame(true)
+    , m_pendingPreroll(0)
+    , m_transientHold(0)
+{
+}
+
+TimeStretcher::~TimeStretcher() = default;
+
+void TimeStretcher::prepare(Quality quality) {
+    m_quality = quality;
+    size_t overlap = 4;
+    switch (quality) {
+        case Quality::Draft:
+            m_frameSize = 1024;
+            m_transients = false;
+            break;
+        case Quality::Standard:
+            m_frameSize = 2048;
+            m_transients = true;
+            break;
+        case Quality::High:
+            m_frameSize = 4096;
+            overlap = 8;
+            m_transients = true;
+            break;
+    }
+    m_hopSize = m_frameSize / overlap;
+    m_numBins = m_frameSize / 2 + 1;
+
+    m_fft = std::make_unique<RealFFT>(m_frameSize);
+    m_window = RealFFT::hannWindow(m_frameSize);
+
+    // Analyse- und Synthesefenster: Summe der w² über alle überlappenden Frames normieren
+    double windowEnergy = 0.0;
+    for (float w : m_window) windowEnergy += static_cast<double>(w) * w;
+    m_outputScale = static_cast<float>(static_cast<double>(m_hopSize) / (windowEnergy * static_cast<double>(m_frameSize)));
+
+    m_frame.assign(m_frameSize, 0.0f);
+    m_spectrum.assign(m_numBins, {0.0f, 0.0f});
+    m_magnitude.assign(m_numBins, 0.0f);
+    m_phase.assign(m_numBins, 0.0f);
+    m_prevMagnitude.assign(m_numBins, 0.0f);
+    m_prevPhase.assign(m_numBins, 0.0f);
+    m_synthPhase.assign(m_numBins, 0.0f);
+    m_peaks.assign(m_numBins, 0);
+    m_overlapAdd.assign(m_frameSize, 0.0f);
+    m_fifo.assign(m_hopSize, 0.0f);
+
+    reset(0.0);
+}
+
+void TimeStretcher::reset(double sourcePosition) {
+    std::fill(m_overlapAdd.begin(), m_overlapAdd.end(), 0.0f);
+    std::fill(m_prevMagnitude.begin(), m_prevMagnitude.end(), 0.0f);
+    m_fifoPos = m_hopSize;
+    m_resetPosition = sourcePosition;
+    m_sourcePosition = sourcePosition;
+    m_firstFrame = true;
+    m_transientHold = 0;
+
+    // Die Frames vor dem Startpunkt werden beim ersten Aufruf verworfen, damit
+    // das Overlap-Add am Start bereits vollständig ist
+    m_pendingPreroll = m_hopSize > 0 ? m_frameSize / m_hopSize - 1 : 0;
+}
+
+void TimeStretcher::setSpeed(double speed) {
+    const double magnitude = std::clamp(std::fabs(speed), kMinSpeed, kMaxSpeed);
+    m_speed = speed < 0.0 ? -magnitude : magnitude;
+}
+
+void TimeStretcher::process(const Source& source, float* output, size_t numFrames) {
+    while (numFrames > 0) {
+        if (m_fifoPos == m_hopSize) synthesizeHop(source);
+
+        const size_t count = std::min(numFrames, m_hopSize - m_fifoPos);
+        std::memcpy(output, m_fifo.data() + m_fifoPos, count * sizeof(float));
+        m_fifoPos += count;
+        m_sourcePosition += m_speed * static_cast<double>(count);
+        output += count;
+        numFrames -= count;
+    }
+}
+
+void TimeStretcher::synthesizeHop(const Source& source) {
+    if (m_pendingPreroll > 0) {
+        m_analysisCenter = m_resetPosition - static_cast<double>(m_frameSize / 2 - m_hopSize) * m_speed;
+        for (; m_pendingPreroll > 0; --m_pendingPreroll) {
+            processFrame(source);
+        }
+    }
+    processFrame(source);
+}
+
+void TimeStretcher::processFrame(const Source& source) {
+    const bool reversed = m_speed < 0.0;
+    const long center = std::lround(m_analysisCenter);
+    readFrame(source, center, reversed);
+    m_fft->forward(m_frame.data(), m_spectrum.data());
+
+    for (size_t k = 0; k < m_numBins; ++k) {
+        m_magnitude[k] = std::abs(m_spectrum[k]);
+        m_phase[k] = std::arg(m_spectrum[k]);
+    }
+
+    // Rückwärts gelesene Frames bilden ein vorwärts laufendes Signal, dessen Hop
+    // das Vorzeichen wechselt
+    const long analysisHop = reversed ? m_prevCenter - center : center - m_prevCenter;
+    const bool restart = m_firstFrame || reversed != m_prevReversed;
+    const bool transient = !restart && detectTransient();
+
+    if (restart || transient || analysisHop == static_cast<long>(m_hopSize)) {
+        // Phasen übernehmen: Neustart, Transiente oder 1:1-Wiedergabe
+        std::copy(m_phase.begin(), m_phase.end(), m_synthPhase.begin());
+    } else {
+        propagatePhases(analysisHop);
+    }
+
+    for (size_t k = 0; k < m_numBins; ++k) {
+        m_spectrum[k] = std::polar(m_magnitude[k], m_synthPhase[k]);
+    }
+    m_fft->inverse(m_spectrum.data(), m_frame.data());
+
+    for (size_t i = 0; i < m_frameSize; ++i) {
+        m_overlapAdd[i] += m_frame[i] * m_window[i] * m_outputScale;
+    }
+
+    // Fertigen Hop ausgeben und den Overlap-Add-Puffer weiterschieben
+    std::memcpy(m_fifo.data(), m_overlapAdd.data(), m_hopSize * sizeof(float));
+    std::memmove(m_overlapAdd.data(), m_overlapAdd.data() + m_hopSize, (m_frameSize - m_hopSize) * sizeof(float));
+    std::fill(m_overlapAdd.end() - static_cast<std::ptrdiff_t>(m_hopSize), m_overlapAdd.end(), 0.0f);
+    m_fifoPos = 0;
+
+    m_prevMagnitude.swap(m_magnitude);
+    m_prevPhase.swap(m_phase);
+    m_prevCenter = center;
+    m_prevReversed = reversed;
+    m_firstFrame = false;
+    m_analysisCenter += static_cast<double>(m_hopSize) * m_speed;
+}
+
+void TimeStretcher::readFrame(const Source& source, long center, bool reversed) {
+    const long half = static_cast<long>(m_frameSize / 2);
+    const long frames = static_cast<long>(source.frames);
+    const int channels = std::max(1, source.channels);
+    const float channelScale = 1.0f / static_cast<float>(channels);
+
+    for (size_t i = 0; i < m_frameSize; ++i) {
+        const long offset = static_cast<long>(i) - half;
+        long index = reversed ? center - offset : center + offset;
+
+        float value = 0.0f;
+        if (source.data && frames > 0) {
+            if (source.loop) {
+                index %= frames;
+                if (index < 0) index += frames;
+            }
+            if (index >= 0 && index < frames) {
+                const float* frame = source.data + static_cast<size_t>(index) * static_cast<size_t>(channels);
+                for (int c = 0; c < channels; ++c) value += frame[c];
+                value *= channelScale;
+            }
+        }
+        m_frame[i] = value * m_window[i];
+    }
+}
+
+bool TimeStretcher::detectTransient() {
+    if (!m_transients) return false;
+
+    // Eine Transiente bleibt mehrere Hops im Fenster, nur einmal zurücksetzen
+    if (m_transientHold > 0) {
+        --m_transientHold;
+        return false;
+    }
+
+    float flux = 0.0f;
+    float energy = 0.0f;
+    for (size_t k = 0; k < m_numBins; ++k) {
+        const float rise = m_magnitude[k] - m_prevMagnitude[k];
+        if (rise > 0.0f) flux += rise;
+        energy += m_magnitude[k];
+    }
+    if (energy < kSilenceFloor * static_cast<float>(m_numBins)) return false;
+
+    if (flux / energy > kTransientThreshold) {
+        m_transientHold = m_frameSize / m_hopSize - 1;
+        return true;
+    }
+    return false;
+}
+
+void TimeStretcher::propagatePhases(long analysisHop) {
+    const double binFrequency = kTwoPi / static_cast<double>(m_frameSize);
+    const double hop = static_cast<double>(analysisHop);
+    const double synthesisHop = static_cast<double>(m_hopSize);
+
+    auto advance = [&](size_t k) {
+        const double omega = binFrequency * static_cast<double>(k);
+        double frequency = omega;
+        if (analysisHop > 0) {
+            const double deviation = princarg(m_phase[k] - m_prevPhase[k] - omega * hop);
+            frequency = omega + deviation / hop;
+        }
+        m_synthPhase[k] = princarg(m_synthPhase[k] + frequency * synthesisHop);
+    };
+
+    // Identity Phase Locking (Laroche/Dolson): nur Peaks propagieren, die Bins
+    // in ihrem Einflussbereich behalten den Phasenabstand zum Peak
+    size_t numPeaks = 0;
+    for (size_t k = 2; k + 2 < m_numBins; ++k) {
+        const float m = m_magnitude[k];
+        if (m > m_magnitude[k - 1] && m > m_magnitude[k - 2] &&
+            m >= m_magnitude[k + 1] && m >= m_magnitude[k + 2]) {
+            m_peaks[numPeaks++] = k;
+        }
+    }
+
+    if (numPeaks == 0) {
+        for (size_t k = 0; k < m_numBins; ++k) advance(k);
+        return;
+    }
+
+    for (size_t p = 0; p < numPeaks; ++p) advance(m_peaks[p]);
+
+    size_t regionStart = 0;
+    for (size_t p = 0; p < numPeaks; ++p) {
+        const size_t peak = m_peaks[p];
+        size_t regionEnd = m_numBins;
+        if (p + 1 < numPeaks) {
+            // Grenze am Minimum zwischen zwei Peaks
+            const size_t nextPeak = m_peaks[p + 1];
+            regionEnd = peak + 1;
+            for (size_t k = peak + 1; k < nextPeak; ++k) {
+                if (m_magnitude[k] < m_magnitude[regionEnd]) regionEnd = k;
+            }
+            regionEnd += 1;
+        }
+
+        const float peakSynth = m_synthPhase[peak];
+        const float peakPhase = m_phase[peak];
+        for (size_t k = regionStart; k < regionEnd; ++k) {
+            if (k != peak) m_synthPhase[k] = princarg(peakSynth + (m_phase[k] - peakPhase));
+        }
+        regionStart = regionEnd;
+    }
+}
+
+std::vector<float> TimeStretcher::render(const Source& source, double speed, Quality quality) {
+    TimeStretcher stretcher;
+    stretcher.prepare(quality);
+    stretcher.setSpeed(speed);
+
+    const double length = static_cast<double>(source.frames);
+    const size_t outputFrames = static_cast<size_t>(std::ceil(length / std::fabs(stretcher.getSpeed())));
+    stretcher.reset(stretcher.getSpeed() < 0.0 ? length - 1.0 : 0.0);
+
+    std::vector<float> output(outputFrames);
+    stretcher.process(source, output.data(), outputFrames);
+    return output;
+}
+
+// Hintergrund-Rendering
+
+TimeStretchPrerenderer& TimeStretchPrerenderer::getInstance() {
+    static TimeStretchPrerenderer instance;
+    return instance;
+}
+
+TimeStretchPrerenderer::TimeStretchPrerenderer()
+    : m_shouldStop(false)
+{
+    m_worker = std::thread(&TimeStretchPrerenderer::run, this);
+}
+
+TimeStretchPrerenderer::~TimeStretchPrerenderer() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shouldStop = true;
+        m_jobs.clear();
+    }
+    m_condition.notify_all();
+    if (m_worker.joinable()) m_worker.join();
+}
+
+void TimeStretchPrerenderer::request(const std::shared_ptr<StretchSlot>& slot,
+                                     std::shared_ptr<const std::vector<float>> source,
+                                     double speed, TimeStretcher::Quality quality) {
+    if (!slot || !source) return;
+
+    Job job;
+    job.slot = slot;
+    job.generation = slot->beginRequest();
+    job.source = std::move(source);
+    job.speed = speed;
+    job.quality = quality;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_condition.notify_one();
+}
+
+void TimeStretchPrerenderer::cancel(const std::shared_ptr<StretchSlot>& slot) {
+    if (slot) slot->cancel();
+}
+
+void TimeStretchPrerenderer::run() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_shouldStop || !m_jobs.empty(); });
+            if (m_shouldStop) return;
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        // Überholte Aufträge gar nicht erst rendern
+        auto slot = job.slot.lock();
+        if (!slot || !slot->isCurrent(job.generation)) continue;
+        slot.reset();
+
+        TimeStretcher::Source source;
+        source.data = job.source->data();
+        source.frames = job.source->size();
+
+        auto clip = std::make_shared<StretchedClip>();
+        clip->speed = job.speed;
+        clip->quality = job.quality;
+        clip->audio = TimeStretcher::render(source, job.speed, job.quality);
+
+        slot = job.slot.lock();
+        if (!slot || !slot->isCurrent(job.generation)) continue;
+        slot->publish(std::move(clip));
+    }
+}
+
+} // namespace VRMusicStudio
@@ -0,0 +1,531 @@
+#include "audio/processing/WindModel.hpp"
+#include "audio/processing/DspMath.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace VRMusicStudio {
+
+namespace {
+
+using SimdOps::Float4;
+
+// Lippenresonator: Güte und Spitzenverstärkung
+constexpr double kLipQuality = 20.0;
+constexpr double kLipGain = 10.0;
+
+// One-pole lowpass (1 - b) / (1 - b z^-1): phase delay at w
+double onePoleDelay(double b, double w) {
+    return std::atan2(b * std::sin(w), 1.0 - b * std::cos(w)) / w;
+}
+
+// Linear interpolierter Abgriff `delay` Samples vor `write`
+float readLine(const float* line, size_t write, float delay, size_t mask) {
+    const size_t whole = static_cast<size_t>(delay);
+    const float fraction = delay - static_cast<float>(whole);
+    const float a = line[(write - whole) & mask];
+    const float b = line[(write - whole - 1) & mask];
+    return a + (b - a) * fraction;
+}
+
+Float4 clamp1(Float4 x) {
+    return min(max(x, Float4::set1(-1.0f)), Float4::set1(1.0f));
+}
+
+WindModel::Preset makePreset(WindModel::Excitation excitation, float lowestFrequency, float pressure,
+                             float toneHoleCutoff, float reflection, float noise, float attack,
+                             float release, float gain) {
+    WindModel::Preset preset;
+    preset.excitation = excitation;
+    preset.lowestFrequency = lowestFrequency;
+    preset.pressure = pressure;
+    preset.toneHoleCutoff = toneHoleCutoff;
+    preset.reflection = reflection;
+    preset.noise = noise;
+    preset.attack = attack;
+    preset.release = release;
+    preset.gain = gain;
+    return preset;
+}
+
+} // namespace
+
+// Tiefster Ton, Blasdruck, Tonloch-Grenzfrequenz, Reflexion, Atemrauschen,
+// Ansprache, Ausklingen, Ausgangspegel
+WindModel::Preset WindModel::flute() {
+    Preset preset = makePreset(Excitation::Jet, 246.0f, 1.15f, 3000.0f, 0.98f, 0.12f, 0.04f, 0.08f, 0.5f);
+    preset.split = 0.32f;
+    preset.dynamics = 0.2f;
+    return preset;
+}
+
+WindModel::Preset WindModel::recorder() {
+    Preset preset = makePreset(Excitation::Jet, 349.0f, 1.05f, 4000.0f, 0.98f, 0.06f, 0.02f, 0.05f, 0.5f);
+    preset.split = 0.32f;
+    preset.dynamics = 0.1f;
+    return preset;
+}
+
+WindModel::Preset WindModel::oboe() {
+    Preset preset = makePreset(Excitation::ConicalReed, 233.0f, 1.1f, 3500.0f, 0.95f, 0.1f, 0.02f, 0.05f, 0.75f);
+    preset.reedSlope = -0.25f;
+    preset.split = 0.35f;
+    preset.dynamics = 0.15f;
+    return preset;
+}
+
+WindModel::Preset WindModel::englishHorn() {
+    Preset preset = makePreset(Excitation::ConicalReed, 164.0f, 0.97f, 2500.0f, 0.95f, 0.1f, 0.03f, 0.06f, 0.65f);
+    preset.reedSlope = -0.28f;
+    preset.split = 0.35f;
+    preset.dynamics = 0.1f;
+    return preset;
+}
+
+WindModel::Preset WindModel::clarinet() {
+    Preset preset = makePreset(Excitation::CylindricalReed, 146.0f, 0.88f, 1500.0f, 0.95f, 0.15f, 0.02f, 0.05f, 1.2f);
+    preset.reedSlope = -0.3f;
+    preset.dynamics = 0.07f;
+    return preset;
+}
+
+WindModel::Preset WindModel::bassClarinet() {
+    Preset preset = makePreset(Excitation::CylindricalReed, 58.0f, 0.88f, 800.0f, 0.95f, 0.15f, 0.04f, 0.08f, 1.2f);
+    preset.reedSlope = -0.32f;
+    preset.dynamics = 0.07f;
+    return preset;
+}
+
+WindModel::Preset WindModel::bassoon() {
+    Preset preset = makePreset(Excitation::ConicalReed, 58.0f, 0.97f, 1000.0f, 0.95f, 0.1f, 0.04f, 0.08f, 0.9f);
+    preset.reedSlope = -0.3f;
+    preset.split = 0.4f;
+    preset.dynamics = 0.06f;
+    return preset;
+}
+
+WindModel::Preset WindModel::saxophone() {
+    Preset preset = makePreset(Excitation::ConicalReed, 138.0f, 0.95f, 2500.0f, 0.95f, 0.2f, 0.02f, 0.05f, 0.8f);
+    preset.reedSlope = -0.3f;
+    preset.split = 0.35f;
+    preset.dynamics = 0.12f;
+    return preset;
+}
+
+WindModel::Preset WindModel::horn() {
+    Preset preset = makePreset(Excitation::Lip, 55.0f, 1.0f, 1200.0f, 0.85f, 0.03f, 0.04f, 0.08f, 1.8f);
+    preset.dynamics = 0.3f;
+    return preset;
+}
+
+WindModel::Preset WindModel::trumpet() {
+    Preset preset = makePreset(Excitation::Lip, 155.0f, 1.0f, 4000.0f, 0.85f, 0.03f, 0.015f, 0.05f, 1.8f);
+    preset.dynamics = 0.3f;
+    return preset;
+}
+
+WindModel::Preset WindModel::trombone() {
+    Preset preset = makePreset(Excitation::Lip, 55.0f, 1.0f, 2500.0f, 0.85f, 0.03f, 0.025f, 0.06f, 1.8f);
+    preset.dynamics = 0.3f;
+    return preset;
+}
+
+WindModel::Preset WindModel::tuba() {
+    Preset preset = makePreset(Excitation::Lip, 29.0f, 1.0f, 800.0f, 0.85f, 0.03f, 0.05f, 0.1f, 1.8f);
+    preset.dynamics = 0.3f;
+    return preset;
+}
+
+WindModel::WindModel(const Preset& preset, int maxVoices, double sampleRate)
+    : m_preset(preset),
+      m_sampleRate(sampleRate),
+      m_write(0),
+      m_breath(1.0f),
+      m_vibratoDepth(0.0f),
+      m_vibratoRate(5.0f),
+      m_vibratoPhase(0.0),
+      m_vibratoApplied(false),
+      m_expression(1.0f),
+      m_expressionTarget(1.0f),
+      m_gain(1.0f),
+      m_legato(false),
+      m_startCounter(0),
+      m_noiseState(0x9e3779b9u) {
+    m_preset.lowestFrequency = std::max(m_preset.lowestFrequency, 20.0f);
+
+    // Flöten: Rohr 3/2 Perioden lang, Vibrato braucht etwas Reserve
+    const double period = m_sampleRate / m_preset.lowestFrequency;
+    const double longest = 1.5 * period * 1.1 + 8.0;
+    m_lineSize = nextPowerOfTwo(static_cast<size_t>(longest));
+    m_lineMask = m_lineSize - 1;
+    m_lossPole = static_cast<float>(std::exp(-2.0 * kPi * std::clamp(m_preset.toneHoleCutoff, 100.0f, 20000.0f) / m_sampleRate));
+
+    const size_t voices = static_cast<size_t>((std::max(maxVoices, 1) + kLanes - 1) / kLanes * kLanes);
+    m_voices.resize(voices);
+    for (auto* lane : {&m_lanes.envelope, &m_lanes.level, &m_lanes.boreDelay, &m_lanes.auxDelay, &m_lanes.loss,
+                       &m_lanes.dcIn, &m_lanes.dcOut, &m_lanes.lipB0, &m_lanes.lipA1, &m_lanes.lipA2,
+                       &m_lanes.lipX1, &m_lanes.lipX2, &m_lanes.lipY1, &m_lanes.lipY2, &m_lanes.energy}) {
+        lane->assign(voices, 0.0f);
+    }
+    m_bore.assign(voices * m_lineSize, 0.0f);
+    m_aux.assign(voices * m_lineSize, 0.0f);
+    m_block.fill(0.0f);
+
+    for (size_t i = 0; i < voices; ++i) {
+        m_voices[i].frequency = m_preset.lowestFrequency;
+        tuneVoice(i, 1.0f);
+    }
+}
+
+WindModel::~WindModel() = default;
+
+void WindModel::setBreath(float breath) {
+    m_breath = std::clamp(breath, 0.0f, 2.0f);
+}
+
+void WindModel::setVibrato(float depth, float rate) {
+    m_vibratoDepth = std::clamp(depth, 0.0f, 2.0f);
+    m_vibratoRate = std::clamp(rate, 0.0f, 20.0f);
+}
+
+void WindModel::setExpression(float expression) {
+    m_expressionTarget = std::clamp(expression, 0.0f, 1.0f);
+}
+
+void WindModel::noteOn(int note, float velocity) {
+    if (velocity <= 0.0f) {
+        noteOff(note);
+        return;
+    }
+
+    const float frequency = 440.0f * std::pow(2.0f, (note - 69) / 12.0f);
+
+    Voice* target = nullptr;
+    if (m_legato) {
+        // Gebundener Ton: nur die Griffweise (Rohrlänge) wechselt
+        for (auto& voice : m_voices) {
+            if (voice.active && !voice.released && (!target || voice.startOrder > target->startOrder)) {
+                target = &voice;
+            }
+        }
+    }
+    if (!target) {
+        target = allocateVoice(note);
+        target->velocity = std::min(velocity, 1.0f);
+    }
+
+    Voice& voice = *target;
+    voice.frequency = std::clamp(frequency, m_preset.lowestFrequency, static_cast<float>(m_sampleRate / 16.0));
+    voice.note = note;
+    voice.released = false;
+    voice.startOrder = ++m_startCounter;
+    voice.active = true;
+    tuneVoice(static_cast<size_t>(&voice - m_voices.data()), 1.0f);
+}
+
+void WindModel::noteOff(int note) {
+    for (auto& voice : m_voices) {
+        if (voice.active && voice.note == note) voice.released = true;
+    }
+}
+
+void WindModel::allNotesOff() {
+    for (auto& voice : m_voices) {
+        if (voice.active) voice.released = true;
+    }
+}
+
+int WindModel::getActiveVoices() const {
+    int count = 0;
+    for (const auto& voice : m_voices) {
+        if (voice.active) ++count;
+    }
+    return count;
+}
+
+WindModel::Voice* WindModel::allocateVoice(int note) {
+    // Klingende Note derselben Höhe wird neu angeblasen
+    for (auto& voice : m_voices) {
+        if (voice.active && voice.note == note) return &voice;
+    }
+
+    // Sonst frei, sonst die älteste
+    Voice* target = nullptr;
+    for (auto& voice : m_voices) {
+        if (!voice.active) {
+            target = &voice;
+            break;
+        }
+        if (!target || voice.startOrder < target->startOrder) target = &voice;
+    }
+
+    resetVoice(static_cast<size_t>(target - m_voices.data()));
+    return target;
+}
+
+void WindModel::resetVoice(size_t index) {
+    std::fill_n(m_bore.begin() + static_cast<std::ptrdiff_t>(index * m_lineSize), m_lineSize, 0.0f);
+    std::fill_n(m_aux.begin() + static_cast<std::ptrdiff_t>(index * m_lineSize), m_lineSize, 0.0f);
+    for (auto* lane : {&m_lanes.envelope, &m_lanes.level, &m_lanes.loss, &m_lanes.dcIn, &m_lanes.dcOut, &m_lanes.lipX1,
+                       &m_lanes.lipX2, &m_lanes.lipY1, &m_lanes.lipY2, &m_lanes.energy}) {
+        (*lane)[index] = 0.0f;
+    }
+}
+
+void WindModel::tuneVoice(size_t index, float vibrato) {
+    const double frequency = m_voices[index].frequency * vibrato;
+    const double w = 2.0 * kPi * frequency / m_sampleRate;
+    const double period = m_sampleRate / frequency;
+    const double maxDelay = static_cast<double>(m_lineSize - 2);
+
+    // Der Tonloch-Tiefpass verlängert die Schleife um seine Phasenlaufzeit
+    const double filterDelay = onePoleDelay(m_lossPole, w);
+    double bore = 0.0;
+    double aux = 1.0;
+
+    switch (m_preset.excitation) {
+    case Excitation::CylindricalReed:
+        // Invertierende Reflexion: eine Periode sind zwei Umläufe
+        bore = 0.5 * period - filterDelay;
+        break;
+    case Excitation::ConicalReed: {
+        const double loop = period - filterDelay;
+        const double split = std::clamp(m_preset.split, 0.05f, 0.5f);
+        aux = std::max(1.0, loop * split);
+        bore = loop - aux;
+        break;
+    }
+    case Excitation::Jet:
+        // Der Jet regt die zweite Resonanz eines um 3/2 längeren Rohrs an
+        bore = 1.5 * period - filterDelay + 1.0;
+        aux = std::max(1.0, bore * std::clamp(m_preset.split, 0.05f, 1.0f));
+        break;
+    case Excitation::Lip: {
+        bore = period - filterDelay;
+
+        // Lippen als Bandpass-Resonator mit konstanter Güte (Kraft -> Auslenkung)
+        const double lip = std::clamp(frequency * m_preset.lipTension, 20.0, m_sampleRate * 0.45);
+        const double r = std::exp(-kPi * lip / (kLipQuality * m_sampleRate));
+        m_lanes.lipA1[index] = static_cast<float>(-2.0 * r * std::cos(2.0 * kPi * lip / m_sampleRate));
+        m_lanes.lipA2[index] = static_cast<float>(r * r);
+        m_lanes.lipB0[index] = static_cast<float>(kLipGain * 0.5 * (1.0 - r * r));
+        break;
+    }
+    }
+
+    m_lanes.boreDelay[index] = static_cast<float>(std::clamp(bore, 2.0, maxDelay));
+    m_lanes.auxDelay[index] = static_cast<float>(std::clamp(aux, 1.0, maxDelay));
+}
+
+float WindModel::nextNoise() {
+    m_noiseState ^= m_noiseState << 13;
+    m_noiseState ^= m_noiseState >> 17;
+    m_noiseState ^= m_noiseState << 5;
+    return static_cast<float>(m_noiseState >> 8) / 8388608.0f - 1.0f;
+}
+
+void WindModel::renderGroup(size_t group, int numSamples) {
+    const size_t base = group * kLanes;
+    const size_t mask = m_lineMask;
+    const Excitation excitation = m_preset.excitation;
+
+    float* bore[kLanes];
+    float* aux[kLanes];
+    float boreDelay[kLanes];
+    float auxDelay[kLanes];
+    alignas(16) float target[kLanes];
+    alignas(16) float rate[kLanes];
+    alignas(16) float level[kLanes];
+
+    const float attack = 1.0f - std::exp(-1.0f / (std::max(m_preset.attack, 0.001f) * static_cast<float>(m_sampleRate)));
+    const float release = 1.0f - std::exp(-1.0f / (std::max(m_preset.release, 0.001f) * static_cast<float>(m_sampleRate)));
+    const float dynamics = std::clamp(m_preset.dynamics, 0.0f, 1.0f);
+    for (int lane = 0; lane < kLanes; ++lane) {
+        const Voice& voice = m_voices[base + lane];
+        bore[lane] = m_bore.data() + (base + lane) * m_lineSize;
+        aux[lane] = m_aux.data() + (base + lane) * m_lineSize;
+        boreDelay[lane] = m_lanes.boreDelay[base + lane];
+        auxDelay[lane] = m_lanes.auxDelay[base + lane];
+        // Velocity mal Atem (Breath Controller) bestimmt Pegel und Blasdruck.
+        // Der Druck bleibt im schmalen Bereich, in dem das Rohrblatt bzw. der
+        // Jet schwingt; erst bei kaum noch Atem bricht der Ton ab.
+        const float blow = std::min(voice.velocity * m_breath, 1.2f);
+        const bool blowing = voice.active && !voice.released && blow > 0.0f;
+        const float gate = std::min(1.0f, blow * 8.0f);
+        target[lane] = blowing ? m_preset.pressure * (1.0f - dynamics + dynamics * blow) * gate : 0.0f;
+        rate[lane] = blowing ? attack : release;
+        level[lane] = voice.released ? m_lanes.level[base + lane] : blow;
+    }
+
+    const Float4 targetV = Float4::load(target);
+    const Float4 rateV = Float4::load(rate);
+    const Float4 levelV = Float4::load(level);
+    const Float4 levelRate = Float4::set1(1.0f - std::exp(-1.0f / (0.01f * static_cast<float>(m_sampleRate))));
+    const Float4 lossCoeff = Float4::set1(1.0f - m_lossPole);
+    const Float4 reflection = Float4::set1(m_preset.reflection);
+    const Float4 noiseLevel = Float4::set1(m_preset.noise);
+    const Float4 reedOffset = Float4::set1(m_preset.reedOffset);
+    const Float4 reedSlope = Float4::set1(m_preset.reedSlope);
+    const Float4 one = Float4::set1(1.0f);
+    const Float4 half = Float4::set1(0.5f);
+    const Float4 restOpening = Float4::set1(2.0f);
+    const Float4 dcPole = Float4::set1(0.9995f);
+    const Float4 lipB0 = Float4::load(&m_lanes.lipB0[base]);
+    const Float4 lipA1 = Float4::load(&m_lanes.lipA1[base]);
+    const Float4 lipA2 = Float4::load(&m_lanes.lipA2[base]);
+
+    Float4 envelope = Float4::load(&m_lanes.envelope[base]);
+    Float4 gain = Float4::load(&m_lanes.level[base]);
+    Float4 loss = Float4::load(&m_lanes.loss[base]);
+    Float4 dcIn = Float4::load(&m_lanes.dcIn[base]);
+    Float4 dcOut = Float4::load(&m_lanes.dcOut[base]);
+    Float4 lipX1 = Float4::load(&m_lanes.lipX1[base]);
+    Float4 lipX2 = Float4::load(&m_lanes.lipX2[base]);
+    Float4 lipY1 = Float4::load(&m_lanes.lipY1[base]);
+    Float4 lipY2 = Float4::load(&m_lanes.lipY2[base]);
+    Float4 energy = Float4::zero();
+
+    alignas(16) float tap[kLanes];
+    alignas(16) float auxTap[kLanes];
+    alignas(16) float noise[kLanes];
+    alignas(16) float boreIn[kLanes];
+    alignas(16) float auxIn[kLanes];
+
+    for (int i = 0; i < numSamples; ++i) {
+        const size_t write = m_write + static_cast<size_t>(i);
+        for (int lane = 0; lane < kLanes; ++lane) {
+            tap[lane] = readLine(bore[lane], write, boreDelay[lane], mask);
+            auxTap[lane] = readLine(aux[lane], write, auxDelay[lane], mask);
+            noise[lane] = nextNoise();
+        }
+
+        const Float4 boreOut = Float4::load(tap);
+        envelope += (targetV - envelope) * rateV;
+        const Float4 breath = envelope * (one + noiseLevel * Float4::load(noise));
+        loss += (boreOut - loss) * lossCoeff;
+
+        Float4 output = boreOut;
+        switch (excitation) {
+        case Excitation::CylindricalReed: {
+            // Rohrblatt als Ventil: die Druckdifferenz öffnet bzw. schließt es
+            const Float4 difference = Float4::zero() - reflection * loss - breath;
+            const Float4 reed = clamp1(reedOffset + reedSlope * difference);
+            (breath + difference * reed).store(boreIn);
+            break;
+        }
+        case Excitation::ConicalReed: {
+            const Float4 bell = Float4::zero() - reflection * loss;
+            const Float4 mouthpiece = bell - Float4::load(auxTap);
+            const Float4 difference = mouthpiece - breath;
+            const Float4 reed = clamp1(reedOffset + reedSlope * difference);
+            (breath + difference * reed - bell).store(boreIn);
+            bell.store(auxIn);
+            output = mouthpiece;
+            break;
+        }
+        case Excitation::Jet: {
+            // Reflexion am offenen Ende, Gleichanteil blockieren
+            const Float4 end = Float4::zero() - reflection * loss;
+            dcOut = end - dcIn + dcPole * dcOut;
+            dcIn = end;
+            (breath - half * dcOut).store(auxIn);
+            const Float4 jet = Float4::load(auxTap);
+            (clamp1(jet * (jet * jet - one)) + half * dcOut).store(boreIn);
+            break;
+        }
+        case Excitation::Lip: {
+            const Float4 mouth = Float4::set1(0.3f) * breath;
+            const Float4 returning = reflection * loss;
+            const Float4 difference = mouth - returning;
+            const Float4 lip = lipB0 * (difference - lipX2) - lipA1 * lipY1 - lipA2 * lipY2;
+            lipX2 = lipX1;
+            lipX1 = difference;
+            lipY2 = lipY1;
+            lipY1 = lip;
+            // Ruheöffnung folgt dem Mundruck, die Resonanz moduliert sie;
+            // Öffnungsfläche ~ Auslenkung², begrenzt auf ganz offen
+            const Float4 displacement = max(restOpening * mouth - lip, Float4::zero());
+            const Float4 opening = min(displacement * displacement, one);
+            const Float4 flow = opening * mouth + (one - opening) * returning;
+            dcOut = flow - dcIn + dcPole * dcOut;
+            dcIn = flow;
+            dcOut.store(boreIn);
+            break;
+        }
+        }
+
+        for (int lane = 0; lane < kLanes; ++lane) {
+            bore[lane][write & mask] = boreIn[lane];
+        }
+        if (excitation == Excitation::ConicalReed || excitation == Excitation::Jet) {
+            for (int lane = 0; lane < kLanes; ++lane) {
+                aux[lane][write & mask] = auxIn[lane];
+            }
+        }
+
+        gain += (levelV - gain) * levelRate;
+        energy += output * output;
+        m_block[i] += (output * gain).sum();
+    }
+
+    envelope.store(&m_lanes.envelope[base]);
+    gain.store(&m_lanes.level[base]);
+    loss.store(&m_lanes.loss[base]);
+    dcIn.store(&m_lanes.dcIn[base]);
+    dcOut.store(&m_lanes.dcOut[base]);
+    lipX1.store(&m_lanes.lipX1[base]);
+    lipX2.store(&m_lanes.lipX2[base]);
+    lipY1.store(&m_lanes.lipY1[base]);
+    lipY2.store(&m_lanes.lipY2[base]);
+    energy.store(&m_lanes.energy[base]);
+}
+
+void WindModel::process(float* out, int numSamples) {
+    const size_t groups = m_voices.size() / kLanes;
+
+    for (int offset = 0; offset < numSamples; offset += kBlockSize) {
+        const int count = std::min(kBlockSize, numSamples - offset);
+        std::fill(m_block.begin(), m_block.begin() + count, 0.0f);
+
+        // Vibrato einmal pro Block
+        const float vibrato = std::pow(2.0f, m_vibratoDepth * static_cast<float>(std::sin(m_vibratoPhase)) / 12.0f);
+        m_vibratoPhase += 2.0 * kPi * m_vibratoRate * count / m_sampleRate;
+        if (m_vibratoPhase > 2.0 * kPi) m_vibratoPhase -= 2.0 * kPi;
+        // Nach dem Abschalten einmal mit vibrato = 1 zurück auf die Note
+        const bool retune = m_vibratoDepth > 0.0f || m_vibratoApplied;
+        m_vibratoApplied = m_vibratoDepth > 0.0f;
+
+        for (size_t group = 0; group < groups; ++group) {
+            const size_t base = group * kLanes;
+            bool sounding = false;
+            for (int lane = 0; lane < kLanes; ++lane) {
+                if (!m_voices[base + lane].active) continue;
+                sounding = true;
+                if (retune) tuneVoice(base + lane, vibrato);
+            }
+            if (!sounding) continue;
+
+            renderGroup(group, count);
+
+            // Ausgeklungene Stimmen freigeben
+            for (int lane = 0; lane < kLanes; ++lane) {
+                Voice& voice = m_voices[base + lane];
+                if (voice.active && voice.released && m_lanes.envelope[base + lane] < 1e-4f &&
+                    m_lanes.energy[base + lane] < 1e-10f * static_cast<float>(count)) {
+                    voice.active = false;
+                }
+            }
+        }
+        m_write += static_cast<size_t>(count);
+
+        // Expression als Rampe über den Block
+        const float start = m_expression;
+        const float step = (m_expressionTarget - start) / static_cast<float>(count);
+        const float gain = m_gain * m_preset.gain;
+        for (int i = 0; i < count; ++i) {
+            out[offset + i] += gain * (start + step * static_cast<float>(i + 1)) * m_block[i];
+        }
+        m_expression = m_expressionTarget;
+    }
+}
+
+} // namespace VRMusicStudio
@@ -1,5 +1,8 @@
 #include "DJMixCompatibility.hpp"
+#include "audio/processing/TempoKeyDetector.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <map>
 
 namespace VRMusicStudio {
 
@@ -7,6 +10,8 @@ struct DJMixCompatibility::Impl {
     DJMixConfig currentConfig;
     std::vector<DJMixConfig> availableDJMixes;
     DJMixChangeCallback djMixChangeCallback;
+    std::map<std::string, std::shared_ptr<TrackAnalysisSlot>> trackAnalyses;
+    TempoKeyDetector::Settings analysisSettings;
     
     Impl() {
         // Initialisiere verfügbare DJ-Mix-Programme
@@ -50,6 +55,40 @@ bool DJMixCompatibility::isDJMixAvailable(const std::string& djMixName) const {
         [&djMixName](const DJMixConfig& config) { return config.name == djMixName; }) != pImpl->availableDJMixes.end();
 }
 
+void DJMixCompatibility::analyzeTracks(const std::vector<std::string>& paths) {
+    // Dekodierung und Analyse laufen im Worker-Pool, bereits analysierte
+    // Dateien kommen aus dem Cache
+    for (const auto& path : paths) {
+        auto& slot = pImpl->trackAnalyses[path];
+        if (!slot) {
+            slot = std::make_shared<TrackAnalysisSlot>();
+        }
+        TempoKeyAnalyzer::getInstance().request(slot, path, nullptr, 0, 0.0, pImpl->analysisSettings);
+    }
+    spdlog::info("Tempo-/Tonart-Analyse für {} Tracks gestartet", paths.size());
+}
+
+void DJMixCompatibility::waitForAnalysis() {
+    TempoKeyAnalyzer::getInstance().waitUntilIdle();
+}
+
+std::shared_ptr<const TrackAnalysis> DJMixCompatibility::getTrackAnalysis(const std::string& path) const {
+    auto it = pImpl->trackAnalyses.find(path);
+    if (it == pImpl->trackAnalyses.end()) return nullptr;
+    return it->second->load();
+}
+
+bool DJMixCompatibility::areTracksHarmonicallyCompatible(const std::string& pathA, const std::string& pathB) const {
+    auto a = getTrackAnalysis(pathA);
+    auto b = getTrackAnalysis(pathB);
+    return a && b && TempoKeyDetector::areKeysCompatible(*a, *b);
+}
+
+double DJMixCompatibility::getTempoRatio(const std::string& path, double targetBpm) const {
+    auto analysis = getTrackAnalysis(path);
+    return analysis ? TempoKeyDetector::tempoRatio(*analysis, targetBpm) : 1.0;
+}
+
 void DJMixCompatibility::setDJMixChangeCallback(DJMixChangeCallback callback) {
     pImpl->djMixChangeCallback = callback;
 }
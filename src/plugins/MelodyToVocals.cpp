@@ -1,4 +1,5 @@
 #include "MelodyToVocals.hpp"
+#include "audio/processing/PitchTracker.hpp"
 #include <spdlog/spdlog.h>
 #include <algorithm>
 #include <cmath>
@@ -23,9 +24,14 @@ struct MelodyToVocals::Impl {
     torch::jit::script::Module emotionModel;
     torch::jit::script::Module articulationModel;
 
+    // Tonhöhenerkennung des Eingangs (ersetzt die Modell-Schätzung)
+    PitchTracker pitchTracker;
+    std::vector<PitchTracker::Estimate> pitchEstimates;
+
     // Zustandsvariablen
     bool isInitialized;
     float currentPitch;
+    float currentPitchConfidence;
     float currentFormant;
     float currentBreath;
     float currentVibrato;
@@ -37,7 +43,7 @@ struct MelodyToVocals::Impl {
     std::vector<float> formantBuffer;
     std::vector<float> emotionBuffer;
 
-    Impl() : isInitialized(false), currentPitch(0.0f), currentFormant(0.0f),
+    Impl() : isInitialized(false), currentPitch(0.0f), currentPitchConfidence(0.0f), currentFormant(0.0f),
              currentBreath(0.0f), currentVibrato(0.0f), currentResonance(0.0f) {
         // Initialisiere Parameter
         params = {
@@ -78,6 +84,15 @@ void MelodyToVocals::prepareToPlay(double sampleRate, int samplesPerBlock) {
     pImpl->formantBuffer.resize(samplesPerBlock * 2);
     pImpl->emotionBuffer.resize(samplesPerBlock * 2);
 
+    // Stimmumfang: 70 Hz - 1.2 kHz, eine Schätzung alle 5 ms
+    PitchTracker::Settings pitchSettings;
+    pitchSettings.minFrequency = 70.0f;
+    pitchSettings.maxFrequency = 1200.0f;
+    pImpl->pitchTracker.prepare(sampleRate, pitchSettings);
+    pImpl->pitchEstimates.resize(samplesPerBlock / pImpl->pitchTracker.getHopSize() + 1);
+    pImpl->currentPitch = 0.0f;
+    pImpl->currentPitchConfidence = 0.0f;
+
     pImpl->isInitialized = true;
 }
 
@@ -99,6 +114,15 @@ void MelodyToVocals::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBu
                  pImpl->inputBuffer.begin() + channel * buffer.getNumSamples());
     }
 
+    // Tonhöhe des (linken) Eingangs verfolgen
+    if (buffer.getNumChannels() > 0) {
+        pImpl->pitchTracker.process(buffer.getReadPointer(0), buffer.getNumSamples(),
+                                    pImpl->pitchEstimates.data(), pImpl->pitchEstimates.size());
+        const auto& estimate = pImpl->pitchTracker.getLatest();
+        pImpl->currentPitch = estimate.frequency;
+        pImpl->currentPitchConfidence = estimate.confidence;
+    }
+
     // Verarbeite Vokalisierung
     processVocalization(buffer);
 
@@ -277,4 +301,12 @@ void MelodyToVocals::setStateInformation(const void* data, int sizeInBytes) {
     }
 }
 
-} // namespace VRMusicStudio 
\ No newline at end of file
+float MelodyToVocals::getInputPitch() const {
+    return pImpl->currentPitch;
+}
+
+float MelodyToVocals::getInputPitchConfidence() const {
+    return pImpl->currentPitchConfidence;
+}
+
+} // namespace VRMusicStudio
@@ -10,6 +10,7 @@ BeatSlicerEffect::BeatSlicerEffect()
     , sliceOffset(0.0f)
     , sliceRandom(0.0f)
     , sliceReverse(0.0f)
+    , snap(0.5f)
     , mix(0.5f)
     , quality(1.0f)
     , automatedSliceSize(false)
@@ -17,9 +18,20 @@ BeatSlicerEffect::BeatSlicerEffect()
     , automatedSliceOffset(false)
     , automatedSliceRandom(false)
     , automatedSliceReverse(false)
+    , automatedSnap(false)
     , automatedMix(false)
     , automatedQuality(false)
+    , slice{0, 0, 0, false}
+    , written(0)
+    , barStart(0)
+    , currentStep(0)
+    , stepCount(0)
+    , sliceLength(0)
     , bufferSize(44100 * 2) // 2 Sekunden bei 44.1kHz
+    , currentMethod(VRMusicStudio::OnsetDetector::Method::ComplexDomain)
+    , detectorOrigin(0)
+    , onsets{}
+    , onsetCount(0)
 {
     std::random_device rd;
     rng.seed(rd());
@@ -36,135 +48,158 @@ bool BeatSlicerEffect::initialize() {
 }
 
 void BeatSlicerEffect::shutdown() {
-    slices.clear();
+    history.clear();
 }
 
 void BeatSlicerEffect::initializeSlices() {
-    slices.clear();
-    
-    // Erstelle initiale Slices
-    int numSlices = static_cast<int>(sliceCount);
-    for (int i = 0; i < numSlices; ++i) {
-        Slice slice;
-        slice.buffer.resize(bufferSize, 0.0f);
-        slice.startPos = 0;
-        slice.endPos = bufferSize;
-        slice.currentPos = 0;
-        slice.level = 1.0f;
-        slice.reverse = false;
-        slice.active = true;
-        slices.push_back(slice);
+    // Verlauf: Platz für den eingefrorenen Takt plus den parallel laufenden nächsten
+    history.assign(bufferSize * 4, 0.0f);
+    written = 0;
+    barStart = 0;
+    onsetCount = 0;
+    slice = {0, 0, 0, false};
+
+    // Nächster Sample startet einen neuen Zyklus
+    stepCount = getStepCount();
+    currentStep = stepCount;
+
+    // Alle Verfahren vorab vorbereiten; der Audio-Thread wählt nur noch aus
+    for (int i = 0; i < kMethodCount; ++i) {
+        VRMusicStudio::OnsetDetector::Settings settings;
+        settings.method = static_cast<VRMusicStudio::OnsetDetector::Method>(i);
+        onsetDetectors[i].prepare(kSampleRate, settings);
     }
+    currentMethod = getDetectionMethod();
+    detectorOrigin = 0;
 }
 
 void BeatSlicerEffect::updateSlices() {
-    // Aktualisiere Slice-Positionen wenn sich Parameter ändern
-    if (sliceSize != currentSliceSize || 
-        sliceCount != currentSliceCount || 
-        sliceOffset != currentSliceOffset) {
-        
-        updateSlicePositions();
-        currentSliceSize = sliceSize;
-        currentSliceCount = sliceCount;
-        currentSliceOffset = sliceOffset;
+    // Läuft am Blockanfang im Audio-Thread: ein anderes Erkennungsverfahren
+    // übernimmt ab hier, seine Positionen zählen ab dem aktuellen Verlaufsstand
+    const auto method = getDetectionMethod();
+    if (method != currentMethod) {
+        currentMethod = method;
+        onsetDetectors[static_cast<int>(method)].reset();
+        detectorOrigin = written;
     }
-    
-    // Wende Randomisierung an
-    if (sliceRandom != currentSliceRandom) {
-        applySliceRandomization();
-        currentSliceRandom = sliceRandom;
-    }
-    
-    // Wende Reversierung an
-    if (sliceReverse != currentSliceReverse) {
-        applySliceReversal();
-        currentSliceReverse = sliceReverse;
+    // Slice-Länge und -Anzahl werden zum nächsten Zyklus übernommen
+}
+
+int BeatSlicerEffect::getStepCount() const {
+    const unsigned long length = static_cast<unsigned long>(bufferSize * std::clamp(sliceSize, 0.1f, 1.0f));
+    int count = std::clamp(static_cast<int>(sliceCount), 1, 16);
+
+    // Der eingefrorene Takt muss bis zum Zyklusende im Verlauf bleiben
+    while (count > 1 && (2 * static_cast<size_t>(count) + 1) * length > bufferSize * 4) {
+        --count;
     }
+    return count;
+}
+
+VRMusicStudio::OnsetDetector::Method BeatSlicerEffect::getDetectionMethod() const {
+    using Method = VRMusicStudio::OnsetDetector::Method;
+    const float value = quality.load(std::memory_order_relaxed);
+    if (value < 0.34f) return Method::HighFrequencyContent;
+    if (value < 0.67f) return Method::SpectralFlux;
+    return Method::ComplexDomain;
 }
 
-void BeatSlicerEffect::updateSlicePositions() {
-    int numSlices = static_cast<int>(sliceCount);
-    size_t sliceLength = static_cast<size_t>(bufferSize * sliceSize);
-    
-    for (int i = 0; i < numSlices; ++i) {
-        if (i < slices.size()) {
-            Slice& slice = slices[i];
-            slice.startPos = i * sliceLength;
-            slice.endPos = slice.startPos + sliceLength;
-            slice.currentPos = slice.startPos;
-            
-            // Wende Offset an
-            if (sliceOffset != 0.0f) {
-                size_t offset = static_cast<size_t>(sliceLength * sliceOffset);
-                slice.startPos = (slice.startPos + offset) % bufferSize;
-                slice.endPos = (slice.endPos + offset) % bufferSize;
-            }
+void BeatSlicerEffect::detectOnsets(const float* buffer, unsigned long framesPerBuffer) {
+    auto& detector = onsetDetectors[static_cast<int>(currentMethod)];
+    uint64_t found[kMaxOnsetsPerBlock];
+    const unsigned long chunk = 1024;
+    for (unsigned long offset = 0; offset < framesPerBuffer; offset += chunk) {
+        const unsigned long frames = std::min(chunk, framesPerBuffer - offset);
+        const size_t count = detector.process(buffer + offset, frames, found, kMaxOnsetsPerBlock);
+        for (size_t i = 0; i < count; ++i) {
+            onsets[onsetCount % kMaxOnsets] = detectorOrigin + found[i];
+            ++onsetCount;
         }
     }
 }
 
-void BeatSlicerEffect::applySliceRandomization() {
-    if (sliceRandom == 0.0f) return;
-    
-    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-    
-    for (auto& slice : slices) {
-        if (dist(rng) < sliceRandom) {
-            // Zufällige Position innerhalb des Buffers
-            slice.startPos = static_cast<size_t>(dist(rng) * bufferSize);
-            slice.endPos = (slice.startPos + static_cast<size_t>(bufferSize * sliceSize)) % bufferSize;
-            slice.currentPos = slice.startPos;
+unsigned long long BeatSlicerEffect::snapToOnset(unsigned long long position, unsigned long maxDistance) const {
+    unsigned long long best = position;
+    unsigned long long bestDistance = static_cast<unsigned long long>(maxDistance) + 1;
+    const size_t valid = std::min(onsetCount, kMaxOnsets);
+
+    for (size_t i = 0; i < valid; ++i) {
+        const unsigned long long onset = onsets[i];
+        // Onsets, die schon aus dem Verlauf gefallen sind, überspringen
+        if (onset + history.size() <= written) continue;
+        const unsigned long long distance = onset > position ? onset - position : position - onset;
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            best = onset;
         }
     }
+    return best;
 }
 
-void BeatSlicerEffect::applySliceReversal() {
-    for (auto& slice : slices) {
-        slice.reverse = (sliceReverse > 0.5f);
+void BeatSlicerEffect::startNextSlice() {
+    if (currentStep >= stepCount) {
+        // Neuer Zyklus: den zuletzt aufgenommenen Takt einfrieren
+        stepCount = getStepCount();
+        sliceLength = static_cast<unsigned long>(bufferSize * std::clamp(sliceSize, 0.1f, 1.0f));
+        const unsigned long long barLength = static_cast<unsigned long long>(stepCount) * sliceLength;
+        barStart = written > barLength ? written - barLength : 0;
+        currentStep = 0;
     }
+
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    int source = (currentStep + static_cast<int>(sliceOffset * stepCount)) % stepCount;
+    if (dist(rng) < sliceRandom) {
+        source = std::uniform_int_distribution<int>(0, stepCount - 1)(rng);
+    }
+
+    const unsigned long long gridPosition = barStart + static_cast<unsigned long long>(source) * sliceLength;
+    const unsigned long maxDistance = static_cast<unsigned long>(std::clamp(snap, 0.0f, 1.0f) * sliceLength * 0.5f);
+
+    slice.start = snapToOnset(gridPosition, maxDistance);
+    slice.length = sliceLength;
+    slice.currentPos = 0;
+    slice.reverse = dist(rng) < sliceReverse;
+    ++currentStep;
 }
 
-void BeatSlicerEffect::processSlice(Slice& slice, float* buffer, unsigned long framesPerBuffer) {
-    if (!slice.active) return;
-    
-    for (unsigned long i = 0; i < framesPerBuffer; ++i) {
-        if (slice.currentPos >= slice.endPos) {
-            slice.currentPos = slice.startPos;
-        }
-        
-        // Lese Sample aus Buffer
-        float sample = slice.buffer[slice.currentPos];
-        
-        // Wende Level an
-        sample *= slice.level;
-        
-        // Schreibe in Output Buffer
-        buffer[i] = sample;
-        
-        // Aktualisiere Position
-        if (slice.reverse) {
-            if (slice.currentPos == slice.startPos) {
-                slice.currentPos = slice.endPos - 1;
-            } else {
-                slice.currentPos--;
-            }
-        } else {
-            slice.currentPos++;
-        }
+float BeatSlicerEffect::processSlice() {
+    if (slice.currentPos >= slice.length) {
+        startNextSlice();
+    }
+
+    const unsigned long offset = slice.reverse ? slice.length - 1 - slice.currentPos : slice.currentPos;
+    const unsigned long long position = slice.start + offset;
+
+    float sample = 0.0f;
+    // Nur bereits geschriebene und noch vorhandene Samples lesen
+    if (position < written && position + history.size() >= written) {
+        sample = history[position % history.size()];
     }
+
+    // Kurze Blenden an den Slice-Grenzen gegen Klicks
+    const unsigned long remaining = slice.length - slice.currentPos;
+    const unsigned long edge = std::min(slice.currentPos + 1, remaining);
+    if (edge < kFadeSamples) {
+        sample *= static_cast<float>(edge) / static_cast<float>(kFadeSamples);
+    }
+
+    ++slice.currentPos;
+    return sample;
 }
 
 void BeatSlicerEffect::processAudio(float* buffer, unsigned long framesPerBuffer) {
+    if (history.empty()) return;
     updateSlices();
-    
-    // Verarbeite jeden Slice
-    for (auto& slice : slices) {
-        processSlice(slice, buffer, framesPerBuffer);
-    }
-    
-    // Wende Mix an
+    detectOnsets(buffer, framesPerBuffer);
+
     for (unsigned long i = 0; i < framesPerBuffer; ++i) {
-        buffer[i] = buffer[i] * mix;
+        const float dry = buffer[i];
+        history[written % history.size()] = dry;
+        ++written;
+
+        const float wet = processSlice();
+        buffer[i] = dry * (1.0f - mix) + wet * mix;
     }
 }
 
@@ -175,8 +210,9 @@ std::vector<PluginParameter> BeatSlicerEffect::getParameters() const {
         {"sliceOffset", sliceOffset, 0.0f, 1.0f, ""},
         {"sliceRandom", sliceRandom, 0.0f, 1.0f, ""},
         {"sliceReverse", sliceReverse, 0.0f, 1.0f, ""},
+        {"snap", snap, 0.0f, 1.0f, ""},
         {"mix", mix, 0.0f, 1.0f, ""},
-        {"quality", quality, 0.0f, 1.0f, ""}
+        {"quality", quality.load(), 0.0f, 1.0f, ""}
     };
 }
 
@@ -186,8 +222,10 @@ void BeatSlicerEffect::setParameter(const std::string& name, float value) {
     else if (name == "sliceOffset") sliceOffset = value;
     else if (name == "sliceRandom") sliceRandom = value;
     else if (name == "sliceReverse") sliceReverse = value;
+    else if (name == "snap") snap = value;
     else if (name == "mix") mix = value;
     else if (name == "quality") quality = value;
+    // Übernahme am nächsten Blockanfang in processAudio()
 }
 
 float BeatSlicerEffect::getParameter(const std::string& name) const {
@@ -196,8 +234,9 @@ float BeatSlicerEffect::getParameter(const std::string& name) const {
     if (name == "sliceOffset") return sliceOffset;
     if (name == "sliceRandom") return sliceRandom;
     if (name == "sliceReverse") return sliceReverse;
+    if (name == "snap") return snap;
     if (name == "mix") return mix;
-    if (name == "quality") return quality;
+    if (name == "quality") return quality.load();
     return 0.0f;
 }
 
@@ -207,6 +246,7 @@ void BeatSlicerEffect::setParameterAutomated(const std::string& name, bool autom
     else if (name == "sliceOffset") automatedSliceOffset = automated;
     else if (name == "sliceRandom") automatedSliceRandom = automated;
     else if (name == "sliceReverse") automatedSliceReverse = automated;
+    else if (name == "snap") automatedSnap = automated;
     else if (name == "mix") automatedMix = automated;
     else if (name == "quality") automatedQuality = automated;
 }
@@ -217,6 +257,7 @@ bool BeatSlicerEffect::isParameterAutomated(const std::string& name) const {
     if (name == "sliceOffset") return automatedSliceOffset;
     if (name == "sliceRandom") return automatedSliceRandom;
     if (name == "sliceReverse") return automatedSliceReverse;
+    if (name == "snap") return automatedSnap;
     if (name == "mix") return automatedMix;
     if (name == "quality") return automatedQuality;
     return false;
@@ -229,6 +270,7 @@ void BeatSlicerEffect::loadPreset(const std::string& presetName) {
         sliceOffset = 0.0f;
         sliceRandom = 0.0f;
         sliceReverse = 0.0f;
+        snap = 0.5f;
         mix = 0.5f;
         quality = 1.0f;
     }
@@ -238,6 +280,7 @@ void BeatSlicerEffect::loadPreset(const std::string& presetName) {
         sliceOffset = 0.25f;
         sliceRandom = 0.5f;
         sliceReverse = 0.3f;
+        snap = 0.75f;
         mix = 0.7f;
         quality = 1.0f;
     }
@@ -247,11 +290,11 @@ void BeatSlicerEffect::loadPreset(const std::string& presetName) {
         sliceOffset = 0.1f;
         sliceRandom = 0.2f;
         sliceReverse = 0.0f;
+        snap = 0.3f;
         mix = 0.3f;
         quality = 1.0f;
     }
-    
-    updateSlices();
+    // Übernahme am nächsten Blockanfang in processAudio()
 }
 
 void BeatSlicerEffect::savePreset(const std::string& presetName) {
@@ -183,6 +183,12 @@ void DelayEffect::processAudio(float* buffer, unsigned long framesPerBuffer) {
     }
 }
 
+double DelayEffect::getTailSeconds() const {
+    // Jede Wiederholung wird um feedback leiser
+    const double delaySeconds = syncRate > 0.0f ? calculateSyncTime() / 44100.0 : time;
+    return VRMusicStudio::feedbackTailSeconds(delaySeconds, feedback);
+}
+
 float DelayEffect::processFilter(float input, int channel) {
     // Low-Cut Filter
     float output = a0 * input + a1 * x1[channel] + a2 * x2[channel]
@@ -205,7 +211,7 @@ float DelayEffect::processFilter(float input, int channel) {
     return filtered;
 }
 
-float DelayEffect::calculateSyncTime() {
+float DelayEffect::calculateSyncTime() const {
     // Sync-Zeit basierend auf BPM berechnen (angenommen 120 BPM)
     return (60.0f / 120.0f) * syncRate * 44100.0f;
 }
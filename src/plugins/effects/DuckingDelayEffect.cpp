@@ -13,6 +13,8 @@ DuckingDelayEffect::DuckingDelayEffect()
     , attack(10.0f)
     , release(100.0f)
     , quality(1.0f)
+    , keyHighpass(VRMusicStudio::SidechainFilter::kMinHighpass)
+    , keyLowpass(VRMusicStudio::SidechainFilter::kMaxLowpass)
     , automatedTime(false)
     , automatedFeedback(false)
     , automatedMix(false)
@@ -21,7 +23,11 @@ DuckingDelayEffect::DuckingDelayEffect()
     , automatedAttack(false)
     , automatedRelease(false)
     , automatedQuality(false)
+    , automatedKeyHighpass(false)
+    , automatedKeyLowpass(false)
     , bufferSize(0)
+    , keyInput(nullptr)
+    , keyFrames(0)
 {
     initializeDelayLines();
 }
@@ -57,6 +63,10 @@ void DuckingDelayEffect::initializeDelayLines() {
     rightDelay.level = 1.0f;
     leftDelay.envelope = 0.0f;
     rightDelay.envelope = 0.0f;
+    leftDelay.keyFilter.prepare(44100.0);
+    rightDelay.keyFilter.prepare(44100.0);
+    leftDelay.keyFilter.setFrequencies(keyHighpass, keyLowpass);
+    rightDelay.keyFilter.setFrequencies(keyHighpass, keyLowpass);
     
     // Berechne Hüllkurven-Koeffizienten
     updateEnvelopeCoefficients();
@@ -89,15 +99,15 @@ void DuckingDelayEffect::updateDelayTimes() {
     rightDelay.readPos = (rightDelay.writePos + bufferSize - delaySamples) % bufferSize;
 }
 
-void DuckingDelayEffect::updateEnvelope(DelayLine& delay, float input) {
-    // Berechne Eingangspegel
-    float inputLevel = std::abs(input);
+void DuckingDelayEffect::updateEnvelope(DelayLine& delay, float key) {
+    // Berechne Key-Pegel nach HPF/LPF
+    float keyLevel = std::abs(delay.keyFilter.process(key));
     
     // Update Hüllkurve
-    if (inputLevel > delay.envelope) {
-        delay.envelope = inputLevel + (delay.envelope - inputLevel) * delay.attackCoeff;
+    if (keyLevel > delay.envelope) {
+        delay.envelope = keyLevel + (delay.envelope - keyLevel) * delay.attackCoeff;
     } else {
-        delay.envelope = inputLevel + (delay.envelope - inputLevel) * delay.releaseCoeff;
+        delay.envelope = keyLevel + (delay.envelope - keyLevel) * delay.releaseCoeff;
     }
 }
 
@@ -114,9 +124,9 @@ float DuckingDelayEffect::calculateGain(float envelope) {
     return 1.0f;
 }
 
-float DuckingDelayEffect::processDelayLine(DelayLine& delay, float input) {
+float DuckingDelayEffect::processDelayLine(DelayLine& delay, float input, float key) {
     // Update Hüllkurve
-    updateEnvelope(delay, input);
+    updateEnvelope(delay, key);
     
     // Berechne Verstärkung
     float gain = calculateGain(delay.envelope);
@@ -133,22 +143,32 @@ float DuckingDelayEffect::processDelayLine(DelayLine& delay, float input) {
     return output * gain;
 }
 
+void DuckingDelayEffect::setSidechainInput(const float* key, unsigned long framesPerBuffer) {
+    keyInput = key;
+    keyFrames = framesPerBuffer;
+}
+
 void DuckingDelayEffect::processAudio(float* buffer, unsigned long framesPerBuffer) {
+    // Ohne (vollständigen) externen Key duckt das trockene Eingangssignal
+    const float* key = (keyInput && keyFrames >= framesPerBuffer) ? keyInput : buffer;
+    leftDelay.keyFilter.setFrequencies(keyHighpass, keyLowpass);
+    rightDelay.keyFilter.setFrequencies(keyHighpass, keyLowpass);
+
     for (unsigned long i = 0; i < framesPerBuffer * 2; i += 2) {
         float leftInput = buffer[i];
         float rightInput = buffer[i + 1];
         
         // Verarbeite Verzögerung
-        float leftDelay = processDelayLine(leftDelay, leftInput);
-        float rightDelay = processDelayLine(rightDelay, rightInput);
+        float leftWet = processDelayLine(leftDelay, leftInput, key[i]);
+        float rightWet = processDelayLine(rightDelay, rightInput, key[i + 1]);
         
         // Feedback
-        leftDelay *= feedback;
-        rightDelay *= feedback;
+        leftWet *= feedback;
+        rightWet *= feedback;
         
         // Mix
-        buffer[i] = leftInput + leftDelay * mix;
-        buffer[i + 1] = rightInput + rightDelay * mix;
+        buffer[i] = leftInput + leftWet * mix;
+        buffer[i + 1] = rightInput + rightWet * mix;
     }
 }
 
@@ -161,7 +181,9 @@ std::vector<PluginParameter> DuckingDelayEffect::getParameters() const {
         {"ratio", ratio, 1.0f, 20.0f, ""},
         {"attack", attack, 0.1f, 100.0f, "ms"},
         {"release", release, 10.0f, 1000.0f, "ms"},
-        {"quality", quality, 0.0f, 1.0f, ""}
+        {"quality", quality, 0.0f, 1.0f, ""},
+        {"keyHighpass", keyHighpass, 20.0f, 2000.0f, "Hz"},
+        {"keyLowpass", keyLowpass, 200.0f, 20000.0f, "Hz"}
     };
 }
 
@@ -183,6 +205,8 @@ void DuckingDelayEffect::setParameter(const std::string& name, float value) {
         updateEnvelopeCoefficients();
     }
     else if (name == "quality") quality = value;
+    else if (name == "keyHighpass") keyHighpass = value;
+    else if (name == "keyLowpass") keyLowpass = value;
 }
 
 float DuckingDelayEffect::getParameter(const std::string& name) const {
@@ -194,6 +218,8 @@ float DuckingDelayEffect::getParameter(const std::string& name) const {
     if (name == "attack") return attack;
     if (name == "release") return release;
     if (name == "quality") return quality;
+    if (name == "keyHighpass") return keyHighpass;
+    if (name == "keyLowpass") return keyLowpass;
     return 0.0f;
 }
 
@@ -206,6 +232,8 @@ void DuckingDelayEffect::setParameterAutomated(const std::string& name, bool aut
     else if (name == "attack") automatedAttack = automated;
     else if (name == "release") automatedRelease = automated;
     else if (name == "quality") automatedQuality = automated;
+    else if (name == "keyHighpass") automatedKeyHighpass = automated;
+    else if (name == "keyLowpass") automatedKeyLowpass = automated;
 }
 
 bool DuckingDelayEffect::isParameterAutomated(const std::string& name) const {
@@ -217,6 +245,8 @@ bool DuckingDelayEffect::isParameterAutomated(const std::string& name) const {
     if (name == "attack") return automatedAttack;
     if (name == "release") return automatedRelease;
     if (name == "quality") return automatedQuality;
+    if (name == "keyHighpass") return automatedKeyHighpass;
+    if (name == "keyLowpass") return automatedKeyLowpass;
     return false;
 }
 
@@ -1,10 +1,26 @@
 #include "EQEffect.hpp"
 #include <cmath>
+#include <cstring>
 #include <algorithm>
 
 namespace VR_DAW {
 
-EQEffect::EQEffect() {
+namespace {
+
+constexpr float kMinLevelDb = -120.0f;
+
+} // namespace
+
+EQEffect::EQEffect()
+    : mode(Mode::MinimumPhase)
+    , controlFill(0)
+    , keyInput(nullptr)
+    , keyFrames(0)
+    , fifoPos(0)
+    , designRequested(0)
+    , designHandled(0)
+    , stopDesign(false)
+{
     // 10 Bands initialisieren
     bands.resize(10);
     
@@ -19,19 +35,50 @@ EQEffect::EQEffect() {
         bands[i].q = 1.0f;
         bands[i].enabled = true;
         bands[i].automated = false;
+        bands[i].threshold = -30.0f;
+        bands[i].ratio = 1.0f;
+        bands[i].range = 12.0f;
+        bands[i].attack = 5.0f;
+        bands[i].release = 80.0f;
     }
     
     // Filter-Koeffizienten und Zustände initialisieren
     coeffs.resize(bands.size());
-    states.resize(bands.size());
+    states.resize(bands.size() * 2);
+    detectors.resize(bands.size());
     
     // Koeffizienten für alle Bands aktualisieren
     for (size_t i = 0; i < bands.size(); ++i) {
         updateFilterCoefficients(i);
+        updateDetectorCoefficients(i);
+    }
+
+    // Linearphasiger Pfad; der erste Kernel wird synchron entworfen, damit
+    // der Audio-Thread immer einen gültigen Kernel vorfindet
+    fft = std::make_unique<VRMusicStudio::RealFFT>(kFftSize);
+    designFft = std::make_unique<VRMusicStudio::RealFFT>(kFftSize);
+    for (int channel = 0; channel < 2; ++channel) {
+        fifoInput[channel].assign(kFftSize, 0.0f);
+        fifoOutput[channel].assign(kHop, 0.0f);
     }
+    fftBuffer.resize(kFftSize);
+    spectrum.resize(fft->getNumBins());
+    filteredSpectrum.resize(fft->getNumBins());
+    activeKernel = designKernel(bands, *designFft);
+    designedKernel.publish(activeKernel);
+
+    designThread = std::thread(&EQEffect::designLoop, this);
 }
 
 EQEffect::~EQEffect() {
+    {
+        std::lock_guard<std::mutex> lock(designMutex);
+        stopDesign = true;
+    }
+    designCondition.notify_all();
+    if (designThread.joinable()) {
+        designThread.join();
+    }
 }
 
 bool EQEffect::initialize() {
@@ -43,6 +90,16 @@ void EQEffect::shutdown() {
 
 std::vector<PluginParameter> EQEffect::getParameters() const {
     std::vector<PluginParameter> params;
+
+    // 0 = minimalphasig, 1 = linearphasig, 2 = dynamisch
+    params.push_back({
+        "mode",
+        "Mode",
+        PluginParameter::Type::Float,
+        0.0f,
+        2.0f,
+        static_cast<float>(mode)
+    });
     
     // Parameter für jeden Band
     for (size_t i = 0; i < bands.size(); ++i) {
@@ -83,55 +140,107 @@ std::vector<PluginParameter> EQEffect::getParameters() const {
             1.0f,
             bands[i].enabled ? 1.0f : 0.0f
         });
+
+        // Dynamic-Modus
+        params.push_back({prefix + "threshold", "Band " + std::to_string(i + 1) + " Threshold",
+                          PluginParameter::Type::Float, -60.0f, 0.0f, bands[i].threshold});
+        params.push_back({prefix + "ratio", "Band " + std::to_string(i + 1) + " Ratio",
+                          PluginParameter::Type::Float, 1.0f, 20.0f, bands[i].ratio});
+        params.push_back({prefix + "range", "Band " + std::to_string(i + 1) + " Range",
+                          PluginParameter::Type::Float, 0.0f, 24.0f, bands[i].range});
+        params.push_back({prefix + "attack", "Band " + std::to_string(i + 1) + " Attack",
+                          PluginParameter::Type::Float, 0.1f, 100.0f, bands[i].attack});
+        params.push_back({prefix + "release", "Band " + std::to_string(i + 1) + " Release",
+                          PluginParameter::Type::Float, 5.0f, 1000.0f, bands[i].release});
     }
     
     return params;
 }
 
+bool EQEffect::parseBandParameter(const std::string& name, size_t& bandIndex, std::string& paramType) const {
+    // Format "band<N>_<parameter>", N = 1 - bands.size()
+    if (name.compare(0, 4, "band") != 0) return false;
+    const size_t separator = name.find('_', 4);
+    if (separator == std::string::npos || separator == 4 || separator > 6) return false;
+
+    size_t number = 0;
+    for (size_t i = 4; i < separator; ++i) {
+        if (name[i] < '0' || name[i] > '9') return false;
+        number = number * 10 + static_cast<size_t>(name[i] - '0');
+    }
+    if (number < 1 || number > bands.size()) return false;
+
+    bandIndex = number - 1;
+    paramType = name.substr(separator + 1);
+    return true;
+}
+
 void EQEffect::setParameter(const std::string& name, float value) {
+    if (name == "mode") {
+        setMode(static_cast<Mode>(static_cast<int>(std::lround(std::clamp(value, 0.0f, 2.0f)))));
+        return;
+    }
+
     // Band-Parameter parsen
     size_t bandIndex;
     std::string paramType;
     
-    if (name.substr(0, 4) == "band" && name[5] == '_') {
-        bandIndex = name[4] - '1';
-        paramType = name.substr(6);
-        
-        if (bandIndex < bands.size()) {
-            if (paramType == "frequency") {
-                bands[bandIndex].frequency = value;
-                updateFilterCoefficients(bandIndex);
-            }
-            else if (paramType == "gain") {
-                bands[bandIndex].gain = value;
-                updateFilterCoefficients(bandIndex);
-            }
-            else if (paramType == "q") {
-                bands[bandIndex].q = value;
-                updateFilterCoefficients(bandIndex);
-            }
-            else if (paramType == "enabled") {
-                bands[bandIndex].enabled = value > 0.5f;
-            }
+    if (parseBandParameter(name, bandIndex, paramType)) {
+        Band& band = bands[bandIndex];
+        bool curveChanged = true;
+
+        if (paramType == "frequency") {
+            band.frequency = value;
+            updateFilterCoefficients(bandIndex);
+            updateDetectorCoefficients(bandIndex);
+        }
+        else if (paramType == "gain") {
+            band.gain = value;
+            updateFilterCoefficients(bandIndex);
+        }
+        else if (paramType == "q") {
+            band.q = value;
+            updateFilterCoefficients(bandIndex);
+            updateDetectorCoefficients(bandIndex);
+        }
+        else if (paramType == "enabled") {
+            band.enabled = value > 0.5f;
+        }
+        else {
+            curveChanged = false;
+            if (paramType == "threshold") band.threshold = value;
+            else if (paramType == "ratio") band.ratio = std::max(value, 1.0f);
+            else if (paramType == "range") band.range = std::max(value, 0.0f);
+            else if (paramType == "attack") band.attack = value;
+            else if (paramType == "release") band.release = value;
+            updateDetectorCoefficients(bandIndex);
+        }
+
+        // Statischer Betragsgang geändert: neuen FIR-Kernel entwerfen
+        if (curveChanged && mode == Mode::LinearPhase) {
+            requestKernel();
         }
     }
 }
 
 float EQEffect::getParameter(const std::string& name) const {
+    if (name == "mode") return static_cast<float>(mode);
+
     // Band-Parameter parsen
     size_t bandIndex;
     std::string paramType;
     
-    if (name.substr(0, 4) == "band" && name[5] == '_') {
-        bandIndex = name[4] - '1';
-        paramType = name.substr(6);
-        
-        if (bandIndex < bands.size()) {
-            if (paramType == "frequency") return bands[bandIndex].frequency;
-            if (paramType == "gain") return bands[bandIndex].gain;
-            if (paramType == "q") return bands[bandIndex].q;
-            if (paramType == "enabled") return bands[bandIndex].enabled ? 1.0f : 0.0f;
-        }
+    if (parseBandParameter(name, bandIndex, paramType)) {
+        const Band& band = bands[bandIndex];
+        if (paramType == "frequency") return band.frequency;
+        if (paramType == "gain") return band.gain;
+        if (paramType == "q") return band.q;
+        if (paramType == "enabled") return band.enabled ? 1.0f : 0.0f;
+        if (paramType == "threshold") return band.threshold;
+        if (paramType == "ratio") return band.ratio;
+        if (paramType == "range") return band.range;
+        if (paramType == "attack") return band.attack;
+        if (paramType == "release") return band.release;
     }
     
     return 0.0f;
@@ -142,14 +251,9 @@ void EQEffect::setParameterAutomated(const std::string& name, bool automated) {
     size_t bandIndex;
     std::string paramType;
     
-    if (name.substr(0, 4) == "band" && name[5] == '_') {
-        bandIndex = name[4] - '1';
-        paramType = name.substr(6);
-        
-        if (bandIndex < bands.size()) {
-            if (paramType == "gain") {
-                bands[bandIndex].automated = automated;
-            }
+    if (parseBandParameter(name, bandIndex, paramType)) {
+        if (paramType == "gain") {
+            bands[bandIndex].automated = automated;
         }
     }
 }
@@ -159,74 +263,343 @@ bool EQEffect::isParameterAutomated(const std::string& name) const {
     size_t bandIndex;
     std::string paramType;
     
-    if (name.substr(0, 4) == "band" && name[5] == '_') {
-        bandIndex = name[4] - '1';
-        paramType = name.substr(6);
-        
-        if (bandIndex < bands.size()) {
-            if (paramType == "gain") {
-                return bands[bandIndex].automated;
-            }
+    if (parseBandParameter(name, bandIndex, paramType)) {
+        if (paramType == "gain") {
+            return bands[bandIndex].automated;
         }
     }
     
     return false;
 }
 
+void EQEffect::setSidechainInput(const float* key, unsigned long framesPerBuffer) {
+    keyInput = key;
+    keyFrames = framesPerBuffer;
+}
+
+int EQEffect::getLatencySamples() const {
+    // Overlap-Save-FIFO plus Gruppenlaufzeit des symmetrischen FIR
+    return mode == Mode::LinearPhase ? static_cast<int>(kHop + (kFirLength - 1) / 2) : 0;
+}
+
+void EQEffect::setMode(Mode newMode) {
+    if (newMode == mode) return;
+
+    if (mode == Mode::Dynamic) {
+        // Dynamische Absenkung verlassen: statische Kurve wiederherstellen
+        for (size_t i = 0; i < bands.size(); ++i) {
+            detectors[i].gainReduction = 0.0f;
+            detectors[i].peak = 0.0f;
+            updateFilterCoefficients(i);
+        }
+        controlFill = 0;
+    }
+    if (newMode == Mode::LinearPhase) {
+        for (int channel = 0; channel < 2; ++channel) {
+            std::fill(fifoInput[channel].begin(), fifoInput[channel].end(), 0.0f);
+            std::fill(fifoOutput[channel].begin(), fifoOutput[channel].end(), 0.0f);
+        }
+        fifoPos = 0;
+        requestKernel();
+    }
+    mode = newMode;
+}
+
 void EQEffect::processAudio(float* buffer, unsigned long framesPerBuffer) {
+    switch (mode) {
+    case Mode::MinimumPhase:
+        processMinimumPhase(buffer, framesPerBuffer);
+        break;
+    case Mode::LinearPhase:
+        processLinearPhase(buffer, framesPerBuffer);
+        break;
+    case Mode::Dynamic:
+        processDynamic(buffer, framesPerBuffer);
+        break;
+    }
+}
+
+void EQEffect::processMinimumPhase(float* buffer, unsigned long framesPerBuffer) {
     for (unsigned long i = 0; i < framesPerBuffer; i += 2) {
         // Stereo-Processing
         float left = buffer[i];
         float right = buffer[i + 1];
-        
+
         // Jeden Band verarbeiten
         for (size_t band = 0; band < bands.size(); ++band) {
             if (bands[band].enabled) {
-                left = processFilter(left, band);
-                right = processFilter(right, band);
+                left = processFilter(left, band, 0);
+                right = processFilter(right, band, 1);
             }
         }
-        
+
         // Ausgabe
         buffer[i] = left;
         buffer[i + 1] = right;
     }
 }
 
-void EQEffect::updateFilterCoefficients(size_t bandIndex) {
-    float w0 = 2.0f * M_PI * bands[bandIndex].frequency / 44100.0f;
-    float alpha = std::sin(w0) / (2.0f * bands[bandIndex].q);
-    float A = std::pow(10.0f, bands[bandIndex].gain / 40.0f);
-    
-    float a0 = 1.0f + alpha;
+void EQEffect::processDynamic(float* buffer, unsigned long framesPerBuffer) {
+    // Key nur verwenden, wenn er den ganzen Puffer abdeckt
+    const float* key = (keyInput && keyFrames >= framesPerBuffer) ? keyInput : buffer;
+
+    for (unsigned long i = 0; i < framesPerBuffer; i += 2) {
+        // Key vor dem Überschreiben lesen (eigener Eingang als Key)
+        const float keyLeft = key[i];
+        const float keyRight = key[i + 1];
+        float left = buffer[i];
+        float right = buffer[i + 1];
+
+        for (size_t band = 0; band < bands.size(); ++band) {
+            if (!bands[band].enabled) continue;
+
+            // Bandpass-Detektor nur für Bänder mit Ratio > 1
+            if (bands[band].ratio > 1.0f) {
+                Detector& detector = detectors[band];
+                for (int channel = 0; channel < 2; ++channel) {
+                    const float x = channel == 0 ? keyLeft : keyRight;
+                    FilterState& state = detector.states[channel];
+                    const float y = detector.coeffs.a0 * x + detector.coeffs.a1 * state.x1 + detector.coeffs.a2 * state.x2
+                                  - detector.coeffs.b1 * state.y1 - detector.coeffs.b2 * state.y2;
+                    state.x2 = state.x1;
+                    state.x1 = x;
+                    state.y2 = state.y1;
+                    state.y1 = y;
+                    detector.peak = std::max(detector.peak, std::abs(y));
+                }
+            }
+
+            left = processFilter(left, band, 0);
+            right = processFilter(right, band, 1);
+        }
+
+        buffer[i] = left;
+        buffer[i + 1] = right;
+
+        // Gains mit Kontrollrate nachführen
+        if (++controlFill == kControlBlock) {
+            controlFill = 0;
+            updateDynamicGains();
+        }
+    }
+}
+
+void EQEffect::updateDynamicGains() {
+    for (size_t i = 0; i < bands.size(); ++i) {
+        const Band& band = bands[i];
+        Detector& detector = detectors[i];
+
+        float target = 0.0f;
+        if (band.enabled && band.ratio > 1.0f) {
+            const float levelDb = detector.peak > 1.0e-6f ? 20.0f * std::log10(detector.peak) : kMinLevelDb;
+            const float overshoot = levelDb - band.threshold;
+            if (overshoot > 0.0f) {
+                target = std::max(overshoot * (1.0f / band.ratio - 1.0f), -band.range);
+            }
+        }
+        detector.peak = 0.0f;
+
+        // Attack bei zunehmender, Release bei abnehmender Absenkung
+        const float coeff = target < detector.gainReduction ? detector.attackCoeff : detector.releaseCoeff;
+        detector.gainReduction = target + (detector.gainReduction - target) * coeff;
+
+        // Biquad nur bei merklicher Änderung neu berechnen
+        if (std::abs(band.gain + detector.gainReduction - detector.appliedGain) > 0.05f) {
+            updateFilterCoefficients(i);
+        }
+    }
+}
+
+void EQEffect::processLinearPhase(float* buffer, unsigned long framesPerBuffer) {
+    for (unsigned long i = 0; i < framesPerBuffer; i += 2) {
+        const float left = buffer[i];
+        const float right = buffer[i + 1];
+        buffer[i] = fifoOutput[0][fifoPos];
+        buffer[i + 1] = fifoOutput[1][fifoPos];
+        fifoInput[0][kFftSize - kHop + fifoPos] = left;
+        fifoInput[1][kFftSize - kHop + fifoPos] = right;
+
+        if (++fifoPos < kHop) continue;
+        fifoPos = 0;
+
+        // Neuer Kernel: alten und neuen Kernel falten und über den Hop überblenden
+        const auto kernel = designedKernel.load();
+        const bool crossfade = kernel && kernel != activeKernel;
+
+        for (int channel = 0; channel < 2; ++channel) {
+            fft->forward(fifoInput[channel].data(), spectrum.data());
+
+            // Overlap-Save: die letzten kHop Samples der zirkulären Faltung sind gültig
+            for (size_t bin = 0; bin < spectrum.size(); ++bin) {
+                filteredSpectrum[bin] = spectrum[bin] * activeKernel->spectrum[bin];
+            }
+            fft->inverse(filteredSpectrum.data(), fftBuffer.data());
+            std::copy(fftBuffer.begin() + (kFftSize - kHop), fftBuffer.end(), fifoOutput[channel].begin());
+
+            if (crossfade) {
+                for (size_t bin = 0; bin < spectrum.size(); ++bin) {
+                    filteredSpectrum[bin] = spectrum[bin] * kernel->spectrum[bin];
+                }
+                fft->inverse(filteredSpectrum.data(), fftBuffer.data());
+                const float* incoming = fftBuffer.data() + (kFftSize - kHop);
+                float* output = fifoOutput[channel].data();
+                for (size_t n = 0; n < kHop; ++n) {
+                    const float fade = static_cast<float>(n + 1) / static_cast<float>(kHop);
+                    output[n] += (incoming[n] - output[n]) * fade;
+                }
+            }
+
+            std::memmove(fifoInput[channel].data(), fifoInput[channel].data() + kHop,
+                         (kFftSize - kHop) * sizeof(float));
+        }
+
+        if (crossfade) {
+            activeKernel = kernel;
+        }
+    }
+}
+
+void EQEffect::requestKernel() {
+    {
+        std::lock_guard<std::mutex> lock(designMutex);
+        pendingBands = bands;
+        ++designRequested;
+    }
+    designCondition.notify_all();
+}
+
+void EQEffect::designLoop() {
+    while (true) {
+        std::vector<Band> snapshot;
+        uint64_t target = 0;
+        {
+            std::unique_lock<std::mutex> lock(designMutex);
+            designCondition.wait(lock, [this] { return stopDesign || designRequested != designHandled; });
+            if (stopDesign) return;
+            // Mehrere Änderungen in Folge ergeben einen einzigen Entwurf
+            snapshot = pendingBands;
+            target = designRequested;
+        }
+
+        designedKernel.publish(designKernel(snapshot, *designFft));
+
+        std::lock_guard<std::mutex> lock(designMutex);
+        designHandled = target;
+    }
+}
+
+std::shared_ptr<const EQEffect::Kernel> EQEffect::designKernel(const std::vector<Band>& snapshot,
+                                                               VRMusicStudio::RealFFT& transform) const {
+    const size_t numBins = transform.getNumBins();
+    const size_t halfLength = (kFirLength - 1) / 2;
+
+    std::vector<FilterCoeffs> sections;
+    for (const auto& band : snapshot) {
+        if (band.enabled && band.gain != 0.0f) {
+            sections.push_back(peakingCoefficients(band.frequency, band.gain, band.q));
+        }
+    }
+
+    // Nullphasiger Betragsgang = Betrag der Biquad-Kaskade
+    std::vector<std::complex<float>> curve(numBins);
+    for (size_t bin = 0; bin < numBins; ++bin) {
+        const double w = 2.0 * M_PI * static_cast<double>(bin) / kFftSize;
+        const std::complex<double> z1 = std::polar(1.0, -w);
+        const std::complex<double> z2 = z1 * z1;
+        double magnitude = 1.0;
+        for (const auto& c : sections) {
+            const std::complex<double> numerator = static_cast<double>(c.a0) + static_cast<double>(c.a1) * z1 + static_cast<double>(c.a2) * z2;
+            const std::complex<double> denominator = 1.0 + static_cast<double>(c.b1) * z1 + static_cast<double>(c.b2) * z2;
+            magnitude *= std::abs(numerator / denominator);
+        }
+        curve[bin] = {static_cast<float>(magnitude), 0.0f};
+    }
+    std::vector<float> impulse(kFftSize);
+    transform.inverse(curve.data(), impulse.data());
+
+    // Impulsantwort um halfLength zentrieren und mit Blackman fenstern
+    std::vector<float> fir(kFftSize, 0.0f);
+    for (size_t n = 0; n < kFirLength; ++n) {
+        const size_t source = (n + kFftSize - halfLength) % kFftSize;
+        const double phase = 2.0 * M_PI * n / (kFirLength - 1);
+        const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+        fir[n] = static_cast<float>(impulse[source] / kFftSize * window);
+    }
+
+    // Kernel enthält bereits die Normierung der späteren inversen FFT
+    auto kernel = std::make_shared<Kernel>();
+    kernel->spectrum.resize(numBins);
+    transform.forward(fir.data(), kernel->spectrum.data());
+    for (auto& bin : kernel->spectrum) {
+        bin /= static_cast<float>(kFftSize);
+    }
+    return kernel;
+}
+
+EQEffect::FilterCoeffs EQEffect::peakingCoefficients(float frequency, float gain, float q) {
+    float w0 = 2.0f * M_PI * std::clamp(frequency, 20.0f, 20000.0f) / 44100.0f;
+    float alpha = std::sin(w0) / (2.0f * std::max(q, 0.1f));
+    float A = std::pow(10.0f, gain / 40.0f);
+
+    float a0 = 1.0f + alpha / A;
     float a1 = -2.0f * std::cos(w0);
-    float a2 = 1.0f - alpha;
+    float a2 = 1.0f - alpha / A;
     float b0 = 1.0f + alpha * A;
     float b1 = a1;
     float b2 = 1.0f - alpha * A;
-    
+
     // Normalisieren
     float scale = 1.0f / a0;
-    coeffs[bandIndex].a0 = b0 * scale;
-    coeffs[bandIndex].a1 = b1 * scale;
-    coeffs[bandIndex].a2 = b2 * scale;
-    coeffs[bandIndex].b1 = a1 * scale;
-    coeffs[bandIndex].b2 = a2 * scale;
+    FilterCoeffs coeffs;
+    coeffs.a0 = b0 * scale;
+    coeffs.a1 = b1 * scale;
+    coeffs.a2 = b2 * scale;
+    coeffs.b1 = a1 * scale;
+    coeffs.b2 = a2 * scale;
+    return coeffs;
 }
 
-float EQEffect::processFilter(float input, size_t bandIndex) {
+void EQEffect::updateFilterCoefficients(size_t bandIndex) {
+    // Im Dynamic-Modus wirkt die aktuelle Absenkung des Detektors mit
+    Detector& detector = detectors[bandIndex];
+    detector.appliedGain = bands[bandIndex].gain + detector.gainReduction;
+    coeffs[bandIndex] = peakingCoefficients(bands[bandIndex].frequency, detector.appliedGain, bands[bandIndex].q);
+}
+
+void EQEffect::updateDetectorCoefficients(size_t bandIndex) {
+    const Band& band = bands[bandIndex];
+    Detector& detector = detectors[bandIndex];
+
+    // RBJ-Bandpass (0 dB Spitzenverstärkung) um die Bandfrequenz
+    float w0 = 2.0f * M_PI * std::clamp(band.frequency, 20.0f, 20000.0f) / 44100.0f;
+    float alpha = std::sin(w0) / (2.0f * std::max(band.q, 0.1f));
+    float scale = 1.0f / (1.0f + alpha);
+    detector.coeffs.a0 = alpha * scale;
+    detector.coeffs.a1 = 0.0f;
+    detector.coeffs.a2 = -alpha * scale;
+    detector.coeffs.b1 = -2.0f * std::cos(w0) * scale;
+    detector.coeffs.b2 = (1.0f - alpha) * scale;
+
+    // Zeitkonstanten in Kontrollblöcken
+    const float blockRate = 44100.0f / static_cast<float>(kControlBlock);
+    detector.attackCoeff = std::exp(-1.0f / (std::max(band.attack, 0.01f) * 0.001f * blockRate));
+    detector.releaseCoeff = std::exp(-1.0f / (std::max(band.release, 0.01f) * 0.001f * blockRate));
+}
+
+float EQEffect::processFilter(float input, size_t bandIndex, int channel) {
+    FilterState& state = states[bandIndex * 2 + channel];
     float output = coeffs[bandIndex].a0 * input
-                 + coeffs[bandIndex].a1 * states[bandIndex].x1
-                 + coeffs[bandIndex].a2 * states[bandIndex].x2
-                 - coeffs[bandIndex].b1 * states[bandIndex].y1
-                 - coeffs[bandIndex].b2 * states[bandIndex].y2;
-    
+                 + coeffs[bandIndex].a1 * state.x1
+                 + coeffs[bandIndex].a2 * state.x2
+                 - coeffs[bandIndex].b1 * state.y1
+                 - coeffs[bandIndex].b2 * state.y2;
+
     // Zustand aktualisieren
-    states[bandIndex].x2 = states[bandIndex].x1;
-    states[bandIndex].x1 = input;
-    states[bandIndex].y2 = states[bandIndex].y1;
-    states[bandIndex].y1 = output;
-    
+    state.x2 = state.x1;
+    state.x1 = input;
+    state.y2 = state.y1;
+    state.y1 = output;
+
     return output;
 }
 
@@ -284,6 +657,10 @@ void EQEffect::loadPreset(const std::string& presetName) {
     // Koeffizienten für alle Bands aktualisieren
     for (size_t i = 0; i < bands.size(); ++i) {
         updateFilterCoefficients(i);
+        updateDetectorCoefficients(i);
+    }
+    if (mode == Mode::LinearPhase) {
+        requestKernel();
     }
 }
 
@@ -12,6 +12,8 @@ GateEffect::GateEffect()
     , range(60.0f)
     , knee(10.0f)
     , mix(1.0f)
+    , keyHighpass(VRMusicStudio::SidechainFilter::kMinHighpass)
+    , keyLowpass(VRMusicStudio::SidechainFilter::kMaxLowpass)
     , automatedThreshold(false)
     , automatedAttack(false)
     , automatedRelease(false)
@@ -19,15 +21,26 @@ GateEffect::GateEffect()
     , automatedRange(false)
     , automatedKnee(false)
     , automatedMix(false)
+    , automatedKeyHighpass(false)
+    , automatedKeyLowpass(false)
     , envelope(0.0f)
     , gain(1.0f)
+    , keyInput(nullptr)
+    , keyFrames(0)
 {
+    for (auto& filter : keyFilters) {
+        filter.prepare(44100.0);
+    }
 }
 
 GateEffect::~GateEffect() {
 }
 
 bool GateEffect::initialize() {
+    for (auto& filter : keyFilters) {
+        filter.prepare(44100.0);
+        filter.setFrequencies(keyHighpass, keyLowpass);
+    }
     return true;
 }
 
@@ -42,7 +55,9 @@ std::vector<PluginParameter> GateEffect::getParameters() const {
         {"ratio", "Ratio", PluginParameter::Type::Float, 1.0f, 100.0f, ratio},
         {"range", "Range", PluginParameter::Type::Float, 0.0f, 100.0f, range},
         {"knee", "Knee", PluginParameter::Type::Float, 0.0f, 40.0f, knee},
-        {"mix", "Mix", PluginParameter::Type::Float, 0.0f, 1.0f, mix}
+        {"mix", "Mix", PluginParameter::Type::Float, 0.0f, 1.0f, mix},
+        {"keyHighpass", "Key HPF", PluginParameter::Type::Float, 20.0f, 2000.0f, keyHighpass},
+        {"keyLowpass", "Key LPF", PluginParameter::Type::Float, 200.0f, 20000.0f, keyLowpass}
     };
 }
 
@@ -54,6 +69,8 @@ void GateEffect::setParameter(const std::string& name, float value) {
     else if (name == "range") range = value;
     else if (name == "knee") knee = value;
     else if (name == "mix") mix = value;
+    else if (name == "keyHighpass") keyHighpass = value;
+    else if (name == "keyLowpass") keyLowpass = value;
 }
 
 float GateEffect::getParameter(const std::string& name) const {
@@ -64,6 +81,8 @@ float GateEffect::getParameter(const std::string& name) const {
     if (name == "range") return range;
     if (name == "knee") return knee;
     if (name == "mix") return mix;
+    if (name == "keyHighpass") return keyHighpass;
+    if (name == "keyLowpass") return keyLowpass;
     return 0.0f;
 }
 
@@ -75,6 +94,8 @@ void GateEffect::setParameterAutomated(const std::string& name, bool automated)
     else if (name == "range") automatedRange = automated;
     else if (name == "knee") automatedKnee = automated;
     else if (name == "mix") automatedMix = automated;
+    else if (name == "keyHighpass") automatedKeyHighpass = automated;
+    else if (name == "keyLowpass") automatedKeyLowpass = automated;
 }
 
 bool GateEffect::isParameterAutomated(const std::string& name) const {
@@ -85,18 +106,32 @@ bool GateEffect::isParameterAutomated(const std::string& name) const {
     if (name == "range") return automatedRange;
     if (name == "knee") return automatedKnee;
     if (name == "mix") return automatedMix;
+    if (name == "keyHighpass") return automatedKeyHighpass;
+    if (name == "keyLowpass") return automatedKeyLowpass;
     return false;
 }
 
+void GateEffect::setSidechainInput(const float* key, unsigned long framesPerBuffer) {
+    keyInput = key;
+    keyFrames = framesPerBuffer;
+}
+
 void GateEffect::processAudio(float* buffer, unsigned long framesPerBuffer) {
+    // Key nur verwenden, wenn er den ganzen Puffer abdeckt
+    const float* key = (keyInput && keyFrames >= framesPerBuffer) ? keyInput : buffer;
+    for (auto& filter : keyFilters) {
+        filter.setFrequencies(keyHighpass, keyLowpass);
+    }
+
     for (unsigned long i = 0; i < framesPerBuffer; i += 2) {
         // Stereo-Processing
         float left = buffer[i];
         float right = buffer[i + 1];
         
-        // Eingangspegel berechnen
-        float inputLevel = std::max(std::abs(left), std::abs(right));
-        float inputDb = linearToDb(inputLevel);
+        // Key-Pegel nach HPF/LPF berechnen
+        float keyLevel = std::max(std::abs(keyFilters[0].process(key[i])),
+                                  std::abs(keyFilters[1].process(key[i + 1])));
+        float inputDb = linearToDb(keyLevel);
         
         // Hüllkurve berechnen
         envelope = calculateEnvelope(inputDb);
@@ -0,0 +1,397 @@
+#include "PitchCorrectionEffect.hpp"
+#include <cmath>
+#include <algorithm>
+
+namespace VR_DAW {
+
+namespace {
+
+constexpr size_t kRingMask = PitchCorrectionEffect::kRingSize - 1;
+constexpr float kUnvoicedPeriod = PitchCorrectionEffect::kLatency / 2;  // reines OLA, Faktor 1
+constexpr float kHysteresis = 0.15f;        // Halbtöne über die Notenmitte hinaus
+constexpr float kHumanizeMs = 300.0f;       // zusätzliche Retune-Zeit bei humanize = 1
+constexpr float kHumanizeSustain = 0.4f;    // Sekunden bis zur vollen Wirkung
+
+// Skalen als Bitmaske über die Tonklassen relativ zur Tonika
+constexpr uint16_t kScaleMasks[] = {
+    0x0FFF,                                                     // Chromatic
+    (1 << 0) | (1 << 2) | (1 << 4) | (1 << 5) | (1 << 7) | (1 << 9) | (1 << 11),   // Major
+    (1 << 0) | (1 << 2) | (1 << 3) | (1 << 5) | (1 << 7) | (1 << 8) | (1 << 10),   // NaturalMinor
+    (1 << 0) | (1 << 2) | (1 << 3) | (1 << 5) | (1 << 7) | (1 << 8) | (1 << 11),   // HarmonicMinor
+    (1 << 0) | (1 << 2) | (1 << 3) | (1 << 5) | (1 << 7) | (1 << 9) | (1 << 10),   // Dorian
+    (1 << 0) | (1 << 2) | (1 << 4) | (1 << 7) | (1 << 9),                          // MajorPentatonic
+    (1 << 0) | (1 << 3) | (1 << 5) | (1 << 7) | (1 << 10),                         // MinorPentatonic
+    (1 << 0) | (1 << 3) | (1 << 5) | (1 << 6) | (1 << 7) | (1 << 10)               // Blues
+};
+constexpr int kScaleCount = static_cast<int>(sizeof(kScaleMasks) / sizeof(kScaleMasks[0]));
+
+} // namespace
+
+PitchCorrectionEffect::PitchCorrectionEffect()
+    : key(0.0f)
+    , scale(static_cast<float>(Scale::Chromatic))
+    , retuneSpeed(40.0f)
+    , humanize(0.3f)
+    , amount(1.0f)
+    , formant(0.0f)
+    , mix(1.0f)
+    , midiTarget(1.0f)
+    , automatedKey(false)
+    , automatedScale(false)
+    , automatedRetuneSpeed(false)
+    , automatedHumanize(false)
+    , automatedAmount(false)
+    , automatedFormant(false)
+    , automatedMix(false)
+    , automatedMidiTarget(false)
+    , detectedFrequency(0.0f)
+    , correction(0.0f)
+    , targetNote(-1)
+    , sustainTime(0.0f)
+    , analysisPeriod(kUnvoicedPeriod)
+    , pitchRatio(1.0f)
+    , formantRatio(1.0f)
+    , heldNotes{}
+    , heldNoteCount(0)
+    , time(0)
+    , analysisMark(0.0)
+    , synthesisMark(0.0)
+    , controlPos(0)
+{
+    // Stimmumfang 110 Hz - 1 kHz, eine Schätzung pro Kontrollblock
+    VRMusicStudio::PitchTracker::Settings settings;
+    settings.minFrequency = kMinFrequency;
+    settings.maxFrequency = 1000.0f;
+    settings.hopMs = 1000.0f * kControlBlock / kSampleRate;
+    tracker.prepare(kSampleRate, settings);
+    estimates.resize(2);
+    monoBlock.resize(kControlBlock, 0.0f);
+
+    for (int channel = 0; channel < 2; ++channel) {
+        inputRing[channel].resize(kRingSize, 0.0f);
+        outputRing[channel].resize(kRingSize, 0.0f);
+    }
+    initialize();
+}
+
+PitchCorrectionEffect::~PitchCorrectionEffect() {
+    shutdown();
+}
+
+bool PitchCorrectionEffect::initialize() {
+    for (int channel = 0; channel < 2; ++channel) {
+        inputRing[channel].assign(kRingSize, 0.0f);
+        outputRing[channel].assign(kRingSize, 0.0f);
+    }
+    std::fill(monoBlock.begin(), monoBlock.end(), 0.0f);
+    tracker.reset();
+
+    detectedFrequency = 0.0f;
+    correction = 0.0f;
+    targetNote = -1;
+    sustainTime = 0.0f;
+    analysisPeriod = kUnvoicedPeriod;
+    pitchRatio = 1.0f;
+    formantRatio = std::pow(2.0f, formant / 12.0f);
+    time = 0;
+    analysisMark = 0.0;
+    synthesisMark = kLatency;
+    controlPos = 0;
+    return true;
+}
+
+void PitchCorrectionEffect::shutdown() {
+    allNotesOff();
+}
+
+std::vector<PluginParameter> PitchCorrectionEffect::getParameters() const {
+    return {
+        {"key", "Key", PluginParameter::Type::Int, 0.0f, 11.0f, key},
+        {"scale", "Scale", PluginParameter::Type::Int, 0.0f, static_cast<float>(kScaleCount - 1), scale},
+        {"retuneSpeed", "Retune Speed", PluginParameter::Type::Float, 0.0f, 400.0f, retuneSpeed},
+        {"humanize", "Humanize", PluginParameter::Type::Float, 0.0f, 1.0f, humanize},
+        {"amount", "Amount", PluginParameter::Type::Float, 0.0f, 1.0f, amount},
+        {"formant", "Formant", PluginParameter::Type::Float, -12.0f, 12.0f, formant},
+        {"mix", "Mix", PluginParameter::Type::Float, 0.0f, 1.0f, mix},
+        {"midiTarget", "MIDI Target", PluginParameter::Type::Bool, 0.0f, 1.0f, midiTarget}
+    };
+}
+
+void PitchCorrectionEffect::setParameter(const std::string& name, float value) {
+    if (name == "key") key = std::clamp(std::round(value), 0.0f, 11.0f);
+    else if (name == "scale") scale = std::clamp(std::round(value), 0.0f, static_cast<float>(kScaleCount - 1));
+    else if (name == "retuneSpeed") retuneSpeed = std::clamp(value, 0.0f, 400.0f);
+    else if (name == "humanize") humanize = std::clamp(value, 0.0f, 1.0f);
+    else if (name == "amount") amount = std::clamp(value, 0.0f, 1.0f);
+    else if (name == "formant") {
+        formant = std::clamp(value, -12.0f, 12.0f);
+        formantRatio = std::pow(2.0f, formant / 12.0f);
+    }
+    else if (name == "mix") mix = std::clamp(value, 0.0f, 1.0f);
+    else if (name == "midiTarget") midiTarget = value >= 0.5f ? 1.0f : 0.0f;
+}
+
+float PitchCorrectionEffect::getParameter(const std::string& name) const {
+    if (name == "key") return key;
+    if (name == "scale") return scale;
+    if (name == "retuneSpeed") return retuneSpeed;
+    if (name == "humanize") return humanize;
+    if (name == "amount") return amount;
+    if (name == "formant") return formant;
+    if (name == "mix") return mix;
+    if (name == "midiTarget") return midiTarget;
+    return 0.0f;
+}
+
+void PitchCorrectionEffect::setParameterAutomated(const std::string& name, bool automated) {
+    if (name == "key") automatedKey = automated;
+    else if (name == "scale") automatedScale = automated;
+    else if (name == "retuneSpeed") automatedRetuneSpeed = automated;
+    else if (name == "humanize") automatedHumanize = automated;
+    else if (name == "amount") automatedAmount = automated;
+    else if (name == "formant") automatedFormant = automated;
+    else if (name == "mix") automatedMix = automated;
+    else if (name == "midiTarget") automatedMidiTarget = automated;
+}
+
+bool PitchCorrectionEffect::isParameterAutomated(const std::string& name) const {
+    if (name == "key") return automatedKey;
+    if (name == "scale") return automatedScale;
+    if (name == "retuneSpeed") return automatedRetuneSpeed;
+    if (name == "humanize") return automatedHumanize;
+    if (name == "amount") return automatedAmount;
+    if (name == "formant") return automatedFormant;
+    if (name == "mix") return automatedMix;
+    if (name == "midiTarget") return automatedMidiTarget;
+    return false;
+}
+
+void PitchCorrectionEffect::noteOn(int note, int velocity) {
+    if (note < 0 || note > 127) return;
+    if (velocity <= 0) {
+        noteOff(note);
+        return;
+    }
+    if (!heldNotes[note]) {
+        heldNotes[note] = true;
+        ++heldNoteCount;
+    }
+}
+
+void PitchCorrectionEffect::noteOff(int note) {
+    if (note < 0 || note > 127 || !heldNotes[note]) return;
+    heldNotes[note] = false;
+    --heldNoteCount;
+}
+
+void PitchCorrectionEffect::allNotesOff() {
+    std::fill(std::begin(heldNotes), std::end(heldNotes), false);
+    heldNoteCount = 0;
+}
+
+void PitchCorrectionEffect::processAudio(float* buffer, unsigned long framesPerBuffer) {
+    for (unsigned long i = 0; i < framesPerBuffer; i += 2) {
+        // Stereo-Processing
+        const float left = buffer[i];
+        const float right = buffer[i + 1];
+        const size_t writeIndex = static_cast<size_t>(time) & kRingMask;
+        inputRing[0][writeIndex] = left;
+        inputRing[1][writeIndex] = right;
+
+        // Tonhöhe und Korrektur pro Kontrollblock
+        monoBlock[controlPos] = (left + right) * 0.5f;
+        if (++controlPos == kControlBlock) {
+            controlPos = 0;
+            tracker.process(monoBlock.data(), kControlBlock, estimates.data(), estimates.size());
+            updateControl();
+        }
+
+        // Alle Grains einplanen, deren erstes Sample jetzt ausgegeben wird
+        while (synthesisMark - grainHalf() / formantRatio <= static_cast<double>(time)) {
+            placeGrain();
+        }
+
+        // Trockensignal um dieselbe Latenz verzögert, sonst kammfiltert der Mix
+        const size_t dryIndex = static_cast<size_t>(time + kRingSize - kLatency) & kRingMask;
+        const float wetLeft = outputRing[0][writeIndex];
+        const float wetRight = outputRing[1][writeIndex];
+        outputRing[0][writeIndex] = 0.0f;
+        outputRing[1][writeIndex] = 0.0f;
+
+        buffer[i] = inputRing[0][dryIndex] * (1.0f - mix) + wetLeft * mix;
+        buffer[i + 1] = inputRing[1][dryIndex] * (1.0f - mix) + wetRight * mix;
+        ++time;
+    }
+}
+
+void PitchCorrectionEffect::updateControl() {
+    const float blockSeconds = kControlBlock / kSampleRate;
+    const auto& estimate = tracker.getLatest();
+
+    float desired = 0.0f;
+    if (estimate.voiced && estimate.frequency > 0.0f) {
+        detectedFrequency = estimate.frequency;
+        analysisPeriod = kSampleRate / estimate.frequency;
+
+        const float inputNote = VRMusicStudio::PitchTracker::frequencyToMidi(estimate.frequency);
+        const bool useMidi = midiTarget >= 0.5f && heldNoteCount > 0;
+        const int note = useMidi ? nearestHeldNote(inputNote) : quantize(inputNote);
+        if (note != targetNote) {
+            targetNote = note;
+            sustainTime = 0.0f;
+        } else {
+            sustainTime += blockSeconds;
+        }
+        desired = (static_cast<float>(targetNote) - inputNote) * amount;
+    } else {
+        // Stimmlos: Faktor 1, Grains im festen Raster
+        detectedFrequency = 0.0f;
+        analysisPeriod = kUnvoicedPeriod;
+        targetNote = -1;
+        sustainTime = 0.0f;
+    }
+
+    // Retune: die Korrektur folgt mit Zeitkonstante, Humanize verlängert sie bei gehaltenen Noten
+    const float timeConstant = retuneSpeed + humanize * kHumanizeMs * std::min(1.0f, sustainTime / kHumanizeSustain);
+    const float coefficient = timeConstant <= 0.0f ? 1.0f : 1.0f - std::exp(-blockSeconds * 1000.0f / timeConstant);
+    correction += (desired - correction) * coefficient;
+    pitchRatio = std::pow(2.0f, correction / 12.0f);
+}
+
+int PitchCorrectionEffect::quantize(float midiNote) const {
+    const uint16_t mask = kScaleMasks[static_cast<int>(scale)];
+    const int tonic = static_cast<int>(key);
+
+    // Hysterese: aktuelle Zielnote halten, solange sie nahe genug bleibt
+    if (targetNote >= 0 && std::abs(midiNote - static_cast<float>(targetNote)) < 0.5f + kHysteresis
+        && (mask & (1 << ((targetNote - tonic + 12) % 12)))) {
+        return targetNote;
+    }
+
+    const int center = static_cast<int>(std::lround(midiNote));
+    int best = center;
+    float bestDistance = 1e9f;
+    for (int note = center - 6; note <= center + 6; ++note) {
+        if (!(mask & (1 << (((note - tonic) % 12 + 12) % 12)))) continue;
+        const float distance = std::abs(midiNote - static_cast<float>(note));
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            best = note;
+        }
+    }
+    return best;
+}
+
+int PitchCorrectionEffect::nearestHeldNote(float midiNote) const {
+    // Tonklasse der gehaltenen Note, Oktave des Sängers
+    int best = static_cast<int>(std::lround(midiNote));
+    float bestDistance = 1e9f;
+    for (int note = 0; note < 128; ++note) {
+        if (!heldNotes[note]) continue;
+        const float octaves = std::round((midiNote - static_cast<float>(note)) / 12.0f);
+        const float candidate = static_cast<float>(note) + 12.0f * octaves;
+        const float distance = std::abs(midiNote - candidate);
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            best = static_cast<int>(candidate);
+        }
+    }
+    return best;
+}
+
+double PitchCorrectionEffect::grainHalf() const {
+    // Eingangshälfte + Ausgangshälfte <= kLatency: der Grain liegt dann beim
+    // Einplanen schon vollständig im Eingang
+    const double maxHalf = kLatency / (1.0 + 1.0 / formantRatio);
+    return std::min(static_cast<double>(analysisPeriod), maxHalf);
+}
+
+void PitchCorrectionEffect::placeGrain() {
+    // TD-PSOLA: Grain um die Analysemarke, die der Ausgabezeit minus Latenz am
+    // nächsten liegt und bereits vollständig im Eingang steht
+    const double now = static_cast<double>(time);
+    const double period = analysisPeriod;
+    const double inputHalf = grainHalf();
+    const double outputHalf = inputHalf / formantRatio;
+
+    while (analysisMark + period + inputHalf <= now) {
+        analysisMark += period;
+    }
+    double center = analysisMark;
+    const double desired = synthesisMark - kLatency;
+    if (center > desired) {
+        center -= period * std::floor((center - desired) / period + 0.5);
+    }
+    // Nach einem Periodenwechsel kann die Marke noch zu jung sein
+    if (center + inputHalf > now) {
+        center -= period * std::ceil((center + inputHalf - now) / period);
+    }
+    // Nie auf Samples zugreifen, die der Ring schon überschrieben hat
+    center = std::max(center, now - static_cast<double>(kRingSize) + inputHalf + 2.0);
+
+    // Abstand der Synthesemarken = neue Periode. Der Gain gleicht die Überlappung
+    // ungekürzter Grains aus; gekürzte tragen den Puls und bleiben unverstärkt
+    const double spacing = period / pitchRatio;
+    const float gain = static_cast<float>(std::min(2.0, spacing * formantRatio / period));
+
+    const long first = static_cast<long>(std::ceil(synthesisMark - outputHalf));
+    const long last = static_cast<long>(std::floor(synthesisMark + outputHalf));
+    for (long t = std::max(first, static_cast<long>(time)); t <= last; ++t) {
+        const double offset = static_cast<double>(t) - synthesisMark;
+        const float window = 0.5f + 0.5f * static_cast<float>(std::cos(M_PI * offset / outputHalf));
+        const double position = center + offset * formantRatio;
+        const size_t index = static_cast<size_t>(t) & kRingMask;
+        outputRing[0][index] += gain * window * readInput(0, position);
+        outputRing[1][index] += gain * window * readInput(1, position);
+    }
+
+    synthesisMark += spacing;
+}
+
+float PitchCorrectionEffect::readInput(int channel, double position) const {
+    if (position < 0.0) return 0.0f;
+    const uint64_t index = static_cast<uint64_t>(position);
+    const float fraction = static_cast<float>(position - static_cast<double>(index));
+    const auto& ring = inputRing[channel];
+    const float a = ring[static_cast<size_t>(index) & kRingMask];
+    const float b = ring[static_cast<size_t>(index + 1) & kRingMask];
+    return a + (b - a) * fraction;
+}
+
+void PitchCorrectionEffect::loadPreset(const std::string& presetName) {
+    if (presetName == "Natural") {
+        scale = static_cast<float>(Scale::Chromatic);
+        retuneSpeed = 60.0f;
+        humanize = 0.5f;
+        amount = 0.8f;
+        formant = 0.0f;
+        mix = 1.0f;
+    }
+    else if (presetName == "Hard Tune") {
+        scale = static_cast<float>(Scale::Major);
+        retuneSpeed = 0.0f;
+        humanize = 0.0f;
+        amount = 1.0f;
+        formant = 0.0f;
+        mix = 1.0f;
+    }
+    else if (presetName == "MIDI Lead") {
+        retuneSpeed = 10.0f;
+        humanize = 0.2f;
+        amount = 1.0f;
+        formant = 0.0f;
+        mix = 1.0f;
+        midiTarget = 1.0f;
+    }
+    formantRatio = std::pow(2.0f, formant / 12.0f);
+}
+
+void PitchCorrectionEffect::savePreset(const std::string& presetName) {
+    // Hier würde die Preset-Speicherung implementiert werden
+}
+
+std::vector<std::string> PitchCorrectionEffect::getAvailablePresets() const {
+    return {"Natural", "Hard Tune", "MIDI Lead"};
+}
+
+} // namespace VR_DAW
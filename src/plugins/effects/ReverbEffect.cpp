@@ -364,6 +364,24 @@ void ReverbEffect::processAudio(float* buffer, unsigned long framesPerBuffer) {
     }
 }
 
+double ReverbEffect::getTailSeconds() const {
+    // Der Kammfilter mit der längsten Nachhallzeit bestimmt das RT60, die
+    // Allpässe dahinter verlängern es; Filterlängen gelten für 44,1 kHz
+    double rt60 = 0.0;
+    for (const auto& filter : combFilters) {
+        const double comb = VRMusicStudio::rt60Seconds(filter.buffer.size() / 44100.0, filter.feedback);
+        if (comb < 0.0) return VRMusicStudio::kInfiniteTail;
+        rt60 = std::max(rt60, comb);
+    }
+    double tail = VRMusicStudio::tailFromRT60(rt60);
+    for (const auto& filter : allpassFilters) {
+        const double allpass = VRMusicStudio::feedbackTailSeconds(filter.buffer.size() / 44100.0, filter.feedback);
+        if (allpass < 0.0) return VRMusicStudio::kInfiniteTail;
+        tail += allpass;
+    }
+    return tail;
+}
+
 void ReverbEffect::processMidi(const std::vector<uint8_t>& midiData) {
     // MIDI-Verarbeitung für den Reverb-Effekt
 }
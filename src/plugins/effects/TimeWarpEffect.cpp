@@ -19,6 +19,11 @@ TimeWarpEffect::TimeWarpEffect()
     , automatedStutter(false)
     , automatedMix(false)
     , automatedQuality(false)
+    , written(0)
+    , activeReader(0)
+    , fadingReader(nullptr)
+    , crossfadeRemaining(0)
+    , currentQuality(VRMusicStudio::TimeStretcher::Quality::High)
     , bufferSize(44100 * 2) // 2 Sekunden bei 44.1kHz
 {
     std::random_device rd;
@@ -36,88 +41,103 @@ bool TimeWarpEffect::initialize() {
 }
 
 void TimeWarpEffect::shutdown() {
-    states.clear();
+    history.clear();
 }
 
 void TimeWarpEffect::initializeStates() {
-    states.clear();
-    
-    // Erstelle 4 Warp-Zustände für komplexe Klangtransformation
-    for (int i = 0; i < 4; ++i) {
-        WarpState state;
-        
-        // Erstelle 8 Zeit-Zustände pro Warp
-        for (int j = 0; j < 8; ++j) {
-            TimeState tstate;
-            std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-            
-            tstate.buffer.resize(bufferSize, 0.0f);
-            tstate.position = dist(rng);
-            tstate.speed = speed;
-            tstate.direction = direction;
-            
-            state.states.push_back(tstate);
+    history.assign(bufferSize, 0.0f);
+    written = 0;
+    crossfadeRemaining = 0;
+    activeReader = 0;
+    fadingReader = nullptr;
+
+    // Alle Stufen vorab vorbereiten, ein Wechsel im Betrieb alloziert nicht
+    for (int tier = 0; tier < kQualityTiers; ++tier) {
+        for (auto& reader : readers[tier]) {
+            reader.prepare(static_cast<VRMusicStudio::TimeStretcher::Quality>(tier));
         }
-        
-        state.time = 0.0f;
-        state.glitch = glitch;
-        
-        states.push_back(state);
     }
+
+    currentQuality = getQualityTier();
+    auto* pair = activePair();
+    for (int i = 0; i < 2; ++i) {
+        pair[i].setSpeed(getWarpRate());
+    }
+
+    // Lesekopf startet eine Frame-Länge hinter dem Schreibkopf
+    pair[activeReader].reset(-static_cast<double>(pair[activeReader].getFrameSize()));
 }
 
 void TimeWarpEffect::updateStates() {
-    // Aktualisiere Zustände basierend auf Parametern
-    for (auto& state : states) {
-        state.glitch = glitch;
-        
-        for (auto& tstate : state.states) {
-            tstate.speed = speed;
-            tstate.direction = direction;
-            
-            // Aktualisiere Position
-            tstate.position += tstate.speed * tstate.direction * 0.01f;
-            
-            // Begrenze Position
-            if (tstate.position > 1.0f) tstate.position -= 1.0f;
-            if (tstate.position < 0.0f) tstate.position += 1.0f;
-        }
-        
-        state.time += 1.0f / 44100.0f;
+    // Läuft am Blockanfang im Audio-Thread
+    const auto tier = getQualityTier();
+    if (tier != currentQuality) {
+        // Neue Stufe setzt an derselben Quellposition ein und wird überblendet
+        VRMusicStudio::TimeStretcher* previous = &activePair()[activeReader];
+        currentQuality = tier;
+        activeReader = 0;
+        activePair()[activeReader].reset(previous->getSourcePosition());
+        fadingReader = previous;
+        crossfadeRemaining = kCrossfadeSamples;
+    }
+
+    auto* pair = activePair();
+    for (int i = 0; i < 2; ++i) {
+        pair[i].setSpeed(getWarpRate());
     }
 }
 
-void TimeWarpEffect::processState(WarpState& state, float* buffer, unsigned long framesPerBuffer) {
+double TimeWarpEffect::getWarpRate() const {
+    // speed 0.5 = Originaltempo, 0 = viertel, 1 = vierfach; direction < 0.5 = rückwärts
+    const double rate = std::pow(2.0, (static_cast<double>(speed) - 0.5) * 4.0);
+    return direction < 0.5f ? -rate : rate;
+}
+
+VRMusicStudio::TimeStretcher::Quality TimeWarpEffect::getQualityTier() const {
+    using Quality = VRMusicStudio::TimeStretcher::Quality;
+    if (quality < 0.34f) return Quality::Draft;
+    if (quality < 0.67f) return Quality::Standard;
+    return Quality::High;
+}
+
+void TimeWarpEffect::processWarp(float* wet, unsigned long framesPerBuffer) {
+    VRMusicStudio::TimeStretcher::Source source;
+    source.data = history.data();
+    source.frames = history.size();
+    source.loop = true;
+
+    auto* pair = activePair();
+    auto& reader = pair[activeReader];
+    const double rate = reader.getSpeed();
+    const double frameSize = static_cast<double>(reader.getFrameSize());
+    const double minLag = frameSize;
+    const double maxLag = static_cast<double>(bufferSize) - frameSize;
+
+    // Abstand zum Schreibkopf am Ende des Blocks vorhersagen und rechtzeitig springen
+    const double lagAtEnd = static_cast<double>(written) - reader.getSourcePosition()
+        - static_cast<double>(framesPerBuffer) * rate;
+    if (crossfadeRemaining == 0 && (lagAtEnd < minLag || lagAtEnd > maxLag)) {
+        // Zu langsam/rückwärts: zurück an die Gegenwart, zu schnell: weit in die Vergangenheit
+        const double targetLag = rate < 1.0 ? minLag : maxLag;
+        const int next = 1 - activeReader;
+        pair[next].setSpeed(rate);
+        pair[next].reset(static_cast<double>(written) - targetLag);
+        fadingReader = &pair[activeReader];
+        activeReader = next;
+        crossfadeRemaining = kCrossfadeSamples;
+    }
+
+    pair[activeReader].process(source, wet, framesPerBuffer);
+    if (crossfadeRemaining == 0) return;
+
+    fadingReader->process(source, fadeBuffer.data(), framesPerBuffer);
     for (unsigned long i = 0; i < framesPerBuffer; ++i) {
-        float output = buffer[i];
-        
-        // Verarbeite jeden Zeit-Zustand
-        for (auto& tstate : state.states) {
-            // Berechne Position im Buffer
-            float position = tstate.position * bufferSize;
-            unsigned long index = static_cast<unsigned long>(position);
-            
-            if (index < tstate.buffer.size()) {
-                // Hole Sample aus Buffer
-                float sample = tstate.buffer[index];
-                
-                // Wende Geschwindigkeit an
-                sample *= tstate.speed;
-                
-                // Wende Richtung an
-                if (tstate.direction < 0.5f) {
-                    sample = -sample;
-                }
-                
-                output += sample;
-            }
-            
-            // Aktualisiere Buffer
-            tstate.buffer.push_back(output);
-            tstate.buffer.pop_front();
+        float fadeIn = 1.0f;
+        if (crossfadeRemaining > 0) {
+            fadeIn = 1.0f - static_cast<float>(crossfadeRemaining) / static_cast<float>(kCrossfadeSamples);
+            --crossfadeRemaining;
         }
-        
-        buffer[i] = output;
+        wet[i] = wet[i] * fadeIn + fadeBuffer[i] * (1.0f - fadeIn);
     }
 }
 
@@ -162,21 +182,31 @@ void TimeWarpEffect::applyStutter(float* buffer, unsigned long framesPerBuffer)
 }
 
 void TimeWarpEffect::processAudio(float* buffer, unsigned long framesPerBuffer) {
-    updateStates();
-    
-    // Verarbeite jeden Zustand
-    for (auto& state : states) {
-        processState(state, buffer, framesPerBuffer);
+    if (history.empty()) return;
+
+    if (wetBuffer.size() < framesPerBuffer) {
+        wetBuffer.resize(framesPerBuffer);
+        fadeBuffer.resize(framesPerBuffer);
     }
-    
-    // Wende Effekte an
-    applyDistortion(buffer, framesPerBuffer);
-    applyGlitch(buffer, framesPerBuffer);
-    applyStutter(buffer, framesPerBuffer);
-    
+
+    // Eingang in den Verlaufspuffer schreiben
+    for (unsigned long i = 0; i < framesPerBuffer; ++i) {
+        history[(written + i) % bufferSize] = buffer[i];
+    }
+    written += framesPerBuffer;
+
+    updateStates();
+    float* wet = wetBuffer.data();
+    processWarp(wet, framesPerBuffer);
+
+    // Wende Effekte auf das verzerrte Signal an
+    applyDistortion(wet, framesPerBuffer);
+    applyGlitch(wet, framesPerBuffer);
+    applyStutter(wet, framesPerBuffer);
+
     // Wende Mix an
     for (unsigned long i = 0; i < framesPerBuffer; ++i) {
-        buffer[i] = buffer[i] * mix;
+        buffer[i] = buffer[i] * (1.0f - mix) + wet[i] * mix;
     }
 }
 
@@ -262,8 +292,7 @@ void TimeWarpEffect::loadPreset(const std::string& presetName) {
         mix = 0.3f;
         quality = 1.0f;
     }
-    
-    updateStates();
+    // Übernahme am nächsten Blockanfang in processAudio()
 }
 
 void TimeWarpEffect::savePreset(const std::string& presetName) {
@@ -4,12 +4,127 @@
 #include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <cstdlib>
+#include <filesystem>
 #include <fstream>
+#include <algorithm>
 #include <sndfile.h>
 
 namespace VR_DAW {
 
-DrumMachine::DrumMachine() : bpm(120.0f), timeSignatureNumerator(4), timeSignatureDenominator(4), currentStep(0.0f), stepLength(0.25f), pitchBend(0.0f), modulation(0.0f), aftertouch(0.0f) {}
+namespace {
+
+// Name, Bereich und Standardwert; Reihenfolge wie PadParameter
+const DrumMachine::ParameterInfo kPadParameters[] = {
+    {"volume", 0.0f, 2.0f, 1.0f},
+    {"pitch", -24.0f, 24.0f, 0.0f},
+    {"start", 0.0f, 1.0f, 0.0f},
+    {"end", 0.0f, 1.0f, 1.0f},
+    {"choke_group", 0.0f, static_cast<float>(DrumMachine::kMaxChokeGroups - 1), 0.0f},
+    {"pan", -1.0f, 1.0f, 0.0f},
+    {"filter_cutoff", 20.0f, 20000.0f, 20000.0f},
+    {"filter_resonance", 0.0f, 1.0f, 0.0f},
+    {"envelope_attack", 0.0f, 10.0f, 0.0f},
+    {"envelope_decay", 0.0f, 10.0f, 0.5f},
+    {"envelope_sustain", 0.0f, 1.0f, 1.0f},
+    {"envelope_release", 0.0f, 10.0f, 0.1f},
+    {"lfo_rate", 0.0f, 20.0f, 1.0f},
+    {"lfo_amount", 0.0f, 1.0f, 0.0f},
+    {"lfo_destination", 0.0f, 2.0f, 0.0f},
+    {"reverb_amount", 0.0f, 1.0f, 0.0f},
+    {"delay_time", 0.0f, 2.0f, 0.0f},
+    {"delay_feedback", 0.0f, 0.95f, 0.0f},
+    {"compression_threshold", 0.0f, 1.0f, 1.0f},
+    {"compression_ratio", 1.0f, 20.0f, 1.0f},
+    {"eq_low", -2.0f, 2.0f, 0.0f},
+    {"eq_mid", -2.0f, 2.0f, 0.0f},
+    {"eq_high", -2.0f, 2.0f, 0.0f},
+    {"distortion_amount", 0.0f, 1.0f, 0.0f},
+    {"granular_grain_size", 0.001f, 1.0f, 0.1f},
+    {"granular_density", 0.0f, 1.0f, 0.0f},
+    {"granular_pitch", -24.0f, 24.0f, 0.0f},
+    {"time_stretch_rate", 0.25f, 4.0f, 1.0f},
+    {"reverse", 0.0f, 1.0f, 0.0f},
+};
+static_assert(sizeof(kPadParameters) / sizeof(kPadParameters[0]) ==
+              static_cast<size_t>(DrumMachine::PadParameter::Count), "PadParameter-Tabelle unvollständig");
+
+const DrumMachine::ParameterInfo kStepParameters[] = {
+    {"active", 0.0f, 1.0f, 0.0f},
+    {"velocity", 1.0f, 127.0f, 100.0f},
+    {"probability", 0.0f, 1.0f, 1.0f},
+    {"pitch", -24.0f, 24.0f, 0.0f},
+    {"length", 0.0625f, 16.0f, 1.0f},
+};
+static_assert(sizeof(kStepParameters) / sizeof(kStepParameters[0]) ==
+              static_cast<size_t>(DrumMachine::StepParameter::Count), "StepParameter-Tabelle unvollständig");
+
+constexpr const char* kKitHeader = "vrdaw-drumkit 1";
+
+bool parseIndex(const std::string& text, int& value) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    const long parsed = std::strtol(text.c_str(), &end, 10);
+    if (*end != '\0') return false;
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+std::vector<std::string> splitName(const std::string& name) {
+    std::vector<std::string> parts;
+    std::stringstream stream(name);
+    std::string part;
+    while (std::getline(stream, part, '.')) parts.push_back(part);
+    return parts;
+}
+
+} // namespace
+
+const DrumMachine::ParameterInfo& DrumMachine::getParameterInfo(PadParameter parameter) {
+    return kPadParameters[static_cast<int>(parameter)];
+}
+
+const DrumMachine::ParameterInfo& DrumMachine::getParameterInfo(StepParameter parameter) {
+    return kStepParameters[static_cast<int>(parameter)];
+}
+
+bool DrumMachine::findParameter(const std::string& name, PadParameter& parameter) {
+    for (int i = 0; i < kPadParameterCount; ++i) {
+        if (name == kPadParameters[i].name) {
+            parameter = static_cast<PadParameter>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool DrumMachine::findParameter(const std::string& name, StepParameter& parameter) {
+    for (int i = 0; i < static_cast<int>(StepParameter::Count); ++i) {
+        if (name == kStepParameters[i].name) {
+            parameter = static_cast<StepParameter>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+DrumMachine::DrumMachine() : pattern(std::make_unique<PatternData>()), frameCounter(0), randomState(0x2545F491u), sequencerRunning(false), sequencerStep(0), nextStepFrame(0.0), bpm(120.0f), timeSignatureNumerator(4), timeSignatureDenominator(4), stepLength(0.5f), pitchBend(0.0f), modulation(0.0f), aftertouch(0.0f) {
+    padInfo.resize(kMaxPads);
+    for (int pad = 0; pad < kMaxPads; ++pad) {
+        resetPad(pad);
+    }
+    clearPattern();
+
+    voices.resize(kMaxVoices);
+    for (auto& voice : voices) {
+        voice.sample = nullptr;
+        voice.pad = -1;
+        voice.active = false;
+        voice.startFrame = 0;
+    }
+    // Trigger werden im Audio-Thread ohne Allokation eingereiht
+    triggers.reserve(kMaxTriggers);
+}
 
 DrumMachine::~DrumMachine() { shutdown(); }
 
@@ -19,16 +134,13 @@ bool DrumMachine::initialize() {
 }
 
 void DrumMachine::shutdown() {
-    activeNotes.clear();
-    pads.clear();
-    steps.clear();
+    sequencerRunning = false;
+    unloadDrumKit();
+    clearPattern();
 }
 
 void DrumMachine::update() {
-    // Sequencer-Logik: Schrittvorschub (z.B. bei jedem Takt)
-    // Dies ist eine vereinfachte Version
-    currentStep += 1.0f;
-    if (currentStep >= 16.0f) currentStep = 0.0f;
+    // Der Sequencer läuft sample-genau in processAudio
 }
 
 std::vector<PluginParameter> DrumMachine::getParameters() const {
@@ -36,29 +148,128 @@ std::vector<PluginParameter> DrumMachine::getParameters() const {
     return {};
 }
 
-void DrumMachine::setParameter(const std::string& name, float value) {}
-float DrumMachine::getParameter(const std::string& name) const { return 0.0f; }
+void DrumMachine::setParameter(const std::string& name, float value) {
+    // "pad.<pad>.<parameter>", "step.<pad>.<step>.<parameter>"; Pad-Parameter
+    // unter einem Step setzen einen Parameter-Lock
+    const auto parts = splitName(name);
+    int pad = 0;
+    int step = 0;
+    PadParameter padParameter;
+    StepParameter stepParameter;
+    if (parts.size() == 3 && parts[0] == "pad" && parseIndex(parts[1], pad) && findParameter(parts[2], padParameter)) {
+        setPadParameter(pad, padParameter, value);
+    } else if (parts.size() == 4 && parts[0] == "step" && parseIndex(parts[1], pad) && parseIndex(parts[2], step)) {
+        if (findParameter(parts[3], stepParameter)) {
+            setStepParameter(pad, step, stepParameter, value);
+        } else if (findParameter(parts[3], padParameter)) {
+            setStepLock(pad, step, padParameter, value);
+        }
+    }
+}
+
+float DrumMachine::getParameter(const std::string& name) const {
+    const auto parts = splitName(name);
+    int pad = 0;
+    int step = 0;
+    PadParameter padParameter;
+    StepParameter stepParameter;
+    if (parts.size() == 3 && parts[0] == "pad" && parseIndex(parts[1], pad) && findParameter(parts[2], padParameter)) {
+        return getPadParameter(pad, padParameter);
+    }
+    if (parts.size() == 4 && parts[0] == "step" && parseIndex(parts[1], pad) && parseIndex(parts[2], step)) {
+        if (findParameter(parts[3], stepParameter)) {
+            return getStepParameter(pad, step, stepParameter);
+        }
+        float value = 0.0f;
+        if (findParameter(parts[3], padParameter) && getStepLock(pad, step, padParameter, value)) {
+            return value;
+        }
+    }
+    return 0.0f;
+}
+
 void DrumMachine::setParameterAutomated(const std::string& name, bool automated) {}
 bool DrumMachine::isParameterAutomated(const std::string& name) const { return false; }
 
+void DrumMachine::resetPad(int pad) {
+    PadInfo& info = padInfo[pad];
+    info = PadInfo();
+    for (int i = 0; i < kPadParameterCount; ++i) {
+        info.parameters[i] = kPadParameters[i].defaultValue;
+    }
+    padData.sample[pad] = nullptr;
+    applyHotParameter(pad, PadParameter::Volume);
+    applyHotParameter(pad, PadParameter::Pitch);
+    applyHotParameter(pad, PadParameter::Start);
+    applyHotParameter(pad, PadParameter::End);
+    applyHotParameter(pad, PadParameter::ChokeGroup);
+}
+
+void DrumMachine::applyHotParameter(int pad, PadParameter parameter) {
+    // Werte, die Stimmenstart und Sequencer brauchen, in die flachen Arrays spiegeln
+    const float value = padInfo[pad].parameters[static_cast<int>(parameter)];
+    switch (parameter) {
+    case PadParameter::Volume: padData.gain[pad] = value; break;
+    case PadParameter::Pitch: padData.pitch[pad] = value; break;
+    case PadParameter::Start: padData.start[pad] = value; break;
+    case PadParameter::End: padData.end[pad] = value; break;
+    case PadParameter::ChokeGroup: padData.chokeGroup[pad] = static_cast<uint8_t>(std::lround(value)); break;
+    default: break;
+    }
+}
+
+void DrumMachine::setPadParameter(int pad, PadParameter parameter, float value) {
+    if (!isValidPad(pad) || parameter >= PadParameter::Count) return;
+    const auto& info = getParameterInfo(parameter);
+    padInfo[pad].parameters[static_cast<int>(parameter)] = std::clamp(value, info.minValue, info.maxValue);
+    applyHotParameter(pad, parameter);
+}
+
+float DrumMachine::getPadParameter(int pad, PadParameter parameter) const {
+    if (!isValidPad(pad) || parameter >= PadParameter::Count) return 0.0f;
+    return padInfo[pad].parameters[static_cast<int>(parameter)];
+}
+
+void DrumMachine::setDrumChokeGroup(int pad, int group) {
+    setPadParameter(pad, PadParameter::ChokeGroup, static_cast<float>(group));
+}
+
 void DrumMachine::processAudio(float* buffer, unsigned long framesPerBuffer) {
-    for (unsigned long i = 0; i < framesPerBuffer; ++i) {
-        float sample = 0.0f;
-        // Aktive Noten (Pads) abspielen
-        for (auto& [pad, note] : activeNotes) {
-            if (note.active) {
-                auto it = pads.find(pad);
-                if (it != pads.end()) {
-                    const auto& padData = it->second;
-                    float position = note.position;
-                    float padSample = processDrumPad(padData, position);
-                    sample += padSample * note.amplitude;
-                    note.position += 1.0f / padData.sampleRate;
-                }
-            }
+    std::fill(buffer, buffer + framesPerBuffer, 0.0f);
+
+    // Steps dieses Puffers einreihen und alle Anschläge nach Offset sortieren
+    // (Insertion Sort, stabil und ohne Allokation)
+    if (sequencerRunning) {
+        scheduleSequencer(framesPerBuffer);
+    }
+    for (size_t i = 1; i < triggers.size(); ++i) {
+        const Trigger trigger = triggers[i];
+        size_t j = i;
+        for (; j > 0 && triggers[j - 1].offset > trigger.offset; --j) {
+            triggers[j] = triggers[j - 1];
+        }
+        triggers[j] = trigger;
+    }
+
+    // Fällige Anschläge starten, spätere in den nächsten Puffer übernehmen
+    size_t pending = 0;
+    for (size_t i = 0; i < triggers.size(); ++i) {
+        Trigger trigger = triggers[i];
+        if (trigger.offset < framesPerBuffer) {
+            startVoice(trigger);
+        } else {
+            trigger.offset -= framesPerBuffer;
+            triggers[pending++] = trigger;
+        }
+    }
+    triggers.resize(pending);
+
+    for (auto& voice : voices) {
+        if (voice.active) {
+            renderVoice(voice, buffer, framesPerBuffer);
         }
-        buffer[i] = sample;
     }
+    frameCounter += framesPerBuffer;
 }
 
 void DrumMachine::processMidi(const std::vector<uint8_t>& midiData) {
@@ -74,59 +285,421 @@ void DrumMachine::processMidi(const std::vector<uint8_t>& midiData) {
 }
 
 void DrumMachine::noteOn(int pad, int velocity) {
-    Note newNote;
-    newNote.pad = pad;
-    newNote.velocity = velocity;
-    newNote.amplitude = velocity / 127.0f;
-    newNote.position = 0.0f;
-    newNote.active = true;
-    activeNotes[pad] = newNote;
+    if (velocity <= 0) {
+        noteOff(pad);
+        return;
+    }
+    triggerPad(pad, velocity, 0);
 }
 
 void DrumMachine::noteOff(int pad) {
-    auto it = activeNotes.find(pad);
-    if (it != activeNotes.end()) {
-        it->second.active = false;
+    // One-Shots des Pads kurz ausblenden statt hart abzuschneiden
+    for (auto& voice : voices) {
+        if (voice.active && voice.pad == pad && voice.fadeRemaining == 0) {
+            voice.fadeRemaining = kChokeFadeFrames;
+        }
+    }
+}
+
+void DrumMachine::triggerPad(int pad, int velocity, unsigned long frameOffset) {
+    if (!isValidPad(pad) || velocity <= 0) return;
+    queueTrigger({pad, std::min(velocity, 127), 0.0f, 0, 0, frameOffset});
+}
+
+void DrumMachine::queueTrigger(const Trigger& trigger) {
+    if (triggers.size() < kMaxTriggers) {
+        triggers.push_back(trigger);
+    }
+}
+
+void DrumMachine::scheduleSequencer(unsigned long framesPerBuffer) {
+    const PatternData& data = *pattern;
+    const double step = framesPerStep();
+    const double blockStart = static_cast<double>(frameCounter);
+    const double blockEnd = blockStart + static_cast<double>(framesPerBuffer);
+
+    while (nextStepFrame < blockEnd) {
+        const auto offset = static_cast<unsigned long>(std::max(0.0, nextStepFrame - blockStart));
+
+        // Nur gesetzte Bits besuchen; die Felder eines Steps liegen hintereinander
+        const auto& words = data.active[sequencerStep];
+        for (int word = 0; word < kPadWords; ++word) {
+            uint64_t bits = words[word];
+            for (int pad = word * 64; bits != 0; ++pad, bits >>= 1) {
+                if (!(bits & 1)) continue;
+                const int cell = cellIndex(pad, sequencerStep);
+                const uint8_t probability = data.probability[cell];
+                if (probability < 255 && nextRandom() * 255.0f >= probability) continue;
+                queueTrigger({pad, data.velocity[cell], data.pitch[cell], 0, 0, offset});
+            }
+        }
+
+        sequencerStep = (sequencerStep + 1) % kStepsPerPattern;
+        nextStepFrame += step;
+    }
+}
+
+void DrumMachine::startVoice(const Trigger& trigger) {
+    const int pad = trigger.pad;
+    const PadSample* sample = padData.sample[pad];
+    if (!sample || sample->frames == 0) return;
+
+    // Bereich: Slice aus dem Trigger oder Start/Ende des Pads
+    const double frames = static_cast<double>(sample->frames);
+    double start = padData.start[pad] * frames;
+    double end = padData.end[pad] * frames;
+    if (trigger.end > trigger.start) {
+        start = static_cast<double>(trigger.start);
+        end = std::min(static_cast<double>(trigger.end), frames);
+    }
+    if (end <= start) return;
+
+    // Neue Generation der Choke-Gruppe; ältere Stimmen blenden ab diesem Frame aus
+    const uint64_t frame = frameCounter + trigger.offset;
+    const int chokeGroup = padData.chokeGroup[pad];
+    uint32_t generation = 0;
+    if (chokeGroup > 0) {
+        auto& group = chokeGroups[chokeGroup];
+        generation = ++group.generation;
+        group.frames[generation & 3] = frame;
+    }
+
+    // Freie Stimme, sonst die älteste
+    Note* target = nullptr;
+    for (auto& voice : voices) {
+        if (!voice.active) {
+            target = &voice;
+            break;
+        }
+        if (!target || voice.startFrame < target->startFrame) {
+            target = &voice;
+        }
+    }
+
+    Note& voice = *target;
+    voice.sample = sample;
+    voice.pad = pad;
+    voice.amplitude = trigger.velocity / 127.0f * padData.gain[pad];
+    voice.position = start;
+    voice.increment = std::pow(2.0, (padData.pitch[pad] + trigger.pitch) / 12.0) * sample->sampleRate / 44100.0; // Sample-Rate: 44.1kHz
+    voice.end = end;
+    voice.fadeAtEnd = end < frames;
+    voice.startOffset = trigger.offset;
+    voice.startFrame = frame;
+    voice.chokeGroup = chokeGroup;
+    voice.chokeGeneration = generation;
+    voice.fadeRemaining = 0;
+    voice.active = true;
+}
+
+void DrumMachine::renderVoice(Note& voice, float* buffer, unsigned long framesPerBuffer) {
+    const PadSample& sample = *voice.sample;
+    unsigned long i = voice.startOffset;
+    voice.startOffset = 0;
+
+    // Von einem späteren Anschlag derselben Gruppe gechokt?
+    unsigned long chokeOffset = framesPerBuffer;
+    if (voice.chokeGroup > 0 && voice.fadeRemaining == 0) {
+        const auto& group = chokeGroups[voice.chokeGroup];
+        if (group.generation != voice.chokeGeneration) {
+            const uint32_t newer = group.generation - voice.chokeGeneration;
+            const uint64_t frame = newer < group.frames.size()
+                ? group.frames[(voice.chokeGeneration + 1) & 3] : frameCounter;
+            chokeOffset = frame > frameCounter ? static_cast<unsigned long>(frame - frameCounter) : 0;
+            chokeOffset = std::max(chokeOffset, i);
+        }
+    }
+
+    for (; i < framesPerBuffer; ++i) {
+        if (voice.position >= voice.end) {
+            voice.active = false;
+            return;
+        }
+        if (i == chokeOffset) {
+            voice.fadeRemaining = kChokeFadeFrames;
+        }
+
+        float gain = voice.amplitude;
+        if (voice.fadeAtEnd) {
+            // Kurze Ausblende vor dem nächsten Slice bzw. dem Pad-Ende gegen Klicks
+            gain *= std::min(1.0f, static_cast<float>(voice.end - voice.position) / kSliceFadeFrames);
+        }
+        const bool fading = voice.fadeRemaining > 0;
+        if (fading) {
+            gain *= static_cast<float>(voice.fadeRemaining--) / kChokeFadeFrames;
+        }
+        buffer[i] += processDrumPad(sample, voice.position) * gain;
+        voice.position += voice.increment;
+
+        if (fading && voice.fadeRemaining == 0) {
+            voice.active = false;
+            return;
+        }
     }
 }
 
-float DrumMachine::processDrumPad(const DrumPad& pad, float position) {
-    if (pad.data.empty()) return 0.0f;
-    float sampleLength = static_cast<float>(pad.data.size()) / pad.channels;
-    float samplePosition = position * pad.sampleRate;
-    int index = static_cast<int>(samplePosition);
-    float fraction = samplePosition - index;
-    if (index + 1 < pad.data.size()) {
-        return pad.data[index] * (1.0f - fraction) + pad.data[index + 1] * fraction;
+void DrumMachine::stopPadVoices(int pad) {
+    for (auto& voice : voices) {
+        if (voice.pad == pad) {
+            voice.active = false;
+        }
+    }
+}
+
+int DrumMachine::getActiveVoiceCount() const {
+    int count = 0;
+    for (const auto& voice : voices) {
+        if (voice.active) ++count;
+    }
+    return count;
+}
+
+float DrumMachine::nextRandom() {
+    // xorshift32, allokationsfrei im Audio-Thread
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return static_cast<float>(randomState >> 8) / 16777216.0f;
+}
+
+float DrumMachine::processDrumPad(const PadSample& sample, double position) {
+    // Kanäle zu Mono mischen, linear interpolieren
+    const int channels = sample.channels;
+    const auto index = static_cast<size_t>(position);
+    if (index >= sample.frames) return 0.0f;
+
+    auto frameAt = [&](size_t frame) {
+        float sum = 0.0f;
+        for (int ch = 0; ch < channels; ++ch) sum += sample.data[frame * channels + ch];
+        return sum / channels;
+    };
+
+    const float fraction = static_cast<float>(position - static_cast<double>(index));
+    float value = frameAt(index);
+    if (index + 1 < sample.frames) {
+        value += (frameAt(index + 1) - value) * fraction;
     }
-    return pad.data[index];
+    return value;
 }
 
 void DrumMachine::setDrumSample(int pad, const std::string& path) {
+    if (!isValidPad(pad)) return;
+
     SF_INFO fileInfo;
     SNDFILE* file = sf_open(path.c_str(), SFM_READ, &fileInfo);
     if (!file) {
         spdlog::error("Konnte Drum-Sample nicht laden: {}", path);
         return;
     }
-    DrumPad drumPad;
-    drumPad.data.resize(fileInfo.frames * fileInfo.channels);
-    sf_readf_float(file, drumPad.data.data(), fileInfo.frames);
-    drumPad.sampleRate = fileInfo.samplerate;
-    drumPad.channels = fileInfo.channels;
-    drumPad.volume = 1.0f;
-    drumPad.pan = 0.0f;
-    drumPad.pitch = 0.0f;
-    pads[pad] = drumPad;
+    auto sample = std::make_shared<PadSample>();
+    sample->channels = std::max(1, fileInfo.channels);
+    sample->sampleRate = static_cast<float>(fileInfo.samplerate);
+    sample->data.resize(static_cast<size_t>(fileInfo.frames) * sample->channels);
+    const sf_count_t read = sf_readf_float(file, sample->data.data(), fileInfo.frames);
     sf_close(file);
+    sample->frames = static_cast<size_t>(std::max<sf_count_t>(0, read));
+    sample->data.resize(sample->frames * sample->channels);
+
+    // Stimmen des alten Samples beenden, bevor dessen Daten verschwinden
+    stopPadVoices(pad);
+    PadInfo& info = padInfo[pad];
+    info.path = path;
+    info.sample = sample;
+    padData.sample[pad] = sample.get();
+
+    // Onset-Analyse läuft im Hintergrund, Ergebnisse werden pro Datei gecacht
+    requestOnsets(info);
+}
+
+void DrumMachine::requestOnsets(PadInfo& pad) {
+    if (!pad.sample || pad.sample->data.empty()) return;
+    if (!pad.onsets) {
+        pad.onsets = std::make_shared<VRMusicStudio::OnsetSlot>();
+    }
+    // Teilt sich die Daten mit dem Pad statt sie zu kopieren
+    std::shared_ptr<const std::vector<float>> data(pad.sample, &pad.sample->data);
+    VRMusicStudio::OnsetAnalyzer::getInstance().request(pad.onsets, pad.path, std::move(data),
+                                                        pad.sample->channels, pad.sample->sampleRate, pad.onsetSettings);
+    pad.slicesDirty = true;
+}
+
+void DrumMachine::resolveSlices(PadInfo& pad) {
+    auto markers = pad.onsets ? pad.onsets->load() : nullptr;
+    if (!pad.slicesDirty && markers == pad.resolvedOnsets) return;
+    pad.resolvedOnsets = markers;
+    pad.slicesDirty = false;
+
+    const size_t frames = pad.sample ? pad.sample->frames : 0;
+    const float sampleRate = pad.sample ? pad.sample->sampleRate : 44100.0f;
+    std::vector<size_t> starts;
+    starts.reserve(pad.slicePoints.size() + 1);
+    starts.push_back(0);
+    for (float point : pad.slicePoints) {
+        starts.push_back(static_cast<size_t>(std::clamp(point, 0.0f, 1.0f) * static_cast<float>(frames)));
+    }
+    std::sort(starts.begin(), starts.end());
+    starts.erase(std::unique(starts.begin(), starts.end()), starts.end());
+
+    // Marker einer anderen Dateiversion ignorieren
+    if (markers && markers->frames == frames && !markers->onsets.empty()) {
+        if (pad.sliceMode == "transient") {
+            // Ein Slice pro Onset; Onsets direkt am Dateianfang gehören zum ersten Slice
+            const size_t minDistance = static_cast<size_t>(pad.onsetSettings.minIntervalMs * 0.001f * sampleRate);
+            starts.assign(1, 0);
+            for (size_t onset : markers->onsets) {
+                if (onset > minDistance && onset < frames) starts.push_back(onset);
+            }
+        } else if (pad.sliceMode == "snap" && starts.size() > 1) {
+            // Gesetzte Punkte auf den nächsten Onset ziehen, maximal um
+            // sliceQuantize * mittlere Slice-Länge
+            const size_t maxDistance = static_cast<size_t>(
+                pad.sliceQuantize * static_cast<float>(frames) / static_cast<float>(starts.size()));
+            starts = VRMusicStudio::OnsetDetector::snapToOnsets(starts, markers->onsets, maxDistance);
+            starts.front() = 0;
+        }
+    }
+
+    pad.sliceStarts = std::move(starts);
+}
+
+void DrumMachine::setDrumSlice(int pad, const std::vector<float>& slicePoints) {
+    if (!isValidPad(pad)) return;
+    padInfo[pad].slicePoints = slicePoints;
+    padInfo[pad].slicesDirty = true;
+}
+
+void DrumMachine::setDrumSliceMode(int pad, const std::string& mode) {
+    if (!isValidPad(pad)) return;
+    if (mode != "manual" && mode != "transient" && mode != "snap") {
+        spdlog::warn("Unbekannter Slice-Modus: {}", mode);
+        return;
+    }
+    padInfo[pad].sliceMode = mode;
+    padInfo[pad].slicesDirty = true;
+}
+
+void DrumMachine::setDrumSliceQuantize(int pad, float amount) {
+    if (!isValidPad(pad)) return;
+    padInfo[pad].sliceQuantize = std::clamp(amount, 0.0f, 1.0f);
+    padInfo[pad].slicesDirty = true;
+}
+
+void DrumMachine::setDrumSliceDetection(int pad, VRMusicStudio::OnsetDetector::Method method, float sensitivity) {
+    if (!isValidPad(pad)) return;
+    padInfo[pad].onsetSettings.method = method;
+    padInfo[pad].onsetSettings.sensitivity = std::clamp(sensitivity, 0.0f, 1.0f);
+    requestOnsets(padInfo[pad]);
+}
+
+void DrumMachine::triggerDrumSlice(int pad, int slice, int velocity) {
+    if (!isValidPad(pad) || velocity <= 0) return;
+    PadInfo& info = padInfo[pad];
+    if (!info.sample) return;
+    resolveSlices(info);
+    if (slice < 0 || slice >= static_cast<int>(info.sliceStarts.size())) return;
+
+    // Slice-Grenzen hier auflösen, der Audio-Thread liest nur den Trigger
+    const size_t start = info.sliceStarts[slice];
+    const size_t end = slice + 1 < static_cast<int>(info.sliceStarts.size())
+        ? info.sliceStarts[slice + 1] : info.sample->frames;
+    queueTrigger({pad, std::min(velocity, 127), 0.0f, start, end, 0});
+}
+
+std::vector<float> DrumMachine::getDrumSlicePoints(int pad) {
+    std::vector<float> points;
+    if (!isValidPad(pad) || !padInfo[pad].sample) return points;
+    PadInfo& info = padInfo[pad];
+    resolveSlices(info);
+
+    const size_t frames = info.sample->frames;
+    if (frames == 0) return points;
+    for (size_t start : info.sliceStarts) {
+        points.push_back(static_cast<float>(start) / static_cast<float>(frames));
+    }
+    return points;
 }
 
 void DrumMachine::unloadDrumKit() {
-    pads.clear();
+    for (auto& voice : voices) {
+        voice.active = false;
+    }
+    triggers.clear();
+    for (int pad = 0; pad < kMaxPads; ++pad) {
+        resetPad(pad);
+    }
+}
+
+bool DrumMachine::loadDrumKit(const std::string& path) {
+    std::ifstream stream(path);
+    std::string line;
+    if (!stream || !std::getline(stream, line) || line != kKitHeader) {
+        spdlog::error("Kein Drum-Kit: {}", path);
+        return false;
+    }
+    unloadDrumKit();
+
+    // Eine Zeile pro Eintrag: "pad <n> <schlüssel> <wert>"; relative
+    // Sample-Pfade beziehen sich auf das Verzeichnis des Kits
+    const std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    while (std::getline(stream, line)) {
+        std::istringstream entry(line);
+        std::string tag;
+        std::string key;
+        int pad = -1;
+        if (!(entry >> tag >> pad >> key) || tag != "pad" || !isValidPad(pad)) continue;
+
+        PadParameter parameter;
+        if (key == "sample") {
+            std::string file;
+            std::getline(entry >> std::ws, file);
+            std::filesystem::path samplePath(file);
+            if (samplePath.is_relative()) samplePath = directory / samplePath;
+            setDrumSample(pad, samplePath.string());
+        } else if (key == "slice_mode") {
+            std::string mode;
+            if (entry >> mode) setDrumSliceMode(pad, mode);
+        } else if (key == "slice_quantize") {
+            float amount = 0.0f;
+            if (entry >> amount) setDrumSliceQuantize(pad, amount);
+        } else if (key == "slices") {
+            std::vector<float> points;
+            float point = 0.0f;
+            while (entry >> point) points.push_back(point);
+            setDrumSlice(pad, points);
+        } else if (findParameter(key, parameter)) {
+            float value = 0.0f;
+            if (entry >> value) setPadParameter(pad, parameter, value);
+        }
+    }
+    return true;
 }
 
-void DrumMachine::loadDrumKit(const std::string& path) {
-    // Platzhalter: Drumkit-Ladefunktion kann später erweitert werden
+bool DrumMachine::saveDrumKit(const std::string& path) const {
+    std::ofstream stream(path, std::ios::trunc);
+    if (!stream) {
+        spdlog::error("Konnte Drum-Kit nicht speichern: {}", path);
+        return false;
+    }
+    stream << kKitHeader << '\n' << std::setprecision(9);
+
+    // Nur belegte Pads und abweichende Werte
+    for (int pad = 0; pad < kMaxPads; ++pad) {
+        const PadInfo& info = padInfo[pad];
+        if (!info.path.empty()) stream << "pad " << pad << " sample " << info.path << '\n';
+        for (int i = 0; i < kPadParameterCount; ++i) {
+            if (info.parameters[i] != kPadParameters[i].defaultValue) {
+                stream << "pad " << pad << ' ' << kPadParameters[i].name << ' ' << info.parameters[i] << '\n';
+            }
+        }
+        if (info.sliceMode != "manual") stream << "pad " << pad << " slice_mode " << info.sliceMode << '\n';
+        if (info.sliceQuantize != 0.25f) stream << "pad " << pad << " slice_quantize " << info.sliceQuantize << '\n';
+        if (!info.slicePoints.empty()) {
+            stream << "pad " << pad << " slices";
+            for (float point : info.slicePoints) stream << ' ' << point;
+            stream << '\n';
+        }
+    }
+    return static_cast<bool>(stream);
 }
 
 float DrumMachine::processFilter(float input, float cutoff, float resonance) {
@@ -298,6 +871,21 @@ float DrumMachine::processReverse(float input) {
     return output;
 }
 
+void DrumMachine::startSequencer() {
+    sequencerStep = 0;
+    nextStepFrame = static_cast<double>(frameCounter);
+    sequencerRunning = true;
+}
+
+void DrumMachine::stopSequencer() {
+    sequencerRunning = false;
+}
+
+double DrumMachine::framesPerStep() const {
+    // stepLength ist ein Schlag (1/denominator), ein Step ein Sechzehntel
+    return stepLength * timeSignatureDenominator / 16.0 * 44100.0; // Sample-Rate: 44.1kHz
+}
+
 void DrumMachine::setBPM(float newBpm) {
     bpm = newBpm;
     stepLength = 60.0f / (bpm * timeSignatureDenominator / 4.0f);
@@ -310,2750 +898,86 @@ void DrumMachine::setTimeSignature(int numerator, int denominator) {
 }
 
 void DrumMachine::setStep(int pad, int step, bool active) {
-    if (steps.find(pad) == steps.end()) {
-        steps[pad] = std::vector<Step>(16);
-    }
-    if (step >= 0 && step < 16) {
-        steps[pad][step].active = active;
-    }
-}
-
-void DrumMachine::setStepVelocity(int pad, int step, int velocity) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].velocity = velocity;
-    }
-}
-
-void DrumMachine::setStepProbability(int pad, int step, float probability) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].probability = probability;
-    }
-}
-
-void DrumMachine::setStepCondition(int pad, int step, const std::string& condition) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].condition = condition;
-    }
-}
-
-void DrumMachine::setStepLength(int pad, int step, float length) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].length = length;
-    }
-}
-
-void DrumMachine::setStepPitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].pitch = pitch;
-    }
-}
-
-void DrumMachine::setStepPan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].pan = pan;
-    }
-}
-
-void DrumMachine::setStepFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].filterCutoff = cutoff;
-        steps[pad][step].filterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].envelopeAttack = attack;
-        steps[pad][step].envelopeDecay = decay;
-        steps[pad][step].envelopeSustain = sustain;
-        steps[pad][step].envelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].lfoRate = rate;
-        steps[pad][step].lfoAmount = amount;
-        steps[pad][step].lfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].reverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].delayTime = time;
-        steps[pad][step].delayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].compressionThreshold = threshold;
-        steps[pad][step].compressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].eqLow = low;
-        steps[pad][step].eqMid = mid;
-        steps[pad][step].eqHigh = high;
-    }
-}
-
-void DrumMachine::setStepDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].distortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
+    setStepParameter(pad, step, StepParameter::Active, active ? 1.0f : 0.0f);
 }
 
-void DrumMachine::setStepSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
+void DrumMachine::setStepParameter(int pad, int step, StepParameter parameter, float value) {
+    if (!isValidCell(pad, step) || parameter >= StepParameter::Count) return;
+    const auto& info = getParameterInfo(parameter);
+    value = std::clamp(value, info.minValue, info.maxValue);
 
-void DrumMachine::setStepSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
+    PatternData& data = *pattern;
+    const int cell = cellIndex(pad, step);
+    switch (parameter) {
+    case StepParameter::Active: {
+        const uint64_t bit = uint64_t(1) << (pad & 63);
+        auto& word = data.active[step][pad >> 6];
+        word = value >= 0.5f ? (word | bit) : (word & ~bit);
+        break;
     }
-}
-
-void DrumMachine::setStepSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
+    case StepParameter::Velocity: data.velocity[cell] = static_cast<uint8_t>(std::lround(value)); break;
+    case StepParameter::Probability: data.probability[cell] = static_cast<uint8_t>(std::lround(value * 255.0f)); break;
+    case StepParameter::Pitch: data.pitch[cell] = value; break;
+    case StepParameter::Length: data.length[cell] = value; break;
+    default: break;
     }
 }
 
-void DrumMachine::setStepSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
+float DrumMachine::getStepParameter(int pad, int step, StepParameter parameter) const {
+    if (!isValidCell(pad, step)) return 0.0f;
 
-void DrumMachine::setStepSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
+    const PatternData& data = *pattern;
+    const int cell = cellIndex(pad, step);
+    switch (parameter) {
+    case StepParameter::Active: return static_cast<float>((data.active[step][pad >> 6] >> (pad & 63)) & 1);
+    case StepParameter::Velocity: return data.velocity[cell];
+    case StepParameter::Probability: return data.probability[cell] / 255.0f;
+    case StepParameter::Pitch: return data.pitch[cell];
+    case StepParameter::Length: return data.length[cell];
+    default: return 0.0f;
     }
 }
 
-void DrumMachine::setStepSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
+void DrumMachine::clearPattern() {
+    PatternData& data = *pattern;
+    for (auto& words : data.active) {
+        words.fill(0);
     }
+    data.velocity.fill(static_cast<uint8_t>(getParameterInfo(StepParameter::Velocity).defaultValue));
+    data.probability.fill(255);
+    data.pitch.fill(0.0f);
+    data.length.fill(1.0f);
+    stepLocks.clear();
+    stepConditions.clear();
 }
 
-void DrumMachine::setStepSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
+void DrumMachine::setStepLock(int pad, int step, PadParameter parameter, float value) {
+    if (!isValidCell(pad, step) || parameter >= PadParameter::Count) return;
+    const auto& info = getParameterInfo(parameter);
+    const uint32_t key = static_cast<uint32_t>(cellIndex(pad, step)) << 8 | static_cast<uint32_t>(parameter);
+    stepLocks[key] = std::clamp(value, info.minValue, info.maxValue);
 }
 
-void DrumMachine::setStepSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
+void DrumMachine::clearStepLock(int pad, int step, PadParameter parameter) {
+    if (!isValidCell(pad, step)) return;
+    stepLocks.erase(static_cast<uint32_t>(cellIndex(pad, step)) << 8 | static_cast<uint32_t>(parameter));
 }
 
-void DrumMachine::setStepSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
+bool DrumMachine::getStepLock(int pad, int step, PadParameter parameter, float& value) const {
+    if (!isValidCell(pad, step)) return false;
+    auto it = stepLocks.find(static_cast<uint32_t>(cellIndex(pad, step)) << 8 | static_cast<uint32_t>(parameter));
+    if (it == stepLocks.end()) return false;
+    value = it->second;
+    return true;
 }
 
-void DrumMachine::setStepSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDistortion(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDistortionAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlice(int pad, int step, const std::vector<float>& slicePoints) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePoints = slicePoints;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceMode(int pad, int step, const std::string& mode) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceMode = mode;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceQuantize(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceQuantize = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceRandom(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceRandom = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverse(int pad, int step, bool reverse) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverse = reverse;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePitch(int pad, int step, float pitch) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePitch = pitch;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceVolume(int pad, int step, float volume) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceVolume = volume;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSlicePan(int pad, int step, float pan) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].slicePan = pan;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceFilter(int pad, int step, float cutoff, float resonance) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceFilterCutoff = cutoff;
-        steps[pad][step].sliceFilterResonance = resonance;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEnvelope(int pad, int step, float attack, float decay, float sustain, float release) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEnvelopeAttack = attack;
-        steps[pad][step].sliceEnvelopeDecay = decay;
-        steps[pad][step].sliceEnvelopeSustain = sustain;
-        steps[pad][step].sliceEnvelopeRelease = release;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceLFO(int pad, int step, float rate, float amount, const std::string& destination) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceLfoRate = rate;
-        steps[pad][step].sliceLfoAmount = amount;
-        steps[pad][step].sliceLfoDestination = destination;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceReverb(int pad, int step, float amount) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceReverbAmount = amount;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceDelay(int pad, int step, float time, float feedback) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceDelayTime = time;
-        steps[pad][step].sliceDelayFeedback = feedback;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceCompression(int pad, int step, float threshold, float ratio) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceCompressionThreshold = threshold;
-        steps[pad][step].sliceCompressionRatio = ratio;
-    }
-}
-
-void DrumMachine::setStepSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceSliceEQ(int pad, int step, float low, float mid, float high) {
-    if (steps.find(pad) != steps.end() && step >= 0 && step < 16) {
-        steps[pad][step].sliceEqLow = low;
-        steps[pad][step].sliceEqMid = mid;
-        steps[pad][step].sliceEqHigh = high;
+void DrumMachine::setStepCondition(int pad, int step, const std::string& condition) {
+    if (!isValidCell(pad, step)) return;
+    if (condition.empty()) {
+        stepConditions.erase(cellIndex(pad, step));
+    } else {
+        stepConditions[cellIndex(pad, step)] = condition;
     }
 }
 
-} // namespace VR_DAW 
\ No newline at end of file
+} // namespace VR_DAW 
@@ -1,11 +1,12 @@
 #include "Sampler.hpp"
+#include "audio/processing/SilenceDetector.hpp"
 #include <spdlog/spdlog.h>
 #include <random>
 #include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
 #include <fstream>
-#include <sndfile.h>
 
 namespace VR_DAW {
 
@@ -15,6 +16,58 @@ Sampler::Sampler() {
     pitchBend = 0.0f;
     modulation = 0.0f;
     aftertouch = 0.0f;
+    frameCounter = 0;
+    randomState = 0x9E3779B9u;
+    sequenceCounters.fill(0);
+    heldVelocity.fill(0);
+    noteOnFrames.fill(0);
+
+    busDelayTime = 0.0f;
+    busDelayFeedback = 0.0f;
+    reverbTail = 0;
+    delayTail = 0;
+    delayTailFrames = 0;
+    voiceBlock.assign(kBlockSize, 0.0f);
+    reverbBus.assign(kBlockSize, 0.0f);
+    delayBus.assign(kBlockSize, 0.0f);
+
+    // Send-Effekte vorab anlegen (Freeverb-Längen bei 44.1kHz)
+    delayLine.assign(kMaxBusDelayFrames, 0.0f);
+    delayWrite = 0;
+    static constexpr size_t kCombLengths[kReverbCombs] = {1116, 1188, 1277, 1356};
+    static constexpr size_t kAllpassLengths[kReverbAllpasses] = {556, 441};
+    for (int i = 0; i < kReverbCombs; ++i) {
+        reverbCombs[i].assign(kCombLengths[i], 0.0f);
+    }
+    for (int i = 0; i < kReverbAllpasses; ++i) {
+        reverbAllpasses[i].assign(kAllpassLengths[i], 0.0f);
+    }
+    reverbCombIndex.fill(0);
+    reverbCombDamp.fill(0.0f);
+    reverbAllpassIndex.fill(0);
+    const double reverbTailSeconds = VRMusicStudio::tailFromRT60(
+        VRMusicStudio::rt60Seconds(kCombLengths[kReverbCombs - 1] / 44100.0, kReverbFeedback));
+    reverbTailFrames = static_cast<unsigned long>(reverbTailSeconds * 44100.0) + kBlockSize;
+
+    voices.resize(kMaxVoices);
+    for (auto& voice : voices) {
+        voice.sample = nullptr;
+        voice.active = false;
+        voice.streamVoice = -1;
+        voice.stretcher = -1;
+    }
+
+    VRMusicStudio::SampleStreamer::Settings streaming;
+    streaming.maxVoices = kMaxStreamVoices;
+    streamer = std::make_unique<VRMusicStudio::SampleStreamer>(streaming);
+
+    // Stretcher vorab anlegen, damit Note-On nicht allokiert
+    for (int i = 0; i < kMaxStretchVoices; ++i) {
+        auto stretcher = std::make_unique<VRMusicStudio::TimeStretcher>();
+        stretcher->prepare(VRMusicStudio::TimeStretcher::Quality::Standard);
+        stretchers.push_back(std::move(stretcher));
+        freeStretchers.push_back(kMaxStretchVoices - 1 - i);
+    }
 }
 
 Sampler::~Sampler() {
@@ -40,8 +93,13 @@ bool Sampler::initialize() {
 }
 
 void Sampler::shutdown() {
-    activeNotes.clear();
+    for (auto& voice : voices) {
+        stopVoice(voice);
+    }
+    zones.clear();
+    zoneSamples.clear();
     samples.clear();
+    rebuildKeyMap();
 }
 
 void Sampler::update() {
@@ -460,57 +518,181 @@ bool Sampler::isParameterAutomated(const std::string& name) const {
 }
 
 void Sampler::processAudio(float* buffer, unsigned long framesPerBuffer) {
-    for (unsigned long i = 0; i < framesPerBuffer; ++i) {
-        float time = static_cast<float>(i) / 44100.0f; // Sample-Rate: 44.1kHz
-        float sample = 0.0f;
-
-        // Aktive Noten verarbeiten
-        for (auto& [note, noteData] : activeNotes) {
-            if (noteData.active) {
-                auto it = samples.find(note);
-                if (it != samples.end()) {
-                    const auto& sampleData = it->second;
-                    float position = noteData.position;
-                    float processedSample = processSample(sampleData, position);
-                    
-                    // Filter anwenden
-                    float cutoff = sampleData.filterCutoff;
-                    if (sampleData.lfoDestination == "filter") {
-                        cutoff *= (1.0f + processLFO(sampleData.lfoRate, sampleData.lfoAmount, sampleData.lfoDestination, time));
-                    }
-                    processedSample = processFilter(processedSample, cutoff, sampleData.filterResonance);
-
-                    // Envelope anwenden
-                    float envelope = processEnvelope(processedSample, sampleData.envelopeAttack, sampleData.envelopeDecay, sampleData.envelopeSustain, sampleData.envelopeRelease, time);
-                    processedSample *= envelope;
-
-                    // Effekte anwenden
-                    processedSample = processReverb(processedSample, sampleData.reverbAmount);
-                    processedSample = processDelay(processedSample, sampleData.delayTime, sampleData.delayFeedback);
-                    processedSample = processCompression(processedSample, sampleData.compressionThreshold, sampleData.compressionRatio);
-                    processedSample = processEQ(processedSample, sampleData.eqLow, sampleData.eqMid, sampleData.eqHigh);
-                    processedSample = processDistortion(processedSample, sampleData.distortionAmount);
-                    processedSample = processBitCrusher(processedSample, sampleData.bitCrusherBits, sampleData.bitCrusherRate);
-                    processedSample = processGranular(processedSample, sampleData.granularGrainSize, sampleData.granularDensity, sampleData.granularPitch);
-                    processedSample = processTimeStretch(processedSample, sampleData.timeStretchRate);
-                    if (sampleData.reverse) {
-                        processedSample = processReverse(processedSample);
-                    }
-
-                    // Slices verarbeiten
-                    if (!sampleData.slicePoints.empty()) {
-                        processedSample = processSlice(sampleData, noteData.currentSlice, noteData.slicePosition);
-                    }
-
-                    sample += processedSample * noteData.amplitude;
-                    noteData.position += 1.0f / sampleData.sampleRate;
-                }
+    for (unsigned long offset = 0; offset < framesPerBuffer; offset += kBlockSize) {
+        const unsigned long frames = std::min(kBlockSize, framesPerBuffer - offset);
+        float* output = buffer + offset;
+        std::fill(output, output + frames, 0.0f);
+        std::fill_n(reverbBus.begin(), frames, 0.0f);
+        std::fill_n(delayBus.begin(), frames, 0.0f);
+
+        // Aktive Stimmen verarbeiten; Sample und Kette wurden vorab aufgelöst
+        for (auto& voice : voices) {
+            if (!voice.active) continue;
+
+            const auto& sampleData = *voice.sample;
+            const auto& chain = sampleData.chain;
+            float* block = voiceBlock.data();
+            renderVoice(voice, block, frames);
+            for (int stage = 0; stage < chain.stageCount; ++stage) {
+                runStage(chain.stages[stage], sampleData, voice, block, frames);
+            }
+
+            const float gain = voice.amplitude;
+            for (unsigned long i = 0; i < frames; ++i) {
+                output[i] += block[i] * gain;
+            }
+            if (chain.reverbSend > 0.0f) {
+                const float send = gain * chain.reverbSend;
+                for (unsigned long i = 0; i < frames; ++i) reverbBus[i] += block[i] * send;
+                reverbTail = reverbTailFrames;
+            }
+            if (chain.delaySend > 0.0f) {
+                const float send = gain * chain.delaySend;
+                for (unsigned long i = 0; i < frames; ++i) delayBus[i] += block[i] * send;
+                delayTail = delayTailFrames;
             }
         }
 
-        // In den Ausgangspuffer schreiben
-        buffer[i] = sample;
+        // Send-Effekte einmal auf der Summe, solange Fahnen ausklingen
+        if (reverbTail > 0) {
+            for (unsigned long i = 0; i < frames; ++i) {
+                output[i] += processReverb(reverbBus[i], 1.0f);
+            }
+            reverbTail -= std::min(reverbTail, frames);
+        }
+        if (delayTail > 0) {
+            for (unsigned long i = 0; i < frames; ++i) {
+                output[i] += processDelay(delayBus[i], busDelayTime, busDelayFeedback);
+            }
+            delayTail -= std::min(delayTail, frames);
+        }
+
+        frameCounter += frames;
     }
+
+    // Gelesene Frames für den Streaming-Thread freigeben
+    for (auto& noteData : voices) {
+        if (noteData.streamVoice >= 0) {
+            const double consumed = std::max(0.0, noteData.position - 1.0);
+            streamer->advance(noteData.streamVoice, static_cast<uint64_t>(consumed),
+                              static_cast<float>(noteData.increment));
+        }
+    }
+}
+
+void Sampler::renderVoice(Note& voice, float* block, unsigned long frames) {
+    const Sample& sampleData = *voice.sample;
+
+    // Residente Kopie für den Stretcher einmal pro Block; fehlt sie noch, reicht der Kopf
+    std::shared_ptr<const VRMusicStudio::StreamedSample> resident;
+    if (voice.stretcher >= 0) resident = sampleData.residentStream->load();
+    const VRMusicStudio::StreamedSample* stretchSource = resident ? resident.get() : sampleData.stream.get();
+
+    for (unsigned long i = 0; i < frames; ++i) {
+        // Endet die Stimme im Block, bleibt der Rest still
+        if (!voice.active) {
+            block[i] = 0.0f;
+        } else {
+            block[i] = voice.stretcher >= 0 ? processTimeStretch(voice, sampleData, *stretchSource)
+                                            : processSample(sampleData, voice);
+            if (voice.releaseStep > 0.0f) {
+                block[i] *= voice.releaseGain;
+                voice.releaseGain -= voice.releaseStep;
+                if (voice.releaseGain <= 0.0f) stopVoice(voice);
+            }
+        }
+    }
+}
+
+void Sampler::runStage(VoiceStage stage, const Sample& sample, const Note& voice, float* block, unsigned long frames) {
+    // Zeit seit dem Anschlag für Hüllkurve und LFO
+    const float start = static_cast<float>(frameCounter - voice.startFrame) / 44100.0f; // Sample-Rate: 44.1kHz
+    const float step = 1.0f / 44100.0f;
+
+    switch (stage) {
+    case VoiceStage::Filter:
+        if (sample.lfoTarget == LfoTarget::Filter) {
+            for (unsigned long i = 0; i < frames; ++i) {
+                const float cutoff = sample.filterCutoff * (1.0f + processLFO(sample.lfoRate, sample.lfoAmount, start + i * step));
+                block[i] = processFilter(block[i], cutoff, sample.filterResonance);
+            }
+        } else {
+            for (unsigned long i = 0; i < frames; ++i) {
+                block[i] = processFilter(block[i], sample.filterCutoff, sample.filterResonance);
+            }
+        }
+        break;
+    case VoiceStage::Envelope:
+        for (unsigned long i = 0; i < frames; ++i) {
+            block[i] *= processEnvelope(block[i], sample.envelopeAttack, sample.envelopeDecay,
+                                        sample.envelopeSustain, sample.envelopeRelease, start + i * step);
+        }
+        break;
+    case VoiceStage::Tremolo:
+        for (unsigned long i = 0; i < frames; ++i) {
+            block[i] *= 1.0f + processLFO(sample.lfoRate, sample.lfoAmount, start + i * step);
+        }
+        break;
+    case VoiceStage::Compression:
+        for (unsigned long i = 0; i < frames; ++i) {
+            block[i] = processCompression(block[i], sample.compressionThreshold, sample.compressionRatio);
+        }
+        break;
+    case VoiceStage::EQ:
+        for (unsigned long i = 0; i < frames; ++i) {
+            block[i] = processEQ(block[i], sample.eqLow, sample.eqMid, sample.eqHigh);
+        }
+        break;
+    case VoiceStage::Distortion:
+        for (unsigned long i = 0; i < frames; ++i) {
+            block[i] = processDistortion(block[i], sample.distortionAmount);
+        }
+        break;
+    case VoiceStage::Granular:
+        for (unsigned long i = 0; i < frames; ++i) {
+            block[i] = processGranular(block[i], sample.granularGrainSize, sample.granularDensity, sample.granularPitch);
+        }
+        break;
+    case VoiceStage::Reverse:
+        for (unsigned long i = 0; i < frames; ++i) {
+            block[i] = processReverse(block[i]);
+        }
+        break;
+    case VoiceStage::Slice:
+        for (unsigned long i = 0; i < frames; ++i) {
+            block[i] = processSlice(sample, voice.currentSlice, voice.slicePosition);
+        }
+        break;
+    }
+}
+
+void Sampler::compileChain(Sample& sample) {
+    // Nur Stufen mit hörbarer Wirkung, Reihenfolge wie bisher
+    auto& chain = sample.chain;
+    chain.stageCount = 0;
+    auto add = [&chain](VoiceStage stage) { chain.stages[chain.stageCount++] = stage; };
+
+    const bool lfoActive = sample.lfoAmount != 0.0f && sample.lfoRate > 0.0f;
+    if (sample.filterCutoff < 20000.0f || (lfoActive && sample.lfoTarget == LfoTarget::Filter)) {
+        add(VoiceStage::Filter);
+    }
+    add(VoiceStage::Envelope);
+    if (lfoActive && sample.lfoTarget == LfoTarget::Amplitude) add(VoiceStage::Tremolo);
+    if (sample.compressionRatio > 1.0f && sample.compressionThreshold < 0.0f) add(VoiceStage::Compression);
+    if (sample.eqLow != 0.0f || sample.eqMid != 0.0f || sample.eqHigh != 0.0f) add(VoiceStage::EQ);
+    if (sample.distortionAmount > 0.0f) add(VoiceStage::Distortion);
+    if (sample.granularGrainSize > 0.0f && sample.granularDensity > 0.0f) add(VoiceStage::Granular);
+    if (sample.reverse) add(VoiceStage::Reverse);
+    if (!sample.slicePoints.empty()) add(VoiceStage::Slice);
+
+    chain.reverbSend = std::max(0.0f, sample.reverbAmount);
+    chain.delaySend = sample.delayTime > 0.0f ? 1.0f : 0.0f;
+}
+
+Sampler::LfoTarget Sampler::parseLfoTarget(const std::string& destination) {
+    if (destination == "filter") return LfoTarget::Filter;
+    if (destination == "amplitude" || destination == "volume") return LfoTarget::Amplitude;
+    return LfoTarget::None;
 }
 
 void Sampler::processMidi(const std::vector<uint8_t>& midiData) {
@@ -528,18 +710,42 @@ void Sampler::processMidi(const std::vector<uint8_t>& midiData) {
 }
 
 void Sampler::loadSample(const std::string& path, int note) {
-    SF_INFO fileInfo;
-    SNDFILE* file = sf_open(path.c_str(), SFM_READ, &fileInfo);
-    if (!file) {
+    if (note < 0 || note > 127) return;
+
+    Sample sample{};
+    if (!createSample(path, sample)) return;
+
+    const bool replaced = samples.count(note) > 0;
+    if (replaced) stopVoices(&samples[note]);
+    samples[note] = sample;
+
+    // Einzelnes Sample pro Taste: Zone über genau diese Taste
+    if (!replaced) {
+        Zone zone;
+        zone.definition.path = path;
+        zone.definition.lowKey = note;
+        zone.definition.highKey = note;
+        zone.definition.rootKey = note;
+        zone.sample = &samples[note];
+        zone.legacyNote = note;
+        zones.push_back(zone);
+        rebuildKeyMap();
+    }
+}
+
+bool Sampler::createSample(const std::string& path, Sample& sample) {
+    // Nur der Kopf wird geladen, kurze Samples liegen komplett im Speicher
+    auto stream = streamer->open(path);
+    if (!stream) {
         spdlog::error("Konnte Sample nicht laden: {}", path);
-        return;
+        return false;
     }
 
-    Sample sample;
-    sample.data.resize(fileInfo.frames * fileInfo.channels);
-    sf_readf_float(file, sample.data.data(), fileInfo.frames);
-    sample.sampleRate = fileInfo.samplerate;
-    sample.channels = fileInfo.channels;
+    sample.stream = stream;
+    sample.residentStream = std::make_shared<VRMusicStudio::AsyncResult<VRMusicStudio::StreamedSample>>();
+    if (stream->isResident()) sample.residentStream->publish(stream);
+    sample.sampleRate = static_cast<float>(stream->sampleRate);
+    sample.channels = stream->channels;
     sample.loop = false;
     sample.loopStart = 0.0f;
     sample.loopEnd = 1.0f;
@@ -554,7 +760,7 @@ void Sampler::loadSample(const std::string& path, int note) {
     sample.envelopeRelease = 0.2f;
     sample.lfoRate = 5.0f;
     sample.lfoAmount = 0.5f;
-    sample.lfoDestination = "filter";
+    sample.lfoTarget = LfoTarget::Filter;
     sample.reverbAmount = 0.0f;
     sample.delayTime = 0.0f;
     sample.delayFeedback = 0.0f;
@@ -564,121 +770,195 @@ void Sampler::loadSample(const std::string& path, int note) {
     sample.eqMid = 0.0f;
     sample.eqHigh = 0.0f;
     sample.distortionAmount = 0.0f;
-    sample.bitCrusherBits = 16;
-    sample.bitCrusherRate = 44100.0f;
-    sample.granularGrainSize = 0.1f;
-    sample.granularDensity = 0.5f;
+    sample.granularGrainSize = 0.0f;                // aus, bis setSampleGranular es einschaltet
+    sample.granularDensity = 0.0f;
     sample.granularPitch = 0.0f;
     sample.timeStretchRate = 1.0f;
     sample.reverse = false;
-
-    samples[note] = sample;
-    sf_close(file);
+    compileChain(sample);
+    return true;
 }
 
 void Sampler::unloadSample(int note) {
-    samples.erase(note);
+    auto it = samples.find(note);
+    if (it == samples.end()) return;
+
+    stopVoices(&it->second);
+    zones.erase(std::remove_if(zones.begin(), zones.end(),
+                               [note](const Zone& zone) { return zone.legacyNote == note; }),
+                zones.end());
+    samples.erase(it);
+    rebuildKeyMap();
+}
+
+int Sampler::addZone(const ZoneDefinition& definition) {
+    Zone zone;
+    zone.definition = definition;
+    zone.legacyNote = -1;
+
+    auto& d = zone.definition;
+    d.lowKey = std::clamp(d.lowKey, 0, 127);
+    d.highKey = std::clamp(d.highKey, d.lowKey, 127);
+    d.rootKey = std::clamp(d.rootKey, 0, 127);
+    d.lowVelocity = std::clamp(d.lowVelocity, 1, 127);
+    d.highVelocity = std::clamp(d.highVelocity, d.lowVelocity, 127);
+    d.sequenceLength = std::max(1, d.sequenceLength);
+    d.sequencePosition = std::clamp(d.sequencePosition, 1, d.sequenceLength);
+    d.randomLow = std::clamp(d.randomLow, 0.0f, 1.0f);
+    d.randomHigh = std::clamp(d.randomHigh, d.randomLow, 1.0f);
+    d.releaseDecay = std::max(0.0f, d.releaseDecay);
+
+    // Mehrere Zonen teilen sich eine Datei (z. B. Velocity-Layer mit Crossfade)
+    auto it = zoneSamples.find(d.path);
+    if (it == zoneSamples.end()) {
+        Sample sample{};
+        if (!createSample(d.path, sample)) return -1;
+        it = zoneSamples.emplace(d.path, sample).first;
+    }
+    zone.sample = &it->second;
+
+    zones.push_back(zone);
+    rebuildKeyMap();
+    return static_cast<int>(zones.size()) - 1;
+}
+
+void Sampler::clearZones() {
+    for (auto& [path, sample] : zoneSamples) {
+        stopVoices(&sample);
+    }
+    zones.erase(std::remove_if(zones.begin(), zones.end(),
+                               [](const Zone& zone) { return zone.legacyNote < 0; }),
+                zones.end());
+    zoneSamples.clear();
+    rebuildKeyMap();
+}
+
+void Sampler::rebuildKeyMap() {
+    for (auto& keyZones : zonesByKey) {
+        keyZones.clear();
+    }
+    for (size_t i = 0; i < zones.size(); ++i) {
+        const auto& d = zones[i].definition;
+        for (int key = d.lowKey; key <= d.highKey; ++key) {
+            zonesByKey[key].push_back(static_cast<int>(i));
+        }
+    }
+}
+
+int Sampler::findZone(const std::string& path) const {
+    for (size_t i = 0; i < zones.size(); ++i) {
+        if (zones[i].definition.path == path) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+Sampler::Sample* Sampler::findSample(int target) {
+    // Zonen über zoneTarget(), sonst per loadSample belegte Tasten
+    if (target >= kZoneTargetBase) {
+        const size_t index = static_cast<size_t>(target - kZoneTargetBase);
+        return index < zones.size() ? zones[index].sample : nullptr;
+    }
+    auto it = samples.find(target);
+    return it != samples.end() ? &it->second : nullptr;
 }
 
 void Sampler::setSampleLoop(int note, bool loop) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.loop = loop;
+    if (Sample* sample = findSample(note)) {
+        sample->loop = loop;
     }
 }
 
 void Sampler::setSampleLoopPoints(int note, float start, float end) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.loopStart = start;
-        it->second.loopEnd = end;
+    if (Sample* sample = findSample(note)) {
+        sample->loopStart = start;
+        sample->loopEnd = end;
     }
 }
 
 void Sampler::setSamplePitch(int note, float pitch) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.pitch = pitch;
+    if (Sample* sample = findSample(note)) {
+        sample->pitch = pitch;
     }
 }
 
 void Sampler::setSampleVolume(int note, float volume) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.volume = volume;
+    if (Sample* sample = findSample(note)) {
+        sample->volume = volume;
     }
 }
 
 void Sampler::setSamplePan(int note, float pan) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.pan = pan;
+    if (Sample* sample = findSample(note)) {
+        sample->pan = pan;
     }
 }
 
 void Sampler::setSampleFilter(int note, float cutoff, float resonance) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.filterCutoff = cutoff;
-        it->second.filterResonance = resonance;
+    if (Sample* sample = findSample(note)) {
+        sample->filterCutoff = cutoff;
+        sample->filterResonance = resonance;
+        compileChain(*sample);
     }
 }
 
 void Sampler::setSampleEnvelope(int note, float attack, float decay, float sustain, float release) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.envelopeAttack = attack;
-        it->second.envelopeDecay = decay;
-        it->second.envelopeSustain = sustain;
-        it->second.envelopeRelease = release;
+    if (Sample* sample = findSample(note)) {
+        sample->envelopeAttack = attack;
+        sample->envelopeDecay = decay;
+        sample->envelopeSustain = sustain;
+        sample->envelopeRelease = release;
     }
 }
 
 void Sampler::setSampleLFO(int note, float rate, float amount, const std::string& destination) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.lfoRate = rate;
-        it->second.lfoAmount = amount;
-        it->second.lfoDestination = destination;
+    if (Sample* sample = findSample(note)) {
+        sample->lfoRate = rate;
+        sample->lfoAmount = amount;
+        sample->lfoTarget = parseLfoTarget(destination);
+        compileChain(*sample);
     }
 }
 
 void Sampler::setSampleReverb(int note, float amount) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.reverbAmount = amount;
+    if (Sample* sample = findSample(note)) {
+        sample->reverbAmount = amount;
+        compileChain(*sample);
     }
 }
 
 void Sampler::setSampleDelay(int note, float time, float feedback) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.delayTime = time;
-        it->second.delayFeedback = feedback;
+    if (Sample* sample = findSample(note)) {
+        sample->delayTime = time;
+        sample->delayFeedback = feedback;
+        busDelayTime = std::clamp(time, 0.0f, static_cast<float>(kMaxBusDelayFrames - 1) / 44100.0f);
+        busDelayFeedback = std::clamp(feedback, 0.0f, kMaxBusDelayFeedback);
+        delayTailFrames = static_cast<unsigned long>(
+            VRMusicStudio::feedbackTailSeconds(busDelayTime, busDelayFeedback) * 44100.0) + kBlockSize;
+        compileChain(*sample);
     }
 }
 
 void Sampler::setSampleCompression(int note, float threshold, float ratio) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.compressionThreshold = threshold;
-        it->second.compressionRatio = ratio;
+    if (Sample* sample = findSample(note)) {
+        sample->compressionThreshold = threshold;
+        sample->compressionRatio = ratio;
+        compileChain(*sample);
     }
 }
 
 void Sampler::setSampleEQ(int note, float low, float mid, float high) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.eqLow = low;
-        it->second.eqMid = mid;
-        it->second.eqHigh = high;
+    if (Sample* sample = findSample(note)) {
+        sample->eqLow = low;
+        sample->eqMid = mid;
+        sample->eqHigh = high;
+        compileChain(*sample);
     }
 }
 
 void Sampler::setSampleDistortion(int note, float amount) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.distortionAmount = amount;
+    if (Sample* sample = findSample(note)) {
+        sample->distortionAmount = amount;
+        compileChain(*sample);
     }
 }
 
@@ -696,179 +976,251 @@ float Sampler::processBitCrusher(float input, int bits, float rate) {
 }
 
 void Sampler::setSampleGranular(int note, float grainSize, float density, float pitch) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.granularGrainSize = grainSize;
-        it->second.granularDensity = density;
-        it->second.granularPitch = pitch;
+    if (Sample* sample = findSample(note)) {
+        sample->granularGrainSize = grainSize;
+        sample->granularDensity = density;
+        sample->granularPitch = pitch;
+        compileChain(*sample);
     }
 }
 
 void Sampler::setSampleTimeStretch(int note, float rate) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.timeStretchRate = rate;
+    if (Sample* sample = findSample(note)) {
+        sample->timeStretchRate = std::clamp(rate,
+            static_cast<float>(VRMusicStudio::TimeStretcher::kMinSpeed),
+            static_cast<float>(VRMusicStudio::TimeStretcher::kMaxSpeed));
+
+        // Der Phase-Vocoder braucht das ganze Sample im Speicher. Die Kopie wird
+        // hier geladen und atomar veröffentlicht; sample->stream bleibt unverändert,
+        // weil der Audio-Thread ihn ohne Sperre liest
+        const auto& stream = sample->stream;
+        if (std::fabs(sample->timeStretchRate - 1.0f) > 1e-3f && stream && !sample->residentStream->load()) {
+            if (auto resident = streamer->open(stream->path, true)) {
+                sample->residentStream->publish(std::move(resident));
+            }
+        }
     }
 }
 
 void Sampler::setSampleReverse(int note, bool reverse) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.reverse = reverse;
+    if (Sample* sample = findSample(note)) {
+        sample->reverse = reverse;
+        compileChain(*sample);
     }
 }
 
 void Sampler::setSampleSlice(int note, const std::vector<float>& slicePoints) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.slicePoints = slicePoints;
+    if (Sample* sample = findSample(note)) {
+        sample->slicePoints = slicePoints;
+        compileChain(*sample);
     }
 }
 
 void Sampler::setSampleSliceMode(int note, const std::string& mode) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.sliceMode = mode;
+    if (Sample* sample = findSample(note)) {
+        sample->sliceMode = mode;
     }
 }
 
 void Sampler::setSampleSliceQuantize(int note, float amount) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.sliceQuantize = amount;
+    if (Sample* sample = findSample(note)) {
+        sample->sliceQuantize = amount;
     }
 }
 
 void Sampler::setSampleSliceRandom(int note, float amount) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.sliceRandom = amount;
+    if (Sample* sample = findSample(note)) {
+        sample->sliceRandom = amount;
     }
 }
 
 void Sampler::setSampleSliceReverse(int note, bool reverse) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.sliceReverse = reverse;
+    if (Sample* sample = findSample(note)) {
+        sample->sliceReverse = reverse;
     }
 }
 
 void Sampler::setSampleSlicePitch(int note, float pitch) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.slicePitch = pitch;
+    if (Sample* sample = findSample(note)) {
+        sample->slicePitch = pitch;
     }
 }
 
 void Sampler::setSampleSliceVolume(int note, float volume) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.sliceVolume = volume;
+    if (Sample* sample = findSample(note)) {
+        sample->sliceVolume = volume;
     }
 }
 
 void Sampler::setSampleSlicePan(int note, float pan) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.slicePan = pan;
+    if (Sample* sample = findSample(note)) {
+        sample->slicePan = pan;
     }
 }
 
 void Sampler::setSampleSliceFilter(int note, float cutoff, float resonance) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.sliceFilterCutoff = cutoff;
-        it->second.sliceFilterResonance = resonance;
+    if (Sample* sample = findSample(note)) {
+        sample->sliceFilterCutoff = cutoff;
+        sample->sliceFilterResonance = resonance;
     }
 }
 
 void Sampler::setSampleSliceEnvelope(int note, float attack, float decay, float sustain, float release) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.sliceEnvelopeAttack = attack;
-        it->second.sliceEnvelopeDecay = decay;
-        it->second.sliceEnvelopeSustain = sustain;
-        it->second.sliceEnvelopeRelease = release;
+    if (Sample* sample = findSample(note)) {
+        sample->sliceEnvelopeAttack = attack;
+        sample->sliceEnvelopeDecay = decay;
+        sample->sliceEnvelopeSustain = sustain;
+        sample->sliceEnvelopeRelease = release;
     }
 }
 
 void Sampler::setSampleSliceLFO(int note, float rate, float amount, const std::string& destination) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.sliceLfoRate = rate;
-        it->second.sliceLfoAmount = amount;
-        it->second.sliceLfoDestination = destination;
+    if (Sample* sample = findSample(note)) {
+        sample->sliceLfoRate = rate;
+        sample->sliceLfoAmount = amount;
+        sample->sliceLfoDestination = destination;
     }
 }
 
 void Sampler::setSampleSliceReverb(int note, float amount) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.sliceReverbAmount = amount;
+    if (Sample* sample = findSample(note)) {
+        sample->sliceReverbAmount = amount;
     }
 }
 
 void Sampler::setSampleSliceDelay(int note, float time, float feedback) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.sliceDelayTime = time;
-        it->second.sliceDelayFeedback = feedback;
+    if (Sample* sample = findSample(note)) {
+        sample->sliceDelayTime = time;
+        sample->sliceDelayFeedback = feedback;
     }
 }
 
 void Sampler::setSampleSliceCompression(int note, float threshold, float ratio) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.sliceCompressionThreshold = threshold;
-        it->second.sliceCompressionRatio = ratio;
+    if (Sample* sample = findSample(note)) {
+        sample->sliceCompressionThreshold = threshold;
+        sample->sliceCompressionRatio = ratio;
     }
 }
 
 void Sampler::setSampleSliceEQ(int note, float low, float mid, float high) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.sliceEqLow = low;
-        it->second.sliceEqMid = mid;
-        it->second.sliceEqHigh = high;
+    if (Sample* sample = findSample(note)) {
+        sample->sliceEqLow = low;
+        sample->sliceEqMid = mid;
+        sample->sliceEqHigh = high;
     }
 }
 
 void Sampler::setSampleSliceDistortion(int note, float amount) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.sliceDistortionAmount = amount;
+    if (Sample* sample = findSample(note)) {
+        sample->sliceDistortionAmount = amount;
     }
 }
 
 void Sampler::setSampleSliceGranular(int note, float grainSize, float density, float pitch) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.sliceGranularGrainSize = grainSize;
-        it->second.sliceGranularDensity = density;
-        it->second.sliceGranularPitch = pitch;
+    if (Sample* sample = findSample(note)) {
+        sample->sliceGranularGrainSize = grainSize;
+        sample->sliceGranularDensity = density;
+        sample->sliceGranularPitch = pitch;
     }
 }
 
 void Sampler::setSampleSliceTimeStretch(int note, float rate) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.sliceTimeStretchRate = rate;
+    if (Sample* sample = findSample(note)) {
+        sample->sliceTimeStretchRate = rate;
     }
 }
 
 void Sampler::setSampleSliceReverse(int note, bool reverse) {
-    auto it = samples.find(note);
-    if (it != samples.end()) {
-        it->second.sliceReverse = reverse;
+    if (Sample* sample = findSample(note)) {
+        sample->sliceReverse = reverse;
     }
 }
 
 void Sampler::noteOn(int note, int velocity) {
-    Note newNote;
+    if (note < 0 || note > 127) return;
+    if (velocity <= 0) {
+        noteOff(note);
+        return;
+    }
+
+    // Erneuter Anschlag ersetzt die gehaltenen Stimmen dieser Taste
+    for (auto& voice : voices) {
+        if (voice.active && voice.note == note && !voice.releaseTrigger) {
+            stopVoice(voice);
+        }
+    }
+
+    heldVelocity[note] = velocity;
+    noteOnFrames[note] = frameCounter;
+    startZones(note, velocity, false, sequenceCounters[note]++, 0.0f);
+}
+
+void Sampler::noteOff(int note) {
+    if (note < 0 || note > 127) return;
+
+    for (auto& voice : voices) {
+        if (voice.active && voice.note == note && !voice.releaseTrigger) {
+            releaseVoice(voice);
+        }
+    }
+
+    // Release-Zonen mit der Velocity des Anschlags starten
+    const int velocity = heldVelocity[note];
+    if (velocity > 0) {
+        heldVelocity[note] = 0;
+        const float heldSeconds = static_cast<float>(frameCounter - noteOnFrames[note]) / 44100.0f; // Sample-Rate: 44.1kHz
+        startZones(note, velocity, true, sequenceCounters[note] - 1, heldSeconds);
+    }
+}
+
+void Sampler::startZones(int note, int velocity, bool releaseTrigger, uint32_t sequence, float heldSeconds) {
+    // Eine Zufallszahl pro Anschlag, damit sich Random-Zonen ausschließen
+    const float random = nextRandom();
+
+    for (int index : zonesByKey[note]) {
+        const Zone& zone = zones[index];
+        const auto& d = zone.definition;
+        if (d.releaseTrigger != releaseTrigger) continue;
+        if (velocity < d.lowVelocity || velocity > d.highVelocity) continue;
+        if (static_cast<int>(sequence % static_cast<uint32_t>(d.sequenceLength)) + 1 != d.sequencePosition) continue;
+        if (random < d.randomLow || random >= d.randomHigh) continue;
+
+        const float decay = releaseTrigger ? -d.releaseDecay * heldSeconds : 0.0f;
+        const float gain = crossfadeGain(d, velocity) * std::pow(10.0f, (d.volume + decay) / 20.0f);
+        if (gain > 1e-4f) {
+            startVoice(zone, note, velocity, gain, releaseTrigger);
+        }
+    }
+}
+
+void Sampler::startVoice(const Zone& zone, int note, int velocity, float gain, bool releaseTrigger) {
+    // Freie Stimme, sonst die älteste
+    Note* target = nullptr;
+    for (auto& voice : voices) {
+        if (!voice.active) {
+            target = &voice;
+            break;
+        }
+        if (!target || voice.startFrame < target->startFrame) {
+            target = &voice;
+        }
+    }
+    stopVoice(*target);
+
+    const Sample& data = *zone.sample;
+    Note& newNote = *target;
+    newNote.sample = &data;
+    newNote.releaseTrigger = releaseTrigger;
+    newNote.startFrame = frameCounter;
     newNote.note = note;
     newNote.velocity = velocity;
-    newNote.amplitude = velocity / 127.0f;
-    newNote.position = 0.0f;
+    newNote.amplitude = velocity / 127.0f * gain;
+    newNote.position = 0.0;
+    newNote.increment = 1.0;
+    newNote.loop = false;
+    newNote.loopStart = 0;
+    newNote.loopEnd = 0;
+    newNote.streamVoice = -1;
     newNote.filterEnvelope = 0.0f;
     newNote.ampEnvelope = 0.0f;
     newNote.active = true;
@@ -877,38 +1229,144 @@ void Sampler::noteOn(int note, int velocity) {
     newNote.sliceFilterEnvelope = 0.0f;
     newNote.sliceAmpEnvelope = 0.0f;
     newNote.sliceActive = false;
-    activeNotes[note] = newNote;
+    newNote.stretcher = -1;
+    newNote.releaseGain = 1.0f;
+    newNote.releaseStep = 0.0f;
+
+    if (data.stream) {
+        const auto frames = static_cast<double>(data.stream->frames);
+        const double semitones = note - zone.definition.rootKey + zone.definition.tune / 100.0 + data.pitch;
+        newNote.increment = std::pow(2.0, semitones / 12.0) * data.sampleRate / 44100.0; // Sample-Rate: 44.1kHz
+        newNote.loopStart = static_cast<uint64_t>(std::clamp(data.loopStart, 0.0f, 1.0f) * frames);
+        newNote.loopEnd = static_cast<uint64_t>(std::clamp(data.loopEnd, 0.0f, 1.0f) * frames);
+        newNote.loop = (data.loop || zone.definition.loop) && newNote.loopEnd > newNote.loopStart;
+
+        // Ohne freie Streaming-Stimme spielt nur der residente Kopf
+        if (!data.stream->isResident()) {
+            newNote.streamVoice = streamer->startVoice(data.stream, newNote.loop, newNote.loopStart, newNote.loopEnd);
+        }
+    }
+
+    // Gestretchte Samples laufen über einen eigenen Phase-Vocoder pro Stimme
+    if (std::fabs(data.timeStretchRate - 1.0f) > 1e-3f) {
+        newNote.stretcher = acquireStretcher();
+        if (newNote.stretcher >= 0) {
+            auto& stretcher = *stretchers[newNote.stretcher];
+            stretcher.setSpeed(data.timeStretchRate);
+            stretcher.reset(0.0);
+        }
+    }
 }
 
-void Sampler::noteOff(int note) {
-    auto it = activeNotes.find(note);
-    if (it != activeNotes.end()) {
-        it->second.active = false;
+void Sampler::stopVoice(Note& voice) {
+    voice.active = false;
+    releaseStretcher(voice);
+    stopStream(voice);
+}
+
+void Sampler::releaseVoice(Note& voice) {
+    // Stimme klingt mit ihrem Stretcher aus, stopVoice() folgt in renderVoice()
+    if (voice.releaseStep > 0.0f) return;
+    const float seconds = std::max(voice.sample ? voice.sample->envelopeRelease : 0.0f, kMinReleaseSeconds);
+    voice.releaseStep = 1.0f / (seconds * 44100.0f); // Sample-Rate: 44.1kHz
+}
+
+void Sampler::stopVoices(const Sample* sample) {
+    for (auto& voice : voices) {
+        if (voice.sample == sample) {
+            stopVoice(voice);
+            voice.sample = nullptr;
+        }
+    }
+}
+
+float Sampler::nextRandom() {
+    // xorshift32, allokationsfrei im Audio-Thread
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return static_cast<float>(randomState >> 8) / 16777216.0f;
+}
+
+float Sampler::crossfadeGain(const ZoneDefinition& zone, int velocity) {
+    // Gleiche Leistung: Amplitude als Wurzel der linearen Rampe
+    float gain = 1.0f;
+    if (zone.fadeInHigh > zone.fadeInLow && velocity < zone.fadeInHigh) {
+        gain *= velocity <= zone.fadeInLow ? 0.0f
+            : std::sqrt(static_cast<float>(velocity - zone.fadeInLow) / (zone.fadeInHigh - zone.fadeInLow));
+    }
+    if (zone.fadeOutHigh > zone.fadeOutLow && velocity > zone.fadeOutLow) {
+        gain *= velocity >= zone.fadeOutHigh ? 0.0f
+            : std::sqrt(static_cast<float>(zone.fadeOutHigh - velocity) / (zone.fadeOutHigh - zone.fadeOutLow));
+    }
+    return gain;
+}
+
+void Sampler::stopStream(Note& note) {
+    if (note.streamVoice >= 0) {
+        streamer->stopVoice(note.streamVoice);
+        note.streamVoice = -1;
     }
 }
 
-float Sampler::processSample(const Sample& sample, float position) {
-    if (sample.data.empty()) return 0.0f;
+int Sampler::acquireStretcher() {
+    if (freeStretchers.empty()) {
+        return -1;
+    }
+    const int index = freeStretchers.back();
+    freeStretchers.pop_back();
+    return index;
+}
 
-    // Position im Sample berechnen
-    float sampleLength = static_cast<float>(sample.data.size()) / sample.channels;
-    float normalizedPosition = position / sampleLength;
+void Sampler::releaseStretcher(Note& note) {
+    if (note.stretcher >= 0) {
+        freeStretchers.push_back(note.stretcher);
+        note.stretcher = -1;
+    }
+}
 
-    // Loop-Punkte berücksichtigen
-    if (sample.loop && normalizedPosition >= sample.loopEnd) {
-        normalizedPosition = sample.loopStart + fmod(normalizedPosition - sample.loopStart, sample.loopEnd - sample.loopStart);
+float Sampler::readFrame(const Sample& sample, const Note& note, uint64_t frame) {
+    const auto& stream = *sample.stream;
+    const int channels = stream.channels;
+    float sum = 0.0f;
+
+    if (note.streamVoice >= 0) {
+        float values[8];
+        streamer->readFrame(note.streamVoice, frame, values);
+        for (int c = 0; c < channels; ++c) sum += values[c];
+        return sum / channels;
     }
 
-    // Sample-Position berechnen
-    float samplePosition = normalizedPosition * sampleLength;
-    int index = static_cast<int>(samplePosition);
-    float fraction = samplePosition - index;
+    // Residente Daten; Loops wie beim Streaming abwickeln
+    if (note.loop && frame >= note.loopEnd) {
+        frame = note.loopStart + (frame - note.loopStart) % (note.loopEnd - note.loopStart);
+    }
+    if (frame >= stream.headFrames) return 0.0f;
+    const float* data = stream.head.data() + frame * channels;
+    for (int c = 0; c < channels; ++c) sum += data[c];
+    return sum / channels;
+}
+
+float Sampler::processSample(const Sample& sample, Note& note) {
+    if (!sample.stream || sample.stream->frames == 0) return 0.0f;
+
+    // Ohne Loop endet die Note mit dem Sample, ohne Streaming-Stimme mit dem Kopf
+    const auto& stream = *sample.stream;
+    const double end = note.streamVoice >= 0 || stream.isResident()
+        ? static_cast<double>(stream.frames) : static_cast<double>(stream.headFrames);
+    if (!note.loop && note.position >= end) {
+        note.active = false;
+        stopStream(note);
+        return 0.0f;
+    }
 
     // Lineare Interpolation
-    if (index + 1 < sample.data.size()) {
-        return sample.data[index] * (1.0f - fraction) + sample.data[index + 1] * fraction;
-    }
-    return sample.data[index];
+    const auto index = static_cast<uint64_t>(note.position);
+    const float fraction = static_cast<float>(note.position - static_cast<double>(index));
+    const float current = readFrame(sample, note, index);
+    const float next = readFrame(sample, note, index + 1);
+    note.position += note.increment;
+    return current + (next - current) * fraction;
 }
 
 float Sampler::processFilter(float input, float cutoff, float resonance) {
@@ -923,21 +1381,44 @@ float Sampler::processEnvelope(float input, float attack, float decay, float sus
     return 1.0f;
 }
 
-float Sampler::processLFO(float rate, float amount, const std::string& destination, float time) {
+float Sampler::processLFO(float rate, float amount, float time) {
     float phase = fmod(rate * time, 1.0f);
     return std::sin(2.0f * M_PI * phase) * amount;
 }
 
 float Sampler::processReverb(float input, float amount) {
-    // Hier würde die Reverb-Verarbeitung implementiert werden
-    // Dies ist eine vereinfachte Version für Demonstrationszwecke
-    return input;
+    // Parallele Kammfilter mit Tiefpass, danach Allpässe in Serie; nur Effektanteil
+    const float scaled = input * kReverbInputGain;
+    float wet = 0.0f;
+    for (int i = 0; i < kReverbCombs; ++i) {
+        auto& line = reverbCombs[i];
+        size_t& index = reverbCombIndex[i];
+        const float delayed = line[index];
+        reverbCombDamp[i] = delayed * (1.0f - kReverbDamping) + reverbCombDamp[i] * kReverbDamping;
+        line[index] = scaled + reverbCombDamp[i] * kReverbFeedback;
+        if (++index == line.size()) index = 0;
+        wet += delayed;
+    }
+    for (int i = 0; i < kReverbAllpasses; ++i) {
+        auto& line = reverbAllpasses[i];
+        size_t& index = reverbAllpassIndex[i];
+        const float delayed = line[index];
+        line[index] = wet + delayed * 0.5f;
+        if (++index == line.size()) index = 0;
+        wet = delayed - wet;
+    }
+    return wet * amount;
 }
 
 float Sampler::processDelay(float input, float time, float feedback) {
-    // Hier würde die Delay-Verarbeitung implementiert werden
-    // Dies ist eine vereinfachte Version für Demonstrationszwecke
-    return input;
+    // Rückgekoppelte Verzögerung; nur die Wiederholungen, nicht das Eingangssignal
+    const unsigned long length = delayLine.size();
+    const unsigned long delayFrames = std::clamp<unsigned long>(
+        static_cast<unsigned long>(time * 44100.0f), 1, length - 1);
+    const float delayed = delayLine[(delayWrite + length - delayFrames) % length];
+    delayLine[delayWrite] = input + delayed * feedback;
+    if (++delayWrite == length) delayWrite = 0;
+    return delayed;
 }
 
 float Sampler::processCompression(float input, float threshold, float ratio) {
@@ -964,10 +1445,25 @@ float Sampler::processGranular(float input, float grainSize, float density, floa
     return input;
 }
 
-float Sampler::processTimeStretch(float input, float rate) {
-    // Hier würde die Time-Stretch-Verarbeitung implementiert werden
-    // Dies ist eine vereinfachte Version für Demonstrationszwecke
-    return input;
+float Sampler::processTimeStretch(Note& note, const Sample& sample, const VRMusicStudio::StreamedSample& stream) {
+    const int channels = std::max(1, sample.channels);
+
+    VRMusicStudio::TimeStretcher::Source source;
+    source.data = stream.head.data();
+    source.frames = stream.headFrames;
+    source.channels = channels;
+    source.loop = sample.loop;
+
+    auto& stretcher = *stretchers[note.stretcher];
+    stretcher.setSpeed(sample.timeStretchRate);
+    const float output = stretcher.next(source);
+
+    // Ohne Loop endet die Note mit dem Sample
+    if (!sample.loop && stretcher.getSourcePosition() >= static_cast<double>(source.frames)) {
+        note.active = false;
+        releaseStretcher(note);
+    }
+    return output;
 }
 
 float Sampler::processReverse(float input) {
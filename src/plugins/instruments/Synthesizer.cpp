@@ -1,5 +1,8 @@
 #include "Synthesizer.hpp"
+#include "audio/processing/DspMath.hpp"
+#include "audio/processing/SimdOps.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
 #include <random>
 #include <sstream>
 #include <iomanip>
@@ -7,9 +10,93 @@
 
 namespace VR_DAW {
 
+namespace {
+
+using VRMusicStudio::SimdOps::Float4;
+
+constexpr float kPi = static_cast<float>(VRMusicStudio::kPi);
+
+// Exponentielle Segmente zielen über das Ende hinaus, damit sie es in der
+// eingestellten Zeit erreichen
+constexpr float kAttackRatio = 0.3f;
+constexpr float kDecayRatio = 0.0001f;
+
+constexpr float kFilterEnvOctaves = 6.0f;   // bei envelopeAmount = 1
+constexpr float kLfoFilterOctaves = 2.0f;   // bei lfo.amount = 1
+constexpr float kLfoPitchSemitones = 2.0f;
+
+struct LfoDivision {
+    const char* name;
+    float quarters;
+};
+
+constexpr LfoDivision kLfoDivisions[] = {
+    {"1/1", 4.0f}, {"1/2", 2.0f}, {"1/4", 1.0f}, {"1/8", 0.5f}, {"1/16", 0.25f},
+    {"1/4T", 2.0f / 3.0f}, {"1/8T", 1.0f / 3.0f}, {"1/4D", 1.5f}, {"1/8D", 0.75f}
+};
+
+inline float wrapUnit(float phase) {
+    return phase - std::floor(phase);
+}
+
+// Phase in [0, 1); Schrittweiten sind kleiner als eins
+inline Float4 wrapPhase(Float4 phase) {
+    return phase - trunc(phase);
+}
+
+// sin(2 pi p) = sin(2 pi (0.5 - p)): Parabel mit einer Korrekturstufe,
+// Fehler unter 0.1 %
+inline Float4 sineWave(Float4 phase) {
+    const Float4 y = Float4::set1(0.5f) - phase;
+    Float4 s = Float4::set1(8.0f) * y - Float4::set1(16.0f) * y * abs(y);
+    return s + Float4::set1(0.225f) * (s * abs(s) - s);
+}
+
+inline Float4 squareWave(Float4 phase) {
+    return Float4::set1(1.0f) - Float4::set1(2.0f) * trunc(phase + phase);
+}
+
+inline Float4 sawWave(Float4 phase) {
+    return phase + phase - Float4::set1(1.0f);
+}
+
+inline Float4 triangleWave(Float4 phase) {
+    return Float4::set1(1.0f) - Float4::set1(4.0f) * abs(phase - Float4::set1(0.5f));
+}
+
+// Ein TPT-Tiefpass erster Ordnung der Ladder-Kaskade
+inline void ladderStage(Float4& x, Float4& state, Float4 G) {
+    const Float4 v = (x - state) * G;
+    x = v + state;
+    state = x + v;
+}
+
+// Ein Oszillator für vier Stimmen über einen Steuerschritt
+template <typename Wave>
+inline Float4 runOscillator(Float4 phase, Float4 step, Float4 level,
+                            Float4* output, unsigned long frames, Wave wave) {
+    for (unsigned long n = 0; n < frames; ++n) {
+        phase = wrapPhase(phase + step);
+        output[n] += wave(phase) * level;
+    }
+    return phase;
+}
+
+} // namespace
+
 Synthesizer::Synthesizer()
     : ampEnvelope{0.01f, 0.1f, 0.7f, 0.2f}
     , filterEnvelope{0.01f, 0.1f, 0.7f, 0.2f}
+    , voices()
+    , activeVoiceCount(0)
+    , noteCounter(0)
+    , voiceStealing(VoiceStealing::Oldest)
+    , maxPolyphony(kMaxVoices)
+    , unisonVoices(1)
+    , unisonDetune(20.0f)
+    , pitchBend(1.0f)
+    , tempo(120.0f)
+    , controlRemaining(0)
 {
     generateId();
     name = "Synthesizer";
@@ -42,7 +129,11 @@ bool Synthesizer::initialize() {
 }
 
 void Synthesizer::shutdown() {
-    activeNotes.clear();
+    for (int v = 0; v < kMaxVoices; ++v) {
+        if (voices.stage[v] != EnvelopeStage::Idle) {
+            freeVoice(v);
+        }
+    }
 }
 
 void Synthesizer::update() {
@@ -51,20 +142,22 @@ void Synthesizer::update() {
 
 void Synthesizer::initializeOscillators() {
     // Drei Oszillatoren initialisieren
-    oscillators.resize(3);
+    oscillators.resize(kNumOscillators);
     for (auto& osc : oscillators) {
         osc.waveform = "sine";
+        osc.shape = Waveform::Sine;
         osc.frequency = 440.0f;
         osc.detune = 0.0f;
         osc.mix = 1.0f;
-        osc.phase = 0.0f;
     }
 }
 
 void Synthesizer::initializeFilter() {
     filter.type = "lowpass";
+    filter.mode = FilterMode::Lowpass;
     filter.cutoff = 1000.0f;
     filter.resonance = 0.7f;
+    filter.keyTracking = 0.5f;
     filter.envelopeAmount = 0.5f;
     filter.envelopeAttack = 0.01f;
     filter.envelopeDecay = 0.1f;
@@ -73,7 +166,8 @@ void Synthesizer::initializeFilter() {
 }
 
 void Synthesizer::initializeEnvelopes() {
-    // Envelopes sind bereits im Konstruktor initialisiert
+    // Zeiten sind bereits im Konstruktor bzw. in initializeFilter() gesetzt
+    updateEnvelopeRates();
 }
 
 void Synthesizer::initializeLFO() {
@@ -82,6 +176,11 @@ void Synthesizer::initializeLFO() {
     lfo.waveform = "sine";
     lfo.destination = "filter";
     lfo.phase = 0.0f;
+    lfo.shape = Waveform::Sine;
+    lfo.target = LfoDestination::Filter;
+    lfo.sync = false;
+    lfo.division = 1.0f;
+    lfo.retrigger = false;
 }
 
 std::vector<PluginParameter> Synthesizer::getParameters() const {
@@ -153,9 +252,9 @@ std::vector<PluginParameter> Synthesizer::getParameters() const {
         0.0f,
         0.0f,
         0.0f,
-        {"lowpass", "highpass", "bandpass", "notch"},
+        {"lowpass", "highpass", "bandpass", "notch", "ladder"},
         false,
-        [this](float value) { setFilterType({"lowpass", "highpass", "bandpass", "notch"}[static_cast<int>(value)]); }
+        [this](float value) { setFilterType({"lowpass", "highpass", "bandpass", "notch", "ladder"}[static_cast<int>(value)]); }
     });
 
     parameters.push_back({
@@ -182,6 +281,78 @@ std::vector<PluginParameter> Synthesizer::getParameters() const {
         [this](float value) { setFilterResonance(value); }
     });
 
+    parameters.push_back({
+        "filter_keytrack",
+        "Filter Key Tracking",
+        PluginParameter::Type::Float,
+        0.0f,
+        1.0f,
+        0.5f,
+        {},
+        false,
+        [this](float value) { setFilterKeyTracking(value); }
+    });
+
+    parameters.push_back({
+        "filter_env_amount",
+        "Filter Envelope Amount",
+        PluginParameter::Type::Float,
+        -1.0f,
+        1.0f,
+        0.5f,
+        {},
+        false,
+        [this](float value) { setFilterEnvelopeAmount(value); }
+    });
+
+    parameters.push_back({
+        "filter_attack",
+        "Filter Attack",
+        PluginParameter::Type::Float,
+        0.001f,
+        10.0f,
+        0.01f,
+        {},
+        false,
+        [this](float value) { setFilterEnvelopeAttack(value); }
+    });
+
+    parameters.push_back({
+        "filter_decay",
+        "Filter Decay",
+        PluginParameter::Type::Float,
+        0.001f,
+        10.0f,
+        0.1f,
+        {},
+        false,
+        [this](float value) { setFilterEnvelopeDecay(value); }
+    });
+
+    parameters.push_back({
+        "filter_sustain",
+        "Filter Sustain",
+        PluginParameter::Type::Float,
+        0.0f,
+        1.0f,
+        0.7f,
+        {},
+        false,
+        [this](float value) { setFilterEnvelopeSustain(value); }
+    });
+
+    parameters.push_back({
+        "filter_release",
+        "Filter Release",
+        PluginParameter::Type::Float,
+        0.001f,
+        10.0f,
+        0.2f,
+        {},
+        false,
+        [this](float value) { setFilterEnvelopeRelease(value); }
+    });
+
     // Envelope-Parameter
     parameters.push_back({
         "amp_attack",
@@ -280,6 +451,91 @@ std::vector<PluginParameter> Synthesizer::getParameters() const {
         [this](float value) { setLfoDestination({"filter", "amplitude", "pitch"}[static_cast<int>(value)]); }
     });
 
+    parameters.push_back({
+        "lfo_sync",
+        "LFO Tempo Sync",
+        PluginParameter::Type::Bool,
+        0.0f,
+        1.0f,
+        0.0f,
+        {},
+        false,
+        [this](float value) { setLfoSync(value >= 0.5f); }
+    });
+
+    parameters.push_back({
+        "lfo_division",
+        "LFO Division",
+        PluginParameter::Type::Choice,
+        0.0f,
+        8.0f,
+        2.0f,
+        {"1/1", "1/2", "1/4", "1/8", "1/16", "1/4T", "1/8T", "1/4D", "1/8D"},
+        false,
+        [this](float value) { setLfoDivision(kLfoDivisions[static_cast<int>(value)].name); }
+    });
+
+    parameters.push_back({
+        "lfo_retrigger",
+        "LFO Retrigger",
+        PluginParameter::Type::Bool,
+        0.0f,
+        1.0f,
+        0.0f,
+        {},
+        false,
+        [this](float value) { setLfoRetrigger(value >= 0.5f); }
+    });
+
+    // Stimmen-Parameter
+    parameters.push_back({
+        "voice_stealing",
+        "Voice Stealing",
+        PluginParameter::Type::Choice,
+        0.0f,
+        2.0f,
+        0.0f,
+        {"oldest", "quietest", "same_note"},
+        false,
+        [this](float value) { setVoiceStealing(static_cast<VoiceStealing>(static_cast<int>(value))); }
+    });
+
+    parameters.push_back({
+        "polyphony",
+        "Polyphony",
+        PluginParameter::Type::Int,
+        1.0f,
+        static_cast<float>(kMaxVoices),
+        static_cast<float>(kMaxVoices),
+        {},
+        false,
+        [this](float value) { setMaxPolyphony(static_cast<int>(value)); }
+    });
+
+    parameters.push_back({
+        "unison_voices",
+        "Unison Voices",
+        PluginParameter::Type::Int,
+        1.0f,
+        static_cast<float>(kMaxUnison),
+        1.0f,
+        {},
+        false,
+        [this](float value) { setUnisonVoices(static_cast<int>(value)); }
+    });
+
+    parameters.push_back({
+        "unison_detune",
+        "Unison Detune",
+        PluginParameter::Type::Float,
+        0.0f,
+        100.0f,
+        20.0f,
+        {},
+        false,
+        [this](float value) { setUnisonDetune(value); }
+    });
+
     return parameters;
 }
 
@@ -309,31 +565,17 @@ bool Synthesizer::isParameterAutomated(const std::string& name) const {
 }
 
 void Synthesizer::processAudio(float* buffer, unsigned long framesPerBuffer) {
-    for (unsigned long i = 0; i < framesPerBuffer; ++i) {
-        float time = static_cast<float>(i) / 44100.0f; // Sample-Rate: 44.1kHz
-        float sample = 0.0f;
-
-        // Oszillatoren verarbeiten
-        for (const auto& osc : oscillators) {
-            sample += processOscillator(osc, time) * osc.mix;
-        }
-
-        // Filter anwenden
-        float cutoff = filter.cutoff;
-        if (lfo.destination == "filter") {
-            cutoff *= (1.0f + processLFO(time) * lfo.amount);
-        }
-        sample = processFilter(sample, cutoff, filter.resonance);
-
-        // Amplitude anwenden
-        float amplitude = 1.0f;
-        if (lfo.destination == "amplitude") {
-            amplitude *= (1.0f + processLFO(time) * lfo.amount);
+    // Steuerschritte laufen über Puffergrenzen hinweg weiter
+    unsigned long offset = 0;
+    while (offset < framesPerBuffer) {
+        if (controlRemaining == 0) {
+            updateModulation();
+            controlRemaining = kControlRate;
         }
-        sample *= amplitude;
-
-        // In den Ausgangspuffer schreiben
-        buffer[i] = sample;
+        const unsigned long frames = std::min(controlRemaining, framesPerBuffer - offset);
+        renderVoices(buffer + offset, frames);
+        offset += frames;
+        controlRemaining -= frames;
     }
 }
 
@@ -348,29 +590,53 @@ void Synthesizer::processMidi(const std::vector<uint8_t>& midiData) {
         noteOn(note, velocity);
     } else if ((status & 0xF0) == 0x80) { // Note Off
         noteOff(note);
+    } else if ((status & 0xF0) == 0xE0 && midiData.size() > 2) { // Pitch Bend
+        const int value = (static_cast<int>(midiData[2]) << 7) | midiData[1];
+        setPitchBend((value - 8192) / 8192.0f);
+    } else if ((status & 0xF0) == 0xB0 && note == 123) { // All Notes Off
+        allNotesOff();
     }
 }
 
 void Synthesizer::noteOn(int note, int velocity) {
-    Note newNote;
-    newNote.note = note;
-    newNote.velocity = velocity;
-    newNote.amplitude = velocity / 127.0f;
-    newNote.filterEnvelope = 0.0f;
-    newNote.ampEnvelope = 0.0f;
-    newNote.active = true;
-    activeNotes[note] = newNote;
+    if (velocity <= 0) {
+        noteOff(note);
+        return;
+    }
+
+    // Alle Unison-Stimmen einer Note tragen denselben Zähler und stehlen
+    // sich daher nicht gegenseitig
+    ++noteCounter;
+    for (int i = 0; i < unisonVoices; ++i) {
+        const int voice = allocateVoice(note);
+        if (voice < 0) {
+            break;
+        }
+        startVoice(voice, note, velocity, i);
+    }
 }
 
 void Synthesizer::noteOff(int note) {
-    auto it = activeNotes.find(note);
-    if (it != activeNotes.end()) {
-        it->second.active = false;
+    for (int v = 0; v < kMaxVoices; ++v) {
+        if (voices.note[v] == note && voices.stage[v] != EnvelopeStage::Idle &&
+            voices.stage[v] != EnvelopeStage::Release) {
+            releaseVoice(v);
+        }
+    }
+}
+
+void Synthesizer::allNotesOff() {
+    for (int v = 0; v < kMaxVoices; ++v) {
+        if (voices.stage[v] != EnvelopeStage::Idle && voices.stage[v] != EnvelopeStage::Release) {
+            releaseVoice(v);
+        }
     }
 }
 
 void Synthesizer::setPitchBend(float value) {
-    // Hier würde der Pitch-Bend-Wert verarbeitet werden
+    // +-2 Halbtöne
+    value = std::max(-1.0f, std::min(1.0f, value));
+    pitchBend = std::pow(2.0f, value * 2.0f / 12.0f);
 }
 
 void Synthesizer::setModulation(float value) {
@@ -381,55 +647,399 @@ void Synthesizer::setAftertouch(float value) {
     // Hier würde der Aftertouch-Wert verarbeitet werden
 }
 
-float Synthesizer::processOscillator(const Oscillator& osc, float time) {
-    float frequency = osc.frequency * (1.0f + osc.detune / 100.0f);
-    float phase = osc.phase + frequency * time;
-    osc.phase = fmod(phase, 1.0f);
+int Synthesizer::allocateVoice(int note) {
+    auto isCurrent = [this](int v) { return voices.started[v] == noteCounter; };
 
-    if (osc.waveform == "sine") {
-        return std::sin(2.0f * M_PI * phase);
-    } else if (osc.waveform == "square") {
-        return phase < 0.5f ? 1.0f : -1.0f;
-    } else if (osc.waveform == "saw") {
-        return 2.0f * phase - 1.0f;
-    } else if (osc.waveform == "triangle") {
-        return phase < 0.5f ? 4.0f * phase - 1.0f : 3.0f - 4.0f * phase;
+    if (voiceStealing == VoiceStealing::SameNote) {
+        for (int v = 0; v < kMaxVoices; ++v) {
+            if (voices.stage[v] != EnvelopeStage::Idle && voices.note[v] == note && !isCurrent(v)) {
+                return v;
+            }
+        }
     }
-    return 0.0f;
+
+    // Freie Stimme mit kleinstem Index, damit die Gruppen dicht belegt bleiben
+    if (activeVoiceCount < maxPolyphony) {
+        for (int v = 0; v < kMaxVoices; ++v) {
+            if (voices.stage[v] == EnvelopeStage::Idle) {
+                return v;
+            }
+        }
+    }
+
+    // Stehlen: losgelassene Stimmen vor gehaltenen, dann nach Strategie
+    int best = -1;
+    for (int v = 0; v < kMaxVoices; ++v) {
+        if (voices.stage[v] == EnvelopeStage::Idle || isCurrent(v)) {
+            continue;
+        }
+        if (best < 0) {
+            best = v;
+            continue;
+        }
+        const bool released = voices.stage[v] == EnvelopeStage::Release;
+        const bool bestReleased = voices.stage[best] == EnvelopeStage::Release;
+        if (released != bestReleased) {
+            if (released) {
+                best = v;
+            }
+            continue;
+        }
+        if (voiceStealing == VoiceStealing::Quietest) {
+            if (voices.envLevel[v] < voices.envLevel[best]) {
+                best = v;
+            }
+        } else if (voices.started[v] < voices.started[best]) {
+            best = v;
+        }
+    }
+    return best;
 }
 
-float Synthesizer::processFilter(float input, float cutoff, float resonance) {
-    // Hier würde die Filter-Verarbeitung implementiert werden
-    // Dies ist eine vereinfachte Version für Demonstrationszwecke
-    return input;
+void Synthesizer::startVoice(int voice, int note, int velocity, int unisonIndex) {
+    const bool wasIdle = voices.stage[voice] == EnvelopeStage::Idle;
+    if (wasIdle) {
+        ++activeVoiceCount;
+        ++voices.groupVoices[voice / kLanes];
+        voices.envLevel[voice] = 0.0f;
+        voices.filterEnvLevel[voice] = 0.0f;
+        voices.amp[voice] = 0.0f;
+        voices.pitchMod[voice] = 1.0f;
+        voices.lfoPhase[voice] = lfo.phase;
+        // Unison-Stimmen mit versetzter Startphase, sonst Phase 0
+        for (int o = 0; o < kNumOscillators; ++o) {
+            const float offset = unisonIndex * 0.618034f + o * 0.25f;
+            voices.phase[o][voice] = unisonVoices > 1 ? offset - std::floor(offset) : 0.0f;
+        }
+        for (int i = 0; i < 4; ++i) {
+            voices.filterState[i][voice] = 0.0f;
+        }
+    }
+    // Eine gestohlene Stimme behält Phase, Pegel und Filterzustand und läuft
+    // ab da neu an
+
+    float detune = 0.0f;
+    if (unisonVoices > 1) {
+        detune = (static_cast<float>(unisonIndex) / (unisonVoices - 1) - 0.5f) * unisonDetune;
+    }
+    const float frequency = 440.0f * std::pow(2.0f, (note - 69 + detune / 100.0f) / 12.0f);
+
+    voices.note[voice] = note;
+    voices.started[voice] = noteCounter;
+    voices.increment[voice] = frequency / kSampleRate;
+    voices.gain[voice] = velocity / 127.0f / std::sqrt(static_cast<float>(unisonVoices));
+    voices.ampDelta[voice] = 0.0f;
+    voices.stage[voice] = EnvelopeStage::Attack;
+    voices.filterStage[voice] = EnvelopeStage::Attack;
+    if (lfo.retrigger) {
+        voices.lfoPhase[voice] = 0.0f;
+    }
+
+    // Filter bis zum nächsten Steuerschritt auf die neue Note setzen
+    float coefficients[3];
+    computeFilterCoefficients(voice, processLFO(voices.lfoPhase[voice]), coefficients);
+    for (int i = 0; i < 3; ++i) {
+        voices.coef[i][voice] = coefficients[i];
+        voices.coefDelta[i][voice] = 0.0f;
+    }
 }
 
-float Synthesizer::processEnvelope(const Envelope& env, float time, bool noteOn) {
-    // Hier würde die Envelope-Verarbeitung implementiert werden
-    // Dies ist eine vereinfachte Version für Demonstrationszwecke
-    return 1.0f;
+void Synthesizer::releaseVoice(int voice) {
+    voices.stage[voice] = EnvelopeStage::Release;
+    voices.filterStage[voice] = EnvelopeStage::Release;
 }
 
-float Synthesizer::processLFO(float time) {
-    float phase = fmod(lfo.phase + lfo.rate * time, 1.0f);
-    lfo.phase = phase;
+void Synthesizer::freeVoice(int voice) {
+    voices.stage[voice] = EnvelopeStage::Idle;
+    voices.filterStage[voice] = EnvelopeStage::Idle;
+    voices.gain[voice] = 0.0f;
+    voices.envLevel[voice] = 0.0f;
+    voices.amp[voice] = 0.0f;
+    voices.ampDelta[voice] = 0.0f;
+    for (int i = 0; i < 3; ++i) {
+        voices.coef[i][voice] = 0.0f;
+        voices.coefDelta[i][voice] = 0.0f;
+    }
+    for (int i = 0; i < 4; ++i) {
+        voices.filterState[i][voice] = 0.0f;
+    }
+    --activeVoiceCount;
+    --voices.groupVoices[voice / kLanes];
+}
 
-    if (lfo.waveform == "sine") {
-        return std::sin(2.0f * M_PI * phase);
-    } else if (lfo.waveform == "square") {
-        return phase < 0.5f ? 1.0f : -1.0f;
-    } else if (lfo.waveform == "saw") {
-        return 2.0f * phase - 1.0f;
-    } else if (lfo.waveform == "triangle") {
-        return phase < 0.5f ? 4.0f * phase - 1.0f : 3.0f - 4.0f * phase;
+void Synthesizer::updateEnvelopeRates() {
+    // Faktor für kControlRate Frames; exp/log nur bei Parameteränderungen
+    auto coefficient = [](float time, float ratio) {
+        const float frames = std::max(time, 0.001f) * kSampleRate;
+        return std::exp(-std::log((1.0f + ratio) / ratio) * kControlRate / frames);
+    };
+
+    ampRates.attackTarget = 1.0f + kAttackRatio;
+    ampRates.attackCoef = coefficient(ampEnvelope.attack, kAttackRatio);
+    ampRates.decayCoef = coefficient(ampEnvelope.decay, kDecayRatio);
+    ampRates.releaseCoef = coefficient(ampEnvelope.release, kDecayRatio);
+
+    filterRates.attackTarget = 1.0f + kAttackRatio;
+    filterRates.attackCoef = coefficient(filter.envelopeAttack, kAttackRatio);
+    filterRates.decayCoef = coefficient(filter.envelopeDecay, kDecayRatio);
+    filterRates.releaseCoef = coefficient(filter.envelopeRelease, kDecayRatio);
+}
+
+float Synthesizer::processEnvelope(float level, EnvelopeStage& stage, const EnvelopeRates& rates, float sustain) const {
+    switch (stage) {
+        case EnvelopeStage::Idle:
+            return 0.0f;
+        case EnvelopeStage::Attack:
+            level = rates.attackTarget + (level - rates.attackTarget) * rates.attackCoef;
+            if (level >= 1.0f) {
+                level = 1.0f;
+                stage = EnvelopeStage::Decay;
+            }
+            return level;
+        case EnvelopeStage::Decay: {
+            const float target = sustain - kDecayRatio * (1.0f - sustain);
+            level = target + (level - target) * rates.decayCoef;
+            if (level <= sustain) {
+                level = sustain;
+                stage = EnvelopeStage::Sustain;
+            }
+            return level;
+        }
+        case EnvelopeStage::Sustain:
+            return sustain;
+        case EnvelopeStage::Release:
+            level = -kDecayRatio + (level + kDecayRatio) * rates.releaseCoef;
+            return std::max(0.0f, level);
+    }
+    return level;
+}
+
+float Synthesizer::processLFO(float phase) const {
+    switch (lfo.shape) {
+        case Waveform::Sine:
+            return std::sin(2.0f * kPi * phase);
+        case Waveform::Square:
+            return phase < 0.5f ? 1.0f : -1.0f;
+        case Waveform::Saw:
+            return 2.0f * phase - 1.0f;
+        case Waveform::Triangle:
+            return phase < 0.5f ? 4.0f * phase - 1.0f : 3.0f - 4.0f * phase;
     }
     return 0.0f;
 }
 
+void Synthesizer::computeFilterCoefficients(int voice, float lfoValue, float* coefficients) const {
+    // Key Tracking um C4, Filter-Hüllkurve und LFO in Oktaven
+    float octaves = (voices.note[voice] - 60) / 12.0f * filter.keyTracking
+                  + voices.filterEnvLevel[voice] * filter.envelopeAmount * kFilterEnvOctaves;
+    if (lfo.target == LfoDestination::Filter) {
+        octaves += lfoValue * lfo.amount * kLfoFilterOctaves;
+    }
+    const float cutoff = std::max(20.0f, std::min(0.45f * kSampleRate, filter.cutoff * std::exp2(octaves)));
+    const float g = std::tan(kPi * cutoff / kSampleRate);
+    const float resonance = std::max(0.0f, std::min(1.0f, filter.resonance));
+
+    if (filter.mode == FilterMode::Ladder) {
+        // Rückkopplung bis knapp unter die Selbstoszillation (k = 4)
+        const float G = g / (1.0f + g);
+        const float G2 = G * G;
+        coefficients[0] = G;
+        coefficients[1] = 1.0f / (1.0f + 3.9f * resonance * G2 * G2);
+        coefficients[2] = 0.0f;
+    } else {
+        // SVF nach Zavalishin/Simper, k = 1 / Q
+        const float k = 2.0f - 1.96f * resonance;
+        const float a1 = 1.0f / (1.0f + g * (g + k));
+        coefficients[0] = a1;
+        coefficients[1] = g * a1;
+        coefficients[2] = g * g * a1;
+    }
+}
+
+void Synthesizer::updateModulation() {
+    const float lfoRate = lfo.sync ? tempo / 60.0f / lfo.division : lfo.rate;
+    const float lfoStep = lfoRate * kControlRate / kSampleRate;
+    lfo.phase = wrapUnit(lfo.phase + lfoStep);
+
+    for (int g = 0; g < kGroups; ++g) {
+        if (voices.groupVoices[g] == 0) {
+            continue;
+        }
+        for (int v = g * kLanes; v < (g + 1) * kLanes; ++v) {
+            if (voices.stage[v] == EnvelopeStage::Idle) {
+                continue;
+            }
+            // Ausgeklungen: der letzte Schritt hat auf 0 interpoliert
+            if (voices.stage[v] == EnvelopeStage::Release && voices.envLevel[v] <= 0.0f) {
+                freeVoice(v);
+                continue;
+            }
+
+            voices.envLevel[v] = processEnvelope(voices.envLevel[v], voices.stage[v], ampRates, ampEnvelope.sustain);
+            voices.filterEnvLevel[v] = processEnvelope(voices.filterEnvLevel[v], voices.filterStage[v],
+                                                       filterRates, filter.envelopeSustain);
+            voices.lfoPhase[v] = wrapUnit(voices.lfoPhase[v] + lfoStep);
+            const float lfoValue = processLFO(voices.lfoPhase[v]);
+
+            float amp = voices.envLevel[v] * voices.gain[v];
+            if (lfo.target == LfoDestination::Amplitude) {
+                amp *= std::max(0.0f, 1.0f + lfoValue * lfo.amount);
+            }
+            voices.ampDelta[v] = (amp - voices.amp[v]) / kControlRate;
+
+            voices.pitchMod[v] = 1.0f;
+            if (lfo.target == LfoDestination::Pitch) {
+                voices.pitchMod[v] = std::exp2(lfoValue * lfo.amount * kLfoPitchSemitones / 12.0f);
+            }
+
+            float coefficients[3];
+            computeFilterCoefficients(v, lfoValue, coefficients);
+            for (int i = 0; i < 3; ++i) {
+                voices.coefDelta[i][v] = (coefficients[i] - voices.coef[i][v]) / kControlRate;
+            }
+        }
+    }
+}
+
+void Synthesizer::renderVoices(float* output, unsigned long frames) {
+    Float4 mix[kControlRate];
+    Float4 voiceOutput[kControlRate];
+    for (unsigned long n = 0; n < frames; ++n) {
+        mix[n] = Float4::zero();
+    }
+
+    // Oszillator-Verhältnisse gelten für alle Stimmen; die Oszillatoren teilen
+    // sich die Aussteuerung
+    float ratio[kNumOscillators];
+    for (int o = 0; o < kNumOscillators; ++o) {
+        const auto& osc = oscillators[o];
+        ratio[o] = osc.frequency / 440.0f * (1.0f + osc.detune / 100.0f) * pitchBend;
+    }
+    const Float4 maxStep = Float4::set1(0.5f);
+
+    // SVF-Ausgang als Mischung aus Eingang (v0), Bandpass (v1) und Tiefpass (v2)
+    const float resonance = std::max(0.0f, std::min(1.0f, filter.resonance));
+    const float k = 2.0f - 1.96f * resonance;
+    float outputMix[3] = {0.0f, 0.0f, 1.0f};
+    switch (filter.mode) {
+        case FilterMode::Highpass: outputMix[0] = 1.0f; outputMix[1] = -k; outputMix[2] = -1.0f; break;
+        case FilterMode::Bandpass: outputMix[1] = 1.0f; outputMix[2] = 0.0f; break;
+        case FilterMode::Notch:    outputMix[0] = 1.0f; outputMix[1] = -k; outputMix[2] = 0.0f; break;
+        default: break;
+    }
+    const Float4 m0 = Float4::set1(outputMix[0]);
+    const Float4 m1 = Float4::set1(outputMix[1]);
+    const Float4 m2 = Float4::set1(outputMix[2]);
+    const Float4 two = Float4::set1(2.0f);
+    const Float4 one = Float4::set1(1.0f);
+    // Ladder: Rückkopplung und Ausgleich des Pegelverlusts im Durchlassbereich
+    const Float4 feedback = Float4::set1(3.9f * resonance);
+    const Float4 ladderGain = Float4::set1(1.0f + 3.9f * resonance);
+
+    for (int g = 0; g < kGroups; ++g) {
+        if (voices.groupVoices[g] == 0) {
+            continue;
+        }
+        const int base = g * kLanes;
+        const Float4 increment = Float4::load(voices.increment + base) * Float4::load(voices.pitchMod + base);
+        for (unsigned long n = 0; n < frames; ++n) {
+            voiceOutput[n] = Float4::zero();
+        }
+
+        for (int o = 0; o < kNumOscillators; ++o) {
+            const auto& osc = oscillators[o];
+            if (osc.mix == 0.0f) {
+                continue;
+            }
+            const Float4 step = min(increment * Float4::set1(ratio[o]), maxStep);
+            const Float4 level = Float4::set1(osc.mix / kNumOscillators);
+            Float4 phase = Float4::load(voices.phase[o] + base);
+            switch (osc.shape) {
+                case Waveform::Sine:
+                    phase = runOscillator(phase, step, level, voiceOutput, frames, sineWave);
+                    break;
+                case Waveform::Square:
+                    phase = runOscillator(phase, step, level, voiceOutput, frames, squareWave);
+                    break;
+                case Waveform::Saw:
+                    phase = runOscillator(phase, step, level, voiceOutput, frames, sawWave);
+                    break;
+                case Waveform::Triangle:
+                    phase = runOscillator(phase, step, level, voiceOutput, frames, triangleWave);
+                    break;
+            }
+            phase.store(voices.phase[o] + base);
+        }
+
+        // Filter und Amplitude; Koeffizienten und Pegel laufen linear auf die
+        // Werte des Steuerschritts zu. Freie Lanes haben Koeffizienten und Pegel 0.
+        Float4 c0 = Float4::load(voices.coef[0] + base);
+        Float4 c1 = Float4::load(voices.coef[1] + base);
+        Float4 c2 = Float4::load(voices.coef[2] + base);
+        const Float4 d0 = Float4::load(voices.coefDelta[0] + base);
+        const Float4 d1 = Float4::load(voices.coefDelta[1] + base);
+        const Float4 d2 = Float4::load(voices.coefDelta[2] + base);
+        Float4 amp = Float4::load(voices.amp + base);
+        const Float4 ampDelta = Float4::load(voices.ampDelta + base);
+        Float4 s1 = Float4::load(voices.filterState[0] + base);
+        Float4 s2 = Float4::load(voices.filterState[1] + base);
+        Float4 s3 = Float4::load(voices.filterState[2] + base);
+        Float4 s4 = Float4::load(voices.filterState[3] + base);
+
+        if (filter.mode == FilterMode::Ladder) {
+            // c0 = G, c1 = 1 / (1 + k G^4); Rückkopplung ohne Verzögerung gelöst
+            for (unsigned long n = 0; n < frames; ++n) {
+                c0 += d0;
+                c1 += d1;
+                amp += ampDelta;
+                const Float4 G = c0;
+                const Float4 G2 = G * G;
+                const Float4 sum = (one - G) * (G * (G * (G * s1 + s2) + s3) + s4);
+                const Float4 input = voiceOutput[n] * ladderGain;
+                Float4 x = input - feedback * ((G2 * G2 * input + sum) * c1);
+                ladderStage(x, s1, G);
+                ladderStage(x, s2, G);
+                ladderStage(x, s3, G);
+                ladderStage(x, s4, G);
+                mix[n] += x * amp;
+            }
+        } else {
+            // s1/s2 = ic1eq/ic2eq, c0..c2 = a1..a3
+            for (unsigned long n = 0; n < frames; ++n) {
+                c0 += d0;
+                c1 += d1;
+                c2 += d2;
+                amp += ampDelta;
+                const Float4 v0 = voiceOutput[n];
+                const Float4 v3 = v0 - s2;
+                const Float4 v1 = c0 * s1 + c1 * v3;
+                const Float4 v2 = s2 + c1 * s1 + c2 * v3;
+                s1 = two * v1 - s1;
+                s2 = two * v2 - s2;
+                mix[n] += (m0 * v0 + m1 * v1 + m2 * v2) * amp;
+            }
+        }
+
+        c0.store(voices.coef[0] + base);
+        c1.store(voices.coef[1] + base);
+        c2.store(voices.coef[2] + base);
+        amp.store(voices.amp + base);
+        s1.store(voices.filterState[0] + base);
+        s2.store(voices.filterState[1] + base);
+        s3.store(voices.filterState[2] + base);
+        s4.store(voices.filterState[3] + base);
+    }
+
+    for (unsigned long n = 0; n < frames; ++n) {
+        output[n] = mix[n].sum();
+    }
+}
+
 // Synthesizer-spezifische Setter-Methoden
 void Synthesizer::setOscillatorWaveform(int oscillator, const std::string& waveform) {
     if (oscillator >= 0 && oscillator < oscillators.size()) {
         oscillators[oscillator].waveform = waveform;
+        oscillators[oscillator].shape = parseWaveform(waveform);
     }
 }
 
@@ -453,6 +1063,17 @@ void Synthesizer::setOscillatorMix(int oscillator, float mix) {
 
 void Synthesizer::setFilterType(const std::string& type) {
     filter.type = type;
+    if (type == "highpass") {
+        filter.mode = FilterMode::Highpass;
+    } else if (type == "bandpass") {
+        filter.mode = FilterMode::Bandpass;
+    } else if (type == "notch") {
+        filter.mode = FilterMode::Notch;
+    } else if (type == "ladder") {
+        filter.mode = FilterMode::Ladder;
+    } else {
+        filter.mode = FilterMode::Lowpass;
+    }
 }
 
 void Synthesizer::setFilterCutoff(float cutoff) {
@@ -463,16 +1084,22 @@ void Synthesizer::setFilterResonance(float resonance) {
     filter.resonance = resonance;
 }
 
+void Synthesizer::setFilterKeyTracking(float amount) {
+    filter.keyTracking = std::max(0.0f, std::min(1.0f, amount));
+}
+
 void Synthesizer::setFilterEnvelopeAmount(float amount) {
     filter.envelopeAmount = amount;
 }
 
 void Synthesizer::setFilterEnvelopeAttack(float attack) {
     filter.envelopeAttack = attack;
+    updateEnvelopeRates();
 }
 
 void Synthesizer::setFilterEnvelopeDecay(float decay) {
     filter.envelopeDecay = decay;
+    updateEnvelopeRates();
 }
 
 void Synthesizer::setFilterEnvelopeSustain(float sustain) {
@@ -481,14 +1108,17 @@ void Synthesizer::setFilterEnvelopeSustain(float sustain) {
 
 void Synthesizer::setFilterEnvelopeRelease(float release) {
     filter.envelopeRelease = release;
+    updateEnvelopeRates();
 }
 
 void Synthesizer::setAmpEnvelopeAttack(float attack) {
     ampEnvelope.attack = attack;
+    updateEnvelopeRates();
 }
 
 void Synthesizer::setAmpEnvelopeDecay(float decay) {
     ampEnvelope.decay = decay;
+    updateEnvelopeRates();
 }
 
 void Synthesizer::setAmpEnvelopeSustain(float sustain) {
@@ -497,6 +1127,7 @@ void Synthesizer::setAmpEnvelopeSustain(float sustain) {
 
 void Synthesizer::setAmpEnvelopeRelease(float release) {
     ampEnvelope.release = release;
+    updateEnvelopeRates();
 }
 
 void Synthesizer::setLfoRate(float rate) {
@@ -509,10 +1140,67 @@ void Synthesizer::setLfoAmount(float amount) {
 
 void Synthesizer::setLfoWaveform(const std::string& waveform) {
     lfo.waveform = waveform;
+    lfo.shape = parseWaveform(waveform);
 }
 
 void Synthesizer::setLfoDestination(const std::string& destination) {
     lfo.destination = destination;
+    if (destination == "amplitude") {
+        lfo.target = LfoDestination::Amplitude;
+    } else if (destination == "pitch") {
+        lfo.target = LfoDestination::Pitch;
+    } else {
+        lfo.target = LfoDestination::Filter;
+    }
+}
+
+void Synthesizer::setLfoSync(bool sync) {
+    lfo.sync = sync;
+}
+
+void Synthesizer::setLfoDivision(const std::string& division) {
+    for (const auto& entry : kLfoDivisions) {
+        if (division == entry.name) {
+            lfo.division = entry.quarters;
+            return;
+        }
+    }
+    spdlog::warn("Synthesizer: unbekannte LFO-Division {}", division);
+}
+
+void Synthesizer::setLfoRetrigger(bool retrigger) {
+    lfo.retrigger = retrigger;
+}
+
+void Synthesizer::setTempo(float bpm) {
+    tempo = std::max(20.0f, std::min(999.0f, bpm));
+}
+
+Synthesizer::Waveform Synthesizer::parseWaveform(const std::string& waveform) {
+    if (waveform == "square") {
+        return Waveform::Square;
+    } else if (waveform == "saw") {
+        return Waveform::Saw;
+    } else if (waveform == "triangle") {
+        return Waveform::Triangle;
+    }
+    return Waveform::Sine;
+}
+
+void Synthesizer::setVoiceStealing(VoiceStealing mode) {
+    voiceStealing = mode;
+}
+
+void Synthesizer::setMaxPolyphony(int count) {
+    maxPolyphony = std::max(1, std::min(kMaxVoices, count));
+}
+
+void Synthesizer::setUnisonVoices(int count) {
+    unisonVoices = std::max(1, std::min(kMaxUnison, count));
+}
+
+void Synthesizer::setUnisonDetune(float cents) {
+    unisonDetune = std::max(0.0f, std::min(100.0f, cents));
 }
 
 } // namespace VR_DAW 
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "audio/processing/StringModel.hpp"
+#include "audio/processing/WindModel.hpp"
+#include "PitchTestUtils.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace VRMusicStudio {
+namespace Tests {
+
+// Presets und Noten je Modell für die gemeinsamen Tests
+template <typename Model>
+struct ModelCases;
+
+template <>
+struct ModelCases<StringModel> {
+    static std::vector<StringModel::Preset> deterministic() { return {StringModel::guitar(), StringModel::cello()}; }
+    static std::vector<StringModel::Preset> release() { return {StringModel::guitar(), StringModel::violin()}; }
+    static constexpr int kNote = 48;
+    static constexpr int kChord[2] = {60, 64};
+};
+
+template <>
+struct ModelCases<WindModel> {
+    static std::vector<WindModel::Preset> deterministic() {
+        return {WindModel::clarinet(), WindModel::flute(), WindModel::trumpet()};
+    }
+    static std::vector<WindModel::Preset> release() { return {WindModel::oboe(), WindModel::flute(), WindModel::horn()}; }
+    static constexpr int kNote = 65;
+    static constexpr int kChord[2] = {60, 67};
+};
+
+template <typename Model>
+class InstrumentModelTest : public ::testing::Test {};
+
+using InstrumentModels = ::testing::Types<StringModel, WindModel>;
+TYPED_TEST_SUITE(InstrumentModelTest, InstrumentModels);
+
+TYPED_TEST(InstrumentModelTest, DeterministicOutput) {
+    using Cases = ModelCases<TypeParam>;
+    for (const auto& preset : Cases::deterministic()) {
+        const auto first = playModelNote<TypeParam>(preset, Cases::kNote, 22050);
+        const auto second = playModelNote<TypeParam>(preset, Cases::kNote, 22050);
+        ASSERT_EQ(first.size(), second.size());
+        for (size_t i = 0; i < first.size(); ++i) {
+            ASSERT_EQ(first[i], second[i]) << "sample " << i;
+        }
+    }
+}
+
+TYPED_TEST(InstrumentModelTest, VoicesFreedAfterRelease) {
+    using Cases = ModelCases<TypeParam>;
+    for (const auto& preset : Cases::release()) {
+        TypeParam model(preset, 4, kTestSampleRate);
+        for (int note : Cases::kChord) model.noteOn(note, 0.8f);
+        renderModel(model, 4410);
+        EXPECT_EQ(model.getActiveVoices(), 2);
+
+        for (int note : Cases::kChord) model.noteOff(note);
+        renderModel(model, static_cast<int>(kTestSampleRate * 2.0));
+        EXPECT_EQ(model.getActiveVoices(), 0);
+    }
+}
+
+} // namespace Tests
+} // namespace VRMusicStudio
@@ -0,0 +1,65 @@
+#include "LoudnessMeter.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+
+namespace VR_DAW {
+namespace Tests {
+
+class LoudnessMeterTest : public ::testing::Test {
+protected:
+    static constexpr double SAMPLE_RATE = 48000.0;
+    static constexpr int BLOCK_SIZE = 512;
+
+    // Stereo-Sinus, beide Kanäle gleich (EBU Tech 3341, Testsignal 1 und 2)
+    std::vector<float> stereoSine(double frequency, float levelDb, double seconds) {
+        const float amplitude = std::pow(10.0f, levelDb / 20.0f);
+        std::vector<float> signal(2 * static_cast<size_t>(seconds * SAMPLE_RATE));
+        for (size_t i = 0; i < signal.size() / 2; ++i) {
+            const float value = amplitude * static_cast<float>(std::sin(2.0 * M_PI * frequency * i / SAMPLE_RATE));
+            signal[2 * i] = value;
+            signal[2 * i + 1] = value;
+        }
+        return signal;
+    }
+
+    void processInBlocks(LoudnessMeter& meter, const std::vector<float>& signal) {
+        const size_t frames = signal.size() / 2;
+        for (size_t offset = 0; offset < frames; offset += BLOCK_SIZE) {
+            meter.process(signal.data() + 2 * offset, std::min<size_t>(BLOCK_SIZE, frames - offset));
+        }
+    }
+};
+
+TEST_F(LoudnessMeterTest, SineAtMinus23Lufs) {
+    // 1 kHz bei -23 dBFS ergibt -23 LUFS, Toleranz nach Tech 3341 +-0,1 LU
+    const auto signal = stereoSine(1000.0, -23.0f, 20.0);
+
+    LoudnessMeter meter;
+    meter.prepare(SAMPLE_RATE, 2);
+    processInBlocks(meter, signal);
+
+    EXPECT_NEAR(meter.getMomentaryLoudness(), -23.0f, 0.1f);
+    EXPECT_NEAR(meter.getShortTermLoudness(), -23.0f, 0.1f);
+    EXPECT_NEAR(meter.getIntegratedLoudness(), -23.0f, 0.1f);
+    EXPECT_NEAR(meter.getLoudnessRange(), 0.0f, 0.1f);
+    EXPECT_NEAR(meter.getTruePeakDb(), -23.0f, 0.1f);
+
+    // Offline-Messung in einem Stück liefert dasselbe
+    const auto measurement = LoudnessMeter::analyze(signal.data(), signal.size() / 2, 2, SAMPLE_RATE);
+    EXPECT_NEAR(measurement.integrated, meter.getIntegratedLoudness(), 0.01f);
+}
+
+TEST_F(LoudnessMeterTest, RelativeGateIgnoresQuietPassage) {
+    // Tech 3341, Testsignal 3: -36 / -23 / -36 dBFS zu je 10 / 60 / 10 s
+    LoudnessMeter meter;
+    meter.prepare(SAMPLE_RATE, 2);
+    processInBlocks(meter, stereoSine(1000.0, -36.0f, 10.0));
+    processInBlocks(meter, stereoSine(1000.0, -23.0f, 60.0));
+    processInBlocks(meter, stereoSine(1000.0, -36.0f, 10.0));
+
+    EXPECT_NEAR(meter.getIntegratedLoudness(), -23.0f, 0.1f);
+}
+
+} // namespace Tests
+} // namespace VR_DAW
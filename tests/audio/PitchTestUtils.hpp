@@ -0,0 +1,81 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+namespace VRMusicStudio {
+namespace Tests {
+
+constexpr double kTestSampleRate = 44100.0;
+constexpr int kTestBlockSize = 256;
+
+inline double noteFrequency(int note) {
+    return 440.0 * std::pow(2.0, (note - 69) / 12.0);
+}
+
+// Grundfrequenz per Autokorrelation. Gesucht wird ab der Oktave über der
+// Erwartung, und das erste Maximum nahe dem höchsten gewinnt, damit ein
+// Oktavsprung als solcher gemessen wird.
+inline double estimateFrequency(const std::vector<float>& signal, size_t start, size_t length,
+                                double expected, double sampleRate) {
+    const int minLag = static_cast<int>(sampleRate / (expected * 2.5));
+    const int maxLag = static_cast<int>(sampleRate / (expected / 1.5)) + 1;
+    auto correlation = [&](int lag) {
+        double sum = 0.0;
+        double energy = 0.0;
+        for (size_t i = start; i < start + length; ++i) {
+            sum += signal[i] * signal[i + lag];
+            energy += 0.5 * (signal[i] * signal[i] + signal[i + lag] * signal[i + lag]);
+        }
+        return energy > 0.0 ? sum / energy : 0.0;
+    };
+
+    std::vector<double> values(maxLag + 2, 0.0);
+    double best = 0.0;
+    for (int lag = minLag - 1; lag <= maxLag + 1; ++lag) {
+        values[lag] = correlation(lag);
+        if (lag >= minLag && lag <= maxLag) best = std::max(best, values[lag]);
+    }
+
+    int bestLag = minLag;
+    for (int lag = minLag; lag <= maxLag; ++lag) {
+        if (values[lag] >= 0.9 * best && values[lag] >= values[lag - 1] && values[lag] >= values[lag + 1]) {
+            bestLag = lag;
+            break;
+        }
+    }
+
+    // Parabel durch die Nachbarn für den Nachkommaanteil
+    const double left = values[bestLag - 1];
+    const double center = values[bestLag];
+    const double right = values[bestLag + 1];
+    const double denominator = left - 2.0 * center + right;
+    const double offset = denominator != 0.0 ? 0.5 * (left - right) / denominator : 0.0;
+    return sampleRate / (bestLag + offset);
+}
+
+inline double centsBetween(double frequency, double reference) {
+    return 1200.0 * std::log2(frequency / reference);
+}
+
+// Blockweises Rendern für alle Modelle mit process(float*, int)
+template <typename Model>
+std::vector<float> renderModel(Model& model, int numSamples) {
+    std::vector<float> output(numSamples, 0.0f);
+    for (int offset = 0; offset < numSamples; offset += kTestBlockSize) {
+        model.process(output.data() + offset, std::min(kTestBlockSize, numSamples - offset));
+    }
+    return output;
+}
+
+template <typename Model>
+std::vector<float> playModelNote(const typename Model::Preset& preset, int note, int numSamples) {
+    Model model(preset, 4, kTestSampleRate);
+    model.noteOn(note, 0.8f);
+    return renderModel(model, numSamples);
+}
+
+} // namespace Tests
+} // namespace VRMusicStudio
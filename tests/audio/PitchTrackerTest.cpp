@@ -0,0 +1,102 @@
+#include "audio/processing/PitchTracker.hpp"
+#include "PitchTestUtils.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+namespace VRMusicStudio {
+namespace Tests {
+
+class PitchTrackerTest : public ::testing::Test {
+protected:
+    static constexpr double SAMPLE_RATE = 44100.0;
+    static constexpr int BLOCK_SIZE = 256;
+
+    static std::vector<float> sine(double frequency, size_t numSamples) {
+        std::vector<float> signal(numSamples);
+        for (size_t i = 0; i < numSamples; ++i) {
+            signal[i] = 0.5f * static_cast<float>(std::sin(2.0 * M_PI * frequency * i / SAMPLE_RATE));
+        }
+        return signal;
+    }
+
+    // Bandbegrenzter Sägezahn; die starken Obertöne provozieren Oktavfehler
+    static std::vector<float> sawtooth(double frequency, size_t numSamples) {
+        std::vector<float> signal(numSamples, 0.0f);
+        for (int harmonic = 1; harmonic * frequency < SAMPLE_RATE / 2.0; ++harmonic) {
+            const double amplitude = 0.3 / harmonic;
+            for (size_t i = 0; i < numSamples; ++i) {
+                signal[i] += static_cast<float>(amplitude * std::sin(2.0 * M_PI * harmonic * frequency * i / SAMPLE_RATE));
+            }
+        }
+        return signal;
+    }
+
+    std::vector<PitchTracker::Estimate> trackStreaming(const std::vector<float>& signal, PitchTracker::Method method) {
+        PitchTracker::Settings settings;
+        settings.method = method;
+        PitchTracker tracker;
+        tracker.prepare(SAMPLE_RATE, settings);
+
+        std::vector<PitchTracker::Estimate> estimates;
+        PitchTracker::Estimate found[8];
+        for (size_t offset = 0; offset < signal.size(); offset += BLOCK_SIZE) {
+            const size_t count = tracker.process(signal.data() + offset,
+                                                 std::min<size_t>(BLOCK_SIZE, signal.size() - offset), found, 8);
+            estimates.insert(estimates.end(), found, found + count);
+        }
+        return estimates;
+    }
+
+    void expectPitch(const std::vector<float>& signal, double frequency, const char* name) {
+        for (auto method : {PitchTracker::Method::YIN, PitchTracker::Method::MPM}) {
+            const auto estimates = trackStreaming(signal, method);
+            ASSERT_FALSE(estimates.empty()) << name;
+            for (const auto& estimate : estimates) {
+                ASSERT_TRUE(estimate.voiced) << name << " " << frequency << " Hz at " << estimate.position;
+                EXPECT_NEAR(centsBetween(estimate.frequency, frequency), 0.0, 5.0)
+                    << name << " " << frequency << " Hz, method " << static_cast<int>(method);
+            }
+        }
+    }
+};
+
+TEST_F(PitchTrackerTest, SinePitch) {
+    for (double frequency : {82.41, 196.0, 440.0, 1046.5}) {
+        expectPitch(sine(frequency, 11025), frequency, "sine");
+    }
+}
+
+TEST_F(PitchTrackerTest, SawtoothPitch) {
+    for (double frequency : {65.41, 146.83, 329.63, 880.0}) {
+        expectPitch(sawtooth(frequency, 11025), frequency, "sawtooth");
+    }
+}
+
+TEST_F(PitchTrackerTest, SilenceIsUnvoiced) {
+    const std::vector<float> silence(22050, 0.0f);
+    for (const auto& estimate : trackStreaming(silence, PitchTracker::Method::MPM)) {
+        EXPECT_FALSE(estimate.voiced);
+        EXPECT_EQ(estimate.frequency, 0.0f);
+    }
+}
+
+TEST_F(PitchTrackerTest, OfflineTrackMatchesMidiNote) {
+    PitchTracker::Settings settings;
+    const auto signal = sawtooth(noteFrequency(57), 22050);
+    const auto estimates = PitchTracker::track(signal.data(), signal.size(), 1, SAMPLE_RATE, settings);
+    ASSERT_FALSE(estimates.empty());
+
+    // Ränder dürfen unvoiced sein, der Rest muss die Note treffen
+    size_t voiced = 0;
+    for (const auto& estimate : estimates) {
+        if (!estimate.voiced) continue;
+        ++voiced;
+        EXPECT_NEAR(estimate.midiNote(), 57.0f, 0.05f) << "position " << estimate.position;
+    }
+    EXPECT_GT(voiced, estimates.size() / 2);
+}
+
+} // namespace Tests
+} // namespace VRMusicStudio
@@ -0,0 +1,44 @@
+#include "audio/processing/StringModel.hpp"
+#include "PitchTestUtils.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace VRMusicStudio {
+namespace Tests {
+
+class StringModelTest : public ::testing::Test {
+protected:
+    static constexpr double SAMPLE_RATE = kTestSampleRate;
+
+    std::vector<float> playNote(const StringModel::Preset& preset, int note, int numSamples) {
+        return playModelNote<StringModel>(preset, note, numSamples);
+    }
+};
+
+TEST_F(StringModelTest, PluckedPitch) {
+    // Ohne Korpus, damit nur die Saite die Tonhöhe bestimmt
+    StringModel::Preset preset = StringModel::guitar();
+    preset.bodyMix = 0.0f;
+
+    for (int note : {45, 57, 64, 76}) {
+        const auto output = playNote(preset, note, static_cast<int>(SAMPLE_RATE));
+        const double expected = noteFrequency(note);
+        const double measured = estimateFrequency(output, 4410, 8192, expected, SAMPLE_RATE);
+        EXPECT_NEAR(centsBetween(measured, expected), 0.0, 5.0) << "note " << note;
+    }
+}
+
+TEST_F(StringModelTest, BowedPitch) {
+    StringModel::Preset preset = StringModel::violin();
+    preset.bodyMix = 0.0f;
+
+    for (int note : {55, 62, 69, 76}) {
+        const auto output = playNote(preset, note, static_cast<int>(SAMPLE_RATE));
+        const double expected = noteFrequency(note);
+        const double measured = estimateFrequency(output, 22050, 8192, expected, SAMPLE_RATE);
+        EXPECT_NEAR(centsBetween(measured, expected), 0.0, 5.0) << "note " << note;
+    }
+}
+
+} // namespace Tests
+} // namespace VRMusicStudio
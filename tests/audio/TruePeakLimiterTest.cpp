@@ -0,0 +1,98 @@
+#include "TruePeakLimiter.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+namespace VR_DAW {
+namespace Tests {
+
+namespace {
+
+// Unabhängige True-Peak-Messung: 8-fache Überabtastung mit
+// Blackman-gefenstertem Sinc über +-32 Samples
+float oversampledPeakDb(const std::vector<float>& signal, size_t start) {
+    constexpr int kFactor = 8;
+    constexpr int kHalfWidth = 32;
+    std::vector<double> kernel(kFactor * 2 * kHalfWidth);
+    for (int phase = 0; phase < kFactor; ++phase) {
+        for (int k = -kHalfWidth + 1; k <= kHalfWidth; ++k) {
+            const double x = k - static_cast<double>(phase) / kFactor;
+            const double sinc = x == 0.0 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+            const double window = 0.42 + 0.5 * std::cos(M_PI * x / kHalfWidth) + 0.08 * std::cos(2.0 * M_PI * x / kHalfWidth);
+            kernel[phase * 2 * kHalfWidth + k + kHalfWidth - 1] = sinc * window;
+        }
+    }
+
+    float peak = 0.0f;
+    for (size_t i = start + kHalfWidth; i + kHalfWidth < signal.size(); ++i) {
+        for (int phase = 0; phase < kFactor; ++phase) {
+            const double* taps = &kernel[phase * 2 * kHalfWidth];
+            double sum = 0.0;
+            for (int k = 0; k < 2 * kHalfWidth; ++k) {
+                sum += signal[i + k - kHalfWidth + 1] * taps[k];
+            }
+            peak = std::max(peak, static_cast<float>(std::fabs(sum)));
+        }
+    }
+    return 20.0f * std::log10(std::max(peak, 1e-9f));
+}
+
+} // namespace
+
+class TruePeakLimiterTest : public ::testing::Test {
+protected:
+    static constexpr double SAMPLE_RATE = 44100.0;
+    static constexpr int BLOCK_SIZE = 512;
+
+    void process(TruePeakLimiter& limiter, std::vector<float>& signal) {
+        for (size_t offset = 0; offset < signal.size(); offset += BLOCK_SIZE) {
+            limiter.process(signal.data() + offset, std::min<size_t>(BLOCK_SIZE, signal.size() - offset));
+        }
+    }
+};
+
+TEST_F(TruePeakLimiterTest, InterSamplePeaksStayBelowCeiling) {
+    // Sinus bei fs/4 mit 45 Grad Phase: die Samples liegen 3 dB unter dem
+    // Scheitel, ein reiner Sample-Peak-Limiter ließe ihn durch. Dazu An- und
+    // Abschwellen, damit Attack und Release durchlaufen werden.
+    std::vector<float> signal(static_cast<size_t>(SAMPLE_RATE / 2));
+    for (size_t i = 0; i < signal.size(); ++i) {
+        const double t = i / SAMPLE_RATE;
+        const double envelope = 0.6 + 0.6 * std::sin(2.0 * M_PI * 4.0 * t);
+        signal[i] = static_cast<float>(envelope * std::sin(M_PI * 0.5 * i + M_PI * 0.25)
+                                       + 0.3 * std::sin(2.0 * M_PI * 997.0 * t));
+    }
+    ASSERT_GT(oversampledPeakDb(signal, 0), 1.0f);
+
+    for (float ceiling : {-1.0f, -0.1f}) {
+        TruePeakLimiter limiter;
+        limiter.setCeiling(ceiling);
+        limiter.prepare(SAMPLE_RATE, 1);
+
+        std::vector<float> output = signal;
+        process(limiter, output);
+        EXPECT_LE(oversampledPeakDb(output, limiter.getLatencySamples()), ceiling + 0.05f) << "ceiling " << ceiling;
+        EXPECT_LE(limiter.getOutputTruePeakDb(), ceiling + 0.01f) << "ceiling " << ceiling;
+    }
+}
+
+TEST_F(TruePeakLimiterTest, QuietSignalPassesWithLatency) {
+    std::vector<float> signal(8192);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = 0.25f * static_cast<float>(std::sin(2.0 * M_PI * 440.0 * i / SAMPLE_RATE));
+    }
+
+    TruePeakLimiter limiter;
+    limiter.prepare(SAMPLE_RATE, 1);
+    std::vector<float> output = signal;
+    process(limiter, output);
+
+    const size_t latency = static_cast<size_t>(limiter.getLatencySamples());
+    for (size_t i = latency; i < output.size(); ++i) {
+        ASSERT_NEAR(output[i], signal[i - latency], 1e-6f) << "sample " << i;
+    }
+}
+
+} // namespace Tests
+} // namespace VR_DAW
@@ -0,0 +1,68 @@
+#include "audio/processing/WindModel.hpp"
+#include "PitchTestUtils.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace VRMusicStudio {
+namespace Tests {
+
+namespace {
+
+struct PitchCase {
+    const char* name;
+    WindModel::Preset preset;
+    int notes[3];
+};
+
+} // namespace
+
+class WindModelTest : public ::testing::Test {
+protected:
+    static constexpr double SAMPLE_RATE = kTestSampleRate;
+
+    std::vector<float> playNote(const WindModel::Preset& preset, int note, int numSamples) {
+        return playModelNote<WindModel>(preset, note, numSamples);
+    }
+};
+
+TEST_F(WindModelTest, PitchPerExcitation) {
+    // Ein Instrument je Anregung, Noten im üblichen Umfang. Rohrblatt und Jet
+    // verstimmen die Schleife um einige Cent, ein Überblasen wären >= 700 Cent.
+    const PitchCase cases[] = {
+        {"clarinet", WindModel::clarinet(), {55, 62, 67}},
+        {"oboe", WindModel::oboe(), {62, 69, 74}},
+        {"saxophone", WindModel::saxophone(), {56, 62, 68}},
+        {"flute", WindModel::flute(), {67, 72, 79}},
+        {"trumpet", WindModel::trumpet(), {60, 67, 72}},
+        {"trombone", WindModel::trombone(), {46, 53, 58}},
+        {"bassoon", WindModel::bassoon(), {41, 48, 55}},
+    };
+
+    for (const auto& pitchCase : cases) {
+        for (int note : pitchCase.notes) {
+            const auto output = playNote(pitchCase.preset, note, static_cast<int>(SAMPLE_RATE));
+            const double expected = noteFrequency(note);
+            const double measured = estimateFrequency(output, 22050, 8192, expected, SAMPLE_RATE);
+            EXPECT_NEAR(centsBetween(measured, expected), 0.0, 10.0)
+                << pitchCase.name << " note " << note;
+        }
+    }
+}
+
+TEST_F(WindModelTest, PitchReturnsAfterVibrato) {
+    // Vibrato nahe der größten Auslenkung abschalten (1,3 Perioden), danach
+    // muss die Note wieder auf ihrer Tonhöhe stehen
+    WindModel model(WindModel::clarinet(), 4, SAMPLE_RATE);
+    model.setVibrato(1.0f, 5.0f);
+    model.noteOn(62, 0.8f);
+    renderModel(model, 11584);
+    model.setVibrato(0.0f, 5.0f);
+
+    const auto output = renderModel(model, static_cast<int>(SAMPLE_RATE));
+    const double expected = noteFrequency(62);
+    const double measured = estimateFrequency(output, 11025, 8192, expected, SAMPLE_RATE);
+    EXPECT_NEAR(centsBetween(measured, expected), 0.0, 10.0);
+}
+
+} // namespace Tests
+} // namespace VRMusicStudio